@@ -16,6 +16,9 @@ headers   += $(call kconf_enabled,STROLL_BOPS,stroll/bops.h)
 headers   += $(call kconf_enabled,STROLL_POW2,stroll/pow2.h)
 headers   += $(call kconf_enabled,STROLL_BMAP,stroll/bmap.h)
 headers   += $(call kconf_enabled,STROLL_FBMAP,stroll/fbmap.h)
+headers   += $(call kconf_enabled,STROLL_HBMAP,stroll/hbmap.h)
+headers   += $(call kconf_enabled,STROLL_IDALLOC,stroll/idalloc.h)
+headers   += $(call kconf_enabled,STROLL_RBMAP,stroll/rbmap.h)
 headers   += $(call kconf_enabled,STROLL_LVSTR,stroll/lvstr.h)
 headers   += $(call kconf_enabled,STROLL_ARRAY,stroll/array.h)
 headers   += $(call kconf_enabled,STROLL_FBHEAP,stroll/fbheap.h)
@@ -34,6 +37,10 @@ headers   += $(call kconf_enabled,STROLL_LALLOC,stroll/lalloc.h)
 headers   += $(call kconf_enabled,STROLL_FALLOC,stroll/falloc.h)
 headers   += $(call kconf_enabled,STROLL_HLIST,stroll/hlist.h)
 headers   += $(call kconf_enabled,STROLL_HASH,stroll/hash.h)
+headers   += $(call kconf_enabled,STROLL_BLOOM,stroll/bloom.h)
+headers   += $(call kconf_enabled,STROLL_CUCKOO,stroll/cuckoo.h)
+headers   += $(call kconf_enabled,STROLL_HLL,stroll/hll.h)
+headers   += $(call kconf_enabled,STROLL_CMSKETCH,stroll/cmsketch.h)
 headers   += $(call kconf_enabled,STROLL_BUFF,stroll/buffer.h)
 headers   += $(call kconf_enabled,STROLL_MSG,stroll/message.h)
 
@@ -48,6 +55,9 @@ override libstroll_pkgconf_libs := Libs: -L$${libdir} \
                                          -Wl,--push-state,--as-needed \
                                          -lstroll \
                                          -Wl,--pop-state
+ifeq ($(CONFIG_STROLL_ARRAY_MT_UTILS),y)
+override libstroll_pkgconf_libs += -pthread
+endif # ($(CONFIG_STROLL_ARRAY_MT_UTILS),y)
 
 define libstroll_pkgconf_tmpl
 prefix=$(PREFIX)
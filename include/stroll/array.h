@@ -21,6 +21,7 @@
 
 #include <stroll/cdefs.h>
 #include <sys/types.h>
+#include <stdint.h>
 
 /**
  * Comparison routine signature.
@@ -410,8 +411,109 @@ stroll_array_3wquick_sort(void * __restrict     array,
                           void *                data)
 	__stroll_nonull(1, 4);
 
+#if defined(CONFIG_STROLL_ARRAY_SAMPLE_SORT_MT)
+
+/**
+ * Sort an array according to the sample sort algorithm using multiple threads.
+ *
+ * @param[inout] array    Array to sort
+ * @param[in]    nr       @p array number of elements
+ * @param[in]    size     Size of a single @p array element
+ * @param[in]    compare  @p array elements comparison function
+ * @param[inout] data     Optional arbitrary user data
+ * @param[in]    nthreads Maximum number of threads to sort with
+ *
+ * @return `0` when successful, a negative errno-like return code otherwise.
+ * @retval 0       Success
+ * @retval -ENOMEM Memory allocation failure
+ * @retval -EAGAIN Not enough resources to synchronize threads
+ *
+ * Sort @p array containing @p nr elements of size @p size using the @p compare
+ * comparison function according to the @rstlnk{Array multi-threaded sample
+ * sort} algorithm.
+ *
+ * Sorting is carried out by at most @p nthreads threads, the calling thread
+ * included. When @p nthreads is `0`, the number of online CPUs is used
+ * instead. The number of threads is further limited so that each thread sorts
+ * a reasonable number of elements: small arrays are sorted by the calling
+ * thread only, as stroll_array_3wquick_sort() does.
+ *
+ * The first 2 arguments passed to the @p compare routine both points to
+ * distinct elements, which may be copies of @p array elements.
+ * @p compare *MUST* return an integer less than, equal to, or greater than zero
+ * if first argument is found, respectively, to be less than, to match, or be
+ * greater than the second one.
+ *
+ * The @p compare routine is given @p data as an optional *third* argument
+ * as-is. It may point to arbitrary user data for comparison purposes.
+ *
+ * @warning
+ * @p compare is called concurrently from multiple threads with the same @p data
+ * argument and *MUST* therefore be thread-safe.
+ *
+ * @note
+ * Refer to @rstlnk{Sorting arrays} for more informations related to algorithm
+ * selection.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * `nr == 0`, result is undefined. An assertion otherwise.
+ */
+extern int
+stroll_array_sample_sort_mt(void * __restrict     array,
+                            unsigned int          nr,
+                            size_t                size,
+                            stroll_array_cmp_fn * compare,
+                            void *                data,
+                            unsigned int          nthreads)
+	__stroll_nonull(1, 4);
+
+#endif /* defined(CONFIG_STROLL_ARRAY_SAMPLE_SORT_MT) */
+
 #endif /* defined(CONFIG_STROLL_ARRAY_3WQUICK_SORT) */
 
+#if defined(CONFIG_STROLL_ARRAY_PDQUICK_SORT)
+
+/**
+ * Sort an array according to the pattern-defeating quick sort algorithm.
+ *
+ * @param[inout] array   Array to sort
+ * @param[in]    size    Size of a single @p array element
+ * @param[in]    nr      @p array number of elements
+ * @param[in]    compare @p array elements comparison function
+ * @param[inout] data    Optional arbitrary user data
+ *
+ * Sort @p array containing @p nr elements of size @p size using the @p compare
+ * comparison function according to the
+ * @rstlnk{Array pattern-defeating quick sort} algorithm.
+ *
+ * The first 2 arguments passed to the @p compare routine both points to
+ * distinct @p array elements.
+ * @p compare *MUST* return an integer less than, equal to, or greater than zero
+ * if first argument is found, respectively, to be less than, to match, or be
+ * greater than the second one.
+ *
+ * The @p compare routine is given @p data as an optional *third* argument
+ * as-is. It may point to arbitrary user data for comparison purposes.
+ *
+ * @note
+ * Refer to @rstlnk{Sorting arrays} for more informations related to algorithm
+ * selection.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * `nr <= 1`, result is undefined. An assertion otherwise.
+ */
+extern void
+stroll_array_pdquick_sort(void * __restrict     array,
+                          unsigned int          nr,
+                          size_t                size,
+                          stroll_array_cmp_fn * compare,
+                          void *                data)
+	__stroll_nonull(1, 4);
+
+#endif /* defined(CONFIG_STROLL_ARRAY_PDQUICK_SORT) */
+
 #if defined(CONFIG_STROLL_ARRAY_MERGE_SORT)
 
 /**
@@ -455,8 +557,356 @@ stroll_array_merge_sort(void * __restrict     array,
                         void *                data)
 	__stroll_nonull(1, 4);
 
+/**
+ * Return size of scratch buffer required to merge sort an array.
+ *
+ * @param[in] nr   Number of array elements
+ * @param[in] size Size of a single array element
+ *
+ * @return Scratch buffer size in bytes
+ *
+ * Compute the size of the scratch buffer that must be given to
+ * stroll_array_merge_sort_with_scratch() to sort an array containing @p nr
+ * elements of size @p size, i.e. `(nr - (nr / 2)) * size` bytes.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * `nr == 0` or `size == 0`, result is undefined. An assertion otherwise.
+ *
+ * @see stroll_array_merge_sort_with_scratch()
+ */
+extern size_t
+stroll_array_merge_sort_scratch_size(unsigned int nr, size_t size)
+	__stroll_const __warn_result;
+
+/**
+ * Sort an array according to the merge sort algorithm using a caller supplied
+ * scratch buffer.
+ *
+ * @param[inout] array   Array to sort
+ * @param[in]    nr      @p array number of elements
+ * @param[in]    size    Size of a single @p array element
+ * @param[in]    compare @p array elements comparison function
+ * @param[inout] data    Optional arbitrary user data
+ * @param[out]   scratch Scratch buffer
+ *
+ * Sort @p array the same way as stroll_array_merge_sort() does, except that
+ * temporary storage is given by the caller thanks to the @p scratch argument
+ * instead of being allocated. This allows to sort multiple arrays in a row
+ * without any memory allocation.
+ *
+ * @p scratch *MUST* point to a buffer at least
+ * stroll_array_merge_sort_scratch_size() bytes long and *MUST NOT* overlap
+ * @p array. Its content is clobbered on return. Sorting runs faster when
+ * @p scratch is aligned on a word boundary.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * `nr == 0`, result is undefined. An assertion otherwise.
+ *
+ * @see
+ * - stroll_array_merge_sort()
+ * - stroll_array_merge_sort_scratch_size()
+ */
+extern void
+stroll_array_merge_sort_with_scratch(void * __restrict     array,
+                                     unsigned int          nr,
+                                     size_t                size,
+                                     stroll_array_cmp_fn * compare,
+                                     void *                data,
+                                     void * __restrict     scratch)
+	__stroll_nonull(1, 4, 6);
+
+#if defined(CONFIG_STROLL_ARRAY_MERGE_SORT_MT)
+
+/**
+ * Sort an array according to the merge sort algorithm using multiple threads.
+ *
+ * @param[inout] array    Array to sort
+ * @param[in]    nr       @p array number of elements
+ * @param[in]    size     Size of a single @p array element
+ * @param[in]    compare  @p array elements comparison function
+ * @param[inout] data     Optional arbitrary user data
+ * @param[in]    nthreads Maximum number of threads to sort with
+ *
+ * @return `0` when successful, a negative errno-like return code otherwise.
+ * @retval 0       Success
+ * @retval -ENOMEM Memory allocation failure
+ * @retval -EAGAIN Not enough resources to synchronize threads
+ *
+ * Sort @p array containing @p nr elements of size @p size using the @p compare
+ * comparison function according to the @rstlnk{Array multi-threaded merge
+ * sort} algorithm.
+ *
+ * Sorting is carried out by at most @p nthreads threads, the calling thread
+ * included. When @p nthreads is `0`, the number of online CPUs is used
+ * instead. The number of threads is further limited so that each thread sorts
+ * a reasonable number of elements: small arrays are sorted by the calling
+ * thread only, as stroll_array_merge_sort() does.
+ *
+ * The first 2 arguments passed to the @p compare routine both points to
+ * distinct @p array elements.
+ * @p compare *MUST* return an integer less than, equal to, or greater than zero
+ * if first argument is found, respectively, to be less than, to match, or be
+ * greater than the second one.
+ *
+ * The @p compare routine is given @p data as an optional *third* argument
+ * as-is. It may point to arbitrary user data for comparison purposes.
+ *
+ * @warning
+ * @p compare is called concurrently from multiple threads with the same @p data
+ * argument and *MUST* therefore be thread-safe.
+ *
+ * @note
+ * Refer to @rstlnk{Sorting arrays} for more informations related to algorithm
+ * selection.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * `nr == 0`, result is undefined. An assertion otherwise.
+ */
+extern int
+stroll_array_merge_sort_mt(void * __restrict     array,
+                           unsigned int          nr,
+                           size_t                size,
+                           stroll_array_cmp_fn * compare,
+                           void *                data,
+                           unsigned int          nthreads)
+	__stroll_nonull(1, 4);
+
+#endif /* defined(CONFIG_STROLL_ARRAY_MERGE_SORT_MT) */
+
 #endif /* defined(CONFIG_STROLL_ARRAY_MERGE_SORT) */
 
+#if defined(CONFIG_STROLL_ARRAY_INPLACE_MERGE_SORT)
+
+/**
+ * Sort an array according to the in-place merge sort algorithm.
+ *
+ * @param[inout] array   Array to sort
+ * @param[in]    nr      @p array number of elements
+ * @param[in]    size    Size of a single @p array element
+ * @param[in]    compare @p array elements comparison function
+ * @param[inout] data    Optional arbitrary user data
+ *
+ * Sort @p array containing @p nr elements of size @p size using the @p compare
+ * comparison function according to the @rstlnk{Array in-place merge sort}
+ * algorithm.
+ *
+ * Sorting is stable and performs no memory allocation: it only requires a
+ * #CONFIG_STROLL_ARRAY_INPLACE_MERGE_SORT_BUFFER bytes long buffer allocated
+ * onto the stack.
+ *
+ * The first 2 arguments passed to the @p compare routine both points to
+ * distinct @p array elements.
+ * @p compare *MUST* return an integer less than, equal to, or greater than zero
+ * if first argument is found, respectively, to be less than, to match, or be
+ * greater than the second one.
+ *
+ * The @p compare routine is given @p data as an optional *third* argument
+ * as-is. It may point to arbitrary user data for comparison purposes.
+ *
+ * @note
+ * Refer to @rstlnk{Sorting arrays} for more informations related to algorithm
+ * selection.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * `nr == 0`, result is undefined. An assertion otherwise.
+ */
+extern void
+stroll_array_inplace_merge_sort(void * __restrict     array,
+                                unsigned int          nr,
+                                size_t                size,
+                                stroll_array_cmp_fn * compare,
+                                void *                data)
+	__stroll_nonull(1, 4);
+
+#endif /* defined(CONFIG_STROLL_ARRAY_INPLACE_MERGE_SORT) */
+
+#if defined(CONFIG_STROLL_ARRAY_INDIRECT_SORT)
+
+/**
+ * Compute the permutation that sorts an array.
+ *
+ * @param[in]    array   Array to sort
+ * @param[in]    nr      @p array number of elements
+ * @param[in]    size    Size of a single @p array element
+ * @param[in]    compare @p array elements comparison function
+ * @param[inout] data    Optional arbitrary user data
+ * @param[out]   indices Sorting permutation
+ *
+ * @return `0` when successful, a negative errno-like return code otherwise.
+ * @retval 0       Success
+ * @retval -ENOMEM Memory allocation failure
+ *
+ * Fill the @p indices array of @p nr indices so that, for each `i` within the
+ * `[0:nr[` range, `indices[i]` is the index of the @p array element that
+ * belongs to position `i` once sorted according to the @p compare comparison
+ * function. @p array is left untouched.
+ *
+ * Indices are sorted using the @rstlnk{Array merge sort} algorithm. Sorting is
+ * therefore stable, i.e. indices of elements that compare equal are given in
+ * ascending order.
+ *
+ * The first 2 arguments passed to the @p compare routine both points to
+ * distinct @p array elements.
+ * @p compare *MUST* return an integer less than, equal to, or greater than zero
+ * if first argument is found, respectively, to be less than, to match, or be
+ * greater than the second one.
+ *
+ * The @p compare routine is given @p data as an optional *third* argument
+ * as-is. It may point to arbitrary user data for comparison purposes.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * `nr == 0`, result is undefined. An assertion otherwise.
+ *
+ * @see
+ * - stroll_array_permute()
+ * - stroll_array_indirect_sort()
+ */
+extern int
+stroll_array_argsort(const void * __restrict  array,
+                     unsigned int             nr,
+                     size_t                   size,
+                     stroll_array_cmp_fn *    compare,
+                     void *                   data,
+                     unsigned int * __restrict indices)
+	__stroll_nonull(1, 4, 6) __warn_result;
+
+/**
+ * Reorder array elements in-place according to a permutation.
+ *
+ * @param[inout] array   Array to reorder
+ * @param[in]    nr      @p array number of elements
+ * @param[in]    size    Size of a single @p array element
+ * @param[inout] indices Permutation to apply
+ *
+ * Move @p array elements so that, for each `i` within the `[0:nr[` range,
+ * the element found at index `indices[i]` on entry is located at index `i` on
+ * return. This is typically used to apply the permutation computed by
+ * stroll_array_argsort().
+ *
+ * Permutation is applied by following its cycles so that each element is
+ * moved once only, which makes it suitable for arrays of large elements.
+ * No memory allocation is performed. @p indices is used to keep track of
+ * moved elements and is reset to the identity permutation on return.
+ *
+ * @warning
+ * @p indices *MUST* hold a permutation of the `[0:nr[` range, i.e. each index
+ * of the range must appear once and only once, otherwise result is undefined.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * `nr == 0`, result is undefined. An assertion otherwise.
+ *
+ * @see stroll_array_argsort()
+ */
+extern void
+stroll_array_permute(void * __restrict         array,
+                     unsigned int              nr,
+                     size_t                    size,
+                     unsigned int * __restrict indices)
+	__stroll_nonull(1, 4);
+
+/**
+ * Sort an array according to the indirect sort algorithm.
+ *
+ * @param[inout] array   Array to sort
+ * @param[in]    nr      @p array number of elements
+ * @param[in]    size    Size of a single @p array element
+ * @param[in]    compare @p array elements comparison function
+ * @param[inout] data    Optional arbitrary user data
+ *
+ * @return `0` when successful, a negative errno-like return code otherwise.
+ * @retval 0       Success
+ * @retval -ENOMEM Memory allocation failure
+ *
+ * Sort @p array containing @p nr elements of size @p size using the @p compare
+ * comparison function according to the @rstlnk{Array indirect sort}
+ * algorithm, i.e. by computing the sorting permutation thanks to
+ * stroll_array_argsort() then applying it thanks to stroll_array_permute().
+ * Sorting is stable and each element is moved once only.
+ *
+ * The first 2 arguments passed to the @p compare routine both points to
+ * distinct @p array elements.
+ * @p compare *MUST* return an integer less than, equal to, or greater than zero
+ * if first argument is found, respectively, to be less than, to match, or be
+ * greater than the second one.
+ *
+ * The @p compare routine is given @p data as an optional *third* argument
+ * as-is. It may point to arbitrary user data for comparison purposes.
+ *
+ * @note
+ * Refer to @rstlnk{Sorting arrays} for more informations related to algorithm
+ * selection.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * `nr == 0`, result is undefined. An assertion otherwise.
+ */
+extern int
+stroll_array_indirect_sort(void * __restrict     array,
+                           unsigned int          nr,
+                           size_t                size,
+                           stroll_array_cmp_fn * compare,
+                           void *                data)
+	__stroll_nonull(1, 4) __warn_result;
+
+#endif /* defined(CONFIG_STROLL_ARRAY_INDIRECT_SORT) */
+
+#if defined(CONFIG_STROLL_ARRAY_POWER_SORT)
+
+/**
+ * Sort an array according to the powersort natural merge sort algorithm.
+ *
+ * @param[inout] array   Array to sort
+ * @param[in]    nr      @p array number of elements
+ * @param[in]    size    Size of a single @p array element
+ * @param[in]    compare @p array elements comparison function
+ * @param[inout] data    Optional arbitrary user data
+ *
+ * @return `0` when successful, a negative errno-like return code otherwise.
+ * @retval 0       Success
+ * @retval -ENOMEM Memory allocation failure
+ *
+ * Sort @p array containing @p nr elements of size @p size using the @p compare
+ * comparison function according to the @rstlnk{Array power sort} algorithm.
+ *
+ * Sorting is stable and adapts to existing order: inputs made of a few long
+ * ascending or strictly descending runs are sorted in close to linear time.
+ * An auxiliary buffer of at most `(nr / 2) * size` bytes is allocated when
+ * runs must be merged. When allocation fails, @p array is left partially
+ * sorted.
+ *
+ * The first 2 arguments passed to the @p compare routine both points to
+ * distinct @p array elements.
+ * @p compare *MUST* return an integer less than, equal to, or greater than zero
+ * if first argument is found, respectively, to be less than, to match, or be
+ * greater than the second one.
+ *
+ * The @p compare routine is given @p data as an optional *third* argument
+ * as-is. It may point to arbitrary user data for comparison purposes.
+ *
+ * @note
+ * Refer to @rstlnk{Sorting arrays} for more informations related to algorithm
+ * selection.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * `nr <= 1`, result is undefined. An assertion otherwise.
+ */
+extern int
+stroll_array_power_sort(void * __restrict     array,
+                        unsigned int          nr,
+                        size_t                size,
+                        stroll_array_cmp_fn * compare,
+                        void *                data)
+	__stroll_nonull(1, 4) __warn_result;
+
+#endif /* defined(CONFIG_STROLL_ARRAY_POWER_SORT) */
+
 #if defined(CONFIG_STROLL_ARRAY_FBHEAP_SORT)
 
 extern void
@@ -479,6 +929,320 @@ stroll_array_fwheap_sort(void * __restrict     array,
                          void *                data)
 	__stroll_nonull(1, 4) __warn_result;
 
+/**
+ * Return size of scratch buffer required to weak heap sort an array.
+ *
+ * @param[in] nr Number of array elements
+ *
+ * @return Scratch buffer size in bytes
+ *
+ * Compute the size of the scratch buffer that must be given to
+ * stroll_array_fwheap_sort_with_scratch() to sort an array containing @p nr
+ * elements, i.e. the size of a bitmap holding one bit per element.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * `nr == 0`, result is undefined. An assertion otherwise.
+ *
+ * @see stroll_array_fwheap_sort_with_scratch()
+ */
+extern size_t
+stroll_array_fwheap_sort_scratch_size(unsigned int nr)
+	__stroll_const __warn_result;
+
+/**
+ * Sort an array according to the weak heap sort algorithm using a caller
+ * supplied scratch buffer.
+ *
+ * @param[inout] array   Array to sort
+ * @param[in]    nr      @p array number of elements
+ * @param[in]    size    Size of a single @p array element
+ * @param[in]    compare @p array elements comparison function
+ * @param[inout] data    Optional arbitrary user data
+ * @param[out]   scratch Scratch buffer
+ *
+ * Sort @p array the same way as stroll_array_fwheap_sort() does, except that
+ * the heap reverse bits bitmap is given by the caller thanks to the @p scratch
+ * argument instead of being allocated. This allows to sort multiple arrays in
+ * a row without any memory allocation.
+ *
+ * @p scratch *MUST* point to a buffer at least
+ * stroll_array_fwheap_sort_scratch_size() bytes long, aligned on an
+ * `unsigned long` boundary. Its content is clobbered on return.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * `nr == 0` or @p scratch is misaligned, result is undefined. An assertion
+ * otherwise.
+ *
+ * @see
+ * - stroll_array_fwheap_sort()
+ * - stroll_array_fwheap_sort_scratch_size()
+ */
+extern void
+stroll_array_fwheap_sort_with_scratch(void * __restrict     array,
+                                      unsigned int          nr,
+                                      size_t                size,
+                                      stroll_array_cmp_fn * compare,
+                                      void *                data,
+                                      void * __restrict     scratch)
+	__stroll_nonull(1, 4, 6);
+
 #endif /* defined(CONFIG_STROLL_ARRAY_FWHEAP_SORT) */
 
+#if defined(CONFIG_STROLL_ARRAY_RADIX_SORT)
+
+/**
+ * Sort an array according to the least significant digit radix sort algorithm.
+ *
+ * @param[inout] array    Array to sort
+ * @param[in]    nr       @p array number of elements
+ * @param[in]    size     Size of a single @p array element
+ * @param[in]    key_off  Offset of sorting key from element start
+ * @param[in]    key_size Size of sorting key
+ *
+ * @return `0` when successful, a negative errno-like return code otherwise.
+ * @retval 0       Success
+ * @retval -ENOMEM Memory allocation failure
+ *
+ * Sort @p array containing @p nr elements of size @p size in ascending order of
+ * keys according to the @rstlnk{Array radix sort} algorithm.
+ *
+ * Each element *MUST* embed an unsigned integer sorting key of size
+ * @p key_size, located @p key_off bytes away from element start and stored
+ * according to native byte order. Key is not required to be aligned.
+ * @p key_size *MUST* be one of `1`, `2`, `4` or `8`.
+ *
+ * Sorting is stable and requires an auxiliary buffer of `nr * size` bytes.
+ * Arrays holding a single element are left untouched and no allocation is
+ * performed.
+ *
+ * @note
+ * Refer to @rstlnk{Sorting arrays} for more informations related to algorithm
+ * selection.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * `nr == 0` or key does not fit into element, result is undefined. An
+ * assertion otherwise.
+ *
+ * @see stroll_array_msd_radix_sort()
+ */
+extern int
+stroll_array_radix_sort(void * __restrict array,
+                        unsigned int      nr,
+                        size_t            size,
+                        size_t            key_off,
+                        size_t            key_size)
+	__stroll_nonull(1);
+
+/**
+ * Sort an array according to the most significant digit radix sort algorithm.
+ *
+ * @param[inout] array    Array to sort
+ * @param[in]    nr       @p array number of elements
+ * @param[in]    size     Size of a single @p array element
+ * @param[in]    key_off  Offset of sorting key from element start
+ * @param[in]    key_size Size of sorting key
+ *
+ * Sort @p array containing @p nr elements of size @p size in ascending order of
+ * keys according to the @rstlnk{Array radix sort} algorithm.
+ *
+ * Sorting key requirements are the same as for stroll_array_radix_sort().
+ *
+ * As opposed to stroll_array_radix_sort(), sorting is performed in-place and is
+ * not stable.
+ *
+ * @note
+ * Refer to @rstlnk{Sorting arrays} for more informations related to algorithm
+ * selection.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * `nr == 0` or key does not fit into element, result is undefined. An
+ * assertion otherwise.
+ *
+ * @see stroll_array_radix_sort()
+ */
+extern void
+stroll_array_msd_radix_sort(void * __restrict array,
+                            unsigned int      nr,
+                            size_t            size,
+                            size_t            key_off,
+                            size_t            key_size)
+	__stroll_nonull(1);
+
+#endif /* defined(CONFIG_STROLL_ARRAY_RADIX_SORT) */
+
+#if defined(CONFIG_STROLL_ARRAY_SORTNET)
+
+/**
+ * Maximum number of keys sorting networks may sort.
+ *
+ * @see
+ * - stroll_array_sortnet_u32()
+ * - stroll_array_sortnet_s32()
+ * - stroll_array_sortnet_u64()
+ */
+#define STROLL_ARRAY_SORTNET_MAX (32U)
+
+/**
+ * Instruction set extensions used by array sorting kernels.
+ *
+ * Sorting networks, i.e. stroll_array_sortnet_u32(),
+ * stroll_array_sortnet_s32() and stroll_array_sortnet_u64(), as well as
+ * stroll_array_sort_u32() and stroll_array_sort_u64() vectorized sorts rely
+ * upon kernels optimized for a particular instruction set. At load time, the
+ * most capable instruction set supported by the CPU is selected.
+ *
+ * @see
+ * - stroll_array_get_isa()
+ * - stroll_array_select_isa()
+ */
+enum stroll_array_isa {
+	/** Portable C code. */
+	STROLL_ARRAY_SCALAR_ISA = 0,
+	/** x86-64 SSE 4.2 extension. */
+	STROLL_ARRAY_SSE_ISA,
+	/** x86-64 AVX2 extension. */
+	STROLL_ARRAY_AVX2_ISA,
+	/** x86-64 AVX-512 foundation extension. */
+	STROLL_ARRAY_AVX512_ISA,
+	/** @internal */
+	STROLL_ARRAY_ISA_NR
+};
+
+/**
+ * Return the instruction set used by array sorting kernels.
+ *
+ * @return Instruction set currently in use
+ *
+ * @see stroll_array_select_isa()
+ */
+extern enum stroll_array_isa
+stroll_array_get_isa(void)
+	__stroll_pure __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Select the instruction set used by array sorting kernels.
+ *
+ * @param[in] isa Instruction set to use
+ *
+ * @return an errno-like error code
+ * @retval 0        success
+ * @retval -ENOTSUP @p isa is not supported by the CPU
+ *
+ * Override the instruction set selected at load time. This is mostly useful
+ * for testing and benchmarking purposes.
+ *
+ * @warning
+ * This is not thread safe: it *MUST NOT* be called while other threads may
+ * perform array sorting operations.
+ *
+ * @see stroll_array_get_isa()
+ */
+extern int
+stroll_array_select_isa(enum stroll_array_isa isa)
+	__stroll_nothrow __leaf __warn_result;
+
+/**
+ * Sort a small array of unsigned 32-bit integers.
+ *
+ * @param[inout] keys Array to sort
+ * @param[in]    nr   @p keys number of elements
+ *
+ * Sort @p keys containing @p nr unsigned 32-bit integers in ascending order
+ * according to the @rstlnk{Array sorting networks} algorithm.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * `nr` is zero or greater than #STROLL_ARRAY_SORTNET_MAX, result is undefined.
+ * An assertion otherwise.
+ */
+extern void
+stroll_array_sortnet_u32(uint32_t * __restrict keys, unsigned int nr)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+/**
+ * Sort a small array of signed 32-bit integers.
+ *
+ * @param[inout] keys Array to sort
+ * @param[in]    nr   @p keys number of elements
+ *
+ * Sort @p keys containing @p nr signed 32-bit integers in ascending order
+ * according to the @rstlnk{Array sorting networks} algorithm.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * `nr` is zero or greater than #STROLL_ARRAY_SORTNET_MAX, result is undefined.
+ * An assertion otherwise.
+ */
+extern void
+stroll_array_sortnet_s32(int32_t * __restrict keys, unsigned int nr)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+/**
+ * Sort a small array of unsigned 64-bit integers.
+ *
+ * @param[inout] keys Array to sort
+ * @param[in]    nr   @p keys number of elements
+ *
+ * Sort @p keys containing @p nr unsigned 64-bit integers in ascending order
+ * according to the @rstlnk{Array sorting networks} algorithm.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * `nr` is zero or greater than #STROLL_ARRAY_SORTNET_MAX, result is undefined.
+ * An assertion otherwise.
+ */
+extern void
+stroll_array_sortnet_u64(uint64_t * __restrict keys, unsigned int nr)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+#if defined(CONFIG_STROLL_ARRAY_VQUICK_SORT)
+
+/**
+ * Sort an array of unsigned 32-bit integers.
+ *
+ * @param[inout] keys Array to sort
+ * @param[in]    nr   @p keys number of elements
+ *
+ * Sort @p keys containing @p nr unsigned 32-bit integers in ascending order
+ * according to the @rstlnk{Array vectorized quick sort} algorithm.
+ *
+ * As opposed to other array sorting functions, keys are compared inline
+ * instead of using a #stroll_array_cmp_fn comparison function.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * `nr` is zero, result is undefined. An assertion otherwise.
+ */
+extern void
+stroll_array_sort_u32(uint32_t * __restrict keys, unsigned int nr)
+	__stroll_nonull(1) __stroll_nothrow;
+
+/**
+ * Sort an array of unsigned 64-bit integers.
+ *
+ * @param[inout] keys Array to sort
+ * @param[in]    nr   @p keys number of elements
+ *
+ * Sort @p keys containing @p nr unsigned 64-bit integers in ascending order
+ * according to the @rstlnk{Array vectorized quick sort} algorithm.
+ *
+ * As opposed to other array sorting functions, keys are compared inline
+ * instead of using a #stroll_array_cmp_fn comparison function.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * `nr` is zero, result is undefined. An assertion otherwise.
+ */
+extern void
+stroll_array_sort_u64(uint64_t * __restrict keys, unsigned int nr)
+	__stroll_nonull(1) __stroll_nothrow;
+
+#endif /* defined(CONFIG_STROLL_ARRAY_VQUICK_SORT) */
+
+#endif /* defined(CONFIG_STROLL_ARRAY_SORTNET) */
+
 #endif /* _STROLL_ARRAY_H */
@@ -0,0 +1,391 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+/**
+ * @file
+ * Bloom filter interface
+ *
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      18 Oct 2026
+ * @copyright Copyright (C) 2026 Grégor Boirie.
+ * @license   [GNU Lesser General Public License (LGPL) v3]
+ *            (https://www.gnu.org/licenses/lgpl+gpl-3.0.txt)
+ */
+
+#ifndef _STROLL_BLOOM_H
+#define _STROLL_BLOOM_H
+
+#include <stroll/fbmap.h>
+#include <stdint.h>
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+
+#include <stroll/assert.h>
+
+#define stroll_bloom_assert_api(_expr) \
+	stroll_assert("stroll:bloom", _expr)
+
+#else  /* !defined(CONFIG_STROLL_ASSERT_API) */
+
+#define stroll_bloom_assert_api(_expr)
+
+#endif /* defined(CONFIG_STROLL_ASSERT_API) */
+
+/**
+ * Number of bits held by a single blocked Bloom filter block.
+ *
+ * A blocked Bloom filter confines all bits of a key into a single block sized
+ * after a typical data cache line, i.e. 64 bytes.
+ *
+ * @see stroll_bloom_init_blocked()
+ */
+#define STROLL_BLOOM_BLOCK_BITS (512U)
+
+/**
+ * Maximum number of hash functions a Bloom filter may use.
+ */
+#define STROLL_BLOOM_HASH_MAX   (32U)
+
+/**
+ * Bloom filter.
+ *
+ * A space efficient probabilistic set membership structure built on top of a
+ * stroll_fbmap fixed sized bitmap. Querying a Bloom filter may return false
+ * positives but never false negatives.
+ *
+ * Two flavours are available:
+ * - a standard Bloom filter, where each of the hash functions may address any
+ *   bit of the whole bitmap ;
+ * - a blocked Bloom filter, where all bits of a key lie within a single
+ *   #STROLL_BLOOM_BLOCK_BITS bits cache line aligned block, i.e., each
+ *   insertion / query costs a single cache miss at most at the price of a
+ *   slightly higher false positive rate.
+ *
+ * Keys are 64-bit integers, typically content hashes or object identifiers,
+ * that are mixed using the <stroll/hash.h> multiplicative hashing primitives.
+ *
+ * @see
+ * - stroll_bloom_init()
+ * - stroll_bloom_init_blocked()
+ * - stroll_bloom_fini()
+ */
+struct stroll_bloom {
+	/**
+	 * @internal
+	 *
+	 * Number of hash functions.
+	 */
+	unsigned int        hash_nr;
+	/**
+	 * @internal
+	 *
+	 * Number of #STROLL_BLOOM_BLOCK_BITS bits blocks for blocked filters,
+	 * 0 for standard ones.
+	 */
+	unsigned int        block_nr;
+	/**
+	 * @internal
+	 *
+	 * Underlying bitmap.
+	 */
+	struct stroll_fbmap map;
+};
+
+#define stroll_bloom_assert_filter_api(_bloom) \
+	stroll_bloom_assert_api(_bloom); \
+	stroll_fbmap_assert_map_api(&(_bloom)->map); \
+	stroll_bloom_assert_api((_bloom)->hash_nr); \
+	stroll_bloom_assert_api((_bloom)->hash_nr <= STROLL_BLOOM_HASH_MAX); \
+	stroll_bloom_assert_api(!(_bloom)->block_nr || \
+	                        ((_bloom)->map.nr == \
+	                         ((_bloom)->block_nr * \
+	                          STROLL_BLOOM_BLOCK_BITS)))
+
+/**
+ * Return the number of bits a Bloom filter is made of.
+ *
+ * @param[in] bloom Bloom filter
+ *
+ * @return Number of bits
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+unsigned int
+stroll_bloom_bit_nr(const struct stroll_bloom * __restrict bloom)
+{
+	stroll_bloom_assert_filter_api(bloom);
+
+	return bloom->map.nr;
+}
+
+/**
+ * Return the number of hash functions a Bloom filter uses.
+ *
+ * @param[in] bloom Bloom filter
+ *
+ * @return Number of hash functions
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+unsigned int
+stroll_bloom_hash_nr(const struct stroll_bloom * __restrict bloom)
+{
+	stroll_bloom_assert_filter_api(bloom);
+
+	return bloom->hash_nr;
+}
+
+/**
+ * Test wether a Bloom filter is a blocked one or not.
+ *
+ * @param[in] bloom Bloom filter
+ *
+ * @return Test result
+ * @retval true  @p bloom is a blocked Bloom filter
+ * @retval false @p bloom is a standard Bloom filter
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+bool
+stroll_bloom_is_blocked(const struct stroll_bloom * __restrict bloom)
+{
+	stroll_bloom_assert_filter_api(bloom);
+
+	return !!bloom->block_nr;
+}
+
+/**
+ * Register a key into a Bloom filter.
+ *
+ * @param[inout] bloom Bloom filter
+ * @param[in]    key   Key to register
+ *
+ * @see
+ * - stroll_bloom_insert_batch()
+ * - stroll_bloom_test()
+ */
+extern void
+stroll_bloom_insert(struct stroll_bloom * __restrict bloom, uint64_t key)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+/**
+ * Register multiple keys into a Bloom filter.
+ *
+ * @param[inout] bloom Bloom filter
+ * @param[in]    keys  Array of keys to register
+ * @param[in]    nr    Number of keys in @p keys
+ *
+ * Behaves as if stroll_bloom_insert() were called for each key of @p keys
+ * while prefetching bitmap words / blocks of upcoming keys to hide memory
+ * access latency.
+ *
+ * @see
+ * - stroll_bloom_insert()
+ * - stroll_bloom_test_batch()
+ */
+extern void
+stroll_bloom_insert_batch(struct stroll_bloom * __restrict bloom,
+                          const uint64_t * __restrict      keys,
+                          unsigned int                     nr)
+	__stroll_nonull(1, 2) __stroll_nothrow __leaf;
+
+/**
+ * Test wether a key may have been registered into a Bloom filter.
+ *
+ * @param[in] bloom Bloom filter
+ * @param[in] key   Key to test
+ *
+ * @return Test result
+ * @retval true  @p key may have been registered into @p bloom
+ * @retval false @p key has certainly not been registered into @p bloom
+ *
+ * @see
+ * - stroll_bloom_insert()
+ * - stroll_bloom_test_batch()
+ */
+extern bool
+stroll_bloom_test(const struct stroll_bloom * __restrict bloom, uint64_t key)
+	__stroll_nonull(1) __stroll_pure __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Test wether multiple keys may have been registered into a Bloom filter.
+ *
+ * @param[in]  bloom   Bloom filter
+ * @param[in]  keys    Array of keys to test
+ * @param[in]  nr      Number of keys in @p keys
+ * @param[out] results Array of @p nr test results
+ *
+ * @return Number of keys that may have been registered into @p bloom
+ *
+ * Behaves as if stroll_bloom_test() were called for each key of @p keys while
+ * prefetching bitmap words / blocks of upcoming keys to hide memory access
+ * latency. The result of testing `keys[k]` is stored into `results[k]`.
+ *
+ * @see
+ * - stroll_bloom_test()
+ * - stroll_bloom_insert_batch()
+ */
+extern unsigned int
+stroll_bloom_test_batch(const struct stroll_bloom * __restrict bloom,
+                        const uint64_t * __restrict            keys,
+                        unsigned int                           nr,
+                        bool * __restrict                      results)
+	__stroll_nonull(1, 2, 4) __stroll_nothrow __leaf;
+
+/**
+ * Unregister all keys from a Bloom filter.
+ *
+ * @param[inout] bloom Bloom filter
+ */
+static inline __stroll_nonull(1) __stroll_nothrow
+void
+stroll_bloom_clear(struct stroll_bloom * __restrict bloom)
+{
+	stroll_bloom_assert_filter_api(bloom);
+
+	stroll_fbmap_clear_all(&bloom->map);
+}
+
+/**
+ * Merge keys registered into a Bloom filter into another one.
+ *
+ * @param[inout] result Bloom filter to merge keys into
+ * @param[in]    bloom  Bloom filter to merge keys from
+ *
+ * Once merged, @p result holds the union of keys registered into both
+ * @p result and @p bloom.
+ *
+ * @warning
+ * Both Bloom filters **MUST** share identical geometries, i.e. they must have
+ * been initialized using the same function with the same capacity and false
+ * positive rate. If not, result is undefined when the #CONFIG_STROLL_ASSERT_API
+ * build option is disabled. An assertion is triggered otherwise.
+ *
+ * @see stroll_bloom_intersect()
+ */
+extern void
+stroll_bloom_unite(struct stroll_bloom * __restrict       result,
+                   const struct stroll_bloom * __restrict bloom)
+	__stroll_nonull(1, 2) __stroll_nothrow __leaf;
+
+/**
+ * Intersect keys registered into a Bloom filter with another one.
+ *
+ * @param[inout] result Bloom filter to intersect keys into
+ * @param[in]    bloom  Bloom filter to intersect keys with
+ *
+ * Once intersected, @p result holds an approximation of the intersection of
+ * keys registered into both @p result and @p bloom. Resulting false positive
+ * rate may be higher than the one of a Bloom filter built from the
+ * intersection of both key sets.
+ *
+ * @warning
+ * Both Bloom filters **MUST** share identical geometries. See
+ * stroll_bloom_unite().
+ *
+ * @see stroll_bloom_unite()
+ */
+extern void
+stroll_bloom_intersect(struct stroll_bloom * __restrict       result,
+                       const struct stroll_bloom * __restrict bloom)
+	__stroll_nonull(1, 2) __stroll_nothrow __leaf;
+
+/**
+ * Initialize a standard Bloom filter.
+ *
+ * @param[out] bloom    Bloom filter
+ * @param[in]  capacity Expected maximum number of registered keys
+ * @param[in]  fpr      Expected false positive rate
+ *
+ * @return an errno-like error code
+ * @retval 0       success
+ * @retval -ERANGE bitmap required to satisfy constraints is too large
+ * @retval -ENOMEM memory allocation failed
+ *
+ * Initialize an empty standard Bloom filter sized so that the false positive
+ * rate should not exceed @p fpr as long as no more than @p capacity keys are
+ * registered into it.
+ *
+ * @note
+ * Once client code is done with @p bloom, it *MUST* call stroll_bloom_fini()
+ * to release allocated resources.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * @p capacity is zero or @p fpr does not belong to the ]0, 1[ range, result is
+ * undefined. An assertion is triggered otherwise.
+ *
+ * @see
+ * - stroll_bloom_init_blocked()
+ * - stroll_bloom_fini()
+ */
+extern int
+stroll_bloom_init(struct stroll_bloom * __restrict bloom,
+                  unsigned int                     capacity,
+                  double                           fpr)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Initialize a blocked Bloom filter.
+ *
+ * @param[out] bloom    Bloom filter
+ * @param[in]  capacity Expected maximum number of registered keys
+ * @param[in]  fpr      Expected false positive rate
+ *
+ * @return an errno-like error code
+ * @retval 0       success
+ * @retval -ERANGE bitmap required to satisfy constraints is too large
+ * @retval -ENOMEM memory allocation failed
+ *
+ * Initialize an empty blocked Bloom filter sized according to @p capacity and
+ * @p fpr. Since the number of keys per block varies, a blocked filter requires
+ * more bits than a standard one to achieve the same false positive rate.
+ * Sizing hence starts from the one stroll_bloom_init() computes and grows it
+ * until the blocked Bloom filter false positive rate model meets @p fpr.
+ * The number of hashes is selected to minimize the modeled false positive
+ * rate. Size is always a whole number of #STROLL_BLOOM_BLOCK_BITS bits blocks.
+ * Bitmap is allocated aligned on a #STROLL_BLOOM_BLOCK_BITS bits boundary so
+ * that each block maps onto a single cache line.
+ *
+ * @note
+ * Once client code is done with @p bloom, it *MUST* call stroll_bloom_fini()
+ * to release allocated resources.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * @p capacity is zero or @p fpr does not belong to the ]0, 1[ range, result is
+ * undefined. An assertion is triggered otherwise.
+ *
+ * @see
+ * - stroll_bloom_init()
+ * - stroll_bloom_fini()
+ */
+extern int
+stroll_bloom_init_blocked(struct stroll_bloom * __restrict bloom,
+                          unsigned int                     capacity,
+                          double                           fpr)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Finalize a Bloom filter.
+ *
+ * @param[inout] bloom Bloom filter
+ *
+ * Release resources allocated for @p bloom. Once called, you *MUST NOT* re-use
+ * @p bloom unless re-initialized first.
+ *
+ * @see
+ * - stroll_bloom_init()
+ * - stroll_bloom_init_blocked()
+ */
+static inline __stroll_nonull(1) __stroll_nothrow
+void
+stroll_bloom_fini(struct stroll_bloom * __restrict bloom)
+{
+	stroll_bloom_assert_filter_api(bloom);
+
+	stroll_fbmap_fini(&bloom->map);
+}
+
+#endif /* _STROLL_BLOOM_H */
@@ -2570,6 +2570,489 @@ stroll_bmap_setup_clearul(unsigned long * __restrict bmap)
 
 #endif
 
+/**
+ * Atomically set bits of a 32-bits word bitmap according to mask given in
+ * argument.
+ *
+ * @param[inout] bmap  Bitmap to set
+ * @param[in]    mask  Mask of bits to set
+ * @param[in]    order Memory ordering constraint
+ *
+ * @return Value of @p bmap before modification
+ *
+ * Atomic variant of stroll_bmap_set_mask32() suitable for bitmaps shared
+ * among multiple threads.
+ */
+static inline uint32_t __stroll_nonull(1) __stroll_nothrow
+stroll_bmap_atomic_set_mask32(uint32_t * __restrict    bmap,
+                              uint32_t                 mask,
+                              enum stroll_atomic_order order)
+{
+	stroll_bmap_assert_api(bmap);
+	stroll_bmap_assert_api(stroll_atomic_order_is_valid(order));
+
+	return __atomic_fetch_or(bmap, mask, (int)order);
+}
+
+/**
+ * Atomically clear bits of a 32-bits word bitmap according to mask given
+ * in argument.
+ *
+ * @param[inout] bmap  Bitmap to clear
+ * @param[in]    mask  Mask of bits to clear
+ * @param[in]    order Memory ordering constraint
+ *
+ * @return Value of @p bmap before modification
+ *
+ * Atomic variant of stroll_bmap_clear_mask32() suitable for bitmaps shared
+ * among multiple threads.
+ */
+static inline uint32_t __stroll_nonull(1) __stroll_nothrow
+stroll_bmap_atomic_clear_mask32(uint32_t * __restrict    bmap,
+                                uint32_t                 mask,
+                                enum stroll_atomic_order order)
+{
+	stroll_bmap_assert_api(bmap);
+	stroll_bmap_assert_api(stroll_atomic_order_is_valid(order));
+
+	return __atomic_fetch_and(bmap, ~mask, (int)order);
+}
+
+/**
+ * Atomically set a bit in a 32-bits word bitmap and return its previous
+ * value.
+ *
+ * @param[inout] bmap   Bitmap to set
+ * @param[in]    bit_no Index of bit to set
+ * @param[in]    order  Memory ordering constraint
+ *
+ * @return Previous bit value
+ * @retval true  Bit was already set
+ * @retval false Bit was cleared
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and @p
+ * bit_no is `>= 32`, result is undefined. An assertion is triggered otherwise.
+ */
+static inline bool __stroll_nonull(1) __stroll_nothrow
+stroll_bmap_atomic_test_and_set32(uint32_t * __restrict    bmap,
+                                  unsigned int             bit_no,
+                                  enum stroll_atomic_order order)
+{
+	uint32_t mask;
+
+	stroll_bmap_assert_api(bit_no < 32);
+
+	mask = UINT32_C(1) << bit_no;
+
+	return !!(stroll_bmap_atomic_set_mask32(bmap, mask, order) & mask);
+}
+
+/**
+ * Atomically clear a bit in a 32-bits word bitmap and return its previous
+ * value.
+ *
+ * @param[inout] bmap   Bitmap to clear
+ * @param[in]    bit_no Index of bit to clear
+ * @param[in]    order  Memory ordering constraint
+ *
+ * @return Previous bit value
+ * @retval true  Bit was set
+ * @retval false Bit was already cleared
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and @p
+ * bit_no is `>= 32`, result is undefined. An assertion is triggered otherwise.
+ */
+static inline bool __stroll_nonull(1) __stroll_nothrow
+stroll_bmap_atomic_test_and_clear32(uint32_t * __restrict    bmap,
+                                    unsigned int             bit_no,
+                                    enum stroll_atomic_order order)
+{
+	uint32_t mask;
+
+	stroll_bmap_assert_api(bit_no < 32);
+
+	mask = UINT32_C(1) << bit_no;
+
+	return !!(stroll_bmap_atomic_clear_mask32(bmap, mask, order) & mask);
+}
+
+/**
+ * Atomically compare and exchange a 32-bits word bitmap.
+ *
+ * @param[inout] bmap     Bitmap to update
+ * @param[inout] expected Expected bitmap value
+ * @param[in]    desired  Value to store into @p bmap
+ * @param[in]    order    Memory ordering constraint
+ *
+ * @return Exchange status
+ * @retval true  @p bmap was equal to @p expected and updated to @p desired
+ * @retval false @p bmap content differs and was stored into @p expected
+ *
+ * Failure is performed with the strongest memory ordering compatible with
+ * @p order.
+ */
+static inline bool __stroll_nonull(1, 2) __stroll_nothrow
+stroll_bmap_atomic_cmpxchg32(uint32_t * __restrict    bmap,
+                             uint32_t * __restrict    expected,
+                             uint32_t                 desired,
+                             enum stroll_atomic_order order)
+{
+	stroll_bmap_assert_api(bmap);
+	stroll_bmap_assert_api(expected);
+	stroll_bmap_assert_api(stroll_atomic_order_is_valid(order));
+
+	int fail = (int)stroll_atomic_fail_order(order);
+
+	return __atomic_compare_exchange_n(bmap,
+	                                   expected,
+	                                   desired,
+	                                   false,
+	                                   (int)order,
+	                                   fail);
+}
+
+/**
+ * Atomically set bits of a 64-bits word bitmap according to mask given in
+ * argument.
+ *
+ * @param[inout] bmap  Bitmap to set
+ * @param[in]    mask  Mask of bits to set
+ * @param[in]    order Memory ordering constraint
+ *
+ * @return Value of @p bmap before modification
+ *
+ * Atomic variant of stroll_bmap_set_mask64() suitable for bitmaps shared
+ * among multiple threads.
+ */
+static inline uint64_t __stroll_nonull(1) __stroll_nothrow
+stroll_bmap_atomic_set_mask64(uint64_t * __restrict    bmap,
+                              uint64_t                 mask,
+                              enum stroll_atomic_order order)
+{
+	stroll_bmap_assert_api(bmap);
+	stroll_bmap_assert_api(stroll_atomic_order_is_valid(order));
+
+	return __atomic_fetch_or(bmap, mask, (int)order);
+}
+
+/**
+ * Atomically clear bits of a 64-bits word bitmap according to mask given
+ * in argument.
+ *
+ * @param[inout] bmap  Bitmap to clear
+ * @param[in]    mask  Mask of bits to clear
+ * @param[in]    order Memory ordering constraint
+ *
+ * @return Value of @p bmap before modification
+ *
+ * Atomic variant of stroll_bmap_clear_mask64() suitable for bitmaps shared
+ * among multiple threads.
+ */
+static inline uint64_t __stroll_nonull(1) __stroll_nothrow
+stroll_bmap_atomic_clear_mask64(uint64_t * __restrict    bmap,
+                                uint64_t                 mask,
+                                enum stroll_atomic_order order)
+{
+	stroll_bmap_assert_api(bmap);
+	stroll_bmap_assert_api(stroll_atomic_order_is_valid(order));
+
+	return __atomic_fetch_and(bmap, ~mask, (int)order);
+}
+
+/**
+ * Atomically set a bit in a 64-bits word bitmap and return its previous
+ * value.
+ *
+ * @param[inout] bmap   Bitmap to set
+ * @param[in]    bit_no Index of bit to set
+ * @param[in]    order  Memory ordering constraint
+ *
+ * @return Previous bit value
+ * @retval true  Bit was already set
+ * @retval false Bit was cleared
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and @p
+ * bit_no is `>= 64`, result is undefined. An assertion is triggered otherwise.
+ */
+static inline bool __stroll_nonull(1) __stroll_nothrow
+stroll_bmap_atomic_test_and_set64(uint64_t * __restrict    bmap,
+                                  unsigned int             bit_no,
+                                  enum stroll_atomic_order order)
+{
+	uint64_t mask;
+
+	stroll_bmap_assert_api(bit_no < 64);
+
+	mask = UINT64_C(1) << bit_no;
+
+	return !!(stroll_bmap_atomic_set_mask64(bmap, mask, order) & mask);
+}
+
+/**
+ * Atomically clear a bit in a 64-bits word bitmap and return its previous
+ * value.
+ *
+ * @param[inout] bmap   Bitmap to clear
+ * @param[in]    bit_no Index of bit to clear
+ * @param[in]    order  Memory ordering constraint
+ *
+ * @return Previous bit value
+ * @retval true  Bit was set
+ * @retval false Bit was already cleared
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and @p
+ * bit_no is `>= 64`, result is undefined. An assertion is triggered otherwise.
+ */
+static inline bool __stroll_nonull(1) __stroll_nothrow
+stroll_bmap_atomic_test_and_clear64(uint64_t * __restrict    bmap,
+                                    unsigned int             bit_no,
+                                    enum stroll_atomic_order order)
+{
+	uint64_t mask;
+
+	stroll_bmap_assert_api(bit_no < 64);
+
+	mask = UINT64_C(1) << bit_no;
+
+	return !!(stroll_bmap_atomic_clear_mask64(bmap, mask, order) & mask);
+}
+
+/**
+ * Atomically compare and exchange a 64-bits word bitmap.
+ *
+ * @param[inout] bmap     Bitmap to update
+ * @param[inout] expected Expected bitmap value
+ * @param[in]    desired  Value to store into @p bmap
+ * @param[in]    order    Memory ordering constraint
+ *
+ * @return Exchange status
+ * @retval true  @p bmap was equal to @p expected and updated to @p desired
+ * @retval false @p bmap content differs and was stored into @p expected
+ *
+ * Failure is performed with the strongest memory ordering compatible with
+ * @p order.
+ */
+static inline bool __stroll_nonull(1, 2) __stroll_nothrow
+stroll_bmap_atomic_cmpxchg64(uint64_t * __restrict    bmap,
+                             uint64_t * __restrict    expected,
+                             uint64_t                 desired,
+                             enum stroll_atomic_order order)
+{
+	stroll_bmap_assert_api(bmap);
+	stroll_bmap_assert_api(expected);
+	stroll_bmap_assert_api(stroll_atomic_order_is_valid(order));
+
+	int fail = (int)stroll_atomic_fail_order(order);
+
+	return __atomic_compare_exchange_n(bmap,
+	                                   expected,
+	                                   desired,
+	                                   false,
+	                                   (int)order,
+	                                   fail);
+}
+
+/**
+ * Atomically set bits of a machine word bitmap according to mask given in
+ * argument.
+ *
+ * @param[inout] bmap  Bitmap to set
+ * @param[in]    mask  Mask of bits to set
+ * @param[in]    order Memory ordering constraint
+ *
+ * @return Value of @p bmap before modification
+ *
+ * Atomic variant of stroll_bmap_set_maskul() suitable for bitmaps shared among
+ * multiple threads.
+ */
+#if __WORDSIZE == 64
+
+static inline unsigned long __stroll_nonull(1) __stroll_nothrow
+stroll_bmap_atomic_set_maskul(unsigned long * __restrict bmap,
+                              unsigned long              mask,
+                              enum stroll_atomic_order   order)
+{
+	return stroll_bmap_atomic_set_mask64((uint64_t *)bmap, mask, order);
+}
+
+#elif __WORDSIZE == 32
+
+static inline unsigned long __stroll_nonull(1) __stroll_nothrow
+stroll_bmap_atomic_set_maskul(unsigned long * __restrict bmap,
+                              unsigned long              mask,
+                              enum stroll_atomic_order   order)
+{
+	return stroll_bmap_atomic_set_mask32((uint32_t *)bmap, mask, order);
+}
+
+#endif
+
+/**
+ * Atomically clear bits of a machine word bitmap according to mask given in
+ * argument.
+ *
+ * @param[inout] bmap  Bitmap to clear
+ * @param[in]    mask  Mask of bits to clear
+ * @param[in]    order Memory ordering constraint
+ *
+ * @return Value of @p bmap before modification
+ *
+ * Atomic variant of stroll_bmap_clear_maskul() suitable for bitmaps shared
+ * among multiple threads.
+ */
+#if __WORDSIZE == 64
+
+static inline unsigned long __stroll_nonull(1) __stroll_nothrow
+stroll_bmap_atomic_clear_maskul(unsigned long * __restrict bmap,
+                                unsigned long              mask,
+                                enum stroll_atomic_order   order)
+{
+	return stroll_bmap_atomic_clear_mask64((uint64_t *)bmap, mask, order);
+}
+
+#elif __WORDSIZE == 32
+
+static inline unsigned long __stroll_nonull(1) __stroll_nothrow
+stroll_bmap_atomic_clear_maskul(unsigned long * __restrict bmap,
+                                unsigned long              mask,
+                                enum stroll_atomic_order   order)
+{
+	return stroll_bmap_atomic_clear_mask32((uint32_t *)bmap, mask, order);
+}
+
+#endif
+
+/**
+ * Atomically set a bit in a machine word bitmap and return its previous value.
+ *
+ * @param[inout] bmap   Bitmap to set
+ * @param[in]    bit_no Index of bit to set
+ * @param[in]    order  Memory ordering constraint
+ *
+ * @return Previous bit value
+ * @retval true  Bit was already set
+ * @retval false Bit was cleared
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and @p
+ * bit_no is `>= __WORDSIZE`, result is undefined. An assertion is triggered
+ * otherwise.
+ */
+#if __WORDSIZE == 64
+
+static inline bool __stroll_nonull(1) __stroll_nothrow
+stroll_bmap_atomic_test_and_setul(unsigned long * __restrict bmap,
+                                  unsigned int               bit_no,
+                                  enum stroll_atomic_order   order)
+{
+	return stroll_bmap_atomic_test_and_set64((uint64_t *)bmap,
+	                                         bit_no,
+	                                         order);
+}
+
+#elif __WORDSIZE == 32
+
+static inline bool __stroll_nonull(1) __stroll_nothrow
+stroll_bmap_atomic_test_and_setul(unsigned long * __restrict bmap,
+                                  unsigned int               bit_no,
+                                  enum stroll_atomic_order   order)
+{
+	return stroll_bmap_atomic_test_and_set32((uint32_t *)bmap,
+	                                         bit_no,
+	                                         order);
+}
+
+#endif
+
+/**
+ * Atomically clear a bit in a machine word bitmap and return its previous
+ * value.
+ *
+ * @param[inout] bmap   Bitmap to clear
+ * @param[in]    bit_no Index of bit to clear
+ * @param[in]    order  Memory ordering constraint
+ *
+ * @return Previous bit value
+ * @retval true  Bit was set
+ * @retval false Bit was already cleared
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and @p
+ * bit_no is `>= __WORDSIZE`, result is undefined. An assertion is triggered
+ * otherwise.
+ */
+#if __WORDSIZE == 64
+
+static inline bool __stroll_nonull(1) __stroll_nothrow
+stroll_bmap_atomic_test_and_clearul(unsigned long * __restrict bmap,
+                                    unsigned int               bit_no,
+                                    enum stroll_atomic_order   order)
+{
+	return stroll_bmap_atomic_test_and_clear64((uint64_t *)bmap,
+	                                           bit_no,
+	                                           order);
+}
+
+#elif __WORDSIZE == 32
+
+static inline bool __stroll_nonull(1) __stroll_nothrow
+stroll_bmap_atomic_test_and_clearul(unsigned long * __restrict bmap,
+                                    unsigned int               bit_no,
+                                    enum stroll_atomic_order   order)
+{
+	return stroll_bmap_atomic_test_and_clear32((uint32_t *)bmap,
+	                                           bit_no,
+	                                           order);
+}
+
+#endif
+
+/**
+ * Atomically compare and exchange a machine word bitmap.
+ *
+ * @param[inout] bmap     Bitmap to update
+ * @param[inout] expected Expected bitmap value
+ * @param[in]    desired  Value to store into @p bmap
+ * @param[in]    order    Memory ordering constraint
+ *
+ * @return Exchange status
+ * @retval true  @p bmap was equal to @p expected and updated to @p desired
+ * @retval false @p bmap content differs and was stored into @p expected
+ */
+#if __WORDSIZE == 64
+
+static inline bool __stroll_nonull(1, 2) __stroll_nothrow
+stroll_bmap_atomic_cmpxchgul(unsigned long * __restrict bmap,
+                             unsigned long * __restrict expected,
+                             unsigned long              desired,
+                             enum stroll_atomic_order   order)
+{
+	return stroll_bmap_atomic_cmpxchg64((uint64_t *)bmap,
+	                                    (uint64_t *)expected,
+	                                    desired,
+	                                    order);
+}
+
+#elif __WORDSIZE == 32
+
+static inline bool __stroll_nonull(1, 2) __stroll_nothrow
+stroll_bmap_atomic_cmpxchgul(unsigned long * __restrict bmap,
+                             unsigned long * __restrict expected,
+                             unsigned long              desired,
+                             enum stroll_atomic_order   order)
+{
+	return stroll_bmap_atomic_cmpxchg32((uint32_t *)bmap,
+	                                    (uint32_t *)expected,
+	                                    desired,
+	                                    order);
+}
+
+#endif
+
 static inline int __stroll_nonull(1, 2) __stroll_nothrow
 _stroll_bmap_step_iter32(uint32_t * __restrict     iter,
                          unsigned int * __restrict bit_no)
@@ -1118,6 +1118,59 @@
 #error "Unsupported machine word size !"
 #endif
 
+/**
+ * Memory ordering constraints of atomic operations.
+ *
+ * Memory models atomic operations may be performed with. Values map onto
+ * the memory orders of GCC `__atomic` builtins.
+ *
+ * @see
+ * [GCC Built-in Functions for Memory Model Aware Atomic Operations](https://gcc.gnu.org/onlinedocs/gcc/_005f_005fatomic-Builtins.html)
+ */
+enum stroll_atomic_order {
+	/** No inter-thread ordering constraints. */
+	STROLL_ATOMIC_RELAXED = __ATOMIC_RELAXED,
+	/** Acquire ordering, for operations loading from memory. */
+	STROLL_ATOMIC_ACQUIRE = __ATOMIC_ACQUIRE,
+	/** Release ordering, for operations storing to memory. */
+	STROLL_ATOMIC_RELEASE = __ATOMIC_RELEASE,
+	/** Both acquire and release ordering. */
+	STROLL_ATOMIC_ACQ_REL = __ATOMIC_ACQ_REL,
+	/** Full sequential consistency. */
+	STROLL_ATOMIC_SEQ_CST = __ATOMIC_SEQ_CST
+};
+
+#define stroll_atomic_order_is_valid(_order) \
+	(((_order) == STROLL_ATOMIC_RELAXED) || \
+	 ((_order) == STROLL_ATOMIC_ACQUIRE) || \
+	 ((_order) == STROLL_ATOMIC_RELEASE) || \
+	 ((_order) == STROLL_ATOMIC_ACQ_REL) || \
+	 ((_order) == STROLL_ATOMIC_SEQ_CST))
+
+/*
+ * Return the memory order a failed compare-and-exchange operation should be
+ * performed with given the order of the successful case: it cannot be stronger
+ * than the latter and must not include release semantics.
+ */
+#define stroll_atomic_fail_order(_order) \
+	(((_order) == STROLL_ATOMIC_SEQ_CST) ? \
+	 STROLL_ATOMIC_SEQ_CST : \
+	 ((((_order) == STROLL_ATOMIC_ACQUIRE) || \
+	   ((_order) == STROLL_ATOMIC_ACQ_REL)) ? \
+	  STROLL_ATOMIC_ACQUIRE : STROLL_ATOMIC_RELAXED))
+
+/*
+ * Return the memory order a plain atomic store should be performed with when
+ * part of an operation requested with the given order: acquire semantics do
+ * not apply to stores.
+ */
+#define stroll_atomic_store_order(_order) \
+	(((_order) == STROLL_ATOMIC_SEQ_CST) ? \
+	 STROLL_ATOMIC_SEQ_CST : \
+	 ((((_order) == STROLL_ATOMIC_RELEASE) || \
+	   ((_order) == STROLL_ATOMIC_ACQ_REL)) ? \
+	  STROLL_ATOMIC_RELEASE : STROLL_ATOMIC_RELAXED))
+
 #define __VA_ARGS_COUNT__( _c0,  _c1,  _c2,  _c3,  _c4,  _c5,  _c6,  _c7, \
                            _c8,  _c9, _c10, _c11, _c12, _c13, _c14, _c15, \
                            _c16, _c17, _c18, _c19, _c20, _c21, _c22, _c23, \
@@ -0,0 +1,454 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+/**
+ * @file
+ * Count-Min and Count sketches interface
+ *
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      18 Oct 2026
+ * @copyright Copyright (C) 2026 Grégor Boirie.
+ * @license   [GNU Lesser General Public License (LGPL) v3]
+ *            (https://www.gnu.org/licenses/lgpl+gpl-3.0.txt)
+ */
+
+#ifndef _STROLL_CMSKETCH_H
+#define _STROLL_CMSKETCH_H
+
+#include <stroll/cdefs.h>
+#include <stdint.h>
+#include <errno.h>
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+
+#include <stroll/assert.h>
+
+#define stroll_cmsketch_assert_api(_expr) \
+	stroll_assert("stroll:cmsketch", _expr)
+
+#else  /* !defined(CONFIG_STROLL_ASSERT_API) */
+
+#define stroll_cmsketch_assert_api(_expr)
+
+#endif /* defined(CONFIG_STROLL_ASSERT_API) */
+
+/**
+ * Maximum number of rows of a Count-Min or Count sketch.
+ */
+#define STROLL_CMSKETCH_DEPTH_MAX      (16U)
+
+/**
+ * Minimum base 2 logarithm of the number of counters per row of a Count-Min or
+ * Count sketch.
+ */
+#define STROLL_CMSKETCH_WIDTH_BITS_MIN (4U)
+
+/**
+ * Maximum base 2 logarithm of the number of counters per row of a Count-Min or
+ * Count sketch.
+ */
+#define STROLL_CMSKETCH_WIDTH_BITS_MAX (26U)
+
+/**
+ * Count-Min sketch.
+ *
+ * Estimate the frequency of 64-bit keys registered into it using a fixed amount
+ * of memory. Estimates never underestimate true frequencies and, with
+ * probability `1 - delta`, overestimate them by at most `epsilon` times the
+ * total of all registered counts.
+ *
+ * Layout is a flat row-major array of `depth` rows of `2^width_bits` unsigned
+ * 32-bit saturating counters. Each row is indexed using a distinct hash of the
+ * key derived from <stroll/hash.h> primitives. Sketches sharing the same
+ * dimensions may be merged across threads or processes by counter wise
+ * addition.
+ *
+ * @see
+ * - stroll_cmsketch_init()
+ * - stroll_cmsketch_fini()
+ */
+struct stroll_cmsketch {
+	/**
+	 * @internal
+	 *
+	 * Number of rows.
+	 */
+	unsigned int depth;
+	/**
+	 * @internal
+	 *
+	 * Base 2 logarithm of the number of counters per row.
+	 */
+	unsigned int width_bits;
+	/**
+	 * @internal
+	 *
+	 * Flat array of depth * 2^width_bits counters.
+	 */
+	uint32_t *   counters;
+};
+
+#define stroll_cmsketch_assert_sketch_api(_sketch) \
+	stroll_cmsketch_assert_api(_sketch); \
+	stroll_cmsketch_assert_api((_sketch)->depth); \
+	stroll_cmsketch_assert_api((_sketch)->depth <= \
+	                           STROLL_CMSKETCH_DEPTH_MAX); \
+	stroll_cmsketch_assert_api((_sketch)->width_bits >= \
+	                           STROLL_CMSKETCH_WIDTH_BITS_MIN); \
+	stroll_cmsketch_assert_api((_sketch)->width_bits <= \
+	                           STROLL_CMSKETCH_WIDTH_BITS_MAX); \
+	stroll_cmsketch_assert_api((_sketch)->counters)
+
+/**
+ * Return the number of rows of a Count-Min sketch.
+ *
+ * @param[in] sketch Count-Min sketch
+ *
+ * @return Number of rows
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+unsigned int
+stroll_cmsketch_depth(const struct stroll_cmsketch * __restrict sketch)
+{
+	stroll_cmsketch_assert_sketch_api(sketch);
+
+	return sketch->depth;
+}
+
+/**
+ * Return the number of counters per row of a Count-Min sketch.
+ *
+ * @param[in] sketch Count-Min sketch
+ *
+ * @return Number of counters per row
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+unsigned int
+stroll_cmsketch_width(const struct stroll_cmsketch * __restrict sketch)
+{
+	stroll_cmsketch_assert_sketch_api(sketch);
+
+	return 1U << sketch->width_bits;
+}
+
+/**
+ * Return the counters of a Count-Min sketch.
+ *
+ * @param[in] sketch Count-Min sketch
+ *
+ * @return Flat row-major array of stroll_cmsketch_depth() rows of
+ *         stroll_cmsketch_width() counters
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+const uint32_t *
+stroll_cmsketch_counters(const struct stroll_cmsketch * __restrict sketch)
+{
+	stroll_cmsketch_assert_sketch_api(sketch);
+
+	return sketch->counters;
+}
+
+/**
+ * Register occurrences of a key into a Count-Min sketch.
+ *
+ * @param[inout] sketch Count-Min sketch
+ * @param[in]    key    Key to register
+ * @param[in]    count  Number of occurrences of @p key
+ *
+ * Counters saturate to UINT32_MAX.
+ *
+ * @see stroll_cmsketch_estimate()
+ */
+extern void
+stroll_cmsketch_update(struct stroll_cmsketch * __restrict sketch,
+                       uint64_t                            key,
+                       uint32_t                            count)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+/**
+ * Estimate the number of occurrences of a key registered into a Count-Min
+ * sketch.
+ *
+ * @param[in] sketch Count-Min sketch
+ * @param[in] key    Key to estimate frequency for
+ *
+ * @return Estimated number of occurrences, never lower than the real one
+ *
+ * @see stroll_cmsketch_update()
+ */
+extern uint32_t
+stroll_cmsketch_estimate(const struct stroll_cmsketch * __restrict sketch,
+                         uint64_t                                  key)
+	__stroll_nonull(1) __stroll_pure __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Merge Count-Min sketches.
+ *
+ * @param[inout] result Count-Min sketch to merge into
+ * @param[in]    sketch Count-Min sketch to merge
+ *
+ * Add counters of @p sketch to @p result so that @p result estimates
+ * frequencies of keys registered into both sketches.
+ *
+ * @warning
+ * Both sketches *MUST* share the same dimensions.
+ */
+extern void
+stroll_cmsketch_merge(struct stroll_cmsketch * __restrict       result,
+                      const struct stroll_cmsketch * __restrict sketch)
+	__stroll_nonull(1, 2) __stroll_nothrow __leaf;
+
+/**
+ * Unregister all keys from a Count-Min sketch.
+ *
+ * @param[inout] sketch Count-Min sketch
+ */
+extern void
+stroll_cmsketch_clear(struct stroll_cmsketch * __restrict sketch)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+/**
+ * Initialize a Count-Min sketch.
+ *
+ * @param[out] sketch Count-Min sketch
+ * @param[in]  epsilon Expected maximum error relative to the total count
+ * @param[in]  delta   Expected probability of exceeding @p epsilon
+ *
+ * @return an errno-like error code
+ * @retval 0       success
+ * @retval -ERANGE constraints cannot be satisfied
+ * @retval -ENOMEM memory allocation failed
+ *
+ * Initialize an empty Count-Min sketch made of `ceil(ln(1 / delta))` rows of
+ * `e / epsilon` counters rounded up to the next power of 2.
+ *
+ * @note
+ * Once client code is done with @p sketch, it *MUST* call
+ * stroll_cmsketch_fini() to release allocated resources.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * either @p epsilon or @p delta does not belong to the ]0, 1[ range, result is
+ * undefined. An assertion is triggered otherwise.
+ *
+ * @see stroll_cmsketch_fini()
+ */
+extern int
+stroll_cmsketch_init(struct stroll_cmsketch * __restrict sketch,
+                     double                              epsilon,
+                     double                              delta)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Finalize a Count-Min sketch.
+ *
+ * @param[inout] sketch Count-Min sketch
+ *
+ * Release resources allocated for @p sketch. Once called, you *MUST NOT*
+ * re-use @p sketch unless re-initialized first.
+ *
+ * @see stroll_cmsketch_init()
+ */
+extern void
+stroll_cmsketch_fini(struct stroll_cmsketch * __restrict sketch)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+/**
+ * Count sketch.
+ *
+ * Estimate the frequency of 64-bit keys registered into it using a fixed amount
+ * of memory. Unlike Count-Min sketches, estimates are unbiased and may be
+ * lower than true frequencies. With probability `1 - delta`, the estimation
+ * error is bounded by `epsilon` times the euclidean norm of the frequency
+ * vector which is much tighter than Count-Min bounds for skewed distributions.
+ * Negative counts, i.e. removal of occurrences, are supported.
+ *
+ * Layout is a flat row-major array of an odd number `depth` rows of
+ * `2^width_bits` signed 32-bit counters. Each row is indexed using a distinct
+ * hash of the key which also selects the sign of the counter update. Sketches
+ * sharing the same dimensions may be merged across threads or processes by
+ * counter wise addition.
+ *
+ * @see
+ * - stroll_csketch_init()
+ * - stroll_csketch_fini()
+ */
+struct stroll_csketch {
+	/**
+	 * @internal
+	 *
+	 * Number of rows.
+	 */
+	unsigned int depth;
+	/**
+	 * @internal
+	 *
+	 * Base 2 logarithm of the number of counters per row.
+	 */
+	unsigned int width_bits;
+	/**
+	 * @internal
+	 *
+	 * Flat array of depth * 2^width_bits counters.
+	 */
+	int32_t *    counters;
+};
+
+/**
+ * Return the number of rows of a Count sketch.
+ *
+ * @param[in] sketch Count sketch
+ *
+ * @return Number of rows
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+unsigned int
+stroll_csketch_depth(const struct stroll_csketch * __restrict sketch)
+{
+	stroll_cmsketch_assert_sketch_api(sketch);
+
+	return sketch->depth;
+}
+
+/**
+ * Return the number of counters per row of a Count sketch.
+ *
+ * @param[in] sketch Count sketch
+ *
+ * @return Number of counters per row
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+unsigned int
+stroll_csketch_width(const struct stroll_csketch * __restrict sketch)
+{
+	stroll_cmsketch_assert_sketch_api(sketch);
+
+	return 1U << sketch->width_bits;
+}
+
+/**
+ * Return the counters of a Count sketch.
+ *
+ * @param[in] sketch Count sketch
+ *
+ * @return Flat row-major array of stroll_csketch_depth() rows of
+ *         stroll_csketch_width() counters
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+const int32_t *
+stroll_csketch_counters(const struct stroll_csketch * __restrict sketch)
+{
+	stroll_cmsketch_assert_sketch_api(sketch);
+
+	return sketch->counters;
+}
+
+/**
+ * Register occurrences of a key into a Count sketch.
+ *
+ * @param[inout] sketch Count sketch
+ * @param[in]    key    Key to register
+ * @param[in]    count  Number of occurrences of @p key, may be negative
+ *
+ * @see stroll_csketch_estimate()
+ */
+extern void
+stroll_csketch_update(struct stroll_csketch * __restrict sketch,
+                      uint64_t                           key,
+                      int32_t                            count)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+/**
+ * Estimate the number of occurrences of a key registered into a Count sketch.
+ *
+ * @param[in] sketch Count sketch
+ * @param[in] key    Key to estimate frequency for
+ *
+ * @return Estimated number of occurrences, i.e. median of row estimates
+ *
+ * @see stroll_csketch_update()
+ */
+extern int32_t
+stroll_csketch_estimate(const struct stroll_csketch * __restrict sketch,
+                        uint64_t                                 key)
+	__stroll_nonull(1) __stroll_pure __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Merge Count sketches.
+ *
+ * @param[inout] result Count sketch to merge into
+ * @param[in]    sketch Count sketch to merge
+ *
+ * Add counters of @p sketch to @p result so that @p result estimates
+ * frequencies of keys registered into both sketches.
+ *
+ * @warning
+ * Both sketches *MUST* share the same dimensions.
+ */
+extern void
+stroll_csketch_merge(struct stroll_csketch * __restrict       result,
+                     const struct stroll_csketch * __restrict sketch)
+	__stroll_nonull(1, 2) __stroll_nothrow __leaf;
+
+/**
+ * Unregister all keys from a Count sketch.
+ *
+ * @param[inout] sketch Count sketch
+ */
+extern void
+stroll_csketch_clear(struct stroll_csketch * __restrict sketch)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+/**
+ * Initialize a Count sketch.
+ *
+ * @param[out] sketch Count sketch
+ * @param[in]  epsilon Expected maximum error relative to the euclidean norm of
+ *                     the frequency vector
+ * @param[in]  delta   Expected probability of exceeding @p epsilon
+ *
+ * @return an errno-like error code
+ * @retval 0       success
+ * @retval -ERANGE constraints cannot be satisfied
+ * @retval -ENOMEM memory allocation failed
+ *
+ * Initialize an empty Count sketch made of `ceil(ln(1 / delta))` rows, rounded
+ * up to the next odd number, of `3 / epsilon^2` counters rounded up to the next
+ * power of 2.
+ *
+ * @note
+ * Once client code is done with @p sketch, it *MUST* call
+ * stroll_csketch_fini() to release allocated resources.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * either @p epsilon or @p delta does not belong to the ]0, 1[ range, result is
+ * undefined. An assertion is triggered otherwise.
+ *
+ * @see stroll_csketch_fini()
+ */
+extern int
+stroll_csketch_init(struct stroll_csketch * __restrict sketch,
+                    double                             epsilon,
+                    double                             delta)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Finalize a Count sketch.
+ *
+ * @param[inout] sketch Count sketch
+ *
+ * Release resources allocated for @p sketch. Once called, you *MUST NOT*
+ * re-use @p sketch unless re-initialized first.
+ *
+ * @see stroll_csketch_init()
+ */
+extern void
+stroll_csketch_fini(struct stroll_csketch * __restrict sketch)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+#endif /* _STROLL_CMSKETCH_H */
@@ -0,0 +1,293 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+/**
+ * @file
+ * Cuckoo filter interface
+ *
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      18 Oct 2026
+ * @copyright Copyright (C) 2026 Grégor Boirie.
+ * @license   [GNU Lesser General Public License (LGPL) v3]
+ *            (https://www.gnu.org/licenses/lgpl+gpl-3.0.txt)
+ */
+
+#ifndef _STROLL_CUCKOO_H
+#define _STROLL_CUCKOO_H
+
+#include <stroll/cdefs.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <errno.h>
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+
+#include <stroll/assert.h>
+
+#define stroll_cuckoo_assert_api(_expr) \
+	stroll_assert("stroll:cuckoo", _expr)
+
+#else  /* !defined(CONFIG_STROLL_ASSERT_API) */
+
+#define stroll_cuckoo_assert_api(_expr)
+
+#endif /* defined(CONFIG_STROLL_ASSERT_API) */
+
+/**
+ * Number of fingerprint slots per cuckoo filter bucket.
+ */
+#define STROLL_CUCKOO_BUCKET_SLOTS (4U)
+
+/**
+ * Maximum number of fingerprint relocations performed at insertion time.
+ *
+ * @see stroll_cuckoo_insert()
+ */
+#define STROLL_CUCKOO_KICK_MAX     (500U)
+
+/**
+ * Cuckoo filter.
+ *
+ * A probabilistic set membership structure which, unlike a Bloom filter,
+ * supports deletion of previously registered keys. Querying a cuckoo filter
+ * may return false positives but never false negatives.
+ *
+ * Keys are 64-bit integers mixed using the <stroll/hash.h> multiplicative
+ * hashing primitives into a non-zero fingerprint stored into one of 2
+ * candidate buckets (partial-key cuckoo hashing).
+ *
+ * Fingerprints are stored into a flat array of power of 2 number of buckets,
+ * each made of #STROLL_CUCKOO_BUCKET_SLOTS 8, 16 or 32 bits wide slots. A zero
+ * slot value denotes an empty slot.
+ *
+ * @see
+ * - stroll_cuckoo_init()
+ * - stroll_cuckoo_fini()
+ */
+struct stroll_cuckoo {
+	/**
+	 * @internal
+	 *
+	 * Number of fingerprints currently registered.
+	 */
+	unsigned int nr;
+	/**
+	 * @internal
+	 *
+	 * Base 2 logarithm of the number of buckets.
+	 */
+	unsigned int bucket_bits;
+	/**
+	 * @internal
+	 *
+	 * Number of bits a fingerprint is made of, i.e. 8, 16 or 32.
+	 */
+	unsigned int fp_bits;
+	/**
+	 * @internal
+	 *
+	 * Flat array of fingerprint slots.
+	 */
+	void *       slots;
+};
+
+#define stroll_cuckoo_assert_filter_api(_cuckoo) \
+	stroll_cuckoo_assert_api(_cuckoo); \
+	stroll_cuckoo_assert_api((_cuckoo)->slots); \
+	stroll_cuckoo_assert_api((_cuckoo)->bucket_bits); \
+	stroll_cuckoo_assert_api(((_cuckoo)->fp_bits == 8) || \
+	                         ((_cuckoo)->fp_bits == 16) || \
+	                         ((_cuckoo)->fp_bits == 32)); \
+	stroll_cuckoo_assert_api((_cuckoo)->nr <= \
+	                         ((STROLL_CUCKOO_BUCKET_SLOTS << \
+	                           (_cuckoo)->bucket_bits)))
+
+/**
+ * Return the number of keys registered into a cuckoo filter.
+ *
+ * @param[in] cuckoo Cuckoo filter
+ *
+ * @return Number of registered keys
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+unsigned int
+stroll_cuckoo_nr(const struct stroll_cuckoo * __restrict cuckoo)
+{
+	stroll_cuckoo_assert_filter_api(cuckoo);
+
+	return cuckoo->nr;
+}
+
+/**
+ * Return the number of fingerprint slots of a cuckoo filter.
+ *
+ * @param[in] cuckoo Cuckoo filter
+ *
+ * @return Number of slots
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+unsigned int
+stroll_cuckoo_slot_nr(const struct stroll_cuckoo * __restrict cuckoo)
+{
+	stroll_cuckoo_assert_filter_api(cuckoo);
+
+	return STROLL_CUCKOO_BUCKET_SLOTS << cuckoo->bucket_bits;
+}
+
+/**
+ * Return the number of bits a cuckoo filter fingerprint is made of.
+ *
+ * @param[in] cuckoo Cuckoo filter
+ *
+ * @return Number of bits, i.e. 8, 16 or 32
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+unsigned int
+stroll_cuckoo_fp_bits(const struct stroll_cuckoo * __restrict cuckoo)
+{
+	stroll_cuckoo_assert_filter_api(cuckoo);
+
+	return cuckoo->fp_bits;
+}
+
+/**
+ * Register a key into a cuckoo filter.
+ *
+ * @param[inout] cuckoo Cuckoo filter
+ * @param[in]    key    Key to register
+ *
+ * @return an errno-like error code
+ * @retval 0       success
+ * @retval -ENOSPC filter is too loaded to register @p key
+ *
+ * When both candidate buckets of @p key are full, up to
+ * #STROLL_CUCKOO_KICK_MAX registered fingerprints are relocated to their
+ * alternate bucket to make room for @p key. When no room could be found, all
+ * relocations are undone and @p cuckoo is left unmodified.
+ *
+ * @note
+ * Registering the same key multiple times stores multiple copies of its
+ * fingerprint, each of which must be deleted separately.
+ *
+ * @see
+ * - stroll_cuckoo_test()
+ * - stroll_cuckoo_delete()
+ */
+extern int
+stroll_cuckoo_insert(struct stroll_cuckoo * __restrict cuckoo, uint64_t key)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Test wether a key may have been registered into a cuckoo filter.
+ *
+ * @param[in] cuckoo Cuckoo filter
+ * @param[in] key    Key to test
+ *
+ * @return Test result
+ * @retval true  @p key may have been registered into @p cuckoo
+ * @retval false @p key has certainly not been registered into @p cuckoo
+ *
+ * @see
+ * - stroll_cuckoo_insert()
+ * - stroll_cuckoo_delete()
+ */
+extern bool
+stroll_cuckoo_test(const struct stroll_cuckoo * __restrict cuckoo,
+                   uint64_t                                key)
+	__stroll_nonull(1) __stroll_pure __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Unregister a key from a cuckoo filter.
+ *
+ * @param[inout] cuckoo Cuckoo filter
+ * @param[in]    key    Key to unregister
+ *
+ * @return an errno-like error code
+ * @retval 0       success
+ * @retval -ENOENT no fingerprint matching @p key found
+ *
+ * @warning
+ * Only keys that have previously been registered into @p cuckoo may be
+ * deleted. Deleting a key that was never registered may remove the
+ * fingerprint of another key sharing the same fingerprint and bucket, leading
+ * to false negatives.
+ *
+ * @see
+ * - stroll_cuckoo_insert()
+ * - stroll_cuckoo_test()
+ */
+extern int
+stroll_cuckoo_delete(struct stroll_cuckoo * __restrict cuckoo, uint64_t key)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+/**
+ * Unregister all keys from a cuckoo filter.
+ *
+ * @param[inout] cuckoo Cuckoo filter
+ */
+extern void
+stroll_cuckoo_clear(struct stroll_cuckoo * __restrict cuckoo)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+/**
+ * Initialize a cuckoo filter.
+ *
+ * @param[out] cuckoo   Cuckoo filter
+ * @param[in]  capacity Expected maximum number of registered keys
+ * @param[in]  fpr      Expected false positive rate
+ *
+ * @return an errno-like error code
+ * @retval 0       success
+ * @retval -ERANGE constraints cannot be satisfied
+ * @retval -ENOMEM memory allocation failed
+ *
+ * Initialize an empty cuckoo filter sized so that the false positive rate
+ * should not exceed @p fpr as long as no more than @p capacity keys are
+ * registered into it.
+ *
+ * Fingerprint width is the smallest of 8, 16 or 32 bits satisfying @p fpr
+ * given that the false positive rate of a cuckoo filter is bounded by
+ * `2 * STROLL_CUCKOO_BUCKET_SLOTS / 2^fp_bits`. The number of buckets is the
+ * smallest power of 2 allowing to store @p capacity fingerprints under a 95%
+ * load factor.
+ *
+ * 8-bit fingerprints are restricted to filters holding at most 128 buckets
+ * since larger tables could not reach this load factor otherwise. Bigger
+ * filters use fingerprints at least 16 bits wide whatever @p fpr is.
+ *
+ * @note
+ * Once client code is done with @p cuckoo, it *MUST* call stroll_cuckoo_fini()
+ * to release allocated resources.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * @p capacity is zero or @p fpr does not belong to the ]0, 1[ range, result is
+ * undefined. An assertion is triggered otherwise.
+ *
+ * @see stroll_cuckoo_fini()
+ */
+extern int
+stroll_cuckoo_init(struct stroll_cuckoo * __restrict cuckoo,
+                   unsigned int                      capacity,
+                   double                            fpr)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Finalize a cuckoo filter.
+ *
+ * @param[inout] cuckoo Cuckoo filter
+ *
+ * Release resources allocated for @p cuckoo. Once called, you *MUST NOT*
+ * re-use @p cuckoo unless re-initialized first.
+ *
+ * @see stroll_cuckoo_init()
+ */
+extern void
+stroll_cuckoo_fini(struct stroll_cuckoo * __restrict cuckoo)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+#endif /* _STROLL_CUCKOO_H */
@@ -21,6 +21,7 @@
 
 #include <stroll/cdefs.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
@@ -122,6 +123,69 @@ stroll_fbmap_nr(const struct stroll_fbmap * __restrict bmap)
 	return bmap->nr;
 }
 
+#if defined(CONFIG_STROLL_FBMAP_SIMD)
+
+/**
+ * Instruction set extensions used by fixed sized bitmap bulk operations.
+ *
+ * Bulk operations, i.e. stroll_fbmap_hweight(), stroll_fbmap_test_range(),
+ * stroll_fbmap_test_all(), stroll_fbmap_toggle_all() as well as operations
+ * combining 2 bitmaps such as stroll_fbmap_and() or stroll_fbmap_is_subset(),
+ * rely upon kernels optimized for a particular instruction set. At load time,
+ * the most capable instruction set supported by the CPU is selected.
+ *
+ * @see
+ * - stroll_fbmap_get_isa()
+ * - stroll_fbmap_select_isa()
+ */
+enum stroll_fbmap_isa {
+	/** Portable C code. */
+	STROLL_FBMAP_SCALAR_ISA = 0,
+	/** x86-64 SSE 4.2 and POPCNT extensions. */
+	STROLL_FBMAP_SSE_ISA,
+	/** x86-64 AVX2 extension. */
+	STROLL_FBMAP_AVX2_ISA,
+	/** x86-64 AVX-512 Foundation and VPOPCNTDQ extensions. */
+	STROLL_FBMAP_AVX512_ISA,
+	/** @internal */
+	STROLL_FBMAP_ISA_NR
+};
+
+/**
+ * Return the instruction set used by fixed sized bitmap bulk operations.
+ *
+ * @return Instruction set currently in use
+ *
+ * @see stroll_fbmap_select_isa()
+ */
+extern enum stroll_fbmap_isa
+stroll_fbmap_get_isa(void)
+	__stroll_pure __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Select the instruction set used by fixed sized bitmap bulk operations.
+ *
+ * @param[in] isa Instruction set to use
+ *
+ * @return an errno-like error code
+ * @retval 0        success
+ * @retval -ENOTSUP @p isa is not supported by the CPU
+ *
+ * Override the instruction set selected at load time. This is mostly useful
+ * for testing and benchmarking purposes.
+ *
+ * @warning
+ * This is not thread safe: it *MUST NOT* be called while other threads may
+ * perform fixed sized bitmap bulk operations.
+ *
+ * @see stroll_fbmap_get_isa()
+ */
+extern int
+stroll_fbmap_select_isa(enum stroll_fbmap_isa isa)
+	__stroll_nothrow __leaf __warn_result;
+
+#endif /* defined(CONFIG_STROLL_FBMAP_SIMD) */
+
 extern unsigned int
 _stroll_fbmap_hweight(const unsigned long * __restrict bits, unsigned int nr)
 	__stroll_nonull(1) __stroll_pure __stroll_nothrow __leaf __warn_result;
@@ -453,367 +517,1772 @@ stroll_fbmap_toggle_all(struct stroll_fbmap * __restrict bmap)
 	return _stroll_fbmap_toggle_all(bmap->bits, bmap->nr);
 }
 
-extern unsigned long *
-_stroll_fbmap_create_bits_clear(unsigned int bit_nr)
-	__stroll_nothrow __leaf __warn_result;
+#define stroll_fbmap_assert_compat_api(_first, _second) \
+	stroll_fbmap_assert_map_api(_first); \
+	stroll_fbmap_assert_map_api(_second); \
+	stroll_fbmap_assert_api((_first)->nr == (_second)->nr)
+
+extern void
+_stroll_fbmap_and(unsigned long *       result,
+                  const unsigned long * first,
+                  const unsigned long * second,
+                  unsigned int          nr)
+	__stroll_nonull(1, 2, 3) __stroll_nothrow __leaf;
 
 /**
- * Zero-initialize fixed sized bitmap.
+ * Compute the intersection of 2 fixed sized bitmaps.
  *
- * @param[out] bmap   Fixed sized bitmap
- * @param[in]  bit_nr Maximum number of bits @p bmap may hold
- *
- * @return an errno-like error code
- * @retval 0       success
- * @retval -ENOMEM memory allocation failed
+ * @param[out] result Bitmap to store result into
+ * @param[in]  first  First operand bitmap
+ * @param[in]  second Second operand bitmap
  *
- * Initialize the @p bmap fixed sized bitmap with all bits cleared.
+ * Set bits of @p result which are set into both @p first and @p second
+ * bitmaps and clear all others, i.e. `result = first & second`.
  *
- * @note
- * Once client code is done with @p bmap, it *MUST* call stroll_fbmap_fini() to
- * release allocated resources.
+ * @p result may refer to one of @p first or @p second operands.
  *
  * @warning
- * - When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
- *   @p bit_nr > `INT_MAX` result is undefined. An assertion is triggered
- *   otherwise.
+ * All 3 bitmaps **MUST** hold the same number of bits. If not, result is
+ * undefined when the #CONFIG_STROLL_ASSERT_API build option is disabled. An
+ * assertion is triggered otherwise.
  *
  * @see
- * - stroll_fbmap_init_set()
- * - stroll_fbmap_init_dup()
- * - stroll_fbmap_fini()
+ * - stroll_fbmap_andnot()
+ * - stroll_fbmap_hweight_and()
+ * - stroll_fbmap_intersects()
  */
-extern int
-stroll_fbmap_init_clear(struct stroll_fbmap * __restrict bmap,
-                        unsigned int                     bit_nr)
-	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+static inline __stroll_nonull(1, 2, 3) __stroll_nothrow
+void
+stroll_fbmap_and(struct stroll_fbmap *       result,
+                const struct stroll_fbmap * first,
+                const struct stroll_fbmap * second)
+{
+	stroll_fbmap_assert_compat_api(result, first);
+	stroll_fbmap_assert_compat_api(result, second);
 
-extern unsigned long *
-_stroll_fbmap_create_bits_set(unsigned int bit_nr)
-	__stroll_nothrow __leaf __warn_result;
+	_stroll_fbmap_and(result->bits, first->bits, second->bits, result->nr);
+}
+
+extern void
+_stroll_fbmap_or(unsigned long *       result,
+                 const unsigned long * first,
+                 const unsigned long * second,
+                 unsigned int          nr)
+	__stroll_nonull(1, 2, 3) __stroll_nothrow __leaf;
 
 /**
- * Initialize fixed sized bitmap with all bits set.
- *
- * @param[out] bmap   Fixed sized bitmap
- * @param[in]  bit_nr Maximum number of bits @p bmap may hold
+ * Compute the union of 2 fixed sized bitmaps.
  *
- * @return an errno-like error code
- * @retval 0       success
- * @retval -ENOMEM memory allocation failed
+ * @param[out] result Bitmap to store result into
+ * @param[in]  first  First operand bitmap
+ * @param[in]  second Second operand bitmap
  *
- * Initialize the @p bmap fixed sized bitmap with all bits set.
+ * Set bits of @p result which are set into either @p first or @p second
+ * bitmaps and clear all others, i.e. `result = first | second`.
  *
- * @note
- * Once client code is done with @p bmap, it *MUST* call stroll_fbmap_fini() to
- * release allocated resources.
+ * @p result may refer to one of @p first or @p second operands.
  *
  * @warning
- * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
- * @p bit_nr > `INT_MAX` result is undefined. An assertion is triggered
- * otherwise.
+ * All 3 bitmaps **MUST** hold the same number of bits. If not, result is
+ * undefined when the #CONFIG_STROLL_ASSERT_API build option is disabled. An
+ * assertion is triggered otherwise.
  *
  * @see
- * - stroll_fbmap_init_clear()
- * - stroll_fbmap_init_dup()
- * - stroll_fbmap_fini()
+ * - stroll_fbmap_and()
+ * - stroll_fbmap_xor()
  */
-extern int
-stroll_fbmap_init_set(struct stroll_fbmap * __restrict bmap,
-                      unsigned int                     bit_nr)
-	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+static inline __stroll_nonull(1, 2, 3) __stroll_nothrow
+void
+stroll_fbmap_or(struct stroll_fbmap *       result,
+               const struct stroll_fbmap * first,
+               const struct stroll_fbmap * second)
+{
+	stroll_fbmap_assert_compat_api(result, first);
+	stroll_fbmap_assert_compat_api(result, second);
 
-extern unsigned long *
-_stroll_fbmap_create_bits_dup(unsigned long * __restrict src,
-                              unsigned int               bit_nr)
-	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+	_stroll_fbmap_or(result->bits, first->bits, second->bits, result->nr);
+}
+
+extern void
+_stroll_fbmap_xor(unsigned long *       result,
+                  const unsigned long * first,
+                  const unsigned long * second,
+                  unsigned int          nr)
+	__stroll_nonull(1, 2, 3) __stroll_nothrow __leaf;
 
 /**
- * Initialize fixed sized bitmap using the content of another stroll_fbmap.
+ * Compute the symmetric difference of 2 fixed sized bitmaps.
  *
- * @param[out] bmap  Fixed sized bitmap
- * @param[in]  src   Fixed sized bitmap to initialize @p bmap with
+ * @param[out] result Bitmap to store result into
+ * @param[in]  first  First operand bitmap
+ * @param[in]  second Second operand bitmap
  *
- * @return an errno-like error code
- * @retval 0       success
- * @retval -ENOMEM memory allocation failed
+ * Set bits of @p result which are set into exactly one of @p first and
+ * @p second bitmaps and clear all others, i.e. `result = first ^ second`.
  *
- * Initialize the @p bmap fixed sized bitmap with all bits set to values of @p
- * src bitmap.
+ * @p result may refer to one of @p first or @p second operands.
  *
- * @note
- * Once client code is done with @p bmap, it *MUST* call stroll_fbmap_fini() to
- * release allocated resources.
+ * @warning
+ * All 3 bitmaps **MUST** hold the same number of bits. If not, result is
+ * undefined when the #CONFIG_STROLL_ASSERT_API build option is disabled. An
+ * assertion is triggered otherwise.
  *
  * @see
- * - stroll_fbmap_init_clear()
- * - stroll_fbmap_init_set()
- * - stroll_fbmap_fini()
+ * - stroll_fbmap_or()
+ * - stroll_fbmap_andnot()
  */
-extern int
-stroll_fbmap_init_dup(struct stroll_fbmap * __restrict       bmap,
-                      const struct stroll_fbmap * __restrict src)
-	__stroll_nonull(1, 2) __stroll_nothrow __leaf __warn_result;
-
-static inline __stroll_nonull(1) __stroll_nothrow
+static inline __stroll_nonull(1, 2, 3) __stroll_nothrow
 void
-_stroll_fbmap_destroy_bits(unsigned long * bits)
+stroll_fbmap_xor(struct stroll_fbmap *       result,
+                const struct stroll_fbmap * first,
+                const struct stroll_fbmap * second)
 {
-	stroll_fbmap_assert_api(bits);
+	stroll_fbmap_assert_compat_api(result, first);
+	stroll_fbmap_assert_compat_api(result, second);
 
-	free(bits);
+	_stroll_fbmap_xor(result->bits, first->bits, second->bits, result->nr);
 }
 
+extern void
+_stroll_fbmap_andnot(unsigned long *       result,
+                     const unsigned long * first,
+                     const unsigned long * second,
+                     unsigned int          nr)
+	__stroll_nonull(1, 2, 3) __stroll_nothrow __leaf;
+
 /**
- * Finalize a fixed sized bitmap.
+ * Compute the difference of 2 fixed sized bitmaps.
  *
- * @param[inout] bmap Fixed sized bitmap
+ * @param[out] result Bitmap to store result into
+ * @param[in]  first  First operand bitmap
+ * @param[in]  second Second operand bitmap
  *
- * Release resources allocated for @p bmap. Once called, you *MUST NOT* re-use
- * @p bmap unless re-initialized first.
+ * Set bits of @p result which are set into @p first but not into
+ * @p second bitmap and clear all others, i.e. `result = first & ~second`.
+ *
+ * @p result may refer to one of @p first or @p second operands.
+ *
+ * @warning
+ * All 3 bitmaps **MUST** hold the same number of bits. If not, result is
+ * undefined when the #CONFIG_STROLL_ASSERT_API build option is disabled. An
+ * assertion is triggered otherwise.
  *
  * @see
- * - stroll_fbmap_init_set()
- * - stroll_fbmap_init_clear()
- * - stroll_fbmap_init_dup()
+ * - stroll_fbmap_and()
+ * - stroll_fbmap_is_subset()
  */
-static inline __stroll_nonull(1) __stroll_nothrow
+static inline __stroll_nonull(1, 2, 3) __stroll_nothrow
 void
-stroll_fbmap_fini(struct stroll_fbmap * __restrict bmap)
+stroll_fbmap_andnot(struct stroll_fbmap *       result,
+                   const struct stroll_fbmap * first,
+                   const struct stroll_fbmap * second)
 {
-	stroll_fbmap_assert_map_api(bmap);
+	stroll_fbmap_assert_compat_api(result, first);
+	stroll_fbmap_assert_compat_api(result, second);
 
-	_stroll_fbmap_destroy_bits(bmap->bits);
+	_stroll_fbmap_andnot(result->bits,
+	                     first->bits,
+	                     second->bits,
+	                     result->nr);
 }
 
+extern unsigned int
+_stroll_fbmap_hweight_and(const unsigned long * __restrict first,
+                          const unsigned long * __restrict second,
+                          unsigned int                     nr)
+	__stroll_nonull(1, 2) __stroll_pure __stroll_nothrow __leaf
+	__warn_result;
+
 /**
- * Fixed sized bitmap iterator.
+ * Find the number of bits set into both of 2 fixed sized bitmaps.
  *
- * An opaque structure that holds internal state of a stroll_fbmap fixed sized
- * bitmap iteration.
+ * @param[in] first  First bitmap
+ * @param[in] second Second bitmap
+ *
+ * @return Number of bits set into both bitmaps
+ *
+ * Returns the Hamming weight of the intersection of @p first and @p second
+ * bitmaps without requiring storage for the intersection itself.
+ *
+ * @warning
+ * Both bitmaps **MUST** hold the same number of bits. If not, result is
+ * undefined when the #CONFIG_STROLL_ASSERT_API build option is disabled. An
+ * assertion is triggered otherwise.
  *
  * @see
- * - stroll_fbmap_foreach_range_set()
- * - stroll_fbmap_foreach_set()
- * - stroll_fbmap_foreach_range_clear()
- * - stroll_fbmap_foreach_clear()
+ * - stroll_fbmap_and()
+ * - stroll_fbmap_hweight()
+ * - stroll_fbmap_intersects()
  */
-struct stroll_fbmap_iter {
-	unsigned long         word;
-	unsigned int          curr;
-	unsigned int          nr;
-	const unsigned long * bits;
-};
-
-extern int
-stroll_fbmap_step_iter_set(struct stroll_fbmap_iter * __restrict iter)
-	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
-
-extern int
-_stroll_fbmap_init_range_iter_set(
-	struct stroll_fbmap_iter * __restrict  iter,
-	const unsigned long * __restrict       bits,
-	unsigned int                           start_bit,
-	unsigned int                           bit_count)
-	__stroll_nonull(1, 2) __stroll_nothrow __leaf __warn_result;
-
-#define _stroll_fbmap_foreach_range_set(_iter, \
-                                        _bits, \
-                                        _start_bit, \
-                                        _bit_count, \
-                                        _bit_no) \
-	for ((_bit_no) = _stroll_fbmap_init_range_iter_set(_iter, \
-	                                                   _bits, \
-	                                                   _start_bit, \
-	                                                   _bit_count); \
-	     (_bit_no) >= 0; \
-	     (_bit_no) = stroll_fbmap_step_iter_set(_iter))
-
-static inline __stroll_nonull(1, 2) __stroll_nothrow __warn_result
-int
-stroll_fbmap_init_range_iter_set(
-	struct stroll_fbmap_iter * __restrict  iter,
-	const struct stroll_fbmap * __restrict bmap,
-	unsigned int                           start_bit,
-	unsigned int                           bit_count)
+static inline __stroll_nonull(1, 2) __stroll_pure __stroll_nothrow __warn_result
+unsigned int
+stroll_fbmap_hweight_and(const struct stroll_fbmap * __restrict first,
+                         const struct stroll_fbmap * __restrict second)
 {
-	stroll_fbmap_assert_api(iter);
-	stroll_fbmap_assert_map_api(bmap);
-	stroll_fbmap_assert_api((start_bit + bit_count) <= bmap->nr);
+	stroll_fbmap_assert_compat_api(first, second);
 
-	return _stroll_fbmap_init_range_iter_set(iter,
-	                                         bmap->bits,
-	                                         start_bit,
-	                                         bit_count);
+	return _stroll_fbmap_hweight_and(first->bits, second->bits, first->nr);
 }
 
+extern bool
+_stroll_fbmap_intersects(const unsigned long * __restrict first,
+                         const unsigned long * __restrict second,
+                         unsigned int                     nr)
+	__stroll_nonull(1, 2) __stroll_pure __stroll_nothrow __leaf
+	__warn_result;
+
 /**
- * Iterate over bits set in a fixed sized bitmap given the specified bit range.
+ * Test wether 2 fixed sized bitmaps have bits set in common or not.
  *
- * @param[inout] _iter      Temporary iteration bitmap
- * @param[in]    _bmap      Bitmap to iterate over
- * @param[in]    _start_bit Range first bit
- * @param[in]    _bit_count Number of bits to iterate over
- * @param[out]   _bit_no    Current bit number
+ * @param[in] first  First bitmap
+ * @param[in] second Second bitmap
  *
- * Given an uninitialed @p iter stroll_fbmap_iter iterator, iterate over bits
- * set in @p _bmap stroll_fbmap bitmap and update @p _bit_no to reflect current
- * bit set.
+ * @return Test result
+ * @retval true  One or multiple bits are set into both bitmaps
+ * @retval false No bits are set into both bitmaps
  *
- * Iteration happens over the range defined as
- * [@p start_bit, @p start_bit + @p bit_count[.
+ * Scanning stops as soon as a common bit set is found.
+ *
+ * @warning
+ * Both bitmaps **MUST** hold the same number of bits. If not, result is
+ * undefined when the #CONFIG_STROLL_ASSERT_API build option is disabled. An
+ * assertion is triggered otherwise.
  *
  * @see
- * - stroll_fbmap_foreach_range_clear()
- * - stroll_fbmap_foreach_set()
+ * - stroll_fbmap_hweight_and()
+ * - stroll_fbmap_is_subset()
  */
-#define stroll_fbmap_foreach_range_set(_iter, \
-                                       _bmap, \
-                                       _start_bit, \
-                                       _bit_count, \
-                                       _bit_no) \
-	for ((_bit_no) = stroll_fbmap_init_range_iter_set(_iter, \
-	                                                  _bmap, \
-	                                                  _start_bit, \
-	                                                  _bit_count); \
-	     (_bit_no) >= 0; \
-	     (_bit_no) = stroll_fbmap_step_iter_set(_iter))
-
-static inline __stroll_nonull(1, 2) __stroll_nothrow __warn_result
-int
-stroll_fbmap_init_iter_set(struct stroll_fbmap_iter * __restrict  iter,
-                           const struct stroll_fbmap * __restrict bmap)
+static inline __stroll_nonull(1, 2) __stroll_pure __stroll_nothrow __warn_result
+bool
+stroll_fbmap_intersects(const struct stroll_fbmap * __restrict first,
+                        const struct stroll_fbmap * __restrict second)
 {
-	stroll_fbmap_assert_api(iter);
-	stroll_fbmap_assert_api(bmap);
+	stroll_fbmap_assert_compat_api(first, second);
 
-	return stroll_fbmap_init_range_iter_set(iter, bmap, 0, bmap->nr);
+	return _stroll_fbmap_intersects(first->bits, second->bits, first->nr);
 }
 
+extern bool
+_stroll_fbmap_is_subset(const unsigned long * __restrict subset,
+                        const unsigned long * __restrict set,
+                        unsigned int                     nr)
+	__stroll_nonull(1, 2) __stroll_pure __stroll_nothrow __leaf
+	__warn_result;
+
 /**
- * Iterate over all bits set in a fixed sized bitmap.
+ * Test wether a fixed sized bitmap is a subset of another one.
  *
- * @param[inout] _iter   Temporary iteration bitmap
- * @param[in]    _bmap   Bitmap to iterate over
- * @param[out]   _bit_no Current bit number
+ * @param[in] subset Bitmap to test
+ * @param[in] set    Bitmap to test against
  *
- * Given an uninitialed @p iter stroll_fbmap_iter iterator, iterate over bits
- * set in @p _bmap stroll_fbmap bitmap and update @p _bit_no to reflect current
- * bit set.
+ * @return Test result
+ * @retval true  All bits set into @p subset are also set into @p set
+ * @retval false One or multiple bits set into @p subset are cleared into @p set
+ *
+ * Scanning stops as soon as a bit set into @p subset but not into @p set is
+ * found.
+ *
+ * @warning
+ * Both bitmaps **MUST** hold the same number of bits. If not, result is
+ * undefined when the #CONFIG_STROLL_ASSERT_API build option is disabled. An
+ * assertion is triggered otherwise.
  *
  * @see
- * - stroll_fbmap_foreach_range_set()
- * - stroll_fbmap_foreach_clear()
+ * - stroll_fbmap_andnot()
+ * - stroll_fbmap_intersects()
  */
-#define stroll_fbmap_foreach_set(_iter, _bmap, _bit_no) \
-	for ((_bit_no) = stroll_fbmap_init_iter_set(_iter, _bmap); \
-	     (_bit_no) >= 0; \
-	     (_bit_no) = stroll_fbmap_step_iter_set(_iter))
+static inline __stroll_nonull(1, 2) __stroll_pure __stroll_nothrow __warn_result
+bool
+stroll_fbmap_is_subset(const struct stroll_fbmap * __restrict subset,
+                       const struct stroll_fbmap * __restrict set)
+{
+	stroll_fbmap_assert_compat_api(subset, set);
 
-extern int
-stroll_fbmap_step_iter_clear(struct stroll_fbmap_iter * __restrict iter)
-	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+	return _stroll_fbmap_is_subset(subset->bits, set->bits, subset->nr);
+}
 
-extern int
-_stroll_fbmap_init_range_iter_clear(
-	struct stroll_fbmap_iter * __restrict iter,
-	const unsigned long * __restrict      bits,
-	unsigned int                          start_bit,
-	unsigned int                          bit_count)
-	__stroll_nonull(1, 2) __stroll_nothrow __leaf __warn_result;
+/*
+ * Atomic operations.
+ *
+ * All functions below may be called concurrently by multiple threads
+ * operating onto the same bitmap without requiring additional locking. They
+ * are performed according to the memory ordering constraint given in argument.
+ */
 
-static inline __stroll_nonull(1, 2) __stroll_nothrow __warn_result
-int
-stroll_fbmap_init_range_iter_clear(
-	struct stroll_fbmap_iter * __restrict  iter,
-	const struct stroll_fbmap * __restrict bmap,
-	unsigned int                           start_bit,
-	unsigned int                           bit_count)
+/**
+ * Atomically test a bit in a fixed sized bitmap.
+ *
+ * @param[in] bmap   Bitmap to test
+ * @param[in] bit_no Index of bit to test
+ * @param[in] order  Memory ordering constraint
+ *
+ * @return Tested bit value
+ *
+ * Atomic variant of stroll_fbmap_test().
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and @p
+ * bit_no is greater than or equal to the number of bits specified at
+ * initialization time, result is undefined. An assertion is triggered
+ * otherwise.
+ *
+ * @see
+ * - stroll_fbmap_atomic_test_and_set()
+ * - stroll_fbmap_atomic_test_and_clear()
+ */
+static inline __stroll_nonull(1) __stroll_nothrow __warn_result
+bool
+stroll_fbmap_atomic_test(const struct stroll_fbmap * __restrict bmap,
+                         unsigned int                           bit_no,
+                         enum stroll_atomic_order               order)
+{
+	stroll_fbmap_assert_map_api(bmap);
+	stroll_fbmap_assert_api(bit_no < bmap->nr);
+	stroll_fbmap_assert_api((order == STROLL_ATOMIC_RELAXED) ||
+	                        (order == STROLL_ATOMIC_ACQUIRE) ||
+	                        (order == STROLL_ATOMIC_SEQ_CST));
+
+	return !!(__atomic_load_n(&bmap->bits[stroll_fbmap_word_no(bit_no)],
+	                          (int)order) &
+	          stroll_fbmap_word_bit_mask(bit_no));
+}
+
+static inline __stroll_nonull(1) __stroll_nothrow
+bool
+_stroll_fbmap_atomic_test_and_set(unsigned long * __restrict bits,
+                                  unsigned int               bit_no,
+                                  enum stroll_atomic_order   order)
+{
+	stroll_fbmap_assert_bits_api(bits, bit_no + 1);
+	stroll_fbmap_assert_api(stroll_atomic_order_is_valid(order));
+
+	unsigned long mask = stroll_fbmap_word_bit_mask(bit_no);
+
+	return !!(__atomic_fetch_or(&bits[stroll_fbmap_word_no(bit_no)],
+	                            mask,
+	                            (int)order) & mask);
+}
+
+/**
+ * Atomically set a bit in a fixed sized bitmap and return its previous value.
+ *
+ * @param[inout] bmap   Bitmap to set
+ * @param[in]    bit_no Index of bit to set
+ * @param[in]    order  Memory ordering constraint
+ *
+ * @return Previous bit value
+ * @retval true  Bit was already set
+ * @retval false Bit was cleared, i.e., caller is the one that set it
+ *
+ * Atomic variant of stroll_fbmap_set().
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and @p
+ * bit_no is greater than or equal to the number of bits specified at
+ * initialization time, result is undefined. An assertion is triggered
+ * otherwise.
+ *
+ * @see
+ * - stroll_fbmap_atomic_test_and_clear()
+ * - stroll_fbmap_atomic_find_and_set_first_clear()
+ */
+static inline __stroll_nonull(1) __stroll_nothrow
+bool
+stroll_fbmap_atomic_test_and_set(struct stroll_fbmap * __restrict bmap,
+                                 unsigned int                     bit_no,
+                                 enum stroll_atomic_order         order)
+{
+	stroll_fbmap_assert_map_api(bmap);
+	stroll_fbmap_assert_api(bit_no < bmap->nr);
+
+	return _stroll_fbmap_atomic_test_and_set(bmap->bits, bit_no, order);
+}
+
+static inline __stroll_nonull(1) __stroll_nothrow
+bool
+_stroll_fbmap_atomic_test_and_clear(unsigned long * __restrict bits,
+                                    unsigned int               bit_no,
+                                    enum stroll_atomic_order   order)
+{
+	stroll_fbmap_assert_bits_api(bits, bit_no + 1);
+	stroll_fbmap_assert_api(stroll_atomic_order_is_valid(order));
+
+	unsigned long mask = stroll_fbmap_word_bit_mask(bit_no);
+
+	return !!(__atomic_fetch_and(&bits[stroll_fbmap_word_no(bit_no)],
+	                             ~mask,
+	                             (int)order) & mask);
+}
+
+/**
+ * Atomically clear a bit in a fixed sized bitmap and return its previous
+ * value.
+ *
+ * @param[inout] bmap   Bitmap to clear
+ * @param[in]    bit_no Index of bit to clear
+ * @param[in]    order  Memory ordering constraint
+ *
+ * @return Previous bit value
+ * @retval true  Bit was set, i.e., caller is the one that cleared it
+ * @retval false Bit was already cleared
+ *
+ * Atomic variant of stroll_fbmap_clear().
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and @p
+ * bit_no is greater than or equal to the number of bits specified at
+ * initialization time, result is undefined. An assertion is triggered
+ * otherwise.
+ *
+ * @see
+ * - stroll_fbmap_atomic_test_and_set()
+ */
+static inline __stroll_nonull(1) __stroll_nothrow
+bool
+stroll_fbmap_atomic_test_and_clear(struct stroll_fbmap * __restrict bmap,
+                                   unsigned int                     bit_no,
+                                   enum stroll_atomic_order         order)
+{
+	stroll_fbmap_assert_map_api(bmap);
+	stroll_fbmap_assert_api(bit_no < bmap->nr);
+
+	return _stroll_fbmap_atomic_test_and_clear(bmap->bits, bit_no, order);
+}
+
+extern void
+_stroll_fbmap_atomic_set_range(unsigned long * __restrict bits,
+                               unsigned int               start_bit,
+                               unsigned int               bit_count,
+                               enum stroll_atomic_order   order)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+/**
+ * Atomically set a range of bits in a fixed sized bitmap.
+ *
+ * @param[inout] bmap      Bitmap to set
+ * @param[in]    start_bit Index of first bit to set starting from zero
+ * @param[in]    bit_count Number of bits to set
+ * @param[in]    order     Memory ordering constraint
+ *
+ * Set all bits within the range defined as
+ * [@p start_bit, @p start_bit + @p bit_count[ into the @p bmap bitmap.
+ *
+ * Each underlying machine word is updated atomically, one after the other:
+ * when the range spans multiple words, concurrent observers may see it
+ * partially set.
+ *
+ * Words fully covered by the range are written using plain atomic stores for
+ * which acquire semantics do not apply: these are performed with release
+ * ordering when @p order is #STROLL_ATOMIC_ACQ_REL and with relaxed ordering
+ * when @p order is #STROLL_ATOMIC_ACQUIRE.
+ *
+ * @warning
+ * - When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ *   @p bit_count is zero, result is undefined. A zero @p bit_count triggers an
+ *   assertion otherwise.
+ * - The sum `start_bit + bit_count` **MUST** be lower than or equal to the
+ *   number of bits specified at initialization time.
+ *   If not, result is undefined when the #CONFIG_STROLL_ASSERT_API build option
+ *   is disabled. An assertion is triggered otherwise.
+ *
+ * @see
+ * - stroll_fbmap_atomic_clear_range()
+ * - stroll_fbmap_atomic_cmpxchg_range()
+ */
+static inline __stroll_nonull(1) __stroll_nothrow
+void
+stroll_fbmap_atomic_set_range(struct stroll_fbmap * __restrict bmap,
+                              unsigned int                     start_bit,
+                              unsigned int                     bit_count,
+                              enum stroll_atomic_order         order)
 {
-	stroll_fbmap_assert_api(iter);
 	stroll_fbmap_assert_map_api(bmap);
+	stroll_fbmap_assert_api(bit_count);
 	stroll_fbmap_assert_api((start_bit + bit_count) <= bmap->nr);
 
-	return _stroll_fbmap_init_range_iter_clear(iter,
-	                                           bmap->bits,
-	                                           start_bit,
-	                                           bit_count);
+	_stroll_fbmap_atomic_set_range(bmap->bits,
+	                               start_bit,
+	                               bit_count,
+	                               order);
 }
 
-#define _stroll_fbmap_foreach_range_clear(_iter, \
-                                          _bits, \
-                                          _start_bit, \
-                                          _bit_count, \
-                                          _bit_no) \
-	for ((_bit_no) = _stroll_fbmap_init_range_iter_clear(_iter, \
-	                                                     _bits, \
-	                                                     _start_bit, \
-	                                                     _bit_count); \
-	     (_bit_no) >= 0; \
-	     (_bit_no) = stroll_fbmap_step_iter_clear(_iter))
+extern void
+_stroll_fbmap_atomic_clear_range(unsigned long * __restrict bits,
+                                 unsigned int               start_bit,
+                                 unsigned int               bit_count,
+                                 enum stroll_atomic_order   order)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
 
 /**
- * Iterate over bits cleared in a fixed sized bitmap given the specified bit
- * range.
+ * Atomically clear a range of bits in a fixed sized bitmap.
  *
- * @param[inout] _iter      Temporary iteration bitmap
- * @param[in]    _bmap      Bitmap to iterate over
- * @param[in]    _start_bit Range first bit
- * @param[in]    _bit_count Number of bits to iterate over
- * @param[out]   _bit_no    Current bit number
+ * @param[inout] bmap      Bitmap to clear
+ * @param[in]    start_bit Index of first bit to clear starting from zero
+ * @param[in]    bit_count Number of bits to clear
+ * @param[in]    order     Memory ordering constraint
  *
- * Given an uninitialed @p iter stroll_fbmap_iter iterator, iterate over bits
- * set to zero in @p _bmap stroll_fbmap bitmap and update @p _bit_no to reflect
- * current cleared bit.
+ * Clear all bits within the range defined as
+ * [@p start_bit, @p start_bit + @p bit_count[ into the @p bmap bitmap.
  *
- * Iteration happens over the range defined as
- * [@p start_bit, @p start_bit + @p bit_count[.
+ * Each underlying machine word is updated atomically, one after the other:
+ * when the range spans multiple words, concurrent observers may see it
+ * partially cleared.
+ * Words fully covered by the range are stored using the same memory ordering
+ * as stroll_fbmap_atomic_set_range().
+ *
+ * @warning
+ * - When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ *   @p bit_count is zero, result is undefined. A zero @p bit_count triggers an
+ *   assertion otherwise.
+ * - The sum `start_bit + bit_count` **MUST** be lower than or equal to the
+ *   number of bits specified at initialization time.
+ *   If not, result is undefined when the #CONFIG_STROLL_ASSERT_API build option
+ *   is disabled. An assertion is triggered otherwise.
  *
  * @see
- * - stroll_fbmap_foreach_range_set()
- * - stroll_fbmap_foreach_clear()
+ * - stroll_fbmap_atomic_set_range()
+ * - stroll_fbmap_atomic_cmpxchg_range()
  */
-#define stroll_fbmap_foreach_range_clear(_iter, \
-                                         _bmap, \
-                                         _start_bit, \
-                                         _bit_count, \
-                                         _bit_no) \
-	for ((_bit_no) = stroll_fbmap_init_range_iter_clear(_iter, \
-	                                                    _bmap, \
-	                                                    _start_bit, \
-	                                                    _bit_count); \
-	     (_bit_no) >= 0; \
-	     (_bit_no) = stroll_fbmap_step_iter_clear(_iter))
+static inline __stroll_nonull(1) __stroll_nothrow
+void
+stroll_fbmap_atomic_clear_range(struct stroll_fbmap * __restrict bmap,
+                                unsigned int                     start_bit,
+                                unsigned int                     bit_count,
+                                enum stroll_atomic_order         order)
+{
+	stroll_fbmap_assert_map_api(bmap);
+	stroll_fbmap_assert_api(bit_count);
+	stroll_fbmap_assert_api((start_bit + bit_count) <= bmap->nr);
 
-static inline __stroll_nonull(1, 2) __stroll_nothrow __warn_result
+	_stroll_fbmap_atomic_clear_range(bmap->bits,
+	                                 start_bit,
+	                                 bit_count,
+	                                 order);
+}
+
+extern int
+_stroll_fbmap_atomic_find_and_set_first_clear(unsigned long * __restrict bits,
+                                              unsigned int               nr,
+                                              enum stroll_atomic_order   order)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Atomically find the first cleared bit of a fixed sized bitmap and set it.
+ *
+ * @param[inout] bmap  Bitmap to search
+ * @param[in]    order Memory ordering constraint
+ *
+ * @return Index of bit found or an errno-like error code
+ * @retval >=0     index of bit the caller set
+ * @retval -ENOSPC all bits are set
+ *
+ * Search @p bmap for the lowest cleared bit and set it, ensuring that when
+ * multiple threads race for the same bit, only one of them succeeds while
+ * others resume their search. This allows to implement lock-free occupancy
+ * maps.
+ *
+ * @see
+ * - stroll_fbmap_atomic_test_and_set()
+ * - stroll_fbmap_atomic_test_and_clear()
+ */
+static inline __stroll_nonull(1) __stroll_nothrow __warn_result
 int
-stroll_fbmap_init_iter_clear(struct stroll_fbmap_iter * __restrict  iter,
-                             const struct stroll_fbmap * __restrict bmap)
+stroll_fbmap_atomic_find_and_set_first_clear(
+	struct stroll_fbmap * __restrict bmap,
+	enum stroll_atomic_order         order)
 {
-	stroll_fbmap_assert_api(iter);
-	stroll_fbmap_assert_api(bmap);
+	stroll_fbmap_assert_map_api(bmap);
 
-	return stroll_fbmap_init_range_iter_clear(iter, bmap, 0, bmap->nr);
+	return _stroll_fbmap_atomic_find_and_set_first_clear(bmap->bits,
+	                                                     bmap->nr,
+	                                                     order);
+}
+
+extern bool
+_stroll_fbmap_atomic_cmpxchg_range(unsigned long * __restrict bits,
+                                   unsigned int               start_bit,
+                                   unsigned int               bit_count,
+                                   unsigned long * __restrict expected,
+                                   unsigned long              desired,
+                                   enum stroll_atomic_order   order)
+	__stroll_nonull(1, 4) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Atomically compare and exchange a range of bits in a fixed sized bitmap.
+ *
+ * @param[inout] bmap      Bitmap to update
+ * @param[in]    start_bit Index of first bit of range starting from zero
+ * @param[in]    bit_count Number of bits in range
+ * @param[inout] expected  Expected range value
+ * @param[in]    desired   Value to store into range
+ * @param[in]    order     Memory ordering constraint
+ *
+ * @return Exchange status
+ * @retval true  range was equal to @p expected and updated to @p desired
+ * @retval false range content differs and was stored into @p expected
+ *
+ * Compare the bits within the range defined as
+ * [@p start_bit, @p start_bit + @p bit_count[ with @p expected and, when
+ * equal, replace them with @p desired. Bits outside of the range are left
+ * untouched and may be concurrently modified by other threads without causing
+ * the exchange to fail.
+ *
+ * @p expected and @p desired hold range values right aligned, i.e., bit
+ * @p start_bit of @p bmap maps to bit 0 of @p expected and @p desired.
+ *
+ * Failure is performed with the strongest memory ordering compatible with
+ * @p order.
+ *
+ * @warning
+ * - When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ *   @p bit_count is zero, result is undefined. A zero @p bit_count triggers an
+ *   assertion otherwise.
+ * - The range **MUST** fit within a single machine word, i.e., it cannot
+ *   cross a `__WORDSIZE` bits boundary. If not, result is undefined when the
+ *   #CONFIG_STROLL_ASSERT_API build option is disabled. An assertion is
+ *   triggered otherwise.
+ * - The sum `start_bit + bit_count` **MUST** be lower than or equal to the
+ *   number of bits specified at initialization time.
+ *   If not, result is undefined when the #CONFIG_STROLL_ASSERT_API build option
+ *   is disabled. An assertion is triggered otherwise.
+ *
+ * @see
+ * - stroll_fbmap_atomic_set_range()
+ * - stroll_fbmap_atomic_clear_range()
+ */
+static inline __stroll_nonull(1, 4) __stroll_nothrow __warn_result
+bool
+stroll_fbmap_atomic_cmpxchg_range(struct stroll_fbmap * __restrict bmap,
+                                  unsigned int                     start_bit,
+                                  unsigned int                     bit_count,
+                                  unsigned long * __restrict       expected,
+                                  unsigned long                    desired,
+                                  enum stroll_atomic_order         order)
+{
+	stroll_fbmap_assert_map_api(bmap);
+	stroll_fbmap_assert_api(bit_count);
+	stroll_fbmap_assert_api((start_bit + bit_count) <= bmap->nr);
+
+	return _stroll_fbmap_atomic_cmpxchg_range(bmap->bits,
+	                                          start_bit,
+	                                          bit_count,
+	                                          expected,
+	                                          desired,
+	                                          order);
 }
 
+extern unsigned long *
+_stroll_fbmap_create_bits_clear(unsigned int bit_nr)
+	__stroll_nothrow __leaf __warn_result;
+
 /**
- * Iterate over all bits cleared in a fixed sized bitmap.
+ * Zero-initialize fixed sized bitmap.
  *
- * @param[inout] _iter   Temporary iteration bitmap
- * @param[in]    _bmap   Bitmap to iterate over
- * @param[out]   _bit_no Current bit number
+ * @param[out] bmap   Fixed sized bitmap
+ * @param[in]  bit_nr Maximum number of bits @p bmap may hold
  *
- * Given an uninitialed @p iter stroll_fbmap_iter iterator, iterate over bits
- * set to zero in @p _bmap stroll_fbmap bitmap and update @p _bit_no to reflect
- * current cleared bit.
+ * @return an errno-like error code
+ * @retval 0       success
+ * @retval -ENOMEM memory allocation failed
+ *
+ * Initialize the @p bmap fixed sized bitmap with all bits cleared.
+ *
+ * @note
+ * Once client code is done with @p bmap, it *MUST* call stroll_fbmap_fini() to
+ * release allocated resources.
+ *
+ * @warning
+ * - When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ *   @p bit_nr > `INT_MAX` result is undefined. An assertion is triggered
+ *   otherwise.
  *
  * @see
- * - stroll_fbmap_foreach_range_clear()
- * - stroll_fbmap_foreach_set()
+ * - stroll_fbmap_init_set()
+ * - stroll_fbmap_init_dup()
+ * - stroll_fbmap_fini()
  */
-#define stroll_fbmap_foreach_clear(_iter, _bmap, _bit_no) \
-	for ((_bit_no) = stroll_fbmap_init_iter_clear(_iter, _bmap); \
-	     (_bit_no) >= 0; \
-	     (_bit_no) = stroll_fbmap_step_iter_clear(_iter))
+extern int
+stroll_fbmap_init_clear(struct stroll_fbmap * __restrict bmap,
+                        unsigned int                     bit_nr)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+extern unsigned long *
+_stroll_fbmap_create_bits_set(unsigned int bit_nr)
+	__stroll_nothrow __leaf __warn_result;
+
+/**
+ * Initialize fixed sized bitmap with all bits set.
+ *
+ * @param[out] bmap   Fixed sized bitmap
+ * @param[in]  bit_nr Maximum number of bits @p bmap may hold
+ *
+ * @return an errno-like error code
+ * @retval 0       success
+ * @retval -ENOMEM memory allocation failed
+ *
+ * Initialize the @p bmap fixed sized bitmap with all bits set.
+ *
+ * @note
+ * Once client code is done with @p bmap, it *MUST* call stroll_fbmap_fini() to
+ * release allocated resources.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * @p bit_nr > `INT_MAX` result is undefined. An assertion is triggered
+ * otherwise.
+ *
+ * @see
+ * - stroll_fbmap_init_clear()
+ * - stroll_fbmap_init_dup()
+ * - stroll_fbmap_fini()
+ */
+extern int
+stroll_fbmap_init_set(struct stroll_fbmap * __restrict bmap,
+                      unsigned int                     bit_nr)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+extern unsigned long *
+_stroll_fbmap_create_bits_dup(unsigned long * __restrict src,
+                              unsigned int               bit_nr)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Initialize fixed sized bitmap using the content of another stroll_fbmap.
+ *
+ * @param[out] bmap  Fixed sized bitmap
+ * @param[in]  src   Fixed sized bitmap to initialize @p bmap with
+ *
+ * @return an errno-like error code
+ * @retval 0       success
+ * @retval -ENOMEM memory allocation failed
+ *
+ * Initialize the @p bmap fixed sized bitmap with all bits set to values of @p
+ * src bitmap.
+ *
+ * @note
+ * Once client code is done with @p bmap, it *MUST* call stroll_fbmap_fini() to
+ * release allocated resources.
+ *
+ * @see
+ * - stroll_fbmap_init_clear()
+ * - stroll_fbmap_init_set()
+ * - stroll_fbmap_fini()
+ */
+extern int
+stroll_fbmap_init_dup(struct stroll_fbmap * __restrict       bmap,
+                      const struct stroll_fbmap * __restrict src)
+	__stroll_nonull(1, 2) __stroll_nothrow __leaf __warn_result;
+
+static inline __stroll_nonull(1) __stroll_nothrow
+void
+_stroll_fbmap_destroy_bits(unsigned long * bits)
+{
+	stroll_fbmap_assert_api(bits);
+
+	free(bits);
+}
+
+/**
+ * Finalize a fixed sized bitmap.
+ *
+ * @param[inout] bmap Fixed sized bitmap
+ *
+ * Release resources allocated for @p bmap. Once called, you *MUST NOT* re-use
+ * @p bmap unless re-initialized first.
+ *
+ * @see
+ * - stroll_fbmap_init_set()
+ * - stroll_fbmap_init_clear()
+ * - stroll_fbmap_init_dup()
+ */
+static inline __stroll_nonull(1) __stroll_nothrow
+void
+stroll_fbmap_fini(struct stroll_fbmap * __restrict bmap)
+{
+	stroll_fbmap_assert_map_api(bmap);
+
+	_stroll_fbmap_destroy_bits(bmap->bits);
+}
+
+/**
+ * Fixed sized bitmap iterator.
+ *
+ * An opaque structure that holds internal state of a stroll_fbmap fixed sized
+ * bitmap iteration.
+ *
+ * @see
+ * - stroll_fbmap_foreach_range_set()
+ * - stroll_fbmap_foreach_set()
+ * - stroll_fbmap_foreach_range_clear()
+ * - stroll_fbmap_foreach_clear()
+ */
+struct stroll_fbmap_iter {
+	unsigned long         word;
+	unsigned int          curr;
+	unsigned int          nr;
+	const unsigned long * bits;
+};
+
+extern int
+stroll_fbmap_step_iter_set(struct stroll_fbmap_iter * __restrict iter)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+extern int
+_stroll_fbmap_init_range_iter_set(
+	struct stroll_fbmap_iter * __restrict  iter,
+	const unsigned long * __restrict       bits,
+	unsigned int                           start_bit,
+	unsigned int                           bit_count)
+	__stroll_nonull(1, 2) __stroll_nothrow __leaf __warn_result;
+
+#define _stroll_fbmap_foreach_range_set(_iter, \
+                                        _bits, \
+                                        _start_bit, \
+                                        _bit_count, \
+                                        _bit_no) \
+	for ((_bit_no) = _stroll_fbmap_init_range_iter_set(_iter, \
+	                                                   _bits, \
+	                                                   _start_bit, \
+	                                                   _bit_count); \
+	     (_bit_no) >= 0; \
+	     (_bit_no) = stroll_fbmap_step_iter_set(_iter))
+
+static inline __stroll_nonull(1, 2) __stroll_nothrow __warn_result
+int
+stroll_fbmap_init_range_iter_set(
+	struct stroll_fbmap_iter * __restrict  iter,
+	const struct stroll_fbmap * __restrict bmap,
+	unsigned int                           start_bit,
+	unsigned int                           bit_count)
+{
+	stroll_fbmap_assert_api(iter);
+	stroll_fbmap_assert_map_api(bmap);
+	stroll_fbmap_assert_api((start_bit + bit_count) <= bmap->nr);
+
+	return _stroll_fbmap_init_range_iter_set(iter,
+	                                         bmap->bits,
+	                                         start_bit,
+	                                         bit_count);
+}
+
+/**
+ * Iterate over bits set in a fixed sized bitmap given the specified bit range.
+ *
+ * @param[inout] _iter      Temporary iteration bitmap
+ * @param[in]    _bmap      Bitmap to iterate over
+ * @param[in]    _start_bit Range first bit
+ * @param[in]    _bit_count Number of bits to iterate over
+ * @param[out]   _bit_no    Current bit number
+ *
+ * Given an uninitialed @p iter stroll_fbmap_iter iterator, iterate over bits
+ * set in @p _bmap stroll_fbmap bitmap and update @p _bit_no to reflect current
+ * bit set.
+ *
+ * Iteration happens over the range defined as
+ * [@p start_bit, @p start_bit + @p bit_count[.
+ *
+ * @see
+ * - stroll_fbmap_foreach_range_clear()
+ * - stroll_fbmap_foreach_set()
+ */
+#define stroll_fbmap_foreach_range_set(_iter, \
+                                       _bmap, \
+                                       _start_bit, \
+                                       _bit_count, \
+                                       _bit_no) \
+	for ((_bit_no) = stroll_fbmap_init_range_iter_set(_iter, \
+	                                                  _bmap, \
+	                                                  _start_bit, \
+	                                                  _bit_count); \
+	     (_bit_no) >= 0; \
+	     (_bit_no) = stroll_fbmap_step_iter_set(_iter))
+
+static inline __stroll_nonull(1, 2) __stroll_nothrow __warn_result
+int
+stroll_fbmap_init_iter_set(struct stroll_fbmap_iter * __restrict  iter,
+                           const struct stroll_fbmap * __restrict bmap)
+{
+	stroll_fbmap_assert_api(iter);
+	stroll_fbmap_assert_api(bmap);
+
+	return stroll_fbmap_init_range_iter_set(iter, bmap, 0, bmap->nr);
+}
+
+/**
+ * Iterate over all bits set in a fixed sized bitmap.
+ *
+ * @param[inout] _iter   Temporary iteration bitmap
+ * @param[in]    _bmap   Bitmap to iterate over
+ * @param[out]   _bit_no Current bit number
+ *
+ * Given an uninitialed @p iter stroll_fbmap_iter iterator, iterate over bits
+ * set in @p _bmap stroll_fbmap bitmap and update @p _bit_no to reflect current
+ * bit set.
+ *
+ * @see
+ * - stroll_fbmap_foreach_range_set()
+ * - stroll_fbmap_foreach_clear()
+ */
+#define stroll_fbmap_foreach_set(_iter, _bmap, _bit_no) \
+	for ((_bit_no) = stroll_fbmap_init_iter_set(_iter, _bmap); \
+	     (_bit_no) >= 0; \
+	     (_bit_no) = stroll_fbmap_step_iter_set(_iter))
+
+extern int
+stroll_fbmap_step_iter_clear(struct stroll_fbmap_iter * __restrict iter)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+extern int
+_stroll_fbmap_init_range_iter_clear(
+	struct stroll_fbmap_iter * __restrict iter,
+	const unsigned long * __restrict      bits,
+	unsigned int                          start_bit,
+	unsigned int                          bit_count)
+	__stroll_nonull(1, 2) __stroll_nothrow __leaf __warn_result;
+
+static inline __stroll_nonull(1, 2) __stroll_nothrow __warn_result
+int
+stroll_fbmap_init_range_iter_clear(
+	struct stroll_fbmap_iter * __restrict  iter,
+	const struct stroll_fbmap * __restrict bmap,
+	unsigned int                           start_bit,
+	unsigned int                           bit_count)
+{
+	stroll_fbmap_assert_api(iter);
+	stroll_fbmap_assert_map_api(bmap);
+	stroll_fbmap_assert_api((start_bit + bit_count) <= bmap->nr);
+
+	return _stroll_fbmap_init_range_iter_clear(iter,
+	                                           bmap->bits,
+	                                           start_bit,
+	                                           bit_count);
+}
+
+#define _stroll_fbmap_foreach_range_clear(_iter, \
+                                          _bits, \
+                                          _start_bit, \
+                                          _bit_count, \
+                                          _bit_no) \
+	for ((_bit_no) = _stroll_fbmap_init_range_iter_clear(_iter, \
+	                                                     _bits, \
+	                                                     _start_bit, \
+	                                                     _bit_count); \
+	     (_bit_no) >= 0; \
+	     (_bit_no) = stroll_fbmap_step_iter_clear(_iter))
+
+/**
+ * Iterate over bits cleared in a fixed sized bitmap given the specified bit
+ * range.
+ *
+ * @param[inout] _iter      Temporary iteration bitmap
+ * @param[in]    _bmap      Bitmap to iterate over
+ * @param[in]    _start_bit Range first bit
+ * @param[in]    _bit_count Number of bits to iterate over
+ * @param[out]   _bit_no    Current bit number
+ *
+ * Given an uninitialed @p iter stroll_fbmap_iter iterator, iterate over bits
+ * set to zero in @p _bmap stroll_fbmap bitmap and update @p _bit_no to reflect
+ * current cleared bit.
+ *
+ * Iteration happens over the range defined as
+ * [@p start_bit, @p start_bit + @p bit_count[.
+ *
+ * @see
+ * - stroll_fbmap_foreach_range_set()
+ * - stroll_fbmap_foreach_clear()
+ */
+#define stroll_fbmap_foreach_range_clear(_iter, \
+                                         _bmap, \
+                                         _start_bit, \
+                                         _bit_count, \
+                                         _bit_no) \
+	for ((_bit_no) = stroll_fbmap_init_range_iter_clear(_iter, \
+	                                                    _bmap, \
+	                                                    _start_bit, \
+	                                                    _bit_count); \
+	     (_bit_no) >= 0; \
+	     (_bit_no) = stroll_fbmap_step_iter_clear(_iter))
+
+static inline __stroll_nonull(1, 2) __stroll_nothrow __warn_result
+int
+stroll_fbmap_init_iter_clear(struct stroll_fbmap_iter * __restrict  iter,
+                             const struct stroll_fbmap * __restrict bmap)
+{
+	stroll_fbmap_assert_api(iter);
+	stroll_fbmap_assert_api(bmap);
+
+	return stroll_fbmap_init_range_iter_clear(iter, bmap, 0, bmap->nr);
+}
+
+/**
+ * Iterate over all bits cleared in a fixed sized bitmap.
+ *
+ * @param[inout] _iter   Temporary iteration bitmap
+ * @param[in]    _bmap   Bitmap to iterate over
+ * @param[out]   _bit_no Current bit number
+ *
+ * Given an uninitialed @p iter stroll_fbmap_iter iterator, iterate over bits
+ * set to zero in @p _bmap stroll_fbmap bitmap and update @p _bit_no to reflect
+ * current cleared bit.
+ *
+ * @see
+ * - stroll_fbmap_foreach_range_clear()
+ * - stroll_fbmap_foreach_set()
+ */
+#define stroll_fbmap_foreach_clear(_iter, _bmap, _bit_no) \
+	for ((_bit_no) = stroll_fbmap_init_iter_clear(_iter, _bmap); \
+	     (_bit_no) >= 0; \
+	     (_bit_no) = stroll_fbmap_step_iter_clear(_iter))
+
+extern unsigned int
+_stroll_fbmap_extract_set(const unsigned long * __restrict bits,
+                          unsigned int                     nr,
+                          unsigned int                     start_bit,
+                          uint32_t * __restrict            indices,
+                          unsigned int                     max)
+	__stroll_nonull(1, 4) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Decode indices of bits set in a fixed sized bitmap into an array.
+ *
+ * @param[in]  bmap      Bitmap to decode
+ * @param[in]  start_bit Index of first bit to decode starting from zero
+ * @param[out] indices   Array to store indices of bits set into
+ * @param[in]  max       Maximum number of indices @p indices may hold
+ *
+ * @return Number of indices stored into @p indices
+ *
+ * Store indices of bits set into @p bmap, starting from @p start_bit, into
+ * the @p indices array in ascending order, until either @p max indices have
+ * been stored or the end of @p bmap has been reached.
+ *
+ * When the returned count equals @p max, more bits may be set beyond the last
+ * index stored: decoding may be resumed by calling stroll_fbmap_extract_set()
+ * again with @p start_bit set to the last index stored plus one.
+ *
+ * This is a faster alternative to stroll_fbmap_foreach_set() when large
+ * numbers of bits have to be decoded: bits are decoded a machine word at a
+ * time, using SIMD kernels when the #CONFIG_STROLL_FBMAP_SIMD build option is
+ * enabled.
+ *
+ * @note
+ * Content of @p indices entries located beyond the returned count is
+ * undefined.
+ *
+ * @warning
+ * - When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ *   @p max is zero, result is undefined. A zero @p max triggers an assertion
+ *   otherwise.
+ * - @p start_bit **MUST** be lower than or equal to the number of bits
+ *   specified at initialization time.
+ *   If not, an undefined result is returned when the #CONFIG_STROLL_ASSERT_API
+ *   build option is disabled. An assertion is triggered otherwise.
+ *
+ * @see
+ * - stroll_fbmap_foreach_set()
+ * - stroll_fbmap_foreach_range_set()
+ */
+static inline __stroll_nonull(1, 3) __stroll_nothrow __warn_result
+unsigned int
+stroll_fbmap_extract_set(const struct stroll_fbmap * __restrict bmap,
+                         unsigned int                           start_bit,
+                         uint32_t * __restrict                  indices,
+                         unsigned int                           max)
+{
+	stroll_fbmap_assert_map_api(bmap);
+	stroll_fbmap_assert_api(start_bit <= bmap->nr);
+	stroll_fbmap_assert_api(indices);
+	stroll_fbmap_assert_api(max);
+
+	return _stroll_fbmap_extract_set(bmap->bits,
+	                                 bmap->nr,
+	                                 start_bit,
+	                                 indices,
+	                                 max);
+}
+
+extern int
+_stroll_fbmap_find_clear_run(const unsigned long * __restrict bits,
+                             unsigned int                     nr,
+                             unsigned int                     bit_count,
+                             unsigned int                     hint)
+	__stroll_nonull(1) __stroll_pure __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Find the first range of contiguous cleared bits of a fixed sized bitmap.
+ *
+ * @param[in] bmap      Bitmap to search
+ * @param[in] bit_count Number of contiguous cleared bits to search for
+ * @param[in] hint      Index of bit to start searching from
+ *
+ * @return Index of first bit of range found or an errno-like error code
+ * @retval >=0     index of first bit of range found
+ * @retval -ENOSPC no range of @p bit_count contiguous cleared bits found
+ *
+ * Search @p bmap for the first range of at least @p bit_count contiguous
+ * cleared bits, starting from @p hint and wrapping around to the beginning of
+ * @p bmap when the end is reached (*next fit* strategy). Giving a zero
+ * @p hint implements a *first fit* strategy.
+ *
+ * This is meant to find free extents of contiguous entries when @p bmap is
+ * used as an occupancy map. Words which bits are all set are skipped at once
+ * and cleared runs are measured a machine word at a time.
+ *
+ * A @p hint equal to the number of bits specified at initialization time is
+ * handled as a zero @p hint so that the index following the last allocated
+ * range may be given without further check.
+ *
+ * @warning
+ * - When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ *   @p bit_count is zero, result is undefined. A zero @p bit_count triggers an
+ *   assertion otherwise.
+ * - @p hint **MUST** be lower than or equal to the number of bits specified at
+ *   initialization time.
+ *   If not, an undefined result is returned when the #CONFIG_STROLL_ASSERT_API
+ *   build option is disabled. An assertion is triggered otherwise.
+ *
+ * @see
+ * - stroll_fbmap_find_best_clear_run()
+ * - stroll_fbmap_test_range()
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+int
+stroll_fbmap_find_clear_run(const struct stroll_fbmap * __restrict bmap,
+                            unsigned int                           bit_count,
+                            unsigned int                           hint)
+{
+	stroll_fbmap_assert_map_api(bmap);
+	stroll_fbmap_assert_api(bit_count);
+	stroll_fbmap_assert_api(hint <= bmap->nr);
+
+	return _stroll_fbmap_find_clear_run(bmap->bits,
+	                                    bmap->nr,
+	                                    bit_count,
+	                                    hint);
+}
+
+extern int
+_stroll_fbmap_find_best_clear_run(const unsigned long * __restrict bits,
+                                  unsigned int                     nr,
+                                  unsigned int                     bit_count)
+	__stroll_nonull(1) __stroll_pure __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Find the smallest range of contiguous cleared bits of a fixed sized bitmap
+ * large enough to hold a given number of bits.
+ *
+ * @param[in] bmap      Bitmap to search
+ * @param[in] bit_count Number of contiguous cleared bits to search for
+ *
+ * @return Index of first bit of range found or an errno-like error code
+ * @retval >=0     index of first bit of range found
+ * @retval -ENOSPC no range of @p bit_count contiguous cleared bits found
+ *
+ * Search @p bmap for the smallest range of at least @p bit_count contiguous
+ * cleared bits (*best fit* strategy). When multiple ranges of the same length
+ * qualify, the lowest one is returned. Search stops as soon as a range of
+ * exactly @p bit_count bits is found.
+ *
+ * Compared to stroll_fbmap_find_clear_run(), this helps limiting
+ * fragmentation at the cost of scanning the whole bitmap in the worst case.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * @p bit_count is zero, result is undefined. A zero @p bit_count triggers an
+ * assertion otherwise.
+ *
+ * @see
+ * - stroll_fbmap_find_clear_run()
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+int
+stroll_fbmap_find_best_clear_run(
+	const struct stroll_fbmap * __restrict bmap,
+	unsigned int                           bit_count)
+{
+	stroll_fbmap_assert_map_api(bmap);
+	stroll_fbmap_assert_api(bit_count);
+
+	return _stroll_fbmap_find_best_clear_run(bmap->bits,
+	                                         bmap->nr,
+	                                         bit_count);
+}
+
+/**
+ * Fixed sized bitmap rank / select directory.
+ *
+ * Auxiliary index built over a stroll_fbmap bitmap to compute:
+ * - the number of bits set before a given bit, i.e. rank, in constant time,
+ * - the index of the n-th bit set, i.e. select, in nearly constant time.
+ *
+ * The directory splits the bitmap into 2048 bits blocks. Each block is given a
+ * 64-bit entry holding the number of bits set before the block and the
+ * number of bits set into the first 3 of its 4 512 bits sub-blocks. In
+ * addition, the index of the block holding every 8192th bit set is sampled to
+ * speed up select operations. This amounts to a space overhead slightly above
+ * 3% of the indexed bitmap size.
+ *
+ * The directory refers to the indexed bitmap content which **MUST NOT** be
+ * modified nor released for the whole directory lifetime. Re-build the
+ * directory after bitmap modifications.
+ *
+ * @see
+ * - stroll_fbmap_init_rank()
+ * - stroll_fbmap_rank()
+ * - stroll_fbmap_select()
+ */
+struct stroll_fbmap_rank {
+	/** @internal */
+	unsigned int          nr;
+	/** @internal */
+	unsigned int          hweight;
+	/** @internal */
+	const unsigned long * bits;
+	/** @internal */
+	uint64_t *            blocks;
+	/** @internal */
+	uint32_t *            samples;
+};
+
+#define stroll_fbmap_assert_rank_api(_rank) \
+	stroll_fbmap_assert_api(_rank); \
+	stroll_fbmap_assert_bits_api((_rank)->bits, (_rank)->nr); \
+	stroll_fbmap_assert_api((_rank)->blocks); \
+	stroll_fbmap_assert_api((_rank)->samples); \
+	stroll_fbmap_assert_api((_rank)->hweight <= (_rank)->nr)
+
+/**
+ * Return the number of bits set into a bitmap indexed by a rank / select
+ * directory.
+ *
+ * @param[in] rank Rank / select directory
+ *
+ * @return Number of bits set
+ *
+ * @see
+ * - stroll_fbmap_init_rank()
+ * - stroll_fbmap_hweight()
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+unsigned int
+stroll_fbmap_rank_hweight(const struct stroll_fbmap_rank * __restrict rank)
+{
+	stroll_fbmap_assert_rank_api(rank);
+
+	return rank->hweight;
+}
+
+extern unsigned int
+_stroll_fbmap_rank(const struct stroll_fbmap_rank * __restrict rank,
+                   unsigned int                                bit_no)
+	__stroll_nonull(1) __stroll_pure __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Return the number of bits set before a given bit of a bitmap.
+ *
+ * @param[in] rank   Rank / select directory
+ * @param[in] bit_no Index of bit starting from zero
+ *
+ * @return Number of bits set within the [0, @p bit_no[ range
+ *
+ * Compute in constant time the number of bits set into the bitmap indexed by
+ * @p rank which index is strictly lower than @p bit_no.
+ *
+ * @warning
+ * @p bit_no **MUST** be lower than or equal to the number of bits of the
+ * indexed bitmap. If not, an undefined result is returned when the
+ * #CONFIG_STROLL_ASSERT_API build option is disabled. An assertion is
+ * triggered otherwise.
+ *
+ * @see
+ * - stroll_fbmap_select()
+ * - stroll_fbmap_init_rank()
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+unsigned int
+stroll_fbmap_rank(const struct stroll_fbmap_rank * __restrict rank,
+                  unsigned int                                bit_no)
+{
+	stroll_fbmap_assert_rank_api(rank);
+	stroll_fbmap_assert_api(bit_no <= rank->nr);
+
+	return _stroll_fbmap_rank(rank, bit_no);
+}
+
+extern int
+_stroll_fbmap_select(const struct stroll_fbmap_rank * __restrict rank,
+                     unsigned int                                index)
+	__stroll_nonull(1) __stroll_pure __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Return the index of the n-th bit set into a bitmap.
+ *
+ * @param[in] rank  Rank / select directory
+ * @param[in] index Rank of bit set to search for, starting from zero
+ *
+ * @return Index of bit found or an errno-like error code
+ * @retval >=0     index of the bit set which rank is @p index
+ * @retval -ENOENT less than @p index + 1 bits are set
+ *
+ * Search the bitmap indexed by @p rank for the bit set preceded by exactly
+ * @p index other bits set. This is the inverse operation of
+ * stroll_fbmap_rank(), i.e.:
+ *
+ *     stroll_fbmap_rank(rank, stroll_fbmap_select(rank, index)) == index
+ *
+ * Search time is bounded by a binary search over the blocks located between 2
+ * consecutive select samples, followed by a scan of at most 512 bits.
+ *
+ * @see
+ * - stroll_fbmap_rank()
+ * - stroll_fbmap_init_rank()
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+int
+stroll_fbmap_select(const struct stroll_fbmap_rank * __restrict rank,
+                    unsigned int                                index)
+{
+	stroll_fbmap_assert_rank_api(rank);
+
+	if (index >= rank->hweight)
+		return -ENOENT;
+
+	return _stroll_fbmap_select(rank, index);
+}
+
+/**
+ * Build a rank / select directory over a fixed sized bitmap.
+ *
+ * @param[out] rank Rank / select directory to initialize
+ * @param[in]  bmap Bitmap to index
+ *
+ * @return An errno-like error code
+ * @retval 0       success
+ * @retval -ENOMEM memory allocation failure
+ *
+ * Allocate and build the @p rank directory indexing @p bmap content.
+ *
+ * @warning
+ * @p bmap content **MUST NOT** be modified nor released till @p rank is
+ * released using stroll_fbmap_fini_rank(). Release and re-build @p rank
+ * to account for @p bmap modifications.
+ *
+ * @see
+ * - stroll_fbmap_fini_rank()
+ * - stroll_fbmap_rank()
+ * - stroll_fbmap_select()
+ */
+extern int
+stroll_fbmap_init_rank(struct stroll_fbmap_rank * __restrict  rank,
+                       const struct stroll_fbmap * __restrict bmap)
+	__stroll_nonull(1, 2) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Release resources allocated by a rank / select directory.
+ *
+ * @param[inout] rank Rank / select directory to release
+ *
+ * Once called, you *MUST NOT* re-use @p rank unless it is re-built using
+ * stroll_fbmap_init_rank().
+ *
+ * @see stroll_fbmap_init_rank()
+ */
+static inline __stroll_nonull(1) __stroll_nothrow
+void
+stroll_fbmap_fini_rank(struct stroll_fbmap_rank * __restrict rank)
+{
+	stroll_fbmap_assert_rank_api(rank);
+
+	free(rank->samples);
+	free(rank->blocks);
+}
+
+/**
+ * Growable bitmap.
+ *
+ * A stroll_fbmap bitmap which number of bits may be modified after
+ * initialization time using stroll_fbmap_resize_dyn().
+ *
+ * Growing is performed with geometric capacity increase so that the cost of
+ * resizing is amortized over multiple calls. Once large enough, memory backing
+ * the bitmap is allocated using anonymous memory mappings so that subsequent
+ * growing may be performed by remapping pages instead of copying bit values.
+ * Shrinking is performed in place, releasing excess capacity once the number
+ * of bits falls significantly below it.
+ *
+ * The underlying stroll_fbmap is retrieved using stroll_fbmap_dyn_map() and may
+ * be given to all stroll_fbmap functions, except stroll_fbmap_fini().
+ *
+ * @warning
+ * Cannot hold more than `INT_MAX` bits.
+ *
+ * @see
+ * - stroll_fbmap_init_dyn()
+ * - stroll_fbmap_resize_dyn()
+ * - stroll_fbmap_dyn_map()
+ */
+struct stroll_fbmap_dyn {
+	/** @internal Underlying fixed sized bitmap. */
+	struct stroll_fbmap map;
+	/** @internal Size of memory area holding bit values in bytes. */
+	size_t              size;
+};
+
+#define stroll_fbmap_assert_dyn_api(_dyn) \
+	stroll_fbmap_assert_api(_dyn); \
+	stroll_fbmap_assert_map_api(&(_dyn)->map); \
+	stroll_fbmap_assert_api((_dyn)->size >= \
+	                        (stroll_fbmap_word_nr((_dyn)->map.nr) * \
+	                         sizeof((_dyn)->map.bits[0])))
+
+/**
+ * Return the fixed sized bitmap underlying a growable bitmap.
+ *
+ * @param[in] dyn Growable bitmap
+ *
+ * @return Underlying stroll_fbmap
+ *
+ * Returned stroll_fbmap may be used with all stroll_fbmap functions except
+ * stroll_fbmap_fini() to access @p dyn content.
+ *
+ * @warning
+ * Resizing @p dyn using stroll_fbmap_resize_dyn() invalidates all iterators
+ * and rank / select directories referring to the returned stroll_fbmap.
+ *
+ * @see stroll_fbmap_init_dyn()
+ */
+static inline __stroll_nonull(1) __stroll_const __stroll_nothrow __warn_result
+struct stroll_fbmap *
+stroll_fbmap_dyn_map(struct stroll_fbmap_dyn * __restrict dyn)
+{
+	stroll_fbmap_assert_api(dyn);
+
+	return &dyn->map;
+}
+
+/**
+ * Modify the number of bits a growable bitmap may hold.
+ *
+ * @param[inout] dyn    Growable bitmap
+ * @param[in]    bit_nr New number of bits
+ *
+ * @return An errno-like error code
+ * @retval 0       success
+ * @retval -ENOMEM memory allocation failure
+ *
+ * Set the number of bits @p dyn may hold to @p bit_nr, preserving values of
+ * bits located below both current and new number of bits. When growing, bits
+ * located beyond the current number of bits are cleared.
+ *
+ * Capacity is at least doubled when growing beyond current capacity. It is
+ * reduced when shrinking below one quarter of current capacity, without moving
+ * bit values.
+ *
+ * @p dyn is left untouched upon failure.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * @p bit_nr is zero or greater than `INT_MAX`, result is undefined. An
+ * assertion is triggered otherwise.
+ *
+ * @see
+ * - stroll_fbmap_init_dyn()
+ * - stroll_fbmap_dyn_map()
+ */
+extern int
+stroll_fbmap_resize_dyn(struct stroll_fbmap_dyn * __restrict dyn,
+                        unsigned int                         bit_nr)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Initialize a growable bitmap with all bits cleared.
+ *
+ * @param[out] dyn    Growable bitmap
+ * @param[in]  bit_nr Initial number of bits
+ *
+ * @return An errno-like error code
+ * @retval 0       success
+ * @retval -ENOMEM memory allocation failure
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * @p bit_nr is zero or greater than `INT_MAX`, result is undefined. An
+ * assertion is triggered otherwise.
+ *
+ * @see
+ * - stroll_fbmap_fini_dyn()
+ * - stroll_fbmap_resize_dyn()
+ */
+extern int
+stroll_fbmap_init_dyn(struct stroll_fbmap_dyn * __restrict dyn,
+                      unsigned int                         bit_nr)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Finalize a growable bitmap.
+ *
+ * @param[inout] dyn Growable bitmap
+ *
+ * Release resources allocated for @p dyn. Once called, you *MUST NOT* re-use
+ * @p dyn unless it is re-initialized using stroll_fbmap_init_dyn().
+ *
+ * @see stroll_fbmap_init_dyn()
+ */
+extern void
+stroll_fbmap_fini_dyn(struct stroll_fbmap_dyn * __restrict dyn)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+#if defined(CONFIG_STROLL_FBMAP_FILE)
+
+#include <sys/types.h>
+
+/**
+ * Open memory mapped file backed bitmap in read-only mode.
+ *
+ * The file is mapped using a shared read-only mapping so that multiple
+ * processes may access the same bitmap without copying it.
+ *
+ * @see stroll_fbmap_open_file()
+ */
+#define STROLL_FBMAP_FILE_RDONLY (1 << 0)
+
+/**
+ * Verify content of memory mapped file backed bitmap at opening time.
+ *
+ * Bit values checksum is computed and compared to the one stored into the file
+ * header at last synchronization time.
+ *
+ * @see
+ * - stroll_fbmap_open_file()
+ * - stroll_fbmap_sync_file()
+ */
+#define STROLL_FBMAP_FILE_VERIFY (1 << 1)
+
+/**
+ * Memory mapped file backed bitmap.
+ *
+ * A stroll_fbmap bitmap which bit values are stored into a file mapped into
+ * memory. This allows bitmaps to survive process restarts without having to
+ * rebuild them: opening consists in mapping the file, no bit value is copied.
+ *
+ * The file starts with a small header holding the number of bits, a format
+ * version and a checksum of bit values computed at synchronization time,
+ * followed by bit values.
+ *
+ * The underlying stroll_fbmap is retrieved using stroll_fbmap_file_map() and
+ * may be given to all stroll_fbmap functions, except stroll_fbmap_fini().
+ *
+ * @warning
+ * Files are stored using the host native byte order.
+ *
+ * @see
+ * - stroll_fbmap_create_file()
+ * - stroll_fbmap_open_file()
+ * - stroll_fbmap_file_map()
+ */
+struct stroll_fbmap_file {
+	/** @internal Underlying fixed sized bitmap. */
+	struct stroll_fbmap map;
+	/** @internal Base address of file mapping. */
+	void *              addr;
+	/** @internal Size of file mapping in bytes. */
+	size_t              size;
+	/** @internal Opening flags. */
+	int                 flags;
+};
+
+#define stroll_fbmap_assert_file_api(_file) \
+	stroll_fbmap_assert_api(_file); \
+	stroll_fbmap_assert_map_api(&(_file)->map); \
+	stroll_fbmap_assert_api((_file)->addr); \
+	stroll_fbmap_assert_api((_file)->size > \
+	                        (stroll_fbmap_word_nr((_file)->map.nr) * \
+	                         sizeof((_file)->map.bits[0]))); \
+	stroll_fbmap_assert_api(!((_file)->flags & \
+	                          ~(STROLL_FBMAP_FILE_RDONLY | \
+	                            STROLL_FBMAP_FILE_VERIFY)))
+
+/**
+ * Return the fixed sized bitmap underlying a memory mapped file backed bitmap.
+ *
+ * @param[in] file Memory mapped file backed bitmap
+ *
+ * @return Underlying stroll_fbmap
+ *
+ * Returned stroll_fbmap may be used with all stroll_fbmap functions except
+ * stroll_fbmap_fini() to access @p file content.
+ *
+ * @warning
+ * When @p file has been opened using the #STROLL_FBMAP_FILE_RDONLY flag,
+ * modifying returned bitmap results in a memory access violation.
+ *
+ * @see
+ * - stroll_fbmap_create_file()
+ * - stroll_fbmap_open_file()
+ */
+static inline __stroll_nonull(1) __stroll_const __stroll_nothrow __warn_result
+struct stroll_fbmap *
+stroll_fbmap_file_map(struct stroll_fbmap_file * __restrict file)
+{
+	stroll_fbmap_assert_api(file);
+
+	return &file->map;
+}
+
+/**
+ * Flush a range of bits of a memory mapped file backed bitmap to storage.
+ *
+ * @param[in] file      Memory mapped file backed bitmap
+ * @param[in] start_bit Index of first bit of range starting from zero
+ * @param[in] bit_count Number of bits in range
+ *
+ * @return An errno-like error code
+ * @retval 0    success
+ * @retval -EIO I/O error
+ *
+ * Synchronously write memory pages holding bits within the
+ * [@p start_bit, @p start_bit + @p bit_count[ range back to the file backing
+ * @p file. The checksum stored into the file header is left untouched: use
+ * stroll_fbmap_sync_file() to update it.
+ *
+ * @warning
+ * - @p file **MUST NOT** have been opened using the #STROLL_FBMAP_FILE_RDONLY
+ *   flag. If not, an undefined result is returned when the
+ *   #CONFIG_STROLL_ASSERT_API build option is disabled. An assertion is
+ *   triggered otherwise.
+ * - When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ *   @p bit_count is zero, result is undefined. A zero @p bit_count triggers an
+ *   assertion otherwise.
+ * - The sum `start_bit + bit_count` **MUST** be lower than or equal to the
+ *   number of bits of @p file.
+ *   If not, an undefined result is returned when the #CONFIG_STROLL_ASSERT_API
+ *   build option is disabled. An assertion is triggered otherwise.
+ *
+ * @see stroll_fbmap_sync_file()
+ */
+extern int
+stroll_fbmap_flush_file_range(
+	const struct stroll_fbmap_file * __restrict file,
+	unsigned int                                start_bit,
+	unsigned int                                bit_count)
+	__stroll_nonull(1) __leaf __warn_result;
+
+/**
+ * Synchronize a memory mapped file backed bitmap with storage.
+ *
+ * @param[inout] file Memory mapped file backed bitmap
+ *
+ * @return An errno-like error code
+ * @retval 0    success
+ * @retval -EIO I/O error
+ *
+ * Update the checksum stored into the header of @p file according to current
+ * bit values then synchronously write the whole mapping back to the file
+ * backing @p file.
+ *
+ * @warning
+ * @p file **MUST NOT** have been opened using the #STROLL_FBMAP_FILE_RDONLY
+ * flag. If not, an undefined result is returned when the
+ * #CONFIG_STROLL_ASSERT_API build option is disabled. An assertion is
+ * triggered otherwise.
+ *
+ * @see
+ * - stroll_fbmap_flush_file_range()
+ * - stroll_fbmap_close_file()
+ */
+extern int
+stroll_fbmap_sync_file(struct stroll_fbmap_file * __restrict file)
+	__stroll_nonull(1) __leaf __warn_result;
+
+/**
+ * Create a memory mapped file backed bitmap with all bits cleared.
+ *
+ * @param[out] file   Memory mapped file backed bitmap
+ * @param[in]  path   Pathname of file to create
+ * @param[in]  bit_nr Number of bits
+ * @param[in]  mode   File permission bits as given to open(2)
+ *
+ * @return An errno-like error code
+ * @retval 0       success
+ * @retval -EEXIST a file already exists at @p path
+ * @retval -ENOMEM memory allocation failure
+ * @retval <0      other error returned by open(2), ftruncate(2) or mmap(2)
+ *
+ * Create the file located at @p path, size it to hold a header followed by
+ * @p bit_nr bits and map it into memory in read / write mode.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * @p bit_nr is zero or greater than `INT_MAX`, result is undefined. An
+ * assertion is triggered otherwise.
+ *
+ * @see
+ * - stroll_fbmap_open_file()
+ * - stroll_fbmap_close_file()
+ */
+extern int
+stroll_fbmap_create_file(struct stroll_fbmap_file * __restrict file,
+                         const char * __restrict               path,
+                         unsigned int                          bit_nr,
+                         mode_t                                mode)
+	__stroll_nonull(1, 2) __leaf __warn_result;
+
+/**
+ * Open a memory mapped file backed bitmap.
+ *
+ * @param[out] file  Memory mapped file backed bitmap
+ * @param[in]  path  Pathname of file to open
+ * @param[in]  flags Opening flags
+ *
+ * @return An errno-like error code
+ * @retval 0        success
+ * @retval -EBADMSG invalid file header or checksum mismatch
+ * @retval -ENOTSUP unsupported file format version or word size
+ * @retval <0       other error returned by open(2), fstat(2) or mmap(2)
+ *
+ * Map the file located at @p path previously created using
+ * stroll_fbmap_create_file() into memory, after validating its header.
+ *
+ * @p flags is a bitwise OR of zero or more of the following:
+ * - #STROLL_FBMAP_FILE_RDONLY to map @p path read-only,
+ * - #STROLL_FBMAP_FILE_VERIFY to check bit values against the checksum
+ *   stored into the file header.
+ *
+ * @note
+ * Checksum verification requires to read all bit values.
+ *
+ * @see
+ * - stroll_fbmap_create_file()
+ * - stroll_fbmap_close_file()
+ */
+extern int
+stroll_fbmap_open_file(struct stroll_fbmap_file * __restrict file,
+                       const char * __restrict               path,
+                       int                                   flags)
+	__stroll_nonull(1, 2) __leaf __warn_result;
+
+/**
+ * Close a memory mapped file backed bitmap.
+ *
+ * @param[inout] file Memory mapped file backed bitmap
+ *
+ * @return An errno-like error code
+ * @retval 0    success
+ * @retval -EIO I/O error
+ *
+ * Synchronize @p file with storage using stroll_fbmap_sync_file() unless
+ * opened using the #STROLL_FBMAP_FILE_RDONLY flag, then unmap it. @p file is
+ * unmapped even when synchronization fails. Once called, you *MUST NOT* re-use
+ * @p file unless it is re-opened.
+ *
+ * @see
+ * - stroll_fbmap_create_file()
+ * - stroll_fbmap_open_file()
+ */
+extern int
+stroll_fbmap_close_file(struct stroll_fbmap_file * __restrict file)
+	__stroll_nonull(1) __leaf;
+
+#endif /* defined(CONFIG_STROLL_FBMAP_FILE) */
 
 #endif /* _STROLL_FBMAP_H */
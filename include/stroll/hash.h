@@ -20,6 +20,7 @@
 #define _STROLL_HASH_H
 
 #include <stroll/cdefs.h>
+#include <stdint.h>
 
 #if defined(CONFIG_STROLL_ASSERT_API)
 
@@ -123,6 +124,26 @@ stroll_hash64(uint64_t key, unsigned int bits)
 
 #endif /* __WORDSIZE == 64 */
 
+/*
+ * Mix all bits of a 64-bit key into a 64-bit hash according to the MurmurHash3
+ * 64-bit finalizer.
+ *
+ * Unlike stroll_hash64(), each bit of the result depends upon all key bits so
+ * that both halves of the hash may be used independently, even for strided or
+ * sequential keys.
+ */
+static inline __stroll_const __stroll_nothrow __warn_result
+uint64_t
+stroll_hash_mix64(uint64_t key)
+{
+	key ^= key >> 33;
+	key *= UINT64_C(0xff51afd7ed558ccd);
+	key ^= key >> 33;
+	key *= UINT64_C(0xc4ceb9fe1a85ec53);
+
+	return key ^ (key >> 33);
+}
+
 static inline
 unsigned int
 stroll_hash(unsigned int key, unsigned int bits)
@@ -0,0 +1,438 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+/**
+ * @file
+ * Hierarchical bitmap interface
+ *
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      18 Oct 2026
+ * @copyright Copyright (C) 2026 Grégor Boirie.
+ * @license   [GNU Lesser General Public License (LGPL) v3]
+ *            (https://www.gnu.org/licenses/lgpl+gpl-3.0.txt)
+ */
+
+#ifndef _STROLL_HBMAP_H
+#define _STROLL_HBMAP_H
+
+#include <stroll/cdefs.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <errno.h>
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+
+#include <stroll/assert.h>
+
+#define stroll_hbmap_assert_api(_expr) \
+	stroll_assert("stroll:hbmap", _expr)
+
+#else  /* !defined(CONFIG_STROLL_ASSERT_API) */
+
+#define stroll_hbmap_assert_api(_expr)
+
+#endif /* defined(CONFIG_STROLL_ASSERT_API) */
+
+/**
+ * Maximum number of summary levels of a hierarchical bitmap.
+ *
+ * Each summary level holds one bit per machine word of the level below.
+ * Since a hierarchical bitmap cannot hold more than `INT_MAX` bits, no more
+ * than `ceil(31 / log2(__WORDSIZE))` summary levels are required.
+ */
+#define STROLL_HBMAP_DEPTH_MAX \
+	((31 + STROLL_WORD_SHIFT - 1) / STROLL_WORD_SHIFT)
+
+/**
+ * Hierarchical bitmap.
+ *
+ * An array of bits which size is set at initialization time and where bit
+ * values may be addressed by bit number / index.
+ *
+ * In addition to the array of bits itself, a stroll_hbmap maintains 2
+ * hierarchies of summary bitmaps where each bit of a summary level tells
+ * whether the corresponding word of the level below:
+ * - contains bits set, allowing to locate set bits,
+ * - contains bits cleared, allowing to locate cleared bits.
+ *
+ * Searching for set or cleared bits is performed in `O(log64(n))` time
+ * (`O(log32(n))` on 32-bit machines) at the cost of additional memory usage
+ * (roughly `2 / 63` of the array of bits) and slightly slower modifications.
+ *
+ * @warning
+ * Cannot hold more than `INT_MAX` bits.
+ */
+struct stroll_hbmap {
+	/**
+	 * @internal
+	 *
+	 * Maximum number of bits this stroll_hbmap may hold.
+	 * MUST BE <= `INT_MAX`.
+	 */
+	unsigned int    nr;
+	/**
+	 * @internal
+	 *
+	 * Number of summary levels, i.e. levels above the array of bits.
+	 */
+	unsigned int    depth;
+	/**
+	 * @internal
+	 *
+	 * Levels of the set bits summary hierarchy. Level 0 is the array of
+	 * bits itself.
+	 */
+	unsigned long * set[STROLL_HBMAP_DEPTH_MAX + 1];
+	/**
+	 * @internal
+	 *
+	 * Levels of the cleared bits summary hierarchy. Level 0 is the array
+	 * of bits itself.
+	 */
+	unsigned long * clear[STROLL_HBMAP_DEPTH_MAX + 1];
+};
+
+#define stroll_hbmap_assert_map_api(_hbmap) \
+	stroll_hbmap_assert_api(_hbmap); \
+	stroll_hbmap_assert_api((_hbmap)->nr); \
+	stroll_hbmap_assert_api((_hbmap)->nr <= (unsigned int)INT_MAX); \
+	stroll_hbmap_assert_api((_hbmap)->depth <= STROLL_HBMAP_DEPTH_MAX); \
+	stroll_hbmap_assert_api((_hbmap)->set[0]); \
+	stroll_hbmap_assert_api((_hbmap)->set[0] == (_hbmap)->clear[0])
+
+/**
+ * Return the maximum number of bits a hierarchical bitmap may hold.
+ *
+ * @param[in] hbmap Bitmap
+ *
+ * @see
+ * - stroll_hbmap_init_clear()
+ * - stroll_hbmap_init_set()
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+unsigned int
+stroll_hbmap_nr(const struct stroll_hbmap * __restrict hbmap)
+{
+	stroll_hbmap_assert_map_api(hbmap);
+
+	return hbmap->nr;
+}
+
+/**
+ * Test wether a bit in a hierarchical bitmap is set or not.
+ *
+ * @param[in] hbmap  Bitmap to test
+ * @param[in] bit_no Index of bit to test starting from 0
+ *
+ * @return Test result
+ * @retval true  tested bit is set
+ * @retval false tested bit is cleared
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and @p
+ * bit_no is greater than or equal to the number of bits specified at
+ * initialization time, result is undefined. An assertion is triggered
+ * otherwise.
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+bool
+stroll_hbmap_test(const struct stroll_hbmap * __restrict hbmap,
+                  unsigned int                           bit_no)
+{
+	stroll_hbmap_assert_map_api(hbmap);
+	stroll_hbmap_assert_api(bit_no < hbmap->nr);
+
+	return !!(hbmap->set[0][bit_no >> STROLL_WORD_SHIFT] &
+	          (1UL << (bit_no & (__WORDSIZE - 1))));
+}
+
+/**
+ * Set a bit in a hierarchical bitmap.
+ *
+ * @param[inout] hbmap  Bitmap to set
+ * @param[in]    bit_no Index of bit to set starting from 0
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and @p
+ * bit_no is greater than or equal to the number of bits specified at
+ * initialization time, result is undefined. An assertion is triggered
+ * otherwise.
+ *
+ * @see
+ * - stroll_hbmap_clear()
+ * - stroll_hbmap_set_range()
+ */
+extern void
+stroll_hbmap_set(struct stroll_hbmap * __restrict hbmap, unsigned int bit_no)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+/**
+ * Clear a bit in a hierarchical bitmap.
+ *
+ * @param[inout] hbmap  Bitmap to clear
+ * @param[in]    bit_no Index of bit to clear starting from 0
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and @p
+ * bit_no is greater than or equal to the number of bits specified at
+ * initialization time, result is undefined. An assertion is triggered
+ * otherwise.
+ *
+ * @see
+ * - stroll_hbmap_set()
+ * - stroll_hbmap_clear_range()
+ */
+extern void
+stroll_hbmap_clear(struct stroll_hbmap * __restrict hbmap, unsigned int bit_no)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+/**
+ * Set a range of bits in a hierarchical bitmap.
+ *
+ * @param[inout] hbmap     Bitmap to set
+ * @param[in]    start_bit Index of first bit to set starting from 0
+ * @param[in]    bit_count Number of bits to set
+ *
+ * Set all bits within the range defined as
+ * [@p start_bit, @p start_bit + @p bit_count[.
+ *
+ * @warning
+ * - When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ *   @p bit_count is zero, result is undefined. A zero @p bit_count triggers an
+ *   assertion otherwise.
+ * - The sum `start_bit + bit_count` **MUST** be lower than or equal to the
+ *   number of bits specified at initialization time.
+ *   If not, result is undefined when the #CONFIG_STROLL_ASSERT_API build
+ *   option is disabled. An assertion is triggered otherwise.
+ *
+ * @see
+ * - stroll_hbmap_set()
+ * - stroll_hbmap_clear_range()
+ */
+extern void
+stroll_hbmap_set_range(struct stroll_hbmap * __restrict hbmap,
+                       unsigned int                     start_bit,
+                       unsigned int                     bit_count)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+/**
+ * Clear a range of bits in a hierarchical bitmap.
+ *
+ * @param[inout] hbmap     Bitmap to clear
+ * @param[in]    start_bit Index of first bit to clear starting from 0
+ * @param[in]    bit_count Number of bits to clear
+ *
+ * Clear all bits within the range defined as
+ * [@p start_bit, @p start_bit + @p bit_count[.
+ *
+ * @warning
+ * - When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ *   @p bit_count is zero, result is undefined. A zero @p bit_count triggers an
+ *   assertion otherwise.
+ * - The sum `start_bit + bit_count` **MUST** be lower than or equal to the
+ *   number of bits specified at initialization time.
+ *   If not, result is undefined when the #CONFIG_STROLL_ASSERT_API build
+ *   option is disabled. An assertion is triggered otherwise.
+ *
+ * @see
+ * - stroll_hbmap_clear()
+ * - stroll_hbmap_set_range()
+ */
+extern void
+stroll_hbmap_clear_range(struct stroll_hbmap * __restrict hbmap,
+                         unsigned int                     start_bit,
+                         unsigned int                     bit_count)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+/**
+ * Find the first set bit of a hierarchical bitmap.
+ *
+ * @param[in] hbmap Bitmap to search
+ *
+ * @return Index of first bit set (starting from 0) if found, a negative errno
+ *         like error code otherwise.
+ * @retval >=0     index of first set bit
+ * @retval -ENOENT no set bits found
+ *
+ * @see
+ * - stroll_hbmap_find_next_set()
+ * - stroll_hbmap_find_first_clear()
+ */
+extern int
+stroll_hbmap_find_first_set(const struct stroll_hbmap * __restrict hbmap)
+	__stroll_nonull(1) __stroll_pure __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Find the next set bit of a hierarchical bitmap.
+ *
+ * @param[in] hbmap  Bitmap to search
+ * @param[in] bit_no Index of bit to start searching from
+ *
+ * @return Index of first bit set (starting from 0) which index is greater than
+ *         or equal to @p bit_no if found, a negative errno like error code
+ *         otherwise.
+ * @retval >=0     index of next set bit
+ * @retval -ENOENT no set bits found
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and @p
+ * bit_no is greater than the number of bits specified at initialization time,
+ * result is undefined. An assertion is triggered otherwise.
+ *
+ * @see
+ * - stroll_hbmap_find_first_set()
+ * - stroll_hbmap_foreach_set()
+ */
+extern int
+stroll_hbmap_find_next_set(const struct stroll_hbmap * __restrict hbmap,
+                           unsigned int                           bit_no)
+	__stroll_nonull(1) __stroll_pure __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Iterate over bits set in a hierarchical bitmap.
+ *
+ * @param[in]  _hbmap  Bitmap to iterate over
+ * @param[out] _bit_no Index of current set bit, an `int` variable
+ *
+ * @see
+ * - stroll_hbmap_find_first_set()
+ * - stroll_hbmap_find_next_set()
+ */
+#define stroll_hbmap_foreach_set(_hbmap, _bit_no) \
+	for (_bit_no = stroll_hbmap_find_first_set(_hbmap); \
+	     _bit_no >= 0; \
+	     _bit_no = stroll_hbmap_find_next_set(_hbmap, \
+	                                          (unsigned int)_bit_no + 1))
+
+/**
+ * Find the first cleared bit of a hierarchical bitmap.
+ *
+ * @param[in] hbmap Bitmap to search
+ *
+ * @return Index of first bit cleared (starting from 0) if found, a negative
+ *         errno like error code otherwise.
+ * @retval >=0     index of first cleared bit
+ * @retval -ENOENT no cleared bits found
+ *
+ * @see
+ * - stroll_hbmap_find_next_clear()
+ * - stroll_hbmap_find_first_set()
+ */
+extern int
+stroll_hbmap_find_first_clear(const struct stroll_hbmap * __restrict hbmap)
+	__stroll_nonull(1) __stroll_pure __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Find the next cleared bit of a hierarchical bitmap.
+ *
+ * @param[in] hbmap  Bitmap to search
+ * @param[in] bit_no Index of bit to start searching from
+ *
+ * @return Index of first bit cleared (starting from 0) which index is greater
+ *         than or equal to @p bit_no if found, a negative errno like error code
+ *         otherwise.
+ * @retval >=0     index of next cleared bit
+ * @retval -ENOENT no cleared bits found
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and @p
+ * bit_no is greater than the number of bits specified at initialization time,
+ * result is undefined. An assertion is triggered otherwise.
+ *
+ * @see
+ * - stroll_hbmap_find_first_clear()
+ * - stroll_hbmap_foreach_clear()
+ */
+extern int
+stroll_hbmap_find_next_clear(const struct stroll_hbmap * __restrict hbmap,
+                             unsigned int                           bit_no)
+	__stroll_nonull(1) __stroll_pure __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Iterate over bits cleared in a hierarchical bitmap.
+ *
+ * @param[in]  _hbmap  Bitmap to iterate over
+ * @param[out] _bit_no Index of current cleared bit, an `int` variable
+ *
+ * @see
+ * - stroll_hbmap_find_first_clear()
+ * - stroll_hbmap_find_next_clear()
+ */
+#define stroll_hbmap_foreach_clear(_hbmap, _bit_no) \
+	for (_bit_no = stroll_hbmap_find_first_clear(_hbmap); \
+	     _bit_no >= 0; \
+	     _bit_no = stroll_hbmap_find_next_clear(_hbmap, \
+	                                            (unsigned int)_bit_no + 1))
+
+/**
+ * Initialize a hierarchical bitmap with all bits cleared.
+ *
+ * @param[out] hbmap  Bitmap to initialize
+ * @param[in]  bit_nr Maximum number of bits @p hbmap may hold
+ *
+ * @return 0 if successful, a negative errno like error code otherwise.
+ * @retval 0       success
+ * @retval -ENOMEM memory allocation failure
+ *
+ * Once client code is done with @p hbmap, it *MUST* call stroll_hbmap_fini()
+ * to release allocated resources.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and @p
+ * bit_nr is zero or greater than `INT_MAX`, result is undefined. An assertion
+ * is triggered otherwise.
+ *
+ * @see
+ * - stroll_hbmap_init_set()
+ * - stroll_hbmap_fini()
+ */
+extern int
+stroll_hbmap_init_clear(struct stroll_hbmap * __restrict hbmap,
+                        unsigned int                     bit_nr)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Initialize a hierarchical bitmap with all bits set.
+ *
+ * @param[out] hbmap  Bitmap to initialize
+ * @param[in]  bit_nr Maximum number of bits @p hbmap may hold
+ *
+ * @return 0 if successful, a negative errno like error code otherwise.
+ * @retval 0       success
+ * @retval -ENOMEM memory allocation failure
+ *
+ * Once client code is done with @p hbmap, it *MUST* call stroll_hbmap_fini()
+ * to release allocated resources.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and @p
+ * bit_nr is zero or greater than `INT_MAX`, result is undefined. An assertion
+ * is triggered otherwise.
+ *
+ * @see
+ * - stroll_hbmap_init_clear()
+ * - stroll_hbmap_fini()
+ */
+extern int
+stroll_hbmap_init_set(struct stroll_hbmap * __restrict hbmap,
+                      unsigned int                     bit_nr)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Release resources allocated by a hierarchical bitmap.
+ *
+ * @param[inout] hbmap Bitmap to release
+ *
+ * @see
+ * - stroll_hbmap_init_clear()
+ * - stroll_hbmap_init_set()
+ */
+extern void
+stroll_hbmap_fini(struct stroll_hbmap * __restrict hbmap)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+#endif /* _STROLL_HBMAP_H */
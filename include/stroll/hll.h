@@ -0,0 +1,324 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+/**
+ * @file
+ * HyperLogLog cardinality estimator interface
+ *
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      18 Oct 2026
+ * @copyright Copyright (C) 2026 Grégor Boirie.
+ * @license   [GNU Lesser General Public License (LGPL) v3]
+ *            (https://www.gnu.org/licenses/lgpl+gpl-3.0.txt)
+ */
+
+#ifndef _STROLL_HLL_H
+#define _STROLL_HLL_H
+
+#include <stroll/cdefs.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <errno.h>
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+
+#include <stroll/assert.h>
+
+#define stroll_hll_assert_api(_expr) \
+	stroll_assert("stroll:hll", _expr)
+
+#else  /* !defined(CONFIG_STROLL_ASSERT_API) */
+
+#define stroll_hll_assert_api(_expr)
+
+#endif /* defined(CONFIG_STROLL_ASSERT_API) */
+
+/**
+ * Minimum HyperLogLog precision, i.e. base 2 logarithm of the number of
+ * registers.
+ */
+#define STROLL_HLL_PREC_MIN (4U)
+
+/**
+ * Maximum HyperLogLog precision, i.e. base 2 logarithm of the number of
+ * registers.
+ */
+#define STROLL_HLL_PREC_MAX (18U)
+
+/**
+ * HyperLogLog cardinality estimator.
+ *
+ * Estimate the number of distinct 64-bit keys registered into it using a fixed
+ * amount of memory with a relative standard error of about `1.04 / sqrt(m)`
+ * where `m = 2^precision` is the number of registers.
+ *
+ * Dense layout is a flat array of `m` 8-bit registers. Register `j` holds the
+ * maximum rank, i.e. the number of leading zero bits plus one, of the lower
+ * `64 - precision` bits of hashes of all keys which upper `precision` bits
+ * equal `j`. Such arrays may be merged across threads or processes using
+ * stroll_hll_merge_regs().
+ *
+ * A freshly initialized estimator starts with a sparse layout, i.e. a sorted
+ * array of 32-bit entries encoding a register index into the upper 24 bits
+ * and its rank into the lower 8 bits. It switches to dense layout as soon as
+ * the sparse array would use more memory than the dense one.
+ *
+ * @see
+ * - stroll_hll_init()
+ * - stroll_hll_fini()
+ */
+struct stroll_hll {
+	/**
+	 * @internal
+	 *
+	 * Base 2 logarithm of the number of registers.
+	 */
+	unsigned int prec;
+	/**
+	 * @internal
+	 *
+	 * Number of sparse entries in use.
+	 */
+	unsigned int sparse_nr;
+	/**
+	 * @internal
+	 *
+	 * Number of sparse entries allocated.
+	 */
+	unsigned int sparse_max;
+	/**
+	 * @internal
+	 *
+	 * Sorted array of sparse entries, NULL once dense.
+	 */
+	uint32_t *   sparse;
+	/**
+	 * @internal
+	 *
+	 * Flat array of dense registers, NULL while sparse.
+	 */
+	uint8_t *    regs;
+};
+
+#define stroll_hll_assert_sketch_api(_hll) \
+	stroll_hll_assert_api(_hll); \
+	stroll_hll_assert_api((_hll)->prec >= STROLL_HLL_PREC_MIN); \
+	stroll_hll_assert_api((_hll)->prec <= STROLL_HLL_PREC_MAX); \
+	stroll_hll_assert_api((_hll)->sparse_nr <= (_hll)->sparse_max); \
+	stroll_hll_assert_api(!(_hll)->regs || !(_hll)->sparse)
+
+/**
+ * Return the precision of a HyperLogLog estimator.
+ *
+ * @param[in] hll HyperLogLog estimator
+ *
+ * @return Base 2 logarithm of the number of registers
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+unsigned int
+stroll_hll_prec(const struct stroll_hll * __restrict hll)
+{
+	stroll_hll_assert_sketch_api(hll);
+
+	return hll->prec;
+}
+
+/**
+ * Return the number of registers of a HyperLogLog estimator.
+ *
+ * @param[in] hll HyperLogLog estimator
+ *
+ * @return Number of registers, i.e. number of bytes the dense layout is made
+ *         of
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+unsigned int
+stroll_hll_reg_nr(const struct stroll_hll * __restrict hll)
+{
+	stroll_hll_assert_sketch_api(hll);
+
+	return 1U << hll->prec;
+}
+
+/**
+ * Test wether a HyperLogLog estimator uses the sparse layout.
+ *
+ * @param[in] hll HyperLogLog estimator
+ *
+ * @return Test result
+ * @retval true  sparse layout
+ * @retval false dense layout
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+bool
+stroll_hll_is_sparse(const struct stroll_hll * __restrict hll)
+{
+	stroll_hll_assert_sketch_api(hll);
+
+	return !hll->regs;
+}
+
+/**
+ * Return the dense registers of a HyperLogLog estimator.
+ *
+ * @param[in] hll HyperLogLog estimator
+ *
+ * @return Flat array of stroll_hll_reg_nr() registers, NULL if @p hll uses the
+ *         sparse layout
+ *
+ * @see stroll_hll_densify()
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+const uint8_t *
+stroll_hll_regs(const struct stroll_hll * __restrict hll)
+{
+	stroll_hll_assert_sketch_api(hll);
+
+	return hll->regs;
+}
+
+/**
+ * Register a key into a HyperLogLog estimator.
+ *
+ * @param[inout] hll HyperLogLog estimator
+ * @param[in]    key Key to register
+ *
+ * @return an errno-like error code
+ * @retval 0       success
+ * @retval -ENOMEM memory allocation failed
+ *
+ * @see stroll_hll_count()
+ */
+extern int
+stroll_hll_insert(struct stroll_hll * __restrict hll, uint64_t key)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Estimate the number of distinct keys registered into a HyperLogLog
+ * estimator.
+ *
+ * @param[in] hll HyperLogLog estimator
+ *
+ * @return Estimated cardinality
+ *
+ * @see stroll_hll_insert()
+ */
+extern uint64_t
+stroll_hll_count(const struct stroll_hll * __restrict hll)
+	__stroll_nonull(1) __stroll_pure __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Switch a HyperLogLog estimator to dense layout.
+ *
+ * @param[inout] hll HyperLogLog estimator
+ *
+ * @return an errno-like error code
+ * @retval 0       success
+ * @retval -ENOMEM memory allocation failed
+ *
+ * Does nothing when @p hll already uses the dense layout.
+ *
+ * @see stroll_hll_regs()
+ */
+extern int
+stroll_hll_densify(struct stroll_hll * __restrict hll)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Merge dense HyperLogLog registers.
+ *
+ * @param[inout] result Registers to merge into
+ * @param[in]    regs   Registers to merge
+ * @param[in]    prec   Base 2 logarithm of the number of registers
+ *
+ * Compute the register wise maximum of @p result and @p regs and store it into
+ * @p result. This operates onto raw flat register arrays, as returned by
+ * stroll_hll_regs(), and is suitable for vectorization.
+ *
+ * @see stroll_hll_merge()
+ */
+extern void
+stroll_hll_merge_regs(uint8_t * __restrict       result,
+                      const uint8_t * __restrict regs,
+                      unsigned int               prec)
+	__stroll_nonull(1, 2) __stroll_nothrow __leaf;
+
+/**
+ * Merge HyperLogLog estimators.
+ *
+ * @param[inout] result HyperLogLog estimator to merge into
+ * @param[in]    hll    HyperLogLog estimator to merge
+ *
+ * @return an errno-like error code
+ * @retval 0       success
+ * @retval -ENOMEM memory allocation failed
+ *
+ * Update @p result so that it estimates the cardinality of the union of keys
+ * registered into @p result and @p hll. @p result is switched to dense layout
+ * unless both estimators use the sparse layout and their union fits.
+ *
+ * @warning
+ * Both estimators *MUST* share the same precision.
+ *
+ * @see stroll_hll_merge_regs()
+ */
+extern int
+stroll_hll_merge(struct stroll_hll * __restrict       result,
+                 const struct stroll_hll * __restrict hll)
+	__stroll_nonull(1, 2) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Unregister all keys from a HyperLogLog estimator.
+ *
+ * @param[inout] hll HyperLogLog estimator
+ *
+ * Layout is preserved, i.e. a dense estimator remains dense.
+ */
+extern void
+stroll_hll_clear(struct stroll_hll * __restrict hll)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+/**
+ * Initialize a HyperLogLog estimator.
+ *
+ * @param[out] hll  HyperLogLog estimator
+ * @param[in]  prec Base 2 logarithm of the number of registers
+ *
+ * Initialize an empty HyperLogLog estimator using the sparse layout. No memory
+ * is allocated until the first key is registered.
+ *
+ * @note
+ * Once client code is done with @p hll, it *MUST* call stroll_hll_fini() to
+ * release allocated resources.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * @p prec does not belong to the
+ * [#STROLL_HLL_PREC_MIN, #STROLL_HLL_PREC_MAX] range, result is undefined. An
+ * assertion is triggered otherwise.
+ *
+ * @see stroll_hll_fini()
+ */
+extern void
+stroll_hll_init(struct stroll_hll * __restrict hll, unsigned int prec)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+/**
+ * Finalize a HyperLogLog estimator.
+ *
+ * @param[inout] hll HyperLogLog estimator
+ *
+ * Release resources allocated for @p hll. Once called, you *MUST NOT* re-use
+ * @p hll unless re-initialized first.
+ *
+ * @see stroll_hll_init()
+ */
+extern void
+stroll_hll_fini(struct stroll_hll * __restrict hll)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+#endif /* _STROLL_HLL_H */
@@ -0,0 +1,439 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+/**
+ * @file
+ * Integer identifier allocator interface
+ *
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      18 Oct 2026
+ * @copyright Copyright (C) 2026 Grégor Boirie.
+ * @license   [GNU Lesser General Public License (LGPL) v3]
+ *            (https://www.gnu.org/licenses/lgpl+gpl-3.0.txt)
+ */
+
+#ifndef _STROLL_IDALLOC_H
+#define _STROLL_IDALLOC_H
+
+#include <stroll/fbmap.h>
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+
+#include <stroll/assert.h>
+
+#define stroll_idalloc_assert_api(_expr) \
+	stroll_assert("stroll:idalloc", _expr)
+
+#else  /* !defined(CONFIG_STROLL_ASSERT_API) */
+
+#define stroll_idalloc_assert_api(_expr)
+
+#endif /* defined(CONFIG_STROLL_ASSERT_API) */
+
+/**
+ * Integer identifier allocator.
+ *
+ * Allocates integer identifiers out of the range [0, nr[ where `nr` is set at
+ * initialization time. Identifiers in use are tracked by a stroll_fbmap fixed
+ * sized bitmap where a bit set means that the corresponding identifier is
+ * allocated.
+ *
+ * All operations are lock-free and may be run concurrently from multiple
+ * threads:
+ * - allocation claims bits using atomic compare-and-swap operations, starting
+ *   searches from a shared next-fit cursor to avoid re-scanning busy words,
+ * - release clears bits using atomic `fetch_and` operations.
+ *
+ * Contention on the bitmap may further be reduced thanks to per-thread /
+ * per-CPU stroll_idalloc_cache caches which grab identifiers by batches of up
+ * to a machine word worth of bits.
+ *
+ * @warning
+ * Cannot hold more than `INT_MAX` identifiers.
+ *
+ * @see
+ * - stroll_idalloc_init()
+ * - stroll_idalloc_cache
+ */
+struct stroll_idalloc {
+	/**
+	 * @internal
+	 *
+	 * Bitmap of allocated identifiers.
+	 */
+	struct stroll_fbmap map;
+	/**
+	 * @internal
+	 *
+	 * Next-fit cursor, i.e. index of word to start next search from.
+	 */
+	unsigned int        next;
+};
+
+#define stroll_idalloc_assert_alloc_api(_alloc) \
+	stroll_idalloc_assert_api(_alloc); \
+	stroll_idalloc_assert_api((_alloc)->map.bits); \
+	stroll_idalloc_assert_api((_alloc)->map.nr); \
+	stroll_idalloc_assert_api((_alloc)->map.nr <= (unsigned int)INT_MAX)
+
+/**
+ * Return the number of identifiers an integer identifier allocator manages.
+ *
+ * @param[in] alloc Identifier allocator
+ *
+ * @see stroll_idalloc_init()
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+unsigned int
+stroll_idalloc_nr(const struct stroll_idalloc * __restrict alloc)
+{
+	stroll_idalloc_assert_alloc_api(alloc);
+
+	return alloc->map.nr;
+}
+
+/**
+ * Test wether an identifier is allocated or not.
+ *
+ * @param[in] alloc Identifier allocator
+ * @param[in] id    Identifier to test
+ *
+ * @return Test result
+ * @retval true  @p id is allocated
+ * @retval false @p id is free
+ *
+ * @note
+ * When run concurrently with allocation / release operations, result is
+ * only a snapshot of @p id state at the time of the call.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and @p
+ * id is greater than or equal to the number of identifiers specified at
+ * initialization time, result is undefined. An assertion is triggered
+ * otherwise.
+ */
+static inline __stroll_nonull(1) __stroll_nothrow __warn_result
+bool
+stroll_idalloc_is_busy(const struct stroll_idalloc * __restrict alloc,
+                       unsigned int                             id)
+{
+	stroll_idalloc_assert_alloc_api(alloc);
+	stroll_idalloc_assert_api(id < alloc->map.nr);
+
+	return stroll_fbmap_atomic_test(&alloc->map, id, STROLL_ATOMIC_RELAXED);
+}
+
+/**
+ * Allocate an identifier.
+ *
+ * @param[inout] alloc Identifier allocator
+ *
+ * @return Allocated identifier or an errno-like error code
+ * @retval >=0     allocated identifier
+ * @retval -ENOSPC no more free identifiers
+ *
+ * Search for a free identifier starting from the next-fit cursor and claim it.
+ *
+ * @see
+ * - stroll_idalloc_free()
+ * - stroll_idalloc_alloc_range()
+ * - stroll_idalloc_alloc_cached()
+ */
+extern int
+stroll_idalloc_alloc(struct stroll_idalloc * __restrict alloc)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Release an identifier.
+ *
+ * @param[inout] alloc Identifier allocator
+ * @param[in]    id    Identifier to release
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and @p
+ * id is out of range or not allocated, result is undefined. An assertion is
+ * triggered otherwise.
+ *
+ * @see
+ * - stroll_idalloc_alloc()
+ */
+extern void
+stroll_idalloc_free(struct stroll_idalloc * __restrict alloc, unsigned int id)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+/**
+ * Reserve a range of identifiers.
+ *
+ * @param[inout] alloc    Identifier allocator
+ * @param[in]    start_id First identifier to reserve
+ * @param[in]    id_count Number of identifiers to reserve
+ *
+ * @return an errno-like error code
+ * @retval 0      success
+ * @retval -EBUSY at least one identifier of range is already allocated
+ *
+ * Claim all identifiers within the range defined as
+ * [@p start_id, @p start_id + @p id_count[. When at least one of them is
+ * already allocated, identifiers claimed so far are released and @p alloc is
+ * left unmodified.
+ *
+ * Words of the underlying bitmap are claimed one after the other, each of them
+ * atomically. Hence, concurrent reservations of overlapping ranges may all
+ * fail.
+ *
+ * Reserved identifiers may be released using stroll_idalloc_free_range().
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * range is empty or exceeds the number of identifiers specified at
+ * initialization time, result is undefined. An assertion is triggered
+ * otherwise.
+ *
+ * @see
+ * - stroll_idalloc_alloc_range()
+ * - stroll_idalloc_free_range()
+ */
+extern int
+stroll_idalloc_reserve_range(struct stroll_idalloc * __restrict alloc,
+                             unsigned int                       start_id,
+                             unsigned int                       id_count)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Allocate a range of contiguous identifiers.
+ *
+ * @param[inout] alloc    Identifier allocator
+ * @param[in]    id_count Number of identifiers to allocate
+ *
+ * @return First allocated identifier or an errno-like error code
+ * @retval >=0     first identifier of allocated range
+ * @retval -ENOSPC no range of @p id_count free identifiers found
+ *
+ * Search for @p id_count contiguous free identifiers starting from the
+ * next-fit cursor and claim them. This allows subsystems to own contiguous
+ * blocks of identifiers.
+ *
+ * Allocated identifiers may be released using stroll_idalloc_free_range().
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * @p id_count is zero or greater than the number of identifiers specified at
+ * initialization time, result is undefined. An assertion is triggered
+ * otherwise.
+ *
+ * @see
+ * - stroll_idalloc_reserve_range()
+ * - stroll_idalloc_free_range()
+ */
+extern int
+stroll_idalloc_alloc_range(struct stroll_idalloc * __restrict alloc,
+                           unsigned int                       id_count)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Release a range of identifiers.
+ *
+ * @param[inout] alloc    Identifier allocator
+ * @param[in]    start_id First identifier to release
+ * @param[in]    id_count Number of identifiers to release
+ *
+ * Release all identifiers within the range defined as
+ * [@p start_id, @p start_id + @p id_count[.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * range is empty, exceeds the number of identifiers specified at initialization
+ * time or contains identifiers not allocated, result is undefined. An assertion
+ * is triggered otherwise.
+ *
+ * @see
+ * - stroll_idalloc_reserve_range()
+ * - stroll_idalloc_alloc_range()
+ */
+extern void
+stroll_idalloc_free_range(struct stroll_idalloc * __restrict alloc,
+                          unsigned int                       start_id,
+                          unsigned int                       id_count)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+/**
+ * Initialize an integer identifier allocator.
+ *
+ * @param[out] alloc  Identifier allocator
+ * @param[in]  id_nr  Number of identifiers @p alloc may allocate
+ *
+ * @return an errno-like error code
+ * @retval 0       success
+ * @retval -ENOMEM memory allocation failed
+ *
+ * Initialize @p alloc so that it may allocate identifiers out of the range
+ * [0, @p id_nr[. All identifiers are initially free.
+ *
+ * @note
+ * Once client code is done with @p alloc, it *MUST* call stroll_idalloc_fini()
+ * to release allocated resources.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and
+ * @p id_nr is zero or > `INT_MAX`, result is undefined. An assertion is
+ * triggered otherwise.
+ *
+ * @see stroll_idalloc_fini()
+ */
+extern int
+stroll_idalloc_init(struct stroll_idalloc * __restrict alloc,
+                    unsigned int                       id_nr)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Finalize an integer identifier allocator.
+ *
+ * @param[inout] alloc Identifier allocator
+ *
+ * Release resources allocated for @p alloc. Once called, you *MUST NOT* re-use
+ * @p alloc unless re-initialized first.
+ *
+ * @see stroll_idalloc_init()
+ */
+static inline __stroll_nonull(1) __stroll_nothrow
+void
+stroll_idalloc_fini(struct stroll_idalloc * __restrict alloc)
+{
+	stroll_idalloc_assert_alloc_api(alloc);
+
+	stroll_fbmap_fini(&alloc->map);
+}
+
+/**
+ * Integer identifier allocator cache.
+ *
+ * A cache of preallocated identifiers meant to be owned by a single thread /
+ * CPU. It holds a batch of identifiers belonging to a single word of the
+ * stroll_idalloc bitmap, all claimed at once thanks to a single atomic
+ * operation.
+ *
+ * Allocating and releasing identifiers through a cache does not touch the
+ * shared bitmap until the batch is exhausted, which considerably reduces
+ * contention when multiple threads allocate identifiers concurrently.
+ *
+ * @warning
+ * A stroll_idalloc_cache is not thread-safe by itself: it *MUST* be protected
+ * against concurrent accesses, typically by storing it into thread-local or
+ * per-CPU storage.
+ *
+ * @see
+ * - stroll_idalloc_init_cache()
+ * - stroll_idalloc_alloc_cached()
+ * - stroll_idalloc_free_cached()
+ * - stroll_idalloc_flush_cache()
+ */
+struct stroll_idalloc_cache {
+	/**
+	 * @internal
+	 *
+	 * Index of stroll_idalloc bitmap word identifiers are cached from.
+	 */
+	unsigned int  word;
+	/**
+	 * @internal
+	 *
+	 * Mask of cached identifiers within word.
+	 */
+	unsigned long ids;
+};
+
+#define STROLL_IDALLOC_CACHE_INIT \
+	{ .word = UINT_MAX, .ids = 0 }
+
+/**
+ * Initialize an integer identifier allocator cache.
+ *
+ * @param[out] cache Identifier allocator cache
+ *
+ * Initialize @p cache as empty.
+ *
+ * @see
+ * - #STROLL_IDALLOC_CACHE_INIT
+ * - stroll_idalloc_flush_cache()
+ */
+static inline __stroll_nonull(1) __stroll_nothrow
+void
+stroll_idalloc_init_cache(struct stroll_idalloc_cache * __restrict cache)
+{
+	stroll_idalloc_assert_api(cache);
+
+	cache->word = UINT_MAX;
+	cache->ids = 0;
+}
+
+/**
+ * Allocate an identifier through a cache.
+ *
+ * @param[inout] alloc Identifier allocator
+ * @param[inout] cache Identifier allocator cache
+ *
+ * @return Allocated identifier or an errno-like error code
+ * @retval >=0     allocated identifier
+ * @retval -ENOSPC no more free identifiers
+ *
+ * Pick an identifier from @p cache. When @p cache is empty, refill it first
+ * with a batch of free identifiers claimed from @p alloc.
+ *
+ * @see
+ * - stroll_idalloc_free_cached()
+ * - stroll_idalloc_alloc()
+ */
+extern int
+stroll_idalloc_alloc_cached(struct stroll_idalloc * __restrict       alloc,
+                            struct stroll_idalloc_cache * __restrict cache)
+	__stroll_nonull(1, 2) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Release an identifier through a cache.
+ *
+ * @param[inout] alloc Identifier allocator
+ * @param[inout] cache Identifier allocator cache
+ * @param[in]    id    Identifier to release
+ *
+ * When @p id belongs to the batch @p cache currently holds, give it back to @p
+ * cache. Release it into @p alloc otherwise.
+ *
+ * @p id may have been allocated using any allocation function.
+ *
+ * @warning
+ * When compiled with the #CONFIG_STROLL_ASSERT_API build option disabled and @p
+ * id is out of range or not allocated, result is undefined. An assertion is
+ * triggered otherwise.
+ *
+ * @see
+ * - stroll_idalloc_alloc_cached()
+ * - stroll_idalloc_free()
+ */
+extern void
+stroll_idalloc_free_cached(struct stroll_idalloc * __restrict       alloc,
+                           struct stroll_idalloc_cache * __restrict cache,
+                           unsigned int                             id)
+	__stroll_nonull(1, 2) __stroll_nothrow __leaf;
+
+/**
+ * Release all identifiers an integer identifier allocator cache holds.
+ *
+ * @param[inout] alloc Identifier allocator
+ * @param[inout] cache Identifier allocator cache
+ *
+ * Release all identifiers @p cache holds into @p alloc and leave @p cache
+ * empty. Client code *MUST* flush caches before calling stroll_idalloc_fini().
+ *
+ * @see
+ * - stroll_idalloc_init_cache()
+ */
+extern void
+stroll_idalloc_flush_cache(struct stroll_idalloc * __restrict       alloc,
+                           struct stroll_idalloc_cache * __restrict cache)
+	__stroll_nonull(1, 2) __stroll_nothrow __leaf;
+
+#endif /* _STROLL_IDALLOC_H */
@@ -0,0 +1,457 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+/**
+ * @file
+ * Compressed (Roaring) bitmap interface
+ *
+ * @author    Grégor Boirie <gregor.boirie@free.fr>
+ * @date      18 Oct 2026
+ * @copyright Copyright (C) 2026 Grégor Boirie.
+ * @license   [GNU Lesser General Public License (LGPL) v3]
+ *            (https://www.gnu.org/licenses/lgpl+gpl-3.0.txt)
+ */
+
+#ifndef _STROLL_RBMAP_H
+#define _STROLL_RBMAP_H
+
+#include <stroll/cdefs.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+
+#include <stroll/assert.h>
+
+#define stroll_rbmap_assert_api(_expr) \
+	stroll_assert("stroll:rbmap", _expr)
+
+#else  /* !defined(CONFIG_STROLL_ASSERT_API) */
+
+#define stroll_rbmap_assert_api(_expr)
+
+#endif /* defined(CONFIG_STROLL_ASSERT_API) */
+
+struct stroll_rbmap_cont;
+
+/**
+ * Compressed bitmap.
+ *
+ * A set of 32-bit unsigned integers implemented according to the Roaring
+ * bitmap scheme.
+ *
+ * The 32-bit integer space is split into chunks of 65536 integers sharing the
+ * same 16 most significant bits. Each chunk holding at least one integer is
+ * stored into a container which kind depends on chunk content:
+ * - an *array* container, i.e. a sorted array of 16-bit values, holds sparse
+ *   chunks of up to 4096 integers,
+ * - a *bitmap* container, i.e. a 65536 bits wide bitmap, holds dense chunks of
+ *   more than 4096 integers,
+ * - a *run* container, i.e. a sorted array of runs of consecutive integers,
+ *   holds clustered chunks once converted using stroll_rbmap_optimize().
+ *
+ * Memory usage is proportional to the number of integers stored instead of
+ * the width of the integer space, i.e. at most 8 KiB per chunk and roughly 2
+ * bytes per integer for sparse sets.
+ *
+ * @see
+ * - stroll_rbmap_init()
+ * - stroll_rbmap_init_deserialize()
+ */
+struct stroll_rbmap {
+	/**
+	 * @internal
+	 *
+	 * Number of containers.
+	 */
+	unsigned int               nr;
+	/**
+	 * @internal
+	 *
+	 * Number of containers @p conts may hold.
+	 */
+	unsigned int               size;
+	/**
+	 * @internal
+	 *
+	 * Containers sorted by increasing chunk index.
+	 */
+	struct stroll_rbmap_cont * conts;
+};
+
+#define stroll_rbmap_assert_map_api(_rbmap) \
+	stroll_rbmap_assert_api(_rbmap); \
+	stroll_rbmap_assert_api((_rbmap)->nr <= (_rbmap)->size); \
+	stroll_rbmap_assert_api(!(_rbmap)->size || (_rbmap)->conts)
+
+/**
+ * Test wether a compressed bitmap is empty or not.
+ *
+ * @param[in] rbmap Compressed bitmap
+ *
+ * @return Test result
+ * @retval true  @p rbmap holds no integers
+ * @retval false @p rbmap holds at least one integer
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+bool
+stroll_rbmap_empty(const struct stroll_rbmap * __restrict rbmap)
+{
+	stroll_rbmap_assert_map_api(rbmap);
+
+	return !rbmap->nr;
+}
+
+/**
+ * Return the number of integers a compressed bitmap holds.
+ *
+ * @param[in] rbmap Compressed bitmap
+ *
+ * @return Cardinality of @p rbmap
+ */
+extern uint64_t
+stroll_rbmap_cardinality(const struct stroll_rbmap * __restrict rbmap)
+	__stroll_nonull(1) __stroll_pure __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Test wether an integer is held by a compressed bitmap or not.
+ *
+ * @param[in] rbmap Compressed bitmap
+ * @param[in] value Integer to test
+ *
+ * @return Test result
+ * @retval true  @p value is held by @p rbmap
+ * @retval false @p value is not held by @p rbmap
+ */
+extern bool
+stroll_rbmap_contains(const struct stroll_rbmap * __restrict rbmap,
+                      uint32_t                               value)
+	__stroll_nonull(1) __stroll_pure __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Add an integer to a compressed bitmap.
+ *
+ * @param[inout] rbmap Compressed bitmap
+ * @param[in]    value Integer to add
+ *
+ * @return an errno-like error code
+ * @retval 0       success
+ * @retval -ENOMEM memory allocation failed
+ *
+ * Adding an integer already held by @p rbmap is a no-op.
+ *
+ * @see stroll_rbmap_remove()
+ */
+extern int
+stroll_rbmap_add(struct stroll_rbmap * __restrict rbmap, uint32_t value)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Remove an integer from a compressed bitmap.
+ *
+ * @param[inout] rbmap Compressed bitmap
+ * @param[in]    value Integer to remove
+ *
+ * @return an errno-like error code
+ * @retval 0       success
+ * @retval -ENOMEM memory allocation failed
+ *
+ * Removing an integer not held by @p rbmap is a no-op. Removal may fail since
+ * it may require to split a run of integers or to convert a container to a
+ * more compact representation.
+ *
+ * @see stroll_rbmap_add()
+ */
+extern int
+stroll_rbmap_remove(struct stroll_rbmap * __restrict rbmap, uint32_t value)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Perform the bitwise AND of 2 compressed bitmaps.
+ *
+ * @param[inout] result Compressed bitmap where to store operation result
+ * @param[in]    first  First compressed bitmap operand
+ * @param[in]    second Second compressed bitmap operand
+ *
+ * @return an errno-like error code
+ * @retval 0       success
+ * @retval -ENOMEM memory allocation failed
+ *
+ * Replace content of @p result with integers held by both @p first and @p
+ * second, i.e. `result = first & second`.
+ *
+ * @p result *MUST* be initialized and may refer to one of @p first or @p
+ * second operands. It is left unmodified on failure.
+ *
+ * @see
+ * - stroll_rbmap_or()
+ * - stroll_rbmap_xor()
+ * - stroll_rbmap_andnot()
+ */
+extern int
+stroll_rbmap_and(struct stroll_rbmap *       result,
+                 const struct stroll_rbmap * first,
+                 const struct stroll_rbmap * second)
+	__stroll_nonull(1, 2, 3) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Perform the bitwise OR of 2 compressed bitmaps.
+ *
+ * @param[inout] result Compressed bitmap where to store operation result
+ * @param[in]    first  First compressed bitmap operand
+ * @param[in]    second Second compressed bitmap operand
+ *
+ * @return an errno-like error code
+ * @retval 0       success
+ * @retval -ENOMEM memory allocation failed
+ *
+ * Replace content of @p result with integers held by @p first or @p second,
+ * i.e. `result = first | second`.
+ *
+ * @p result *MUST* be initialized and may refer to one of @p first or @p
+ * second operands. It is left unmodified on failure.
+ *
+ * @see
+ * - stroll_rbmap_and()
+ * - stroll_rbmap_xor()
+ * - stroll_rbmap_andnot()
+ */
+extern int
+stroll_rbmap_or(struct stroll_rbmap *       result,
+                const struct stroll_rbmap * first,
+                const struct stroll_rbmap * second)
+	__stroll_nonull(1, 2, 3) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Perform the bitwise XOR of 2 compressed bitmaps.
+ *
+ * @param[inout] result Compressed bitmap where to store operation result
+ * @param[in]    first  First compressed bitmap operand
+ * @param[in]    second Second compressed bitmap operand
+ *
+ * @return an errno-like error code
+ * @retval 0       success
+ * @retval -ENOMEM memory allocation failed
+ *
+ * Replace content of @p result with integers held by either @p first or @p
+ * second but not both, i.e. `result = first ^ second`.
+ *
+ * @p result *MUST* be initialized and may refer to one of @p first or @p
+ * second operands. It is left unmodified on failure.
+ *
+ * @see
+ * - stroll_rbmap_and()
+ * - stroll_rbmap_or()
+ * - stroll_rbmap_andnot()
+ */
+extern int
+stroll_rbmap_xor(struct stroll_rbmap *       result,
+                 const struct stroll_rbmap * first,
+                 const struct stroll_rbmap * second)
+	__stroll_nonull(1, 2, 3) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Perform the bitwise AND NOT of 2 compressed bitmaps.
+ *
+ * @param[inout] result Compressed bitmap where to store operation result
+ * @param[in]    first  First compressed bitmap operand
+ * @param[in]    second Second compressed bitmap operand
+ *
+ * @return an errno-like error code
+ * @retval 0       success
+ * @retval -ENOMEM memory allocation failed
+ *
+ * Replace content of @p result with integers held by @p first but not by @p
+ * second, i.e. `result = first & ~second`.
+ *
+ * @p result *MUST* be initialized and may refer to one of @p first or @p
+ * second operands. It is left unmodified on failure.
+ *
+ * @see
+ * - stroll_rbmap_and()
+ * - stroll_rbmap_or()
+ * - stroll_rbmap_xor()
+ */
+extern int
+stroll_rbmap_andnot(struct stroll_rbmap *       result,
+                    const struct stroll_rbmap * first,
+                    const struct stroll_rbmap * second)
+	__stroll_nonull(1, 2, 3) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Convert containers of a compressed bitmap to their most compact form.
+ *
+ * @param[inout] rbmap Compressed bitmap
+ *
+ * @return an errno-like error code
+ * @retval 0       success
+ * @retval -ENOMEM memory allocation failed
+ *
+ * Convert each container of @p rbmap to a run container when doing so reduces
+ * memory usage, and back to array or bitmap containers otherwise. This is
+ * typically suited to sets of clustered integers once built.
+ *
+ * On failure, @p rbmap content is left unmodified although some containers may
+ * have been converted.
+ */
+extern int
+stroll_rbmap_optimize(struct stroll_rbmap * __restrict rbmap)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Return the size of the serialized form of a compressed bitmap.
+ *
+ * @param[in] rbmap Compressed bitmap
+ *
+ * @return Size in bytes
+ *
+ * @see stroll_rbmap_serialize()
+ */
+extern size_t
+stroll_rbmap_serialized_size(const struct stroll_rbmap * __restrict rbmap)
+	__stroll_nonull(1) __stroll_pure __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Serialize a compressed bitmap.
+ *
+ * @param[in]  rbmap  Compressed bitmap
+ * @param[out] buffer Memory area where to store serialized form
+ * @param[in]  size   Size of @p buffer in bytes
+ *
+ * @return Size of serialized form in bytes or an errno-like error code
+ * @retval >0      size of serialized form
+ * @retval -ENOSPC @p buffer too small
+ *
+ * Store @p rbmap content into @p buffer according to the portable Roaring
+ * bitmap serialization format, i.e. a little-endian, architecture independent
+ * format other Roaring implementations may load.
+ *
+ * @see
+ * - stroll_rbmap_serialized_size()
+ * - stroll_rbmap_init_deserialize()
+ */
+extern ssize_t
+stroll_rbmap_serialize(const struct stroll_rbmap * __restrict rbmap,
+                       void * __restrict                      buffer,
+                       size_t                                 size)
+	__stroll_nonull(1, 2) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Initialize a compressed bitmap from its serialized form.
+ *
+ * @param[out] rbmap  Compressed bitmap
+ * @param[in]  buffer Memory area holding serialized form
+ * @param[in]  size   Size of @p buffer in bytes
+ *
+ * @return an errno-like error code
+ * @retval 0       success
+ * @retval -EINVAL malformed serialized form
+ * @retval -ENOMEM memory allocation failed
+ *
+ * Initialize @p rbmap with content of @p buffer which *MUST* hold a compressed
+ * bitmap serialized according to the portable Roaring bitmap serialization
+ * format. Content of @p buffer is fully validated before use.
+ *
+ * @note
+ * Once client code is done with @p rbmap, it *MUST* call stroll_rbmap_fini()
+ * to release allocated resources.
+ *
+ * @see
+ * - stroll_rbmap_serialize()
+ * - stroll_rbmap_fini()
+ */
+extern int
+stroll_rbmap_init_deserialize(struct stroll_rbmap * __restrict rbmap,
+                              const void * __restrict          buffer,
+                              size_t                           size)
+	__stroll_nonull(1, 2) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Initialize an empty compressed bitmap.
+ *
+ * @param[out] rbmap Compressed bitmap
+ *
+ * @note
+ * Once client code is done with @p rbmap, it *MUST* call stroll_rbmap_fini()
+ * to release allocated resources.
+ *
+ * @see stroll_rbmap_fini()
+ */
+static inline __stroll_nonull(1) __stroll_nothrow
+void
+stroll_rbmap_init(struct stroll_rbmap * __restrict rbmap)
+{
+	stroll_rbmap_assert_api(rbmap);
+
+	rbmap->nr = 0;
+	rbmap->size = 0;
+	rbmap->conts = NULL;
+}
+
+/**
+ * Finalize a compressed bitmap.
+ *
+ * @param[inout] rbmap Compressed bitmap
+ *
+ * Release resources allocated for @p rbmap. Once called, you *MUST NOT* re-use
+ * @p rbmap unless re-initialized first.
+ *
+ * @see
+ * - stroll_rbmap_init()
+ * - stroll_rbmap_init_deserialize()
+ */
+extern void
+stroll_rbmap_fini(struct stroll_rbmap * __restrict rbmap)
+	__stroll_nonull(1) __stroll_nothrow __leaf;
+
+/**
+ * Compressed bitmap iterator.
+ *
+ * An opaque structure that holds internal state of a stroll_rbmap compressed
+ * bitmap iteration.
+ *
+ * @see
+ * - stroll_rbmap_foreach()
+ */
+struct stroll_rbmap_iter {
+	unsigned long               word;
+	unsigned int                index;
+	unsigned int                value;
+	unsigned int                cont;
+	const struct stroll_rbmap * rbmap;
+};
+
+extern int64_t
+stroll_rbmap_step_iter(struct stroll_rbmap_iter * __restrict iter)
+	__stroll_nonull(1) __stroll_nothrow __leaf __warn_result;
+
+extern int64_t
+stroll_rbmap_init_iter(struct stroll_rbmap_iter * __restrict  iter,
+                       const struct stroll_rbmap * __restrict rbmap)
+	__stroll_nonull(1, 2) __stroll_nothrow __leaf __warn_result;
+
+/**
+ * Iterate over all integers held by a compressed bitmap.
+ *
+ * @param[inout] _iter  Temporary iteration state
+ * @param[in]    _rbmap Compressed bitmap to iterate over
+ * @param[out]   _value Current integer, an `int64_t` lvalue
+ *
+ * Given an uninitialed @p iter stroll_rbmap_iter iterator, iterate over
+ * integers held by @p _rbmap stroll_rbmap compressed bitmap in increasing
+ * order and update @p _value to reflect current integer.
+ *
+ * @warning
+ * @p _rbmap *MUST NOT* be modified while iterating.
+ */
+#define stroll_rbmap_foreach(_iter, _rbmap, _value) \
+	for ((_value) = stroll_rbmap_init_iter(_iter, _rbmap); \
+	     (_value) >= 0; \
+	     (_value) = stroll_rbmap_step_iter(_iter))
+
+#endif /* _STROLL_RBMAP_H */
@@ -6,9 +6,11 @@
  ******************************************************************************/
 
 #include "array.h"
+#include "stroll/bops.h"
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#include <limits.h>
 
 #define STROLL_ARRAY_DEFINE_SWAP(_func, _type) \
 	void \
@@ -572,6 +574,33 @@ struct stroll_array_quick {
 	stroll_array_assert_intern((_parms)->compare); \
 	stroll_array_assert_intern((_parms)->thres)
 
+/*
+ * Introsort depth limit and median-of-three pivot selection are used by both
+ * quicksort and 3-way quicksort but not by pattern-defeating quicksort which
+ * comes with its own pivot selection and fallback schemes.
+ */
+#if defined(CONFIG_STROLL_ARRAY_QUICK_SORT) || \
+    defined(CONFIG_STROLL_ARRAY_3WQUICK_SORT)
+
+/*
+ * Return the maximum recursion depth quicksort may reach before falling back
+ * to heapsort, i.e. 2 * floor(log2(nr)), as stated by Musser's introsort.
+ *
+ * Adversarial or patterned inputs such as "organ-pipe" ones may defeat the
+ * median-of-three pivot selection strategy, making quicksort degrade to
+ * O(n^2) time. Switching to heapsort once partitioning goes deeper than
+ * expected for random inputs bounds sorting time to O(n.log(n)) in the worst
+ * case.
+ */
+static __stroll_const __stroll_nothrow __warn_result
+unsigned int
+stroll_array_quick_depth(unsigned int nr)
+{
+	stroll_array_assert_intern(nr);
+
+	return 2 * (stroll_bops_fls(nr) - 1);
+}
+
 #define STROLL_ARRAY_DEFINE_QUICK_MED(_med_func, _swap_func, _type) \
 	static __stroll_nonull(1, 2, 3) \
 	_type \
@@ -616,7 +645,10 @@ struct stroll_array_quick {
 			.thres    = _thres \
 		}; \
 		\
-		_recsort_func(&parms, array, &array[(nr - 1)]); \
+		_recsort_func(&parms, \
+		              array, \
+		              &array[(nr - 1)], \
+		              stroll_array_quick_depth(nr)); \
 		\
 		_insert_func(array, nr, compare, data); \
 	}
@@ -673,8 +705,210 @@ stroll_array_quick_med_mem(
 	memcpy(pivot, mid, sz);
 }
 
+#endif /* defined(CONFIG_STROLL_ARRAY_QUICK_SORT) || \
+          defined(CONFIG_STROLL_ARRAY_3WQUICK_SORT) */
+
 #endif /* defined(CONFIG_STROLL_ARRAY_QUICK_SORT_UTILS) */
 
+#if defined(CONFIG_STROLL_ARRAY_MT_UTILS)
+
+#include <pthread.h>
+#include <unistd.h>
+
+/*
+ * Minimum number of elements each thread should process for multi-threading
+ * to be worth the cost of spawning threads.
+ */
+#define STROLL_ARRAY_MT_MIN_NR (8192U)
+
+struct stroll_array_team;
+
+typedef void (stroll_array_team_fn)(struct stroll_array_team * __restrict,
+                                    unsigned int);
+
+struct stroll_array_team_worker {
+	struct stroll_array_team * team;
+	unsigned int               id;
+	int                        err;
+	pthread_t                  thread;
+};
+
+/*
+ * Team of threads cooperating to sort an array.
+ *
+ * The calling thread acts as the first worker of the team. Other workers are
+ * spawned on a per-call basis and wait for the calling thread to complete the
+ * setup of shared data structures according to the final number of workers
+ * before running `run'.
+ * Workers may synchronize with each other using the `barrier' and report
+ * errors through their own `err' field.
+ */
+struct stroll_array_team {
+	stroll_array_team_fn *            run;
+	unsigned int                      nr;
+	struct stroll_array_team_worker * workers;
+	bool                              start;
+	int                               err;
+	pthread_mutex_t                   lock;
+	pthread_cond_t                    cond;
+	pthread_barrier_t                 barrier;
+};
+
+#define STROLL_ARRAY_TEAM_INIT(_run) \
+	{ \
+		.run     = _run, \
+		.nr      = 0, \
+		.workers = NULL, \
+		.start   = false, \
+		.err     = 0, \
+		.lock    = PTHREAD_MUTEX_INITIALIZER, \
+		.cond    = PTHREAD_COND_INITIALIZER \
+	}
+
+/*
+ * Return the number of threads to process `nr' elements with, given the
+ * maximum number of threads requested by the user, 0 meaning all online CPUs.
+ */
+static __stroll_nothrow __warn_result
+unsigned int
+stroll_array_team_size(unsigned int nthreads, unsigned int nr)
+{
+	if (!nthreads) {
+		long cpus;
+
+		cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		nthreads = (cpus > 1) ? (unsigned int)stroll_min(cpus,
+		                                                 (long)UINT_MAX)
+		                      : 1;
+	}
+
+	return stroll_min(nthreads, nr / STROLL_ARRAY_MT_MIN_NR);
+}
+
+/* Wait for all workers of the team to reach this point. */
+static inline __stroll_nonull(1)
+void
+stroll_array_team_sync(struct stroll_array_team * __restrict team)
+{
+	stroll_array_assert_intern(team);
+
+	pthread_barrier_wait(&team->barrier);
+}
+
+/* Return the first error a worker met, if any. */
+static __stroll_nonull(1) __stroll_pure __warn_result
+int
+stroll_array_team_error(const struct stroll_array_team * __restrict team)
+{
+	stroll_array_assert_intern(team);
+
+	unsigned int w;
+
+	for (w = 0; w < team->nr; w++)
+		if (team->workers[w].err)
+			return team->workers[w].err;
+
+	return 0;
+}
+
+static __stroll_nonull(1)
+void *
+stroll_array_team_thread(void * arg)
+{
+	struct stroll_array_team_worker * worker = arg;
+	struct stroll_array_team *        team = worker->team;
+	bool                              abort;
+
+	/* Wait for the final number of workers to be known. */
+	pthread_mutex_lock(&team->lock);
+	while (!team->start)
+		pthread_cond_wait(&team->cond, &team->lock);
+	abort = !!team->err;
+	pthread_mutex_unlock(&team->lock);
+
+	if (!abort)
+		team->run(team, worker->id);
+
+	return NULL;
+}
+
+/*
+ * Spawn up to `nthreads - 1' worker threads, the calling thread acting as the
+ * first worker. When failing to spawn a thread, go on with the ones already
+ * spawned: on return, `team->nr' holds the final number of workers.
+ */
+static __stroll_nonull(1) __warn_result
+int
+stroll_array_team_spawn(struct stroll_array_team * __restrict team,
+                        unsigned int                          nthreads)
+{
+	stroll_array_assert_intern(team);
+	stroll_array_assert_intern(team->run);
+	stroll_array_assert_intern(nthreads > 1);
+
+	unsigned int w;
+
+	team->workers = calloc(nthreads, sizeof(team->workers[0]));
+	if (!team->workers)
+		return -errno;
+
+	for (w = 0; w < nthreads; w++) {
+		team->workers[w].team = team;
+		team->workers[w].id = w;
+		if (w && pthread_create(&team->workers[w].thread,
+		                        NULL,
+		                        stroll_array_team_thread,
+		                        &team->workers[w]))
+			break;
+	}
+
+	team->nr = w;
+
+	return 0;
+}
+
+/*
+ * Unleash spawned workers, run the first one from the calling thread and wait
+ * for all of them to complete.
+ */
+static __stroll_nonull(1) __warn_result
+int
+stroll_array_team_run(struct stroll_array_team * __restrict team)
+{
+	stroll_array_assert_intern(team);
+	stroll_array_assert_intern(team->nr);
+	stroll_array_assert_intern(team->workers);
+
+	unsigned int w;
+	int          err;
+
+	/* Tell workers to give up when barrier cannot be initialized. */
+	pthread_mutex_lock(&team->lock);
+	team->err = -pthread_barrier_init(&team->barrier, NULL, team->nr);
+	team->start = true;
+	pthread_cond_broadcast(&team->cond);
+	pthread_mutex_unlock(&team->lock);
+
+	if (!team->err)
+		team->run(team, 0);
+
+	for (w = 1; w < team->nr; w++)
+		pthread_join(team->workers[w].thread, NULL);
+
+	if (!team->err) {
+		pthread_barrier_destroy(&team->barrier);
+		err = stroll_array_team_error(team);
+	}
+	else
+		err = team->err;
+
+	free(team->workers);
+
+	return err;
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_MT_UTILS) */
+
 #if defined(CONFIG_STROLL_ARRAY_QUICK_SORT)
 
 #if CONFIG_STROLL_ARRAY_QUICK_SORT_INSERT_THRESHOLD < 2
@@ -725,21 +959,33 @@ stroll_array_quick_med_mem(
 	void \
 	_recsort_func(const struct stroll_array_quick * __restrict parms, \
 	              _type *                                      array, \
-	              _type *                                      last) \
+	              _type *                                      last, \
+	              unsigned int                                 depth) \
 	{ \
 		stroll_array_quick_assert(parms); \
 		stroll_array_assert_intern(array); \
 		stroll_array_assert_intern(last >= array); \
 		\
 		while (&array[parms->thres] <= last) { \
-			_type * pivot = _part_func(parms, array, last); \
+			_type * pivot; \
 			\
+			if (!depth--) { \
+				stroll_array_fbheap_sort( \
+					array, \
+					(unsigned int)(last - array) + 1, \
+					sizeof(_type), \
+					parms->compare, \
+					parms->data); \
+				return; \
+			} \
+			\
+			pivot = _part_func(parms, array, last); \
 			if ((pivot - array) < (last - pivot)) { \
-				_recsort_func(parms, array, pivot); \
+				_recsort_func(parms, array, pivot, depth); \
 				array = pivot + 1; \
 			} \
 			else { \
-				_recsort_func(parms, pivot + 1, last); \
+				_recsort_func(parms, pivot + 1, last, depth); \
 				last = pivot; \
 			} \
 		} \
@@ -911,7 +1157,8 @@ void
 stroll_array_quick_sort_recmem(
 	const struct stroll_array_quick * __restrict parms,
 	char *                                       array,
-	char *                                       last)
+	char *                                       last,
+	unsigned int                                 depth)
 {
 	stroll_array_quick_assert(parms);
 	stroll_array_assert_intern(parms->size);
@@ -933,6 +1180,21 @@ stroll_array_quick_sort_recmem(
 		size_t sz = parms->size;
 		char * pivot;
 
+		/*
+		 * Partitioning went deeper than 2 * log2(n): the pivot
+		 * selection strategy has been defeated by input content.
+		 * Fall back to heapsort to prevent from O(n^2) behavior.
+		 */
+		if (!depth--) {
+			stroll_array_fbheap_sort(
+				array,
+				(unsigned int)((size_t)(last - array) / sz) + 1,
+				sz,
+				parms->compare,
+				parms->data);
+			return;
+		}
+
 		/*
 		 * Partition [array:last] into 2 sub-arrays according to the
 		 * Hoare's partitioning scheme:
@@ -959,11 +1221,17 @@ stroll_array_quick_sort_recmem(
 		 * - a second sub-array containing all other elements.
 		 */
 		if ((pivot - array) < (last - pivot)) {
-			stroll_array_quick_sort_recmem(parms, array, pivot);
+			stroll_array_quick_sort_recmem(parms,
+			                               array,
+			                               pivot,
+			                               depth);
 			array = &pivot[sz];
 		}
 		else {
-			stroll_array_quick_sort_recmem(parms, &pivot[sz], last);
+			stroll_array_quick_sort_recmem(parms,
+			                               &pivot[sz],
+			                               last,
+			                               depth);
 			last = pivot;
 		}
 	}
@@ -994,7 +1262,10 @@ stroll_array_quick_sort_mem(char * __restrict     array,
 	 * of elements of current partition is larger than
 	 * STROLL_QSORT_INSERT_THRESHOLD.
 	 */
-	stroll_array_quick_sort_recmem(&parms, array, &array[(nr - 1) * size]);
+	stroll_array_quick_sort_recmem(&parms,
+	                               array,
+	                               &array[(nr - 1) * size],
+	                               stroll_array_quick_depth(nr));
 
 	/*
 	 * Now that array is k-sorted (where k equals
@@ -1164,7 +1435,8 @@ stroll_array_quick_sort(void * __restrict     array,
 	void \
 	_recsort_func(const struct stroll_array_quick * __restrict parms, \
 	              _type *                                      array, \
-	              _type *                                      last) \
+	              _type *                                      last, \
+	              unsigned int                                 depth) \
 	{ \
 		stroll_array_quick_assert(parms); \
 		stroll_array_assert_intern(array); \
@@ -1174,14 +1446,24 @@ stroll_array_quick_sort(void * __restrict     array,
 			_type * low = array; \
 			_type * high = last; \
 			\
+			if (!depth--) { \
+				stroll_array_fbheap_sort( \
+					array, \
+					(unsigned int)(last - array) + 1, \
+					sizeof(_type), \
+					parms->compare, \
+					parms->data); \
+				return; \
+			} \
+			\
 			_part_func(parms, &low, &high); \
 			\
 			if ((low - array) < (last - high)) { \
-				_recsort_func(parms, array, low); \
+				_recsort_func(parms, array, low, depth); \
 				array = high; \
 			} \
 			else { \
-				_recsort_func(parms, high, last); \
+				_recsort_func(parms, high, last, depth); \
 				last = low; \
 			} \
 		} \
@@ -1470,26 +1752,51 @@ void
 stroll_array_3wquick_sort_recmem(
 	const struct stroll_array_quick * __restrict parms,
 	char *                                       array,
-	char *                                       last)
+	char *                                       last,
+	unsigned int                                 depth)
 {
 	stroll_array_quick_assert(parms);
 	stroll_array_assert_intern(parms->size);
 	stroll_array_assert_intern(array);
 	stroll_array_assert_intern(last);
-	stroll_array_assert_intern(!((size_t)(last - array) % parms->size));
+	/*
+	 * 3-way partitioning may produce empty sub-arrays, in which case
+	 * `last' points to the element preceding `array'.
+	 */
+	stroll_array_assert_intern(last >= (array - parms->size));
+	stroll_array_assert_intern(
+		!((size_t)(last + parms->size - array) % parms->size));
 
 	while (&array[parms->thres] <= last) {
 		char * low = array;
 		char * high = last;
 
+		/* See stroll_array_quick_sort_recmem(). */
+		if (!depth--) {
+			stroll_array_fbheap_sort(
+				array,
+				(unsigned int)((size_t)(last - array) /
+				               parms->size) + 1,
+				parms->size,
+				parms->compare,
+				parms->data);
+			return;
+		}
+
 		stroll_array_3wquick_part_mem(parms, &low, &high);
 
 		if ((low - array) < (last - high)) {
-			stroll_array_3wquick_sort_recmem(parms, array, low);
+			stroll_array_3wquick_sort_recmem(parms,
+			                                 array,
+			                                 low,
+			                                 depth);
 			array = high;
 		}
 		else {
-			stroll_array_3wquick_sort_recmem(parms, high, last);
+			stroll_array_3wquick_sort_recmem(parms,
+			                                 high,
+			                                 last,
+			                                 depth);
 			last = low;
 		}
 	}
@@ -1522,7 +1829,8 @@ stroll_array_3wquick_sort_mem(char * __restrict     array,
 	 */
 	stroll_array_3wquick_sort_recmem(&parms,
 	                                 array,
-	                                 &array[(nr - 1) * size]);
+	                                 &array[(nr - 1) * size],
+	                                 stroll_array_quick_depth(nr));
 
 	/*
 	 * Now that array is k-sorted (where k equals
@@ -1561,532 +1869,5994 @@ stroll_array_3wquick_sort(void * __restrict     array,
 		stroll_array_3wquick_sort_mem(array, nr, size, compare, data);
 }
 
-#endif /* defined(CONFIG_STROLL_ARRAY_3WQUICK_SORT) */
+#if defined(CONFIG_STROLL_ARRAY_SAMPLE_SORT_MT)
 
-#if defined(CONFIG_STROLL_ARRAY_MERGE_SORT)
+/* Number of buckets per thread, allowing to balance the load dynamically. */
+#define STROLL_ARRAY_SAMPLE_MT_BUCKETS    (4U)
 
-#if CONFIG_STROLL_ARRAY_MERGE_SORT_INSERT_THRESHOLD < 2
-#error Invalid Mergesort insertion threshold !
-#endif /* CONFIG_STROLL_ARRAY_MERGE_SORT_INSERT_THRESHOLD < 2 */
+/* Number of samples per bucket used to select splitters. */
+#define STROLL_ARRAY_SAMPLE_MT_OVERSAMPLE (32U)
 
-#define STROLL_MSORT_INSERT_THRESHOLD \
-	STROLL_CONCAT(CONFIG_STROLL_ARRAY_MERGE_SORT_INSERT_THRESHOLD, U)
+/*
+ * Maximum number of threads, so that element classes, i.e. buckets and
+ * splitters, fit into 16-bit integers.
+ */
+#define STROLL_ARRAY_SAMPLE_MT_THREADS_MAX \
+	(UINT16_MAX / (2 * STROLL_ARRAY_SAMPLE_MT_BUCKETS))
 
-struct stroll_array_merge {
-	size_t                size;
-	stroll_array_cmp_fn * compare;
-	void *                data;
-	size_t                thres;
+/*
+ * Multi-threaded sample sort context.
+ *
+ * `spl_nr' sorted splitters partition elements into `cls_nr' classes: even
+ * classes hold elements located strictly between 2 consecutive splitters
+ * while odd classes hold elements equal to a splitter, which need no further
+ * sorting.
+ * Each worker first classifies the elements of its own chunk, recording the
+ * class of each element into `classes' and the number of elements per class
+ * into its own row of `counts'. Workers then scatter elements of their chunk
+ * to auxiliary buffer at offsets computed by prefix summing `counts', so that
+ * classes end up contiguous. Finally, classes are dynamically claimed by
+ * workers thanks to `next', sorted using 3-way quick sort and copied back to
+ * array.
+ */
+struct stroll_array_sample_mt {
+	struct stroll_array_team team;
+	char *                   array;
+	char *                   aux;
+	unsigned int             nr;
+	size_t                   size;
+	stroll_array_cmp_fn *    compare;
+	void *                   data;
+	const char *             splitters;
+	unsigned int             spl_nr;
+	unsigned int             cls_nr;
+	uint16_t *               classes;
+	unsigned int *           counts;
+	unsigned int *           offsets;
+	unsigned int *           starts;
+	unsigned int             next;
 };
 
-#define stroll_array_merge_assert(_parms) \
-	stroll_array_assert_intern(_parms); \
-	stroll_array_assert_intern((_parms)->compare); \
-	stroll_array_assert_intern((_parms)->thres)
+static __stroll_nonull(1, 2) __warn_result
+unsigned int
+stroll_array_sample_mt_classify(
+	const struct stroll_array_sample_mt * __restrict ctx,
+	const char * __restrict                          elem)
+{
+	stroll_array_assert_intern(ctx);
+	stroll_array_assert_intern(elem);
 
-#define STROLL_ARRAY_MERGE_PART_RUNS(_func, _type) \
-	static inline __stroll_nonull(1, 2, 3, 4, 5, 6) \
+	unsigned int lo = 0;
+	unsigned int hi = ctx->spl_nr;
+
+	/* Find the first splitter that is not lower than elem. */
+	while (lo < hi) {
+		unsigned int mid = lo + ((hi - lo) / 2);
+
+		if (ctx->compare(&ctx->splitters[mid * ctx->size],
+		                 elem,
+		                 ctx->data) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	if ((lo < ctx->spl_nr) &&
+	    !ctx->compare(elem, &ctx->splitters[lo * ctx->size], ctx->data))
+		return (2 * lo) + 1;
+
+	return 2 * lo;
+}
+
+static inline __stroll_nonull(1, 2)
+void
+stroll_array_sample_mt_move(char * __restrict       dst,
+                            const char * __restrict src,
+                            size_t                  size)
+{
+	/* Give the compiler a chance to inline copies of common sizes. */
+	if (size == sizeof(uint32_t))
+		memcpy(dst, src, sizeof(uint32_t));
+	else if (size == sizeof(uint64_t))
+		memcpy(dst, src, sizeof(uint64_t));
+	else
+		memcpy(dst, src, size);
+}
+
+static __stroll_nonull(1)
+void
+stroll_array_sample_mt_run(struct stroll_array_team * __restrict team,
+                           unsigned int                          id)
+{
+	stroll_array_assert_intern(team);
+	stroll_array_assert_intern(id < team->nr);
+
+	struct stroll_array_sample_mt * ctx =
+		containerof(team, struct stroll_array_sample_mt, team);
+	size_t                          size = ctx->size;
+	unsigned int                    cls_nr = ctx->cls_nr;
+	unsigned int                    lo = (unsigned int)
+	                                     (((unsigned long long)ctx->nr *
+	                                       id) / team->nr);
+	unsigned int                    hi = (unsigned int)
+	                                     (((unsigned long long)ctx->nr *
+	                                       (id + 1)) / team->nr);
+	unsigned int *                  cnts = &ctx->counts[id * cls_nr];
+	unsigned int *                  offs = &ctx->offsets[id * cls_nr];
+	unsigned int                    off = 0;
+	unsigned int                    n;
+	unsigned int                    c;
+
+	/* Classify elements of own chunk. */
+	for (n = lo; n < hi; n++) {
+		c = stroll_array_sample_mt_classify(ctx,
+		                                    &ctx->array[n * size]);
+		ctx->classes[n] = (uint16_t)c;
+		cnts[c]++;
+	}
+
+	stroll_array_team_sync(team);
+
+	/*
+	 * Compute the location of own elements within each class. Within a
+	 * class, elements of lower numbered workers come first.
+	 */
+	for (c = 0; c < cls_nr; c++) {
+		unsigned int w;
+
+		if (!id)
+			ctx->starts[c] = off;
+
+		for (w = 0; w < team->nr; w++) {
+			if (w == id)
+				offs[c] = off;
+			off += ctx->counts[(w * cls_nr) + c];
+		}
+	}
+	if (!id)
+		ctx->starts[cls_nr] = off;
+
+	/* Scatter elements of own chunk to auxiliary buffer. */
+	for (n = lo; n < hi; n++)
+		stroll_array_sample_mt_move(
+			&ctx->aux[offs[ctx->classes[n]]++ * size],
+			&ctx->array[n * size],
+			size);
+
+	stroll_array_team_sync(team);
+
+	/* Sort classes not sorted yet and move them back to array. */
+	while ((c = __atomic_fetch_add(&ctx->next, 1, __ATOMIC_RELAXED)) <
+	       cls_nr) {
+		unsigned int start = ctx->starts[c];
+		unsigned int cnt = ctx->starts[c + 1] - start;
+
+		if (!cnt)
+			continue;
+
+		if (!(c & 1) && (cnt > 1))
+			stroll_array_3wquick_sort(&ctx->aux[start * size],
+			                          cnt,
+			                          size,
+			                          ctx->compare,
+			                          ctx->data);
+
+		memcpy(&ctx->array[start * size],
+		       &ctx->aux[start * size],
+		       cnt * size);
+	}
+}
+
+/*
+ * Select splitters out of a randomly picked sample of elements. Splitters are
+ * stored at the beginning of the samples buffer.
+ */
+static __stroll_nonull(1, 2)
+void
+stroll_array_sample_mt_select(
+	const struct stroll_array_sample_mt * __restrict ctx,
+	char * __restrict                                samples,
+	unsigned int                                     smpl_nr)
+{
+	uint64_t     seed = UINT64_C(0x9e3779b97f4a7c15) ^ ctx->nr;
+	size_t       size = ctx->size;
+	unsigned int s;
+
+	for (s = 0; s < smpl_nr; s++) {
+		seed ^= seed << 13;
+		seed ^= seed >> 7;
+		seed ^= seed << 17;
+
+		memcpy(&samples[s * size],
+		       &ctx->array[(seed % ctx->nr) * size],
+		       size);
+	}
+
+	stroll_array_3wquick_sort(samples,
+	                          smpl_nr,
+	                          size,
+	                          ctx->compare,
+	                          ctx->data);
+
+	for (s = 1; s <= ctx->spl_nr; s++)
+		memcpy(&samples[(s - 1) * size],
+		       &samples[s * STROLL_ARRAY_SAMPLE_MT_OVERSAMPLE * size],
+		       size);
+}
+
+int
+stroll_array_sample_sort_mt(void * __restrict     array,
+                            unsigned int          nr,
+                            size_t                size,
+                            stroll_array_cmp_fn * compare,
+                            void *                data,
+                            unsigned int          nthreads)
+{
+	stroll_array_assert_api(array);
+	stroll_array_assert_api(nr);
+	stroll_array_assert_api(size);
+	stroll_array_assert_api(compare);
+
+	struct stroll_array_sample_mt ctx = {
+		.team    = STROLL_ARRAY_TEAM_INIT(stroll_array_sample_mt_run),
+		.array   = array,
+		.nr      = nr,
+		.size    = size,
+		.compare = compare,
+		.data    = data,
+		.next    = 0
+	};
+	unsigned int                  bkt_nr;
+	unsigned int                  smpl_nr;
+	char *                        samples;
+	int                           err;
+
+	nthreads = stroll_min(stroll_array_team_size(nthreads, nr),
+	                      STROLL_ARRAY_SAMPLE_MT_THREADS_MAX);
+	if (nthreads <= 1) {
+		stroll_array_3wquick_sort(array, nr, size, compare, data);
+		return 0;
+	}
+
+	bkt_nr = nthreads * STROLL_ARRAY_SAMPLE_MT_BUCKETS;
+	smpl_nr = bkt_nr * STROLL_ARRAY_SAMPLE_MT_OVERSAMPLE;
+	ctx.spl_nr = bkt_nr - 1;
+	ctx.cls_nr = (2 * ctx.spl_nr) + 1;
+
+	ctx.aux = malloc(nr * size);
+	if (!ctx.aux)
+		return -errno;
+
+	samples = malloc(smpl_nr * size);
+	if (!samples) {
+		err = -errno;
+		goto free_aux;
+	}
+
+	ctx.classes = malloc(nr * sizeof(ctx.classes[0]));
+	if (!ctx.classes) {
+		err = -errno;
+		goto free_samples;
+	}
+
+	/* Per-worker counts and offsets followed by class start offsets. */
+	ctx.counts = calloc((2 * nthreads * ctx.cls_nr) + ctx.cls_nr + 1,
+	                    sizeof(ctx.counts[0]));
+	if (!ctx.counts) {
+		err = -errno;
+		goto free_classes;
+	}
+	ctx.offsets = &ctx.counts[nthreads * ctx.cls_nr];
+	ctx.starts = &ctx.offsets[nthreads * ctx.cls_nr];
+
+	stroll_array_sample_mt_select(&ctx, samples, smpl_nr);
+	ctx.splitters = samples;
+
+	err = stroll_array_team_spawn(&ctx.team, nthreads);
+	if (err)
+		goto free_counts;
+
+	err = stroll_array_team_run(&ctx.team);
+
+free_counts:
+	free(ctx.counts);
+free_classes:
+	free(ctx.classes);
+free_samples:
+	free(samples);
+free_aux:
+	free(ctx.aux);
+
+	return err;
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_SAMPLE_SORT_MT) */
+
+#endif /* defined(CONFIG_STROLL_ARRAY_3WQUICK_SORT) */
+
+#if defined(CONFIG_STROLL_ARRAY_PDQUICK_SORT)
+
+#if CONFIG_STROLL_ARRAY_PDQUICK_SORT_INSERT_THRESHOLD < 8
+#error Invalid pattern-defeating quicksort insertion threshold !
+#endif /* CONFIG_STROLL_ARRAY_PDQUICK_SORT_INSERT_THRESHOLD < 8 */
+
+#define STROLL_PDQSORT_INSERT_THRESHOLD \
+	STROLL_CONCAT(CONFIG_STROLL_ARRAY_PDQUICK_SORT_INSERT_THRESHOLD, U)
+
+/*
+ * Partitions holding more elements than this are given a pivot selected
+ * according to Tukey's ninther (pseudo-median of 9) instead of median-of-three.
+ */
+#define STROLL_PDQSORT_NINTHER_THRESHOLD (128U)
+
+/*
+ * Maximum number of element moves partial insertion sort may perform before
+ * giving up.
+ */
+#define STROLL_PDQSORT_PARTIAL_INSERT_LIMIT (8U)
+
+/*
+ * Number of elements examined at once by each side of the branchless block
+ * partitioning scheme. Must fit into an uint8_t offset.
+ */
+#define STROLL_PDQSORT_BLOCK_SIZE ((size_t)64)
+
+/*
+ * Compute the number of elements each side of the block partitioning scheme
+ * should scan to refill its empty offset buffer given the number of elements
+ * not yet scanned and the number of offsets both buffers currently hold.
+ */
+static inline __stroll_nonull(4, 5) __stroll_nothrow
+void
+stroll_array_pdquick_split(size_t              unknown,
+                           unsigned int        nr_l,
+                           unsigned int        nr_r,
+                           size_t * __restrict split_l,
+                           size_t * __restrict split_r)
+{
+	size_t l = !nr_l ? (!nr_r ? unknown / 2 : unknown) : 0;
+	size_t r = !nr_r ? unknown - l : 0;
+
+	*split_l = stroll_min(l, STROLL_PDQSORT_BLOCK_SIZE);
+	*split_r = stroll_min(r, STROLL_PDQSORT_BLOCK_SIZE);
+}
+
+#define STROLL_ARRAY_DEFINE_PDQUICK_SORT3(_sort3_func, _swap_func, _type) \
+	static __stroll_nonull(1, 2, 3, 4) \
 	void \
-	_func(const struct stroll_array_merge * __restrict parms, \
-	      _type * __restrict                           result, \
-	      const _type * __restrict                     part0, \
-	      const _type * __restrict                     end0, \
-	      const _type * __restrict                     part1, \
-	      const _type * __restrict                     end1) \
+	_sort3_func(const struct stroll_array_quick * __restrict parms, \
+	            _type *                                      first, \
+	            _type *                                      second, \
+	            _type *                                      third) \
 	{ \
-		do { \
-			if (parms->compare(part0, part1, parms->data) <= 0) { \
-				*result = *part0; \
-				part0++; \
-			} \
-			else { \
-				*result = *part1; \
-				part1++; \
-			} \
-			\
-			result++; \
-		} while ((part0 < end0) && (part1 < end1)); \
+		if (parms->compare(second, first, parms->data) < 0) \
+			_swap_func(first, second); \
 		\
-		if (part0 != end0) { \
-			stroll_array_assert_intern(part0 < end0); \
-			stroll_array_assert_intern(part1 >= end1); \
-			\
-			memcpy(result, \
-			       part0, \
-			       (size_t)(end0 - part0) * parms->size); \
-		} \
-		else if (part1 != end1) { \
-			stroll_array_assert_intern(part1 < end1); \
-			stroll_array_assert_intern(part0 >= end0); \
+		if (parms->compare(third, second, parms->data) < 0) { \
+			_swap_func(second, third); \
 			\
-			memcpy(result, \
-			       part1, \
-			       (size_t)(end1 - part1) * parms->size); \
+			if (parms->compare(second, first, parms->data) < 0) \
+				_swap_func(first, second); \
 		} \
 	}
 
-#define STROLL_ARRAY_MERGE_PARTS(_func, _runs_func, _type) \
-	static __stroll_nonull(1, 2, 3, 4, 5, 6) \
-	void \
-	_func(const struct stroll_array_merge * __restrict parms, \
-	      _type * __restrict                           result, \
-	      const _type * __restrict                     part0, \
-	      const _type * __restrict                     end0, \
-	      const _type * __restrict                     part1, \
-	      const _type * __restrict                     end1) \
+#define STROLL_ARRAY_DEFINE_PDQUICK_PART_LEFT(_part_func, _swap_func, _type) \
+	static __stroll_nonull(1, 2, 3) \
+	_type * \
+	_part_func(const struct stroll_array_quick * __restrict parms, \
+	           _type *                                      begin, \
+	           _type *                                      end) \
 	{ \
-		stroll_array_merge_assert(parms); \
-		stroll_array_assert_intern(parms->size); \
-		stroll_array_assert_intern(part0); \
-		stroll_array_assert_intern(end0 > part0); \
-		stroll_array_assert_intern(part1); \
-		stroll_array_assert_intern(end1 > part1); \
+		_type   pivot = *begin; \
+		_type * first = begin; \
+		_type * last = end; \
 		\
-		if (stroll_array_merge_full_runs(parms, \
-		                                 (char *)result, \
-		                                 (const char *)part0, \
-		                                 (const char *)end0, \
-		                                 (const char *)part1, \
-		                                 (const char *)end1)) \
-			return; \
+		while (parms->compare(&pivot, --last, parms->data) < 0) \
+			; \
 		\
-		_runs_func(parms, result, part0, end0, part1, end1); \
+		if ((last + 1) == end) \
+			while ((first < last) && \
+			       (parms->compare(&pivot, \
+			                       ++first, \
+			                       parms->data) >= 0)) \
+				; \
+		else \
+			while (parms->compare(&pivot, \
+			                      ++first, \
+			                      parms->data) >= 0) \
+				; \
+		\
+		while (first < last) { \
+			_swap_func(first, last); \
+			while (parms->compare(&pivot, \
+			                      --last, \
+			                      parms->data) < 0) \
+				; \
+			while (parms->compare(&pivot, \
+			                      ++first, \
+			                      parms->data) >= 0) \
+				; \
+		} \
+		\
+		*begin = *last; \
+		*last = pivot; \
+		\
+		return last; \
 	}
 
-#define STROLL_ARRAY_INSERT_OOPSORT(_func, _insert_oopsort_elem, _type) \
+#define STROLL_ARRAY_DEFINE_PDQUICK_PART_RIGHT(_part_func, _swap_func, _type) \
 	static __stroll_nonull(1, 2, 3, 4) \
-	void \
-	_func(const struct stroll_array_merge * __restrict parms, \
-	      _type * __restrict                           result, \
-	      const _type * __restrict                     array, \
-	      const _type * __restrict                     end) \
+	_type * \
+	_part_func(const struct stroll_array_quick * __restrict parms, \
+	           _type *                                      begin, \
+	           _type *                                      end, \
+	           bool * __restrict                            parted) \
 	{ \
-		_type * res; \
+		_type   pivot = *begin; \
+		_type * first = begin; \
+		_type * last = end; \
 		\
-		*result = *array; \
+		while (parms->compare(++first, &pivot, parms->data) < 0) \
+			; \
 		\
-		for (res = result + 1, array++; array != end; res++, array++) \
-			_insert_oopsort_elem(result, \
-			                     res, \
-			                     array, \
-			                     parms->compare, \
-			                     parms->data); \
+		if ((first - 1) == begin) \
+			while ((first < last) && \
+			       (parms->compare(--last, \
+			                       &pivot, \
+			                       parms->data) >= 0)) \
+				; \
+		else \
+			while (parms->compare(--last, \
+			                      &pivot, \
+			                      parms->data) >= 0) \
+				; \
+		\
+		*parted = (first >= last); \
+		if (!*parted) { \
+			uint8_t      offs_l[STROLL_PDQSORT_BLOCK_SIZE]; \
+			uint8_t      offs_r[STROLL_PDQSORT_BLOCK_SIZE]; \
+			_type *      base_l; \
+			_type *      base_r; \
+			unsigned int nr_l = 0; \
+			unsigned int nr_r = 0; \
+			unsigned int start_l = 0; \
+			unsigned int start_r = 0; \
+			\
+			_swap_func(first, last); \
+			first++; \
+			\
+			base_l = first; \
+			base_r = last; \
+			while (first < last) { \
+				size_t       unknown = (size_t)(last - first); \
+				size_t       split_l; \
+				size_t       split_r; \
+				unsigned int o; \
+				unsigned int n; \
+				\
+				stroll_array_pdquick_split(unknown, \
+				                           nr_l, \
+				                           nr_r, \
+				                           &split_l, \
+				                           &split_r); \
+				\
+				for (o = 0; o < split_l; o++) { \
+					int cmp = parms->compare(first++, \
+					                         &pivot, \
+					                         parms->data); \
+					\
+					offs_l[nr_l] = (uint8_t)o; \
+					nr_l += (cmp >= 0); \
+				} \
+				\
+				for (o = 0; o < split_r; ) { \
+					int cmp = parms->compare(--last, \
+					                         &pivot, \
+					                         parms->data); \
+					\
+					offs_r[nr_r] = (uint8_t)++o; \
+					nr_r += (cmp < 0); \
+				} \
+				\
+				n = stroll_min(nr_l, nr_r); \
+				for (o = 0; o < n; o++) \
+					_swap_func( \
+						&base_l[offs_l[start_l + o]], \
+						base_r - offs_r[start_r + o]); \
+				\
+				nr_l -= n; \
+				nr_r -= n; \
+				start_l += n; \
+				start_r += n; \
+				if (!nr_l) { \
+					start_l = 0; \
+					base_l = first; \
+				} \
+				if (!nr_r) { \
+					start_r = 0; \
+					base_r = last; \
+				} \
+			} \
+			\
+			if (nr_l) { \
+				const uint8_t * offs = &offs_l[start_l]; \
+				\
+				while (nr_l--) \
+					_swap_func(&base_l[offs[nr_l]], \
+					           --last); \
+				first = last; \
+			} \
+			if (nr_r) { \
+				const uint8_t * offs = &offs_r[start_r]; \
+				\
+				while (nr_r--) { \
+					_swap_func(base_r - offs[nr_r], \
+					           first); \
+					first++; \
+				} \
+				last = first; \
+			} \
+		} \
+		\
+		first--; \
+		*begin = *first; \
+		*first = pivot; \
+		\
+		return first; \
 	}
 
-#define STROLL_ARRAY_MERGE_TOPDWN(_func, _insert_oopsort, _merge_func, _type) \
-	static __stroll_nonull(1, 2, 3, 4) \
-	void \
-	_func(const struct stroll_array_merge * __restrict parms, \
-	      _type * __restrict                           result, \
-	      _type * __restrict                           array, \
-	      const _type * __restrict                     end) \
+#define STROLL_ARRAY_DEFINE_PDQUICK_PARTIAL_INSERT(_insert_func, _type) \
+	static __stroll_nonull(1, 2, 3) \
+	bool \
+	_insert_func(const struct stroll_array_quick * __restrict parms, \
+	             _type *                                      begin, \
+	             _type *                                      end) \
 	{ \
-		stroll_array_merge_assert(parms); \
-		stroll_array_assert_intern(result); \
-		stroll_array_assert_intern(end > array); \
-		\
-		unsigned int nr = (unsigned int)(end - array); \
-		unsigned int nr0; \
+		unsigned int moved = 0; \
+		_type *      curr; \
 		\
-		if ((nr * sizeof(*array)) <= parms->thres) { \
-			stroll_array_assert_intern(nr >= 1); \
-			_insert_oopsort(parms, result, array, end); \
-			return; \
+		for (curr = begin + 1; curr < end; curr++) { \
+			_type * sift = curr; \
+			_type * prev = curr - 1; \
+			\
+			if (parms->compare(sift, prev, parms->data) < 0) { \
+				_type tmp = *sift; \
+				\
+				do { \
+					*sift-- = *prev; \
+				} while ((sift != begin) && \
+				         (parms->compare(&tmp, \
+				                         --prev, \
+				                         parms->data) < 0)); \
+				\
+				*sift = tmp; \
+				moved += (unsigned int)(curr - sift); \
+			} \
+			\
+			if (moved > STROLL_PDQSORT_PARTIAL_INSERT_LIMIT) \
+				return false; \
 		} \
 		\
-		nr0 = nr / 2; \
+		return true; \
+	}
+
+/*
+ * Break patterns of an unbalanced partition by swapping a few elements at fixed
+ * positions so that next pivot selection will likely give better results.
+ */
+#define STROLL_ARRAY_DEFINE_PDQUICK_BREAK(_break_func, _swap_func, _type) \
+	static __stroll_nonull(1, 2) \
+	void \
+	_break_func(_type * begin, _type * end) \
+	{ \
+		size_t nr = (size_t)(end - begin); \
+		size_t q = nr / 4; \
 		\
-		_func(parms, &result[nr0], &array[nr0], end); \
-		_func(parms, &array[nr - nr0], array, &array[nr0]); \
-		_merge_func(parms, \
-		            result, \
-		            &array[nr - nr0], \
-		            end, \
-		            &result[nr0], \
-		            &result[nr]); \
+		_swap_func(begin, &begin[q]); \
+		_swap_func(end - 1, end - q); \
+		if (nr > STROLL_PDQSORT_NINTHER_THRESHOLD) { \
+			_swap_func(&begin[1], &begin[q + 1]); \
+			_swap_func(&begin[2], &begin[q + 2]); \
+			_swap_func(end - 2, end - (q + 1)); \
+			_swap_func(end - 3, end - (q + 2)); \
+		} \
 	}
 
-#define STROLL_ARRAY_MERGE_SORT(_func, _topdwn_func, _merge_func, _type) \
+#define STROLL_ARRAY_DEFINE_PDQUICK_RECSORT(_recsort_func, \
+                                            _sort3_func, \
+                                            _part_left_func, \
+                                            _part_right_func, \
+                                            _partial_insert_func, \
+                                            _break_func, \
+                                            _insert_func, \
+                                            _swap_func, \
+                                            _type) \
+	static __stroll_nonull(1, 2, 3) \
+	void \
+	_recsort_func(const struct stroll_array_quick * __restrict parms, \
+	              _type *                                      begin, \
+	              _type *                                      end, \
+	              unsigned int                                 bad, \
+	              bool                                         leftmost) \
+	{ \
+		stroll_array_quick_assert(parms); \
+		stroll_array_assert_intern(begin); \
+		stroll_array_assert_intern(end >= begin); \
+		\
+		while (true) { \
+			size_t  nr = (size_t)(end - begin); \
+			size_t  half = nr / 2; \
+			_type * pivot; \
+			size_t  nr_l; \
+			size_t  nr_r; \
+			bool    parted; \
+			\
+			if (nr < parms->thres) { \
+				if (nr > 1) \
+					_insert_func(begin, \
+					             (unsigned int)nr, \
+					             parms->compare, \
+					             parms->data); \
+				return; \
+			} \
+			\
+			if (nr > STROLL_PDQSORT_NINTHER_THRESHOLD) { \
+				_sort3_func(parms, \
+				            begin, \
+				            &begin[half], \
+				            &end[-1]); \
+				_sort3_func(parms, \
+				            &begin[1], \
+				            &begin[half - 1], \
+				            &end[-2]); \
+				_sort3_func(parms, \
+				            &begin[2], \
+				            &begin[half + 1], \
+				            &end[-3]); \
+				_sort3_func(parms, \
+				            &begin[half - 1], \
+				            &begin[half], \
+				            &begin[half + 1]); \
+				_swap_func(begin, &begin[half]); \
+			} \
+			else \
+				_sort3_func(parms, \
+				            &begin[half], \
+				            begin, \
+				            &end[-1]); \
+			\
+			if (!leftmost && \
+			    (parms->compare(&begin[-1], \
+			                    begin, \
+			                    parms->data) >= 0)) { \
+				pivot = _part_left_func(parms, begin, end); \
+				begin = pivot + 1; \
+				continue; \
+			} \
+			\
+			pivot = _part_right_func(parms, begin, end, &parted); \
+			nr_l = (size_t)(pivot - begin); \
+			nr_r = (size_t)(end - (pivot + 1)); \
+			\
+			if ((nr_l < (nr / 8)) || (nr_r < (nr / 8))) { \
+				if (!--bad) { \
+					stroll_array_fbheap_sort( \
+						begin, \
+						(unsigned int)nr, \
+						sizeof(_type), \
+						parms->compare, \
+						parms->data); \
+					return; \
+				} \
+				\
+				if (nr_l >= parms->thres) \
+					_break_func(begin, pivot); \
+				if (nr_r >= parms->thres) \
+					_break_func(&pivot[1], end); \
+			} \
+			else if (parted && \
+			         _partial_insert_func(parms, begin, pivot) && \
+			         _partial_insert_func(parms, &pivot[1], end)) \
+				return; \
+			\
+			if (nr_l < nr_r) { \
+				_recsort_func(parms, \
+				              begin, \
+				              pivot, \
+				              bad, \
+				              leftmost); \
+				begin = &pivot[1]; \
+				leftmost = false; \
+			} \
+			else { \
+				_recsort_func(parms, \
+				              &pivot[1], \
+				              end, \
+				              bad, \
+				              false); \
+				end = pivot; \
+			} \
+		} \
+	}
+
+#define STROLL_ARRAY_DEFINE_PDQUICK_SORT(_sort_func, _recsort_func, _type) \
 	static __stroll_nonull(1, 3) \
-	int \
-	_func(_type * __restrict    array, \
-	      unsigned int          nr, \
-	      stroll_array_cmp_fn * compare, \
-	      void *                data) \
+	void \
+	_sort_func(_type * __restrict    array, \
+	           unsigned int          nr, \
+	           stroll_array_cmp_fn * compare, \
+	           void *                data) \
 	{ \
 		stroll_array_assert_intern(array); \
 		stroll_array_assert_intern(nr > 1); \
 		stroll_array_assert_intern(compare); \
 		\
-		_type *                         aux; \
-		unsigned int                    anr = nr / 2; \
-		_type *                         mid = &array[anr]; \
-		unsigned int                    mnr = nr - anr; \
-		const struct stroll_array_merge parms = { \
-			.size    = sizeof(*array), \
-			.compare = compare, \
-			.data    = data, \
-			.thres   = STROLL_MSORT_INSERT_THRESHOLD * \
-			           sizeof(*array) \
+		const struct stroll_array_quick parms = { \
+			.compare  = compare, \
+			.data     = data, \
+			.thres    = STROLL_PDQSORT_INSERT_THRESHOLD \
 		}; \
 		\
-		aux = malloc(mnr * sizeof(*array)); \
-		if (!aux) \
-			return -errno; \
-		\
-		_topdwn_func(&parms, aux, mid, &mid[mnr]); \
-		_topdwn_func(&parms, &array[mnr], array, mid); \
-		\
-		_merge_func(&parms, \
-		            array, \
-		            &array[mnr], &mid[mnr], \
-		            aux, &aux[mnr]); \
-		\
-		free(aux); \
-		\
-		return 0; \
+		_recsort_func(&parms, \
+		              array, \
+		              &array[nr], \
+		              stroll_bops_fls(nr) - 1, \
+		              true); \
 	}
 
-#if defined(CONFIG_STROLL_ARRAY_MERGE_SORT_FULL_RUNS)
+STROLL_ARRAY_DEFINE_PDQUICK_SORT3(stroll_array_pdquick_sort3_32,
+                                  stroll_array_swap32,
+                                  uint32_t)
+STROLL_ARRAY_DEFINE_PDQUICK_PART_LEFT(stroll_array_pdquick_part_left32,
+                                      stroll_array_swap32,
+                                      uint32_t)
+STROLL_ARRAY_DEFINE_PDQUICK_PART_RIGHT(stroll_array_pdquick_part_right32,
+                                       stroll_array_swap32,
+                                       uint32_t)
+STROLL_ARRAY_DEFINE_PDQUICK_PARTIAL_INSERT(stroll_array_pdquick_insert32,
+                                           uint32_t)
+STROLL_ARRAY_DEFINE_PDQUICK_BREAK(stroll_array_pdquick_break32,
+                                  stroll_array_swap32,
+                                  uint32_t)
+STROLL_ARRAY_DEFINE_PDQUICK_RECSORT(stroll_array_pdquick_sort_rec32,
+                                    stroll_array_pdquick_sort3_32,
+                                    stroll_array_pdquick_part_left32,
+                                    stroll_array_pdquick_part_right32,
+                                    stroll_array_pdquick_insert32,
+                                    stroll_array_pdquick_break32,
+                                    stroll_array_insert_sort32,
+                                    stroll_array_swap32,
+                                    uint32_t)
+STROLL_ARRAY_DEFINE_PDQUICK_SORT(stroll_array_pdquick_sort32,
+                                 stroll_array_pdquick_sort_rec32,
+                                 uint32_t)
+
+STROLL_ARRAY_DEFINE_PDQUICK_SORT3(stroll_array_pdquick_sort3_64,
+                                  stroll_array_swap64,
+                                  uint64_t)
+STROLL_ARRAY_DEFINE_PDQUICK_PART_LEFT(stroll_array_pdquick_part_left64,
+                                      stroll_array_swap64,
+                                      uint64_t)
+STROLL_ARRAY_DEFINE_PDQUICK_PART_RIGHT(stroll_array_pdquick_part_right64,
+                                       stroll_array_swap64,
+                                       uint64_t)
+STROLL_ARRAY_DEFINE_PDQUICK_PARTIAL_INSERT(stroll_array_pdquick_insert64,
+                                           uint64_t)
+STROLL_ARRAY_DEFINE_PDQUICK_BREAK(stroll_array_pdquick_break64,
+                                  stroll_array_swap64,
+                                  uint64_t)
+STROLL_ARRAY_DEFINE_PDQUICK_RECSORT(stroll_array_pdquick_sort_rec64,
+                                    stroll_array_pdquick_sort3_64,
+                                    stroll_array_pdquick_part_left64,
+                                    stroll_array_pdquick_part_right64,
+                                    stroll_array_pdquick_insert64,
+                                    stroll_array_pdquick_break64,
+                                    stroll_array_insert_sort64,
+                                    stroll_array_swap64,
+                                    uint64_t)
+STROLL_ARRAY_DEFINE_PDQUICK_SORT(stroll_array_pdquick_sort64,
+                                 stroll_array_pdquick_sort_rec64,
+                                 uint64_t)
 
-static inline __stroll_nonull(1, 2, 3, 4, 5, 6)
-bool
-stroll_array_merge_full_runs(
-	const struct stroll_array_merge * __restrict parms,
-	char * __restrict                            result,
-	const char * __restrict                      part0,
-	const char * __restrict                      end0,
-	const char * __restrict                      part1,
-	const char * __restrict                      end1)
+/*
+ * Sort the 3 given elements relative to each other so that first <= second <=
+ * third.
+ */
+static __stroll_nonull(1, 2, 3, 4)
+void
+stroll_array_pdquick_sort3_mem(
+	const struct stroll_array_quick * __restrict parms,
+	char *                                       first,
+	char *                                       second,
+	char *                                       third)
 {
 	size_t sz = parms->size;
 
-	if (parms->compare(end0 - sz, part1, parms->data) <= 0) {
-		sz = (size_t)(end0 - part0);
-		memcpy(result, part0, sz);
-		memcpy(&result[sz], part1, (size_t)(end1 - part1));
-		return true;
-	}
-	else if (parms->compare(end1 - sz, part0, parms->data) <= 0) {
-		sz = (size_t)(end1 - part1);
-		memcpy(result, part1, sz);
-		memcpy(&result[sz], part0, (size_t)(end0 - part0));
-		return true;
+	if (parms->compare(second, first, parms->data) < 0)
+		stroll_array_swap(first, second, sz);
+
+	if (parms->compare(third, second, parms->data) < 0) {
+		stroll_array_swap(second, third, sz);
+
+		if (parms->compare(second, first, parms->data) < 0)
+			stroll_array_swap(first, second, sz);
 	}
-	else
-		return false;
 }
 
-#else  /* !defined(CONFIG_STROLL_ARRAY_MERGE_SORT_FULL_RUNS) */
-
-static inline __stroll_nonull(1, 2, 3, 4, 5, 6)
-bool
-stroll_array_merge_full_runs(
-	const struct stroll_array_merge * __restrict parms __unused,
-	char * __restrict                            result __unused,
-	const char * __restrict                      part0 __unused,
-	const char * __restrict                      end0 __unused,
-	const char * __restrict                      part1 __unused,
-	const char * __restrict                      end1 __unused)
+/*
+ * Partition [begin:end[ around the pivot located at `begin' so that elements
+ * equal to the pivot are moved into the left partition.
+ *
+ * This is used when the pivot is found equal to the element preceding the
+ * current partition, i.e. the pivot of a previous partitioning pass: no element
+ * of [begin:end[ may be smaller than pivot, meaning that all elements equal to
+ * pivot are gathered to the left side and may be skipped at once.
+ * This gives pattern-defeating quicksort O(n.k) complexity for inputs holding
+ * k distinct keys.
+ *
+ * Return pointer to the final pivot location.
+ */
+static __stroll_nonull(1, 2, 3)
+char *
+stroll_array_pdquick_part_left_mem(
+	const struct stroll_array_quick * __restrict parms,
+	char *                                       begin,
+	char *                                       end)
 {
-	return false;
-}
+	size_t sz = parms->size;
+	char   pivot[sz];
+	char * first = begin;
+	char * last = end;
 
-#endif /* defined(CONFIG_STROLL_ARRAY_MERGE_SORT_FULL_RUNS) */
+	memcpy(pivot, begin, sz);
 
-STROLL_ARRAY_MERGE_PART_RUNS(stroll_array_merge_part_runs32, uint32_t)
-STROLL_ARRAY_MERGE_PARTS(stroll_array_merge_parts32,
-                         stroll_array_merge_part_runs32,
-                         uint32_t)
-STROLL_ARRAY_INSERT_OOPSORT(stroll_array_insert_oopsort32,
-                            stroll_array_insert_oopsort_elem32,
-                            uint32_t)
-STROLL_ARRAY_MERGE_TOPDWN(stroll_array_merge_topdwn32,
-                          stroll_array_insert_oopsort32,
-                          stroll_array_merge_parts32,
-                          uint32_t)
-STROLL_ARRAY_MERGE_SORT(stroll_array_merge_sort32,
-                        stroll_array_merge_topdwn32,
-                        stroll_array_merge_parts32,
-                        uint32_t)
+	do {
+		last -= sz;
+	} while (parms->compare(pivot, last, parms->data) < 0);
 
-STROLL_ARRAY_MERGE_PART_RUNS(stroll_array_merge_part_runs64, uint64_t)
-STROLL_ARRAY_MERGE_PARTS(stroll_array_merge_parts64,
-                         stroll_array_merge_part_runs64,
-                         uint64_t)
-STROLL_ARRAY_INSERT_OOPSORT(stroll_array_insert_oopsort64,
-                            stroll_array_insert_oopsort_elem64,
-                            uint64_t)
-STROLL_ARRAY_MERGE_TOPDWN(stroll_array_merge_topdwn64,
-                          stroll_array_insert_oopsort64,
-                          stroll_array_merge_parts64,
-                          uint64_t)
-STROLL_ARRAY_MERGE_SORT(stroll_array_merge_sort64,
-                        stroll_array_merge_topdwn64,
-                        stroll_array_merge_parts64,
-                        uint64_t)
+	if (&last[sz] == end) {
+		while (first < last) {
+			first += sz;
+			if (parms->compare(pivot, first, parms->data) < 0)
+				break;
+		}
+	}
+	else {
+		do {
+			first += sz;
+		} while (parms->compare(pivot, first, parms->data) >= 0);
+	}
 
-#if defined(CONFIG_STROLL_ARRAY_MERGE_SORT_RUNS_BYBLOCK)
+	while (first < last) {
+		stroll_array_swap(first, last, sz);
 
-static inline __stroll_nonull(1, 2, 3, 4, 5, 6)
+		do {
+			last -= sz;
+		} while (parms->compare(pivot, last, parms->data) < 0);
+
+		do {
+			first += sz;
+		} while (parms->compare(pivot, first, parms->data) >= 0);
+	}
+
+	memcpy(begin, last, sz);
+	memcpy(last, pivot, sz);
+
+	return last;
+}
+
+/*
+ * Partition [begin:end[ around the pivot located at `begin' so that elements
+ * equal to the pivot are moved into the right partition.
+ *
+ * Elements are partitioned according to the BlockQuicksort scheme described
+ * into "BlockQuicksort: How Branch Mispredictions don't affect Quicksort",
+ * Stefan Edelkamp and Armin Weiss, 2016.
+ *
+ * Instead of swapping elements as soon as a misplaced pair is found (as Hoare's
+ * scheme does), each side scans a block of up to STROLL_PDQSORT_BLOCK_SIZE
+ * elements and records the offsets of misplaced elements into a small buffer.
+ * The recording step increments the buffer index by the result of the
+ * comparison without branching, decoupling comparison outcome from control
+ * flow. Recorded elements are then swapped pairwise.
+ * This removes the branch mispredictions that dominate Hoare's partitioning
+ * when sorting random inputs.
+ *
+ * Upon return, `parted' is set to true when no element had to be moved, i.e.
+ * when [begin:end[ was already partitioned. Caller may use this hint to detect
+ * (nearly) sorted inputs.
+ *
+ * Return pointer to the final pivot location.
+ */
+static __stroll_nonull(1, 2, 3, 4)
+char *
+stroll_array_pdquick_part_right_mem(
+	const struct stroll_array_quick * __restrict parms,
+	char *                                       begin,
+	char *                                       end,
+	bool * __restrict                            parted)
+{
+	size_t sz = parms->size;
+	char   pivot[sz];
+	char * first = begin;
+	char * last = end;
+
+	memcpy(pivot, begin, sz);
+
+	/*
+	 * Find the first element greater than or equal to pivot. Median-of-3
+	 * selection guarantees such an element exists.
+	 */
+	do {
+		first += sz;
+	} while (parms->compare(first, pivot, parms->data) < 0);
+
+	/*
+	 * Find the last element strictly smaller than pivot. Search must be
+	 * bounded when no element preceding `first' is smaller than pivot.
+	 */
+	if ((first - sz) == begin) {
+		while (first < last) {
+			last -= sz;
+			if (parms->compare(last, pivot, parms->data) < 0)
+				break;
+		}
+	}
+	else {
+		do {
+			last -= sz;
+		} while (parms->compare(last, pivot, parms->data) >= 0);
+	}
+
+	*parted = (first >= last);
+	if (!*parted) {
+		uint8_t      offs_l[STROLL_PDQSORT_BLOCK_SIZE];
+		uint8_t      offs_r[STROLL_PDQSORT_BLOCK_SIZE];
+		char *       base_l;
+		char *       base_r;
+		unsigned int nr_l = 0;
+		unsigned int nr_r = 0;
+		unsigned int start_l = 0;
+		unsigned int start_r = 0;
+
+		stroll_array_swap(first, last, sz);
+		first += sz;
+
+		base_l = first;
+		base_r = last;
+		while (first < last) {
+			size_t       unknown = (size_t)(last - first) / sz;
+			size_t       split_l;
+			size_t       split_r;
+			unsigned int o;
+			unsigned int n;
+
+			stroll_array_pdquick_split(unknown,
+			                           nr_l,
+			                           nr_r,
+			                           &split_l,
+			                           &split_r);
+
+			/*
+			 * Record offsets of elements that belong to the other
+			 * side: buffer index is incremented according to the
+			 * comparison result without any conditional branch.
+			 */
+			for (o = 0; o < split_l; o++) {
+				offs_l[nr_l] = (uint8_t)o;
+				nr_l += (parms->compare(first,
+				                        pivot,
+				                        parms->data) >= 0);
+				first += sz;
+			}
+
+			for (o = 0; o < split_r; ) {
+				offs_r[nr_r] = (uint8_t)++o;
+				last -= sz;
+				nr_r += (parms->compare(last,
+				                        pivot,
+				                        parms->data) < 0);
+			}
+
+			/* Swap misplaced pairs. */
+			n = stroll_min(nr_l, nr_r);
+			for (o = 0; o < n; o++)
+				stroll_array_swap(
+					&base_l[offs_l[start_l + o] * sz],
+					base_r - (offs_r[start_r + o] * sz),
+					sz);
+
+			nr_l -= n;
+			nr_r -= n;
+			start_l += n;
+			start_r += n;
+			if (!nr_l) {
+				start_l = 0;
+				base_l = first;
+			}
+			if (!nr_r) {
+				start_r = 0;
+				base_r = last;
+			}
+		}
+
+		/*
+		 * All elements have been scanned: move remaining misplaced
+		 * elements of the single non empty buffer to the partition
+		 * boundary.
+		 */
+		if (nr_l) {
+			while (nr_l--) {
+				last -= sz;
+				stroll_array_swap(
+					&base_l[offs_l[start_l + nr_l] * sz],
+					last,
+					sz);
+			}
+			first = last;
+		}
+		if (nr_r) {
+			while (nr_r--) {
+				stroll_array_swap(
+					base_r - (offs_r[start_r + nr_r] * sz),
+					first,
+					sz);
+				first += sz;
+			}
+			last = first;
+		}
+	}
+
+	/* Move pivot to its final location. */
+	first -= sz;
+	memcpy(begin, first, sz);
+	memcpy(first, pivot, sz);
+
+	return first;
+}
+
+/*
+ * Run insertion sort over [begin:end[ unless more than
+ * STROLL_PDQSORT_PARTIAL_INSERT_LIMIT element moves are required.
+ *
+ * Return true when [begin:end[ has been fully sorted, false otherwise, in which
+ * case [begin:end[ is left partially sorted.
+ */
+static __stroll_nonull(1, 2, 3)
+bool
+stroll_array_pdquick_insert_mem(
+	const struct stroll_array_quick * __restrict parms,
+	char *                                       begin,
+	char *                                       end)
+{
+	size_t       sz = parms->size;
+	char         tmp[sz];
+	unsigned int moved = 0;
+	char *       curr;
+
+	for (curr = &begin[sz]; curr < end; curr += sz) {
+		char * sift = curr;
+		char * prev = curr - sz;
+
+		if (parms->compare(sift, prev, parms->data) < 0) {
+			memcpy(tmp, sift, sz);
+
+			do {
+				memcpy(sift, prev, sz);
+				sift -= sz;
+				if (sift == begin)
+					break;
+				prev -= sz;
+			} while (parms->compare(tmp, prev, parms->data) < 0);
+
+			memcpy(sift, tmp, sz);
+			moved += (unsigned int)((size_t)(curr - sift) / sz);
+		}
+
+		if (moved > STROLL_PDQSORT_PARTIAL_INSERT_LIMIT)
+			return false;
+	}
+
+	return true;
+}
+
+/*
+ * Break patterns of an unbalanced [begin:end[ partition by swapping a few
+ * elements at fixed positions.
+ */
+static __stroll_nonull(1, 2)
 void
-stroll_array_merge_part_runs_mem(
-	const struct stroll_array_merge * __restrict parms,
-	char * __restrict                            result,
-	const char * __restrict                      part0,
-	const char * __restrict                      end0,
-	const char * __restrict                      part1,
-	const char * __restrict                      end1)
+stroll_array_pdquick_break_mem(char * begin, char * end, size_t sz)
+{
+	size_t nr = (size_t)(end - begin) / sz;
+	size_t q = (nr / 4) * sz;
+
+	stroll_array_swap(begin, &begin[q], sz);
+	stroll_array_swap(end - sz, end - q, sz);
+	if (nr > STROLL_PDQSORT_NINTHER_THRESHOLD) {
+		stroll_array_swap(&begin[sz], &begin[q + sz], sz);
+		stroll_array_swap(&begin[2 * sz], &begin[q + (2 * sz)], sz);
+		stroll_array_swap(end - (2 * sz), end - (q + sz), sz);
+		stroll_array_swap(end - (3 * sz), end - (q + (2 * sz)), sz);
+	}
+}
+
+/*
+ * Pattern-defeating quicksort main loop as described into
+ * "Pattern-defeating Quicksort", Orson R. L. Peters, 2021.
+ *
+ * It is an introsort variant that includes the following enhancements:
+ * - pivot selected according to median-of-three for small partitions and
+ *   Tukey's ninther for larger ones ;
+ * - branchless block partitioning (see stroll_array_pdquick_part_right_mem()) ;
+ * - partitions holding many elements equal to a previous pivot are processed
+ *   in linear time (see stroll_array_pdquick_part_left_mem()) ;
+ * - when a partitioning pass moves no elements, the partition is likely
+ *   sorted: a partial insertion sort pass is attempted to finish it in linear
+ *   time ;
+ * - highly unbalanced partitions are considered "bad": elements are shuffled
+ *   to break patterns that may defeat pivot selection. Once log2(n) bad
+ *   partitions have been encountered, sorting falls back to heapsort, bounding
+ *   worst case complexity to O(n.log(n)).
+ *
+ * `leftmost' is false when an element smaller than or equal to all elements of
+ * [begin:end[ precedes `begin', i.e. a previous pivot.
+ * As for other quicksort implementations, always recurse into the smaller
+ * partition first to limit auxiliary stack space to O(log(n)).
+ */
+static __stroll_nonull(1, 2, 3)
+void
+stroll_array_pdquick_sort_recmem(
+	const struct stroll_array_quick * __restrict parms,
+	char *                                       begin,
+	char *                                       end,
+	unsigned int                                 bad,
+	bool                                         leftmost)
 {
+	stroll_array_quick_assert(parms);
+	stroll_array_assert_intern(parms->size);
+	stroll_array_assert_intern(begin);
+	stroll_array_assert_intern(end >= begin);
+	stroll_array_assert_intern(!((size_t)(end - begin) % parms->size));
+
 	size_t sz = parms->size;
 
 	while (true) {
-		const char * run = part0;
-		size_t       rsz;
+		size_t nr = (size_t)(end - begin) / sz;
+		char * mid = &begin[(nr / 2) * sz];
+		char * pivot;
+		size_t nr_l;
+		size_t nr_r;
+		bool   parted;
+
+		if (nr < parms->thres) {
+			if (nr > 1)
+				stroll_array_insert_sort_mem(begin,
+				                             (unsigned int)nr,
+				                             sz,
+				                             parms->compare,
+				                             parms->data);
+			return;
+		}
 
-		do {
-			if (parms->compare(part0, part1, parms->data) > 0)
-				break;
-			part0 += sz;
-		} while (part0 < end0);
+		/* Select pivot and move it to the first partition slot. */
+		if (nr > STROLL_PDQSORT_NINTHER_THRESHOLD) {
+			stroll_array_pdquick_sort3_mem(parms,
+			                               begin,
+			                               mid,
+			                               end - sz);
+			stroll_array_pdquick_sort3_mem(parms,
+			                               &begin[sz],
+			                               mid - sz,
+			                               end - (2 * sz));
+			stroll_array_pdquick_sort3_mem(parms,
+			                               &begin[2 * sz],
+			                               &mid[sz],
+			                               end - (3 * sz));
+			stroll_array_pdquick_sort3_mem(parms,
+			                               mid - sz,
+			                               mid,
+			                               &mid[sz]);
+			stroll_array_swap(begin, mid, sz);
+		}
+		else
+			stroll_array_pdquick_sort3_mem(parms,
+			                               mid,
+			                               begin,
+			                               end - sz);
 
-		rsz = (size_t)(part0 - run);
-		memcpy(result, run, rsz);
-		result += rsz;
+		/*
+		 * Pivot equals previous partitioning pivot: all elements equal
+		 * to pivot may be gathered to the left and skipped at once.
+		 */
+		if (!leftmost &&
+		    (parms->compare(begin - sz, begin, parms->data) >= 0)) {
+			begin = stroll_array_pdquick_part_left_mem(parms,
+			                                           begin,
+			                                           end) + sz;
+			continue;
+		}
 
-		if (part0 == end0) {
-			stroll_array_assert_intern(part0 <= end0);
-			stroll_array_assert_intern(part1 <= end1);
-			memcpy(result, part1, (size_t)(end1 - part1));
+		pivot = stroll_array_pdquick_part_right_mem(parms,
+		                                            begin,
+		                                            end,
+		                                            &parted);
+		nr_l = (size_t)(pivot - begin) / sz;
+		nr_r = (size_t)(end - (pivot + sz)) / sz;
+
+		if ((nr_l < (nr / 8)) || (nr_r < (nr / 8))) {
+			/*
+			 * Highly unbalanced partitioning: once too many of
+			 * them have been encountered, switch to heapsort to
+			 * guarantee O(n.log(n)) worst case.
+			 */
+			if (!--bad) {
+				stroll_array_fbheap_sort(begin,
+				                         (unsigned int)nr,
+				                         sz,
+				                         parms->compare,
+				                         parms->data);
+				return;
+			}
+
+			/*
+			 * Otherwise, break patterns by swapping a few elements
+			 * at fixed positions so that next pivot selection will
+			 * likely give better results.
+			 */
+			if (nr_l >= parms->thres)
+				stroll_array_pdquick_break_mem(begin,
+				                               pivot,
+				                               sz);
+			if (nr_r >= parms->thres)
+				stroll_array_pdquick_break_mem(&pivot[sz],
+				                               end,
+				                               sz);
+		}
+		else if (parted &&
+		         stroll_array_pdquick_insert_mem(parms, begin, pivot) &&
+		         stroll_array_pdquick_insert_mem(parms,
+		                                         &pivot[sz],
+		                                         end))
+			/*
+			 * Partitioning moved no elements and both partitions
+			 * could be sorted with few element moves: input was
+			 * (nearly) sorted.
+			 */
 			return;
+
+		if (nr_l < nr_r) {
+			stroll_array_pdquick_sort_recmem(parms,
+			                                 begin,
+			                                 pivot,
+			                                 bad,
+			                                 leftmost);
+			begin = &pivot[sz];
+			leftmost = false;
+		}
+		else {
+			stroll_array_pdquick_sort_recmem(parms,
+			                                 &pivot[sz],
+			                                 end,
+			                                 bad,
+			                                 false);
+			end = pivot;
 		}
+	}
+}
+
+static __stroll_nonull(1, 4)
+void
+stroll_array_pdquick_sort_mem(char * __restrict     array,
+                              unsigned int          nr,
+                              size_t                size,
+                              stroll_array_cmp_fn * compare,
+                              void *                data)
+{
+	stroll_array_assert_intern(array);
+	stroll_array_assert_intern(nr > 1);
+	stroll_array_assert_intern(size);
+	stroll_array_assert_intern(compare);
+
+	const struct stroll_array_quick parms = {
+		.size     = size,
+		.compare  = compare,
+		.data     = data,
+		.thres    = STROLL_PDQSORT_INSERT_THRESHOLD
+	};
+
+	stroll_array_pdquick_sort_recmem(&parms,
+	                                 array,
+	                                 &array[nr * size],
+	                                 stroll_bops_fls(nr) - 1,
+	                                 true);
+}
+
+void
+stroll_array_pdquick_sort(void * __restrict     array,
+                          unsigned int          nr,
+                          size_t                size,
+                          stroll_array_cmp_fn * compare,
+                          void *                data)
+{
+	stroll_array_assert_api(array);
+	stroll_array_assert_api(nr);
+	stroll_array_assert_api(size);
+	stroll_array_assert_api(compare);
+
+	if (nr == 1)
+		return;
+
+	if (stroll_array_aligned(array, size, sizeof(uint32_t)))
+		stroll_array_pdquick_sort32(array, nr, compare, data);
+	else if (stroll_array_aligned(array, size, sizeof(uint64_t)))
+		stroll_array_pdquick_sort64(array, nr, compare, data);
+	else
+		stroll_array_pdquick_sort_mem(array, nr, size, compare, data);
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_PDQUICK_SORT) */
+
+#if defined(CONFIG_STROLL_ARRAY_MERGE_SORT)
+
+#if CONFIG_STROLL_ARRAY_MERGE_SORT_INSERT_THRESHOLD < 2
+#error Invalid Mergesort insertion threshold !
+#endif /* CONFIG_STROLL_ARRAY_MERGE_SORT_INSERT_THRESHOLD < 2 */
+
+#define STROLL_MSORT_INSERT_THRESHOLD \
+	STROLL_CONCAT(CONFIG_STROLL_ARRAY_MERGE_SORT_INSERT_THRESHOLD, U)
+
+struct stroll_array_merge {
+	size_t                size;
+	stroll_array_cmp_fn * compare;
+	void *                data;
+	size_t                thres;
+};
+
+#define stroll_array_merge_assert(_parms) \
+	stroll_array_assert_intern(_parms); \
+	stroll_array_assert_intern((_parms)->compare); \
+	stroll_array_assert_intern((_parms)->thres)
+
+#define STROLL_ARRAY_MERGE_PART_RUNS(_func, _type) \
+	static inline __stroll_nonull(1, 2, 3, 4, 5, 6) \
+	void \
+	_func(const struct stroll_array_merge * __restrict parms, \
+	      _type * __restrict                           result, \
+	      const _type * __restrict                     part0, \
+	      const _type * __restrict                     end0, \
+	      const _type * __restrict                     part1, \
+	      const _type * __restrict                     end1) \
+	{ \
+		do { \
+			if (parms->compare(part0, part1, parms->data) <= 0) { \
+				*result = *part0; \
+				part0++; \
+			} \
+			else { \
+				*result = *part1; \
+				part1++; \
+			} \
+			\
+			result++; \
+		} while ((part0 < end0) && (part1 < end1)); \
+		\
+		if (part0 != end0) { \
+			stroll_array_assert_intern(part0 < end0); \
+			stroll_array_assert_intern(part1 >= end1); \
+			\
+			memcpy(result, \
+			       part0, \
+			       (size_t)(end0 - part0) * parms->size); \
+		} \
+		else if (part1 != end1) { \
+			stroll_array_assert_intern(part1 < end1); \
+			stroll_array_assert_intern(part0 >= end0); \
+			\
+			memcpy(result, \
+			       part1, \
+			       (size_t)(end1 - part1) * parms->size); \
+		} \
+	}
+
+#define STROLL_ARRAY_MERGE_PARTS(_func, _runs_func, _type) \
+	static __stroll_nonull(1, 2, 3, 4, 5, 6) \
+	void \
+	_func(const struct stroll_array_merge * __restrict parms, \
+	      _type * __restrict                           result, \
+	      const _type * __restrict                     part0, \
+	      const _type * __restrict                     end0, \
+	      const _type * __restrict                     part1, \
+	      const _type * __restrict                     end1) \
+	{ \
+		stroll_array_merge_assert(parms); \
+		stroll_array_assert_intern(parms->size); \
+		stroll_array_assert_intern(part0); \
+		stroll_array_assert_intern(end0 > part0); \
+		stroll_array_assert_intern(part1); \
+		stroll_array_assert_intern(end1 > part1); \
+		\
+		if (stroll_array_merge_full_runs(parms, \
+		                                 (char *)result, \
+		                                 (const char *)part0, \
+		                                 (const char *)end0, \
+		                                 (const char *)part1, \
+		                                 (const char *)end1)) \
+			return; \
+		\
+		_runs_func(parms, result, part0, end0, part1, end1); \
+	}
+
+#define STROLL_ARRAY_INSERT_OOPSORT(_func, _insert_oopsort_elem, _type) \
+	static __stroll_nonull(1, 2, 3, 4) \
+	void \
+	_func(const struct stroll_array_merge * __restrict parms, \
+	      _type * __restrict                           result, \
+	      const _type * __restrict                     array, \
+	      const _type * __restrict                     end) \
+	{ \
+		_type * res; \
+		\
+		*result = *array; \
+		\
+		for (res = result + 1, array++; array != end; res++, array++) \
+			_insert_oopsort_elem(result, \
+			                     res, \
+			                     array, \
+			                     parms->compare, \
+			                     parms->data); \
+	}
+
+#define STROLL_ARRAY_MERGE_TOPDWN(_func, _insert_oopsort, _merge_func, _type) \
+	static __stroll_nonull(1, 2, 3, 4) \
+	void \
+	_func(const struct stroll_array_merge * __restrict parms, \
+	      _type * __restrict                           result, \
+	      _type * __restrict                           array, \
+	      const _type * __restrict                     end) \
+	{ \
+		stroll_array_merge_assert(parms); \
+		stroll_array_assert_intern(result); \
+		stroll_array_assert_intern(end > array); \
+		\
+		unsigned int nr = (unsigned int)(end - array); \
+		unsigned int nr0; \
+		\
+		if ((nr * sizeof(*array)) <= parms->thres) { \
+			stroll_array_assert_intern(nr >= 1); \
+			_insert_oopsort(parms, result, array, end); \
+			return; \
+		} \
+		\
+		nr0 = nr / 2; \
+		\
+		_func(parms, &result[nr0], &array[nr0], end); \
+		_func(parms, &array[nr - nr0], array, &array[nr0]); \
+		_merge_func(parms, \
+		            result, \
+		            &array[nr - nr0], \
+		            end, \
+		            &result[nr0], \
+		            &result[nr]); \
+	}
+
+#define STROLL_ARRAY_MERGE_SORT(_func, _topdwn_func, _merge_func, _type) \
+	static __stroll_nonull(1, 3, 5) \
+	void \
+	_func(_type * __restrict    array, \
+	      unsigned int          nr, \
+	      stroll_array_cmp_fn * compare, \
+	      void *                data, \
+	      _type * __restrict    aux) \
+	{ \
+		stroll_array_assert_intern(array); \
+		stroll_array_assert_intern(nr > 1); \
+		stroll_array_assert_intern(compare); \
+		stroll_array_assert_intern(aux); \
+		\
+		unsigned int                    anr = nr / 2; \
+		_type *                         mid = &array[anr]; \
+		unsigned int                    mnr = nr - anr; \
+		const struct stroll_array_merge parms = { \
+			.size    = sizeof(*array), \
+			.compare = compare, \
+			.data    = data, \
+			.thres   = STROLL_MSORT_INSERT_THRESHOLD * \
+			           sizeof(*array) \
+		}; \
+		\
+		_topdwn_func(&parms, aux, mid, &mid[mnr]); \
+		_topdwn_func(&parms, &array[mnr], array, mid); \
+		\
+		_merge_func(&parms, \
+		            array, \
+		            &array[mnr], &mid[mnr], \
+		            aux, &aux[mnr]); \
+	}
+
+#if defined(CONFIG_STROLL_ARRAY_MERGE_SORT_FULL_RUNS)
+
+static inline __stroll_nonull(1, 2, 3, 4, 5, 6)
+bool
+stroll_array_merge_full_runs(
+	const struct stroll_array_merge * __restrict parms,
+	char * __restrict                            result,
+	const char * __restrict                      part0,
+	const char * __restrict                      end0,
+	const char * __restrict                      part1,
+	const char * __restrict                      end1)
+{
+	size_t sz = parms->size;
+
+	if (parms->compare(end0 - sz, part1, parms->data) <= 0) {
+		sz = (size_t)(end0 - part0);
+		memcpy(result, part0, sz);
+		memcpy(&result[sz], part1, (size_t)(end1 - part1));
+		return true;
+	}
+	else if (parms->compare(end1 - sz, part0, parms->data) < 0) {
+		/*
+		 * Strict comparison: when last element of part1 equals first
+		 * element of part0, moving part1 in front of part0 would break
+		 * sorting stability.
+		 */
+		sz = (size_t)(end1 - part1);
+		memcpy(result, part1, sz);
+		memcpy(&result[sz], part0, (size_t)(end0 - part0));
+		return true;
+	}
+	else
+		return false;
+}
+
+#else  /* !defined(CONFIG_STROLL_ARRAY_MERGE_SORT_FULL_RUNS) */
+
+static inline __stroll_nonull(1, 2, 3, 4, 5, 6)
+bool
+stroll_array_merge_full_runs(
+	const struct stroll_array_merge * __restrict parms __unused,
+	char * __restrict                            result __unused,
+	const char * __restrict                      part0 __unused,
+	const char * __restrict                      end0 __unused,
+	const char * __restrict                      part1 __unused,
+	const char * __restrict                      end1 __unused)
+{
+	return false;
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_MERGE_SORT_FULL_RUNS) */
+
+STROLL_ARRAY_MERGE_PART_RUNS(stroll_array_merge_part_runs32, uint32_t)
+STROLL_ARRAY_MERGE_PARTS(stroll_array_merge_parts32,
+                         stroll_array_merge_part_runs32,
+                         uint32_t)
+STROLL_ARRAY_INSERT_OOPSORT(stroll_array_insert_oopsort32,
+                            stroll_array_insert_oopsort_elem32,
+                            uint32_t)
+STROLL_ARRAY_MERGE_TOPDWN(stroll_array_merge_topdwn32,
+                          stroll_array_insert_oopsort32,
+                          stroll_array_merge_parts32,
+                          uint32_t)
+STROLL_ARRAY_MERGE_SORT(stroll_array_merge_sort32,
+                        stroll_array_merge_topdwn32,
+                        stroll_array_merge_parts32,
+                        uint32_t)
+
+STROLL_ARRAY_MERGE_PART_RUNS(stroll_array_merge_part_runs64, uint64_t)
+STROLL_ARRAY_MERGE_PARTS(stroll_array_merge_parts64,
+                         stroll_array_merge_part_runs64,
+                         uint64_t)
+STROLL_ARRAY_INSERT_OOPSORT(stroll_array_insert_oopsort64,
+                            stroll_array_insert_oopsort_elem64,
+                            uint64_t)
+STROLL_ARRAY_MERGE_TOPDWN(stroll_array_merge_topdwn64,
+                          stroll_array_insert_oopsort64,
+                          stroll_array_merge_parts64,
+                          uint64_t)
+STROLL_ARRAY_MERGE_SORT(stroll_array_merge_sort64,
+                        stroll_array_merge_topdwn64,
+                        stroll_array_merge_parts64,
+                        uint64_t)
+
+#if defined(CONFIG_STROLL_ARRAY_MERGE_SORT_RUNS_BYBLOCK)
+
+static inline __stroll_nonull(1, 2, 3, 4, 5, 6)
+void
+stroll_array_merge_part_runs_mem(
+	const struct stroll_array_merge * __restrict parms,
+	char * __restrict                            result,
+	const char * __restrict                      part0,
+	const char * __restrict                      end0,
+	const char * __restrict                      part1,
+	const char * __restrict                      end1)
+{
+	size_t sz = parms->size;
+
+	while (true) {
+		const char * run = part0;
+		size_t       rsz;
+
+		do {
+			if (parms->compare(part0, part1, parms->data) > 0)
+				break;
+			part0 += sz;
+		} while (part0 < end0);
+
+		rsz = (size_t)(part0 - run);
+		memcpy(result, run, rsz);
+		result += rsz;
+
+		if (part0 == end0) {
+			stroll_array_assert_intern(part0 <= end0);
+			stroll_array_assert_intern(part1 <= end1);
+			memcpy(result, part1, (size_t)(end1 - part1));
+			return;
+		}
+
+		run = part1;
+		do {
+			if (parms->compare(part0, part1, parms->data) <= 0)
+				break;
+			part1 += sz;
+		} while (part1 < end1);
+
+		rsz = (size_t)(part1 - run);
+		memcpy(result, run, rsz);
+		result += rsz;
+
+		if (part1 == end1) {
+			stroll_array_assert_intern(part0 <= end0);
+			stroll_array_assert_intern(part1 <= end1);
+			memcpy(result, part0, (size_t)(end0 - part0));
+			return;
+		}
+	}
+}
+
+#else  /* !defined(CONFIG_STROLL_ARRAY_MERGE_SORT_RUNS_BYBLOCK) */
+
+static inline __stroll_nonull(1, 2, 3, 4, 5, 6)
+void
+stroll_array_merge_part_runs_mem(
+	const struct stroll_array_merge * __restrict parms,
+	char * __restrict                            result,
+	const char * __restrict                      part0,
+	const char * __restrict                      end0,
+	const char * __restrict                      part1,
+	const char * __restrict                      end1)
+{
+	size_t sz = parms->size;
+
+	do {
+		if (parms->compare(part0, part1, parms->data) <= 0) {
+			memcpy(result, part0, sz);
+			part0 += sz;
+		}
+		else {
+			memcpy(result, part1, sz);
+			part1 += sz;
+		}
+
+		result += sz;
+	} while ((part0 < end0) && (part1 < end1));
+
+	if (part0 != end0) {
+		stroll_array_assert_intern(part0 < end0);
+		stroll_array_assert_intern(part1 >= end1);
+
+		memcpy(result, part0, (size_t)(end0 - part0));
+	}
+	else if (part1 != end1) {
+		stroll_array_assert_intern(part1 < end1);
+		stroll_array_assert_intern(part0 >= end0);
+
+		memcpy(result, part1, (size_t)(end1 - part1));
+	}
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_MERGE_SORT_RUNS_BYBLOCK) */
+
+static __stroll_nonull(1, 2, 3, 4, 5, 6)
+void
+stroll_array_merge_parts_mem(
+	const struct stroll_array_merge * __restrict parms,
+	char * __restrict                            result,
+	const char * __restrict                      part0,
+	const char * __restrict                      end0,
+	const char * __restrict                      part1,
+	const char * __restrict                      end1)
+{
+	stroll_array_merge_assert(parms);
+	stroll_array_assert_intern(parms->size);
+	stroll_array_assert_intern(part0);
+	stroll_array_assert_intern(end0 > part0);
+	stroll_array_assert_intern(!((size_t)(end0 - part0) % parms->size));
+	stroll_array_assert_intern(part1);
+	stroll_array_assert_intern(end1 > part1);
+	stroll_array_assert_intern(!((size_t)(end1 - part1) % parms->size));
+
+	if (stroll_array_merge_full_runs(parms,
+	                                 result,
+	                                 part0,
+	                                 end0,
+	                                 part1,
+	                                 end1))
+		return;
+
+	stroll_array_merge_part_runs_mem(parms,
+	                                 result,
+	                                 part0,
+	                                 end0,
+	                                 part1,
+	                                 end1);
+}
+
+static __stroll_nonull(1, 2, 3, 4)
+void
+stroll_array_insert_oopsort_mem(
+	const struct stroll_array_merge * __restrict parms,
+	char * __restrict                            result,
+	const char * __restrict                      array,
+	const char * __restrict                      end)
+{
+	char * res;
+
+	memcpy(result, array, parms->size);
+
+	for (res = result + parms->size, array += parms->size;
+	     array != end;
+	     res += parms->size, array += parms->size)
+		stroll_array_insert_oopsort_elem_mem(result,
+		                                     res,
+		                                     array,
+		                                     parms->size,
+		                                     parms->compare,
+		                                     parms->data);
+}
+
+static __stroll_nonull(1, 2, 3, 4)
+void
+stroll_array_merge_topdwn_sort(
+	const struct stroll_array_merge * __restrict parms,
+	char * __restrict                            result,
+	char * __restrict                            array,
+	const char * __restrict                      end)
+{
+	stroll_array_merge_assert(parms);
+	stroll_array_assert_intern(parms->size);
+	stroll_array_assert_intern(result);
+	stroll_array_assert_intern(end > array);
+	stroll_array_assert_intern(!((size_t)(end - array) % parms->size));
+
+	size_t sz = (size_t)(end - array);
+	size_t sz0;
+
+	if (sz <= parms->thres) {
+		stroll_array_assert_intern(sz >= parms->size);
+		stroll_array_insert_oopsort_mem(parms, result, array, end);
+		return;
+	}
+
+	sz0 = (sz / (2 * parms->size)) * parms->size;
+
+	stroll_array_merge_topdwn_sort(parms,
+	                               &result[sz0],
+	                               &array[sz0],
+	                               end);
+	stroll_array_merge_topdwn_sort(parms,
+	                               &array[sz - sz0],
+	                               array,
+	                               &array[sz0]);
+	stroll_array_merge_parts_mem(parms,
+	                             result,
+	                             &array[sz - sz0], end,
+	                             &result[sz0], &result[sz]);
+}
+
+static __stroll_nonull(1, 4, 6)
+void
+stroll_array_merge_sort_mem(char * __restrict     array,
+                            unsigned int          nr,
+                            size_t                size,
+                            stroll_array_cmp_fn * compare,
+                            void *                data,
+                            char * __restrict     aux)
+{
+	stroll_array_assert_intern(array);
+	stroll_array_assert_intern(nr > 1);
+	stroll_array_assert_intern(size);
+	stroll_array_assert_intern(compare);
+	stroll_array_assert_intern(aux);
+
+	size_t                          asz = (nr / 2) * size;
+	char *                          mid = &array[asz];
+	size_t                          msz = (nr * size) - asz;
+	const struct stroll_array_merge parms = {
+		.size    = size,
+		.compare = compare,
+		.data    = data,
+		.thres   = STROLL_MSORT_INSERT_THRESHOLD * size
+	};
+
+	stroll_array_merge_topdwn_sort(&parms, aux, mid, &mid[msz]);
+	stroll_array_merge_topdwn_sort(&parms, &array[msz], array, mid);
+
+	stroll_array_merge_parts_mem(&parms,
+	                             array,
+	                             &array[msz], &mid[msz],
+	                             aux, &aux[msz]);
+}
+
+size_t
+stroll_array_merge_sort_scratch_size(unsigned int nr, size_t size)
+{
+	stroll_array_assert_api(nr);
+	stroll_array_assert_api(size);
+
+	return (size_t)(nr - (nr / 2)) * size;
+}
+
+void
+stroll_array_merge_sort_with_scratch(void * __restrict     array,
+                                     unsigned int          nr,
+                                     size_t                size,
+                                     stroll_array_cmp_fn * compare,
+                                     void *                data,
+                                     void * __restrict     scratch)
+{
+	stroll_array_assert_api(array);
+	stroll_array_assert_api(nr);
+	stroll_array_assert_api(size);
+	stroll_array_assert_api(compare);
+	stroll_array_assert_api(scratch);
+
+	if (nr == 1)
+		return;
+
+	/*
+	 * Typed sorting requires both array and scratch buffer to be suitably
+	 * aligned.
+	 */
+	if (stroll_array_aligned(array, size, sizeof(uint32_t)) &&
+	    stroll_array_aligned(scratch, size, sizeof(uint32_t)))
+		stroll_array_merge_sort32(array, nr, compare, data, scratch);
+	else if (stroll_array_aligned(array, size, sizeof(uint64_t)) &&
+	         stroll_array_aligned(scratch, size, sizeof(uint64_t)))
+		stroll_array_merge_sort64(array, nr, compare, data, scratch);
+	else
+		stroll_array_merge_sort_mem(array,
+		                            nr,
+		                            size,
+		                            compare,
+		                            data,
+		                            scratch);
+}
+
+int
+stroll_array_merge_sort(void * __restrict     array,
+                        unsigned int          nr,
+                        size_t                size,
+                        stroll_array_cmp_fn * compare,
+                        void *                data)
+{
+	stroll_array_assert_api(array);
+	stroll_array_assert_api(nr);
+	stroll_array_assert_api(size);
+	stroll_array_assert_api(compare);
+
+	void * aux;
+
+	if (nr == 1)
+		return 0;
+
+	aux = malloc(stroll_array_merge_sort_scratch_size(nr, size));
+	if (!aux)
+		return -errno;
+
+	stroll_array_merge_sort_with_scratch(array,
+	                                     nr,
+	                                     size,
+	                                     compare,
+	                                     data,
+	                                     aux);
+
+	free(aux);
+
+	return 0;
+}
+
+
+#if defined(CONFIG_STROLL_ARRAY_MERGE_SORT_MT)
+
+/*
+ * Multi-threaded merge sort context.
+ *
+ * Array is split into as many chunks as there are team workers, which bounds
+ * are given by `bounds'. Once each worker has sorted its own chunk, sorted
+ * runs are pairwise merged over log2(workers) rounds, back and forth between
+ * array and auxiliary buffer.
+ * At each round, the output range of each thread is the same as the chunk it
+ * initially sorted. Input portions of runs to merge into this range are
+ * located thanks to co-ranking, so that all threads perform the same amount
+ * of work whatever the number of runs left to merge.
+ */
+struct stroll_array_merge_mt {
+	struct stroll_array_team  team;
+	struct stroll_array_merge parms;
+	void *                    array;
+	void *                    aux;
+	size_t                    word;
+	unsigned int *            bounds;
+};
+
+/*
+ * Return the number of elements of first run that precede the k-th element of
+ * the result of merging first and second runs.
+ *
+ * This is the merge path co-rank: a binary search over the diagonal k of the
+ * merge matrix. Elements of first run precede equal elements of second run to
+ * preserve stability.
+ */
+static __stroll_nonull(1, 2, 4) __warn_result
+unsigned int
+stroll_array_merge_mt_corank(
+	const struct stroll_array_merge * __restrict parms,
+	const char * __restrict                      first,
+	unsigned int                                 first_nr,
+	const char * __restrict                      second,
+	unsigned int                                 second_nr,
+	unsigned int                                 k)
+{
+	stroll_array_merge_assert(parms);
+	stroll_array_assert_intern(k <= (first_nr + second_nr));
+
+	unsigned int lo = (k > second_nr) ? k - second_nr : 0;
+	unsigned int hi = stroll_min(k, first_nr);
+
+	while (lo < hi) {
+		unsigned int mid = lo + ((hi - lo) / 2);
+
+		if (parms->compare(&first[mid * parms->size],
+		                   &second[(k - mid - 1) * parms->size],
+		                   parms->data) <= 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+#define STROLL_ARRAY_MERGE_MT_PART(_func, _merge_func, _type) \
+	static __stroll_nonull(1, 2, 3, 4, 5, 6) \
+	void \
+	_func(const struct stroll_array_merge * __restrict parms, \
+	      _type * __restrict                           result, \
+	      const _type * __restrict                     part0, \
+	      const _type * __restrict                     end0, \
+	      const _type * __restrict                     part1, \
+	      const _type * __restrict                     end1) \
+	{ \
+		if (part0 == end0) \
+			memcpy(result, \
+			       part1, \
+			       (size_t)(end1 - part1) * sizeof(*part1)); \
+		else if (part1 == end1) \
+			memcpy(result, \
+			       part0, \
+			       (size_t)(end0 - part0) * sizeof(*part0)); \
+		else \
+			_merge_func(parms, result, part0, end0, part1, end1); \
+	}
+
+STROLL_ARRAY_MERGE_MT_PART(stroll_array_merge_mt_part32,
+                           stroll_array_merge_parts32,
+                           uint32_t)
+STROLL_ARRAY_MERGE_MT_PART(stroll_array_merge_mt_part64,
+                           stroll_array_merge_parts64,
+                           uint64_t)
+
+static __stroll_nonull(1, 2, 3, 4, 5, 6)
+void
+stroll_array_merge_mt_part_mem(
+	const struct stroll_array_merge * __restrict parms,
+	char * __restrict                            result,
+	const char * __restrict                      part0,
+	const char * __restrict                      end0,
+	const char * __restrict                      part1,
+	const char * __restrict                      end1)
+{
+	if (part0 == end0)
+		memcpy(result, part1, (size_t)(end1 - part1));
+	else if (part1 == end1)
+		memcpy(result, part0, (size_t)(end0 - part0));
+	else
+		stroll_array_merge_parts_mem(parms,
+		                             result,
+		                             part0,
+		                             end0,
+		                             part1,
+		                             end1);
+}
+
+/*
+ * Merge the portion of runs [start0, start1[ and [start1, end[ of `src' that
+ * lands into the [lo, hi[ range of `dst'.
+ */
+static __stroll_nonull(1, 2, 3)
+void
+stroll_array_merge_mt_slice(
+	const struct stroll_array_merge_mt * __restrict ctx,
+	void * __restrict                               dst,
+	const void * __restrict                         src,
+	unsigned int                                    start0,
+	unsigned int                                    start1,
+	unsigned int                                    end,
+	unsigned int                                    lo,
+	unsigned int                                    hi)
+{
+	stroll_array_assert_intern(ctx);
+	stroll_array_assert_intern(start0 <= lo);
+	stroll_array_assert_intern(lo < hi);
+	stroll_array_assert_intern(hi <= end);
+
+	const struct stroll_array_merge * parms = &ctx->parms;
+	const char *                      run0 = src;
+	const char *                      run1 = src;
+	unsigned int                      nr0 = start1 - start0;
+	unsigned int                      nr1 = end - start1;
+	unsigned int                      i0;
+	unsigned int                      i1;
+	unsigned int                      j0;
+	unsigned int                      j1;
+
+	run0 = &run0[start0 * parms->size];
+	run1 = &run1[start1 * parms->size];
+	i0 = stroll_array_merge_mt_corank(parms,
+	                                  run0,
+	                                  nr0,
+	                                  run1,
+	                                  nr1,
+	                                  lo - start0);
+	i1 = stroll_array_merge_mt_corank(parms,
+	                                  run0,
+	                                  nr0,
+	                                  run1,
+	                                  nr1,
+	                                  hi - start0);
+	j0 = start1 + lo - start0 - i0;
+	j1 = start1 + hi - start0 - i1;
+	i0 += start0;
+	i1 += start0;
+
+	switch (ctx->word) {
+	case sizeof(uint32_t):
+		stroll_array_merge_mt_part32(parms,
+		                             &((uint32_t *)dst)[lo],
+		                             &((const uint32_t *)src)[i0],
+		                             &((const uint32_t *)src)[i1],
+		                             &((const uint32_t *)src)[j0],
+		                             &((const uint32_t *)src)[j1]);
+		break;
+
+	case sizeof(uint64_t):
+		stroll_array_merge_mt_part64(parms,
+		                             &((uint64_t *)dst)[lo],
+		                             &((const uint64_t *)src)[i0],
+		                             &((const uint64_t *)src)[i1],
+		                             &((const uint64_t *)src)[j0],
+		                             &((const uint64_t *)src)[j1]);
+		break;
+
+	default:
+		stroll_array_merge_mt_part_mem(
+			parms,
+			&((char *)dst)[lo * parms->size],
+			&((const char *)src)[i0 * parms->size],
+			&((const char *)src)[i1 * parms->size],
+			&((const char *)src)[j0 * parms->size],
+			&((const char *)src)[j1 * parms->size]);
+	}
+}
+
+static __stroll_nonull(1)
+void
+stroll_array_merge_mt_run(struct stroll_array_team * __restrict team,
+                          unsigned int                          id)
+{
+	stroll_array_assert_intern(team);
+	stroll_array_assert_intern(id < team->nr);
+
+	struct stroll_array_merge_mt * ctx =
+		containerof(team, struct stroll_array_merge_mt, team);
+	unsigned int                   thr_nr = team->nr;
+	size_t                         size = ctx->parms.size;
+	unsigned int                   lo = ctx->bounds[id];
+	unsigned int                   hi = ctx->bounds[id + 1];
+	void *                         src = ctx->array;
+	void *                         dst = ctx->aux;
+	unsigned int                   width;
+
+	/*
+	 * Sort own chunk using the matching slice of the auxiliary array as
+	 * scratch buffer: it is not used until merging starts.
+	 */
+	if (hi > lo)
+		stroll_array_merge_sort_with_scratch(
+			&((char *)src)[lo * size],
+			hi - lo,
+			size,
+			ctx->parms.compare,
+			ctx->parms.data,
+			&((char *)dst)[lo * size]);
+
+	stroll_array_team_sync(team);
+
+	for (width = 1; width < thr_nr; width *= 2) {
+		unsigned int run;
+		void *       tmp;
+
+		for (run = 0; run < thr_nr; run += 2 * width) {
+			unsigned int start0 = ctx->bounds[run];
+			unsigned int start1 =
+				ctx->bounds[stroll_min(run + width, thr_nr)];
+			unsigned int end =
+				ctx->bounds[stroll_min(run + (2 * width),
+				                       thr_nr)];
+
+			if ((end <= lo) || (start0 >= hi))
+				continue;
+
+			stroll_array_merge_mt_slice(ctx,
+			                            dst,
+			                            src,
+			                            start0,
+			                            start1,
+			                            end,
+			                            stroll_max(lo, start0),
+			                            stroll_min(hi, end));
+		}
+
+		stroll_array_team_sync(team);
+
+		tmp = src;
+		src = dst;
+		dst = tmp;
+	}
+
+	if (src != ctx->array)
+		memcpy(&((char *)ctx->array)[lo * size],
+		       &((const char *)src)[lo * size],
+		       (hi - lo) * size);
+}
+
+int
+stroll_array_merge_sort_mt(void * __restrict     array,
+                           unsigned int          nr,
+                           size_t                size,
+                           stroll_array_cmp_fn * compare,
+                           void *                data,
+                           unsigned int          nthreads)
+{
+	stroll_array_assert_api(array);
+	stroll_array_assert_api(nr);
+	stroll_array_assert_api(size);
+	stroll_array_assert_api(compare);
+
+	struct stroll_array_merge_mt ctx = {
+		.team  = STROLL_ARRAY_TEAM_INIT(stroll_array_merge_mt_run),
+		.parms = {
+			.size    = size,
+			.compare = compare,
+			.data    = data,
+			.thres   = STROLL_MSORT_INSERT_THRESHOLD * size
+		},
+		.array = array
+	};
+	unsigned int                 t;
+	int                          err;
+
+	nthreads = stroll_array_team_size(nthreads, nr);
+	if (nthreads <= 1)
+		return stroll_array_merge_sort(array, nr, size, compare, data);
+
+	if (stroll_array_aligned(array, size, sizeof(uint32_t)))
+		ctx.word = sizeof(uint32_t);
+	else if (stroll_array_aligned(array, size, sizeof(uint64_t)))
+		ctx.word = sizeof(uint64_t);
+	else
+		ctx.word = 0;
+
+	ctx.aux = malloc(nr * size);
+	if (!ctx.aux)
+		return -errno;
+
+	ctx.bounds = malloc((nthreads + 1) * sizeof(ctx.bounds[0]));
+	if (!ctx.bounds) {
+		err = -errno;
+		goto free_aux;
+	}
+
+	err = stroll_array_team_spawn(&ctx.team, nthreads);
+	if (err)
+		goto free_bounds;
+
+	for (t = 0; t <= ctx.team.nr; t++)
+		ctx.bounds[t] = (unsigned int)(((unsigned long long)nr * t) /
+		                               ctx.team.nr);
+
+	err = stroll_array_team_run(&ctx.team);
+
+free_bounds:
+	free(ctx.bounds);
+free_aux:
+	free(ctx.aux);
+
+	return err;
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_MERGE_SORT_MT) */
+
+#endif /* defined(CONFIG_STROLL_ARRAY_MERGE_SORT) */
+
+#if defined(CONFIG_STROLL_ARRAY_INPLACE_MERGE_SORT)
+
+/*
+ * Size of the fixed buffer used to speed up merging and rotations, allocated
+ * onto the stack.
+ */
+#define STROLL_ARRAY_INPMERGE_BUFF_SIZE \
+	((size_t)CONFIG_STROLL_ARRAY_INPLACE_MERGE_SORT_BUFFER)
+
+/*
+ * Length of initial runs sorted using binary insertion sort before merging.
+ */
+#define STROLL_ARRAY_INPMERGE_RUN (16U)
+
+struct stroll_array_inpmerge {
+	size_t                size;
+	stroll_array_cmp_fn * compare;
+	void *                data;
+	char *                buff;
+	unsigned int          buff_nr;
+};
+
+#define stroll_array_inpmerge_assert(_parms) \
+	stroll_array_assert_intern(_parms); \
+	stroll_array_assert_intern((_parms)->size); \
+	stroll_array_assert_intern((_parms)->compare); \
+	stroll_array_assert_intern((_parms)->buff); \
+	stroll_array_assert_intern((_parms)->buff_nr == \
+	                           (STROLL_ARRAY_INPMERGE_BUFF_SIZE / \
+	                            (_parms)->size))
+
+/*
+ * Swap content of non overlapping [fst:fst + len[ and [snd:snd + len[ byte
+ * areas, one buffer sized chunk at a time.
+ */
+static __stroll_nonull(1, 2, 3)
+void
+stroll_array_inpmerge_swap(
+	const struct stroll_array_inpmerge * __restrict parms,
+	char * __restrict                               fst,
+	char * __restrict                               snd,
+	size_t                                          len)
+{
+	stroll_array_inpmerge_assert(parms);
+	stroll_array_assert_intern(fst);
+	stroll_array_assert_intern(snd);
+
+	while (len) {
+		size_t chunk = stroll_min(len, STROLL_ARRAY_INPMERGE_BUFF_SIZE);
+
+		memcpy(parms->buff, fst, chunk);
+		memcpy(fst, snd, chunk);
+		memcpy(snd, parms->buff, chunk);
+
+		fst += chunk;
+		snd += chunk;
+		len -= chunk;
+	}
+}
+
+/*
+ * Rotate the [array:array + fst_len + snd_len[ byte area so that its trailing
+ * snd_len bytes come first while preserving the order of bytes within both
+ * sub-areas.
+ *
+ * When the shortest sub-area fits into the buffer, it is saved into the buffer
+ * while the other one is moved at once. Otherwise, rotation is performed by
+ * swapping equally sized blocks (Gries-Mills algorithm), shrinking the area
+ * left to rotate at each step.
+ */
+static __stroll_nonull(1, 2)
+void
+stroll_array_inpmerge_rotate(
+	const struct stroll_array_inpmerge * __restrict parms,
+	char *                                          array,
+	size_t                                          fst_len,
+	size_t                                          snd_len)
+{
+	stroll_array_inpmerge_assert(parms);
+	stroll_array_assert_intern(array);
+
+	while (fst_len && snd_len) {
+		if (fst_len <= snd_len) {
+			if (fst_len <= STROLL_ARRAY_INPMERGE_BUFF_SIZE) {
+				memcpy(parms->buff, array, fst_len);
+				memmove(array, &array[fst_len], snd_len);
+				memcpy(&array[snd_len], parms->buff, fst_len);
+				return;
+			}
+
+			stroll_array_inpmerge_swap(parms,
+			                           array,
+			                           &array[fst_len],
+			                           fst_len);
+			array += fst_len;
+			snd_len -= fst_len;
+		}
+		else {
+			if (snd_len <= STROLL_ARRAY_INPMERGE_BUFF_SIZE) {
+				memcpy(parms->buff, &array[fst_len], snd_len);
+				memmove(&array[snd_len], array, fst_len);
+				memcpy(array, parms->buff, snd_len);
+				return;
+			}
+
+			stroll_array_inpmerge_swap(parms,
+			                           &array[fst_len - snd_len],
+			                           &array[fst_len],
+			                           snd_len);
+			fst_len -= snd_len;
+		}
+	}
+}
+
+/*
+ * Return the number of leading elements of the sorted [array:array + nr[ range
+ * that compare lower than `key', or lower than or equal to `key' when `right'
+ * is true.
+ */
+#define STROLL_ARRAY_DEFINE_INPMERGE_BOUND(_bound_func, _size) \
+	static __stroll_nonull(1, 2, 3) \
+	unsigned int \
+	_bound_func(const struct stroll_array_inpmerge * __restrict parms, \
+	            const char *                                    key, \
+	            const char *                                    array, \
+	            unsigned int                                    nr, \
+	            bool                                            right) \
+	{ \
+		stroll_array_inpmerge_assert(parms); \
+		stroll_array_assert_intern(key); \
+		stroll_array_assert_intern(array); \
+		\
+		size_t       sz = _size; \
+		unsigned int lo = 0; \
+		unsigned int hi = nr; \
+		\
+		while (lo < hi) { \
+			unsigned int mid = lo + ((hi - lo) / 2); \
+			int          cmp; \
+			\
+			cmp = parms->compare(&array[mid * sz], \
+			                     key, \
+			                     parms->data); \
+			if ((cmp < 0) || (right && !cmp)) \
+				lo = mid + 1; \
+			else \
+				hi = mid; \
+		} \
+		\
+		return lo; \
+	}
+
+/*
+ * Sort the [array:array + nr[ range using stable binary insertion sort.
+ */
+#define STROLL_ARRAY_DEFINE_INPMERGE_INSERT(_insert_func, _bound_func, _size) \
+	static __stroll_nonull(1, 2) \
+	void \
+	_insert_func(const struct stroll_array_inpmerge * __restrict parms, \
+	             char *                                          array, \
+	             unsigned int                                    nr) \
+	{ \
+		stroll_array_inpmerge_assert(parms); \
+		stroll_array_assert_intern(array); \
+		stroll_array_assert_intern(nr); \
+		\
+		size_t       sz = _size; \
+		char         tmp[_size]; \
+		unsigned int e; \
+		\
+		for (e = 1; e < nr; e++) { \
+			char *       elem = &array[e * sz]; \
+			unsigned int pos; \
+			\
+			pos = _bound_func(parms, elem, array, e, true); \
+			if (pos == e) \
+				continue; \
+			\
+			memcpy(tmp, elem, sz); \
+			memmove(&array[(pos + 1) * sz], \
+			        &array[pos * sz], \
+			        (e - pos) * sz); \
+			memcpy(&array[pos * sz], tmp, sz); \
+		} \
+	}
+
+/*
+ * Merge adjacent [fst:fst + fst_nr[ and [fst + fst_nr:fst + fst_nr + snd_nr[
+ * sorted runs, where the first one fits into the buffer, by copying the first
+ * run into the buffer and merging from the left.
+ */
+#define STROLL_ARRAY_DEFINE_INPMERGE_MERGE_LO(_lo_func, _size) \
+	static __stroll_nonull(1, 2) \
+	void \
+	_lo_func(const struct stroll_array_inpmerge * __restrict parms, \
+	         char *                                          fst, \
+	         unsigned int                                    fst_nr, \
+	         unsigned int                                    snd_nr) \
+	{ \
+		stroll_array_inpmerge_assert(parms); \
+		stroll_array_assert_intern(fst); \
+		stroll_array_assert_intern(fst_nr); \
+		stroll_array_assert_intern(fst_nr <= parms->buff_nr); \
+		stroll_array_assert_intern(snd_nr); \
+		\
+		size_t       sz = _size; \
+		const char * buff = parms->buff; \
+		const char * buff_end = &buff[fst_nr * sz]; \
+		const char * snd = &fst[fst_nr * sz]; \
+		const char * snd_end = &snd[snd_nr * sz]; \
+		\
+		memcpy(parms->buff, fst, fst_nr * sz); \
+		\
+		while ((buff < buff_end) && (snd < snd_end)) { \
+			if (parms->compare(snd, buff, parms->data) < 0) { \
+				memcpy(fst, snd, sz); \
+				snd += sz; \
+			} \
+			else { \
+				memcpy(fst, buff, sz); \
+				buff += sz; \
+			} \
+			fst += sz; \
+		} \
+		\
+		memcpy(fst, buff, (size_t)(buff_end - buff)); \
+	}
+
+/*
+ * Merge adjacent [fst:fst + fst_nr[ and [fst + fst_nr:fst + fst_nr + snd_nr[
+ * sorted runs, where the second one fits into the buffer, by copying the
+ * second run into the buffer and merging from the right.
+ */
+#define STROLL_ARRAY_DEFINE_INPMERGE_MERGE_HI(_hi_func, _size) \
+	static __stroll_nonull(1, 2) \
+	void \
+	_hi_func(const struct stroll_array_inpmerge * __restrict parms, \
+	         char *                                          fst, \
+	         unsigned int                                    fst_nr, \
+	         unsigned int                                    snd_nr) \
+	{ \
+		stroll_array_inpmerge_assert(parms); \
+		stroll_array_assert_intern(fst); \
+		stroll_array_assert_intern(fst_nr); \
+		stroll_array_assert_intern(snd_nr); \
+		stroll_array_assert_intern(snd_nr <= parms->buff_nr); \
+		\
+		size_t       sz = _size; \
+		const char * buff = parms->buff; \
+		unsigned int out = fst_nr + snd_nr; \
+		\
+		memcpy(parms->buff, &fst[fst_nr * sz], snd_nr * sz); \
+		\
+		while (fst_nr && snd_nr) { \
+			out--; \
+			if (parms->compare(&buff[(snd_nr - 1) * sz], \
+			                   &fst[(fst_nr - 1) * sz], \
+			                   parms->data) < 0) { \
+				fst_nr--; \
+				memcpy(&fst[out * sz], \
+				       &fst[fst_nr * sz], \
+				       sz); \
+			} \
+			else { \
+				snd_nr--; \
+				memcpy(&fst[out * sz], \
+				       &buff[snd_nr * sz], \
+				       sz); \
+			} \
+		} \
+		\
+		memcpy(fst, buff, snd_nr * sz); \
+	}
+
+/*
+ * Merge adjacent [fst:fst + fst_nr[ and [fst + fst_nr:fst + fst_nr + snd_nr[
+ * sorted runs in-place.
+ *
+ * Leading elements of the first run that are already in place as well as
+ * trailing elements of the second run that are already in place are skipped
+ * first. Then, when one of the remaining runs fits into the buffer, runs are
+ * merged using a buffered merge.
+ *
+ * Otherwise, the longest run is split in its middle and the matching split
+ * point of the other run is located using binary search. The second part of
+ * the first run and the first part of the second run are then swapped by
+ * rotation, giving 2 smaller independent merging problems: the smallest one is
+ * solved recursively while the largest one is solved iteratively to bound
+ * recursion depth to O(log(n)).
+ */
+#define STROLL_ARRAY_DEFINE_INPMERGE_MERGE(_merge_func, \
+                                           _bound_func, \
+                                           _lo_func, \
+                                           _hi_func, \
+                                           _size) \
+	static __stroll_nonull(1, 2) \
+	void \
+	_merge_func(const struct stroll_array_inpmerge * __restrict parms, \
+	            char *                                          fst, \
+	            unsigned int                                    fst_nr, \
+	            unsigned int                                    snd_nr) \
+	{ \
+		stroll_array_inpmerge_assert(parms); \
+		stroll_array_assert_intern(fst); \
+		\
+		size_t sz = _size; \
+		\
+		while (fst_nr && snd_nr) { \
+			char *       snd = &fst[fst_nr * sz]; \
+			unsigned int cnt; \
+			unsigned int fst_cut; \
+			unsigned int snd_cut; \
+			char *       mid; \
+			\
+			cnt = _bound_func(parms, snd, fst, fst_nr, true); \
+			fst += cnt * sz; \
+			fst_nr -= cnt; \
+			if (!fst_nr) \
+				return; \
+			\
+			snd_nr = _bound_func(parms, \
+			                     &fst[(fst_nr - 1) * sz], \
+			                     snd, \
+			                     snd_nr, \
+			                     false); \
+			if (!snd_nr) \
+				return; \
+			\
+			if (fst_nr <= parms->buff_nr) { \
+				_lo_func(parms, fst, fst_nr, snd_nr); \
+				return; \
+			} \
+			if (snd_nr <= parms->buff_nr) { \
+				_hi_func(parms, fst, fst_nr, snd_nr); \
+				return; \
+			} \
+			\
+			if (fst_nr >= snd_nr) { \
+				fst_cut = fst_nr / 2; \
+				snd_cut = _bound_func(parms, \
+				                      &fst[fst_cut * sz], \
+				                      snd, \
+				                      snd_nr, \
+				                      false); \
+			} \
+			else { \
+				snd_cut = snd_nr / 2; \
+				fst_cut = _bound_func(parms, \
+				                      &snd[snd_cut * sz], \
+				                      fst, \
+				                      fst_nr, \
+				                      true); \
+			} \
+			\
+			stroll_array_inpmerge_rotate(parms, \
+			                             &fst[fst_cut * sz], \
+			                             (fst_nr - fst_cut) * sz, \
+			                             snd_cut * sz); \
+			\
+			mid = &fst[(fst_cut + snd_cut) * sz]; \
+			if ((fst_cut + snd_cut) <= ((fst_nr + snd_nr) / 2)) { \
+				_merge_func(parms, fst, fst_cut, snd_cut); \
+				fst = mid; \
+				fst_nr -= fst_cut; \
+				snd_nr -= snd_cut; \
+			} \
+			else { \
+				_merge_func(parms, \
+				            mid, \
+				            fst_nr - fst_cut, \
+				            snd_nr - snd_cut); \
+				fst_nr = fst_cut; \
+				snd_nr = snd_cut; \
+			} \
+		} \
+	}
+
+/*
+ * In-place merge sort main loop.
+ *
+ * Input is first split into runs of STROLL_ARRAY_INPMERGE_RUN elements sorted
+ * using binary insertion sort. Runs are then merged bottom-up, doubling their
+ * length at each pass until the whole array is sorted.
+ */
+#define STROLL_ARRAY_DEFINE_INPMERGE_SORT(_sort_func, \
+                                          _insert_func, \
+                                          _merge_func, \
+                                          _size) \
+	static __stroll_nonull(1, 2) \
+	void \
+	_sort_func(const struct stroll_array_inpmerge * __restrict parms, \
+	           char *                                          array, \
+	           unsigned int                                    nr) \
+	{ \
+		stroll_array_inpmerge_assert(parms); \
+		stroll_array_assert_intern(array); \
+		stroll_array_assert_intern(nr > 1); \
+		\
+		size_t       sz = _size; \
+		unsigned int start = 0; \
+		unsigned int width = STROLL_ARRAY_INPMERGE_RUN; \
+		\
+		while ((nr - start) > width) { \
+			_insert_func(parms, &array[start * sz], width); \
+			start += width; \
+		} \
+		_insert_func(parms, &array[start * sz], nr - start); \
+		\
+		while (width < nr) { \
+			start = 0; \
+			while ((nr - start) > width) { \
+				unsigned int left = nr - start - width; \
+				\
+				_merge_func(parms, \
+				            &array[start * sz], \
+				            width, \
+				            stroll_min(width, left)); \
+				if (left <= width) \
+					break; \
+				start += 2 * width; \
+			} \
+			\
+			if (width >= (nr - width)) \
+				break; \
+			width *= 2; \
+		} \
+	}
+
+#define STROLL_ARRAY_DEFINE_INPMERGE(_sort_func, \
+                                     _bound_func, \
+                                     _insert_func, \
+                                     _lo_func, \
+                                     _hi_func, \
+                                     _merge_func, \
+                                     _size) \
+	STROLL_ARRAY_DEFINE_INPMERGE_BOUND(_bound_func, _size) \
+	STROLL_ARRAY_DEFINE_INPMERGE_INSERT(_insert_func, _bound_func, _size) \
+	STROLL_ARRAY_DEFINE_INPMERGE_MERGE_LO(_lo_func, _size) \
+	STROLL_ARRAY_DEFINE_INPMERGE_MERGE_HI(_hi_func, _size) \
+	STROLL_ARRAY_DEFINE_INPMERGE_MERGE(_merge_func, \
+	                                   _bound_func, \
+	                                   _lo_func, \
+	                                   _hi_func, \
+	                                   _size) \
+	STROLL_ARRAY_DEFINE_INPMERGE_SORT(_sort_func, \
+	                                  _insert_func, \
+	                                  _merge_func, \
+	                                  _size)
+
+STROLL_ARRAY_DEFINE_INPMERGE(stroll_array_inpmerge_sort32,
+                             stroll_array_inpmerge_bound32,
+                             stroll_array_inpmerge_insert32,
+                             stroll_array_inpmerge_merge_lo32,
+                             stroll_array_inpmerge_merge_hi32,
+                             stroll_array_inpmerge_merge32,
+                             sizeof(uint32_t))
+
+STROLL_ARRAY_DEFINE_INPMERGE(stroll_array_inpmerge_sort64,
+                             stroll_array_inpmerge_bound64,
+                             stroll_array_inpmerge_insert64,
+                             stroll_array_inpmerge_merge_lo64,
+                             stroll_array_inpmerge_merge_hi64,
+                             stroll_array_inpmerge_merge64,
+                             sizeof(uint64_t))
+
+STROLL_ARRAY_DEFINE_INPMERGE(stroll_array_inpmerge_sort_mem,
+                             stroll_array_inpmerge_bound_mem,
+                             stroll_array_inpmerge_insert_mem,
+                             stroll_array_inpmerge_merge_lo_mem,
+                             stroll_array_inpmerge_merge_hi_mem,
+                             stroll_array_inpmerge_merge_mem,
+                             parms->size)
+
+void
+stroll_array_inplace_merge_sort(void * __restrict     array,
+                                unsigned int          nr,
+                                size_t                size,
+                                stroll_array_cmp_fn * compare,
+                                void *                data)
+{
+	stroll_array_assert_api(array);
+	stroll_array_assert_api(nr);
+	stroll_array_assert_api(size);
+	stroll_array_assert_api(compare);
+
+	unsigned long                buff[
+		(STROLL_ARRAY_INPMERGE_BUFF_SIZE + sizeof(unsigned long) - 1) /
+		sizeof(unsigned long)];
+	struct stroll_array_inpmerge parms = {
+		.size    = size,
+		.compare = compare,
+		.data    = data,
+		.buff    = (char *)buff,
+		.buff_nr = (unsigned int)
+		           (STROLL_ARRAY_INPMERGE_BUFF_SIZE / size)
+	};
+
+	if (nr == 1)
+		return;
+
+	if (stroll_array_aligned(array, size, sizeof(uint32_t)))
+		stroll_array_inpmerge_sort32(&parms, array, nr);
+	else if (stroll_array_aligned(array, size, sizeof(uint64_t)))
+		stroll_array_inpmerge_sort64(&parms, array, nr);
+	else
+		stroll_array_inpmerge_sort_mem(&parms, array, nr);
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_INPLACE_MERGE_SORT) */
+
+#if defined(CONFIG_STROLL_ARRAY_INDIRECT_SORT)
+
+/*
+ * Size of the buffer holding the slice of record saved at the beginning of
+ * each permutation cycle.
+ */
+#define STROLL_ARRAY_PERMUTE_BUFF_SIZE (1024U)
+
+struct stroll_array_argsort {
+	const char *          array;
+	size_t                size;
+	stroll_array_cmp_fn * compare;
+	void *                data;
+};
+
+static __stroll_nonull(1, 2, 3)
+int
+stroll_array_argsort_cmp(const void * first, const void * second, void * data)
+{
+	stroll_array_assert_intern(first);
+	stroll_array_assert_intern(second);
+	stroll_array_assert_intern(data);
+
+	const struct stroll_array_argsort * parms = data;
+	unsigned int                        fst = *(const unsigned int *)first;
+	unsigned int                        snd = *(const unsigned int *)second;
+
+	return parms->compare(&parms->array[fst * parms->size],
+	                      &parms->array[snd * parms->size],
+	                      parms->data);
+}
+
+int
+stroll_array_argsort(const void * __restrict  array,
+                     unsigned int             nr,
+                     size_t                   size,
+                     stroll_array_cmp_fn *    compare,
+                     void *                   data,
+                     unsigned int * __restrict indices)
+{
+	stroll_array_assert_api(array);
+	stroll_array_assert_api(nr);
+	stroll_array_assert_api(size);
+	stroll_array_assert_api(compare);
+	stroll_array_assert_api(indices);
+
+	struct stroll_array_argsort parms = {
+		.array   = array,
+		.size    = size,
+		.compare = compare,
+		.data    = data
+	};
+	unsigned int                idx;
+
+	for (idx = 0; idx < nr; idx++)
+		indices[idx] = idx;
+
+	return stroll_array_merge_sort(indices,
+	                               nr,
+	                               sizeof(indices[0]),
+	                               stroll_array_argsort_cmp,
+	                               &parms);
+}
+
+/*
+ * Apply permutation given by `indices' to the [array:array + nr[ range, i.e.
+ * move record found at index indices[i] to index i, following each
+ * permutation cycle in turn.
+ *
+ * The first record of a cycle is saved into a buffer, then every other
+ * record of the cycle is moved to its final location right over the one
+ * moved during the previous step. Finally, the saved record is restored at
+ * the last location of the cycle. Records larger than the buffer are
+ * processed one buffer sized slice at a time, following each cycle once per
+ * slice.
+ *
+ * Every record is therefore moved once (per slice) only. While walking a
+ * cycle, the record after next is prefetched to hide the latency of the
+ * random memory accesses.
+ *
+ * Once a cycle has been processed, the related indices are reset to identity
+ * so that the cycle is skipped when encountered again.
+ */
+#define STROLL_ARRAY_DEFINE_PERMUTE(_permute_func, _size) \
+	static __stroll_nonull(1, 3) \
+	void \
+	_permute_func(char * __restrict         array, \
+	              unsigned int              nr, \
+	              unsigned int * __restrict indices, \
+	              size_t                    size __unused) \
+	{ \
+		stroll_array_assert_intern(array); \
+		stroll_array_assert_intern(nr); \
+		stroll_array_assert_intern(indices); \
+		\
+		size_t        sz = _size; \
+		unsigned long buff[STROLL_ARRAY_PERMUTE_BUFF_SIZE / \
+		                   sizeof(unsigned long)]; \
+		unsigned int  start; \
+		\
+		for (start = 0; start < nr; start++) { \
+			size_t off; \
+			size_t len; \
+			\
+			stroll_array_assert_api(indices[start] < nr); \
+			if (indices[start] == start) \
+				continue; \
+			\
+			for (off = 0; off < sz; off += len) { \
+				bool         last; \
+				unsigned int curr = start; \
+				unsigned int next = indices[curr]; \
+				\
+				len = stroll_min(sz - off, sizeof(buff)); \
+				last = (off + len) == sz; \
+				\
+				memcpy(buff, &array[(start * sz) + off], len); \
+				\
+				while (next != start) { \
+					stroll_array_assert_api(next < nr); \
+					stroll_prefetch( \
+						&array[(indices[next] * sz) + \
+						       off], \
+						STROLL_PREFETCH_ACCESS_RO); \
+					\
+					memcpy(&array[(curr * sz) + off], \
+					       &array[(next * sz) + off], \
+					       len); \
+					if (last) \
+						indices[curr] = curr; \
+					\
+					curr = next; \
+					next = indices[curr]; \
+				} \
+				\
+				memcpy(&array[(curr * sz) + off], buff, len); \
+				if (last) \
+					indices[curr] = curr; \
+			} \
+		} \
+	}
+
+STROLL_ARRAY_DEFINE_PERMUTE(stroll_array_permute32, sizeof(uint32_t))
+
+STROLL_ARRAY_DEFINE_PERMUTE(stroll_array_permute64, sizeof(uint64_t))
+
+STROLL_ARRAY_DEFINE_PERMUTE(stroll_array_permute_mem, size)
+
+void
+stroll_array_permute(void * __restrict         array,
+                     unsigned int              nr,
+                     size_t                    size,
+                     unsigned int * __restrict indices)
+{
+	stroll_array_assert_api(array);
+	stroll_array_assert_api(nr);
+	stroll_array_assert_api(size);
+	stroll_array_assert_api(indices);
+
+	if (stroll_array_aligned(array, size, sizeof(uint32_t)))
+		stroll_array_permute32(array, nr, indices, size);
+	else if (stroll_array_aligned(array, size, sizeof(uint64_t)))
+		stroll_array_permute64(array, nr, indices, size);
+	else
+		stroll_array_permute_mem(array, nr, indices, size);
+}
+
+int
+stroll_array_indirect_sort(void * __restrict     array,
+                           unsigned int          nr,
+                           size_t                size,
+                           stroll_array_cmp_fn * compare,
+                           void *                data)
+{
+	stroll_array_assert_api(array);
+	stroll_array_assert_api(nr);
+	stroll_array_assert_api(size);
+	stroll_array_assert_api(compare);
+
+	unsigned int * indices;
+	int            ret;
+
+	if (nr == 1)
+		return 0;
+
+	indices = malloc(nr * sizeof(indices[0]));
+	if (!indices)
+		return -errno;
+
+	ret = stroll_array_argsort(array, nr, size, compare, data, indices);
+	if (!ret)
+		stroll_array_permute(array, nr, size, indices);
+
+	free(indices);
+
+	return ret;
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_INDIRECT_SORT) */
+
+#if defined(CONFIG_STROLL_ARRAY_POWER_SORT)
+
+/*
+ * Initial number of consecutive "wins" from the same run required for a merge
+ * to switch to galloping mode.
+ */
+#define STROLL_ARRAY_POWER_MIN_GALLOP (7U)
+
+/*
+ * Runs shorter than minimum run length are extended using binary insertion
+ * sort. Minimum run length is computed so that it lies within the
+ * [STROLL_ARRAY_POWER_MINRUN_MAX / 2:STROLL_ARRAY_POWER_MINRUN_MAX] range.
+ */
+#define STROLL_ARRAY_POWER_MINRUN_MAX (64U)
+
+/*
+ * Maximum number of pending runs. Node powers of runs pending onto the stack
+ * are strictly increasing and bounded by log2(nr) + 1.
+ */
+#define STROLL_ARRAY_POWER_RUNS_MAX ((sizeof(unsigned int) * CHAR_BIT) + 1)
+
+struct stroll_array_power {
+	size_t                size;
+	stroll_array_cmp_fn * compare;
+	void *                data;
+	unsigned int          nr;
+	char *                aux;
+	unsigned int          gallop;
+};
+
+struct stroll_array_power_run {
+	unsigned int start;
+	unsigned int nr;
+	unsigned int power;
+};
+
+#define stroll_array_power_assert(_parms) \
+	stroll_array_assert_intern(_parms); \
+	stroll_array_assert_intern((_parms)->size); \
+	stroll_array_assert_intern((_parms)->compare); \
+	stroll_array_assert_intern((_parms)->nr > 1); \
+	stroll_array_assert_intern((_parms)->gallop)
+
+/*
+ * Compute minimum run length so that the number of runs, i.e. nr / minrun, is
+ * equal to or slightly less than a power of 2, which gives balanced merges for
+ * random inputs.
+ */
+static __stroll_const __stroll_nothrow
+unsigned int
+stroll_array_power_minrun(unsigned int nr)
+{
+	unsigned int rem = 0;
+
+	while (nr >= STROLL_ARRAY_POWER_MINRUN_MAX) {
+		rem |= nr & 1;
+		nr >>= 1;
+	}
+
+	return nr + rem;
+}
+
+/*
+ * Compute the power of the node separating 2 adjacent runs, i.e. the depth of
+ * the boundary between both runs within a perfectly balanced merge tree built
+ * over the [0:nr[ range.
+ *
+ * Run midpoints are mapped to the [0:1[ interval, and power is given by the
+ * index of the first bit that differs in the binary expansions of both
+ * midpoints. See "Nearly-Optimal Mergesorts: Fast, Practical Sorting Methods
+ * That Optimally Adapt to Existing Runs", J. Ian Munro and Sebastian Wild,
+ * 2018.
+ */
+static __stroll_const __stroll_nothrow
+unsigned int
+stroll_array_power_node(unsigned int start,
+                        unsigned int fst_nr,
+                        unsigned int snd_nr,
+                        unsigned int nr)
+{
+	uint64_t     fst = (2 * (uint64_t)start) + fst_nr;
+	uint64_t     snd = fst + fst_nr + snd_nr;
+	unsigned int power = 0;
+
+	while (true) {
+		power++;
+
+		if (fst >= nr) {
+			fst -= nr;
+			snd -= nr;
+		}
+		else if (snd >= nr)
+			break;
+
+		fst <<= 1;
+		snd <<= 1;
+	}
+
+	return power;
+}
+
+/*
+ * Return true when `elem' should be located before `key' into a sorted
+ * sequence. When `right' is true, elements equal to key are located before
+ * it.
+ */
+static inline __stroll_nonull(1, 2, 3)
+bool
+stroll_array_power_precedes(const struct stroll_array_power * __restrict parms,
+                            const char *                                 elem,
+                            const char *                                 key,
+                            bool                                         right)
+{
+	int cmp = parms->compare(key, elem, parms->data);
+
+	return right ? (cmp >= 0) : (cmp > 0);
+}
+
+/*
+ * Return the length of the run starting at `array' and reverse it when it is
+ * strictly descending. Strictness ensures reversal keeps sorting stable.
+ */
+#define STROLL_ARRAY_DEFINE_POWER_COUNT_RUN(_count_func, _size) \
+	static __stroll_nonull(1, 2) \
+	unsigned int \
+	_count_func(const struct stroll_array_power * __restrict parms, \
+	            char *                                       array, \
+	            unsigned int                                 nr) \
+	{ \
+		stroll_array_power_assert(parms); \
+		stroll_array_assert_intern(array); \
+		stroll_array_assert_intern(nr); \
+		\
+		size_t       sz = _size; \
+		char *       curr = &array[sz]; \
+		unsigned int cnt = 2; \
+		\
+		if (nr == 1) \
+			return 1; \
+		\
+		if (parms->compare(curr, array, parms->data) < 0) { \
+			char * lo = array; \
+			char * hi; \
+			\
+			for (; cnt < nr; cnt++) { \
+				curr += sz; \
+				if (parms->compare(curr, \
+				                   curr - sz, \
+				                   parms->data) >= 0) \
+					break; \
+			} \
+			\
+			hi = &array[(cnt - 1) * sz]; \
+			while (lo < hi) { \
+				char tmp[_size]; \
+				\
+				memcpy(tmp, lo, sz); \
+				memcpy(lo, hi, sz); \
+				memcpy(hi, tmp, sz); \
+				lo += sz; \
+				hi -= sz; \
+			} \
+		} \
+		else { \
+			for (; cnt < nr; cnt++) { \
+				curr += sz; \
+				if (parms->compare(curr, \
+				                   curr - sz, \
+				                   parms->data) < 0) \
+					break; \
+			} \
+		} \
+		\
+		return cnt; \
+	}
+
+/*
+ * Extend the sorted [array:array + start[ run to the whole [array:array + nr[
+ * range using stable binary insertion sort.
+ */
+#define STROLL_ARRAY_DEFINE_POWER_INSERT(_insert_func, _size) \
+	static __stroll_nonull(1, 2) \
+	void \
+	_insert_func(const struct stroll_array_power * __restrict parms, \
+	             char *                                       array, \
+	             unsigned int                                 nr, \
+	             unsigned int                                 start) \
+	{ \
+		stroll_array_power_assert(parms); \
+		stroll_array_assert_intern(array); \
+		stroll_array_assert_intern(start); \
+		stroll_array_assert_intern(start <= nr); \
+		\
+		size_t       sz = _size; \
+		char         tmp[_size]; \
+		unsigned int e; \
+		\
+		for (e = start; e < nr; e++) { \
+			char *       elem = &array[e * sz]; \
+			unsigned int lo = 0; \
+			unsigned int hi = e; \
+			\
+			while (lo < hi) { \
+				unsigned int mid = lo + ((hi - lo) / 2); \
+				\
+				if (parms->compare(elem, \
+				                   &array[mid * sz], \
+				                   parms->data) < 0) \
+					hi = mid; \
+				else \
+					lo = mid + 1; \
+			} \
+			\
+			if (lo == e) \
+				continue; \
+			\
+			memcpy(tmp, elem, sz); \
+			memmove(&array[(lo + 1) * sz], \
+			        &array[lo * sz], \
+			        (e - lo) * sz); \
+			memcpy(&array[lo * sz], tmp, sz); \
+		} \
+	}
+
+/*
+ * Return the number of leading elements of the sorted [array:array + nr[ range
+ * that precede `key' (see stroll_array_power_precedes()).
+ *
+ * Search is performed using exponential search ("galloping") starting from
+ * the beginning of the range for the forward variant and from its end for the
+ * backward variant, followed by a binary search within the last probed
+ * interval. This requires O(log(k)) comparisons where k is the distance from
+ * the starting end to the searched location.
+ */
+#define STROLL_ARRAY_DEFINE_POWER_GALLOP(_fwd_func, _bwd_func, _size) \
+	static __stroll_nonull(1, 2, 3) \
+	unsigned int \
+	_fwd_func(const struct stroll_array_power * __restrict parms, \
+	          const char *                                 key, \
+	          const char *                                 array, \
+	          unsigned int                                 nr, \
+	          bool                                         right) \
+	{ \
+		stroll_array_power_assert(parms); \
+		stroll_array_assert_intern(key); \
+		stroll_array_assert_intern(array); \
+		stroll_array_assert_intern(nr); \
+		\
+		size_t sz = _size; \
+		size_t last = 0; \
+		size_t ofs = 1; \
+		\
+		if (!stroll_array_power_precedes(parms, array, key, right)) \
+			return 0; \
+		\
+		while ((ofs < nr) && \
+		       stroll_array_power_precedes(parms, \
+		                                   &array[ofs * sz], \
+		                                   key, \
+		                                   right)) { \
+			last = ofs; \
+			ofs = (ofs << 1) + 1; \
+		} \
+		ofs = stroll_min(ofs, (size_t)nr); \
+		\
+		last++; \
+		while (last < ofs) { \
+			size_t mid = last + ((ofs - last) / 2); \
+			\
+			if (stroll_array_power_precedes(parms, \
+			                                &array[mid * sz], \
+			                                key, \
+			                                right)) \
+				last = mid + 1; \
+			else \
+				ofs = mid; \
+		} \
+		\
+		return (unsigned int)last; \
+	} \
+	\
+	static __stroll_nonull(1, 2, 3) \
+	unsigned int \
+	_bwd_func(const struct stroll_array_power * __restrict parms, \
+	          const char *                                 key, \
+	          const char *                                 array, \
+	          unsigned int                                 nr, \
+	          bool                                         right) \
+	{ \
+		stroll_array_power_assert(parms); \
+		stroll_array_assert_intern(key); \
+		stroll_array_assert_intern(array); \
+		stroll_array_assert_intern(nr); \
+		\
+		size_t sz = _size; \
+		size_t last = 0; \
+		size_t ofs = 1; \
+		size_t lo; \
+		size_t hi; \
+		\
+		if (stroll_array_power_precedes(parms, \
+		                                &array[(nr - 1) * sz], \
+		                                key, \
+		                                right)) \
+			return nr; \
+		\
+		while ((ofs < nr) && \
+		       !stroll_array_power_precedes( \
+				parms, \
+				&array[(nr - 1 - ofs) * sz], \
+				key, \
+				right)) { \
+			last = ofs; \
+			ofs = (ofs << 1) + 1; \
+		} \
+		ofs = stroll_min(ofs, (size_t)nr); \
+		\
+		lo = nr - ofs; \
+		hi = nr - 1 - last; \
+		while (lo < hi) { \
+			size_t mid = lo + ((hi - lo) / 2); \
+			\
+			if (stroll_array_power_precedes(parms, \
+			                                &array[mid * sz], \
+			                                key, \
+			                                right)) \
+				lo = mid + 1; \
+			else \
+				hi = mid; \
+		} \
+		\
+		return (unsigned int)lo; \
+	}
+
+/*
+ * Merge adjacent [fst:fst + fst_nr[ and [snd:snd + snd_nr[ sorted runs, where
+ * fst_nr <= snd_nr, by copying the first one into the auxiliary buffer and
+ * merging from the left.
+ *
+ * Callers ensure that:
+ * - the first element of the second run is smaller than the first element of
+ *   the first run,
+ * - the last element of the first run is greater than all elements of the
+ *   second run.
+ *
+ * Runs are merged one element at a time until one of them "wins" gallop times
+ * in a row. Merge then switches to galloping mode where whole blocks of
+ * elements are located using exponential search and moved at once. Galloping
+ * mode is left as soon as blocks get shorter than
+ * STROLL_ARRAY_POWER_MIN_GALLOP. The gallop threshold is adapted according to
+ * the success of galloping mode so that merging random data does not suffer
+ * from the extra comparisons.
+ */
+#define STROLL_ARRAY_DEFINE_POWER_MERGE_LO(_merge_func, _gallop_func, _size) \
+	static __stroll_nonull(1, 2, 4) \
+	void \
+	_merge_func(struct stroll_array_power * __restrict parms, \
+	            char *                                 fst, \
+	            unsigned int                           fst_nr, \
+	            char *                                 snd, \
+	            unsigned int                           snd_nr) \
+	{ \
+		stroll_array_power_assert(parms); \
+		stroll_array_assert_intern(parms->aux); \
+		stroll_array_assert_intern(fst_nr); \
+		stroll_array_assert_intern(snd_nr); \
+		stroll_array_assert_intern(fst_nr <= snd_nr); \
+		\
+		size_t       sz = _size; \
+		char *       dst = fst; \
+		char *       pfst = parms->aux; \
+		char *       psnd = snd; \
+		unsigned int gallop = parms->gallop; \
+		\
+		memcpy(parms->aux, fst, fst_nr * sz); \
+		\
+		memcpy(dst, psnd, sz); \
+		dst += sz; \
+		psnd += sz; \
+		if (!--snd_nr) \
+			goto done; \
+		if (fst_nr == 1) \
+			goto copy; \
+		\
+		while (true) { \
+			unsigned int fst_cnt = 0; \
+			unsigned int snd_cnt = 0; \
+			\
+			do { \
+				if (parms->compare(psnd, \
+				                   pfst, \
+				                   parms->data) < 0) { \
+					memcpy(dst, psnd, sz); \
+					dst += sz; \
+					psnd += sz; \
+					snd_cnt++; \
+					fst_cnt = 0; \
+					if (!--snd_nr) \
+						goto done; \
+				} \
+				else { \
+					memcpy(dst, pfst, sz); \
+					dst += sz; \
+					pfst += sz; \
+					fst_cnt++; \
+					snd_cnt = 0; \
+					if (--fst_nr == 1) \
+						goto copy; \
+				} \
+			} while ((fst_cnt | snd_cnt) < gallop); \
+			\
+			gallop++; \
+			do { \
+				gallop -= (gallop > 1); \
+				\
+				fst_cnt = _gallop_func(parms, \
+				                       psnd, \
+				                       pfst, \
+				                       fst_nr, \
+				                       true); \
+				if (fst_cnt) { \
+					memcpy(dst, pfst, fst_cnt * sz); \
+					dst += fst_cnt * sz; \
+					pfst += fst_cnt * sz; \
+					fst_nr -= fst_cnt; \
+					if (fst_nr == 1) \
+						goto copy; \
+					if (!fst_nr) \
+						goto done; \
+				} \
+				memcpy(dst, psnd, sz); \
+				dst += sz; \
+				psnd += sz; \
+				if (!--snd_nr) \
+					goto done; \
+				\
+				snd_cnt = _gallop_func(parms, \
+				                       pfst, \
+				                       psnd, \
+				                       snd_nr, \
+				                       false); \
+				if (snd_cnt) { \
+					memmove(dst, psnd, snd_cnt * sz); \
+					dst += snd_cnt * sz; \
+					psnd += snd_cnt * sz; \
+					snd_nr -= snd_cnt; \
+					if (!snd_nr) \
+						goto done; \
+				} \
+				memcpy(dst, pfst, sz); \
+				dst += sz; \
+				pfst += sz; \
+				if (--fst_nr == 1) \
+					goto copy; \
+			} while ((fst_cnt >= STROLL_ARRAY_POWER_MIN_GALLOP) || \
+			         (snd_cnt >= STROLL_ARRAY_POWER_MIN_GALLOP)); \
+			\
+			gallop++; \
+		} \
+		\
+	done: \
+		if (fst_nr) \
+			memcpy(dst, pfst, fst_nr * sz); \
+		parms->gallop = gallop; \
+		return; \
+		\
+	copy: \
+		memmove(dst, psnd, snd_nr * sz); \
+		memcpy(&dst[snd_nr * sz], pfst, sz); \
+		parms->gallop = gallop; \
+	}
+
+/*
+ * Merge adjacent [fst:fst + fst_nr[ and [snd:snd + snd_nr[ sorted runs, where
+ * fst_nr > snd_nr, by copying the second one into the auxiliary buffer and
+ * merging from the right.
+ * This is the mirror of the STROLL_ARRAY_DEFINE_POWER_MERGE_LO() logic.
+ */
+#define STROLL_ARRAY_DEFINE_POWER_MERGE_HI(_merge_func, _gallop_func, _size) \
+	static __stroll_nonull(1, 2, 4) \
+	void \
+	_merge_func(struct stroll_array_power * __restrict parms, \
+	            char *                                 fst, \
+	            unsigned int                           fst_nr, \
+	            char *                                 snd, \
+	            unsigned int                           snd_nr) \
+	{ \
+		stroll_array_power_assert(parms); \
+		stroll_array_assert_intern(parms->aux); \
+		stroll_array_assert_intern(fst_nr); \
+		stroll_array_assert_intern(snd_nr); \
+		\
+		size_t       sz = _size; \
+		char *       dst = &snd[(snd_nr - 1) * sz]; \
+		char *       pfst = &fst[(fst_nr - 1) * sz]; \
+		char *       psnd = &parms->aux[(snd_nr - 1) * sz]; \
+		unsigned int gallop = parms->gallop; \
+		\
+		memcpy(parms->aux, snd, snd_nr * sz); \
+		\
+		memcpy(dst, pfst, sz); \
+		dst -= sz; \
+		pfst -= sz; \
+		if (!--fst_nr) \
+			goto done; \
+		if (snd_nr == 1) \
+			goto copy; \
+		\
+		while (true) { \
+			unsigned int fst_cnt = 0; \
+			unsigned int snd_cnt = 0; \
+			\
+			do { \
+				if (parms->compare(psnd, \
+				                   pfst, \
+				                   parms->data) < 0) { \
+					memcpy(dst, pfst, sz); \
+					dst -= sz; \
+					pfst -= sz; \
+					fst_cnt++; \
+					snd_cnt = 0; \
+					if (!--fst_nr) \
+						goto done; \
+				} \
+				else { \
+					memcpy(dst, psnd, sz); \
+					dst -= sz; \
+					psnd -= sz; \
+					snd_cnt++; \
+					fst_cnt = 0; \
+					if (--snd_nr == 1) \
+						goto copy; \
+				} \
+			} while ((fst_cnt | snd_cnt) < gallop); \
+			\
+			gallop++; \
+			do { \
+				gallop -= (gallop > 1); \
+				\
+				fst_cnt = fst_nr - _gallop_func(parms, \
+				                                psnd, \
+				                                fst, \
+				                                fst_nr, \
+				                                true); \
+				if (fst_cnt) { \
+					dst -= fst_cnt * sz; \
+					pfst -= fst_cnt * sz; \
+					memmove(&dst[sz], \
+					        &pfst[sz], \
+					        fst_cnt * sz); \
+					fst_nr -= fst_cnt; \
+					if (!fst_nr) \
+						goto done; \
+				} \
+				memcpy(dst, psnd, sz); \
+				dst -= sz; \
+				psnd -= sz; \
+				if (--snd_nr == 1) \
+					goto copy; \
+				\
+				snd_cnt = snd_nr - _gallop_func(parms, \
+				                                pfst, \
+				                                parms->aux, \
+				                                snd_nr, \
+				                                false); \
+				if (snd_cnt) { \
+					dst -= snd_cnt * sz; \
+					psnd -= snd_cnt * sz; \
+					memcpy(&dst[sz], \
+					       &psnd[sz], \
+					       snd_cnt * sz); \
+					snd_nr -= snd_cnt; \
+					if (snd_nr == 1) \
+						goto copy; \
+					if (!snd_nr) \
+						goto done; \
+				} \
+				memcpy(dst, pfst, sz); \
+				dst -= sz; \
+				pfst -= sz; \
+				if (!--fst_nr) \
+					goto done; \
+			} while ((fst_cnt >= STROLL_ARRAY_POWER_MIN_GALLOP) || \
+			         (snd_cnt >= STROLL_ARRAY_POWER_MIN_GALLOP)); \
+			\
+			gallop++; \
+		} \
+		\
+	done: \
+		if (snd_nr) \
+			memcpy(fst, parms->aux, snd_nr * sz); \
+		parms->gallop = gallop; \
+		return; \
+		\
+	copy: \
+		memmove(&fst[sz], fst, fst_nr * sz); \
+		memcpy(fst, parms->aux, sz); \
+		parms->gallop = gallop; \
+	}
+
+/*
+ * Merge the 2 topmost runs pending onto the run stack.
+ *
+ * Elements of the first run that are smaller than or equal to the first
+ * element of the second run are already in place, as are elements of the
+ * second run that are greater than or equal to the last element of the first
+ * run. Locate them using galloping first so that merging concatenated sorted
+ * runs completes in O(log(n)) comparisons.
+ *
+ * The auxiliary merge buffer is allocated on first use only, so that sorting
+ * an already sorted input requires no memory allocation.
+ */
+#define STROLL_ARRAY_DEFINE_POWER_MERGE_AT(_merge_func, \
+                                           _fwd_func, \
+                                           _bwd_func, \
+                                           _lo_func, \
+                                           _hi_func, \
+                                           _size) \
+	static __stroll_nonull(1, 2, 3) __warn_result \
+	int \
+	_merge_func(struct stroll_array_power * __restrict     parms, \
+	            char *                                     array, \
+	            struct stroll_array_power_run * __restrict runs, \
+	            unsigned int                               cnt) \
+	{ \
+		stroll_array_power_assert(parms); \
+		stroll_array_assert_intern(array); \
+		stroll_array_assert_intern(runs); \
+		stroll_array_assert_intern(cnt >= 2); \
+		\
+		size_t                          sz = _size; \
+		struct stroll_array_power_run * run = &runs[cnt - 2]; \
+		char *                          fst; \
+		unsigned int                    fst_nr = run[0].nr; \
+		char *                          snd; \
+		unsigned int                    snd_nr = run[1].nr; \
+		unsigned int                    cnt_in; \
+		\
+		stroll_array_assert_intern((run[0].start + fst_nr) == \
+		                           run[1].start); \
+		\
+		run[0].nr += snd_nr; \
+		\
+		fst = &array[run[0].start * sz]; \
+		snd = &array[run[1].start * sz]; \
+		cnt_in = _fwd_func(parms, snd, fst, fst_nr, true); \
+		fst += cnt_in * sz; \
+		fst_nr -= cnt_in; \
+		if (!fst_nr) \
+			return 0; \
+		\
+		snd_nr = _bwd_func(parms, \
+		                   &fst[(fst_nr - 1) * sz], \
+		                   snd, \
+		                   snd_nr, \
+		                   false); \
+		if (!snd_nr) \
+			return 0; \
+		\
+		if (!parms->aux) { \
+			parms->aux = malloc((parms->nr / 2) * sz); \
+			if (!parms->aux) { \
+				run[0].nr -= run[1].nr; \
+				return -errno; \
+			} \
+		} \
+		\
+		if (fst_nr <= snd_nr) \
+			_lo_func(parms, fst, fst_nr, snd, snd_nr); \
+		else \
+			_hi_func(parms, fst, fst_nr, snd, snd_nr); \
+		\
+		return 0; \
+	}
+
+/*
+ * Powersort main loop.
+ *
+ * Input is scanned from left to right to detect natural runs, i.e. maximal
+ * non-descending or strictly descending sequences of elements, the latter
+ * being reversed in-place. Runs shorter than minrun are extended using binary
+ * insertion sort.
+ *
+ * Each time a new run is found, the power of the boundary between the topmost
+ * pending run and the new one is computed. Pending runs separated by
+ * boundaries of greater power are merged before pushing the new run.
+ * This merge policy builds a nearly optimal merge tree with respect to the
+ * entropy of run lengths, giving O(n) time for inputs made of few long runs
+ * and O(n.log(n)) in the worst case.
+ */
+#define STROLL_ARRAY_DEFINE_POWER_SORT(_sort_func, \
+                                       _count_func, \
+                                       _insert_func, \
+                                       _merge_func, \
+                                       _size) \
+	static __stroll_nonull(1, 2) __warn_result \
+	int \
+	_sort_func(struct stroll_array_power * __restrict parms, char * array) \
+	{ \
+		stroll_array_power_assert(parms); \
+		stroll_array_assert_intern(array); \
+		\
+		size_t                        sz = _size; \
+		unsigned int                  nr = parms->nr; \
+		unsigned int                  min; \
+		struct stroll_array_power_run runs[ \
+			STROLL_ARRAY_POWER_RUNS_MAX]; \
+		unsigned int                  cnt = 0; \
+		unsigned int                  start = 0; \
+		int                           ret; \
+		\
+		min = stroll_array_power_minrun(nr); \
+		while (start < nr) { \
+			unsigned int left = nr - start; \
+			char *       run = &array[start * sz]; \
+			unsigned int run_nr; \
+			\
+			run_nr = _count_func(parms, run, left); \
+			if (run_nr < min) { \
+				unsigned int force = stroll_min(min, left); \
+				\
+				_insert_func(parms, run, force, run_nr); \
+				run_nr = force; \
+			} \
+			\
+			if (cnt) { \
+				unsigned int pow; \
+				\
+				pow = stroll_array_power_node( \
+					runs[cnt - 1].start, \
+					runs[cnt - 1].nr, \
+					run_nr, \
+					nr); \
+				while ((cnt > 1) && \
+				       (runs[cnt - 2].power > pow)) { \
+					ret = _merge_func(parms, \
+					                  array, \
+					                  runs, \
+					                  cnt); \
+					if (ret) \
+						return ret; \
+					cnt--; \
+				} \
+				runs[cnt - 1].power = pow; \
+			} \
+			\
+			stroll_array_assert_intern( \
+				cnt < STROLL_ARRAY_POWER_RUNS_MAX); \
+			runs[cnt].start = start; \
+			runs[cnt].nr = run_nr; \
+			cnt++; \
+			\
+			start += run_nr; \
+		} \
+		\
+		while (cnt > 1) { \
+			ret = _merge_func(parms, array, runs, cnt); \
+			if (ret) \
+				return ret; \
+			cnt--; \
+		} \
+		\
+		return 0; \
+	}
+
+#define STROLL_ARRAY_DEFINE_POWER(_sort_func, \
+                                  _count_func, \
+                                  _insert_func, \
+                                  _fwd_func, \
+                                  _bwd_func, \
+                                  _lo_func, \
+                                  _hi_func, \
+                                  _merge_func, \
+                                  _size) \
+	STROLL_ARRAY_DEFINE_POWER_COUNT_RUN(_count_func, _size) \
+	STROLL_ARRAY_DEFINE_POWER_INSERT(_insert_func, _size) \
+	STROLL_ARRAY_DEFINE_POWER_GALLOP(_fwd_func, _bwd_func, _size) \
+	STROLL_ARRAY_DEFINE_POWER_MERGE_LO(_lo_func, _fwd_func, _size) \
+	STROLL_ARRAY_DEFINE_POWER_MERGE_HI(_hi_func, _bwd_func, _size) \
+	STROLL_ARRAY_DEFINE_POWER_MERGE_AT(_merge_func, \
+	                                   _fwd_func, \
+	                                   _bwd_func, \
+	                                   _lo_func, \
+	                                   _hi_func, \
+	                                   _size) \
+	STROLL_ARRAY_DEFINE_POWER_SORT(_sort_func, \
+	                               _count_func, \
+	                               _insert_func, \
+	                               _merge_func, \
+	                               _size)
+
+/*
+ * Instantiate uint32_t / uint64_t sized element variants, where element size
+ * is a compile time constant allowing the compiler to turn single element
+ * copies into plain word moves, as well as a generic variant for arbitrary
+ * element sizes.
+ */
+STROLL_ARRAY_DEFINE_POWER(stroll_array_power_sort32,
+                          stroll_array_power_count_run32,
+                          stroll_array_power_insert32,
+                          stroll_array_power_gallop_fwd32,
+                          stroll_array_power_gallop_bwd32,
+                          stroll_array_power_merge_lo32,
+                          stroll_array_power_merge_hi32,
+                          stroll_array_power_merge_at32,
+                          sizeof(uint32_t))
+
+STROLL_ARRAY_DEFINE_POWER(stroll_array_power_sort64,
+                          stroll_array_power_count_run64,
+                          stroll_array_power_insert64,
+                          stroll_array_power_gallop_fwd64,
+                          stroll_array_power_gallop_bwd64,
+                          stroll_array_power_merge_lo64,
+                          stroll_array_power_merge_hi64,
+                          stroll_array_power_merge_at64,
+                          sizeof(uint64_t))
+
+STROLL_ARRAY_DEFINE_POWER(stroll_array_power_sort_mem,
+                          stroll_array_power_count_run_mem,
+                          stroll_array_power_insert_mem,
+                          stroll_array_power_gallop_fwd_mem,
+                          stroll_array_power_gallop_bwd_mem,
+                          stroll_array_power_merge_lo_mem,
+                          stroll_array_power_merge_hi_mem,
+                          stroll_array_power_merge_at_mem,
+                          parms->size)
+
+int
+stroll_array_power_sort(void * __restrict     array,
+                        unsigned int          nr,
+                        size_t                size,
+                        stroll_array_cmp_fn * compare,
+                        void *                data)
+{
+	stroll_array_assert_api(array);
+	stroll_array_assert_api(nr);
+	stroll_array_assert_api(size);
+	stroll_array_assert_api(compare);
+
+	struct stroll_array_power parms = {
+		.size    = size,
+		.compare = compare,
+		.data    = data,
+		.nr      = nr,
+		.aux     = NULL,
+		.gallop  = STROLL_ARRAY_POWER_MIN_GALLOP
+	};
+	int                       ret;
+
+	if (nr == 1)
+		return 0;
+
+	if (stroll_array_aligned(array, size, sizeof(uint32_t)))
+		ret = stroll_array_power_sort32(&parms, array);
+	else if (stroll_array_aligned(array, size, sizeof(uint64_t)))
+		ret = stroll_array_power_sort64(&parms, array);
+	else
+		ret = stroll_array_power_sort_mem(&parms, array);
+
+	free(parms.aux);
+
+	return ret;
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_POWER_SORT) */
+
+#if defined(CONFIG_STROLL_ARRAY_SORTNET)
+
+/*
+ * Arrays of primitive keys sorting kernels.
+ */
+struct stroll_array_kernels {
+	void (*sortnet_u32)(uint32_t * __restrict keys, unsigned int nr);
+	void (*sortnet_s32)(int32_t * __restrict keys, unsigned int nr);
+	void (*sortnet_u64)(uint64_t * __restrict keys, unsigned int nr);
+#if defined(CONFIG_STROLL_ARRAY_VQUICK_SORT)
+	void (*sort_u32)(uint32_t * __restrict keys,
+	                 unsigned int          nr,
+	                 unsigned int          depth);
+	void (*sort_u64)(uint64_t * __restrict keys,
+	                 unsigned int          nr,
+	                 unsigned int          depth);
+#endif /* defined(CONFIG_STROLL_ARRAY_VQUICK_SORT) */
+};
+
+/*
+ * Scalar kernels.
+ *
+ * For such small key counts, a plain insertion sort comparing keys inline
+ * outperforms a scalar implementation of sorting networks.
+ */
+#define STROLL_ARRAY_DEFINE_SORTNET_SCALAR(_func, _type) \
+	static __stroll_nonull(1) __stroll_nothrow \
+	void \
+	_func(_type * __restrict keys, unsigned int nr) \
+	{ \
+		stroll_array_assert_intern(keys); \
+		stroll_array_assert_intern(nr <= STROLL_ARRAY_SORTNET_MAX); \
+		\
+		unsigned int k; \
+		\
+		for (k = 1; k < nr; k++) { \
+			_type        key = keys[k]; \
+			unsigned int n = k; \
+			\
+			while (n && (keys[n - 1] > key)) { \
+				keys[n] = keys[n - 1]; \
+				n--; \
+			} \
+			\
+			keys[n] = key; \
+		} \
+	}
+
+STROLL_ARRAY_DEFINE_SORTNET_SCALAR(stroll_array_sortnet_u32_scalar, uint32_t)
+STROLL_ARRAY_DEFINE_SORTNET_SCALAR(stroll_array_sortnet_s32_scalar, int32_t)
+STROLL_ARRAY_DEFINE_SORTNET_SCALAR(stroll_array_sortnet_u64_scalar, uint64_t)
+
+#if defined(CONFIG_STROLL_ARRAY_VQUICK_SORT)
+
+/*
+ * Vectorized quick sort.
+ *
+ * Each instruction set gets its own quick sort implementation so that
+ * partitioning and sorting networks kernels are inlined. Keys are compared
+ * inline instead of thanks to a stroll_array_cmp_fn() comparison callback.
+ */
+
+/*
+ * Number of keys above which pivot is selected using Tukey's ninther instead
+ * of median-of-three.
+ */
+#define STROLL_ARRAY_VQUICK_NINTHER_THRESHOLD (128U)
+
+#define STROLL_ARRAY_DEFINE_VQUICK_CMP(_func, _type) \
+	static __stroll_nonull(1, 2) __stroll_pure __stroll_nothrow \
+	int \
+	_func(const void * __restrict first, \
+	      const void * __restrict second, \
+	      void *                  data __unused) \
+	{ \
+		_type fst = *(const _type *)first; \
+		_type snd = *(const _type *)second; \
+		\
+		return (fst > snd) - (fst < snd); \
+	}
+
+STROLL_ARRAY_DEFINE_VQUICK_CMP(stroll_array_vquick_cmp_u32, uint32_t)
+STROLL_ARRAY_DEFINE_VQUICK_CMP(stroll_array_vquick_cmp_u64, uint64_t)
+
+#define STROLL_ARRAY_DEFINE_VQUICK_PIVOT(_med_func, _pivot_func, _type) \
+	static inline __stroll_const __stroll_nothrow \
+	_type \
+	_med_func(_type first, _type second, _type third) \
+	{ \
+		if (first > second) { \
+			_type tmp = first; \
+			\
+			first = second; \
+			second = tmp; \
+		} \
+		\
+		if (second <= third) \
+			return second; \
+		\
+		return (first > third) ? first : third; \
+	} \
+	\
+	static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow \
+	_type \
+	_pivot_func(const _type * __restrict keys, unsigned int nr) \
+	{ \
+		stroll_array_assert_intern(keys); \
+		stroll_array_assert_intern(nr > 2); \
+		\
+		unsigned int mid = nr / 2; \
+		unsigned int last = nr - 1; \
+		unsigned int step; \
+		\
+		if (nr < STROLL_ARRAY_VQUICK_NINTHER_THRESHOLD) \
+			return _med_func(keys[0], keys[mid], keys[last]); \
+		\
+		step = nr / 8; \
+		return _med_func(_med_func(keys[0], \
+		                           keys[step], \
+		                           keys[2 * step]), \
+		                 _med_func(keys[mid - step], \
+		                           keys[mid], \
+		                           keys[mid + step]), \
+		                 _med_func(keys[last - (2 * step)], \
+		                           keys[last - step], \
+		                           keys[last])); \
+	}
+
+STROLL_ARRAY_DEFINE_VQUICK_PIVOT(stroll_array_vquick_med_u32,
+                                 stroll_array_vquick_pivot_u32,
+                                 uint32_t)
+STROLL_ARRAY_DEFINE_VQUICK_PIVOT(stroll_array_vquick_med_u64,
+                                 stroll_array_vquick_pivot_u64,
+                                 uint64_t)
+
+/*
+ * Detect inputs already sorted in either ascending or descending order so that
+ * these are sorted in linear time. Unsorted inputs are usually detected after
+ * inspecting a few keys only.
+ */
+#define STROLL_ARRAY_DEFINE_VQUICK_PRESORTED(_func, _type) \
+	static __stroll_nonull(1) __stroll_nothrow __warn_result \
+	bool \
+	_func(_type * __restrict keys, unsigned int nr) \
+	{ \
+		stroll_array_assert_intern(keys); \
+		stroll_array_assert_intern(nr); \
+		\
+		unsigned int k; \
+		\
+		for (k = 1; (k < nr) && (keys[k - 1] <= keys[k]); k++) \
+			; \
+		if (k == nr) \
+			return true; \
+		\
+		for (k = 1; (k < nr) && (keys[k - 1] >= keys[k]); k++) \
+			; \
+		if (k != nr) \
+			return false; \
+		\
+		for (k = 0; k < (nr / 2); k++) { \
+			_type tmp = keys[k]; \
+			\
+			keys[k] = keys[nr - 1 - k]; \
+			keys[nr - 1 - k] = tmp; \
+		} \
+		\
+		return true; \
+	}
+
+STROLL_ARRAY_DEFINE_VQUICK_PRESORTED(stroll_array_vquick_presorted_u32,
+                                     uint32_t)
+STROLL_ARRAY_DEFINE_VQUICK_PRESORTED(stroll_array_vquick_presorted_u64,
+                                     uint64_t)
+
+/*
+ * Partition keys so that keys lower than or equal to pivot come first, keys
+ * greater than pivot last. Return the number of keys lower than or equal to
+ * pivot.
+ */
+#define STROLL_ARRAY_DEFINE_VQUICK_PART_SCALAR(_func, _type) \
+	static inline __stroll_nonull(1) __stroll_nothrow \
+	unsigned int \
+	_func(_type * __restrict keys, unsigned int nr, _type pivot) \
+	{ \
+		stroll_array_assert_intern(keys); \
+		\
+		unsigned int lo = 0; \
+		unsigned int hi = nr; \
+		\
+		while (true) { \
+			_type tmp; \
+			\
+			while ((lo < hi) && (keys[lo] <= pivot)) \
+				lo++; \
+			while ((lo < hi) && (keys[hi - 1] > pivot)) \
+				hi--; \
+			if (lo >= hi) \
+				return lo; \
+			\
+			tmp = keys[lo]; \
+			keys[lo++] = keys[--hi]; \
+			keys[hi] = tmp; \
+		} \
+	}
+
+STROLL_ARRAY_DEFINE_VQUICK_PART_SCALAR(stroll_array_vquick_part_u32_scalar,
+                                       uint32_t)
+STROLL_ARRAY_DEFINE_VQUICK_PART_SCALAR(stroll_array_vquick_part_u64_scalar,
+                                       uint64_t)
+
+/*
+ * Define a quick sort kernel using the given partitioning and sorting network
+ * kernels.
+ *
+ * Pivot is always one of the keys to sort, meaning that partitioning yields
+ * at least one key lower than or equal to pivot. When no key is greater than
+ * pivot, keys equal to pivot are moved at the end of the partition and skipped
+ * since already sorted. This guarantees progress whatever the number of
+ * duplicate keys.
+ * Recursion depth is bounded by falling back to heap sort as introsort does.
+ */
+#define STROLL_ARRAY_DEFINE_VQUICK_SORT(_func, \
+                                        _attr, \
+                                        _type, \
+                                        _pivot, \
+                                        _part, \
+                                        _sortnet, \
+                                        _cmp) \
+	static _attr __stroll_nonull(1) __stroll_nothrow \
+	void \
+	_func(_type * __restrict keys, unsigned int nr, unsigned int depth) \
+	{ \
+		stroll_array_assert_intern(keys); \
+		stroll_array_assert_intern(nr); \
+		\
+		while (nr > STROLL_ARRAY_SORTNET_MAX) { \
+			_type        pivot; \
+			unsigned int lo; \
+			\
+			if (!depth--) { \
+				stroll_array_fbheap_sort(keys, \
+				                         nr, \
+				                         sizeof(keys[0]), \
+				                         _cmp, \
+				                         NULL); \
+				return; \
+			} \
+			\
+			pivot = _pivot(keys, nr); \
+			lo = _part(keys, nr, pivot); \
+			if (lo == nr) { \
+				if (!pivot) \
+					return; \
+				nr = _part(keys, nr, pivot - 1); \
+				continue; \
+			} \
+			\
+			if (lo < (nr - lo)) { \
+				_func(keys, lo, depth); \
+				keys += lo; \
+				nr -= lo; \
+			} \
+			else { \
+				_func(&keys[lo], nr - lo, depth); \
+				nr = lo; \
+			} \
+		} \
+		\
+		if (nr > 1) \
+			_sortnet(keys, nr); \
+	}
+
+STROLL_ARRAY_DEFINE_VQUICK_SORT(stroll_array_vquick_sort_u32_scalar,
+                                ,
+                                uint32_t,
+                                stroll_array_vquick_pivot_u32,
+                                stroll_array_vquick_part_u32_scalar,
+                                stroll_array_sortnet_u32_scalar,
+                                stroll_array_vquick_cmp_u32)
+STROLL_ARRAY_DEFINE_VQUICK_SORT(stroll_array_vquick_sort_u64_scalar,
+                                ,
+                                uint64_t,
+                                stroll_array_vquick_pivot_u64,
+                                stroll_array_vquick_part_u64_scalar,
+                                stroll_array_sortnet_u64_scalar,
+                                stroll_array_vquick_cmp_u64)
+
+#endif /* defined(CONFIG_STROLL_ARRAY_VQUICK_SORT) */
+
+#if defined(__x86_64__)
+
+#include <immintrin.h>
+
+#define __stroll_array_sse \
+	__attribute__((target("sse4.2")))
+
+#define __stroll_array_avx2 \
+	__attribute__((target("avx2")))
+
+/*
+ * Bitonic sorting networks.
+ *
+ * Keys are padded with the greatest key value up to the network size, i.e. 16
+ * or 32 keys, and loaded into vector registers holding `lanes' keys each.
+ *
+ * Network is made of log2(n) merge stages. Stage k merges bitonic sequences of
+ * k keys by comparing / exchanging keys i and i ^ j for j = k/2, k/4, ..., 1,
+ * in ascending order when i & k is zero, in descending order otherwise:
+ * - when j >= lanes, compared keys are located at the same lane of distinct
+ *   registers, exchanging them requires a single min / max pair ;
+ * - when j < lanes, compared keys are located within the same register, which
+ *   is first permuted to bring them face to face. Lanes receiving the minimum
+ *   are then selected according to a constant mask.
+ */
+
+/*
+ * Evaluate to -1 when the i-th key should receive the minimum of keys i and
+ * i ^ j at stage k, 0 otherwise.
+ */
+#define STROLL_ARRAY_SORTNET_TAKE_MIN(_i, _k, _j) \
+	((!((_i) & (_j)) == !((_i) & (_k))) ? -1 : 0)
+
+/* SSE 4.2 primitives. */
+
+static inline __stroll_array_sse __stroll_const __stroll_nothrow
+__m128i
+stroll_array_sortnet_swap32_sse(__m128i vec, unsigned int j)
+{
+	switch (j) {
+	case 1:
+		return _mm_shuffle_epi32(vec, 0xb1);
+	default:
+		return _mm_shuffle_epi32(vec, 0x4e);
+	}
+}
+
+static inline __stroll_array_sse __stroll_const __stroll_nothrow
+__m128i
+stroll_array_sortnet_swap64_sse(__m128i vec, unsigned int j __unused)
+{
+	return _mm_shuffle_epi32(vec, 0x4e);
+}
+
+static inline __stroll_array_sse __stroll_const __stroll_nothrow
+__m128i
+stroll_array_sortnet_mask32_sse(unsigned int base,
+                               unsigned int k,
+                               unsigned int j)
+{
+	return _mm_setr_epi32(STROLL_ARRAY_SORTNET_TAKE_MIN(base, k, j),
+	                      STROLL_ARRAY_SORTNET_TAKE_MIN(base + 1, k, j),
+	                      STROLL_ARRAY_SORTNET_TAKE_MIN(base + 2, k, j),
+	                      STROLL_ARRAY_SORTNET_TAKE_MIN(base + 3, k, j));
+}
+
+static inline __stroll_array_sse __stroll_const __stroll_nothrow
+__m128i
+stroll_array_sortnet_mask64_sse(unsigned int base,
+                               unsigned int k,
+                               unsigned int j)
+{
+	return _mm_set_epi64x(STROLL_ARRAY_SORTNET_TAKE_MIN(base + 1, k, j),
+	                      STROLL_ARRAY_SORTNET_TAKE_MIN(base, k, j));
+}
+
+static inline __stroll_array_sse __stroll_const __stroll_nothrow
+__m128i
+stroll_array_sortnet_gt_u64_sse(__m128i first, __m128i second)
+{
+	const __m128i sign = _mm_set1_epi64x(INT64_MIN);
+
+	return _mm_cmpgt_epi64(_mm_xor_si128(first, sign),
+	                       _mm_xor_si128(second, sign));
+}
+
+static inline __stroll_array_sse __stroll_const __stroll_nothrow
+__m128i
+stroll_array_sortnet_min_u64_sse(__m128i first, __m128i second)
+{
+	return _mm_blendv_epi8(first,
+	                       second,
+	                       stroll_array_sortnet_gt_u64_sse(first, second));
+}
+
+static inline __stroll_array_sse __stroll_const __stroll_nothrow
+__m128i
+stroll_array_sortnet_max_u64_sse(__m128i first, __m128i second)
+{
+	return _mm_blendv_epi8(second,
+	                       first,
+	                       stroll_array_sortnet_gt_u64_sse(first, second));
+}
+
+/*
+ * Merge lanes of `vec' with their counterparts of `swp': lanes selected by
+ * `mask' receive the minimum, other ones receive the maximum.
+ */
+static inline __stroll_array_sse __stroll_const __stroll_nothrow
+__m128i
+stroll_array_sortnet_merge_u32_sse(__m128i vec, __m128i swp, __m128i mask)
+{
+	return _mm_blendv_epi8(_mm_max_epu32(vec, swp),
+	                       _mm_min_epu32(vec, swp),
+	                       mask);
+}
+
+static inline __stroll_array_sse __stroll_const __stroll_nothrow
+__m128i
+stroll_array_sortnet_merge_s32_sse(__m128i vec, __m128i swp, __m128i mask)
+{
+	return _mm_blendv_epi8(_mm_max_epi32(vec, swp),
+	                       _mm_min_epi32(vec, swp),
+	                       mask);
+}
+
+/*
+ * As there is no 64-bit min / max instructions, keep lanes of `vec' when they
+ * are greater than their `swp' counterparts and the minimum is requested or
+ * the other way around. This saves 2 blending operations.
+ */
+static inline __stroll_array_sse __stroll_const __stroll_nothrow
+__m128i
+stroll_array_sortnet_merge_u64_sse(__m128i vec, __m128i swp, __m128i mask)
+{
+	return _mm_blendv_epi8(
+		swp,
+		vec,
+		_mm_xor_si128(stroll_array_sortnet_gt_u64_sse(vec, swp),
+		              mask));
+}
+
+/* AVX2 primitives. */
+
+static inline __stroll_array_avx2 __stroll_const __stroll_nothrow
+__m256i
+stroll_array_sortnet_swap32_avx2(__m256i vec, unsigned int j)
+{
+	switch (j) {
+	case 1:
+		return _mm256_shuffle_epi32(vec, 0xb1);
+	case 2:
+		return _mm256_shuffle_epi32(vec, 0x4e);
+	default:
+		return _mm256_permute2x128_si256(vec, vec, 0x01);
+	}
+}
+
+static inline __stroll_array_avx2 __stroll_const __stroll_nothrow
+__m256i
+stroll_array_sortnet_swap64_avx2(__m256i vec, unsigned int j)
+{
+	switch (j) {
+	case 1:
+		return _mm256_shuffle_epi32(vec, 0x4e);
+	default:
+		return _mm256_permute2x128_si256(vec, vec, 0x01);
+	}
+}
+
+static inline __stroll_array_avx2 __stroll_const __stroll_nothrow
+__m256i
+stroll_array_sortnet_mask32_avx2(unsigned int base,
+                                 unsigned int k,
+                                 unsigned int j)
+{
+	return _mm256_setr_epi32(STROLL_ARRAY_SORTNET_TAKE_MIN(base, k, j),
+	                         STROLL_ARRAY_SORTNET_TAKE_MIN(base + 1, k, j),
+	                         STROLL_ARRAY_SORTNET_TAKE_MIN(base + 2, k, j),
+	                         STROLL_ARRAY_SORTNET_TAKE_MIN(base + 3, k, j),
+	                         STROLL_ARRAY_SORTNET_TAKE_MIN(base + 4, k, j),
+	                         STROLL_ARRAY_SORTNET_TAKE_MIN(base + 5, k, j),
+	                         STROLL_ARRAY_SORTNET_TAKE_MIN(base + 6, k, j),
+	                         STROLL_ARRAY_SORTNET_TAKE_MIN(base + 7, k, j));
+}
+
+static inline __stroll_array_avx2 __stroll_const __stroll_nothrow
+__m256i
+stroll_array_sortnet_mask64_avx2(unsigned int base,
+                                 unsigned int k,
+                                 unsigned int j)
+{
+	return _mm256_setr_epi64x(
+		STROLL_ARRAY_SORTNET_TAKE_MIN(base, k, j),
+		STROLL_ARRAY_SORTNET_TAKE_MIN(base + 1, k, j),
+		STROLL_ARRAY_SORTNET_TAKE_MIN(base + 2, k, j),
+		STROLL_ARRAY_SORTNET_TAKE_MIN(base + 3, k, j));
+}
+
+static inline __stroll_array_avx2 __stroll_const __stroll_nothrow
+__m256i
+stroll_array_sortnet_gt_u64_avx2(__m256i first, __m256i second)
+{
+	const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+
+	return _mm256_cmpgt_epi64(_mm256_xor_si256(first, sign),
+	                          _mm256_xor_si256(second, sign));
+}
+
+static inline __stroll_array_avx2 __stroll_const __stroll_nothrow
+__m256i
+stroll_array_sortnet_min_u64_avx2(__m256i first, __m256i second)
+{
+	return _mm256_blendv_epi8(first,
+	                          second,
+	                          stroll_array_sortnet_gt_u64_avx2(first,
+	                                                           second));
+}
+
+static inline __stroll_array_avx2 __stroll_const __stroll_nothrow
+__m256i
+stroll_array_sortnet_max_u64_avx2(__m256i first, __m256i second)
+{
+	return _mm256_blendv_epi8(second,
+	                          first,
+	                          stroll_array_sortnet_gt_u64_avx2(first,
+	                                                           second));
+}
+
+static inline __stroll_array_avx2 __stroll_const __stroll_nothrow
+__m256i
+stroll_array_sortnet_merge_u32_avx2(__m256i vec, __m256i swp, __m256i mask)
+{
+	return _mm256_blendv_epi8(_mm256_max_epu32(vec, swp),
+	                          _mm256_min_epu32(vec, swp),
+	                          mask);
+}
+
+static inline __stroll_array_avx2 __stroll_const __stroll_nothrow
+__m256i
+stroll_array_sortnet_merge_s32_avx2(__m256i vec, __m256i swp, __m256i mask)
+{
+	return _mm256_blendv_epi8(_mm256_max_epi32(vec, swp),
+	                          _mm256_min_epi32(vec, swp),
+	                          mask);
+}
+
+static inline __stroll_array_avx2 __stroll_const __stroll_nothrow
+__m256i
+stroll_array_sortnet_merge_u64_avx2(__m256i vec, __m256i swp, __m256i mask)
+{
+	return _mm256_blendv_epi8(
+		swp,
+		vec,
+		_mm256_xor_si256(stroll_array_sortnet_gt_u64_avx2(vec, swp),
+		                 mask));
+}
+
+/*
+ * Run the comparison / exchange step j of merge stage k over `_regs' vector
+ * registers of `_lanes' lanes each.
+ *
+ * Step and stage indices are compile time constants so that the compiler may
+ * select the proper code path, permutation immediate and lanes mask.
+ */
+#define STROLL_ARRAY_SORTNET_STEP(_k, \
+                                  _j, \
+                                  _vec, \
+                                  _regs, \
+                                  _lanes, \
+                                  _min, \
+                                  _max, \
+                                  _merge, \
+                                  _swap, \
+                                  _mask) \
+	do { \
+		unsigned int reg; \
+		\
+		if ((_j) >= (_lanes)) { \
+			_Pragma("GCC unroll 16") \
+			for (reg = 0; reg < (_regs); reg++) { \
+				unsigned int pair = reg ^ ((_j) / (_lanes)); \
+				__typeof__(_vec[0]) lo; \
+				__typeof__(_vec[0]) hi; \
+				\
+				if (pair < reg) \
+					continue; \
+				\
+				lo = _min(_vec[reg], _vec[pair]); \
+				hi = _max(_vec[reg], _vec[pair]); \
+				if (!((reg * (_lanes)) & (_k))) { \
+					_vec[reg] = lo; \
+					_vec[pair] = hi; \
+				} \
+				else { \
+					_vec[reg] = hi; \
+					_vec[pair] = lo; \
+				} \
+			} \
+		} \
+		else { \
+			_Pragma("GCC unroll 16") \
+			for (reg = 0; reg < (_regs); reg++) { \
+				_vec[reg] = _merge(_vec[reg], \
+				                   _swap(_vec[reg], _j), \
+				                   _mask(reg * (_lanes), \
+				                         _k, \
+				                         _j)); \
+			} \
+		} \
+	} while (0)
+
+/* Merge stages of 8 keys bitonic sorting network. */
+#define STROLL_ARRAY_SORTNET_STAGES8(_step, ...) \
+	_step(2, 1, __VA_ARGS__); \
+	_step(4, 2, __VA_ARGS__); \
+	_step(4, 1, __VA_ARGS__); \
+	_step(8, 4, __VA_ARGS__); \
+	_step(8, 2, __VA_ARGS__); \
+	_step(8, 1, __VA_ARGS__)
+
+/* Merge stages of 16 keys bitonic sorting network. */
+#define STROLL_ARRAY_SORTNET_STAGES16(_step, ...) \
+	STROLL_ARRAY_SORTNET_STAGES8(_step, __VA_ARGS__); \
+	_step(16, 8, __VA_ARGS__); \
+	_step(16, 4, __VA_ARGS__); \
+	_step(16, 2, __VA_ARGS__); \
+	_step(16, 1, __VA_ARGS__)
+
+/* Merge stages of 32 keys bitonic sorting network. */
+#define STROLL_ARRAY_SORTNET_STAGES32(_step, ...) \
+	STROLL_ARRAY_SORTNET_STAGES16(_step, __VA_ARGS__); \
+	_step(32, 16, __VA_ARGS__); \
+	_step(32, 8, __VA_ARGS__); \
+	_step(32, 4, __VA_ARGS__); \
+	_step(32, 2, __VA_ARGS__); \
+	_step(32, 1, __VA_ARGS__)
+
+/*
+ * Define a bitonic sorting network kernel for `_nr' keys of type `_type' held
+ * into vector registers of type `_vec' made of `_lanes' lanes.
+ */
+#define STROLL_ARRAY_DEFINE_SORTNET_BITONIC(_func, \
+                                            _attr, \
+                                            _type, \
+                                            _pad, \
+                                            _nr, \
+                                            _stages, \
+                                            _vec, \
+                                            _lanes, \
+                                            _load, \
+                                            _store, \
+                                            _min, \
+                                            _max, \
+                                            _merge, \
+                                            _swap, \
+                                            _mask) \
+	static _attr __stroll_nonull(1) __stroll_nothrow \
+	void \
+	_func(_type * __restrict keys, unsigned int nr) \
+	{ \
+		stroll_array_assert_intern(keys); \
+		stroll_array_assert_intern(nr <= (_nr)); \
+		\
+		_type        buff[_nr]; \
+		_vec         vec[(_nr) / (_lanes)]; \
+		unsigned int r; \
+		\
+		memcpy(buff, keys, nr * sizeof(buff[0])); \
+		for (r = nr; r < (_nr); r++) \
+			buff[r] = _pad; \
+		for (r = 0; r < ((_nr) / (_lanes)); r++) \
+			vec[r] = _load((const _vec *)&buff[r * (_lanes)]); \
+		\
+		_stages(STROLL_ARRAY_SORTNET_STEP, \
+		        vec, \
+		        (_nr) / (_lanes), \
+		        _lanes, \
+		        _min, \
+		        _max, \
+		        _merge, \
+		        _swap, \
+		        _mask); \
+		\
+		for (r = 0; r < ((_nr) / (_lanes)); r++) \
+			_store((_vec *)&buff[r * (_lanes)], vec[r]); \
+		memcpy(keys, buff, nr * sizeof(keys[0])); \
+	}
+
+#define STROLL_ARRAY_DEFINE_SORTNET_SSE(_func, \
+                                        _type, \
+                                        _pad, \
+                                        _nr, \
+                                        _stages, \
+                                        _lanes, \
+                                        _min, \
+                                        _max, \
+                                        _merge, \
+                                        _swap, \
+                                        _mask) \
+	STROLL_ARRAY_DEFINE_SORTNET_BITONIC(_func, \
+	                                    __stroll_array_sse, \
+	                                    _type, \
+	                                    _pad, \
+	                                    _nr, \
+	                                    _stages, \
+	                                    __m128i, \
+	                                    _lanes, \
+	                                    _mm_loadu_si128, \
+	                                    _mm_storeu_si128, \
+	                                    _min, \
+	                                    _max, \
+	                                    _merge, \
+	                                    _swap, \
+	                                    _mask)
+
+#define STROLL_ARRAY_DEFINE_SORTNET_AVX2(_func, \
+                                         _type, \
+                                         _pad, \
+                                         _nr, \
+                                         _stages, \
+                                         _lanes, \
+                                         _min, \
+                                         _max, \
+                                         _merge, \
+                                         _swap, \
+                                         _mask) \
+	STROLL_ARRAY_DEFINE_SORTNET_BITONIC(_func, \
+	                                    __stroll_array_avx2, \
+	                                    _type, \
+	                                    _pad, \
+	                                    _nr, \
+	                                    _stages, \
+	                                    __m256i, \
+	                                    _lanes, \
+	                                    _mm256_loadu_si256, \
+	                                    _mm256_storeu_si256, \
+	                                    _min, \
+	                                    _max, \
+	                                    _merge, \
+	                                    _swap, \
+	                                    _mask)
+
+/*
+ * Define a kernel selecting the smallest network able to sort the given
+ * number of keys.
+ */
+#define STROLL_ARRAY_DEFINE_SORTNET_SELECT(_func, \
+                                           _attr, \
+                                           _type, \
+                                           _net8, \
+                                           _net16, \
+                                           _net32) \
+	static _attr __stroll_nonull(1) __stroll_nothrow \
+	void \
+	_func(_type * __restrict keys, unsigned int nr) \
+	{ \
+		if (nr <= 8) \
+			_net8(keys, nr); \
+		else if (nr <= 16) \
+			_net16(keys, nr); \
+		else \
+			_net32(keys, nr); \
+	}
+
+STROLL_ARRAY_DEFINE_SORTNET_SSE(stroll_array_sortnet8_u32_sse,
+                                uint32_t,
+                                UINT32_MAX,
+                                8,
+                                STROLL_ARRAY_SORTNET_STAGES8,
+                                4,
+                                _mm_min_epu32,
+                                _mm_max_epu32,
+                                stroll_array_sortnet_merge_u32_sse,
+                                stroll_array_sortnet_swap32_sse,
+                                stroll_array_sortnet_mask32_sse)
+STROLL_ARRAY_DEFINE_SORTNET_SSE(stroll_array_sortnet16_u32_sse,
+                                uint32_t,
+                                UINT32_MAX,
+                                16,
+                                STROLL_ARRAY_SORTNET_STAGES16,
+                                4,
+                                _mm_min_epu32,
+                                _mm_max_epu32,
+                                stroll_array_sortnet_merge_u32_sse,
+                                stroll_array_sortnet_swap32_sse,
+                                stroll_array_sortnet_mask32_sse)
+STROLL_ARRAY_DEFINE_SORTNET_SSE(stroll_array_sortnet32_u32_sse,
+                                uint32_t,
+                                UINT32_MAX,
+                                32,
+                                STROLL_ARRAY_SORTNET_STAGES32,
+                                4,
+                                _mm_min_epu32,
+                                _mm_max_epu32,
+                                stroll_array_sortnet_merge_u32_sse,
+                                stroll_array_sortnet_swap32_sse,
+                                stroll_array_sortnet_mask32_sse)
+STROLL_ARRAY_DEFINE_SORTNET_SELECT(stroll_array_sortnet_u32_sse,
+                                   __stroll_array_sse,
+                                   uint32_t,
+                                   stroll_array_sortnet8_u32_sse,
+                                   stroll_array_sortnet16_u32_sse,
+                                   stroll_array_sortnet32_u32_sse)
+
+STROLL_ARRAY_DEFINE_SORTNET_SSE(stroll_array_sortnet8_s32_sse,
+                                int32_t,
+                                INT32_MAX,
+                                8,
+                                STROLL_ARRAY_SORTNET_STAGES8,
+                                4,
+                                _mm_min_epi32,
+                                _mm_max_epi32,
+                                stroll_array_sortnet_merge_s32_sse,
+                                stroll_array_sortnet_swap32_sse,
+                                stroll_array_sortnet_mask32_sse)
+STROLL_ARRAY_DEFINE_SORTNET_SSE(stroll_array_sortnet16_s32_sse,
+                                int32_t,
+                                INT32_MAX,
+                                16,
+                                STROLL_ARRAY_SORTNET_STAGES16,
+                                4,
+                                _mm_min_epi32,
+                                _mm_max_epi32,
+                                stroll_array_sortnet_merge_s32_sse,
+                                stroll_array_sortnet_swap32_sse,
+                                stroll_array_sortnet_mask32_sse)
+STROLL_ARRAY_DEFINE_SORTNET_SSE(stroll_array_sortnet32_s32_sse,
+                                int32_t,
+                                INT32_MAX,
+                                32,
+                                STROLL_ARRAY_SORTNET_STAGES32,
+                                4,
+                                _mm_min_epi32,
+                                _mm_max_epi32,
+                                stroll_array_sortnet_merge_s32_sse,
+                                stroll_array_sortnet_swap32_sse,
+                                stroll_array_sortnet_mask32_sse)
+STROLL_ARRAY_DEFINE_SORTNET_SELECT(stroll_array_sortnet_s32_sse,
+                                   __stroll_array_sse,
+                                   int32_t,
+                                   stroll_array_sortnet8_s32_sse,
+                                   stroll_array_sortnet16_s32_sse,
+                                   stroll_array_sortnet32_s32_sse)
+
+STROLL_ARRAY_DEFINE_SORTNET_SSE(stroll_array_sortnet8_u64_sse,
+                                uint64_t,
+                                UINT64_MAX,
+                                8,
+                                STROLL_ARRAY_SORTNET_STAGES8,
+                                2,
+                                stroll_array_sortnet_min_u64_sse,
+                                stroll_array_sortnet_max_u64_sse,
+                                stroll_array_sortnet_merge_u64_sse,
+                                stroll_array_sortnet_swap64_sse,
+                                stroll_array_sortnet_mask64_sse)
+STROLL_ARRAY_DEFINE_SORTNET_SSE(stroll_array_sortnet16_u64_sse,
+                                uint64_t,
+                                UINT64_MAX,
+                                16,
+                                STROLL_ARRAY_SORTNET_STAGES16,
+                                2,
+                                stroll_array_sortnet_min_u64_sse,
+                                stroll_array_sortnet_max_u64_sse,
+                                stroll_array_sortnet_merge_u64_sse,
+                                stroll_array_sortnet_swap64_sse,
+                                stroll_array_sortnet_mask64_sse)
+STROLL_ARRAY_DEFINE_SORTNET_SSE(stroll_array_sortnet32_u64_sse,
+                                uint64_t,
+                                UINT64_MAX,
+                                32,
+                                STROLL_ARRAY_SORTNET_STAGES32,
+                                2,
+                                stroll_array_sortnet_min_u64_sse,
+                                stroll_array_sortnet_max_u64_sse,
+                                stroll_array_sortnet_merge_u64_sse,
+                                stroll_array_sortnet_swap64_sse,
+                                stroll_array_sortnet_mask64_sse)
+STROLL_ARRAY_DEFINE_SORTNET_SELECT(stroll_array_sortnet_u64_sse,
+                                   __stroll_array_sse,
+                                   uint64_t,
+                                   stroll_array_sortnet8_u64_sse,
+                                   stroll_array_sortnet16_u64_sse,
+                                   stroll_array_sortnet32_u64_sse)
+
+STROLL_ARRAY_DEFINE_SORTNET_AVX2(stroll_array_sortnet8_u32_avx2,
+                                 uint32_t,
+                                 UINT32_MAX,
+                                 8,
+                                 STROLL_ARRAY_SORTNET_STAGES8,
+                                 8,
+                                 _mm256_min_epu32,
+                                 _mm256_max_epu32,
+                                 stroll_array_sortnet_merge_u32_avx2,
+                                 stroll_array_sortnet_swap32_avx2,
+                                 stroll_array_sortnet_mask32_avx2)
+STROLL_ARRAY_DEFINE_SORTNET_AVX2(stroll_array_sortnet16_u32_avx2,
+                                 uint32_t,
+                                 UINT32_MAX,
+                                 16,
+                                 STROLL_ARRAY_SORTNET_STAGES16,
+                                 8,
+                                 _mm256_min_epu32,
+                                 _mm256_max_epu32,
+                                 stroll_array_sortnet_merge_u32_avx2,
+                                 stroll_array_sortnet_swap32_avx2,
+                                 stroll_array_sortnet_mask32_avx2)
+STROLL_ARRAY_DEFINE_SORTNET_AVX2(stroll_array_sortnet32_u32_avx2,
+                                 uint32_t,
+                                 UINT32_MAX,
+                                 32,
+                                 STROLL_ARRAY_SORTNET_STAGES32,
+                                 8,
+                                 _mm256_min_epu32,
+                                 _mm256_max_epu32,
+                                 stroll_array_sortnet_merge_u32_avx2,
+                                 stroll_array_sortnet_swap32_avx2,
+                                 stroll_array_sortnet_mask32_avx2)
+STROLL_ARRAY_DEFINE_SORTNET_SELECT(stroll_array_sortnet_u32_avx2,
+                                   __stroll_array_avx2,
+                                   uint32_t,
+                                   stroll_array_sortnet8_u32_avx2,
+                                   stroll_array_sortnet16_u32_avx2,
+                                   stroll_array_sortnet32_u32_avx2)
+
+STROLL_ARRAY_DEFINE_SORTNET_AVX2(stroll_array_sortnet8_s32_avx2,
+                                 int32_t,
+                                 INT32_MAX,
+                                 8,
+                                 STROLL_ARRAY_SORTNET_STAGES8,
+                                 8,
+                                 _mm256_min_epi32,
+                                 _mm256_max_epi32,
+                                 stroll_array_sortnet_merge_s32_avx2,
+                                 stroll_array_sortnet_swap32_avx2,
+                                 stroll_array_sortnet_mask32_avx2)
+STROLL_ARRAY_DEFINE_SORTNET_AVX2(stroll_array_sortnet16_s32_avx2,
+                                 int32_t,
+                                 INT32_MAX,
+                                 16,
+                                 STROLL_ARRAY_SORTNET_STAGES16,
+                                 8,
+                                 _mm256_min_epi32,
+                                 _mm256_max_epi32,
+                                 stroll_array_sortnet_merge_s32_avx2,
+                                 stroll_array_sortnet_swap32_avx2,
+                                 stroll_array_sortnet_mask32_avx2)
+STROLL_ARRAY_DEFINE_SORTNET_AVX2(stroll_array_sortnet32_s32_avx2,
+                                 int32_t,
+                                 INT32_MAX,
+                                 32,
+                                 STROLL_ARRAY_SORTNET_STAGES32,
+                                 8,
+                                 _mm256_min_epi32,
+                                 _mm256_max_epi32,
+                                 stroll_array_sortnet_merge_s32_avx2,
+                                 stroll_array_sortnet_swap32_avx2,
+                                 stroll_array_sortnet_mask32_avx2)
+STROLL_ARRAY_DEFINE_SORTNET_SELECT(stroll_array_sortnet_s32_avx2,
+                                   __stroll_array_avx2,
+                                   int32_t,
+                                   stroll_array_sortnet8_s32_avx2,
+                                   stroll_array_sortnet16_s32_avx2,
+                                   stroll_array_sortnet32_s32_avx2)
+
+STROLL_ARRAY_DEFINE_SORTNET_AVX2(stroll_array_sortnet8_u64_avx2,
+                                 uint64_t,
+                                 UINT64_MAX,
+                                 8,
+                                 STROLL_ARRAY_SORTNET_STAGES8,
+                                 4,
+                                 stroll_array_sortnet_min_u64_avx2,
+                                 stroll_array_sortnet_max_u64_avx2,
+                                 stroll_array_sortnet_merge_u64_avx2,
+                                 stroll_array_sortnet_swap64_avx2,
+                                 stroll_array_sortnet_mask64_avx2)
+STROLL_ARRAY_DEFINE_SORTNET_AVX2(stroll_array_sortnet16_u64_avx2,
+                                 uint64_t,
+                                 UINT64_MAX,
+                                 16,
+                                 STROLL_ARRAY_SORTNET_STAGES16,
+                                 4,
+                                 stroll_array_sortnet_min_u64_avx2,
+                                 stroll_array_sortnet_max_u64_avx2,
+                                 stroll_array_sortnet_merge_u64_avx2,
+                                 stroll_array_sortnet_swap64_avx2,
+                                 stroll_array_sortnet_mask64_avx2)
+STROLL_ARRAY_DEFINE_SORTNET_AVX2(stroll_array_sortnet32_u64_avx2,
+                                 uint64_t,
+                                 UINT64_MAX,
+                                 32,
+                                 STROLL_ARRAY_SORTNET_STAGES32,
+                                 4,
+                                 stroll_array_sortnet_min_u64_avx2,
+                                 stroll_array_sortnet_max_u64_avx2,
+                                 stroll_array_sortnet_merge_u64_avx2,
+                                 stroll_array_sortnet_swap64_avx2,
+                                 stroll_array_sortnet_mask64_avx2)
+STROLL_ARRAY_DEFINE_SORTNET_SELECT(stroll_array_sortnet_u64_avx2,
+                                   __stroll_array_avx2,
+                                   uint64_t,
+                                   stroll_array_sortnet8_u64_avx2,
+                                   stroll_array_sortnet16_u64_avx2,
+                                   stroll_array_sortnet32_u64_avx2)
+
+#if defined(CONFIG_STROLL_ARRAY_VQUICK_SORT)
+
+#define __stroll_array_avx512 \
+	__attribute__((target("avx512f")))
+
+/*
+ * In-place vectorized partitioning.
+ *
+ * Vectors of `_lanes' keys are loaded, compared to pivot and permuted so that
+ * keys lower than or equal to pivot come first, keys greater than pivot last.
+ * Permuted vectors are then stored twice: once at the left write position and
+ * once at the right write position, each of which is then advanced by the
+ * number of keys that belong to its side.
+ *
+ * Full vector stores overwrite keys next to write positions. To prevent
+ * from overwriting keys not yet partitioned, the first and last vectors are
+ * loaded and set aside before the main loop starts, leaving room for one
+ * vector on each side. Subsequent vectors are loaded from the side where
+ * the least room is left, which guarantees both sides always have room for
+ * one full vector store. Remaining keys are partitioned by scalar code, then
+ * set aside vectors are finally stored into the exact room left.
+ */
+#define STROLL_ARRAY_DEFINE_VQUICK_PART(_func, \
+                                        _attr, \
+                                        _type, \
+                                        _vec, \
+                                        _lanes, \
+                                        _load, \
+                                        _store, \
+                                        _bcast, \
+                                        _split, \
+                                        _scalar) \
+	static inline _attr __stroll_nonull(1) __stroll_nothrow \
+	unsigned int \
+	_func(_type * __restrict keys, unsigned int nr, _type pivot) \
+	{ \
+		stroll_array_assert_intern(keys); \
+		\
+		_vec         pvt; \
+		_vec         first; \
+		_vec         last; \
+		_type        tail[_lanes]; \
+		unsigned int rd_lo = (_lanes); \
+		unsigned int rd_hi = nr - (_lanes); \
+		unsigned int wr_lo = 0; \
+		unsigned int wr_hi = nr; \
+		unsigned int cnt; \
+		unsigned int k; \
+		\
+		if (nr < (2 * (_lanes))) \
+			return _scalar(keys, nr, pivot); \
+		\
+		pvt = _bcast(pivot); \
+		first = _load((const _vec *)&keys[0]); \
+		last = _load((const _vec *)&keys[rd_hi]); \
+		\
+		while ((rd_hi - rd_lo) >= (_lanes)) { \
+			_vec vec; \
+			\
+			if ((rd_lo - wr_lo) <= (wr_hi - rd_hi)) { \
+				vec = _load((const _vec *)&keys[rd_lo]); \
+				rd_lo += (_lanes); \
+			} \
+			else { \
+				rd_hi -= (_lanes); \
+				vec = _load((const _vec *)&keys[rd_hi]); \
+			} \
+			\
+			vec = _split(vec, pvt, &cnt); \
+			_store((_vec *)&keys[wr_lo], vec); \
+			_store((_vec *)&keys[wr_hi - (_lanes)], vec); \
+			wr_lo += (_lanes) - cnt; \
+			wr_hi -= cnt; \
+		} \
+		\
+		cnt = rd_hi - rd_lo; \
+		memcpy(tail, &keys[rd_lo], cnt * sizeof(tail[0])); \
+		for (k = 0; k < cnt; k++) { \
+			if (tail[k] > pivot) \
+				keys[--wr_hi] = tail[k]; \
+			else \
+				keys[wr_lo++] = tail[k]; \
+		} \
+		\
+		first = _split(first, pvt, &cnt); \
+		_store((_vec *)&keys[wr_lo], first); \
+		_store((_vec *)&keys[wr_hi - (_lanes)], first); \
+		wr_lo += (_lanes) - cnt; \
+		\
+		last = _split(last, pvt, &cnt); \
+		_store((_vec *)&keys[wr_lo], last); \
+		\
+		return wr_lo + (_lanes) - cnt; \
+	}
+
+/*
+ * AVX2 partitioning primitives.
+ *
+ * AVX2 lacks a compress instruction: vectors are permuted according to
+ * indices fetched from a table indexed by the comparison mask. Each table
+ * entry encodes 8 x 3-bit 32-bit lane indices into 8 nibbles.
+ */
+static uint32_t stroll_array_vquick_perm32[1U << 8];
+static uint32_t stroll_array_vquick_perm64[1U << 4];
+
+/*
+ * Build permutation table for vectors of `lanes' keys, each key spanning
+ * `width' 32-bit lanes.
+ */
+static __stroll_nonull(1) __stroll_nothrow
+void
+stroll_array_vquick_build_perm(uint32_t * __restrict perm,
+                               unsigned int          lanes,
+                               unsigned int          width)
+{
+	stroll_array_assert_intern(perm);
+	stroll_array_assert_intern((lanes * width) == 8);
+
+	unsigned int msk;
+
+	for (msk = 0; msk < (1U << lanes); msk++) {
+		uint32_t     ent = 0;
+		unsigned int out = 0;
+		unsigned int gt;
+
+		for (gt = 0; gt <= 1; gt++) {
+			unsigned int l;
+
+			for (l = 0; l < lanes; l++) {
+				unsigned int w;
+
+				if (!!(msk & (1U << l)) != gt)
+					continue;
+
+				for (w = 0; w < width; w++, out++)
+					ent |= ((l * width) + w) << (out * 4);
+			}
+		}
+
+		perm[msk] = ent;
+	}
+}
+
+static inline __stroll_array_avx2 __stroll_pure __stroll_nothrow
+__m256i
+stroll_array_vquick_perm_avx2(__m256i vec, uint32_t ent)
+{
+	const __m256i shift = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+
+	/* Permutation only considers the 3 lowest bits of each index. */
+	return _mm256_permutevar8x32_epi32(
+		vec,
+		_mm256_srlv_epi32(_mm256_set1_epi32((int)ent), shift));
+}
+
+static inline __stroll_array_avx2 __stroll_const __stroll_nothrow
+__m256i
+stroll_array_vquick_bcast_u32_avx2(uint32_t pivot)
+{
+	/* Bias pivot so that signed comparisons order unsigned keys. */
+	return _mm256_set1_epi32((int)(pivot ^ UINT32_C(0x80000000)));
+}
+
+static inline __stroll_array_avx2 __stroll_nonull(3) __stroll_nothrow
+__m256i
+stroll_array_vquick_split_u32_avx2(__m256i                 vec,
+                                   __m256i                 pivot,
+                                   unsigned int * __restrict nr)
+{
+	const __m256i bias = _mm256_set1_epi32(INT32_MIN);
+	__m256i       gt;
+	unsigned int  msk;
+
+	gt = _mm256_cmpgt_epi32(_mm256_xor_si256(vec, bias), pivot);
+	msk = (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(gt));
+	*nr = (unsigned int)__builtin_popcount(msk);
+
+	return stroll_array_vquick_perm_avx2(vec,
+	                                     stroll_array_vquick_perm32[msk]);
+}
+
+static inline __stroll_array_avx2 __stroll_const __stroll_nothrow
+__m256i
+stroll_array_vquick_bcast_u64_avx2(uint64_t pivot)
+{
+	return _mm256_set1_epi64x((long long)(pivot ^ (UINT64_C(1) << 63)));
+}
+
+static inline __stroll_array_avx2 __stroll_nonull(3) __stroll_nothrow
+__m256i
+stroll_array_vquick_split_u64_avx2(__m256i                 vec,
+                                   __m256i                 pivot,
+                                   unsigned int * __restrict nr)
+{
+	const __m256i bias = _mm256_set1_epi64x(INT64_MIN);
+	__m256i       gt;
+	unsigned int  msk;
+
+	gt = _mm256_cmpgt_epi64(_mm256_xor_si256(vec, bias), pivot);
+	msk = (unsigned int)_mm256_movemask_pd(_mm256_castsi256_pd(gt));
+	*nr = (unsigned int)__builtin_popcount(msk);
+
+	return stroll_array_vquick_perm_avx2(vec,
+	                                     stroll_array_vquick_perm64[msk]);
+}
+
+/*
+ * AVX-512 partitioning primitives.
+ *
+ * Keys lower than or equal to pivot are compressed into the lowest lanes, keys
+ * greater than pivot are expanded into the highest lanes. Note that compress
+ * is performed into registers since compressing stores to memory are
+ * microcoded, hence very slow, on some CPUs.
+ */
+static inline __stroll_array_avx512 __stroll_const __stroll_nothrow
+__m512i
+stroll_array_vquick_bcast_u32_avx512(uint32_t pivot)
+{
+	return _mm512_set1_epi32((int)pivot);
+}
+
+static inline __stroll_array_avx512 __stroll_nonull(3) __stroll_nothrow
+__m512i
+stroll_array_vquick_split_u32_avx512(__m512i                 vec,
+                                     __m512i                 pivot,
+                                     unsigned int * __restrict nr)
+{
+	__mmask16    gt = _mm512_cmpgt_epu32_mask(vec, pivot);
+	unsigned int cnt = (unsigned int)__builtin_popcount(gt);
+
+	*nr = cnt;
+
+	return _mm512_mask_expand_epi32(
+		_mm512_maskz_compress_epi32((__mmask16)~gt, vec),
+		(__mmask16)(0xffffU << (16 - cnt)),
+		_mm512_maskz_compress_epi32(gt, vec));
+}
+
+static inline __stroll_array_avx512 __stroll_const __stroll_nothrow
+__m512i
+stroll_array_vquick_bcast_u64_avx512(uint64_t pivot)
+{
+	return _mm512_set1_epi64((long long)pivot);
+}
+
+static inline __stroll_array_avx512 __stroll_nonull(3) __stroll_nothrow
+__m512i
+stroll_array_vquick_split_u64_avx512(__m512i                 vec,
+                                     __m512i                 pivot,
+                                     unsigned int * __restrict nr)
+{
+	__mmask8     gt = _mm512_cmpgt_epu64_mask(vec, pivot);
+	unsigned int cnt = (unsigned int)__builtin_popcount(gt);
+
+	*nr = cnt;
+
+	return _mm512_mask_expand_epi64(
+		_mm512_maskz_compress_epi64((__mmask8)~gt, vec),
+		(__mmask8)(0xffU << (8 - cnt)),
+		_mm512_maskz_compress_epi64(gt, vec));
+}
+
+static inline __stroll_array_avx512 __stroll_pure __stroll_nothrow
+__m512i
+stroll_array_vquick_load_avx512(const __m512i * __restrict addr)
+{
+	return _mm512_loadu_si512(addr);
+}
+
+static inline __stroll_array_avx512 __stroll_nothrow
+void
+stroll_array_vquick_store_avx512(__m512i * __restrict addr, __m512i vec)
+{
+	_mm512_storeu_si512(addr, vec);
+}
+
+STROLL_ARRAY_DEFINE_VQUICK_PART(stroll_array_vquick_part_u32_avx2,
+                                __stroll_array_avx2,
+                                uint32_t,
+                                __m256i,
+                                8,
+                                _mm256_loadu_si256,
+                                _mm256_storeu_si256,
+                                stroll_array_vquick_bcast_u32_avx2,
+                                stroll_array_vquick_split_u32_avx2,
+                                stroll_array_vquick_part_u32_scalar)
+STROLL_ARRAY_DEFINE_VQUICK_PART(stroll_array_vquick_part_u64_avx2,
+                                __stroll_array_avx2,
+                                uint64_t,
+                                __m256i,
+                                4,
+                                _mm256_loadu_si256,
+                                _mm256_storeu_si256,
+                                stroll_array_vquick_bcast_u64_avx2,
+                                stroll_array_vquick_split_u64_avx2,
+                                stroll_array_vquick_part_u64_scalar)
+STROLL_ARRAY_DEFINE_VQUICK_PART(stroll_array_vquick_part_u32_avx512,
+                                __stroll_array_avx512,
+                                uint32_t,
+                                __m512i,
+                                16,
+                                stroll_array_vquick_load_avx512,
+                                stroll_array_vquick_store_avx512,
+                                stroll_array_vquick_bcast_u32_avx512,
+                                stroll_array_vquick_split_u32_avx512,
+                                stroll_array_vquick_part_u32_scalar)
+STROLL_ARRAY_DEFINE_VQUICK_PART(stroll_array_vquick_part_u64_avx512,
+                                __stroll_array_avx512,
+                                uint64_t,
+                                __m512i,
+                                8,
+                                stroll_array_vquick_load_avx512,
+                                stroll_array_vquick_store_avx512,
+                                stroll_array_vquick_bcast_u64_avx512,
+                                stroll_array_vquick_split_u64_avx512,
+                                stroll_array_vquick_part_u64_scalar)
+
+/*
+ * SSE 4.2 kernels rely upon scalar partitioning: lacking both a compress
+ * instruction and a cross lane variable permutation, SSE partitioning does not
+ * perform significantly better.
+ */
+STROLL_ARRAY_DEFINE_VQUICK_SORT(stroll_array_vquick_sort_u32_sse,
+                                __stroll_array_sse,
+                                uint32_t,
+                                stroll_array_vquick_pivot_u32,
+                                stroll_array_vquick_part_u32_scalar,
+                                stroll_array_sortnet_u32_sse,
+                                stroll_array_vquick_cmp_u32)
+STROLL_ARRAY_DEFINE_VQUICK_SORT(stroll_array_vquick_sort_u64_sse,
+                                __stroll_array_sse,
+                                uint64_t,
+                                stroll_array_vquick_pivot_u64,
+                                stroll_array_vquick_part_u64_scalar,
+                                stroll_array_sortnet_u64_sse,
+                                stroll_array_vquick_cmp_u64)
+
+STROLL_ARRAY_DEFINE_VQUICK_SORT(stroll_array_vquick_sort_u32_avx2,
+                                __stroll_array_avx2,
+                                uint32_t,
+                                stroll_array_vquick_pivot_u32,
+                                stroll_array_vquick_part_u32_avx2,
+                                stroll_array_sortnet_u32_avx2,
+                                stroll_array_vquick_cmp_u32)
+STROLL_ARRAY_DEFINE_VQUICK_SORT(stroll_array_vquick_sort_u64_avx2,
+                                __stroll_array_avx2,
+                                uint64_t,
+                                stroll_array_vquick_pivot_u64,
+                                stroll_array_vquick_part_u64_avx2,
+                                stroll_array_sortnet_u64_avx2,
+                                stroll_array_vquick_cmp_u64)
+
+/* AVX-512 kernels rely upon AVX2 sorting networks. */
+STROLL_ARRAY_DEFINE_VQUICK_SORT(stroll_array_vquick_sort_u32_avx512,
+                                __stroll_array_avx512,
+                                uint32_t,
+                                stroll_array_vquick_pivot_u32,
+                                stroll_array_vquick_part_u32_avx512,
+                                stroll_array_sortnet_u32_avx2,
+                                stroll_array_vquick_cmp_u32)
+STROLL_ARRAY_DEFINE_VQUICK_SORT(stroll_array_vquick_sort_u64_avx512,
+                                __stroll_array_avx512,
+                                uint64_t,
+                                stroll_array_vquick_pivot_u64,
+                                stroll_array_vquick_part_u64_avx512,
+                                stroll_array_sortnet_u64_avx2,
+                                stroll_array_vquick_cmp_u64)
+
+#endif /* defined(CONFIG_STROLL_ARRAY_VQUICK_SORT) */
+
+static const struct stroll_array_kernels
+stroll_array_all_kernels[] = {
+	[STROLL_ARRAY_SCALAR_ISA] = {
+		.sortnet_u32 = stroll_array_sortnet_u32_scalar,
+		.sortnet_s32 = stroll_array_sortnet_s32_scalar,
+		.sortnet_u64 = stroll_array_sortnet_u64_scalar,
+#if defined(CONFIG_STROLL_ARRAY_VQUICK_SORT)
+		.sort_u32    = stroll_array_vquick_sort_u32_scalar,
+		.sort_u64    = stroll_array_vquick_sort_u64_scalar
+#endif /* defined(CONFIG_STROLL_ARRAY_VQUICK_SORT) */
+	},
+	[STROLL_ARRAY_SSE_ISA] = {
+		.sortnet_u32 = stroll_array_sortnet_u32_sse,
+		.sortnet_s32 = stroll_array_sortnet_s32_sse,
+		.sortnet_u64 = stroll_array_sortnet_u64_sse,
+#if defined(CONFIG_STROLL_ARRAY_VQUICK_SORT)
+		.sort_u32    = stroll_array_vquick_sort_u32_sse,
+		.sort_u64    = stroll_array_vquick_sort_u64_sse
+#endif /* defined(CONFIG_STROLL_ARRAY_VQUICK_SORT) */
+	},
+	[STROLL_ARRAY_AVX2_ISA] = {
+		.sortnet_u32 = stroll_array_sortnet_u32_avx2,
+		.sortnet_s32 = stroll_array_sortnet_s32_avx2,
+		.sortnet_u64 = stroll_array_sortnet_u64_avx2,
+#if defined(CONFIG_STROLL_ARRAY_VQUICK_SORT)
+		.sort_u32    = stroll_array_vquick_sort_u32_avx2,
+		.sort_u64    = stroll_array_vquick_sort_u64_avx2
+#endif /* defined(CONFIG_STROLL_ARRAY_VQUICK_SORT) */
+	},
+	/* There is no AVX-512 sorting network: use AVX2 ones. */
+	[STROLL_ARRAY_AVX512_ISA] = {
+		.sortnet_u32 = stroll_array_sortnet_u32_avx2,
+		.sortnet_s32 = stroll_array_sortnet_s32_avx2,
+		.sortnet_u64 = stroll_array_sortnet_u64_avx2,
+#if defined(CONFIG_STROLL_ARRAY_VQUICK_SORT)
+		.sort_u32    = stroll_array_vquick_sort_u32_avx512,
+		.sort_u64    = stroll_array_vquick_sort_u64_avx512
+#endif /* defined(CONFIG_STROLL_ARRAY_VQUICK_SORT) */
+	}
+};
+
+static __stroll_nothrow __warn_result
+bool
+stroll_array_probe_isa(enum stroll_array_isa isa)
+{
+	__builtin_cpu_init();
+
+	switch (isa) {
+	case STROLL_ARRAY_SCALAR_ISA:
+		return true;
+	case STROLL_ARRAY_SSE_ISA:
+		return __builtin_cpu_supports("sse4.2");
+	case STROLL_ARRAY_AVX2_ISA:
+		return __builtin_cpu_supports("avx2");
+	case STROLL_ARRAY_AVX512_ISA:
+		return __builtin_cpu_supports("avx512f");
+	default:
+		return false;
+	}
+}
+
+#else  /* !defined(__x86_64__) */
+
+static const struct stroll_array_kernels
+stroll_array_all_kernels[] = {
+	[STROLL_ARRAY_SCALAR_ISA] = {
+		.sortnet_u32 = stroll_array_sortnet_u32_scalar,
+		.sortnet_s32 = stroll_array_sortnet_s32_scalar,
+		.sortnet_u64 = stroll_array_sortnet_u64_scalar,
+#if defined(CONFIG_STROLL_ARRAY_VQUICK_SORT)
+		.sort_u32    = stroll_array_vquick_sort_u32_scalar,
+		.sort_u64    = stroll_array_vquick_sort_u64_scalar
+#endif /* defined(CONFIG_STROLL_ARRAY_VQUICK_SORT) */
+	}
+};
+
+static __stroll_nothrow __warn_result
+bool
+stroll_array_probe_isa(enum stroll_array_isa isa)
+{
+	return isa == STROLL_ARRAY_SCALAR_ISA;
+}
+
+#endif /* defined(__x86_64__) */
+
+static const struct stroll_array_kernels *
+stroll_array_kernels =
+	&stroll_array_all_kernels[STROLL_ARRAY_SCALAR_ISA];
+
+static enum stroll_array_isa stroll_array_isa = STROLL_ARRAY_SCALAR_ISA;
+
+enum stroll_array_isa
+stroll_array_get_isa(void)
+{
+	return stroll_array_isa;
+}
+
+int
+stroll_array_select_isa(enum stroll_array_isa isa)
+{
+	stroll_array_assert_api(isa >= 0);
+	stroll_array_assert_api(isa < STROLL_ARRAY_ISA_NR);
+
+	if (!stroll_array_probe_isa(isa))
+		return -ENOTSUP;
+
+	stroll_array_kernels = &stroll_array_all_kernels[isa];
+	stroll_array_isa = isa;
+
+	return 0;
+}
+
+/* Select the most capable kernels supported by the CPU at load time. */
+static __ctor(101) __stroll_nothrow
+void
+stroll_array_init_kernels(void)
+{
+	int isa;
+
+#if defined(CONFIG_STROLL_ARRAY_VQUICK_SORT) && defined(__x86_64__)
+	stroll_array_vquick_build_perm(stroll_array_vquick_perm32, 8, 1);
+	stroll_array_vquick_build_perm(stroll_array_vquick_perm64, 4, 2);
+#endif /* defined(CONFIG_STROLL_ARRAY_VQUICK_SORT) && defined(__x86_64__) */
+
+	for (isa = STROLL_ARRAY_ISA_NR - 1;
+	     isa > STROLL_ARRAY_SCALAR_ISA;
+	     isa--)
+		if (!stroll_array_select_isa((enum stroll_array_isa)isa))
+			break;
+}
+
+void
+stroll_array_sortnet_u32(uint32_t * __restrict keys, unsigned int nr)
+{
+	stroll_array_assert_api(keys);
+	stroll_array_assert_api(nr);
+	stroll_array_assert_api(nr <= STROLL_ARRAY_SORTNET_MAX);
+
+	if (nr == 1)
+		return;
+
+	stroll_array_kernels->sortnet_u32(keys, nr);
+}
+
+void
+stroll_array_sortnet_s32(int32_t * __restrict keys, unsigned int nr)
+{
+	stroll_array_assert_api(keys);
+	stroll_array_assert_api(nr);
+	stroll_array_assert_api(nr <= STROLL_ARRAY_SORTNET_MAX);
+
+	if (nr == 1)
+		return;
+
+	stroll_array_kernels->sortnet_s32(keys, nr);
+}
+
+void
+stroll_array_sortnet_u64(uint64_t * __restrict keys, unsigned int nr)
+{
+	stroll_array_assert_api(keys);
+	stroll_array_assert_api(nr);
+	stroll_array_assert_api(nr <= STROLL_ARRAY_SORTNET_MAX);
+
+	if (nr == 1)
+		return;
+
+	stroll_array_kernels->sortnet_u64(keys, nr);
+}
+
+#if defined(CONFIG_STROLL_ARRAY_VQUICK_SORT)
+
+/*
+ * Return the maximum recursion depth vectorized quick sort may reach before
+ * falling back to heap sort, i.e. 2 * floor(log2(nr)).
+ */
+static __stroll_const __stroll_nothrow __warn_result
+unsigned int
+stroll_array_vquick_depth(unsigned int nr)
+{
+	stroll_array_assert_intern(nr);
+
+	return 2 * (stroll_bops_fls(nr) - 1);
+}
+
+void
+stroll_array_sort_u32(uint32_t * __restrict keys, unsigned int nr)
+{
+	stroll_array_assert_api(keys);
+	stroll_array_assert_api(nr);
+
+	if (stroll_array_vquick_presorted_u32(keys, nr))
+		return;
+
+	stroll_array_kernels->sort_u32(keys,
+	                               nr,
+	                               stroll_array_vquick_depth(nr));
+}
+
+void
+stroll_array_sort_u64(uint64_t * __restrict keys, unsigned int nr)
+{
+	stroll_array_assert_api(keys);
+	stroll_array_assert_api(nr);
+
+	if (stroll_array_vquick_presorted_u64(keys, nr))
+		return;
+
+	stroll_array_kernels->sort_u64(keys,
+	                               nr,
+	                               stroll_array_vquick_depth(nr));
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_VQUICK_SORT) */
+
+#endif /* defined(CONFIG_STROLL_ARRAY_SORTNET) */
+
+#if defined(CONFIG_STROLL_ARRAY_RADIX_SORT)
+
+#if CONFIG_STROLL_ARRAY_RADIX_SORT_INSERT_THRESHOLD < 2
+#error Invalid MSD radix sort insertion threshold !
+#endif /* CONFIG_STROLL_ARRAY_RADIX_SORT_INSERT_THRESHOLD < 2 */
+
+#define STROLL_RADIX_INSERT_THRESHOLD \
+	STROLL_CONCAT(CONFIG_STROLL_ARRAY_RADIX_SORT_INSERT_THRESHOLD, U)
+
+/* Keys are processed one byte-sized digit at a time. */
+#define STROLL_RADIX_DIGIT_BITS (8U)
+#define STROLL_RADIX_DIGIT_NR   (1U << STROLL_RADIX_DIGIT_BITS)
+#define STROLL_RADIX_DIGIT_MASK (STROLL_RADIX_DIGIT_NR - 1)
+
+struct stroll_array_radix {
+	size_t size;
+	size_t off;
+	size_t ksz;
+};
+
+#define stroll_array_radix_assert(_parms) \
+	stroll_array_assert_intern(_parms); \
+	stroll_array_assert_intern((_parms)->size); \
+	stroll_array_assert_intern(((_parms)->off + (_parms)->ksz) <= \
+	                           (_parms)->size)
+
+/*
+ * Fetch the unsigned integer key of size `ksz' located at offset `off' from
+ * `elem' start. Key may be misaligned.
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow
+uint64_t
+stroll_array_radix_key(const char * __restrict elem, size_t off, size_t ksz)
+{
+	stroll_array_assert_intern(elem);
+
+	switch (ksz) {
+	case sizeof(uint8_t):
+		return (uint8_t)elem[off];
+
+	case sizeof(uint16_t):
+		{
+			uint16_t key;
+
+			memcpy(&key, &elem[off], sizeof(key));
+			return key;
+		}
+
+	case sizeof(uint32_t):
+		{
+			uint32_t key;
+
+			memcpy(&key, &elem[off], sizeof(key));
+			return key;
+		}
+
+	case sizeof(uint64_t):
+		{
+			uint64_t key;
+
+			memcpy(&key, &elem[off], sizeof(key));
+			return key;
+		}
+
+	default:
+		stroll_array_assert_intern(0);
+	}
+
+	unreachable();
+}
+
+static inline __stroll_const __stroll_nothrow
+unsigned int
+stroll_array_radix_digit(uint64_t key, unsigned int digit)
+{
+	return (unsigned int)(key >> (digit * STROLL_RADIX_DIGIT_BITS)) &
+	       STROLL_RADIX_DIGIT_MASK;
+}
+
+/*
+ * Turn the digit histogram given in argument into an array of bucket start
+ * offsets.
+ *
+ * Return true when all keys hold the same digit value, meaning that the digit
+ * may be skipped altogether.
+ */
+static __stroll_nonull(1) __stroll_nothrow
+bool
+stroll_array_radix_scan(unsigned int * __restrict hist, unsigned int nr)
+{
+	unsigned int d;
+	unsigned int sum = 0;
+
+	for (d = 0; d < STROLL_RADIX_DIGIT_NR; d++) {
+		unsigned int cnt = hist[d];
+
+		if (cnt == nr)
+			return true;
+
+		hist[d] = sum;
+		sum += cnt;
+	}
+
+	return false;
+}
+
+#define STROLL_ARRAY_DEFINE_RADIX_LSD_SORT(_sort_func, _type) \
+	static __stroll_nonull(1, 2, 4) \
+	void \
+	_sort_func(_type * __restrict                           array, \
+	           _type * __restrict                           aux, \
+	           unsigned int                                 nr, \
+	           const struct stroll_array_radix * __restrict parms) \
+	{ \
+		stroll_array_assert_intern(array); \
+		stroll_array_assert_intern(aux); \
+		stroll_array_assert_intern(nr > 1); \
+		stroll_array_radix_assert(parms); \
+		stroll_array_assert_intern(parms->size == sizeof(_type)); \
+		\
+		unsigned int hist[sizeof(uint64_t)][STROLL_RADIX_DIGIT_NR]; \
+		unsigned int dnr = (unsigned int)parms->ksz; \
+		_type *      src = array; \
+		_type *      dst = aux; \
+		unsigned int d; \
+		unsigned int e; \
+		\
+		memset(hist, 0, dnr * sizeof(hist[0])); \
+		for (e = 0; e < nr; e++) { \
+			uint64_t key = stroll_array_radix_key( \
+				(const char *)&array[e], \
+				parms->off, \
+				parms->ksz); \
+			\
+			for (d = 0; d < dnr; d++) \
+				hist[d][stroll_array_radix_digit(key, d)]++; \
+		} \
+		\
+		for (d = 0; d < dnr; d++) { \
+			unsigned int * offs = hist[d]; \
+			_type *        tmp; \
+			\
+			if (stroll_array_radix_scan(offs, nr)) \
+				continue; \
+			\
+			for (e = 0; e < nr; e++) { \
+				uint64_t     key = stroll_array_radix_key( \
+					(const char *)&src[e], \
+					parms->off, \
+					parms->ksz); \
+				unsigned int b; \
+				\
+				b = stroll_array_radix_digit(key, d); \
+				dst[offs[b]++] = src[e]; \
+			} \
+			\
+			tmp = src; \
+			src = dst; \
+			dst = tmp; \
+		} \
+		\
+		if (src != array) \
+			memcpy(array, src, nr * sizeof(_type)); \
+	}
+
+STROLL_ARRAY_DEFINE_RADIX_LSD_SORT(stroll_array_radix_sort32, uint32_t)
+
+STROLL_ARRAY_DEFINE_RADIX_LSD_SORT(stroll_array_radix_sort64, uint64_t)
+
+/*
+ * Least significant digit radix sort.
+ *
+ * Keys are processed one digit at a time starting from the least significant
+ * one. For each digit, elements are stably distributed into an auxiliary array
+ * according to the digit value, then both arrays are swapped for the next pass.
+ *
+ * Histograms for all digits are computed with one single initial pass over
+ * input elements. Digits for which all keys hold the same value are skipped,
+ * saving a full distribution pass for keys whose most significant bytes are
+ * unused.
+ *
+ * Complexity is O(w.n) in time, where w is the key width in bytes, and O(n) in
+ * auxiliary space.
+ */
+static __stroll_nonull(1, 2, 4)
+void
+stroll_array_radix_sort_mem(char * __restrict                            array,
+                            char * __restrict                            aux,
+                            unsigned int                                 nr,
+                            const struct stroll_array_radix * __restrict parms)
+{
+	stroll_array_assert_intern(array);
+	stroll_array_assert_intern(aux);
+	stroll_array_assert_intern(nr > 1);
+	stroll_array_radix_assert(parms);
+
+	unsigned int hist[sizeof(uint64_t)][STROLL_RADIX_DIGIT_NR];
+	unsigned int dnr = (unsigned int)parms->ksz;
+	size_t       sz = parms->size;
+	char *       src = array;
+	char *       dst = aux;
+	unsigned int d;
+	unsigned int e;
+
+	memset(hist, 0, dnr * sizeof(hist[0]));
+	for (e = 0; e < nr; e++) {
+		uint64_t key = stroll_array_radix_key(&array[e * sz],
+		                                      parms->off,
+		                                      parms->ksz);
+
+		for (d = 0; d < dnr; d++)
+			hist[d][stroll_array_radix_digit(key, d)]++;
+	}
 
-		run = part1;
-		do {
-			if (parms->compare(part0, part1, parms->data) <= 0)
-				break;
-			part1 += sz;
-		} while (part1 < end1);
+	for (d = 0; d < dnr; d++) {
+		unsigned int * offs = hist[d];
+		char *         tmp;
 
-		rsz = (size_t)(part1 - run);
-		memcpy(result, run, rsz);
-		result += rsz;
+		if (stroll_array_radix_scan(offs, nr))
+			continue;
 
-		if (part1 == end1) {
-			stroll_array_assert_intern(part0 <= end0);
-			stroll_array_assert_intern(part1 <= end1);
-			memcpy(result, part0, (size_t)(end0 - part0));
-			return;
+		for (e = 0; e < nr; e++) {
+			const char * elem = &src[e * sz];
+			uint64_t     key = stroll_array_radix_key(elem,
+			                                          parms->off,
+			                                          parms->ksz);
+
+			memcpy(&dst[offs[stroll_array_radix_digit(key, d)]++ *
+			            sz],
+			       elem,
+			       sz);
 		}
+
+		tmp = src;
+		src = dst;
+		dst = tmp;
 	}
-}
 
-#else  /* !defined(CONFIG_STROLL_ARRAY_MERGE_SORT_RUNS_BYBLOCK) */
+	if (src != array)
+		memcpy(array, src, nr * sz);
+}
 
-static inline __stroll_nonull(1, 2, 3, 4, 5, 6)
-void
-stroll_array_merge_part_runs_mem(
-	const struct stroll_array_merge * __restrict parms,
-	char * __restrict                            result,
-	const char * __restrict                      part0,
-	const char * __restrict                      end0,
-	const char * __restrict                      part1,
-	const char * __restrict                      end1)
+int
+stroll_array_radix_sort(void * __restrict array,
+                        unsigned int      nr,
+                        size_t            size,
+                        size_t            key_off,
+                        size_t            key_size)
 {
-	size_t sz = parms->size;
+	stroll_array_assert_api(array);
+	stroll_array_assert_api(nr);
+	stroll_array_assert_api(size);
+	stroll_array_assert_api((key_size == sizeof(uint8_t)) ||
+	                        (key_size == sizeof(uint16_t)) ||
+	                        (key_size == sizeof(uint32_t)) ||
+	                        (key_size == sizeof(uint64_t)));
+	stroll_array_assert_api((key_off + key_size) <= size);
+
+	const struct stroll_array_radix parms = {
+		.size = size,
+		.off  = key_off,
+		.ksz  = key_size
+	};
+	void *                          aux;
 
-	do {
-		if (parms->compare(part0, part1, parms->data) <= 0) {
-			memcpy(result, part0, sz);
-			part0 += sz;
-		}
-		else {
-			memcpy(result, part1, sz);
-			part1 += sz;
-		}
+	if (nr == 1)
+		return 0;
 
-		result += sz;
-	} while ((part0 < end0) && (part1 < end1));
+	aux = malloc(nr * size);
+	if (!aux)
+		return -errno;
 
-	if (part0 != end0) {
-		stroll_array_assert_intern(part0 < end0);
-		stroll_array_assert_intern(part1 >= end1);
+	if (stroll_array_aligned(array, size, sizeof(uint32_t)))
+		stroll_array_radix_sort32(array, aux, nr, &parms);
+	else if (stroll_array_aligned(array, size, sizeof(uint64_t)))
+		stroll_array_radix_sort64(array, aux, nr, &parms);
+	else
+		stroll_array_radix_sort_mem(array, aux, nr, &parms);
 
-		memcpy(result, part0, (size_t)(end0 - part0));
-	}
-	else if (part1 != end1) {
-		stroll_array_assert_intern(part1 < end1);
-		stroll_array_assert_intern(part0 >= end0);
+	free(aux);
 
-		memcpy(result, part1, (size_t)(end1 - part1));
-	}
+	return 0;
 }
 
-#endif /* defined(CONFIG_STROLL_ARRAY_MERGE_SORT_RUNS_BYBLOCK) */
+#if defined(CONFIG_STROLL_ARRAY_SORTNET)
 
-static __stroll_nonull(1, 2, 3, 4, 5, 6)
-void
-stroll_array_merge_parts_mem(
-	const struct stroll_array_merge * __restrict parms,
-	char * __restrict                            result,
-	const char * __restrict                      part0,
-	const char * __restrict                      end0,
-	const char * __restrict                      part1,
-	const char * __restrict                      end1)
-{
-	stroll_array_merge_assert(parms);
-	stroll_array_assert_intern(parms->size);
-	stroll_array_assert_intern(part0);
-	stroll_array_assert_intern(end0 > part0);
-	stroll_array_assert_intern(!((size_t)(end0 - part0) % parms->size));
-	stroll_array_assert_intern(part1);
-	stroll_array_assert_intern(end1 > part1);
-	stroll_array_assert_intern(!((size_t)(end1 - part1) % parms->size));
+/*
+ * When elements are bare keys, i.e. when key size equals element size, sort
+ * small buckets using sorting networks.
+ */
+#define STROLL_ARRAY_RADIX_SORTNET(_array, _nr, _parms, _sortnet_func) \
+	if (((_parms)->ksz == sizeof(*(_array))) && \
+	    ((_nr) <= STROLL_ARRAY_SORTNET_MAX)) { \
+		_sortnet_func(_array, _nr); \
+		return; \
+	}
 
-	if (stroll_array_merge_full_runs(parms,
-	                                 result,
-	                                 part0,
-	                                 end0,
-	                                 part1,
-	                                 end1))
-		return;
+#else  /* !defined(CONFIG_STROLL_ARRAY_SORTNET) */
 
-	stroll_array_merge_part_runs_mem(parms,
-	                                 result,
-	                                 part0,
-	                                 end0,
-	                                 part1,
-	                                 end1);
-}
+#define STROLL_ARRAY_RADIX_SORTNET(_array, _nr, _parms, _sortnet_func)
 
-static __stroll_nonull(1, 2, 3, 4)
-void
-stroll_array_insert_oopsort_mem(
-	const struct stroll_array_merge * __restrict parms,
-	char * __restrict                            result,
-	const char * __restrict                      array,
-	const char * __restrict                      end)
-{
-	char * res;
+#endif /* defined(CONFIG_STROLL_ARRAY_SORTNET) */
 
-	memcpy(result, array, parms->size);
+#define STROLL_ARRAY_DEFINE_RADIX_INSERT_SORT(_sort_func, \
+                                              _sortnet_func, \
+                                              _type) \
+	static __stroll_nonull(1, 3) \
+	void \
+	_sort_func(_type * __restrict                           array, \
+	           unsigned int                                 nr, \
+	           const struct stroll_array_radix * __restrict parms) \
+	{ \
+		unsigned int e; \
+		\
+		STROLL_ARRAY_RADIX_SORTNET(array, nr, parms, _sortnet_func) \
+		\
+		for (e = 1; e < nr; e++) { \
+			_type        tmp = array[e]; \
+			uint64_t     key = stroll_array_radix_key( \
+				(const char *)&array[e], \
+				parms->off, \
+				parms->ksz); \
+			unsigned int i = e; \
+			\
+			while (i && \
+			       (stroll_array_radix_key( \
+			                (const char *)&array[i - 1], \
+			                parms->off, \
+			                parms->ksz) > key)) { \
+				array[i] = array[i - 1]; \
+				i--; \
+			} \
+			\
+			array[i] = tmp; \
+		} \
+	}
 
-	for (res = result + parms->size, array += parms->size;
-	     array != end;
-	     res += parms->size, array += parms->size)
-		stroll_array_insert_oopsort_elem_mem(result,
-		                                     res,
-		                                     array,
-		                                     parms->size,
-		                                     parms->compare,
-		                                     parms->data);
-}
+#define STROLL_ARRAY_DEFINE_RADIX_MSD_SORT(_sort_func, \
+                                           _insert_func, \
+                                           _swap_func, \
+                                           _type) \
+	static __stroll_nonull(1, 4) \
+	void \
+	_sort_func(_type * __restrict                           array, \
+	           unsigned int                                 nr, \
+	           unsigned int                                 digit, \
+	           const struct stroll_array_radix * __restrict parms) \
+	{ \
+		stroll_array_assert_intern(array); \
+		stroll_array_assert_intern(nr > 1); \
+		stroll_array_radix_assert(parms); \
+		stroll_array_assert_intern(digit < parms->ksz); \
+		\
+		unsigned int next[STROLL_RADIX_DIGIT_NR]; \
+		unsigned int end[STROLL_RADIX_DIGIT_NR]; \
+		unsigned int d; \
+		unsigned int e; \
+		\
+		while (true) { \
+			if (nr < STROLL_RADIX_INSERT_THRESHOLD) { \
+				_insert_func(array, nr, parms); \
+				return; \
+			} \
+			\
+			memset(end, 0, sizeof(end)); \
+			for (e = 0; e < nr; e++) { \
+				uint64_t key = stroll_array_radix_key( \
+					(const char *)&array[e], \
+					parms->off, \
+					parms->ksz); \
+				\
+				end[stroll_array_radix_digit(key, digit)]++; \
+			} \
+			\
+			memcpy(next, end, sizeof(next)); \
+			if (!stroll_array_radix_scan(next, nr)) \
+				break; \
+			\
+			if (!digit) \
+				return; \
+			digit--; \
+		} \
+		\
+		for (d = 0; d < STROLL_RADIX_DIGIT_NR; d++) \
+			end[d] += next[d]; \
+		\
+		for (d = 0; d < STROLL_RADIX_DIGIT_NR; d++) { \
+			while (next[d] < end[d]) { \
+				_type *      elem = &array[next[d]]; \
+				uint64_t     key = stroll_array_radix_key( \
+					(const char *)elem, \
+					parms->off, \
+					parms->ksz); \
+				unsigned int b; \
+				\
+				b = stroll_array_radix_digit(key, digit); \
+				if (b != d) \
+					_swap_func(elem, &array[next[b]]); \
+				next[b]++; \
+			} \
+		} \
+		\
+		if (!digit) \
+			return; \
+		\
+		for (d = 0, e = 0; d < STROLL_RADIX_DIGIT_NR; d++) { \
+			unsigned int cnt = end[d] - e; \
+			\
+			if (cnt > 1) \
+				_sort_func(&array[e], cnt, digit - 1, parms); \
+			e = end[d]; \
+		} \
+	}
 
-static __stroll_nonull(1, 2, 3, 4)
+STROLL_ARRAY_DEFINE_RADIX_INSERT_SORT(stroll_array_radix_insert_sort32,
+                                      stroll_array_kernels->sortnet_u32,
+                                      uint32_t)
+STROLL_ARRAY_DEFINE_RADIX_MSD_SORT(stroll_array_msd_radix_sort32,
+                                   stroll_array_radix_insert_sort32,
+                                   stroll_array_swap32,
+                                   uint32_t)
+
+STROLL_ARRAY_DEFINE_RADIX_INSERT_SORT(stroll_array_radix_insert_sort64,
+                                      stroll_array_kernels->sortnet_u64,
+                                      uint64_t)
+STROLL_ARRAY_DEFINE_RADIX_MSD_SORT(stroll_array_msd_radix_sort64,
+                                   stroll_array_radix_insert_sort64,
+                                   stroll_array_swap64,
+                                   uint64_t)
+
+static __stroll_nonull(1, 3)
 void
-stroll_array_merge_topdwn_sort(
-	const struct stroll_array_merge * __restrict parms,
-	char * __restrict                            result,
+stroll_array_radix_insert_sort_mem(
 	char * __restrict                            array,
-	const char * __restrict                      end)
+	unsigned int                                 nr,
+	const struct stroll_array_radix * __restrict parms)
 {
-	stroll_array_merge_assert(parms);
-	stroll_array_assert_intern(parms->size);
-	stroll_array_assert_intern(result);
-	stroll_array_assert_intern(end > array);
-	stroll_array_assert_intern(!((size_t)(end - array) % parms->size));
-
-	size_t sz = (size_t)(end - array);
-	size_t sz0;
+	size_t       sz = parms->size;
+	char         tmp[sz];
+	unsigned int e;
 
-	if (sz <= parms->thres) {
-		stroll_array_assert_intern(sz >= parms->size);
-		stroll_array_insert_oopsort_mem(parms, result, array, end);
-		return;
-	}
+	for (e = 1; e < nr; e++) {
+		char *   elem = &array[e * sz];
+		uint64_t key = stroll_array_radix_key(elem,
+		                                      parms->off,
+		                                      parms->ksz);
+		char *   prev = elem - sz;
 
-	sz0 = (sz / (2 * parms->size)) * parms->size;
+		if (stroll_array_radix_key(prev, parms->off, parms->ksz) <= key)
+			continue;
 
-	stroll_array_merge_topdwn_sort(parms,
-	                               &result[sz0],
-	                               &array[sz0],
-	                               end);
-	stroll_array_merge_topdwn_sort(parms,
-	                               &array[sz - sz0],
-	                               array,
-	                               &array[sz0]);
-	stroll_array_merge_parts_mem(parms,
-	                             result,
-	                             &array[sz - sz0], end,
-	                             &result[sz0], &result[sz]);
+		memcpy(tmp, elem, sz);
+		do {
+			memcpy(elem, prev, sz);
+			elem = prev;
+			prev -= sz;
+		} while ((elem != array) &&
+		         (stroll_array_radix_key(prev,
+		                                 parms->off,
+		                                 parms->ksz) > key));
+		memcpy(elem, tmp, sz);
+	}
 }
 
+/*
+ * Most significant digit radix sort, also known as American flag sort.
+ *
+ * Elements are distributed in-place into buckets according to the value of the
+ * current digit, starting from the most significant one: a first pass counts
+ * the number of elements per bucket, then elements are cyclically swapped into
+ * their final bucket. Each bucket is finally sorted recursively according to
+ * the next digit.
+ *
+ * When all keys of a bucket hold the same digit value, the distribution pass is
+ * skipped and the next digit is processed immediately. This makes the
+ * algorithm efficient for skewed key distributions, i.e. keys concentrated
+ * within a small range of values.
+ *
+ * Buckets holding less than STROLL_RADIX_INSERT_THRESHOLD elements are sorted
+ * using insertion sort.
+ *
+ * Complexity is O(w.n) in time, where w is the key width in bytes, and O(w)
+ * auxiliary stack space, where each recursion level requires 2 KiB.
+ */
 static __stroll_nonull(1, 4)
-int
-stroll_array_merge_sort_mem(char * __restrict     array,
-                            unsigned int          nr,
-                            size_t                size,
-                            stroll_array_cmp_fn * compare,
-                            void *                data)
+void
+stroll_array_msd_radix_sort_mem(char * __restrict                   array,
+                                unsigned int                        nr,
+                                unsigned int                        digit,
+                                const struct stroll_array_radix * __restrict
+                                                                    parms)
 {
 	stroll_array_assert_intern(array);
 	stroll_array_assert_intern(nr > 1);
-	stroll_array_assert_intern(size);
-	stroll_array_assert_intern(compare);
+	stroll_array_radix_assert(parms);
+	stroll_array_assert_intern(digit < parms->ksz);
 
-	char *                          aux;
-	size_t                          asz = (nr / 2) * size;
-	char *                          mid = &array[asz];
-	size_t                          msz = (nr * size) - asz;
-	const struct stroll_array_merge parms = {
-		.size    = size,
-		.compare = compare,
-		.data    = data,
-		.thres   = STROLL_MSORT_INSERT_THRESHOLD * size
-	};
+	size_t       sz = parms->size;
+	unsigned int next[STROLL_RADIX_DIGIT_NR];
+	unsigned int end[STROLL_RADIX_DIGIT_NR];
+	unsigned int d;
+	unsigned int e;
 
-	aux = malloc(msz);
-	if (!aux)
-		return -errno;
+	while (true) {
+		if (nr < STROLL_RADIX_INSERT_THRESHOLD) {
+			stroll_array_radix_insert_sort_mem(array, nr, parms);
+			return;
+		}
 
-	stroll_array_merge_topdwn_sort(&parms, aux, mid, &mid[msz]);
-	stroll_array_merge_topdwn_sort(&parms, &array[msz], array, mid);
+		memset(end, 0, sizeof(end));
+		for (e = 0; e < nr; e++) {
+			uint64_t key = stroll_array_radix_key(&array[e * sz],
+			                                      parms->off,
+			                                      parms->ksz);
 
-	stroll_array_merge_parts_mem(&parms,
-	                             array,
-	                             &array[msz], &mid[msz],
-	                             aux, &aux[msz]);
+			end[stroll_array_radix_digit(key, digit)]++;
+		}
 
-	free(aux);
+		memcpy(next, end, sizeof(next));
+		if (!stroll_array_radix_scan(next, nr))
+			break;
 
-	return 0;
+		/* All keys share the current digit value: skip it. */
+		if (!digit)
+			return;
+		digit--;
+	}
+
+	/* Turn bucket counts into bucket end offsets. */
+	for (d = 0; d < STROLL_RADIX_DIGIT_NR; d++)
+		end[d] += next[d];
+
+	/*
+	 * Move each element into its bucket. Buckets are filled in order: once
+	 * bucket `d' is complete, all remaining elements hold digits greater
+	 * than `d'.
+	 */
+	for (d = 0; d < STROLL_RADIX_DIGIT_NR; d++) {
+		while (next[d] < end[d]) {
+			char *       elem = &array[next[d] * sz];
+			uint64_t     key = stroll_array_radix_key(elem,
+			                                          parms->off,
+			                                          parms->ksz);
+			unsigned int b = stroll_array_radix_digit(key, digit);
+
+			if (b != d)
+				stroll_array_swap(elem,
+				                  &array[next[b] * sz],
+				                  sz);
+			next[b]++;
+		}
+	}
+
+	if (!digit)
+		return;
+
+	for (d = 0, e = 0; d < STROLL_RADIX_DIGIT_NR; d++) {
+		unsigned int cnt = end[d] - e;
+
+		if (cnt > 1)
+			stroll_array_msd_radix_sort_mem(&array[e * sz],
+			                                cnt,
+			                                digit - 1,
+			                                parms);
+		e = end[d];
+	}
 }
 
-int
-stroll_array_merge_sort(void * __restrict     array,
-                        unsigned int          nr,
-                        size_t                size,
-                        stroll_array_cmp_fn * compare,
-                        void *                data)
+void
+stroll_array_msd_radix_sort(void * __restrict array,
+                            unsigned int      nr,
+                            size_t            size,
+                            size_t            key_off,
+                            size_t            key_size)
 {
 	stroll_array_assert_api(array);
 	stroll_array_assert_api(nr);
 	stroll_array_assert_api(size);
-	stroll_array_assert_api(compare);
+	stroll_array_assert_api((key_size == sizeof(uint8_t)) ||
+	                        (key_size == sizeof(uint16_t)) ||
+	                        (key_size == sizeof(uint32_t)) ||
+	                        (key_size == sizeof(uint64_t)));
+	stroll_array_assert_api((key_off + key_size) <= size);
+
+	const struct stroll_array_radix parms = {
+		.size = size,
+		.off  = key_off,
+		.ksz  = key_size
+	};
+	unsigned int                    digit = (unsigned int)key_size - 1;
 
 	if (nr == 1)
-		return 0;
+		return;
 
 	if (stroll_array_aligned(array, size, sizeof(uint32_t)))
-		return stroll_array_merge_sort32(array, nr, compare, data);
+		stroll_array_msd_radix_sort32(array, nr, digit, &parms);
 	else if (stroll_array_aligned(array, size, sizeof(uint64_t)))
-		return stroll_array_merge_sort64(array, nr, compare, data);
+		stroll_array_msd_radix_sort64(array, nr, digit, &parms);
 	else
-		return stroll_array_merge_sort_mem(array,
-		                                   nr,
-		                                   size,
-		                                   compare,
-		                                   data);
+		stroll_array_msd_radix_sort_mem(array, nr, digit, &parms);
 }
 
-#endif /* defined(CONFIG_STROLL_ARRAY_MERGE_SORT) */
+#endif /* defined(CONFIG_STROLL_ARRAY_RADIX_SORT) */
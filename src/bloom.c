@@ -0,0 +1,561 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#include "stroll/bloom.h"
+#include "stroll/hash.h"
+#include "log.h"
+
+/* Number of machine words a blocked Bloom filter block is made of. */
+#define STROLL_BLOOM_BLOCK_WORDS \
+	(STROLL_BLOOM_BLOCK_BITS / __WORDSIZE)
+
+/*
+ * Number of keys to look ahead of when prefetching bitmap content during batch
+ * operations.
+ */
+#define STROLL_BLOOM_PREFETCH_DIST \
+	(8U)
+
+#define stroll_bloom_assert_compat_api(_result, _bloom) \
+	stroll_bloom_assert_filter_api(_result); \
+	stroll_bloom_assert_filter_api(_bloom); \
+	stroll_bloom_assert_api((_result)->hash_nr == (_bloom)->hash_nr); \
+	stroll_bloom_assert_api((_result)->block_nr == (_bloom)->block_nr); \
+	stroll_bloom_assert_api((_result)->map.nr == (_bloom)->map.nr)
+
+/*
+ * Derive the 2 hashes used to generate the whole sequence of bit indices
+ * according to the Kirsch-Mitzenmacher double hashing scheme.
+ *
+ * Both hashes are extracted from distinct halves of the mixed key hash: a
+ * single multiplicative hash would map strided keys onto correlated bit
+ * indices and exceed the requested false positive rate. Step is forced odd so
+ * that successive indices cannot collapse onto a single one.
+ */
+static inline __stroll_nothrow
+void
+stroll_bloom_hash(uint64_t key, uint32_t * base, uint32_t * step)
+{
+	uint64_t hash = stroll_hash_mix64(key);
+
+	*base = (uint32_t)hash;
+	*step = (uint32_t)(hash >> 32) | 1U;
+}
+
+/*
+ * Map a 32-bit hash onto the [0, nr[ range using a multiply-shift reduction
+ * instead of a (much slower) modulo operation.
+ */
+static inline __const __nothrow __warn_result
+unsigned int
+stroll_bloom_reduce(uint32_t hash, unsigned int nr)
+{
+	return (unsigned int)(((uint64_t)hash * nr) >> 32);
+}
+
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+unsigned long *
+stroll_bloom_block(const struct stroll_bloom * __restrict bloom, uint32_t base)
+{
+	return &bloom->map.bits[stroll_bloom_reduce(base, bloom->block_nr) *
+	                        STROLL_BLOOM_BLOCK_WORDS];
+}
+
+/* Number of bits required to index a bit within a blocked filter block. */
+#define STROLL_BLOOM_BLOCK_SHIFT \
+	(9U)
+
+/* Number of block bit indices a single 64-bit hash value may provide. */
+#define STROLL_BLOOM_BLOCK_IDX_NR \
+	(64U / STROLL_BLOOM_BLOCK_SHIFT)
+
+/*
+ * Compute the index of the h-th bit a key maps to within a blocked Bloom
+ * filter block.
+ *
+ * Indices are extracted #STROLL_BLOOM_BLOCK_SHIFT bits at a time from a
+ * splitmix64 like sequence of hashes seeded with the key so that each index
+ * carries its own entropy. Deriving them using double hashing instead would
+ * make the whole set of indices depend upon 2 * #STROLL_BLOOM_BLOCK_SHIFT bits
+ * only, causing keys sharing a block to collide far more often than expected.
+ */
+static inline __stroll_nonull(1, 2) __stroll_nothrow __warn_result
+unsigned int
+stroll_bloom_block_bit(uint64_t * __restrict seed,
+                       uint64_t * __restrict hash,
+                       unsigned int          h)
+{
+	unsigned int bit;
+
+	if (!(h % STROLL_BLOOM_BLOCK_IDX_NR)) {
+		*seed += UINT64_C(0x9e3779b97f4a7c15);
+		*hash = stroll_hash_mix64(*seed);
+	}
+
+	bit = (unsigned int)*hash & (STROLL_BLOOM_BLOCK_BITS - 1);
+	*hash >>= STROLL_BLOOM_BLOCK_SHIFT;
+
+	return bit;
+}
+
+static __stroll_nonull(1) __stroll_nothrow
+void
+stroll_bloom_insert_std(struct stroll_bloom * __restrict bloom, uint64_t key)
+{
+	uint32_t     hash;
+	uint32_t     step;
+	unsigned int h;
+
+	stroll_bloom_hash(key, &hash, &step);
+	for (h = 0; h < bloom->hash_nr; h++, hash += step)
+		_stroll_fbmap_set(bloom->map.bits,
+		                  stroll_bloom_reduce(hash, bloom->map.nr));
+}
+
+static __stroll_nonull(1) __stroll_nothrow
+void
+stroll_bloom_insert_blk(struct stroll_bloom * __restrict bloom, uint64_t key)
+{
+	uint32_t        base;
+	uint32_t        step;
+	uint64_t        hash = 0;
+	unsigned long * blk;
+	unsigned int    h;
+
+	stroll_bloom_hash(key, &base, &step);
+	blk = stroll_bloom_block(bloom, base);
+
+	for (h = 0; h < bloom->hash_nr; h++)
+		_stroll_fbmap_set(blk, stroll_bloom_block_bit(&key, &hash, h));
+}
+
+void
+stroll_bloom_insert(struct stroll_bloom * __restrict bloom, uint64_t key)
+{
+	stroll_bloom_assert_filter_api(bloom);
+
+	if (bloom->block_nr)
+		stroll_bloom_insert_blk(bloom, key);
+	else
+		stroll_bloom_insert_std(bloom, key);
+}
+
+static __stroll_nonull(1) __stroll_nothrow
+void
+stroll_bloom_prefetch(const struct stroll_bloom * __restrict bloom,
+                      uint64_t                               key,
+                      int                                    access)
+{
+	uint32_t     hash;
+	uint32_t     step;
+	unsigned int h;
+
+	stroll_bloom_hash(key, &hash, &step);
+
+	if (bloom->block_nr) {
+		/* A single cache line holds all bits of a blocked key. */
+		if (access == STROLL_PREFETCH_ACCESS_RW)
+			stroll_prefetch(stroll_bloom_block(bloom, hash),
+			                STROLL_PREFETCH_ACCESS_RW);
+		else
+			stroll_prefetch(stroll_bloom_block(bloom, hash),
+			                STROLL_PREFETCH_ACCESS_RO);
+		return;
+	}
+
+	for (h = 0; h < bloom->hash_nr; h++, hash += step) {
+		const unsigned long * word;
+
+		word = &bloom->map.bits[stroll_fbmap_word_no(
+			stroll_bloom_reduce(hash, bloom->map.nr))];
+		if (access == STROLL_PREFETCH_ACCESS_RW)
+			stroll_prefetch(word, STROLL_PREFETCH_ACCESS_RW);
+		else
+			stroll_prefetch(word, STROLL_PREFETCH_ACCESS_RO);
+	}
+}
+
+void
+stroll_bloom_insert_batch(struct stroll_bloom * __restrict bloom,
+                          const uint64_t * __restrict      keys,
+                          unsigned int                     nr)
+{
+	stroll_bloom_assert_filter_api(bloom);
+	stroll_bloom_assert_api(keys);
+
+	unsigned int k;
+
+	for (k = 0; k < nr; k++) {
+		if ((k + STROLL_BLOOM_PREFETCH_DIST) < nr)
+			stroll_bloom_prefetch(
+				bloom,
+				keys[k + STROLL_BLOOM_PREFETCH_DIST],
+				STROLL_PREFETCH_ACCESS_RW);
+
+		stroll_bloom_insert(bloom, keys[k]);
+	}
+}
+
+static __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+bool
+stroll_bloom_test_std(const struct stroll_bloom * __restrict bloom,
+                      uint64_t                               key)
+{
+	uint32_t     hash;
+	uint32_t     step;
+	unsigned int h;
+
+	stroll_bloom_hash(key, &hash, &step);
+	for (h = 0; h < bloom->hash_nr; h++, hash += step) {
+		unsigned int bit = stroll_bloom_reduce(hash, bloom->map.nr);
+
+		if (!_stroll_fbmap_test(bloom->map.bits, bit))
+			return false;
+	}
+
+	return true;
+}
+
+static __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+bool
+stroll_bloom_test_blk(const struct stroll_bloom * __restrict bloom,
+                      uint64_t                               key)
+{
+	uint32_t              base;
+	uint32_t              step;
+	uint64_t              hash = 0;
+	const unsigned long * blk;
+	unsigned int          h;
+
+	stroll_bloom_hash(key, &base, &step);
+	blk = stroll_bloom_block(bloom, base);
+
+	for (h = 0; h < bloom->hash_nr; h++) {
+		if (!_stroll_fbmap_test(blk,
+		                        stroll_bloom_block_bit(&key, &hash, h)))
+			return false;
+	}
+
+	return true;
+}
+
+bool
+stroll_bloom_test(const struct stroll_bloom * __restrict bloom, uint64_t key)
+{
+	stroll_bloom_assert_filter_api(bloom);
+
+	if (bloom->block_nr)
+		return stroll_bloom_test_blk(bloom, key);
+	else
+		return stroll_bloom_test_std(bloom, key);
+}
+
+unsigned int
+stroll_bloom_test_batch(const struct stroll_bloom * __restrict bloom,
+                        const uint64_t * __restrict            keys,
+                        unsigned int                           nr,
+                        bool * __restrict                      results)
+{
+	stroll_bloom_assert_filter_api(bloom);
+	stroll_bloom_assert_api(keys);
+	stroll_bloom_assert_api(results);
+
+	unsigned int k;
+	unsigned int cnt = 0;
+
+	for (k = 0; k < nr; k++) {
+		if ((k + STROLL_BLOOM_PREFETCH_DIST) < nr)
+			stroll_bloom_prefetch(
+				bloom,
+				keys[k + STROLL_BLOOM_PREFETCH_DIST],
+				STROLL_PREFETCH_ACCESS_RO);
+
+		results[k] = stroll_bloom_test(bloom, keys[k]);
+		cnt += (unsigned int)results[k];
+	}
+
+	return cnt;
+}
+
+void
+stroll_bloom_unite(struct stroll_bloom * __restrict       result,
+                   const struct stroll_bloom * __restrict bloom)
+{
+	stroll_bloom_assert_compat_api(result, bloom);
+
+	stroll_fbmap_or(&result->map, &result->map, &bloom->map);
+}
+
+void
+stroll_bloom_intersect(struct stroll_bloom * __restrict       result,
+                       const struct stroll_bloom * __restrict bloom)
+{
+	stroll_bloom_assert_compat_api(result, bloom);
+
+	stroll_fbmap_and(&result->map, &result->map, &bloom->map);
+}
+
+/*
+ * Compute optimal number of bits and hash functions given the expected
+ * maximum number of keys and false positive rate, i.e.:
+ *     bits   = -capacity * ln(fpr) / ln(2)^2
+ *     hashes = bits / capacity * ln(2)
+ */
+static __stroll_nonull(3, 4) __stroll_nothrow __warn_result
+int
+stroll_bloom_size(unsigned int              capacity,
+                  double                    fpr,
+                  unsigned int * __restrict bit_nr,
+                  unsigned int * __restrict hash_nr)
+{
+	stroll_bloom_assert_api(capacity);
+	stroll_bloom_assert_api(fpr > 0.0);
+	stroll_bloom_assert_api(fpr < 1.0);
+
+	double       bits = (double)capacity * -stroll_log(fpr) /
+	                    (M_LN2 * M_LN2);
+	unsigned int nr;
+
+	if (bits >= (double)INT_MAX)
+		return -ERANGE;
+
+	/* Round up to the next integral number of bits. */
+	nr = (unsigned int)bits;
+	if ((double)nr < bits)
+		nr++;
+
+	*bit_nr = stroll_max(nr, 1U);
+	*hash_nr = stroll_min(
+		stroll_max((unsigned int)((bits / (double)capacity * M_LN2) +
+		                          0.5),
+		           1U),
+		STROLL_BLOOM_HASH_MAX);
+
+	return 0;
+}
+
+int
+stroll_bloom_init(struct stroll_bloom * __restrict bloom,
+                  unsigned int                     capacity,
+                  double                           fpr)
+{
+	stroll_bloom_assert_api(bloom);
+
+	unsigned int bit_nr;
+	unsigned int hash_nr;
+	int          err;
+
+	err = stroll_bloom_size(capacity, fpr, &bit_nr, &hash_nr);
+	if (err)
+		return err;
+
+	err = stroll_fbmap_init_clear(&bloom->map, bit_nr);
+	if (err)
+		return err;
+
+	bloom->hash_nr = hash_nr;
+	bloom->block_nr = 0;
+
+	return 0;
+}
+
+/* Raise x to the n-th power by repeated squaring. */
+static __const __nothrow __warn_result
+double
+stroll_bloom_pow(double x, unsigned int n)
+{
+	double res = 1.0;
+
+	while (n) {
+		if (n & 1U)
+			res *= x;
+		x *= x;
+		n >>= 1;
+	}
+
+	return res;
+}
+
+/*
+ * Compute natural logarithm of n!.
+ *
+ * Use exact product for small values and Stirling's series otherwise.
+ */
+static __const __nothrow __warn_result
+double
+stroll_bloom_log_fact(unsigned int n)
+{
+	if (n <= 20) {
+		double       fact = 1.0;
+		unsigned int i;
+
+		for (i = 2; i <= n; i++)
+			fact *= (double)i;
+
+		return stroll_log(fact);
+	}
+
+	return ((double)n * stroll_log((double)n)) - (double)n +
+	       (0.5 * stroll_log(2.0 * M_PI * (double)n)) +
+	       (1.0 / (12.0 * (double)n));
+}
+
+/*
+ * Poisson probabilities below this threshold are considered negligible when
+ * computing blocked Bloom filter false positive rate.
+ */
+#define STROLL_BLOOM_POISSON_MIN 	(1e-20)
+
+/*
+ * Compute false positive rate of a blocked Bloom filter.
+ *
+ * Keys are distributed among blocks following a Poisson distribution of mean
+ * lambda = STROLL_BLOOM_BLOCK_BITS / bits per key. A block holding i keys
+ * behaves as a standard Bloom filter of STROLL_BLOOM_BLOCK_BITS bits which
+ * false positive rate is (1 - (1 - 1 / STROLL_BLOOM_BLOCK_BITS)^(i * k))^k.
+ * Overall rate is the sum of per block rates weighted by Poisson
+ * probabilities.
+ *
+ * Summation starts from the mode of the Poisson distribution, i.e. its
+ * largest term, and walks both tails until remaining terms are negligible.
+ * See Putze, Sanders and Singler, "Cache-, Hash- and Space-Efficient Bloom
+ * Filters", 2007.
+ */
+static __const __nothrow __warn_result
+double
+stroll_bloom_blocked_fpr(double lambda, unsigned int mode, double mode_prob,
+                         unsigned int hash_nr)
+{
+	double       miss = stroll_bloom_pow(1.0 -
+	                                     (1.0 / STROLL_BLOOM_BLOCK_BITS),
+	                                     hash_nr);
+	double       mode_miss = stroll_bloom_pow(miss, mode);
+	double       prob = mode_prob;
+	double       clr = mode_miss;
+	double       fpr = 0.0;
+	unsigned int i = mode;
+
+	/* Walk the upper tail, mode included. */
+	do {
+		fpr += prob * stroll_bloom_pow(1.0 - clr, hash_nr);
+		prob *= lambda / (double)(++i);
+		clr *= miss;
+	} while (prob > STROLL_BLOOM_POISSON_MIN);
+
+	/* Now walk the lower tail. */
+	prob = mode_prob;
+	clr = mode_miss;
+	for (i = mode; i > 0; i--) {
+		prob *= (double)i / lambda;
+		if (prob <= STROLL_BLOOM_POISSON_MIN)
+			break;
+		clr /= miss;
+		fpr += prob * stroll_bloom_pow(1.0 - clr, hash_nr);
+	}
+
+	return fpr;
+}
+
+/*
+ * Compute the number of blocks and hashes a blocked Bloom filter requires to
+ * satisfy the given false positive rate.
+ *
+ * Confining keys into blocks makes the false positive rate higher than the
+ * one of a standard Bloom filter of identical size since the number of keys
+ * per block varies. Start with the standard Bloom filter size and grow it by
+ * steps of about 2% until the blocked filter model (see
+ * stroll_bloom_blocked_fpr()) meets the requested rate, selecting the optimal
+ * number of hashes at each step.
+ */
+static __stroll_nonull(3, 4) __stroll_nothrow __warn_result
+int
+stroll_bloom_size_blocked(unsigned int              capacity,
+                          double                    fpr,
+                          unsigned int * __restrict blk_nr,
+                          unsigned int * __restrict hash_nr)
+{
+	unsigned int bit_nr;
+	unsigned int nr;
+	int          err;
+
+	err = stroll_bloom_size(capacity, fpr, &bit_nr, hash_nr);
+	if (err)
+		return err;
+
+	nr = (bit_nr + STROLL_BLOOM_BLOCK_BITS - 1) / STROLL_BLOOM_BLOCK_BITS;
+	while (true) {
+		double       lambda;
+		unsigned int mode;
+		double       mode_prob;
+		double       best = 1.0;
+		unsigned int h;
+
+		if (nr > ((unsigned int)INT_MAX / STROLL_BLOOM_BLOCK_BITS))
+			return -ERANGE;
+
+		lambda = (double)capacity / (double)nr;
+		mode = (unsigned int)lambda;
+		mode_prob = stroll_exp(((double)mode * stroll_log(lambda)) -
+		                       lambda -
+		                       stroll_bloom_log_fact(mode));
+
+		/* False positive rate is unimodal in the number of hashes. */
+		for (h = 1; h <= STROLL_BLOOM_HASH_MAX; h++) {
+			double curr = stroll_bloom_blocked_fpr(lambda,
+			                                       mode,
+			                                       mode_prob,
+			                                       h);
+
+			if (curr >= best)
+				break;
+			best = curr;
+			*hash_nr = h;
+		}
+
+		if (best <= fpr)
+			break;
+
+		nr += stroll_max(nr / 50, 1U);
+	}
+
+	*blk_nr = nr;
+
+	return 0;
+}
+
+int
+stroll_bloom_init_blocked(struct stroll_bloom * __restrict bloom,
+                          unsigned int                     capacity,
+                          double                           fpr)
+{
+	stroll_bloom_assert_api(bloom);
+
+	unsigned int    hash_nr;
+	unsigned int    blk_nr;
+	size_t          sz;
+	unsigned long * bits;
+	int             err;
+
+	err = stroll_bloom_size_blocked(capacity, fpr, &blk_nr, &hash_nr);
+	if (err)
+		return err;
+
+	/* Make sure each block lies within a single cache line. */
+	sz = (size_t)blk_nr * (STROLL_BLOOM_BLOCK_BITS / CHAR_BIT);
+	bits = aligned_alloc(STROLL_BLOOM_BLOCK_BITS / CHAR_BIT, sz);
+	if (!bits)
+		return -errno;
+
+	memset(bits, 0, sz);
+
+	bloom->hash_nr = hash_nr;
+	bloom->block_nr = blk_nr;
+	bloom->map.nr = blk_nr * STROLL_BLOOM_BLOCK_BITS;
+	bloom->map.bits = bits;
+
+	return 0;
+}
@@ -0,0 +1,371 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#include "stroll/cmsketch.h"
+#include "stroll/hash.h"
+#include "stroll/pow2.h"
+#include "log.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Number of counters merged per iteration. This is a compile time constant so
+ * that the compiler may fully vectorize the inner merging loop without having
+ * to generate a scalar epilogue.
+ */
+#define STROLL_CMSKETCH_MERGE_STRIDE (16U)
+
+#define stroll_cmsketch_assert_compat_api(_result, _sketch) \
+	stroll_cmsketch_assert_sketch_api(_result); \
+	stroll_cmsketch_assert_sketch_api(_sketch); \
+	stroll_cmsketch_assert_api((_result)->depth == (_sketch)->depth); \
+	stroll_cmsketch_assert_api((_result)->width_bits == \
+	                           (_sketch)->width_bits)
+
+static inline __const __nothrow __warn_result
+unsigned int
+stroll_cmsketch_counter_nr(unsigned int depth, unsigned int width_bits)
+{
+	return depth << width_bits;
+}
+
+/*
+ * Derive the 2 hashes used to generate per row hashes according to the
+ * Kirsch-Mitzenmacher double hashing scheme.
+ */
+static inline __stroll_nothrow
+void
+stroll_cmsketch_hash(uint64_t key, uint32_t * base, uint32_t * step)
+{
+	*base = stroll_hash64(key, 32);
+	*step = stroll_hash32(*base ^ (uint32_t)key ^ (uint32_t)(key >> 32),
+	                      32) | 1U;
+}
+
+/*
+ * Compute the index of a counter within the flat counter array given the row
+ * and the row hash. Use the most significant bits of the row hash since these
+ * are the most random ones.
+ */
+static inline __const __nothrow __warn_result
+unsigned int
+stroll_cmsketch_index(unsigned int row, unsigned int width_bits, uint32_t hash)
+{
+	return (row << width_bits) + (hash >> (32U - width_bits));
+}
+
+/*
+ * Compute dimensions given the expected number of counters per row and the
+ * expected probability of exceeding error bounds, i.e.
+ *     depth = ceil(ln(1 / delta))
+ */
+static __stroll_nonull(3, 4) __stroll_nothrow __warn_result
+int
+stroll_cmsketch_size(double                    width,
+                     double                    delta,
+                     unsigned int * __restrict depth,
+                     unsigned int * __restrict width_bits)
+{
+	double       rows = -stroll_log(delta);
+	unsigned int nr;
+
+	if ((rows > (double)STROLL_CMSKETCH_DEPTH_MAX) ||
+	    (width > (double)(1U << STROLL_CMSKETCH_WIDTH_BITS_MAX)))
+		return -ERANGE;
+
+	/* Round up to the next integral number of rows. */
+	nr = (unsigned int)rows;
+	if ((double)nr < rows)
+		nr++;
+	*depth = stroll_max(nr, 1U);
+
+	/* Round up to the next integral number of counters. */
+	nr = (unsigned int)width;
+	if ((double)nr < width)
+		nr++;
+	*width_bits = stroll_max(stroll_pow2_up64(stroll_max(nr, 1U)),
+	                         STROLL_CMSKETCH_WIDTH_BITS_MIN);
+
+	return 0;
+}
+
+void
+stroll_cmsketch_update(struct stroll_cmsketch * __restrict sketch,
+                       uint64_t                            key,
+                       uint32_t                            count)
+{
+	stroll_cmsketch_assert_sketch_api(sketch);
+
+	uint32_t     hash;
+	uint32_t     step;
+	unsigned int r;
+
+	stroll_cmsketch_hash(key, &hash, &step);
+	for (r = 0; r < sketch->depth; r++, hash += step) {
+		uint32_t * cnt = &sketch->counters[
+			stroll_cmsketch_index(r, sketch->width_bits, hash)];
+		uint32_t   sum = *cnt + count;
+
+		/* Saturate on overflow. */
+		*cnt = sum | -(uint32_t)(sum < count);
+	}
+}
+
+uint32_t
+stroll_cmsketch_estimate(const struct stroll_cmsketch * __restrict sketch,
+                         uint64_t                                  key)
+{
+	stroll_cmsketch_assert_sketch_api(sketch);
+
+	uint32_t     hash;
+	uint32_t     step;
+	unsigned int r;
+	uint32_t     est = UINT32_MAX;
+
+	stroll_cmsketch_hash(key, &hash, &step);
+	for (r = 0; r < sketch->depth; r++, hash += step)
+		est = stroll_min(est,
+		                 sketch->counters[
+		                 stroll_cmsketch_index(r,
+		                                       sketch->width_bits,
+		                                       hash)]);
+
+	return est;
+}
+
+void
+stroll_cmsketch_merge(struct stroll_cmsketch * __restrict       result,
+                      const struct stroll_cmsketch * __restrict sketch)
+{
+	stroll_cmsketch_assert_compat_api(result, sketch);
+
+	unsigned int                nr = stroll_cmsketch_counter_nr(
+	                                         result->depth,
+	                                         result->width_bits);
+	uint32_t * __restrict       res = result->counters;
+	const uint32_t * __restrict cnt = sketch->counters;
+	unsigned int                c;
+
+	compile_assert(!((1U << STROLL_CMSKETCH_WIDTH_BITS_MIN) %
+	                 STROLL_CMSKETCH_MERGE_STRIDE));
+
+	for (c = 0; c < nr; c += STROLL_CMSKETCH_MERGE_STRIDE) {
+		unsigned int s;
+
+		for (s = 0; s < STROLL_CMSKETCH_MERGE_STRIDE; s++) {
+			uint32_t sum = res[c + s] + cnt[c + s];
+
+			res[c + s] = sum | -(uint32_t)(sum < cnt[c + s]);
+		}
+	}
+}
+
+void
+stroll_cmsketch_clear(struct stroll_cmsketch * __restrict sketch)
+{
+	stroll_cmsketch_assert_sketch_api(sketch);
+
+	memset(sketch->counters,
+	       0,
+	       stroll_cmsketch_counter_nr(sketch->depth, sketch->width_bits) *
+	       sizeof(sketch->counters[0]));
+}
+
+int
+stroll_cmsketch_init(struct stroll_cmsketch * __restrict sketch,
+                     double                              epsilon,
+                     double                              delta)
+{
+	stroll_cmsketch_assert_api(sketch);
+	stroll_cmsketch_assert_api(epsilon > 0.0);
+	stroll_cmsketch_assert_api(epsilon < 1.0);
+	stroll_cmsketch_assert_api(delta > 0.0);
+	stroll_cmsketch_assert_api(delta < 1.0);
+
+	unsigned int depth;
+	unsigned int width_bits;
+	size_t       sz;
+	int          err;
+
+	err = stroll_cmsketch_size(M_E / epsilon, delta, &depth, &width_bits);
+	if (err)
+		return err;
+
+	sz = stroll_cmsketch_counter_nr(depth, width_bits) *
+	     sizeof(sketch->counters[0]);
+	sketch->counters = malloc(sz);
+	if (!sketch->counters)
+		return -errno;
+
+	memset(sketch->counters, 0, sz);
+	sketch->depth = depth;
+	sketch->width_bits = width_bits;
+
+	return 0;
+}
+
+void
+stroll_cmsketch_fini(struct stroll_cmsketch * __restrict sketch)
+{
+	stroll_cmsketch_assert_sketch_api(sketch);
+
+	free(sketch->counters);
+}
+
+/*
+ * Apply the sign of a Count sketch counter update to the given value according
+ * to the row hash. Use a re-hashed value so that sign is not correlated with
+ * the counter index.
+ *
+ * Negation is performed using unsigned modular arithmetic since negating
+ * INT32_MIN is undefined for signed integers.
+ */
+static inline __const __nothrow __warn_result
+uint32_t
+stroll_csketch_sign(uint32_t hash, uint32_t value)
+{
+	/* All bits set when sign is negative, cleared otherwise. */
+	uint32_t neg = (_stroll_hash32(hash) >> 31) - 1U;
+
+	return (value ^ neg) - neg;
+}
+
+void
+stroll_csketch_update(struct stroll_csketch * __restrict sketch,
+                      uint64_t                           key,
+                      int32_t                            count)
+{
+	stroll_cmsketch_assert_sketch_api(sketch);
+
+	uint32_t     hash;
+	uint32_t     step;
+	unsigned int r;
+
+	stroll_cmsketch_hash(key, &hash, &step);
+	for (r = 0; r < sketch->depth; r++, hash += step) {
+		int32_t * cnt = &sketch->counters[
+			stroll_cmsketch_index(r, sketch->width_bits, hash)];
+
+		/* Rely on modular arithmetic to prevent signed overflows. */
+		*cnt = (int32_t)((uint32_t)*cnt +
+		                 stroll_csketch_sign(hash, (uint32_t)count));
+	}
+}
+
+int32_t
+stroll_csketch_estimate(const struct stroll_csketch * __restrict sketch,
+                        uint64_t                                 key)
+{
+	stroll_cmsketch_assert_sketch_api(sketch);
+
+	uint32_t     hash;
+	uint32_t     step;
+	int32_t      est[STROLL_CMSKETCH_DEPTH_MAX];
+	unsigned int r;
+
+	stroll_cmsketch_hash(key, &hash, &step);
+	for (r = 0; r < sketch->depth; r++, hash += step) {
+		int32_t      val;
+		unsigned int e;
+
+		val = (int32_t)stroll_csketch_sign(
+			hash,
+			(uint32_t)sketch->counters[
+				stroll_cmsketch_index(r,
+				                      sketch->width_bits,
+				                      hash)]);
+
+		/* Insertion sort row estimates to compute median. */
+		for (e = r; (e > 0) && (est[e - 1] > val); e--)
+			est[e] = est[e - 1];
+		est[e] = val;
+	}
+
+	return est[sketch->depth / 2];
+}
+
+void
+stroll_csketch_merge(struct stroll_csketch * __restrict       result,
+                     const struct stroll_csketch * __restrict sketch)
+{
+	stroll_cmsketch_assert_compat_api(result, sketch);
+
+	unsigned int               nr = stroll_cmsketch_counter_nr(
+	                                        result->depth,
+	                                        result->width_bits);
+	int32_t * __restrict       res = result->counters;
+	const int32_t * __restrict cnt = sketch->counters;
+	unsigned int               c;
+
+	for (c = 0; c < nr; c += STROLL_CMSKETCH_MERGE_STRIDE) {
+		unsigned int s;
+
+		for (s = 0; s < STROLL_CMSKETCH_MERGE_STRIDE; s++)
+			res[c + s] = (int32_t)((uint32_t)res[c + s] +
+			                       (uint32_t)cnt[c + s]);
+	}
+}
+
+void
+stroll_csketch_clear(struct stroll_csketch * __restrict sketch)
+{
+	stroll_cmsketch_assert_sketch_api(sketch);
+
+	memset(sketch->counters,
+	       0,
+	       stroll_cmsketch_counter_nr(sketch->depth, sketch->width_bits) *
+	       sizeof(sketch->counters[0]));
+}
+
+int
+stroll_csketch_init(struct stroll_csketch * __restrict sketch,
+                    double                             epsilon,
+                    double                             delta)
+{
+	stroll_cmsketch_assert_api(sketch);
+	stroll_cmsketch_assert_api(epsilon > 0.0);
+	stroll_cmsketch_assert_api(epsilon < 1.0);
+	stroll_cmsketch_assert_api(delta > 0.0);
+	stroll_cmsketch_assert_api(delta < 1.0);
+
+	unsigned int depth;
+	unsigned int width_bits;
+	size_t       sz;
+	int          err;
+
+	err = stroll_cmsketch_size(3.0 / (epsilon * epsilon),
+	                           delta,
+	                           &depth,
+	                           &width_bits);
+	if (err)
+		return err;
+
+	/* Median computation requires an odd number of rows. */
+	depth |= 1U;
+	if (depth > STROLL_CMSKETCH_DEPTH_MAX)
+		return -ERANGE;
+
+	sz = stroll_cmsketch_counter_nr(depth, width_bits) *
+	     sizeof(sketch->counters[0]);
+	sketch->counters = malloc(sz);
+	if (!sketch->counters)
+		return -errno;
+
+	memset(sketch->counters, 0, sz);
+	sketch->depth = depth;
+	sketch->width_bits = width_bits;
+
+	return 0;
+}
+
+void
+stroll_csketch_fini(struct stroll_csketch * __restrict sketch)
+{
+	stroll_cmsketch_assert_sketch_api(sketch);
+
+	free(sketch->counters);
+}
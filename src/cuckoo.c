@@ -0,0 +1,353 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#include "stroll/cuckoo.h"
+#include "stroll/hash.h"
+#include "stroll/pow2.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Maximum base 2 logarithm of the number of buckets so that slot indices fit
+ * into an int.
+ */
+#define STROLL_CUCKOO_BUCKET_BITS_MAX (28U)
+
+/*
+ * Maximum base 2 logarithm of the number of buckets 8-bit fingerprints may
+ * address.
+ *
+ * Alternate buckets are computed by XOR'ing the current bucket index with a
+ * hash of the fingerprint. With only 255 distinct non-zero 8-bit fingerprints,
+ * larger tables would restrict each key to a small subset of alternate buckets
+ * and insertions would fail well before reaching a 95% load factor.
+ */
+#define STROLL_CUCKOO_FP8_BUCKET_BITS_MAX (7U)
+
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+uint32_t
+stroll_cuckoo_get(const struct stroll_cuckoo * __restrict cuckoo,
+                  unsigned int                            slot)
+{
+	switch (cuckoo->fp_bits) {
+	case 8:
+		return ((const uint8_t *)cuckoo->slots)[slot];
+	case 16:
+		return ((const uint16_t *)cuckoo->slots)[slot];
+	default:
+		return ((const uint32_t *)cuckoo->slots)[slot];
+	}
+}
+
+static inline __stroll_nonull(1) __stroll_nothrow
+void
+stroll_cuckoo_set(struct stroll_cuckoo * __restrict cuckoo,
+                  unsigned int                      slot,
+                  uint32_t                          fp)
+{
+	switch (cuckoo->fp_bits) {
+	case 8:
+		((uint8_t *)cuckoo->slots)[slot] = (uint8_t)fp;
+		break;
+	case 16:
+		((uint16_t *)cuckoo->slots)[slot] = (uint16_t)fp;
+		break;
+	default:
+		((uint32_t *)cuckoo->slots)[slot] = fp;
+	}
+}
+
+/*
+ * Derive bucket index and fingerprint from key. Zero fingerprints are reserved
+ * to denote empty slots.
+ *
+ * Bucket index and fingerprint are extracted from distinct halves of the
+ * mixed key hash. Deriving both from correlated hashes would make keys mapped
+ * to the same bucket share fingerprints, which badly hurts the false positive
+ * rate of dense keys such as sequential integers.
+ */
+static inline __stroll_nonull(1, 3, 4) __stroll_nothrow
+void
+stroll_cuckoo_hash(const struct stroll_cuckoo * __restrict cuckoo,
+                   uint64_t                                key,
+                   unsigned int * __restrict               bucket,
+                   uint32_t * __restrict                   fp)
+{
+	uint64_t hash = stroll_hash_mix64(key);
+
+	*bucket = (unsigned int)((uint32_t)hash >> (32U - cuckoo->bucket_bits));
+	*fp = (uint32_t)(hash >> 32) >> (32U - cuckoo->fp_bits);
+	if (!*fp)
+		*fp = 1;
+}
+
+/*
+ * Compute alternate bucket index. This is an involution so that the original
+ * bucket may be recovered from the fingerprint and the alternate bucket only.
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+unsigned int
+stroll_cuckoo_alt(const struct stroll_cuckoo * __restrict cuckoo,
+                  unsigned int                            bucket,
+                  uint32_t                                fp)
+{
+	return bucket ^ stroll_hash32(fp, cuckoo->bucket_bits);
+}
+
+/*
+ * Find the slot holding the given fingerprint within the given bucket.
+ *
+ * Fingerprints narrower than 32 bits are matched using SWAR techniques, i.e.
+ * the whole bucket is loaded at once and searched for a zero lane once xor'ed
+ * with the broadcast fingerprint.
+ */
+static __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+int
+stroll_cuckoo_find(const struct stroll_cuckoo * __restrict cuckoo,
+                   unsigned int                            bucket,
+                   uint32_t                                fp)
+{
+	unsigned int slot = bucket * STROLL_CUCKOO_BUCKET_SLOTS;
+	unsigned int s;
+
+	compile_assert(STROLL_CUCKOO_BUCKET_SLOTS == 4);
+
+	switch (cuckoo->fp_bits) {
+	case 8:
+		{
+			uint32_t blk;
+
+			memcpy(&blk, &((const uint8_t *)cuckoo->slots)[slot],
+			       sizeof(blk));
+			blk ^= fp * UINT32_C(0x01010101);
+			blk = (blk - UINT32_C(0x01010101)) & ~blk &
+			      UINT32_C(0x80808080);
+			if (!blk)
+				return -ENOENT;
+			break;
+		}
+
+	case 16:
+		{
+			uint64_t blk;
+
+			memcpy(&blk, &((const uint16_t *)cuckoo->slots)[slot],
+			       sizeof(blk));
+			blk ^= fp * UINT64_C(0x0001000100010001);
+			blk = (blk - UINT64_C(0x0001000100010001)) & ~blk &
+			      UINT64_C(0x8000800080008000);
+			if (!blk)
+				return -ENOENT;
+			break;
+		}
+
+	default:
+		break;
+	}
+
+	/* Locate the exact matching slot. */
+	for (s = 0; s < STROLL_CUCKOO_BUCKET_SLOTS; s++)
+		if (stroll_cuckoo_get(cuckoo, slot + s) == fp)
+			return (int)(slot + s);
+
+	return -ENOENT;
+}
+
+static __stroll_nonull(1) __stroll_nothrow __warn_result
+bool
+stroll_cuckoo_put(struct stroll_cuckoo * __restrict cuckoo,
+                  unsigned int                      bucket,
+                  uint32_t                          fp)
+{
+	int slot;
+
+	slot = stroll_cuckoo_find(cuckoo, bucket, 0);
+	if (slot < 0)
+		return false;
+
+	stroll_cuckoo_set(cuckoo, (unsigned int)slot, fp);
+
+	return true;
+}
+
+int
+stroll_cuckoo_insert(struct stroll_cuckoo * __restrict cuckoo, uint64_t key)
+{
+	stroll_cuckoo_assert_filter_api(cuckoo);
+
+	unsigned int bucket;
+	uint32_t     fp;
+	unsigned int path[STROLL_CUCKOO_KICK_MAX];
+	unsigned int k;
+
+	stroll_cuckoo_hash(cuckoo, key, &bucket, &fp);
+	if (stroll_cuckoo_put(cuckoo, bucket, fp))
+		goto inserted;
+
+	bucket = stroll_cuckoo_alt(cuckoo, bucket, fp);
+	if (stroll_cuckoo_put(cuckoo, bucket, fp))
+		goto inserted;
+
+	/*
+	 * Both candidate buckets are full: kick a victim out of the current
+	 * bucket and try to relocate it into its own alternate bucket. Record
+	 * the path followed so that relocations may be undone on failure.
+	 */
+	for (k = 0; k < STROLL_CUCKOO_KICK_MAX; k++) {
+		unsigned int slot;
+		uint32_t     victim;
+
+		slot = (bucket * STROLL_CUCKOO_BUCKET_SLOTS) +
+		       ((fp + k) % STROLL_CUCKOO_BUCKET_SLOTS);
+		victim = stroll_cuckoo_get(cuckoo, slot);
+		stroll_cuckoo_set(cuckoo, slot, fp);
+		path[k] = slot;
+
+		fp = victim;
+		bucket = stroll_cuckoo_alt(cuckoo, bucket, fp);
+		if (stroll_cuckoo_put(cuckoo, bucket, fp))
+			goto inserted;
+	}
+
+	/* Walk the relocation path backward to restore original content. */
+	while (k--) {
+		uint32_t victim = stroll_cuckoo_get(cuckoo, path[k]);
+
+		stroll_cuckoo_set(cuckoo, path[k], fp);
+		fp = victim;
+	}
+
+	return -ENOSPC;
+
+inserted:
+	cuckoo->nr++;
+
+	return 0;
+}
+
+bool
+stroll_cuckoo_test(const struct stroll_cuckoo * __restrict cuckoo,
+                   uint64_t                                key)
+{
+	stroll_cuckoo_assert_filter_api(cuckoo);
+
+	unsigned int bucket;
+	uint32_t     fp;
+
+	stroll_cuckoo_hash(cuckoo, key, &bucket, &fp);
+	if (stroll_cuckoo_find(cuckoo, bucket, fp) >= 0)
+		return true;
+
+	return stroll_cuckoo_find(cuckoo,
+	                          stroll_cuckoo_alt(cuckoo, bucket, fp),
+	                          fp) >= 0;
+}
+
+int
+stroll_cuckoo_delete(struct stroll_cuckoo * __restrict cuckoo, uint64_t key)
+{
+	stroll_cuckoo_assert_filter_api(cuckoo);
+
+	unsigned int bucket;
+	uint32_t     fp;
+	int          slot;
+
+	stroll_cuckoo_hash(cuckoo, key, &bucket, &fp);
+	slot = stroll_cuckoo_find(cuckoo, bucket, fp);
+	if (slot < 0) {
+		slot = stroll_cuckoo_find(cuckoo,
+		                          stroll_cuckoo_alt(cuckoo, bucket, fp),
+		                          fp);
+		if (slot < 0)
+			return slot;
+	}
+
+	stroll_cuckoo_set(cuckoo, (unsigned int)slot, 0);
+	cuckoo->nr--;
+
+	return 0;
+}
+
+static __const __nothrow __warn_result
+size_t
+stroll_cuckoo_size(unsigned int bucket_bits, unsigned int fp_bits)
+{
+	return ((size_t)STROLL_CUCKOO_BUCKET_SLOTS << bucket_bits) *
+	       (fp_bits / CHAR_BIT);
+}
+
+void
+stroll_cuckoo_clear(struct stroll_cuckoo * __restrict cuckoo)
+{
+	stroll_cuckoo_assert_filter_api(cuckoo);
+
+	memset(cuckoo->slots,
+	       0,
+	       stroll_cuckoo_size(cuckoo->bucket_bits, cuckoo->fp_bits));
+	cuckoo->nr = 0;
+}
+
+int
+stroll_cuckoo_init(struct stroll_cuckoo * __restrict cuckoo,
+                   unsigned int                      capacity,
+                   double                            fpr)
+{
+	stroll_cuckoo_assert_api(cuckoo);
+	stroll_cuckoo_assert_api(capacity);
+	stroll_cuckoo_assert_api(fpr > 0.0);
+	stroll_cuckoo_assert_api(fpr < 1.0);
+
+	uint64_t     bucket_nr;
+	unsigned int bucket_bits;
+	unsigned int fp_bits;
+	size_t       sz;
+
+	/* Round number of buckets up to a 95% maximum load factor. */
+	bucket_nr = (((uint64_t)capacity * 100U) +
+	             (STROLL_CUCKOO_BUCKET_SLOTS * 95U) - 1) /
+	            (STROLL_CUCKOO_BUCKET_SLOTS * 95U);
+	bucket_bits = (bucket_nr > 2) ? stroll_pow2_up64(bucket_nr) : 1;
+	if (bucket_bits > STROLL_CUCKOO_BUCKET_BITS_MAX)
+		return -ERANGE;
+
+	/*
+	 * Select the smallest fingerprint width such that
+	 * 2 * STROLL_CUCKOO_BUCKET_SLOTS / 2^fp_bits <= fpr, restricting 8-bit
+	 * fingerprints to tables small enough for them to reach all alternate
+	 * buckets.
+	 */
+	fp_bits = (bucket_bits <= STROLL_CUCKOO_FP8_BUCKET_BITS_MAX) ? 8 : 16;
+	for (; fp_bits <= 32; fp_bits *= 2) {
+		double rate = (double)(2 * STROLL_CUCKOO_BUCKET_SLOTS) /
+		              (double)(UINT64_C(1) << fp_bits);
+
+		if (rate <= fpr)
+			break;
+	}
+	if (fp_bits > 32)
+		return -ERANGE;
+
+	sz = stroll_cuckoo_size(bucket_bits, fp_bits);
+	cuckoo->slots = malloc(sz);
+	if (!cuckoo->slots)
+		return -errno;
+
+	memset(cuckoo->slots, 0, sz);
+	cuckoo->nr = 0;
+	cuckoo->bucket_bits = bucket_bits;
+	cuckoo->fp_bits = fp_bits;
+
+	return 0;
+}
+
+void
+stroll_cuckoo_fini(struct stroll_cuckoo * __restrict cuckoo)
+{
+	stroll_cuckoo_assert_filter_api(cuckoo);
+
+	free(cuckoo->slots);
+}
@@ -42,6 +42,9 @@ libstroll.so-objs    := shared/page.o
 libstroll.so-objs    += $(call kconf_enabled,STROLL_ASSERT,shared/assert.o)
 libstroll.so-objs    += $(call kconf_enabled,STROLL_POW2,shared/pow2.o)
 libstroll.so-objs    += $(call kconf_enabled,STROLL_FBMAP,shared/fbmap.o)
+libstroll.so-objs    += $(call kconf_enabled,STROLL_HBMAP,shared/hbmap.o)
+libstroll.so-objs    += $(call kconf_enabled,STROLL_IDALLOC,shared/idalloc.o)
+libstroll.so-objs    += $(call kconf_enabled,STROLL_RBMAP,shared/rbmap.o)
 libstroll.so-objs    += $(call kconf_enabled,STROLL_LVSTR,shared/lvstr.o)
 libstroll.so-objs    += $(call kconf_enabled,STROLL_ARRAY,shared/array.o)
 ifneq ($(filter y,$(CONFIG_STROLL_FBHEAP) $(CONFIG_STROLL_ARRAY_FBHEAP_SORT)),)
@@ -63,15 +66,24 @@ libstroll.so-objs    += $(call kconf_enabled,STROLL_PALLOC,shared/palloc.o)
 libstroll.so-objs    += $(call kconf_enabled,STROLL_LALLOC,shared/lalloc.o)
 libstroll.so-objs    += $(call kconf_enabled,STROLL_FALLOC,shared/falloc.o)
 libstroll.so-objs    += $(call kconf_enabled,STROLL_MSG,shared/message.o)
+libstroll.so-objs    += $(call kconf_enabled,STROLL_BLOOM,shared/bloom.o)
+libstroll.so-objs    += $(call kconf_enabled,STROLL_CUCKOO,shared/cuckoo.o)
+libstroll.so-objs    += $(call kconf_enabled,STROLL_HLL,shared/hll.o)
+libstroll.so-objs    += $(call kconf_enabled,STROLL_CMSKETCH,shared/cmsketch.o)
 libstroll.so-cflags  := $(filter-out -fpie -fPIE,$(common-cflags)) -fpic
 libstroll.so-ldflags := $(filter-out -pie -fpie -fPIE,$(common-ldflags)) \
                         -shared -Bsymbolic -fpic -Wl,-soname,libstroll.so
+libstroll.so-ldflags += $(call kconf_enabled,STROLL_ARRAY_MT_UTILS,\
+                               -pthread)
 
 arlibs               := libstroll.a
 libstroll.a-objs     := static/page.o
 libstroll.a-objs     += $(call kconf_enabled,STROLL_ASSERT,static/assert.o)
 libstroll.a-objs     += $(call kconf_enabled,STROLL_POW2,static/pow2.o)
 libstroll.a-objs     += $(call kconf_enabled,STROLL_FBMAP,static/fbmap.o)
+libstroll.a-objs     += $(call kconf_enabled,STROLL_HBMAP,static/hbmap.o)
+libstroll.a-objs     += $(call kconf_enabled,STROLL_IDALLOC,static/idalloc.o)
+libstroll.a-objs     += $(call kconf_enabled,STROLL_RBMAP,static/rbmap.o)
 libstroll.a-objs     += $(call kconf_enabled,STROLL_LVSTR,static/lvstr.o)
 libstroll.a-objs     += $(call kconf_enabled,STROLL_ARRAY,static/array.o)
 ifneq ($(filter y,$(CONFIG_STROLL_FBHEAP) $(CONFIG_STROLL_ARRAY_FBHEAP_SORT)),)
@@ -93,6 +105,10 @@ libstroll.a-objs     += $(call kconf_enabled,STROLL_PALLOC,static/palloc.o)
 libstroll.a-objs     += $(call kconf_enabled,STROLL_LALLOC,static/lalloc.o)
 libstroll.a-objs     += $(call kconf_enabled,STROLL_FALLOC,static/falloc.o)
 libstroll.a-objs     += $(call kconf_enabled,STROLL_MSG,static/message.o)
+libstroll.a-objs     += $(call kconf_enabled,STROLL_BLOOM,static/bloom.o)
+libstroll.a-objs     += $(call kconf_enabled,STROLL_CUCKOO,static/cuckoo.o)
+libstroll.a-objs     += $(call kconf_enabled,STROLL_HLL,static/hll.o)
+libstroll.a-objs     += $(call kconf_enabled,STROLL_CMSKETCH,static/cmsketch.o)
 libstroll.a-cflags   := $(common-cflags)
 
 # ex: filetype=make :
@@ -7,7 +7,15 @@
 
 #include "stroll/fbmap.h"
 #include "stroll/bops.h"
+#include "stroll/page.h"
 #include <errno.h>
+#include <sys/mman.h>
+
+#if defined(CONFIG_STROLL_FBMAP_FILE)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif /* defined(CONFIG_STROLL_FBMAP_FILE) */
 
 #define stroll_fbmap_assert_range(_bits, _start_bit, _bit_count) \
 	stroll_fbmap_assert_api(_bits); \
@@ -37,281 +45,2583 @@ stroll_fbmap_word_low_mask(unsigned int bit_no)
 	return ~(0UL) >> (__WORDSIZE - 1 - stroll_fbmap_word_bit_no(bit_no));
 }
 
-unsigned int
-_stroll_fbmap_hweight(const unsigned long * __restrict bits, unsigned int nr)
-{
-	stroll_fbmap_assert_api(bits);
+/******************************************************************************
+ * Bulk word kernels
+ ******************************************************************************/
 
-	unsigned int w, hw = 0;
+/*
+ * Bulk operations are split into a kernel processing a whole number of words
+ * and scalar code dealing with partial head / tail words. Kernels are selected
+ * at load time according to instruction set extensions the CPU supports.
+ */
+struct stroll_fbmap_kernels {
+	unsigned int (*hweight)(const unsigned long * __restrict bits,
+	                        unsigned int                     nr);
+	bool         (*test)(const unsigned long * __restrict bits,
+	                     unsigned int                     nr);
+	void         (*toggle)(unsigned long * __restrict bits,
+	                       unsigned int               nr);
+	void         (*and)(unsigned long *       result,
+	                    const unsigned long * first,
+	                    const unsigned long * second,
+	                    unsigned int          nr);
+	void         (*or)(unsigned long *       result,
+	                   const unsigned long * first,
+	                   const unsigned long * second,
+	                   unsigned int          nr);
+	void         (*xor)(unsigned long *       result,
+	                    const unsigned long * first,
+	                    const unsigned long * second,
+	                    unsigned int          nr);
+	void         (*andnot)(unsigned long *       result,
+	                       const unsigned long * first,
+	                       const unsigned long * second,
+	                       unsigned int          nr);
+	unsigned int (*hweight_and)(const unsigned long * __restrict first,
+	                            const unsigned long * __restrict second,
+	                            unsigned int                     nr);
+	bool         (*test_and)(const unsigned long * __restrict first,
+	                         const unsigned long * __restrict second,
+	                         unsigned int                     nr);
+	bool         (*test_andnot)(const unsigned long * __restrict first,
+	                            const unsigned long * __restrict second,
+	                            unsigned int                     nr);
+	unsigned int (*extract)(uint32_t * __restrict            indices,
+	                        unsigned int                     max,
+	                        const unsigned long * __restrict bits,
+	                        unsigned int * __restrict        nr,
+	                        uint32_t                         base);
+};
 
-	for (w = 0; w < (stroll_fbmap_word_nr(nr) - 1); w++)
-		hw += stroll_bops_hweightul(bits[w]);
+/*
+ * Binary operation kernels generators.
+ *
+ * Result of binary operations may be stored into one of the operands: result
+ * words are computed from operand words located at the same index only, hence
+ * pointers are not restricted.
+ */
+#define STROLL_FBMAP_DEFINE_BINOP_SCALAR(_func, _op) \
+	static __stroll_nonull(1, 2, 3) __stroll_nothrow \
+	void \
+	_func(unsigned long *       result, \
+	      const unsigned long * first, \
+	      const unsigned long * second, \
+	      unsigned int          nr) \
+	{ \
+		unsigned int w; \
+		\
+		for (w = 0; w < nr; w++) \
+			result[w] = _op(first[w], second[w]); \
+	}
 
-	return hw +
-	       stroll_bops_hweightul(bits[w] &
-	                             stroll_fbmap_word_low_mask(nr - 1));
-}
+#define STROLL_FBMAP_DEFINE_TEST_BINOP_SCALAR(_func, _op) \
+	static __stroll_nonull(1, 2) __stroll_pure __stroll_nothrow \
+	       __warn_result \
+	bool \
+	_func(const unsigned long * __restrict first, \
+	      const unsigned long * __restrict second, \
+	      unsigned int                     nr) \
+	{ \
+		unsigned int w; \
+		\
+		for (w = 0; w < nr; w++) \
+			if (_op(first[w], second[w])) \
+				return true; \
+		\
+		return false; \
+	}
 
-bool
-_stroll_fbmap_test_range(const unsigned long * __restrict bits,
-                         unsigned int                     start_bit,
-                         unsigned int                     bit_count)
-{
-	stroll_fbmap_assert_range(bits, start_bit, bit_count);
+#define stroll_fbmap_and_word(_first, _second) \
+	((_first) & (_second))
 
-	unsigned int  stop_bit = start_bit + bit_count - 1;
-	unsigned int  curr = stroll_fbmap_word_no(start_bit);
-	unsigned int  last = stroll_fbmap_word_no(stop_bit);
-	unsigned long msb = stroll_fbmap_word_high_mask(start_bit);
-	unsigned long lsb = stroll_fbmap_word_low_mask(stop_bit);
+#define stroll_fbmap_or_word(_first, _second) \
+	((_first) | (_second))
 
-	if (curr != last) {
-		/*
-		 * Mask out unwanted least significant bits and check if 0 or
-		 * not.
-		 */
-		if (bits[curr++] & msb)
-			return true;
-	}
-	else
-		/*
-		 * Range applies to a single word only: mask out unwanted most
-		 * and least significant bits and check if 0 or not.
-		 */
-		return !!(bits[curr] & msb & lsb);
+#define stroll_fbmap_xor_word(_first, _second) \
+	((_first) ^ (_second))
 
-	/* Iterate over all remaining words but the last and test if 0. */
-	while (curr < last)
-		if (bits[curr++])
-			return true;
+#define stroll_fbmap_andnot_word(_first, _second) \
+	((_first) & ~(_second))
 
-	/*
-	 * Mask out last word's unwanted most significant bits and check if 0 or
-	 * not.
-	 */
-	return !!(bits[curr] & lsb);
+static __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+unsigned int
+stroll_fbmap_hweight_scalar(const unsigned long * __restrict bits,
+                            unsigned int                     nr)
+{
+	unsigned int w, hw = 0;
+
+	for (w = 0; w < nr; w++)
+		hw += stroll_bops_hweightul(bits[w]);
+
+	return hw;
 }
 
+static __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
 bool
-_stroll_fbmap_test_all(const unsigned long * __restrict bits, unsigned int nr)
+stroll_fbmap_test_scalar(const unsigned long * __restrict bits,
+                         unsigned int                     nr)
 {
-	stroll_fbmap_assert_bits_api(bits, nr);
-
 	unsigned int w;
 
-	for (w = 0; w < (stroll_fbmap_word_nr(nr) - 1); w++) {
+	for (w = 0; w < nr; w++)
 		if (bits[w])
 			return true;
-	}
-
-	if (bits[w] & stroll_fbmap_word_low_mask(nr - 1))
-		return true;
 
 	return false;
 }
 
+static __stroll_nonull(1) __stroll_nothrow
 void
-_stroll_fbmap_toggle_all(unsigned long * __restrict bits, unsigned int nr)
+stroll_fbmap_toggle_scalar(unsigned long * __restrict bits, unsigned int nr)
 {
-	stroll_fbmap_assert_bits_api(bits, nr);
-
 	unsigned int w;
 
-	for (w = 0; w < stroll_fbmap_word_nr(nr); w++)
+	for (w = 0; w < nr; w++)
 		bits[w] = ~bits[w];
 }
 
-unsigned long *
-_stroll_fbmap_create_bits_clear(unsigned int bit_nr)
-{
-	stroll_fbmap_assert_api(bit_nr);
-	stroll_fbmap_assert_api(bit_nr <= (unsigned int)INT_MAX);
-
-	unsigned long * bits;
-	unsigned int    sz = stroll_fbmap_word_nr(bit_nr) * sizeof(bits[0]);
+STROLL_FBMAP_DEFINE_BINOP_SCALAR(stroll_fbmap_and_scalar,
+                                 stroll_fbmap_and_word)
+STROLL_FBMAP_DEFINE_BINOP_SCALAR(stroll_fbmap_or_scalar,
+                                 stroll_fbmap_or_word)
+STROLL_FBMAP_DEFINE_BINOP_SCALAR(stroll_fbmap_xor_scalar,
+                                 stroll_fbmap_xor_word)
+STROLL_FBMAP_DEFINE_BINOP_SCALAR(stroll_fbmap_andnot_scalar,
+                                 stroll_fbmap_andnot_word)
 
-	bits = malloc(sz);
-	if (!bits)
-		return NULL;
+static __stroll_nonull(1, 2) __stroll_pure __stroll_nothrow __warn_result
+unsigned int
+stroll_fbmap_hweight_and_scalar(const unsigned long * __restrict first,
+                                const unsigned long * __restrict second,
+                                unsigned int                     nr)
+{
+	unsigned int w, hw = 0;
 
-	memset(bits, 0, sz);
+	for (w = 0; w < nr; w++)
+		hw += stroll_bops_hweightul(first[w] & second[w]);
 
-	return bits;
+	return hw;
 }
 
-int
-stroll_fbmap_init_clear(struct stroll_fbmap * __restrict bmap,
-                        unsigned int                     bit_nr)
+STROLL_FBMAP_DEFINE_TEST_BINOP_SCALAR(stroll_fbmap_test_and_scalar,
+                                      stroll_fbmap_and_word)
+STROLL_FBMAP_DEFINE_TEST_BINOP_SCALAR(stroll_fbmap_test_andnot_scalar,
+                                      stroll_fbmap_andnot_word)
+
+/*
+ * Set bit extraction kernels.
+ *
+ * Decode indices of bits set into the nr words given in argument, base being
+ * the index of the first bit of the first word. Kernels stop before the first
+ * word the indices array has not enough room left for, update nr with the
+ * number of words fully decoded and return the number of indices stored.
+ * Kernels may store garbage beyond the returned count, within the limits of
+ * max entries though.
+ */
+static __stroll_nonull(1, 3, 4) __stroll_nothrow __warn_result
+unsigned int
+stroll_fbmap_extract_scalar(uint32_t * __restrict            indices,
+                            unsigned int                     max,
+                            const unsigned long * __restrict bits,
+                            unsigned int * __restrict        nr,
+                            uint32_t                         base)
 {
-	stroll_fbmap_assert_api(bmap);
-	stroll_fbmap_assert_api(bit_nr);
-	stroll_fbmap_assert_api(bit_nr <= (unsigned int)INT_MAX);
+	unsigned int cnt = 0;
+	unsigned int w;
 
-	bmap->bits = _stroll_fbmap_create_bits_clear(bit_nr);
-	if (!bmap->bits)
-		return -errno;
+	for (w = 0; w < *nr; w++, base += __WORDSIZE) {
+		unsigned long word = bits[w];
 
-	bmap->nr = bit_nr;
+		if (stroll_bops_hweightul(word) > (max - cnt))
+			break;
 
-	return 0;
-}
+		/* Isolate lowest bit set, then clear it (TZCNT / BLSR). */
+		while (word) {
+			indices[cnt++] = base + (uint32_t)__builtin_ctzl(word);
+			word &= word - 1;
+		}
+	}
 
-unsigned long *
-_stroll_fbmap_create_bits_set(unsigned int bit_nr)
-{
-	stroll_fbmap_assert_api(bit_nr);
-	stroll_fbmap_assert_api(bit_nr <= (unsigned int)INT_MAX);
+	*nr = w;
 
-	unsigned long * bits;
-	unsigned int    sz = stroll_fbmap_word_nr(bit_nr) * sizeof(bits[0]);
+	return cnt;
+}
 
-	bits = malloc(sz);
-	if (!bits)
-		return NULL;
+#if defined(CONFIG_STROLL_FBMAP_SIMD) && defined(__x86_64__)
 
-	memset(bits, 0xff, sz);
+#include <immintrin.h>
 
-	return bits;
-}
+#define __stroll_fbmap_sse \
+	__attribute__((target("sse4.2,popcnt")))
 
-int
-stroll_fbmap_init_set(struct stroll_fbmap * __restrict bmap,
-                      unsigned int                     bit_nr)
-{
-	stroll_fbmap_assert_api(bmap);
-	stroll_fbmap_assert_api(bit_nr);
-	stroll_fbmap_assert_api(bit_nr <= (unsigned int)INT_MAX);
+#define __stroll_fbmap_avx2 \
+	__attribute__((target("avx2,popcnt")))
 
-	bmap->bits = _stroll_fbmap_create_bits_set(bit_nr);
-	if (!bmap->bits)
-		return -errno;
+#define __stroll_fbmap_avx512 \
+	__attribute__((target("avx512f,avx512vpopcntdq")))
 
-	bmap->nr = bit_nr;
+/*
+ * SSE 4.2 kernels.
+ *
+ * Hamming weight relies upon the POPCNT instruction, which is available on all
+ * SSE 4.2 capable processors, 4 words at a time to hide its latency.
+ */
+static __stroll_fbmap_sse __stroll_nonull(1) __stroll_pure __stroll_nothrow
+       __warn_result
+unsigned int
+stroll_fbmap_hweight_sse(const unsigned long * __restrict bits,
+                         unsigned int                     nr)
+{
+	unsigned long long hw0 = 0, hw1 = 0, hw2 = 0, hw3 = 0;
+	unsigned int       w;
+
+	for (w = 0; (w + 4) <= nr; w += 4) {
+		hw0 += (unsigned long long)_mm_popcnt_u64(bits[w]);
+		hw1 += (unsigned long long)_mm_popcnt_u64(bits[w + 1]);
+		hw2 += (unsigned long long)_mm_popcnt_u64(bits[w + 2]);
+		hw3 += (unsigned long long)_mm_popcnt_u64(bits[w + 3]);
+	}
+	for (; w < nr; w++)
+		hw0 += (unsigned long long)_mm_popcnt_u64(bits[w]);
 
-	return 0;
+	return (unsigned int)(hw0 + hw1 + hw2 + hw3);
 }
 
-unsigned long *
-_stroll_fbmap_create_bits_dup(unsigned long * __restrict src,
-                              unsigned int               bit_nr)
+static __stroll_fbmap_sse __stroll_nonull(1) __stroll_pure __stroll_nothrow
+       __warn_result
+bool
+stroll_fbmap_test_sse(const unsigned long * __restrict bits, unsigned int nr)
 {
-	stroll_fbmap_assert_api(src);
-	stroll_fbmap_assert_api(bit_nr);
-	stroll_fbmap_assert_api(bit_nr <= (unsigned int)INT_MAX);
+	const __m128i * vec = (const __m128i *)bits;
+	unsigned int    v;
+
+	/* Process 4 vectors, i.e. 8 words, per iteration. */
+	for (v = 0; (v + 4) <= (nr / 2); v += 4) {
+		__m128i acc = _mm_or_si128(
+			_mm_or_si128(_mm_loadu_si128(&vec[v]),
+			             _mm_loadu_si128(&vec[v + 1])),
+			_mm_or_si128(_mm_loadu_si128(&vec[v + 2]),
+			             _mm_loadu_si128(&vec[v + 3])));
+
+		if (!_mm_testz_si128(acc, acc))
+			return true;
+	}
 
-	unsigned long * bits;
-	unsigned int    sz = stroll_fbmap_word_nr(bit_nr) * sizeof(bits[0]);
+	return stroll_fbmap_test_scalar(&bits[v * 2], nr - (v * 2));
+}
 
-	bits = malloc(sz);
-	if (!bits)
-		return NULL;
+static __stroll_fbmap_sse __stroll_nonull(1) __stroll_nothrow
+void
+stroll_fbmap_toggle_sse(unsigned long * __restrict bits, unsigned int nr)
+{
+	__m128i *    vec = (__m128i *)bits;
+	__m128i      ones = _mm_set1_epi32(-1);
+	unsigned int v;
 
-	memcpy(bits, src, sz);
+	for (v = 0; v < (nr / 2); v++)
+		_mm_storeu_si128(&vec[v],
+		                 _mm_xor_si128(_mm_loadu_si128(&vec[v]), ones));
 
-	return bits;
+	stroll_fbmap_toggle_scalar(&bits[v * 2], nr - (v * 2));
 }
 
-int
-stroll_fbmap_init_dup(struct stroll_fbmap * __restrict       bmap,
-                      const struct stroll_fbmap * __restrict src)
-{
-	stroll_fbmap_assert_api(bmap);
-	stroll_fbmap_assert_map_api(src);
+#define STROLL_FBMAP_DEFINE_BINOP_SSE(_func, _op, _scalar_func) \
+	static __stroll_fbmap_sse __stroll_nonull(1, 2, 3) __stroll_nothrow \
+	void \
+	_func(unsigned long *       result, \
+	      const unsigned long * first, \
+	      const unsigned long * second, \
+	      unsigned int          nr) \
+	{ \
+		unsigned int w; \
+		\
+		for (w = 0; (w + 2) <= nr; w += 2) \
+			_mm_storeu_si128( \
+				(__m128i *)&result[w], \
+				_op(_mm_loadu_si128( \
+				            (const __m128i *)&first[w]), \
+				    _mm_loadu_si128( \
+				            (const __m128i *)&second[w]))); \
+		\
+		_scalar_func(&result[w], &first[w], &second[w], nr - w); \
+	}
 
-	bmap->bits = _stroll_fbmap_create_bits_dup(src->bits, src->nr);
-	if (!bmap->bits)
-		return -errno;
+/*
+ * Test kernels combine 4 vectors, i.e. 8 words, per iteration before checking
+ * for early exit.
+ */
+#define STROLL_FBMAP_DEFINE_TEST_BINOP_SSE(_func, _op, _scalar_func) \
+	static __stroll_fbmap_sse __stroll_nonull(1, 2) __stroll_pure \
+	       __stroll_nothrow __warn_result \
+	bool \
+	_func(const unsigned long * __restrict first, \
+	      const unsigned long * __restrict second, \
+	      unsigned int                     nr) \
+	{ \
+		const __m128i * fst = (const __m128i *)first; \
+		const __m128i * snd = (const __m128i *)second; \
+		unsigned int    v; \
+		\
+		for (v = 0; (v + 4) <= (nr / 2); v += 4) { \
+			__m128i acc = _mm_or_si128( \
+				_mm_or_si128( \
+					_op(_mm_loadu_si128(&fst[v]), \
+					    _mm_loadu_si128(&snd[v])), \
+					_op(_mm_loadu_si128(&fst[v + 1]), \
+					    _mm_loadu_si128(&snd[v + 1]))), \
+				_mm_or_si128( \
+					_op(_mm_loadu_si128(&fst[v + 2]), \
+					    _mm_loadu_si128(&snd[v + 2])), \
+					_op(_mm_loadu_si128(&fst[v + 3]), \
+					    _mm_loadu_si128(&snd[v + 3])))); \
+			\
+			if (!_mm_testz_si128(acc, acc)) \
+				return true; \
+		} \
+		\
+		return _scalar_func(&first[v * 2], \
+		                    &second[v * 2], \
+		                    nr - (v * 2)); \
+	}
 
-	bmap->nr = src->nr;
+/* ANDN intrinsics complement their first operand. */
+#define stroll_fbmap_sse_andnot(_first, _second) \
+	_mm_andnot_si128(_second, _first)
+
+STROLL_FBMAP_DEFINE_BINOP_SSE(stroll_fbmap_and_sse,
+                              _mm_and_si128,
+                              stroll_fbmap_and_scalar)
+STROLL_FBMAP_DEFINE_BINOP_SSE(stroll_fbmap_or_sse,
+                              _mm_or_si128,
+                              stroll_fbmap_or_scalar)
+STROLL_FBMAP_DEFINE_BINOP_SSE(stroll_fbmap_xor_sse,
+                              _mm_xor_si128,
+                              stroll_fbmap_xor_scalar)
+STROLL_FBMAP_DEFINE_BINOP_SSE(stroll_fbmap_andnot_sse,
+                              stroll_fbmap_sse_andnot,
+                              stroll_fbmap_andnot_scalar)
+
+static __stroll_fbmap_sse __stroll_nonull(1, 2) __stroll_pure __stroll_nothrow
+       __warn_result
+unsigned int
+stroll_fbmap_hweight_and_sse(const unsigned long * __restrict first,
+                             const unsigned long * __restrict second,
+                             unsigned int                     nr)
+{
+	unsigned long long hw0 = 0, hw1 = 0, hw2 = 0, hw3 = 0;
+	unsigned int       w;
+
+	for (w = 0; (w + 4) <= nr; w += 4) {
+		hw0 += (unsigned long long)_mm_popcnt_u64(first[w] &
+		                                          second[w]);
+		hw1 += (unsigned long long)_mm_popcnt_u64(first[w + 1] &
+		                                          second[w + 1]);
+		hw2 += (unsigned long long)_mm_popcnt_u64(first[w + 2] &
+		                                          second[w + 2]);
+		hw3 += (unsigned long long)_mm_popcnt_u64(first[w + 3] &
+		                                          second[w + 3]);
+	}
+	for (; w < nr; w++)
+		hw0 += (unsigned long long)_mm_popcnt_u64(first[w] & second[w]);
 
-	return 0;
+	return (unsigned int)(hw0 + hw1 + hw2 + hw3);
 }
 
-#define stroll_fbmap_assert_iter(_iter) \
-	stroll_fbmap_assert_api(_iter); \
-	stroll_fbmap_assert_bits_api((_iter)->bits, (_iter)->nr); \
-	stroll_fbmap_assert_api((_iter)->curr < stroll_fbmap_word_nr(iter->nr))
+STROLL_FBMAP_DEFINE_TEST_BINOP_SSE(stroll_fbmap_test_and_sse,
+                                   _mm_and_si128,
+                                   stroll_fbmap_test_and_scalar)
+STROLL_FBMAP_DEFINE_TEST_BINOP_SSE(stroll_fbmap_test_andnot_sse,
+                                   stroll_fbmap_sse_andnot,
+                                   stroll_fbmap_test_andnot_scalar)
 
-int
-stroll_fbmap_step_iter_set(struct stroll_fbmap_iter * __restrict iter)
+/*
+ * AVX2 kernels.
+ *
+ * Hamming weight is computed using the vectorized nibble lookup table
+ * technique described by Wojciech Muła et al. in "Faster Population Counts
+ * Using AVX2 Instructions": per byte counts are computed with VPSHUFB then
+ * horizontally summed into 64-bit lanes using VPSADBW.
+ */
+static inline __stroll_fbmap_avx2 __stroll_nothrow __warn_result
+__m256i
+stroll_fbmap_popcnt_avx2(__m256i vec)
 {
-	stroll_fbmap_assert_iter(iter);
-
-	unsigned int bit_no;
+	const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3,
+	                                     1, 2, 2, 3, 2, 3, 3, 4,
+	                                     0, 1, 1, 2, 1, 2, 2, 3,
+	                                     1, 2, 2, 3, 2, 3, 3, 4);
+	const __m256i low = _mm256_set1_epi8(0x0f);
+	__m256i       lo = _mm256_and_si256(vec, low);
+	__m256i       hi = _mm256_and_si256(_mm256_srli_epi16(vec, 4), low);
+
+	return _mm256_add_epi8(_mm256_shuffle_epi8(lut, lo),
+	                       _mm256_shuffle_epi8(lut, hi));
+}
 
-	while (!iter->word) {
-		if (++iter->curr >= stroll_fbmap_word_nr(iter->nr))
-			return -ENOENT;
+static __stroll_fbmap_avx2 __stroll_nonull(1) __stroll_pure __stroll_nothrow
+       __warn_result
+unsigned int
+stroll_fbmap_hweight_avx2(const unsigned long * __restrict bits,
+                          unsigned int                     nr)
+{
+	const __m256i * vec = (const __m256i *)bits;
+	__m256i         acc = _mm256_setzero_si256();
+	unsigned int    v;
+	unsigned int    hw;
 
-		iter->word = iter->bits[iter->curr];
+	/*
+	 * Per byte counts of 2 vectors cannot exceed 16: sum them before
+	 * reducing to 64-bit lanes.
+	 */
+	for (v = 0; (v + 2) <= (nr / 4); v += 2) {
+		__m256i cnt = _mm256_add_epi8(
+			stroll_fbmap_popcnt_avx2(_mm256_loadu_si256(&vec[v])),
+			stroll_fbmap_popcnt_avx2(
+				_mm256_loadu_si256(&vec[v + 1])));
+
+		acc = _mm256_add_epi64(acc,
+		                       _mm256_sad_epu8(cnt,
+		                                       _mm256_setzero_si256()));
 	}
 
-	bit_no = stroll_bops_ffsul(iter->word) - 1;
-	iter->word &= ~(1UL << bit_no);
-
-	bit_no += (iter->curr * __WORDSIZE);
-	if (bit_no >= iter->nr)
-		return -ENOENT;
+	hw = (unsigned int)(_mm256_extract_epi64(acc, 0) +
+	                    _mm256_extract_epi64(acc, 1) +
+	                    _mm256_extract_epi64(acc, 2) +
+	                    _mm256_extract_epi64(acc, 3));
+	for (v *= 4; v < nr; v++)
+		hw += (unsigned int)_mm_popcnt_u64(bits[v]);
 
-	return (int)bit_no;
+	return hw;
 }
 
-int
-_stroll_fbmap_init_range_iter_set(
-	struct stroll_fbmap_iter * __restrict iter,
-	const unsigned long * __restrict      bits,
-	unsigned int                          start_bit,
-	unsigned int                          bit_count)
+static __stroll_fbmap_avx2 __stroll_nonull(1) __stroll_pure __stroll_nothrow
+       __warn_result
+bool
+stroll_fbmap_test_avx2(const unsigned long * __restrict bits, unsigned int nr)
 {
-	stroll_fbmap_assert_api(iter);
-	stroll_fbmap_assert_range(bits, start_bit, bit_count);
-
-	iter->curr = stroll_fbmap_word_no(start_bit);
-	iter->word = bits[iter->curr] & stroll_fbmap_word_high_mask(start_bit);
-	iter->nr = start_bit + bit_count;
-	iter->bits = bits;
+	const __m256i * vec = (const __m256i *)bits;
+	unsigned int    v;
+
+	/* Process 4 vectors, i.e. 16 words, per iteration. */
+	for (v = 0; (v + 4) <= (nr / 4); v += 4) {
+		__m256i acc = _mm256_or_si256(
+			_mm256_or_si256(_mm256_loadu_si256(&vec[v]),
+			                _mm256_loadu_si256(&vec[v + 1])),
+			_mm256_or_si256(_mm256_loadu_si256(&vec[v + 2]),
+			                _mm256_loadu_si256(&vec[v + 3])));
+
+		if (!_mm256_testz_si256(acc, acc))
+			return true;
+	}
 
-	return stroll_fbmap_step_iter_set(iter);
+	return stroll_fbmap_test_scalar(&bits[v * 4], nr - (v * 4));
 }
 
-int
-stroll_fbmap_step_iter_clear(struct stroll_fbmap_iter * __restrict iter)
+static __stroll_fbmap_avx2 __stroll_nonull(1) __stroll_nothrow
+void
+stroll_fbmap_toggle_avx2(unsigned long * __restrict bits, unsigned int nr)
 {
-	stroll_fbmap_assert_iter(iter);
+	__m256i *    vec = (__m256i *)bits;
+	__m256i      ones = _mm256_set1_epi32(-1);
+	unsigned int v;
 
-	unsigned int bit_no;
+	for (v = 0; v < (nr / 4); v++)
+		_mm256_storeu_si256(
+			&vec[v],
+			_mm256_xor_si256(_mm256_loadu_si256(&vec[v]), ones));
 
-	while (iter->word == ~(0UL)) {
-		if (++iter->curr >= stroll_fbmap_word_nr(iter->nr))
-			return -ENOENT;
+	stroll_fbmap_toggle_scalar(&bits[v * 4], nr - (v * 4));
+}
 
-		iter->word = iter->bits[iter->curr];
+#define STROLL_FBMAP_DEFINE_BINOP_AVX2(_func, _op, _scalar_func) \
+	static __stroll_fbmap_avx2 __stroll_nonull(1, 2, 3) __stroll_nothrow \
+	void \
+	_func(unsigned long *       result, \
+	      const unsigned long * first, \
+	      const unsigned long * second, \
+	      unsigned int          nr) \
+	{ \
+		unsigned int w; \
+		\
+		for (w = 0; (w + 4) <= nr; w += 4) \
+			_mm256_storeu_si256( \
+				(__m256i *)&result[w], \
+				_op(_mm256_loadu_si256( \
+				            (const __m256i *)&first[w]), \
+				    _mm256_loadu_si256( \
+				            (const __m256i *)&second[w]))); \
+		\
+		_scalar_func(&result[w], &first[w], &second[w], nr - w); \
 	}
 
-	bit_no = stroll_bops_ffcul(iter->word) - 1;
-	iter->word |= 1UL << bit_no;
+/*
+ * Test kernels combine 4 vectors, i.e. 16 words, per iteration before checking
+ * for early exit.
+ */
+#define STROLL_FBMAP_DEFINE_TEST_BINOP_AVX2(_func, _op, _scalar_func) \
+	static __stroll_fbmap_avx2 __stroll_nonull(1, 2) __stroll_pure \
+	       __stroll_nothrow __warn_result \
+	bool \
+	_func(const unsigned long * __restrict first, \
+	      const unsigned long * __restrict second, \
+	      unsigned int                     nr) \
+	{ \
+		const __m256i * fst = (const __m256i *)first; \
+		const __m256i * snd = (const __m256i *)second; \
+		unsigned int    v; \
+		\
+		for (v = 0; (v + 4) <= (nr / 4); v += 4) { \
+			__m256i lo = _mm256_or_si256( \
+				_op(_mm256_loadu_si256(&fst[v]), \
+				    _mm256_loadu_si256(&snd[v])), \
+				_op(_mm256_loadu_si256(&fst[v + 1]), \
+				    _mm256_loadu_si256(&snd[v + 1]))); \
+			__m256i hi = _mm256_or_si256( \
+				_op(_mm256_loadu_si256(&fst[v + 2]), \
+				    _mm256_loadu_si256(&snd[v + 2])), \
+				_op(_mm256_loadu_si256(&fst[v + 3]), \
+				    _mm256_loadu_si256(&snd[v + 3]))); \
+			__m256i acc = _mm256_or_si256(lo, hi); \
+			\
+			if (!_mm256_testz_si256(acc, acc)) \
+				return true; \
+		} \
+		\
+		return _scalar_func(&first[v * 4], \
+		                    &second[v * 4], \
+		                    nr - (v * 4)); \
+	}
 
-	bit_no += (iter->curr * __WORDSIZE);
-	if (bit_no >= iter->nr)
-		return -ENOENT;
+#define stroll_fbmap_avx2_andnot(_first, _second) \
+	_mm256_andnot_si256(_second, _first)
+
+STROLL_FBMAP_DEFINE_BINOP_AVX2(stroll_fbmap_and_avx2,
+                               _mm256_and_si256,
+                               stroll_fbmap_and_scalar)
+STROLL_FBMAP_DEFINE_BINOP_AVX2(stroll_fbmap_or_avx2,
+                               _mm256_or_si256,
+                               stroll_fbmap_or_scalar)
+STROLL_FBMAP_DEFINE_BINOP_AVX2(stroll_fbmap_xor_avx2,
+                               _mm256_xor_si256,
+                               stroll_fbmap_xor_scalar)
+STROLL_FBMAP_DEFINE_BINOP_AVX2(stroll_fbmap_andnot_avx2,
+                               stroll_fbmap_avx2_andnot,
+                               stroll_fbmap_andnot_scalar)
+
+static __stroll_fbmap_avx2 __stroll_nonull(1, 2) __stroll_pure __stroll_nothrow
+       __warn_result
+unsigned int
+stroll_fbmap_hweight_and_avx2(const unsigned long * __restrict first,
+                              const unsigned long * __restrict second,
+                              unsigned int                     nr)
+{
+	const __m256i * fst = (const __m256i *)first;
+	const __m256i * snd = (const __m256i *)second;
+	__m256i         acc = _mm256_setzero_si256();
+	unsigned int    v;
+	unsigned int    hw;
+
+	for (v = 0; (v + 2) <= (nr / 4); v += 2) {
+		__m256i cnt = _mm256_add_epi8(
+			stroll_fbmap_popcnt_avx2(
+				_mm256_and_si256(_mm256_loadu_si256(&fst[v]),
+				                 _mm256_loadu_si256(&snd[v]))),
+			stroll_fbmap_popcnt_avx2(
+				_mm256_and_si256(
+					_mm256_loadu_si256(&fst[v + 1]),
+					_mm256_loadu_si256(&snd[v + 1]))));
+
+		acc = _mm256_add_epi64(acc,
+		                       _mm256_sad_epu8(cnt,
+		                                       _mm256_setzero_si256()));
+	}
 
-	return (int)bit_no;
+	hw = (unsigned int)(_mm256_extract_epi64(acc, 0) +
+	                    _mm256_extract_epi64(acc, 1) +
+	                    _mm256_extract_epi64(acc, 2) +
+	                    _mm256_extract_epi64(acc, 3));
+	for (v *= 4; v < nr; v++)
+		hw += (unsigned int)_mm_popcnt_u64(first[v] & second[v]);
+
+	return hw;
 }
 
-int
-_stroll_fbmap_init_range_iter_clear(
-	struct stroll_fbmap_iter * __restrict iter,
-	const unsigned long * __restrict      bits,
-	unsigned int                          start_bit,
-	unsigned int                          bit_count)
-{
-	stroll_fbmap_assert_api(iter);
-	stroll_fbmap_assert_range(bits, start_bit, bit_count);
+STROLL_FBMAP_DEFINE_TEST_BINOP_AVX2(stroll_fbmap_test_and_avx2,
+                                    _mm256_and_si256,
+                                    stroll_fbmap_test_and_scalar)
+STROLL_FBMAP_DEFINE_TEST_BINOP_AVX2(stroll_fbmap_test_andnot_avx2,
+                                    stroll_fbmap_avx2_andnot,
+                                    stroll_fbmap_test_andnot_scalar)
 
-	iter->curr = stroll_fbmap_word_no(start_bit);
-	iter->word = bits[iter->curr] | ~stroll_fbmap_word_high_mask(start_bit);
-	iter->nr = start_bit + bit_count;
-	iter->bits = bits;
+/*
+ * Offsets of bits set into a byte, packed into consecutive bytes in ascending
+ * order.
+ */
+#define STROLL_FBMAP_EXTRACT_OFF(_byte, _bit) \
+	((((_byte) >> (_bit)) & 1) * \
+	 ((uint64_t)(_bit) << \
+	  (CHAR_BIT * __builtin_popcount((_byte) & ((1U << (_bit)) - 1)))))
+
+#define STROLL_FBMAP_EXTRACT_LUT1(_byte) \
+	(STROLL_FBMAP_EXTRACT_OFF(_byte, 0) | \
+	 STROLL_FBMAP_EXTRACT_OFF(_byte, 1) | \
+	 STROLL_FBMAP_EXTRACT_OFF(_byte, 2) | \
+	 STROLL_FBMAP_EXTRACT_OFF(_byte, 3) | \
+	 STROLL_FBMAP_EXTRACT_OFF(_byte, 4) | \
+	 STROLL_FBMAP_EXTRACT_OFF(_byte, 5) | \
+	 STROLL_FBMAP_EXTRACT_OFF(_byte, 6) | \
+	 STROLL_FBMAP_EXTRACT_OFF(_byte, 7))
+
+#define STROLL_FBMAP_EXTRACT_LUT4(_byte) \
+	STROLL_FBMAP_EXTRACT_LUT1(_byte), \
+	STROLL_FBMAP_EXTRACT_LUT1((_byte) + 1), \
+	STROLL_FBMAP_EXTRACT_LUT1((_byte) + 2), \
+	STROLL_FBMAP_EXTRACT_LUT1((_byte) + 3)
+
+#define STROLL_FBMAP_EXTRACT_LUT16(_byte) \
+	STROLL_FBMAP_EXTRACT_LUT4(_byte), \
+	STROLL_FBMAP_EXTRACT_LUT4((_byte) + 4), \
+	STROLL_FBMAP_EXTRACT_LUT4((_byte) + 8), \
+	STROLL_FBMAP_EXTRACT_LUT4((_byte) + 12)
+
+#define STROLL_FBMAP_EXTRACT_LUT64(_byte) \
+	STROLL_FBMAP_EXTRACT_LUT16(_byte), \
+	STROLL_FBMAP_EXTRACT_LUT16((_byte) + 16), \
+	STROLL_FBMAP_EXTRACT_LUT16((_byte) + 32), \
+	STROLL_FBMAP_EXTRACT_LUT16((_byte) + 48)
+
+static const uint64_t stroll_fbmap_extract_lut[256] = {
+	STROLL_FBMAP_EXTRACT_LUT64(0U),
+	STROLL_FBMAP_EXTRACT_LUT64(64U),
+	STROLL_FBMAP_EXTRACT_LUT64(128U),
+	STROLL_FBMAP_EXTRACT_LUT64(192U)
+};
 
-	return stroll_fbmap_step_iter_clear(iter);
-}
+/*
+ * Decode 8 bits at a time: widen the packed offsets of the byte to 8 x 32-bit
+ * lanes, add the index of the byte's first bit and store all 8 lanes
+ * whatever the number of bits set, then move forward by the byte Hamming
+ * weight.
+ */
+static __stroll_fbmap_avx2 __stroll_nonull(1, 3, 4) __stroll_nothrow
+       __warn_result
+unsigned int
+stroll_fbmap_extract_avx2(uint32_t * __restrict            indices,
+                          unsigned int                     max,
+                          const unsigned long * __restrict bits,
+                          unsigned int * __restrict        nr,
+                          uint32_t                         base)
+{
+	unsigned int cnt = 0;
+	unsigned int w;
+
+	for (w = 0; w < *nr; w++, base += __WORDSIZE) {
+		unsigned long word = bits[w];
+		unsigned int  b;
+
+		if (!word)
+			continue;
+
+		/* Last byte store may write up to 8 entries past the end. */
+		if (((unsigned int)_mm_popcnt_u64(word) + 8) > (max - cnt))
+			break;
+
+		for (b = 0; b < sizeof(word); b++, word >>= CHAR_BIT) {
+			unsigned int byte = (unsigned int)word & 0xffU;
+			__m256i      off = _mm256_cvtepu8_epi32(
+				_mm_loadl_epi64(
+					(const __m128i *)
+					&stroll_fbmap_extract_lut[byte]));
+
+			_mm256_storeu_si256(
+				(__m256i *)&indices[cnt],
+				_mm256_add_epi32(
+					off,
+					_mm256_set1_epi32(
+						(int)(base + (b * CHAR_BIT)))));
+			cnt += (unsigned int)_mm_popcnt_u32(byte);
+		}
+	}
+
+	*nr = w;
+
+	return cnt;
+}
+
+/*
+ * AVX-512 kernels.
+ *
+ * Hamming weight relies upon the VPOPCNTQ instruction. Partial trailing
+ * vectors are processed using masked loads / stores.
+ */
+static __stroll_fbmap_avx512 __stroll_nonull(1) __stroll_pure __stroll_nothrow
+       __warn_result
+unsigned int
+stroll_fbmap_hweight_avx512(const unsigned long * __restrict bits,
+                            unsigned int                     nr)
+{
+	__m512i      acc = _mm512_setzero_si512();
+	unsigned int w;
+
+	for (w = 0; (w + 8) <= nr; w += 8)
+		acc = _mm512_add_epi64(acc,
+		                       _mm512_popcnt_epi64(
+		                               _mm512_loadu_si512(&bits[w])));
+	if (w < nr) {
+		__mmask8 msk = (__mmask8)((1U << (nr - w)) - 1);
+
+		acc = _mm512_add_epi64(acc,
+		                       _mm512_popcnt_epi64(
+		                               _mm512_maskz_loadu_epi64(
+		                                       msk,
+		                                       &bits[w])));
+	}
+
+	return (unsigned int)_mm512_reduce_add_epi64(acc);
+}
+
+static __stroll_fbmap_avx512 __stroll_nonull(1) __stroll_pure __stroll_nothrow
+       __warn_result
+bool
+stroll_fbmap_test_avx512(const unsigned long * __restrict bits,
+                         unsigned int                     nr)
+{
+	unsigned int w;
+
+	/* Process 4 vectors, i.e. 32 words, per iteration. */
+	for (w = 0; (w + 32) <= nr; w += 32) {
+		__m512i acc = _mm512_or_si512(
+			_mm512_or_si512(_mm512_loadu_si512(&bits[w]),
+			                _mm512_loadu_si512(&bits[w + 8])),
+			_mm512_or_si512(_mm512_loadu_si512(&bits[w + 16]),
+			                _mm512_loadu_si512(&bits[w + 24])));
+
+		if (_mm512_test_epi64_mask(acc, acc))
+			return true;
+	}
+	for (; (w + 8) <= nr; w += 8) {
+		__m512i vec = _mm512_loadu_si512(&bits[w]);
+
+		if (_mm512_test_epi64_mask(vec, vec))
+			return true;
+	}
+	if (w < nr) {
+		__mmask8 msk = (__mmask8)((1U << (nr - w)) - 1);
+		__m512i  vec = _mm512_maskz_loadu_epi64(msk, &bits[w]);
+
+		return !!_mm512_test_epi64_mask(vec, vec);
+	}
+
+	return false;
+}
+
+static __stroll_fbmap_avx512 __stroll_nonull(1) __stroll_nothrow
+void
+stroll_fbmap_toggle_avx512(unsigned long * __restrict bits, unsigned int nr)
+{
+	__m512i      ones = _mm512_set1_epi64(-1);
+	unsigned int w;
+
+	for (w = 0; (w + 8) <= nr; w += 8)
+		_mm512_storeu_si512(
+			&bits[w],
+			_mm512_xor_si512(_mm512_loadu_si512(&bits[w]), ones));
+	if (w < nr) {
+		__mmask8 msk = (__mmask8)((1U << (nr - w)) - 1);
+
+		_mm512_mask_storeu_epi64(
+			&bits[w],
+			msk,
+			_mm512_xor_si512(_mm512_maskz_loadu_epi64(msk,
+			                                          &bits[w]),
+			                 ones));
+	}
+}
+
+#define STROLL_FBMAP_DEFINE_BINOP_AVX512(_func, _op) \
+	static __stroll_fbmap_avx512 __stroll_nonull(1, 2, 3) __stroll_nothrow \
+	void \
+	_func(unsigned long *       result, \
+	      const unsigned long * first, \
+	      const unsigned long * second, \
+	      unsigned int          nr) \
+	{ \
+		unsigned int w; \
+		\
+		for (w = 0; (w + 8) <= nr; w += 8) \
+			_mm512_storeu_si512( \
+				&result[w], \
+				_op(_mm512_loadu_si512(&first[w]), \
+				    _mm512_loadu_si512(&second[w]))); \
+		if (w < nr) { \
+			__mmask8 msk = (__mmask8)((1U << (nr - w)) - 1); \
+			\
+			_mm512_mask_storeu_epi64( \
+				&result[w], \
+				msk, \
+				_op(_mm512_maskz_loadu_epi64(msk, &first[w]), \
+				    _mm512_maskz_loadu_epi64(msk, \
+				                             &second[w]))); \
+		} \
+	}
+
+/*
+ * Test kernels combine 4 vectors, i.e. 32 words, per iteration before checking
+ * for early exit.
+ */
+#define STROLL_FBMAP_DEFINE_TEST_BINOP_AVX512(_func, _op) \
+	static __stroll_fbmap_avx512 __stroll_nonull(1, 2) __stroll_pure \
+	       __stroll_nothrow __warn_result \
+	bool \
+	_func(const unsigned long * __restrict first, \
+	      const unsigned long * __restrict second, \
+	      unsigned int                     nr) \
+	{ \
+		unsigned int w; \
+		\
+		for (w = 0; (w + 32) <= nr; w += 32) { \
+			__m512i lo = _mm512_or_si512( \
+				_op(_mm512_loadu_si512(&first[w]), \
+				    _mm512_loadu_si512(&second[w])), \
+				_op(_mm512_loadu_si512(&first[w + 8]), \
+				    _mm512_loadu_si512(&second[w + 8]))); \
+			__m512i hi = _mm512_or_si512( \
+				_op(_mm512_loadu_si512(&first[w + 16]), \
+				    _mm512_loadu_si512(&second[w + 16])), \
+				_op(_mm512_loadu_si512(&first[w + 24]), \
+				    _mm512_loadu_si512(&second[w + 24]))); \
+			__m512i acc = _mm512_or_si512(lo, hi); \
+			\
+			if (_mm512_test_epi64_mask(acc, acc)) \
+				return true; \
+		} \
+		for (; (w + 8) <= nr; w += 8) { \
+			__m512i vec = _op(_mm512_loadu_si512(&first[w]), \
+			                  _mm512_loadu_si512(&second[w])); \
+			\
+			if (_mm512_test_epi64_mask(vec, vec)) \
+				return true; \
+		} \
+		if (w < nr) { \
+			__mmask8 msk = (__mmask8)((1U << (nr - w)) - 1); \
+			__m512i  vec = _op( \
+				_mm512_maskz_loadu_epi64(msk, &first[w]), \
+				_mm512_maskz_loadu_epi64(msk, &second[w])); \
+			\
+			return !!_mm512_test_epi64_mask(vec, vec); \
+		} \
+		\
+		return false; \
+	}
+
+#define stroll_fbmap_avx512_andnot(_first, _second) \
+	_mm512_andnot_si512(_second, _first)
+
+STROLL_FBMAP_DEFINE_BINOP_AVX512(stroll_fbmap_and_avx512, _mm512_and_si512)
+STROLL_FBMAP_DEFINE_BINOP_AVX512(stroll_fbmap_or_avx512, _mm512_or_si512)
+STROLL_FBMAP_DEFINE_BINOP_AVX512(stroll_fbmap_xor_avx512, _mm512_xor_si512)
+STROLL_FBMAP_DEFINE_BINOP_AVX512(stroll_fbmap_andnot_avx512,
+                                 stroll_fbmap_avx512_andnot)
+
+static __stroll_fbmap_avx512 __stroll_nonull(1, 2) __stroll_pure
+       __stroll_nothrow __warn_result
+unsigned int
+stroll_fbmap_hweight_and_avx512(const unsigned long * __restrict first,
+                                const unsigned long * __restrict second,
+                                unsigned int                     nr)
+{
+	__m512i      acc = _mm512_setzero_si512();
+	unsigned int w;
+
+	for (w = 0; (w + 8) <= nr; w += 8) {
+		__m512i vec = _mm512_and_si512(_mm512_loadu_si512(&first[w]),
+		                               _mm512_loadu_si512(&second[w]));
+
+		acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(vec));
+	}
+	if (w < nr) {
+		__mmask8 msk = (__mmask8)((1U << (nr - w)) - 1);
+		__m512i  vec = _mm512_and_si512(
+			_mm512_maskz_loadu_epi64(msk, &first[w]),
+			_mm512_maskz_loadu_epi64(msk, &second[w]));
+
+		acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(vec));
+	}
+
+	return (unsigned int)_mm512_reduce_add_epi64(acc);
+}
+
+STROLL_FBMAP_DEFINE_TEST_BINOP_AVX512(stroll_fbmap_test_and_avx512,
+                                      _mm512_and_si512)
+STROLL_FBMAP_DEFINE_TEST_BINOP_AVX512(stroll_fbmap_test_andnot_avx512,
+                                      stroll_fbmap_avx512_andnot)
+
+/*
+ * Decode 16 bits at a time: compress the indices of bits set into the lowest
+ * lanes of a vector using VPCOMPRESSD, store all 16 lanes, then move forward
+ * by the number of bits set.
+ */
+static __stroll_fbmap_avx512 __stroll_nonull(1, 3, 4) __stroll_nothrow
+       __warn_result
+unsigned int
+stroll_fbmap_extract_avx512(uint32_t * __restrict            indices,
+                            unsigned int                     max,
+                            const unsigned long * __restrict bits,
+                            unsigned int * __restrict        nr,
+                            uint32_t                         base)
+{
+	const __m512i iota = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7,
+	                                       8, 9, 10, 11, 12, 13, 14, 15);
+	unsigned int  cnt = 0;
+	unsigned int  w;
+
+	for (w = 0; w < *nr; w++, base += __WORDSIZE) {
+		unsigned long word = bits[w];
+		unsigned int  c;
+
+		if (!word)
+			continue;
+
+		/* Last store may write up to 16 entries past the end. */
+		if (((unsigned int)__builtin_popcountl(word) + 16) >
+		    (max - cnt))
+			break;
+
+		for (c = 0; c < (__WORDSIZE / 16); c++, word >>= 16) {
+			__mmask16 msk = (__mmask16)word;
+
+			_mm512_storeu_si512(
+				&indices[cnt],
+				_mm512_maskz_compress_epi32(
+					msk,
+					_mm512_add_epi32(
+						iota,
+						_mm512_set1_epi32(
+							(int)(base +
+							      (c * 16))))));
+			cnt += (unsigned int)__builtin_popcount(msk);
+		}
+	}
+
+	*nr = w;
+
+	return cnt;
+}
+
+static const struct stroll_fbmap_kernels stroll_fbmap_all_kernels[] = {
+	[STROLL_FBMAP_SCALAR_ISA] = {
+		.hweight     = stroll_fbmap_hweight_scalar,
+		.test        = stroll_fbmap_test_scalar,
+		.toggle      = stroll_fbmap_toggle_scalar,
+		.and         = stroll_fbmap_and_scalar,
+		.or          = stroll_fbmap_or_scalar,
+		.xor         = stroll_fbmap_xor_scalar,
+		.andnot      = stroll_fbmap_andnot_scalar,
+		.hweight_and = stroll_fbmap_hweight_and_scalar,
+		.test_and    = stroll_fbmap_test_and_scalar,
+		.test_andnot = stroll_fbmap_test_andnot_scalar,
+		.extract     = stroll_fbmap_extract_scalar
+	},
+	[STROLL_FBMAP_SSE_ISA]    = {
+		.hweight     = stroll_fbmap_hweight_sse,
+		.test        = stroll_fbmap_test_sse,
+		.toggle      = stroll_fbmap_toggle_sse,
+		.and         = stroll_fbmap_and_sse,
+		.or          = stroll_fbmap_or_sse,
+		.xor         = stroll_fbmap_xor_sse,
+		.andnot      = stroll_fbmap_andnot_sse,
+		.hweight_and = stroll_fbmap_hweight_and_sse,
+		.test_and    = stroll_fbmap_test_and_sse,
+		.test_andnot = stroll_fbmap_test_andnot_sse,
+		.extract     = stroll_fbmap_extract_scalar
+	},
+	[STROLL_FBMAP_AVX2_ISA]   = {
+		.hweight     = stroll_fbmap_hweight_avx2,
+		.test        = stroll_fbmap_test_avx2,
+		.toggle      = stroll_fbmap_toggle_avx2,
+		.and         = stroll_fbmap_and_avx2,
+		.or          = stroll_fbmap_or_avx2,
+		.xor         = stroll_fbmap_xor_avx2,
+		.andnot      = stroll_fbmap_andnot_avx2,
+		.hweight_and = stroll_fbmap_hweight_and_avx2,
+		.test_and    = stroll_fbmap_test_and_avx2,
+		.test_andnot = stroll_fbmap_test_andnot_avx2,
+		.extract     = stroll_fbmap_extract_avx2
+	},
+	[STROLL_FBMAP_AVX512_ISA] = {
+		.hweight     = stroll_fbmap_hweight_avx512,
+		.test        = stroll_fbmap_test_avx512,
+		.toggle      = stroll_fbmap_toggle_avx512,
+		.and         = stroll_fbmap_and_avx512,
+		.or          = stroll_fbmap_or_avx512,
+		.xor         = stroll_fbmap_xor_avx512,
+		.andnot      = stroll_fbmap_andnot_avx512,
+		.hweight_and = stroll_fbmap_hweight_and_avx512,
+		.test_and    = stroll_fbmap_test_and_avx512,
+		.test_andnot = stroll_fbmap_test_andnot_avx512,
+		.extract     = stroll_fbmap_extract_avx512
+	}
+};
+
+static __stroll_nothrow __warn_result
+bool
+stroll_fbmap_probe_isa(enum stroll_fbmap_isa isa)
+{
+	__builtin_cpu_init();
+
+	switch (isa) {
+	case STROLL_FBMAP_SCALAR_ISA:
+		return true;
+	case STROLL_FBMAP_SSE_ISA:
+		return __builtin_cpu_supports("sse4.2") &&
+		       __builtin_cpu_supports("popcnt");
+	case STROLL_FBMAP_AVX2_ISA:
+		return __builtin_cpu_supports("avx2") &&
+		       __builtin_cpu_supports("popcnt");
+	case STROLL_FBMAP_AVX512_ISA:
+		return __builtin_cpu_supports("avx512f") &&
+		       __builtin_cpu_supports("avx512vpopcntdq");
+	default:
+		return false;
+	}
+}
+
+#else  /* !(defined(CONFIG_STROLL_FBMAP_SIMD) && defined(__x86_64__)) */
+
+static const struct stroll_fbmap_kernels stroll_fbmap_all_kernels[] = {
+	[0] = {
+		.hweight     = stroll_fbmap_hweight_scalar,
+		.test        = stroll_fbmap_test_scalar,
+		.toggle      = stroll_fbmap_toggle_scalar,
+		.and         = stroll_fbmap_and_scalar,
+		.or          = stroll_fbmap_or_scalar,
+		.xor         = stroll_fbmap_xor_scalar,
+		.andnot      = stroll_fbmap_andnot_scalar,
+		.hweight_and = stroll_fbmap_hweight_and_scalar,
+		.test_and    = stroll_fbmap_test_and_scalar,
+		.test_andnot = stroll_fbmap_test_andnot_scalar,
+		.extract     = stroll_fbmap_extract_scalar
+	}
+};
+
+#if defined(CONFIG_STROLL_FBMAP_SIMD)
+
+static __stroll_nothrow __warn_result
+bool
+stroll_fbmap_probe_isa(enum stroll_fbmap_isa isa)
+{
+	return isa == STROLL_FBMAP_SCALAR_ISA;
+}
+
+#endif /* defined(CONFIG_STROLL_FBMAP_SIMD) */
+
+#endif /* defined(CONFIG_STROLL_FBMAP_SIMD) && defined(__x86_64__) */
+
+static const struct stroll_fbmap_kernels * stroll_fbmap_kernels =
+	&stroll_fbmap_all_kernels[0];
+
+#if defined(CONFIG_STROLL_FBMAP_SIMD)
+
+static enum stroll_fbmap_isa stroll_fbmap_isa = STROLL_FBMAP_SCALAR_ISA;
+
+enum stroll_fbmap_isa
+stroll_fbmap_get_isa(void)
+{
+	return stroll_fbmap_isa;
+}
+
+int
+stroll_fbmap_select_isa(enum stroll_fbmap_isa isa)
+{
+	stroll_fbmap_assert_api(isa >= 0);
+	stroll_fbmap_assert_api(isa < STROLL_FBMAP_ISA_NR);
+
+	if (!stroll_fbmap_probe_isa(isa))
+		return -ENOTSUP;
+
+	stroll_fbmap_kernels = &stroll_fbmap_all_kernels[isa];
+	stroll_fbmap_isa = isa;
+
+	return 0;
+}
+
+/* Select the most capable kernels supported by the CPU at load time. */
+static __ctor(101) __stroll_nothrow
+void
+stroll_fbmap_init_kernels(void)
+{
+	int isa;
+
+	for (isa = STROLL_FBMAP_ISA_NR - 1;
+	     isa > STROLL_FBMAP_SCALAR_ISA;
+	     isa--)
+		if (!stroll_fbmap_select_isa((enum stroll_fbmap_isa)isa))
+			break;
+}
+
+#endif /* defined(CONFIG_STROLL_FBMAP_SIMD) */
+
+unsigned int
+_stroll_fbmap_hweight(const unsigned long * __restrict bits, unsigned int nr)
+{
+	stroll_fbmap_assert_api(bits);
+
+	unsigned int w = stroll_fbmap_word_nr(nr) - 1;
+
+	return stroll_fbmap_kernels->hweight(bits, w) +
+	       stroll_bops_hweightul(bits[w] &
+	                             stroll_fbmap_word_low_mask(nr - 1));
+}
+
+bool
+_stroll_fbmap_test_range(const unsigned long * __restrict bits,
+                         unsigned int                     start_bit,
+                         unsigned int                     bit_count)
+{
+	stroll_fbmap_assert_range(bits, start_bit, bit_count);
+
+	unsigned int  stop_bit = start_bit + bit_count - 1;
+	unsigned int  curr = stroll_fbmap_word_no(start_bit);
+	unsigned int  last = stroll_fbmap_word_no(stop_bit);
+	unsigned long msb = stroll_fbmap_word_high_mask(start_bit);
+	unsigned long lsb = stroll_fbmap_word_low_mask(stop_bit);
+
+	if (curr != last) {
+		/*
+		 * Mask out unwanted least significant bits and check if 0 or
+		 * not.
+		 */
+		if (bits[curr++] & msb)
+			return true;
+	}
+	else
+		/*
+		 * Range applies to a single word only: mask out unwanted most
+		 * and least significant bits and check if 0 or not.
+		 */
+		return !!(bits[curr] & msb & lsb);
+
+	/* Test all remaining words but the last one at once. */
+	if (stroll_fbmap_kernels->test(&bits[curr], last - curr))
+		return true;
+
+	/*
+	 * Mask out last word's unwanted most significant bits and check if 0 or
+	 * not.
+	 */
+	return !!(bits[last] & lsb);
+}
+
+bool
+_stroll_fbmap_test_all(const unsigned long * __restrict bits, unsigned int nr)
+{
+	stroll_fbmap_assert_bits_api(bits, nr);
+
+	unsigned int w = stroll_fbmap_word_nr(nr) - 1;
+
+	if (stroll_fbmap_kernels->test(bits, w))
+		return true;
+
+	if (bits[w] & stroll_fbmap_word_low_mask(nr - 1))
+		return true;
+
+	return false;
+}
+
+void
+_stroll_fbmap_toggle_all(unsigned long * __restrict bits, unsigned int nr)
+{
+	stroll_fbmap_assert_bits_api(bits, nr);
+
+	stroll_fbmap_kernels->toggle(bits, stroll_fbmap_word_nr(nr));
+}
+
+void
+_stroll_fbmap_and(unsigned long *       result,
+                  const unsigned long * first,
+                  const unsigned long * second,
+                  unsigned int          nr)
+{
+	stroll_fbmap_assert_bits_api(result, nr);
+	stroll_fbmap_assert_api(first);
+	stroll_fbmap_assert_api(second);
+
+	stroll_fbmap_kernels->and(result,
+	                          first,
+	                          second,
+	                          stroll_fbmap_word_nr(nr));
+}
+
+void
+_stroll_fbmap_or(unsigned long *       result,
+                 const unsigned long * first,
+                 const unsigned long * second,
+                 unsigned int          nr)
+{
+	stroll_fbmap_assert_bits_api(result, nr);
+	stroll_fbmap_assert_api(first);
+	stroll_fbmap_assert_api(second);
+
+	stroll_fbmap_kernels->or(result,
+	                         first,
+	                         second,
+	                         stroll_fbmap_word_nr(nr));
+}
+
+void
+_stroll_fbmap_xor(unsigned long *       result,
+                  const unsigned long * first,
+                  const unsigned long * second,
+                  unsigned int          nr)
+{
+	stroll_fbmap_assert_bits_api(result, nr);
+	stroll_fbmap_assert_api(first);
+	stroll_fbmap_assert_api(second);
+
+	stroll_fbmap_kernels->xor(result,
+	                          first,
+	                          second,
+	                          stroll_fbmap_word_nr(nr));
+}
+
+void
+_stroll_fbmap_andnot(unsigned long *       result,
+                     const unsigned long * first,
+                     const unsigned long * second,
+                     unsigned int          nr)
+{
+	stroll_fbmap_assert_bits_api(result, nr);
+	stroll_fbmap_assert_api(first);
+	stroll_fbmap_assert_api(second);
+
+	stroll_fbmap_kernels->andnot(result,
+	                             first,
+	                             second,
+	                             stroll_fbmap_word_nr(nr));
+}
+
+unsigned int
+_stroll_fbmap_hweight_and(const unsigned long * __restrict first,
+                          const unsigned long * __restrict second,
+                          unsigned int                     nr)
+{
+	stroll_fbmap_assert_bits_api(first, nr);
+	stroll_fbmap_assert_api(second);
+
+	unsigned int w = stroll_fbmap_word_nr(nr) - 1;
+
+	return stroll_fbmap_kernels->hweight_and(first, second, w) +
+	       stroll_bops_hweightul(first[w] & second[w] &
+	                             stroll_fbmap_word_low_mask(nr - 1));
+}
+
+bool
+_stroll_fbmap_intersects(const unsigned long * __restrict first,
+                         const unsigned long * __restrict second,
+                         unsigned int                     nr)
+{
+	stroll_fbmap_assert_bits_api(first, nr);
+	stroll_fbmap_assert_api(second);
+
+	unsigned int w = stroll_fbmap_word_nr(nr) - 1;
+
+	if (stroll_fbmap_kernels->test_and(first, second, w))
+		return true;
+
+	return !!(first[w] & second[w] & stroll_fbmap_word_low_mask(nr - 1));
+}
+
+bool
+_stroll_fbmap_is_subset(const unsigned long * __restrict subset,
+                        const unsigned long * __restrict set,
+                        unsigned int                     nr)
+{
+	stroll_fbmap_assert_bits_api(subset, nr);
+	stroll_fbmap_assert_api(set);
+
+	unsigned int w = stroll_fbmap_word_nr(nr) - 1;
+
+	/* Look for bits set into subset but not into set. */
+	if (stroll_fbmap_kernels->test_andnot(subset, set, w))
+		return false;
+
+	return !(subset[w] & ~set[w] & stroll_fbmap_word_low_mask(nr - 1));
+}
+
+/*
+ * Decode indices of bits set into a single word, up to max indices.
+ */
+static __stroll_nonull(1) __stroll_nothrow __warn_result
+unsigned int
+stroll_fbmap_extract_word(uint32_t * __restrict indices,
+                          unsigned int          max,
+                          unsigned long         word,
+                          uint32_t              base)
+{
+	unsigned int cnt = 0;
+
+	while (word && (cnt < max)) {
+		indices[cnt++] = base + (uint32_t)__builtin_ctzl(word);
+		word &= word - 1;
+	}
+
+	return cnt;
+}
+
+unsigned int
+_stroll_fbmap_extract_set(const unsigned long * __restrict bits,
+                          unsigned int                     nr,
+                          unsigned int                     start_bit,
+                          uint32_t * __restrict            indices,
+                          unsigned int                     max)
+{
+	stroll_fbmap_assert_bits_api(bits, nr);
+	stroll_fbmap_assert_api(start_bit <= nr);
+	stroll_fbmap_assert_api(indices);
+	stroll_fbmap_assert_api(max);
+
+	unsigned int  last = stroll_fbmap_word_nr(nr) - 1;
+	unsigned int  curr;
+	unsigned long word;
+	unsigned int  cnt = 0;
+
+	if (start_bit == nr)
+		return 0;
+
+	curr = stroll_fbmap_word_no(start_bit);
+	word = bits[curr] & stroll_fbmap_word_high_mask(start_bit);
+	while (curr < last) {
+		unsigned int cnt_words;
+
+		/*
+		 * Decode the partial head word or the word the bulk kernel
+		 * stopped at since it could not fit into remaining room.
+		 */
+		cnt += stroll_fbmap_extract_word(&indices[cnt],
+		                                 max - cnt,
+		                                 word,
+		                                 curr << STROLL_WORD_SHIFT);
+		if (cnt == max)
+			return cnt;
+
+		/* Decode all whole words but the last one at once. */
+		curr++;
+		cnt_words = last - curr;
+		cnt += stroll_fbmap_kernels->extract(&indices[cnt],
+		                                     max - cnt,
+		                                     &bits[curr],
+		                                     &cnt_words,
+		                                     curr << STROLL_WORD_SHIFT);
+		curr += cnt_words;
+		word = bits[curr];
+	}
+
+	/* Mask out last word's unwanted most significant bits. */
+	word &= stroll_fbmap_word_low_mask(nr - 1);
+
+	return cnt + stroll_fbmap_extract_word(&indices[cnt],
+	                                       max - cnt,
+	                                       word,
+	                                       last << STROLL_WORD_SHIFT);
+}
+
+/*
+ * Return index of first bit which value differs from the one given by flip
+ * (i.e. 0 to search for a set bit, ~0UL to search for a cleared bit) within
+ * the [bit_no, nr[ range, or nr when none found.
+ *
+ * Words holding no matching bit are skipped at once.
+ */
+static __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+unsigned int
+stroll_fbmap_find_next(const unsigned long * __restrict bits,
+                       unsigned int                     bit_no,
+                       unsigned int                     nr,
+                       unsigned long                    flip)
+{
+	unsigned int  curr = stroll_fbmap_word_no(bit_no);
+	unsigned int  last = stroll_fbmap_word_no(nr - 1);
+	unsigned long word;
+
+	word = (bits[curr] ^ flip) & stroll_fbmap_word_high_mask(bit_no);
+	while (!word) {
+		if (++curr > last)
+			return nr;
+		word = bits[curr] ^ flip;
+	}
+
+	/* Bits located beyond nr may be garbage: clamp result. */
+	return stroll_min((curr << STROLL_WORD_SHIFT) +
+	                  (unsigned int)__builtin_ctzl(word),
+	                  nr);
+}
+
+/*
+ * Search for the first range of bit_count contiguous cleared bits fully
+ * contained within the [start_bit, stop_bit[ range.
+ */
+static __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+int
+stroll_fbmap_find_first_clear_run(const unsigned long * __restrict bits,
+                                  unsigned int                     start_bit,
+                                  unsigned int                     stop_bit,
+                                  unsigned int                     bit_count)
+{
+	while ((start_bit + bit_count) <= stop_bit) {
+		unsigned int end;
+
+		start_bit = stroll_fbmap_find_next(bits,
+		                                   start_bit,
+		                                   stop_bit,
+		                                   ~(0UL));
+		if ((start_bit + bit_count) > stop_bit)
+			break;
+
+		/*
+		 * Look for a set bit within the candidate range only: there is
+		 * no need to measure the whole run.
+		 */
+		end = stroll_fbmap_find_next(bits,
+		                             start_bit,
+		                             start_bit + bit_count,
+		                             0);
+		if (end == (start_bit + bit_count))
+			return (int)start_bit;
+
+		start_bit = end + 1;
+	}
+
+	return -ENOSPC;
+}
+
+int
+_stroll_fbmap_find_clear_run(const unsigned long * __restrict bits,
+                             unsigned int                     nr,
+                             unsigned int                     bit_count,
+                             unsigned int                     hint)
+{
+	stroll_fbmap_assert_bits_api(bits, nr);
+	stroll_fbmap_assert_api(bit_count);
+	stroll_fbmap_assert_api(hint <= nr);
+
+	int ret;
+
+	if (bit_count > nr)
+		return -ENOSPC;
+
+	if (hint == nr)
+		hint = 0;
+
+	ret = stroll_fbmap_find_first_clear_run(bits, hint, nr, bit_count);
+	if ((ret >= 0) || !hint)
+		return ret;
+
+	/*
+	 * Wrap around: search ranges starting before hint, including the ones
+	 * that overlap hint and that could not be found by the above search.
+	 */
+	return stroll_fbmap_find_first_clear_run(
+		bits,
+		0,
+		stroll_min(hint + bit_count - 1, nr),
+		bit_count);
+}
+
+int
+_stroll_fbmap_find_best_clear_run(const unsigned long * __restrict bits,
+                                  unsigned int                     nr,
+                                  unsigned int                     bit_count)
+{
+	stroll_fbmap_assert_bits_api(bits, nr);
+	stroll_fbmap_assert_api(bit_count);
+
+	unsigned int start = 0;
+	unsigned int best_len = UINT_MAX;
+	int          best = -ENOSPC;
+
+	while ((start + bit_count) <= nr) {
+		unsigned int end;
+
+		start = stroll_fbmap_find_next(bits, start, nr, ~(0UL));
+		if ((start + bit_count) > nr)
+			break;
+
+		end = stroll_fbmap_find_next(bits, start, nr, 0);
+		if (((end - start) >= bit_count) &&
+		    ((end - start) < best_len)) {
+			if ((end - start) == bit_count)
+				/* Exact fit: cannot do better. */
+				return (int)start;
+
+			best_len = end - start;
+			best = (int)start;
+		}
+
+		if (end == nr)
+			break;
+
+		start = end + 1;
+	}
+
+	return best;
+}
+
+unsigned long *
+_stroll_fbmap_create_bits_clear(unsigned int bit_nr)
+{
+	stroll_fbmap_assert_api(bit_nr);
+	stroll_fbmap_assert_api(bit_nr <= (unsigned int)INT_MAX);
+
+	unsigned long * bits;
+	unsigned int    sz = stroll_fbmap_word_nr(bit_nr) * sizeof(bits[0]);
+
+	bits = malloc(sz);
+	if (!bits)
+		return NULL;
+
+	memset(bits, 0, sz);
+
+	return bits;
+}
+
+int
+stroll_fbmap_init_clear(struct stroll_fbmap * __restrict bmap,
+                        unsigned int                     bit_nr)
+{
+	stroll_fbmap_assert_api(bmap);
+	stroll_fbmap_assert_api(bit_nr);
+	stroll_fbmap_assert_api(bit_nr <= (unsigned int)INT_MAX);
+
+	bmap->bits = _stroll_fbmap_create_bits_clear(bit_nr);
+	if (!bmap->bits)
+		return -errno;
+
+	bmap->nr = bit_nr;
+
+	return 0;
+}
+
+unsigned long *
+_stroll_fbmap_create_bits_set(unsigned int bit_nr)
+{
+	stroll_fbmap_assert_api(bit_nr);
+	stroll_fbmap_assert_api(bit_nr <= (unsigned int)INT_MAX);
+
+	unsigned long * bits;
+	unsigned int    sz = stroll_fbmap_word_nr(bit_nr) * sizeof(bits[0]);
+
+	bits = malloc(sz);
+	if (!bits)
+		return NULL;
+
+	memset(bits, 0xff, sz);
+
+	return bits;
+}
+
+int
+stroll_fbmap_init_set(struct stroll_fbmap * __restrict bmap,
+                      unsigned int                     bit_nr)
+{
+	stroll_fbmap_assert_api(bmap);
+	stroll_fbmap_assert_api(bit_nr);
+	stroll_fbmap_assert_api(bit_nr <= (unsigned int)INT_MAX);
+
+	bmap->bits = _stroll_fbmap_create_bits_set(bit_nr);
+	if (!bmap->bits)
+		return -errno;
+
+	bmap->nr = bit_nr;
+
+	return 0;
+}
+
+unsigned long *
+_stroll_fbmap_create_bits_dup(unsigned long * __restrict src,
+                              unsigned int               bit_nr)
+{
+	stroll_fbmap_assert_api(src);
+	stroll_fbmap_assert_api(bit_nr);
+	stroll_fbmap_assert_api(bit_nr <= (unsigned int)INT_MAX);
+
+	unsigned long * bits;
+	unsigned int    sz = stroll_fbmap_word_nr(bit_nr) * sizeof(bits[0]);
+
+	bits = malloc(sz);
+	if (!bits)
+		return NULL;
+
+	memcpy(bits, src, sz);
+
+	return bits;
+}
+
+int
+stroll_fbmap_init_dup(struct stroll_fbmap * __restrict       bmap,
+                      const struct stroll_fbmap * __restrict src)
+{
+	stroll_fbmap_assert_api(bmap);
+	stroll_fbmap_assert_map_api(src);
+
+	bmap->bits = _stroll_fbmap_create_bits_dup(src->bits, src->nr);
+	if (!bmap->bits)
+		return -errno;
+
+	bmap->nr = src->nr;
+
+	return 0;
+}
+
+#define stroll_fbmap_assert_iter(_iter) \
+	stroll_fbmap_assert_api(_iter); \
+	stroll_fbmap_assert_bits_api((_iter)->bits, (_iter)->nr); \
+	stroll_fbmap_assert_api((_iter)->curr < stroll_fbmap_word_nr(iter->nr))
+
+int
+stroll_fbmap_step_iter_set(struct stroll_fbmap_iter * __restrict iter)
+{
+	stroll_fbmap_assert_iter(iter);
+
+	unsigned int bit_no;
+
+	while (!iter->word) {
+		if (++iter->curr >= stroll_fbmap_word_nr(iter->nr))
+			return -ENOENT;
+
+		iter->word = iter->bits[iter->curr];
+	}
+
+	bit_no = stroll_bops_ffsul(iter->word) - 1;
+	iter->word &= ~(1UL << bit_no);
+
+	bit_no += (iter->curr * __WORDSIZE);
+	if (bit_no >= iter->nr)
+		return -ENOENT;
+
+	return (int)bit_no;
+}
+
+int
+_stroll_fbmap_init_range_iter_set(
+	struct stroll_fbmap_iter * __restrict iter,
+	const unsigned long * __restrict      bits,
+	unsigned int                          start_bit,
+	unsigned int                          bit_count)
+{
+	stroll_fbmap_assert_api(iter);
+	stroll_fbmap_assert_range(bits, start_bit, bit_count);
+
+	iter->curr = stroll_fbmap_word_no(start_bit);
+	iter->word = bits[iter->curr] & stroll_fbmap_word_high_mask(start_bit);
+	iter->nr = start_bit + bit_count;
+	iter->bits = bits;
+
+	return stroll_fbmap_step_iter_set(iter);
+}
+
+int
+stroll_fbmap_step_iter_clear(struct stroll_fbmap_iter * __restrict iter)
+{
+	stroll_fbmap_assert_iter(iter);
+
+	unsigned int bit_no;
+
+	while (iter->word == ~(0UL)) {
+		if (++iter->curr >= stroll_fbmap_word_nr(iter->nr))
+			return -ENOENT;
+
+		iter->word = iter->bits[iter->curr];
+	}
+
+	bit_no = stroll_bops_ffcul(iter->word) - 1;
+	iter->word |= 1UL << bit_no;
+
+	bit_no += (iter->curr * __WORDSIZE);
+	if (bit_no >= iter->nr)
+		return -ENOENT;
+
+	return (int)bit_no;
+}
+
+int
+_stroll_fbmap_init_range_iter_clear(
+	struct stroll_fbmap_iter * __restrict iter,
+	const unsigned long * __restrict      bits,
+	unsigned int                          start_bit,
+	unsigned int                          bit_count)
+{
+	stroll_fbmap_assert_api(iter);
+	stroll_fbmap_assert_range(bits, start_bit, bit_count);
+
+	iter->curr = stroll_fbmap_word_no(start_bit);
+	iter->word = bits[iter->curr] | ~stroll_fbmap_word_high_mask(start_bit);
+	iter->nr = start_bit + bit_count;
+	iter->bits = bits;
+
+	return stroll_fbmap_step_iter_clear(iter);
+}
+
+/******************************************************************************
+ * Atomic operations
+ ******************************************************************************/
+
+#define stroll_fbmap_assert_order(_order) \
+	stroll_fbmap_assert_api(stroll_atomic_order_is_valid(_order))
+
+void
+_stroll_fbmap_atomic_set_range(unsigned long * __restrict bits,
+                               unsigned int               start_bit,
+                               unsigned int               bit_count,
+                               enum stroll_atomic_order   order)
+{
+	stroll_fbmap_assert_range(bits, start_bit, bit_count);
+	stroll_fbmap_assert_order(order);
+
+	unsigned int  stop_bit = start_bit + bit_count - 1;
+	unsigned int  curr = stroll_fbmap_word_no(start_bit);
+	unsigned int  last = stroll_fbmap_word_no(stop_bit);
+	unsigned long msb = stroll_fbmap_word_high_mask(start_bit);
+	unsigned long lsb = stroll_fbmap_word_low_mask(stop_bit);
+	int           store = (int)stroll_atomic_store_order(order);
+
+	if (curr == last) {
+		__atomic_fetch_or(&bits[curr], msb & lsb, (int)order);
+		return;
+	}
+
+	__atomic_fetch_or(&bits[curr++], msb, (int)order);
+	while (curr < last)
+		__atomic_store_n(&bits[curr++], ~(0UL), store);
+	__atomic_fetch_or(&bits[last], lsb, (int)order);
+}
+
+void
+_stroll_fbmap_atomic_clear_range(unsigned long * __restrict bits,
+                                 unsigned int               start_bit,
+                                 unsigned int               bit_count,
+                                 enum stroll_atomic_order   order)
+{
+	stroll_fbmap_assert_range(bits, start_bit, bit_count);
+	stroll_fbmap_assert_order(order);
+
+	unsigned int  stop_bit = start_bit + bit_count - 1;
+	unsigned int  curr = stroll_fbmap_word_no(start_bit);
+	unsigned int  last = stroll_fbmap_word_no(stop_bit);
+	unsigned long msb = stroll_fbmap_word_high_mask(start_bit);
+	unsigned long lsb = stroll_fbmap_word_low_mask(stop_bit);
+	int           store = (int)stroll_atomic_store_order(order);
+
+	if (curr == last) {
+		__atomic_fetch_and(&bits[curr], ~(msb & lsb), (int)order);
+		return;
+	}
+
+	__atomic_fetch_and(&bits[curr++], ~msb, (int)order);
+	while (curr < last)
+		__atomic_store_n(&bits[curr++], 0UL, store);
+	__atomic_fetch_and(&bits[last], ~lsb, (int)order);
+}
+
+int
+_stroll_fbmap_atomic_find_and_set_first_clear(unsigned long * __restrict bits,
+                                              unsigned int               nr,
+                                              enum stroll_atomic_order   order)
+{
+	stroll_fbmap_assert_bits_api(bits, nr);
+	stroll_fbmap_assert_order(order);
+
+	int          fail = (int)stroll_atomic_fail_order(order);
+	unsigned int last = stroll_fbmap_word_nr(nr) - 1;
+	unsigned int w;
+
+	for (w = 0; w <= last; w++) {
+		/* Pretend bits beyond the end of bitmap are set. */
+		unsigned long pad = (w == last) ?
+		                    ~stroll_fbmap_word_low_mask(nr - 1) : 0;
+		unsigned long old = __atomic_load_n(&bits[w], __ATOMIC_RELAXED);
+
+		while (~(old | pad)) {
+			/* Isolate lowest cleared bit. */
+			unsigned long bit = ~(old | pad) & ((old | pad) + 1);
+
+			if (__atomic_compare_exchange_n(&bits[w],
+			                                &old,
+			                                old | bit,
+			                                false,
+			                                (int)order,
+			                                fail))
+				return (int)((w << STROLL_WORD_SHIFT) +
+				             stroll_bops_ffsul(bit) - 1);
+
+			/* Lost the race: old has been reloaded, try again. */
+		}
+	}
+
+	return -ENOSPC;
+}
+
+bool
+_stroll_fbmap_atomic_cmpxchg_range(unsigned long * __restrict bits,
+                                   unsigned int               start_bit,
+                                   unsigned int               bit_count,
+                                   unsigned long * __restrict expected,
+                                   unsigned long              desired,
+                                   enum stroll_atomic_order   order)
+{
+	stroll_fbmap_assert_range(bits, start_bit, bit_count);
+	stroll_fbmap_assert_api(expected);
+	stroll_fbmap_assert_api((stroll_fbmap_word_bit_no(start_bit) +
+	                         bit_count) <= __WORDSIZE);
+	stroll_fbmap_assert_order(order);
+
+	unsigned long * word = &bits[stroll_fbmap_word_no(start_bit)];
+	unsigned int    shift = stroll_fbmap_word_bit_no(start_bit);
+	unsigned long   mask = stroll_fbmap_word_high_mask(start_bit) &
+	                       stroll_fbmap_word_low_mask(start_bit +
+	                                                  bit_count - 1);
+	int             fail = (int)stroll_atomic_fail_order(order);
+	unsigned long   old = __atomic_load_n(word, fail);
+
+	do {
+		if (((old & mask) >> shift) != *expected) {
+			*expected = (old & mask) >> shift;
+			return false;
+		}
+	} while (!__atomic_compare_exchange_n(word,
+	                                      &old,
+	                                      (old & ~mask) |
+	                                      ((desired << shift) & mask),
+	                                      false,
+	                                      (int)order,
+	                                      fail));
+
+	return true;
+}
+
+/******************************************************************************
+ * Rank / select directory
+ ******************************************************************************/
+
+/*
+ * Directory geometry, expressed as a number of bits: 2048 bits blocks split
+ * into 4 sub-blocks of 512 bits, and a select sample every 8192 bits set.
+ *
+ * Block entries hold the number of bits set before the block into their 32
+ * least significant bits, followed by 3 10-bit fields holding the number of
+ * bits set into each of the first 3 sub-blocks.
+ */
+#define STROLL_FBMAP_RANK_BLOCK_SHIFT  (11U)
+#define STROLL_FBMAP_RANK_SUB_SHIFT    (9U)
+#define STROLL_FBMAP_RANK_SUB_NR \
+	(1U << (STROLL_FBMAP_RANK_BLOCK_SHIFT - STROLL_FBMAP_RANK_SUB_SHIFT))
+#define STROLL_FBMAP_RANK_SUB_WORDS \
+	((1U << STROLL_FBMAP_RANK_SUB_SHIFT) / __WORDSIZE)
+#define STROLL_FBMAP_RANK_SUB_BITS     (10U)
+#define STROLL_FBMAP_RANK_SAMPLE_SHIFT (13U)
+
+/* Offset of a sub-block count field within a block entry. */
+#define stroll_fbmap_rank_sub_shift(_sub) \
+	(32U + ((_sub) * STROLL_FBMAP_RANK_SUB_BITS))
+
+static __const __nothrow __warn_result
+unsigned int
+stroll_fbmap_rank_block_nr(unsigned int bit_nr)
+{
+	return (bit_nr + (1U << STROLL_FBMAP_RANK_BLOCK_SHIFT) - 1) >>
+	       STROLL_FBMAP_RANK_BLOCK_SHIFT;
+}
+
+/*
+ * Return the number of bits set before the sub-block given in argument, i.e.
+ * the number of bits set before the block plus the counts of preceding
+ * sub-blocks.
+ */
+static __const __nothrow __warn_result
+unsigned int
+stroll_fbmap_rank_sub(uint64_t entry, unsigned int sub)
+{
+	unsigned int cnt = (unsigned int)(entry & UINT32_MAX);
+	unsigned int s;
+
+	for (s = 0; s < sub; s++)
+		cnt += (unsigned int)(entry >> stroll_fbmap_rank_sub_shift(s)) &
+		       ((1U << STROLL_FBMAP_RANK_SUB_BITS) - 1);
+
+	return cnt;
+}
+
+/*
+ * Return word given in argument with bits located beyond the end of bitmap
+ * masked out.
+ */
+static __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+unsigned long
+stroll_fbmap_rank_word(const struct stroll_fbmap_rank * __restrict rank,
+                       unsigned int                                word_no)
+{
+	unsigned int last = stroll_fbmap_word_no(rank->nr - 1);
+
+	if (word_no < last)
+		return rank->bits[word_no];
+
+	return rank->bits[last] & stroll_fbmap_word_low_mask(rank->nr - 1);
+}
+
+/*
+ * Return the index of the bit set preceded by index other bits set within the
+ * word given in argument. Narrow search down to a single byte using halving
+ * population counts before walking remaining bits.
+ */
+static __const __nothrow __warn_result
+unsigned int
+stroll_fbmap_select_word(unsigned long word, unsigned int index)
+{
+	unsigned int bit_no = 0;
+	unsigned int width;
+
+	for (width = __WORDSIZE / 2; width >= 8; width /= 2) {
+		unsigned long low = word & ((1UL << width) - 1);
+		unsigned int  cnt = stroll_bops_hweightul(low);
+
+		if (index >= cnt) {
+			index -= cnt;
+			word >>= width;
+			bit_no += width;
+		}
+		else
+			word = low;
+	}
+
+	while (index--)
+		word &= word - 1;
+
+	return bit_no + (unsigned int)__builtin_ctzl(word);
+}
+
+unsigned int
+_stroll_fbmap_rank(const struct stroll_fbmap_rank * __restrict rank,
+                   unsigned int                                bit_no)
+{
+	stroll_fbmap_assert_rank_api(rank);
+	stroll_fbmap_assert_api(bit_no <= rank->nr);
+
+	unsigned int blk = bit_no >> STROLL_FBMAP_RANK_BLOCK_SHIFT;
+	unsigned int sub = (bit_no >> STROLL_FBMAP_RANK_SUB_SHIFT) &
+	                   (STROLL_FBMAP_RANK_SUB_NR - 1);
+	unsigned int curr = (bit_no >> STROLL_FBMAP_RANK_SUB_SHIFT) *
+	                    STROLL_FBMAP_RANK_SUB_WORDS;
+	unsigned int last = stroll_fbmap_word_no(bit_no);
+	unsigned int cnt;
+
+	if (bit_no == rank->nr)
+		return rank->hweight;
+
+	cnt = stroll_fbmap_rank_sub(rank->blocks[blk], sub);
+	while (curr < last)
+		cnt += stroll_bops_hweightul(rank->bits[curr++]);
+
+	return cnt +
+	       stroll_bops_hweightul(rank->bits[last] &
+	                             ~stroll_fbmap_word_high_mask(bit_no));
+}
+
+int
+_stroll_fbmap_select(const struct stroll_fbmap_rank * __restrict rank,
+                     unsigned int                                index)
+{
+	stroll_fbmap_assert_rank_api(rank);
+	stroll_fbmap_assert_api(index < rank->hweight);
+
+	unsigned int smpl = index >> STROLL_FBMAP_RANK_SAMPLE_SHIFT;
+	unsigned int lo = rank->samples[smpl];
+	unsigned int hi;
+	unsigned int sub;
+	unsigned int curr;
+
+	/*
+	 * Block holding the searched bit lies between the block holding the
+	 * current sample and the block holding the next one.
+	 */
+	if ((smpl + 1) <
+	    ((rank->hweight + (1U << STROLL_FBMAP_RANK_SAMPLE_SHIFT) - 1) >>
+	     STROLL_FBMAP_RANK_SAMPLE_SHIFT))
+		hi = rank->samples[smpl + 1];
+	else
+		hi = stroll_fbmap_rank_block_nr(rank->nr) - 1;
+
+	/* Find the last block preceded by at most index bits set. */
+	while (lo < hi) {
+		unsigned int mid = lo + ((hi - lo + 1) / 2);
+
+		if ((unsigned int)(rank->blocks[mid] & UINT32_MAX) <= index)
+			lo = mid;
+		else
+			hi = mid - 1;
+	}
+
+	/* Then the sub-block holding the searched bit. */
+	for (sub = 1; sub < STROLL_FBMAP_RANK_SUB_NR; sub++)
+		if (stroll_fbmap_rank_sub(rank->blocks[lo], sub) > index)
+			break;
+	sub--;
+	index -= stroll_fbmap_rank_sub(rank->blocks[lo], sub);
+
+	/* And finally the word holding the searched bit. */
+	curr = ((lo * STROLL_FBMAP_RANK_SUB_NR) + sub) *
+	       STROLL_FBMAP_RANK_SUB_WORDS;
+	while (true) {
+		unsigned long word = stroll_fbmap_rank_word(rank, curr);
+		unsigned int  cnt = stroll_bops_hweightul(word);
+
+		if (index < cnt)
+			return (int)((curr << STROLL_WORD_SHIFT) +
+			             stroll_fbmap_select_word(word, index));
+
+		index -= cnt;
+		curr++;
+	}
+
+	unreachable();
+}
+
+int
+stroll_fbmap_init_rank(struct stroll_fbmap_rank * __restrict  rank,
+                       const struct stroll_fbmap * __restrict bmap)
+{
+	stroll_fbmap_assert_api(rank);
+	stroll_fbmap_assert_map_api(bmap);
+
+	unsigned int words = stroll_fbmap_word_nr(bmap->nr);
+	unsigned int blk_nr = stroll_fbmap_rank_block_nr(bmap->nr);
+	unsigned int blk;
+	unsigned int smpl = 0;
+	unsigned int cnt = 0;
+
+	rank->blocks = malloc(blk_nr * sizeof(rank->blocks[0]));
+	if (!rank->blocks)
+		return -ENOMEM;
+
+	rank->samples = malloc(((bmap->nr >> STROLL_FBMAP_RANK_SAMPLE_SHIFT) +
+	                        1) *
+	                       sizeof(rank->samples[0]));
+	if (!rank->samples) {
+		free(rank->blocks);
+		return -ENOMEM;
+	}
+
+	rank->nr = bmap->nr;
+	rank->bits = bmap->bits;
+
+	for (blk = 0; blk < blk_nr; blk++) {
+		uint64_t     entry = cnt;
+		unsigned int sub;
+
+		for (sub = 0; sub < STROLL_FBMAP_RANK_SUB_NR; sub++) {
+			unsigned int curr;
+			unsigned int end;
+			unsigned int c = 0;
+
+			curr = ((blk * STROLL_FBMAP_RANK_SUB_NR) + sub) *
+			       STROLL_FBMAP_RANK_SUB_WORDS;
+			end = stroll_min(curr + STROLL_FBMAP_RANK_SUB_WORDS,
+			                 words);
+			if (curr < stroll_min(end, words - 1))
+				/* Whole words but the last one of bitmap. */
+				c = stroll_fbmap_kernels->hweight(
+					&rank->bits[curr],
+					stroll_min(end, words - 1) - curr);
+			if ((curr < end) && (end == words))
+				/* Last word of bitmap, with trailing bits. */
+				c += stroll_bops_hweightul(
+					stroll_fbmap_rank_word(rank,
+					                       words - 1));
+
+			if (sub < (STROLL_FBMAP_RANK_SUB_NR - 1))
+				entry |= (uint64_t)c <<
+				         stroll_fbmap_rank_sub_shift(sub);
+
+			/* Sample blocks holding every 8192th bit set. */
+			while ((smpl << STROLL_FBMAP_RANK_SAMPLE_SHIFT) <
+			       (cnt + c))
+				rank->samples[smpl++] = blk;
+
+			cnt += c;
+		}
+
+		rank->blocks[blk] = entry;
+	}
+
+	rank->hweight = cnt;
+
+	return 0;
+}
+
+/******************************************************************************
+ * Growable bitmaps
+ ******************************************************************************/
+
+/*
+ * Memory areas which size is greater than or equal to this threshold are
+ * allocated using anonymous memory mappings so that they may be grown thanks
+ * to mremap(2) without copying content. Smaller ones are allocated from the
+ * heap.
+ */
+#define STROLL_FBMAP_DYN_MMAP_MIN (128UL * 1024UL)
+
+static __const __nothrow __warn_result
+size_t
+stroll_fbmap_dyn_size(unsigned int bit_nr)
+{
+	return (size_t)stroll_fbmap_word_nr(bit_nr) * sizeof(unsigned long);
+}
+
+/*
+ * Round size given in argument up to the allocation granularity of the
+ * backing memory area.
+ */
+static __pure __nothrow __warn_result
+size_t
+stroll_fbmap_dyn_round(size_t size)
+{
+	if (size < STROLL_FBMAP_DYN_MMAP_MIN)
+		return size;
+
+	return (size + stroll_page_size() - 1) & ~(stroll_page_size() - 1);
+}
+
+/*
+ * Allocate the memory area backing a growable bitmap.
+ * Size MUST have been rounded using stroll_fbmap_dyn_round().
+ */
+static __nothrow __warn_result
+unsigned long *
+stroll_fbmap_dyn_alloc(size_t size)
+{
+	void * bits;
+
+	if (size < STROLL_FBMAP_DYN_MMAP_MIN)
+		return malloc(size);
+
+	bits = mmap(NULL,
+	            size,
+	            PROT_READ | PROT_WRITE,
+	            MAP_PRIVATE | MAP_ANONYMOUS,
+	            -1,
+	            0);
+	if (bits == MAP_FAILED)
+		return NULL;
+
+	return bits;
+}
+
+/*
+ * Modify the size of the memory area backing a growable bitmap, preserving
+ * content located below both current and new sizes.
+ *
+ * Mapped areas are never turned back into heap allocated ones so that they
+ * may be shrunk in place.
+ */
+static __stroll_nonull(1) __nothrow
+int
+stroll_fbmap_dyn_realloc(struct stroll_fbmap_dyn * __restrict dyn,
+                         size_t                               size)
+{
+	void * bits;
+
+	if (dyn->size >= STROLL_FBMAP_DYN_MMAP_MIN) {
+		size = stroll_fbmap_dyn_round(
+			stroll_max(size, STROLL_FBMAP_DYN_MMAP_MIN));
+		if (size == dyn->size)
+			return 0;
+
+		bits = mremap(dyn->map.bits, dyn->size, size, MREMAP_MAYMOVE);
+		if (bits == MAP_FAILED)
+			return -errno;
+	}
+	else if (size >= STROLL_FBMAP_DYN_MMAP_MIN) {
+		bits = stroll_fbmap_dyn_alloc(size);
+		if (!bits)
+			return -errno;
+
+		memcpy(bits, dyn->map.bits, dyn->size);
+		free(dyn->map.bits);
+	}
+	else {
+		bits = realloc(dyn->map.bits, size);
+		if (!bits)
+			return -errno;
+	}
+
+	dyn->map.bits = bits;
+	dyn->size = size;
+
+	return 0;
+}
+
+int
+stroll_fbmap_resize_dyn(struct stroll_fbmap_dyn * __restrict dyn,
+                        unsigned int                         bit_nr)
+{
+	stroll_fbmap_assert_dyn_api(dyn);
+	stroll_fbmap_assert_api(bit_nr);
+	stroll_fbmap_assert_api(bit_nr <= (unsigned int)INT_MAX);
+
+	unsigned int old_nr = dyn->map.nr;
+	size_t       need = stroll_fbmap_dyn_size(bit_nr);
+
+	if (need > dyn->size) {
+		/* Grow geometrically to amortize resizing cost. */
+		size_t size = stroll_max(need,
+		                         stroll_min(2 * dyn->size,
+		                                    stroll_fbmap_dyn_size(
+		                                          (unsigned int)
+		                                          INT_MAX)));
+		int    err;
+
+		err = stroll_fbmap_dyn_realloc(dyn,
+		                               stroll_fbmap_dyn_round(size));
+		if (err)
+			return err;
+	}
+	else if (need <= (dyn->size / 4))
+		/*
+		 * Release excess capacity, leaving room for further growth.
+		 * Failing to shrink is harmless since current memory area
+		 * remains valid.
+		 */
+		stroll_fbmap_dyn_realloc(dyn,
+		                         stroll_fbmap_dyn_round(2 * need));
+
+	if (bit_nr > old_nr) {
+		unsigned int last = stroll_fbmap_word_no(old_nr - 1);
+		unsigned int words = stroll_fbmap_word_nr(bit_nr);
+
+		/*
+		 * Clear bits beyond the current end of bitmap: these may have
+		 * been set by whole word operations or left over by a previous
+		 * shrink.
+		 */
+		dyn->map.bits[last] &= stroll_fbmap_word_low_mask(old_nr - 1);
+		memset(&dyn->map.bits[last + 1],
+		       0,
+		       (words - last - 1) * sizeof(dyn->map.bits[0]));
+	}
+
+	dyn->map.nr = bit_nr;
+
+	return 0;
+}
+
+int
+stroll_fbmap_init_dyn(struct stroll_fbmap_dyn * __restrict dyn,
+                      unsigned int                         bit_nr)
+{
+	stroll_fbmap_assert_api(dyn);
+	stroll_fbmap_assert_api(bit_nr);
+	stroll_fbmap_assert_api(bit_nr <= (unsigned int)INT_MAX);
+
+	size_t size = stroll_fbmap_dyn_round(stroll_fbmap_dyn_size(bit_nr));
+
+	dyn->map.bits = stroll_fbmap_dyn_alloc(size);
+	if (!dyn->map.bits)
+		return -errno;
+
+	if (size < STROLL_FBMAP_DYN_MMAP_MIN)
+		/* Anonymous mappings are zero filled. */
+		memset(dyn->map.bits, 0, size);
+
+	dyn->map.nr = bit_nr;
+	dyn->size = size;
+
+	return 0;
+}
+
+void
+stroll_fbmap_fini_dyn(struct stroll_fbmap_dyn * __restrict dyn)
+{
+	stroll_fbmap_assert_dyn_api(dyn);
+
+	if (dyn->size >= STROLL_FBMAP_DYN_MMAP_MIN)
+		munmap(dyn->map.bits, dyn->size);
+	else
+		free(dyn->map.bits);
+}
+
+#if defined(CONFIG_STROLL_FBMAP_FILE)
+
+/******************************************************************************
+ * Memory mapped file backed bitmaps
+ ******************************************************************************/
+
+/* "SFBM" when stored using little endian byte order. */
+#define STROLL_FBMAP_FILE_MAGIC   UINT32_C(0x4d424653)
+#define STROLL_FBMAP_FILE_VERSION UINT16_C(1)
+
+/*
+ * File header.
+ *
+ * Sized to 64 bytes so that bit values that follow are properly aligned for
+ * word and SIMD accesses. Reserved fields are zeroed at creation time and left
+ * for future format extensions.
+ */
+struct stroll_fbmap_file_head {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t word_size;
+	uint32_t nr;
+	uint32_t reserved0;
+	uint64_t csum;
+	uint64_t reserved1[5];
+};
+
+static __const __nothrow __warn_result
+size_t
+stroll_fbmap_file_size(unsigned int bit_nr)
+{
+	return sizeof(struct stroll_fbmap_file_head) +
+	       ((size_t)stroll_fbmap_word_nr(bit_nr) * sizeof(unsigned long));
+}
+
+/*
+ * Compute checksum of bit values using a word wise FNV-1a variant. Trailing
+ * bits located beyond the end of bitmap are masked out since whole word
+ * operations may modify them.
+ */
+static __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+uint64_t
+stroll_fbmap_file_csum(const unsigned long * __restrict bits,
+                       unsigned int                     nr)
+{
+	unsigned int last = stroll_fbmap_word_no(nr - 1);
+	uint64_t     csum = UINT64_C(0xcbf29ce484222325);
+	unsigned int w;
+
+	for (w = 0; w < last; w++)
+		csum = (csum ^ bits[w]) * UINT64_C(0x100000001b3);
+
+	return (csum ^ (bits[last] & stroll_fbmap_word_low_mask(nr - 1))) *
+	       UINT64_C(0x100000001b3);
+}
+
+static __stroll_nonull(1, 2) __stroll_nothrow
+void
+stroll_fbmap_file_setup(struct stroll_fbmap_file * __restrict file,
+                        void * __restrict                     addr,
+                        size_t                                size,
+                        unsigned int                          bit_nr,
+                        int                                   flags)
+{
+	file->map.nr = bit_nr;
+	file->map.bits = (unsigned long *)
+	                 ((struct stroll_fbmap_file_head *)addr + 1);
+	file->addr = addr;
+	file->size = size;
+	file->flags = flags;
+}
+
+int
+stroll_fbmap_flush_file_range(
+	const struct stroll_fbmap_file * __restrict file,
+	unsigned int                                start_bit,
+	unsigned int                                bit_count)
+{
+	stroll_fbmap_assert_file_api(file);
+	stroll_fbmap_assert_api(!(file->flags & STROLL_FBMAP_FILE_RDONLY));
+	stroll_fbmap_assert_api(bit_count);
+	stroll_fbmap_assert_api((start_bit + bit_count) <= file->map.nr);
+
+	const char * first = (const char *)
+	                     &file->map.bits[stroll_fbmap_word_no(start_bit)];
+	const char * last = (const char *)
+	                    &file->map.bits[stroll_fbmap_word_no(start_bit +
+	                                                         bit_count -
+	                                                         1) + 1];
+	size_t       off = stroll_align_lower(
+		(size_t)(first - (const char *)file->addr),
+		stroll_page_size());
+
+	if (msync((char *)file->addr + off,
+	          (size_t)(last - (const char *)file->addr) - off,
+	          MS_SYNC))
+		return -errno;
+
+	return 0;
+}
+
+int
+stroll_fbmap_sync_file(struct stroll_fbmap_file * __restrict file)
+{
+	stroll_fbmap_assert_file_api(file);
+	stroll_fbmap_assert_api(!(file->flags & STROLL_FBMAP_FILE_RDONLY));
+
+	struct stroll_fbmap_file_head * head = file->addr;
+
+	head->csum = stroll_fbmap_file_csum(file->map.bits, file->map.nr);
+	if (msync(file->addr, file->size, MS_SYNC))
+		return -errno;
+
+	return 0;
+}
+
+int
+stroll_fbmap_create_file(struct stroll_fbmap_file * __restrict file,
+                         const char * __restrict               path,
+                         unsigned int                          bit_nr,
+                         mode_t                                mode)
+{
+	stroll_fbmap_assert_api(file);
+	stroll_fbmap_assert_api(path);
+	stroll_fbmap_assert_api(bit_nr);
+	stroll_fbmap_assert_api(bit_nr <= (unsigned int)INT_MAX);
+	compile_assert(sizeof(struct stroll_fbmap_file_head) == 64);
+
+	size_t                          size = stroll_fbmap_file_size(bit_nr);
+	int                             fd;
+	struct stroll_fbmap_file_head * head;
+	int                             err;
+
+	fd = open(path, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, mode);
+	if (fd < 0)
+		return -errno;
+
+	/* Extending file fills it with zeros, i.e. all bits cleared. */
+	if (ftruncate(fd, (off_t)size)) {
+		err = -errno;
+		goto unlink;
+	}
+
+	head = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (head == MAP_FAILED) {
+		err = -errno;
+		goto unlink;
+	}
+
+	close(fd);
+
+	head->magic = STROLL_FBMAP_FILE_MAGIC;
+	head->version = STROLL_FBMAP_FILE_VERSION;
+	head->word_size = (uint16_t)sizeof(unsigned long);
+	head->nr = bit_nr;
+	/*
+	 * Checksum the empty bitmap so that the file may be verified even if
+	 * never synced.
+	 */
+	head->csum = stroll_fbmap_file_csum((const unsigned long *)(head + 1),
+	                                    bit_nr);
+
+	stroll_fbmap_file_setup(file, head, size, bit_nr, 0);
+
+	return 0;
+
+unlink:
+	unlink(path);
+	close(fd);
+
+	return err;
+}
+
+int
+stroll_fbmap_open_file(struct stroll_fbmap_file * __restrict file,
+                       const char * __restrict               path,
+                       int                                   flags)
+{
+	stroll_fbmap_assert_api(file);
+	stroll_fbmap_assert_api(path);
+	stroll_fbmap_assert_api(!(flags & ~(STROLL_FBMAP_FILE_RDONLY |
+	                                    STROLL_FBMAP_FILE_VERIFY)));
+
+	bool                            rdonly;
+	int                             fd;
+	struct stat                     st;
+	struct stroll_fbmap_file_head * head;
+	int                             err;
+
+	rdonly = !!(flags & STROLL_FBMAP_FILE_RDONLY);
+	fd = open(path, (rdonly ? O_RDONLY : O_RDWR) | O_CLOEXEC);
+	if (fd < 0)
+		return -errno;
+
+	if (fstat(fd, &st)) {
+		err = -errno;
+		goto close;
+	}
+
+	if (!S_ISREG(st.st_mode) ||
+	    ((size_t)st.st_size <= sizeof(*head))) {
+		err = -EBADMSG;
+		goto close;
+	}
+
+	head = mmap(NULL,
+	            (size_t)st.st_size,
+	            rdonly ? PROT_READ : (PROT_READ | PROT_WRITE),
+	            MAP_SHARED,
+	            fd,
+	            0);
+	if (head == MAP_FAILED) {
+		err = -errno;
+		goto close;
+	}
+
+	close(fd);
+
+	if (head->magic != STROLL_FBMAP_FILE_MAGIC) {
+		err = -EBADMSG;
+		goto unmap;
+	}
+
+	if ((head->version != STROLL_FBMAP_FILE_VERSION) ||
+	    (head->word_size != sizeof(unsigned long))) {
+		err = -ENOTSUP;
+		goto unmap;
+	}
+
+	if (!head->nr ||
+	    (head->nr > (unsigned int)INT_MAX) ||
+	    (stroll_fbmap_file_size(head->nr) != (size_t)st.st_size)) {
+		err = -EBADMSG;
+		goto unmap;
+	}
+
+	if ((flags & STROLL_FBMAP_FILE_VERIFY) &&
+	    (stroll_fbmap_file_csum((const unsigned long *)(head + 1),
+	                            head->nr) != head->csum)) {
+		err = -EBADMSG;
+		goto unmap;
+	}
+
+	stroll_fbmap_file_setup(file,
+	                        head,
+	                        (size_t)st.st_size,
+	                        head->nr,
+	                        flags);
+
+	return 0;
+
+unmap:
+	munmap(head, (size_t)st.st_size);
+
+	return err;
+
+close:
+	close(fd);
+
+	return err;
+}
+
+int
+stroll_fbmap_close_file(struct stroll_fbmap_file * __restrict file)
+{
+	stroll_fbmap_assert_file_api(file);
+
+	int err = 0;
+
+	if (!(file->flags & STROLL_FBMAP_FILE_RDONLY))
+		err = stroll_fbmap_sync_file(file);
+
+	munmap(file->addr, file->size);
+
+	return err;
+}
+
+#endif /* defined(CONFIG_STROLL_FBMAP_FILE) */
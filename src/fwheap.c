@@ -426,24 +426,32 @@ stroll_fwheap_sort_mem(char * __restrict          array,
 	}
 }
 
-int
-stroll_array_fwheap_sort(void * __restrict     array,
-                         unsigned int          nr,
-                         size_t                size,
-                         stroll_array_cmp_fn * compare,
-                         void *                data)
+size_t
+stroll_array_fwheap_sort_scratch_size(unsigned int nr)
+{
+	stroll_fwheap_assert_api(nr);
+
+	return stroll_fbmap_word_nr(nr) * sizeof(unsigned long);
+}
+
+void
+stroll_array_fwheap_sort_with_scratch(void * __restrict     array,
+                                      unsigned int          nr,
+                                      size_t                size,
+                                      stroll_array_cmp_fn * compare,
+                                      void *                data,
+                                      void * __restrict     scratch)
 {
 	stroll_fwheap_assert_api(array);
 	stroll_fwheap_assert_api(nr);
 	stroll_fwheap_assert_api(size);
 	stroll_fwheap_assert_api(compare);
+	stroll_fwheap_assert_api(scratch);
+	stroll_fwheap_assert_api(stroll_aligned((unsigned long)scratch,
+	                                        sizeof(unsigned long)));
 
 	if (nr > 1) {
-		unsigned long * rbits;
-
-		rbits = malloc(stroll_fbmap_word_nr(nr) * sizeof(rbits[0]));
-		if (!rbits)
-			return -errno;
+		unsigned long * rbits = scratch;
 
 		if (stroll_array_aligned(array, size, sizeof(uint32_t)))
 			stroll_fwheap_sort32(array, rbits, nr, compare, data);
@@ -456,6 +464,34 @@ stroll_array_fwheap_sort(void * __restrict     array,
 			                       size,
 			                       compare,
 			                       data);
+	}
+}
+
+int
+stroll_array_fwheap_sort(void * __restrict     array,
+                         unsigned int          nr,
+                         size_t                size,
+                         stroll_array_cmp_fn * compare,
+                         void *                data)
+{
+	stroll_fwheap_assert_api(array);
+	stroll_fwheap_assert_api(nr);
+	stroll_fwheap_assert_api(size);
+	stroll_fwheap_assert_api(compare);
+
+	if (nr > 1) {
+		void * rbits;
+
+		rbits = malloc(stroll_array_fwheap_sort_scratch_size(nr));
+		if (!rbits)
+			return -errno;
+
+		stroll_array_fwheap_sort_with_scratch(array,
+		                                      nr,
+		                                      size,
+		                                      compare,
+		                                      data,
+		                                      rbits);
 
 		free(rbits);
 	}
@@ -0,0 +1,483 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#include "stroll/hbmap.h"
+#include "stroll/bops.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Both summary hierarchies are handled by the same code. Level 0 of the
+ * cleared bits hierarchy is the array of bits itself which is inverted on the
+ * fly. Bits beyond the last significant one of the array of bits are kept
+ * cleared: these are seen as cleared bits by the cleared bits hierarchy and
+ * searching results are checked against the number of significant bits.
+ */
+#define STROLL_HBMAP_SET_INV   (0UL)
+#define STROLL_HBMAP_CLEAR_INV (~0UL)
+
+static inline __const __nothrow __warn_result
+unsigned int
+stroll_hbmap_word_no(unsigned int bit_no)
+{
+	return bit_no >> STROLL_WORD_SHIFT;
+}
+
+static inline __const __nothrow __warn_result
+unsigned int
+stroll_hbmap_word_nr(unsigned int bit_nr)
+{
+	return stroll_hbmap_word_no(bit_nr + __WORDSIZE - 1);
+}
+
+static inline __const __nothrow __warn_result
+unsigned long
+stroll_hbmap_bit_mask(unsigned int bit_no)
+{
+	return 1UL << (bit_no & (__WORDSIZE - 1));
+}
+
+/*
+ * Return a bit mask suitable for masking out all bits lower that the bit index
+ * given in argument.
+ */
+static inline __const __nothrow __warn_result
+unsigned long
+stroll_hbmap_high_mask(unsigned int bit_no)
+{
+	return ~(0UL) << (bit_no & (__WORDSIZE - 1));
+}
+
+/*
+ * Return a bit mask suitable for masking out all bits higher that the bit index
+ * given in argument.
+ */
+static inline __const __nothrow __warn_result
+unsigned long
+stroll_hbmap_low_mask(unsigned int bit_no)
+{
+	return ~(0UL) >> (__WORDSIZE - 1 - (bit_no & (__WORDSIZE - 1)));
+}
+
+/*
+ * Return content of a word at the given level of a summary hierarchy.
+ */
+static inline __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+unsigned long
+stroll_hbmap_word(unsigned long * const * __restrict levels,
+                  unsigned long                      inv,
+                  unsigned int                       level,
+                  unsigned int                       word_no)
+{
+	return levels[level][word_no] ^ (level ? 0UL : inv);
+}
+
+/*
+ * Walk down a summary hierarchy from the given word of the given level till
+ * level 0, following the first bit set at each level.
+ */
+static __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+int
+stroll_hbmap_descend(unsigned long * const * __restrict levels,
+                     unsigned long                      inv,
+                     unsigned int                       level,
+                     unsigned int                       word_no,
+                     unsigned int                       nr)
+{
+	unsigned long word;
+	unsigned int  bit_no;
+
+	while (true) {
+		word = stroll_hbmap_word(levels, inv, level, word_no);
+		if (!word)
+			/* May only happen at top level. */
+			return -ENOENT;
+
+		bit_no = (word_no << STROLL_WORD_SHIFT) +
+		         stroll_bops_ffsul(word) - 1;
+		if (!level--)
+			break;
+
+		word_no = bit_no;
+	}
+
+	return (bit_no < nr) ? (int)bit_no : -ENOENT;
+}
+
+static __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+int
+stroll_hbmap_find_next(unsigned long * const * __restrict levels,
+                       unsigned long                      inv,
+                       unsigned int                       depth,
+                       unsigned int                       bit_no,
+                       unsigned int                       nr)
+{
+	unsigned int  level;
+	unsigned int  word_no = stroll_hbmap_word_no(bit_no);
+	unsigned long word;
+
+	if (bit_no >= nr)
+		return -ENOENT;
+
+	word = stroll_hbmap_word(levels, inv, 0, word_no) &
+	       stroll_hbmap_high_mask(bit_no);
+	if (word) {
+		bit_no = (word_no << STROLL_WORD_SHIFT) +
+		         stroll_bops_ffsul(word) - 1;
+
+		return (bit_no < nr) ? (int)bit_no : -ENOENT;
+	}
+
+	/*
+	 * Climb up the hierarchy till a summary word with a bit set beyond the
+	 * one of the current word is found...
+	 */
+	for (level = 1; level <= depth; level++) {
+		bit_no = word_no + 1;
+		word_no = stroll_hbmap_word_no(word_no);
+
+		if (stroll_hbmap_word_no(bit_no) != word_no)
+			/* Current word is the last one of its parent word. */
+			continue;
+
+		word = levels[level][word_no] & stroll_hbmap_high_mask(bit_no);
+		if (word)
+			/* ...then walk down to level 0. */
+			return stroll_hbmap_descend(
+				levels,
+				inv,
+				level - 1,
+				(word_no << STROLL_WORD_SHIFT) +
+				stroll_bops_ffsul(word) - 1,
+				nr);
+	}
+
+	return -ENOENT;
+}
+
+/*
+ * Propagate the state of a modified level 0 word up to the top of a summary
+ * hierarchy. Stop as soon as a summary word remains zero / non-zero since upper
+ * levels cannot be affected.
+ */
+static __stroll_nonull(1) __stroll_nothrow
+void
+stroll_hbmap_update(unsigned long * const * __restrict levels,
+                    unsigned long                      inv,
+                    unsigned int                       depth,
+                    unsigned int                       word_no)
+{
+	unsigned int level;
+
+	for (level = 1; level <= depth; level++) {
+		unsigned long * sum = &levels[level][stroll_hbmap_word_no(
+			word_no)];
+		unsigned long   msk = stroll_hbmap_bit_mask(word_no);
+		unsigned long   old = *sum;
+
+		if (stroll_hbmap_word(levels, inv, level - 1, word_no))
+			*sum |= msk;
+		else
+			*sum &= ~msk;
+
+		if (!*sum == !old)
+			break;
+
+		word_no = stroll_hbmap_word_no(word_no);
+	}
+}
+
+/*
+ * Recompute summary bits of a summary hierarchy for the given range of level 0
+ * words.
+ */
+static __stroll_nonull(1) __stroll_nothrow
+void
+stroll_hbmap_sync(unsigned long * const * __restrict levels,
+                  unsigned long                      inv,
+                  unsigned int                       depth,
+                  unsigned int                       first_word,
+                  unsigned int                       last_word)
+{
+	unsigned int level;
+
+	for (level = 1; level <= depth; level++) {
+		unsigned int w;
+
+		for (w = first_word; w <= last_word; w++) {
+			unsigned long * sum =
+				&levels[level][stroll_hbmap_word_no(w)];
+			unsigned long   msk = stroll_hbmap_bit_mask(w);
+
+			if (stroll_hbmap_word(levels, inv, level - 1, w))
+				*sum |= msk;
+			else
+				*sum &= ~msk;
+		}
+
+		first_word = stroll_hbmap_word_no(first_word);
+		last_word = stroll_hbmap_word_no(last_word);
+	}
+}
+
+static __stroll_nonull(1) __stroll_nothrow
+void
+stroll_hbmap_sync_all(struct stroll_hbmap * __restrict hbmap,
+                      unsigned int                     first_word,
+                      unsigned int                     last_word)
+{
+	stroll_hbmap_sync(hbmap->set,
+	                  STROLL_HBMAP_SET_INV,
+	                  hbmap->depth,
+	                  first_word,
+	                  last_word);
+	stroll_hbmap_sync(hbmap->clear,
+	                  STROLL_HBMAP_CLEAR_INV,
+	                  hbmap->depth,
+	                  first_word,
+	                  last_word);
+}
+
+void
+stroll_hbmap_set(struct stroll_hbmap * __restrict hbmap, unsigned int bit_no)
+{
+	stroll_hbmap_assert_map_api(hbmap);
+	stroll_hbmap_assert_api(bit_no < hbmap->nr);
+
+	unsigned int word_no = stroll_hbmap_word_no(bit_no);
+
+	hbmap->set[0][word_no] |= stroll_hbmap_bit_mask(bit_no);
+
+	stroll_hbmap_update(hbmap->set,
+	                    STROLL_HBMAP_SET_INV,
+	                    hbmap->depth,
+	                    word_no);
+	stroll_hbmap_update(hbmap->clear,
+	                    STROLL_HBMAP_CLEAR_INV,
+	                    hbmap->depth,
+	                    word_no);
+}
+
+void
+stroll_hbmap_clear(struct stroll_hbmap * __restrict hbmap, unsigned int bit_no)
+{
+	stroll_hbmap_assert_map_api(hbmap);
+	stroll_hbmap_assert_api(bit_no < hbmap->nr);
+
+	unsigned int word_no = stroll_hbmap_word_no(bit_no);
+
+	hbmap->set[0][word_no] &= ~stroll_hbmap_bit_mask(bit_no);
+
+	stroll_hbmap_update(hbmap->set,
+	                    STROLL_HBMAP_SET_INV,
+	                    hbmap->depth,
+	                    word_no);
+	stroll_hbmap_update(hbmap->clear,
+	                    STROLL_HBMAP_CLEAR_INV,
+	                    hbmap->depth,
+	                    word_no);
+}
+
+#define stroll_hbmap_assert_range(_hbmap, _start_bit, _bit_count) \
+	stroll_hbmap_assert_map_api(_hbmap); \
+	stroll_hbmap_assert_api(_bit_count); \
+	stroll_hbmap_assert_api((_start_bit) < (_hbmap)->nr); \
+	stroll_hbmap_assert_api((_bit_count) <= ((_hbmap)->nr - (_start_bit)))
+
+void
+stroll_hbmap_set_range(struct stroll_hbmap * __restrict hbmap,
+                       unsigned int                     start_bit,
+                       unsigned int                     bit_count)
+{
+	stroll_hbmap_assert_range(hbmap, start_bit, bit_count);
+
+	unsigned long * bits = hbmap->set[0];
+	unsigned int    stop_bit = start_bit + bit_count - 1;
+	unsigned int    first = stroll_hbmap_word_no(start_bit);
+	unsigned int    last = stroll_hbmap_word_no(stop_bit);
+	unsigned long   msb = stroll_hbmap_high_mask(start_bit);
+	unsigned long   lsb = stroll_hbmap_low_mask(stop_bit);
+
+	if (first != last) {
+		bits[first] |= msb;
+		if ((last - first) > 1)
+			memset(&bits[first + 1],
+			       0xff,
+			       (last - first - 1) * sizeof(bits[0]));
+		bits[last] |= lsb;
+	}
+	else
+		bits[first] |= msb & lsb;
+
+	stroll_hbmap_sync_all(hbmap, first, last);
+}
+
+void
+stroll_hbmap_clear_range(struct stroll_hbmap * __restrict hbmap,
+                         unsigned int                     start_bit,
+                         unsigned int                     bit_count)
+{
+	stroll_hbmap_assert_range(hbmap, start_bit, bit_count);
+
+	unsigned long * bits = hbmap->set[0];
+	unsigned int    stop_bit = start_bit + bit_count - 1;
+	unsigned int    first = stroll_hbmap_word_no(start_bit);
+	unsigned int    last = stroll_hbmap_word_no(stop_bit);
+	unsigned long   msb = stroll_hbmap_high_mask(start_bit);
+	unsigned long   lsb = stroll_hbmap_low_mask(stop_bit);
+
+	if (first != last) {
+		bits[first] &= ~msb;
+		if ((last - first) > 1)
+			memset(&bits[first + 1],
+			       0,
+			       (last - first - 1) * sizeof(bits[0]));
+		bits[last] &= ~lsb;
+	}
+	else
+		bits[first] &= ~(msb & lsb);
+
+	stroll_hbmap_sync_all(hbmap, first, last);
+}
+
+int
+stroll_hbmap_find_first_set(const struct stroll_hbmap * __restrict hbmap)
+{
+	stroll_hbmap_assert_map_api(hbmap);
+
+	return stroll_hbmap_descend(hbmap->set,
+	                            STROLL_HBMAP_SET_INV,
+	                            hbmap->depth,
+	                            0,
+	                            hbmap->nr);
+}
+
+int
+stroll_hbmap_find_next_set(const struct stroll_hbmap * __restrict hbmap,
+                           unsigned int                           bit_no)
+{
+	stroll_hbmap_assert_map_api(hbmap);
+	stroll_hbmap_assert_api(bit_no <= hbmap->nr);
+
+	return stroll_hbmap_find_next(hbmap->set,
+	                              STROLL_HBMAP_SET_INV,
+	                              hbmap->depth,
+	                              bit_no,
+	                              hbmap->nr);
+}
+
+int
+stroll_hbmap_find_first_clear(const struct stroll_hbmap * __restrict hbmap)
+{
+	stroll_hbmap_assert_map_api(hbmap);
+
+	return stroll_hbmap_descend(hbmap->clear,
+	                            STROLL_HBMAP_CLEAR_INV,
+	                            hbmap->depth,
+	                            0,
+	                            hbmap->nr);
+}
+
+int
+stroll_hbmap_find_next_clear(const struct stroll_hbmap * __restrict hbmap,
+                             unsigned int                           bit_no)
+{
+	stroll_hbmap_assert_map_api(hbmap);
+	stroll_hbmap_assert_api(bit_no <= hbmap->nr);
+
+	return stroll_hbmap_find_next(hbmap->clear,
+	                              STROLL_HBMAP_CLEAR_INV,
+	                              hbmap->depth,
+	                              bit_no,
+	                              hbmap->nr);
+}
+
+/*
+ * Allocate a single memory area holding the array of bits followed by all
+ * levels of both summary hierarchies.
+ */
+static __stroll_nonull(1) __stroll_nothrow __warn_result
+int
+stroll_hbmap_init(struct stroll_hbmap * __restrict hbmap, unsigned int bit_nr)
+{
+	stroll_hbmap_assert_api(hbmap);
+	stroll_hbmap_assert_api(bit_nr);
+	stroll_hbmap_assert_api(bit_nr <= (unsigned int)INT_MAX);
+
+	unsigned int    cnt[STROLL_HBMAP_DEPTH_MAX + 1];
+	unsigned int    depth = 0;
+	unsigned int    total;
+	unsigned long * words;
+	unsigned int    l;
+
+	cnt[0] = stroll_hbmap_word_nr(bit_nr);
+	total = cnt[0];
+	while (cnt[depth] > 1) {
+		depth++;
+		stroll_hbmap_assert_api(depth <= STROLL_HBMAP_DEPTH_MAX);
+		cnt[depth] = stroll_hbmap_word_nr(cnt[depth - 1]);
+		total += 2 * cnt[depth];
+	}
+
+	words = calloc(total, sizeof(words[0]));
+	if (!words)
+		return -ENOMEM;
+
+	hbmap->set[0] = words;
+	hbmap->clear[0] = words;
+	words += cnt[0];
+	for (l = 1; l <= depth; l++) {
+		hbmap->set[l] = words;
+		words += cnt[l];
+		hbmap->clear[l] = words;
+		words += cnt[l];
+	}
+
+	hbmap->nr = bit_nr;
+	hbmap->depth = depth;
+
+	return 0;
+}
+
+int
+stroll_hbmap_init_clear(struct stroll_hbmap * __restrict hbmap,
+                        unsigned int                     bit_nr)
+{
+	int err;
+
+	err = stroll_hbmap_init(hbmap, bit_nr);
+	if (err)
+		return err;
+
+	stroll_hbmap_sync_all(hbmap, 0, stroll_hbmap_word_nr(bit_nr) - 1);
+
+	return 0;
+}
+
+int
+stroll_hbmap_init_set(struct stroll_hbmap * __restrict hbmap,
+                      unsigned int                     bit_nr)
+{
+	int err;
+
+	err = stroll_hbmap_init(hbmap, bit_nr);
+	if (err)
+		return err;
+
+	stroll_hbmap_set_range(hbmap, 0, bit_nr);
+
+	return 0;
+}
+
+void
+stroll_hbmap_fini(struct stroll_hbmap * __restrict hbmap)
+{
+	stroll_hbmap_assert_map_api(hbmap);
+
+	free(hbmap->set[0]);
+}
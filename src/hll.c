@@ -0,0 +1,432 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#include "stroll/hll.h"
+#include "stroll/hash.h"
+#include "stroll/bops.h"
+#include "log.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Number of registers merged per iteration. This is a compile time constant so
+ * that the compiler may fully vectorize the inner merging loop without having
+ * to generate a scalar epilogue.
+ */
+#define STROLL_HLL_MERGE_STRIDE (16U)
+
+/* Minimum number of sparse entries allocated. */
+#define STROLL_HLL_SPARSE_MIN   (8U)
+
+#define stroll_hll_assert_compat_api(_result, _hll) \
+	stroll_hll_assert_sketch_api(_result); \
+	stroll_hll_assert_sketch_api(_hll); \
+	stroll_hll_assert_api((_result)->prec == (_hll)->prec)
+
+#define stroll_hll_sparse_entry(_index, _rank) \
+	(((_index) << 8) | (_rank))
+
+#define stroll_hll_sparse_index(_entry) \
+	((_entry) >> 8)
+
+#define stroll_hll_sparse_rank(_entry) \
+	((uint8_t)((_entry) & 0xffU))
+
+/*
+ * Maximum number of sparse entries, i.e. so that the sparse layout never uses
+ * more memory than the dense one.
+ */
+static inline __const __nothrow __warn_result
+unsigned int
+stroll_hll_sparse_max(unsigned int prec)
+{
+	return (1U << prec) / sizeof(uint32_t);
+}
+
+/*
+ * Mix all bits of a key into a 64-bit hash.
+ *
+ * stroll_hash64() only provides up to 32 significant bits whereas HyperLogLog
+ * requires a full 64-bit hash with good avalanche properties, even for
+ * sequential keys. Hence the additional xor-shift rounds combined with the
+ * <stroll/hash.h> 64-bit golden ratio multiplier.
+ */
+static inline __const __nothrow __warn_result
+uint64_t
+stroll_hll_hash(uint64_t key)
+{
+	key ^= key >> 32;
+	key *= STROLL_HASH_GOLDEN_RATIO64;
+	key ^= key >> 29;
+	key *= STROLL_HASH_GOLDEN_RATIO64;
+
+	return key ^ (key >> 32);
+}
+
+/*
+ * Return the register index given by the upper prec bits of hash and the rank
+ * of the remaining lower bits. A sentinel bit bounds rank to 64 - prec + 1.
+ */
+static inline __stroll_nonull(3, 4) __stroll_nothrow
+void
+stroll_hll_split(uint64_t                  hash,
+                 unsigned int              prec,
+                 unsigned int * __restrict index,
+                 uint8_t * __restrict      rank)
+{
+	*index = (unsigned int)(hash >> (64U - prec));
+	*rank = (uint8_t)(65U - stroll_bops_fls64((hash << prec) |
+	                                          (UINT64_C(1) <<
+	                                           (prec - 1))));
+}
+
+/* Find the position of the first sparse entry which index >= index. */
+static __stroll_nonull(1) __stroll_pure __stroll_nothrow __warn_result
+unsigned int
+stroll_hll_sparse_find(const struct stroll_hll * __restrict hll,
+                       unsigned int                        index)
+{
+	unsigned int lo = 0;
+	unsigned int hi = hll->sparse_nr;
+
+	while (lo < hi) {
+		unsigned int mid = lo + ((hi - lo) / 2);
+
+		if (stroll_hll_sparse_index(hll->sparse[mid]) < index)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+static __stroll_nonull(1) __stroll_nothrow
+void
+stroll_hll_apply_sparse(uint8_t * __restrict        regs,
+                        const uint32_t * __restrict sparse,
+                        unsigned int                nr)
+{
+	unsigned int e;
+
+	for (e = 0; e < nr; e++) {
+		unsigned int idx = stroll_hll_sparse_index(sparse[e]);
+		uint8_t      rank = stroll_hll_sparse_rank(sparse[e]);
+
+		regs[idx] = (uint8_t)stroll_max(regs[idx], rank);
+	}
+}
+
+int
+stroll_hll_densify(struct stroll_hll * __restrict hll)
+{
+	stroll_hll_assert_sketch_api(hll);
+
+	uint8_t * regs;
+
+	if (hll->regs)
+		return 0;
+
+	regs = malloc(1U << hll->prec);
+	if (!regs)
+		return -errno;
+
+	memset(regs, 0, 1U << hll->prec);
+	stroll_hll_apply_sparse(regs, hll->sparse, hll->sparse_nr);
+
+	free(hll->sparse);
+	hll->sparse = NULL;
+	hll->sparse_nr = 0;
+	hll->sparse_max = 0;
+	hll->regs = regs;
+
+	return 0;
+}
+
+/*
+ * Register an index / rank pair using the sparse layout. Return 1 when the
+ * sparse layout is full and the estimator should switch to dense layout.
+ */
+static __stroll_nonull(1) __stroll_nothrow __warn_result
+int
+stroll_hll_insert_sparse(struct stroll_hll * __restrict hll,
+                         unsigned int                   index,
+                         uint8_t                        rank)
+{
+	unsigned int pos;
+
+	pos = stroll_hll_sparse_find(hll, index);
+	if ((pos < hll->sparse_nr) &&
+	    (stroll_hll_sparse_index(hll->sparse[pos]) == index)) {
+		if (rank > stroll_hll_sparse_rank(hll->sparse[pos]))
+			hll->sparse[pos] = stroll_hll_sparse_entry(index, rank);
+		return 0;
+	}
+
+	if (hll->sparse_nr == hll->sparse_max) {
+		unsigned int max = stroll_hll_sparse_max(hll->prec);
+		uint32_t *   sparse;
+
+		if (hll->sparse_max == max)
+			return 1;
+
+		max = stroll_min(stroll_max(2 * hll->sparse_max,
+		                            STROLL_HLL_SPARSE_MIN),
+		                 max);
+		sparse = realloc(hll->sparse, max * sizeof(sparse[0]));
+		if (!sparse)
+			return -errno;
+
+		hll->sparse = sparse;
+		hll->sparse_max = max;
+	}
+
+	memmove(&hll->sparse[pos + 1],
+	        &hll->sparse[pos],
+	        (hll->sparse_nr - pos) * sizeof(hll->sparse[0]));
+	hll->sparse[pos] = stroll_hll_sparse_entry(index, rank);
+	hll->sparse_nr++;
+
+	return 0;
+}
+
+int
+stroll_hll_insert(struct stroll_hll * __restrict hll, uint64_t key)
+{
+	stroll_hll_assert_sketch_api(hll);
+
+	unsigned int idx;
+	uint8_t      rank;
+
+	stroll_hll_split(stroll_hll_hash(key), hll->prec, &idx, &rank);
+
+	if (!hll->regs) {
+		int ret;
+
+		ret = stroll_hll_insert_sparse(hll, idx, rank);
+		if (ret <= 0)
+			return ret;
+
+		ret = stroll_hll_densify(hll);
+		if (ret)
+			return ret;
+	}
+
+	hll->regs[idx] = (uint8_t)stroll_max(hll->regs[idx], rank);
+
+	return 0;
+}
+
+/*
+ * Compute 2^-rank by building the IEEE 754 double precision representation
+ * directly, i.e. without requiring a division nor libm.
+ */
+static inline __const __nothrow __warn_result
+double
+stroll_hll_inv_pow2(uint8_t rank)
+{
+	union {
+		uint64_t word;
+		double   real;
+	} val = { .word = (uint64_t)(1023U - rank) << 52 };
+
+	return val.real;
+}
+
+/*
+ * Apply the original HyperLogLog estimator, falling back to linear counting
+ * for small cardinalities. Large range correction is not needed since hashes
+ * are 64-bit wide.
+ */
+uint64_t
+stroll_hll_count(const struct stroll_hll * __restrict hll)
+{
+	stroll_hll_assert_sketch_api(hll);
+
+	double       m = (double)(1U << hll->prec);
+	double       sum = 0.0;
+	unsigned int zeros = 0;
+	double       alpha;
+	double       est;
+	unsigned int r;
+
+	if (hll->regs) {
+		for (r = 0; r < (1U << hll->prec); r++) {
+			sum += stroll_hll_inv_pow2(hll->regs[r]);
+			zeros += !hll->regs[r];
+		}
+	}
+	else {
+		for (r = 0; r < hll->sparse_nr; r++)
+			sum += stroll_hll_inv_pow2(
+				stroll_hll_sparse_rank(hll->sparse[r]));
+		zeros = (1U << hll->prec) - hll->sparse_nr;
+		sum += (double)zeros;
+	}
+
+	switch (hll->prec) {
+	case 4:
+		alpha = 0.673;
+		break;
+	case 5:
+		alpha = 0.697;
+		break;
+	case 6:
+		alpha = 0.709;
+		break;
+	default:
+		alpha = 0.7213 / (1.0 + (1.079 / m));
+	}
+
+	est = alpha * m * m / sum;
+	if ((est <= (2.5 * m)) && zeros)
+		est = m * stroll_log(m / (double)zeros);
+
+	return (uint64_t)(est + 0.5);
+}
+
+void
+stroll_hll_merge_regs(uint8_t * __restrict       result,
+                      const uint8_t * __restrict regs,
+                      unsigned int               prec)
+{
+	stroll_hll_assert_api(result);
+	stroll_hll_assert_api(regs);
+	stroll_hll_assert_api(prec >= STROLL_HLL_PREC_MIN);
+	stroll_hll_assert_api(prec <= STROLL_HLL_PREC_MAX);
+
+	unsigned int r;
+
+	compile_assert(!((1U << STROLL_HLL_PREC_MIN) %
+	                 STROLL_HLL_MERGE_STRIDE));
+
+	for (r = 0; r < (1U << prec); r += STROLL_HLL_MERGE_STRIDE) {
+		unsigned int s;
+
+		for (s = 0; s < STROLL_HLL_MERGE_STRIDE; s++)
+			result[r + s] = (uint8_t)stroll_max(result[r + s],
+			                                    regs[r + s]);
+	}
+}
+
+/*
+ * Merge 2 sparse estimators which union is known to fit into the sparse
+ * layout.
+ */
+static __stroll_nonull(1, 2) __stroll_nothrow __warn_result
+int
+stroll_hll_merge_sparse(struct stroll_hll * __restrict       result,
+                        const struct stroll_hll * __restrict hll)
+{
+	unsigned int max = result->sparse_nr + hll->sparse_nr;
+	uint32_t *   sparse;
+	unsigned int a = 0;
+	unsigned int b = 0;
+	unsigned int nr = 0;
+
+	sparse = malloc(max * sizeof(sparse[0]));
+	if (!sparse)
+		return -errno;
+
+	while ((a < result->sparse_nr) && (b < hll->sparse_nr)) {
+		uint32_t ea = result->sparse[a];
+		uint32_t eb = hll->sparse[b];
+
+		if (stroll_hll_sparse_index(ea) < stroll_hll_sparse_index(eb)) {
+			sparse[nr++] = ea;
+			a++;
+		}
+		else if (stroll_hll_sparse_index(ea) >
+		         stroll_hll_sparse_index(eb)) {
+			sparse[nr++] = eb;
+			b++;
+		}
+		else {
+			/* Same index: rank ordering matches entry ordering. */
+			sparse[nr++] = stroll_max(ea, eb);
+			a++;
+			b++;
+		}
+	}
+	while (a < result->sparse_nr)
+		sparse[nr++] = result->sparse[a++];
+	while (b < hll->sparse_nr)
+		sparse[nr++] = hll->sparse[b++];
+
+	free(result->sparse);
+	result->sparse = sparse;
+	result->sparse_nr = nr;
+	result->sparse_max = max;
+
+	return 0;
+}
+
+int
+stroll_hll_merge(struct stroll_hll * __restrict       result,
+                 const struct stroll_hll * __restrict hll)
+{
+	stroll_hll_assert_compat_api(result, hll);
+
+	int err;
+
+	if (!hll->regs) {
+		if (!hll->sparse_nr)
+			return 0;
+
+		if (!result->regs &&
+		    ((result->sparse_nr + hll->sparse_nr) <=
+		     stroll_hll_sparse_max(result->prec)))
+			return stroll_hll_merge_sparse(result, hll);
+	}
+
+	err = stroll_hll_densify(result);
+	if (err)
+		return err;
+
+	if (hll->regs)
+		stroll_hll_merge_regs(result->regs, hll->regs, result->prec);
+	else
+		stroll_hll_apply_sparse(result->regs,
+		                        hll->sparse,
+		                        hll->sparse_nr);
+
+	return 0;
+}
+
+void
+stroll_hll_clear(struct stroll_hll * __restrict hll)
+{
+	stroll_hll_assert_sketch_api(hll);
+
+	if (hll->regs)
+		memset(hll->regs, 0, 1U << hll->prec);
+	else
+		hll->sparse_nr = 0;
+}
+
+void
+stroll_hll_init(struct stroll_hll * __restrict hll, unsigned int prec)
+{
+	stroll_hll_assert_api(hll);
+	stroll_hll_assert_api(prec >= STROLL_HLL_PREC_MIN);
+	stroll_hll_assert_api(prec <= STROLL_HLL_PREC_MAX);
+
+	hll->prec = prec;
+	hll->sparse_nr = 0;
+	hll->sparse_max = 0;
+	hll->sparse = NULL;
+	hll->regs = NULL;
+}
+
+void
+stroll_hll_fini(struct stroll_hll * __restrict hll)
+{
+	stroll_hll_assert_sketch_api(hll);
+
+	free(hll->sparse);
+	free(hll->regs);
+}
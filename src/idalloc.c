@@ -0,0 +1,446 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#include "stroll/idalloc.h"
+#include "stroll/bops.h"
+
+/*
+ * Bits of the underlying bitmap are only ever accessed using GCC atomic
+ * builtins. Allocation paths claim bits with acquire semantics and release
+ * paths clear them with release semantics so that accesses to objects
+ * identified by an identifier are properly ordered with respect to the
+ * identifier lifetime.
+ *
+ * Bits located beyond the last identifier of the last word are set at
+ * initialization time and never cleared so that they are never handed out.
+ */
+
+#define stroll_idalloc_assert_range_api(_alloc, _start_id, _id_count) \
+	stroll_idalloc_assert_alloc_api(_alloc); \
+	stroll_idalloc_assert_api(_id_count); \
+	stroll_idalloc_assert_api((_start_id) < (_alloc)->map.nr); \
+	stroll_idalloc_assert_api((_id_count) <= \
+	                          ((_alloc)->map.nr - (_start_id)))
+
+static __const __nothrow __warn_result
+unsigned long
+stroll_idalloc_high_mask(unsigned int id)
+{
+	return ~(0UL) << stroll_fbmap_word_bit_no(id);
+}
+
+static __const __nothrow __warn_result
+unsigned long
+stroll_idalloc_low_mask(unsigned int id)
+{
+	return ~(0UL) >> (__WORDSIZE - 1 - stroll_fbmap_word_bit_no(id));
+}
+
+static __nothrow __warn_result
+unsigned int
+stroll_idalloc_word_id(unsigned int word, unsigned long bit)
+{
+	return (word << STROLL_WORD_SHIFT) + stroll_bops_ffsul(bit) - 1;
+}
+
+/*
+ * Move the next-fit cursor. Skip the store when the cursor already points to
+ * the given word to prevent from needlessly bouncing the cache line it lives
+ * in between CPUs.
+ */
+static __nothrow
+void
+stroll_idalloc_move_cursor(struct stroll_idalloc * __restrict alloc,
+                           unsigned int                       word)
+{
+	if (__atomic_load_n(&alloc->next, __ATOMIC_RELAXED) != word)
+		__atomic_store_n(&alloc->next, word, __ATOMIC_RELAXED);
+}
+
+/*
+ * Atomically set all bits of mask into word unless at least one of them is
+ * already set.
+ */
+static __nothrow __warn_result
+bool
+stroll_idalloc_claim_word(unsigned long * word, unsigned long mask)
+{
+	unsigned long old = __atomic_load_n(word, __ATOMIC_RELAXED);
+
+	do {
+		if (old & mask)
+			return false;
+	} while (!__atomic_compare_exchange_n(word,
+	                                      &old,
+	                                      old | mask,
+	                                      true,
+	                                      __ATOMIC_ACQUIRE,
+	                                      __ATOMIC_RELAXED));
+
+	return true;
+}
+
+static __nothrow
+void
+stroll_idalloc_release_word(unsigned long * word, unsigned long mask)
+{
+	unsigned long old __unused;
+
+	old = __atomic_fetch_and(word, ~mask, __ATOMIC_RELEASE);
+	stroll_idalloc_assert_api((old & mask) == mask);
+}
+
+static __nothrow
+void
+stroll_idalloc_release_range(unsigned long * bits,
+                             unsigned int    start_id,
+                             unsigned int    id_count)
+{
+	unsigned int  stop_id = start_id + id_count - 1;
+	unsigned int  curr = stroll_fbmap_word_no(start_id);
+	unsigned int  last = stroll_fbmap_word_no(stop_id);
+	unsigned long mask = stroll_idalloc_high_mask(start_id);
+
+	while (curr < last) {
+		stroll_idalloc_release_word(&bits[curr++], mask);
+		mask = ~(0UL);
+	}
+
+	stroll_idalloc_release_word(&bits[curr],
+	                            mask & stroll_idalloc_low_mask(stop_id));
+}
+
+int
+stroll_idalloc_alloc(struct stroll_idalloc * __restrict alloc)
+{
+	stroll_idalloc_assert_alloc_api(alloc);
+
+	unsigned long * bits = alloc->map.bits;
+	unsigned int    nr = stroll_fbmap_word_nr(alloc->map.nr);
+	unsigned int    curr = __atomic_load_n(&alloc->next, __ATOMIC_RELAXED);
+	unsigned int    cnt;
+
+	for (cnt = 0; cnt < nr; cnt++) {
+		unsigned long word = __atomic_load_n(&bits[curr],
+		                                     __ATOMIC_RELAXED);
+
+		while (word != ~(0UL)) {
+			/* Isolate lowest cleared bit. */
+			unsigned long bit = ~word & (word + 1);
+
+			if (__atomic_compare_exchange_n(&bits[curr],
+			                                &word,
+			                                word | bit,
+			                                true,
+			                                __ATOMIC_ACQUIRE,
+			                                __ATOMIC_RELAXED)) {
+				stroll_idalloc_move_cursor(alloc, curr);
+
+				return (int)stroll_idalloc_word_id(curr, bit);
+			}
+		}
+
+		if (++curr == nr)
+			curr = 0;
+	}
+
+	return -ENOSPC;
+}
+
+void
+stroll_idalloc_free(struct stroll_idalloc * __restrict alloc, unsigned int id)
+{
+	stroll_idalloc_assert_alloc_api(alloc);
+	stroll_idalloc_assert_api(id < alloc->map.nr);
+
+	stroll_idalloc_release_word(&alloc->map.bits[stroll_fbmap_word_no(id)],
+	                            1UL << stroll_fbmap_word_bit_no(id));
+}
+
+int
+stroll_idalloc_reserve_range(struct stroll_idalloc * __restrict alloc,
+                             unsigned int                       start_id,
+                             unsigned int                       id_count)
+{
+	stroll_idalloc_assert_range_api(alloc, start_id, id_count);
+
+	unsigned long * bits = alloc->map.bits;
+	unsigned int    stop_id = start_id + id_count - 1;
+	unsigned int    first = stroll_fbmap_word_no(start_id);
+	unsigned int    last = stroll_fbmap_word_no(stop_id);
+	unsigned int    curr = first;
+	unsigned long   mask = stroll_idalloc_high_mask(start_id);
+
+	while (true) {
+		if (curr == last)
+			mask &= stroll_idalloc_low_mask(stop_id);
+
+		if (!stroll_idalloc_claim_word(&bits[curr], mask))
+			break;
+
+		if (curr == last)
+			return 0;
+
+		curr++;
+		mask = ~(0UL);
+	}
+
+	if (curr != first)
+		/* Roll back words claimed so far. */
+		stroll_idalloc_release_range(bits,
+		                             start_id,
+		                             (curr << STROLL_WORD_SHIFT) -
+		                             start_id);
+
+	return -EBUSY;
+}
+
+/*
+ * Return index of first identifier within [start_id, end_id[ which bit, once
+ * XOR'ed with invert, is set. Return end_id when none found.
+ */
+static __nothrow __warn_result
+unsigned int
+stroll_idalloc_scan(const unsigned long * bits,
+                    unsigned int          start_id,
+                    unsigned int          end_id,
+                    unsigned long         invert)
+{
+	unsigned int  curr = stroll_fbmap_word_no(start_id);
+	unsigned int  last = stroll_fbmap_word_no(end_id - 1);
+	unsigned long word;
+	unsigned int  id;
+
+	word = (__atomic_load_n(&bits[curr], __ATOMIC_RELAXED) ^ invert) &
+	       stroll_idalloc_high_mask(start_id);
+	while (!word) {
+		if (++curr > last)
+			return end_id;
+		word = __atomic_load_n(&bits[curr], __ATOMIC_RELAXED) ^ invert;
+	}
+
+	id = stroll_idalloc_word_id(curr, word);
+
+	return stroll_min(id, end_id);
+}
+
+/*
+ * Search for a run of id_count free identifiers starting within
+ * [start_id, end_id - id_count] and claim it.
+ */
+static __nothrow __warn_result
+int
+stroll_idalloc_alloc_range_from(struct stroll_idalloc * __restrict alloc,
+                                unsigned int                       start_id,
+                                unsigned int                       end_id,
+                                unsigned int                       id_count)
+{
+	const unsigned long * bits = alloc->map.bits;
+	unsigned int          id = start_id;
+
+	while ((end_id - id) >= id_count) {
+		unsigned int busy;
+
+		/* Skip allocated identifiers. */
+		id = stroll_idalloc_scan(bits, id, end_id, ~(0UL));
+		if ((end_id - id) < id_count)
+			break;
+
+		/* Look for an allocated identifier within candidate range. */
+		busy = stroll_idalloc_scan(bits, id, id + id_count, 0UL);
+		if (busy == (id + id_count)) {
+			if (!stroll_idalloc_reserve_range(alloc,
+			                                  id,
+			                                  id_count)) {
+				stroll_idalloc_move_cursor(
+					alloc,
+					stroll_fbmap_word_no(busy - 1));
+				return (int)id;
+			}
+
+			/*
+			 * Another thread claimed part of the candidate range in
+			 * the meantime: scan it again.
+			 */
+			continue;
+		}
+
+		id = busy + 1;
+	}
+
+	return -ENOSPC;
+}
+
+int
+stroll_idalloc_alloc_range(struct stroll_idalloc * __restrict alloc,
+                           unsigned int                       id_count)
+{
+	stroll_idalloc_assert_range_api(alloc, 0, id_count);
+
+	unsigned int nr = alloc->map.nr;
+	unsigned int start = __atomic_load_n(&alloc->next, __ATOMIC_RELAXED) <<
+	                     STROLL_WORD_SHIFT;
+	int          ret;
+
+	ret = stroll_idalloc_alloc_range_from(alloc, start, nr, id_count);
+	if ((ret == -ENOSPC) && start)
+		/* Wrap around, including ranges crossing the cursor. */
+		ret = stroll_idalloc_alloc_range_from(
+			alloc,
+			0,
+			stroll_min(start + id_count - 1, nr),
+			id_count);
+
+	return ret;
+}
+
+void
+stroll_idalloc_free_range(struct stroll_idalloc * __restrict alloc,
+                          unsigned int                       start_id,
+                          unsigned int                       id_count)
+{
+	stroll_idalloc_assert_range_api(alloc, start_id, id_count);
+
+	stroll_idalloc_release_range(alloc->map.bits, start_id, id_count);
+}
+
+int
+stroll_idalloc_init(struct stroll_idalloc * __restrict alloc,
+                    unsigned int                       id_nr)
+{
+	stroll_idalloc_assert_api(alloc);
+	stroll_idalloc_assert_api(id_nr);
+	stroll_idalloc_assert_api(id_nr <= (unsigned int)INT_MAX);
+
+	int err;
+
+	err = stroll_fbmap_init_clear(&alloc->map, id_nr);
+	if (err)
+		return err;
+
+	/* Make identifiers beyond the last one permanently busy. */
+	if (stroll_fbmap_word_bit_no(id_nr))
+		alloc->map.bits[stroll_fbmap_word_nr(id_nr) - 1] |=
+			stroll_idalloc_high_mask(id_nr);
+
+	alloc->next = 0;
+
+	return 0;
+}
+
+/*
+ * Refill cache with all free identifiers of the first word found with at least
+ * one free identifier, starting from the next-fit cursor.
+ */
+static __nothrow __warn_result
+int
+stroll_idalloc_refill_cache(struct stroll_idalloc * __restrict       alloc,
+                            struct stroll_idalloc_cache * __restrict cache)
+{
+	unsigned long * bits = alloc->map.bits;
+	unsigned int    nr = stroll_fbmap_word_nr(alloc->map.nr);
+	unsigned int    curr = __atomic_load_n(&alloc->next, __ATOMIC_RELAXED);
+	unsigned int    cnt;
+
+	for (cnt = 0; cnt < nr; cnt++) {
+		unsigned long word = __atomic_load_n(&bits[curr],
+		                                     __ATOMIC_RELAXED);
+
+		while (word != ~(0UL)) {
+			/* Grab all cleared bits at once. */
+			if (__atomic_compare_exchange_n(&bits[curr],
+			                                &word,
+			                                ~(0UL),
+			                                true,
+			                                __ATOMIC_ACQUIRE,
+			                                __ATOMIC_RELAXED)) {
+				cache->word = curr;
+				cache->ids = ~word;
+				stroll_idalloc_move_cursor(alloc,
+				                           (curr + 1) % nr);
+
+				return 0;
+			}
+		}
+
+		if (++curr == nr)
+			curr = 0;
+	}
+
+	return -ENOSPC;
+}
+
+int
+stroll_idalloc_alloc_cached(struct stroll_idalloc * __restrict       alloc,
+                            struct stroll_idalloc_cache * __restrict cache)
+{
+	stroll_idalloc_assert_alloc_api(alloc);
+	stroll_idalloc_assert_api(cache);
+
+	unsigned long bit;
+
+	if (!cache->ids) {
+		int err;
+
+		err = stroll_idalloc_refill_cache(alloc, cache);
+		if (err)
+			return err;
+	}
+
+	stroll_idalloc_assert_api(cache->ids);
+	stroll_idalloc_assert_api(cache->word <
+	                          stroll_fbmap_word_nr(alloc->map.nr));
+
+	/* Pop lowest cached identifier. */
+	bit = cache->ids & (~cache->ids + 1);
+	cache->ids &= ~bit;
+
+	return (int)stroll_idalloc_word_id(cache->word, bit);
+}
+
+void
+stroll_idalloc_free_cached(struct stroll_idalloc * __restrict       alloc,
+                           struct stroll_idalloc_cache * __restrict cache,
+                           unsigned int                             id)
+{
+	stroll_idalloc_assert_alloc_api(alloc);
+	stroll_idalloc_assert_api(cache);
+	stroll_idalloc_assert_api(id < alloc->map.nr);
+	stroll_idalloc_assert_api(stroll_idalloc_is_busy(alloc, id));
+
+	if (stroll_fbmap_word_no(id) == cache->word) {
+		unsigned long bit = 1UL << stroll_fbmap_word_bit_no(id);
+
+		/*
+		 * Give identifier back to the cache: its bit is left set into
+		 * the bitmap since the cache owns it.
+		 */
+		stroll_idalloc_assert_api(!(cache->ids & bit));
+		cache->ids |= bit;
+
+		return;
+	}
+
+	stroll_idalloc_free(alloc, id);
+}
+
+void
+stroll_idalloc_flush_cache(struct stroll_idalloc * __restrict       alloc,
+                           struct stroll_idalloc_cache * __restrict cache)
+{
+	stroll_idalloc_assert_alloc_api(alloc);
+	stroll_idalloc_assert_api(cache);
+
+	if (cache->ids) {
+		stroll_idalloc_assert_api(cache->word <
+		                          stroll_fbmap_word_nr(alloc->map.nr));
+		stroll_idalloc_release_word(&alloc->map.bits[cache->word],
+		                            cache->ids);
+	}
+
+	stroll_idalloc_init_cache(cache);
+}
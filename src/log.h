@@ -0,0 +1,85 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#ifndef _STROLL_INTERN_LOG_H
+#define _STROLL_INTERN_LOG_H
+
+#include "stroll/cdefs.h"
+#include <math.h>
+
+/*
+ * Compute natural logarithm of a strictly positive value.
+ *
+ * This prevents probabilistic structures from having to link against libm for
+ * sizing / estimation purposes only. Given x = 2^e * m where m belongs to
+ * [1, 2[, ln(x) = e * ln(2) + ln(m) and ln(m) = 2 * atanh((m - 1) / (m + 1))
+ * which Taylor series converges quickly since (m - 1) / (m + 1) < 1/3.
+ */
+static inline __const __nothrow __warn_result
+double
+stroll_log(double x)
+{
+	double       m = x;
+	int          e = 0;
+	double       t;
+	double       t2;
+	double       term;
+	double       sum = 0.0;
+	unsigned int n;
+
+	while (m >= 2.0) {
+		m /= 2.0;
+		e++;
+	}
+	while (m < 1.0) {
+		m *= 2.0;
+		e--;
+	}
+
+	t = (m - 1.0) / (m + 1.0);
+	t2 = t * t;
+	for (n = 1, term = t; n < 32; n += 2, term *= t2)
+		sum += term / (double)n;
+
+	return ((double)e * M_LN2) + (2.0 * sum);
+}
+
+/*
+ * Compute natural exponential of a value.
+ *
+ * Same rationale as stroll_log() above. Given x = e * ln(2) + r where e is
+ * integral and r belongs to [-ln(2) / 2, ln(2) / 2], exp(x) = 2^e * exp(r)
+ * where exp(r) Taylor series converges quickly since |r| < 0.35.
+ */
+static inline __const __nothrow __warn_result
+double
+stroll_exp(double x)
+{
+	int          e = (int)((x / M_LN2) + ((x < 0.0) ? -0.5 : 0.5));
+	double       r = x - ((double)e * M_LN2);
+	double       term = 1.0;
+	double       sum = 1.0;
+	unsigned int n;
+
+	for (n = 1; n < 24; n++) {
+		term *= r / (double)n;
+		sum += term;
+	}
+
+	while (e > 0) {
+		sum *= 2.0;
+		e--;
+	}
+	while (e < 0) {
+		sum /= 2.0;
+		e++;
+	}
+
+	return sum;
+}
+
+#endif /* _STROLL_INTERN_LOG_H */
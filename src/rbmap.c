@@ -0,0 +1,1826 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#include "stroll/rbmap.h"
+#include "stroll/fbmap.h"
+#include "stroll/bops.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(CONFIG_STROLL_ASSERT_INTERN)
+
+#include "stroll/assert.h"
+
+#define stroll_rbmap_assert_intern(_expr) \
+	stroll_assert("stroll:rbmap", _expr)
+
+#else  /* !defined(CONFIG_STROLL_ASSERT_INTERN) */
+
+#define stroll_rbmap_assert_intern(_expr)
+
+#endif /* defined(CONFIG_STROLL_ASSERT_INTERN) */
+
+/*
+ * Number of integers a container may hold, i.e. number of integers sharing the
+ * same 16 most significant bits.
+ */
+#define STROLL_RBMAP_CHUNK_BITS \
+	(1U << 16)
+
+/*
+ * Maximum number of integers an array container may hold. Beyond this, a
+ * bitmap container requires less memory.
+ */
+#define STROLL_RBMAP_ARRAY_MAX \
+	(4096U)
+
+#define STROLL_RBMAP_BITMAP_WORDS \
+	(STROLL_RBMAP_CHUNK_BITS / __WORDSIZE)
+
+#define STROLL_RBMAP_BITMAP_SIZE \
+	(STROLL_RBMAP_BITMAP_WORDS * sizeof(unsigned long))
+
+enum stroll_rbmap_type {
+	STROLL_RBMAP_ARRAY_TYPE,
+	STROLL_RBMAP_BITMAP_TYPE,
+	STROLL_RBMAP_RUN_TYPE
+};
+
+/* Run of len + 1 consecutive integers starting from start. */
+struct stroll_rbmap_run {
+	uint16_t start;
+	uint16_t len;
+};
+
+/*
+ * Container of integers sharing the same 16 most significant bits, i.e. key.
+ *
+ * Unless converted to a run container, a container holding no more than
+ * STROLL_RBMAP_ARRAY_MAX integers is always an array container and a bitmap
+ * container otherwise. Containers registered into a stroll_rbmap are never
+ * empty.
+ */
+struct stroll_rbmap_cont {
+	uint16_t                      key;
+	uint16_t                      type;
+	/* Number of integers held. */
+	uint32_t                      card;
+	/* Number of array entries / runs. */
+	uint32_t                      nr;
+	/* Number of array entries / runs allocated. */
+	uint32_t                      size;
+	union {
+		uint16_t *                array;
+		unsigned long *           bitmap;
+		struct stroll_rbmap_run * runs;
+	};
+};
+
+static inline __const __nothrow __warn_result
+uint16_t
+stroll_rbmap_key(uint32_t value)
+{
+	return (uint16_t)(value >> 16);
+}
+
+static inline __const __nothrow __warn_result
+uint16_t
+stroll_rbmap_low(uint32_t value)
+{
+	return (uint16_t)(value & 0xffffU);
+}
+
+static inline __pure __nothrow __warn_result
+unsigned int
+stroll_rbmap_run_end(const struct stroll_rbmap_run * __restrict run)
+{
+	return (unsigned int)run->start + run->len;
+}
+
+/******************************************************************************
+ * Container primitives
+ ******************************************************************************/
+
+/* Return index of first array entry greater than or equal to value. */
+static __pure __nothrow __warn_result
+unsigned int
+stroll_rbmap_array_search(const uint16_t * __restrict array,
+                          unsigned int                nr,
+                          uint16_t                    value)
+{
+	unsigned int lo = 0;
+	unsigned int hi = nr;
+
+	while (lo < hi) {
+		unsigned int mid = (lo + hi) / 2;
+
+		if (array[mid] < value)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+/* Return index of last run starting at or before value, nr when none. */
+static __pure __nothrow __warn_result
+unsigned int
+stroll_rbmap_run_search(const struct stroll_rbmap_run * __restrict runs,
+                        unsigned int                               nr,
+                        uint16_t                                   value)
+{
+	unsigned int lo = 0;
+	unsigned int hi = nr;
+
+	while (lo < hi) {
+		unsigned int mid = (lo + hi) / 2;
+
+		if (runs[mid].start <= value)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo ? lo - 1 : nr;
+}
+
+static __nothrow
+void
+stroll_rbmap_bitmap_fill(unsigned long * __restrict bitmap,
+                         unsigned int               start,
+                         unsigned int               count)
+{
+	unsigned int  stop = start + count - 1;
+	unsigned int  curr = stroll_fbmap_word_no(start);
+	unsigned int  last = stroll_fbmap_word_no(stop);
+	unsigned long mask = ~(0UL) << stroll_fbmap_word_bit_no(start);
+
+	while (curr < last) {
+		bitmap[curr++] |= mask;
+		mask = ~(0UL);
+	}
+
+	bitmap[curr] |= mask &
+	                (~(0UL) >> (__WORDSIZE - 1 -
+	                            stroll_fbmap_word_bit_no(stop)));
+}
+
+/* Extract card integers out of a bitmap into a newly allocated array. */
+static __nothrow __warn_result
+uint16_t *
+stroll_rbmap_bitmap_extract(const unsigned long * __restrict bitmap,
+                            unsigned int                     card)
+{
+	uint16_t *   array;
+	unsigned int w;
+	unsigned int n = 0;
+
+	array = malloc(card * sizeof(array[0]));
+	if (!array)
+		return NULL;
+
+	for (w = 0; w < STROLL_RBMAP_BITMAP_WORDS; w++) {
+		unsigned long word = bitmap[w];
+
+		while (word) {
+			array[n++] = (uint16_t)((w << STROLL_WORD_SHIFT) +
+			                        stroll_bops_ffsul(word) - 1);
+			word &= word - 1;
+		}
+	}
+
+	stroll_rbmap_assert_intern(n == card);
+
+	return array;
+}
+
+/* Make room for at least nr entries of elm_size bytes. */
+static __nothrow __warn_result
+int
+stroll_rbmap_cont_reserve(struct stroll_rbmap_cont * __restrict cont,
+                          unsigned int                          nr,
+                          size_t                                elm_size)
+{
+	unsigned int size;
+	void *       data;
+
+	if (nr <= cont->size)
+		return 0;
+
+	size = stroll_max(stroll_max(nr, 2 * cont->size), 4U);
+	data = realloc(cont->array, size * elm_size);
+	if (!data)
+		return -ENOMEM;
+
+	cont->array = data;
+	cont->size = size;
+
+	return 0;
+}
+
+static __nothrow
+void
+stroll_rbmap_cont_fini(struct stroll_rbmap_cont * __restrict cont)
+{
+	free(cont->array);
+}
+
+static __nothrow __warn_result
+int
+stroll_rbmap_array_to_bitmap(struct stroll_rbmap_cont * __restrict cont)
+{
+	stroll_rbmap_assert_intern(cont->type == STROLL_RBMAP_ARRAY_TYPE);
+
+	unsigned long * bitmap;
+	unsigned int    e;
+
+	bitmap = calloc(STROLL_RBMAP_BITMAP_WORDS, sizeof(bitmap[0]));
+	if (!bitmap)
+		return -ENOMEM;
+
+	for (e = 0; e < cont->nr; e++)
+		_stroll_fbmap_set(bitmap, cont->array[e]);
+
+	free(cont->array);
+	cont->type = STROLL_RBMAP_BITMAP_TYPE;
+	cont->nr = 0;
+	cont->size = 0;
+	cont->bitmap = bitmap;
+
+	return 0;
+}
+
+static __nothrow __warn_result
+int
+stroll_rbmap_bitmap_to_array(struct stroll_rbmap_cont * __restrict cont)
+{
+	stroll_rbmap_assert_intern(cont->type == STROLL_RBMAP_BITMAP_TYPE);
+	stroll_rbmap_assert_intern(cont->card <= STROLL_RBMAP_ARRAY_MAX);
+
+	uint16_t * array;
+
+	array = stroll_rbmap_bitmap_extract(cont->bitmap, cont->card);
+	if (!array)
+		return -ENOMEM;
+
+	free(cont->bitmap);
+	cont->type = STROLL_RBMAP_ARRAY_TYPE;
+	cont->nr = cont->card;
+	cont->size = cont->card;
+	cont->array = array;
+
+	return 0;
+}
+
+/* Convert a run container to an array or bitmap container. */
+static __nothrow __warn_result
+int
+stroll_rbmap_run_to_std(struct stroll_rbmap_cont * __restrict cont)
+{
+	stroll_rbmap_assert_intern(cont->type == STROLL_RBMAP_RUN_TYPE);
+
+	const struct stroll_rbmap_run * runs = cont->runs;
+	unsigned int                    r;
+
+	if (cont->card <= STROLL_RBMAP_ARRAY_MAX) {
+		uint16_t *   array;
+		unsigned int n = 0;
+
+		array = malloc(cont->card * sizeof(array[0]));
+		if (!array)
+			return -ENOMEM;
+
+		for (r = 0; r < cont->nr; r++) {
+			unsigned int v;
+
+			for (v = runs[r].start;
+			     v <= stroll_rbmap_run_end(&runs[r]);
+			     v++)
+				array[n++] = (uint16_t)v;
+		}
+
+		free(cont->runs);
+		cont->type = STROLL_RBMAP_ARRAY_TYPE;
+		cont->nr = cont->card;
+		cont->size = cont->card;
+		cont->array = array;
+	}
+	else {
+		unsigned long * bitmap;
+
+		bitmap = calloc(STROLL_RBMAP_BITMAP_WORDS, sizeof(bitmap[0]));
+		if (!bitmap)
+			return -ENOMEM;
+
+		for (r = 0; r < cont->nr; r++)
+			stroll_rbmap_bitmap_fill(bitmap,
+			                         runs[r].start,
+			                         (unsigned int)runs[r].len + 1);
+
+		free(cont->runs);
+		cont->type = STROLL_RBMAP_BITMAP_TYPE;
+		cont->nr = 0;
+		cont->size = 0;
+		cont->bitmap = bitmap;
+	}
+
+	return 0;
+}
+
+static __nothrow
+void
+stroll_rbmap_push_run(struct stroll_rbmap_run * __restrict runs,
+                      unsigned int * __restrict            nr,
+                      unsigned int                         value)
+{
+	if (*nr && (value == (stroll_rbmap_run_end(&runs[*nr - 1]) + 1)))
+		runs[*nr - 1].len++;
+	else
+		runs[(*nr)++] = (struct stroll_rbmap_run){
+			.start = (uint16_t)value,
+			.len   = 0
+		};
+}
+
+static __pure __nothrow __warn_result
+unsigned int
+stroll_rbmap_array_count_runs(const uint16_t * __restrict array,
+                              unsigned int                nr)
+{
+	unsigned int runs = !!nr;
+	unsigned int e;
+
+	for (e = 1; e < nr; e++)
+		runs += (array[e] != (array[e - 1] + 1));
+
+	return runs;
+}
+
+static __pure __nothrow __warn_result
+unsigned int
+stroll_rbmap_bitmap_count_runs(const unsigned long * __restrict bitmap)
+{
+	unsigned long carry = 0;
+	unsigned int  runs = 0;
+	unsigned int  w;
+
+	for (w = 0; w < STROLL_RBMAP_BITMAP_WORDS; w++) {
+		unsigned long word = bitmap[w];
+
+		/* Count bits set which preceding bit is cleared. */
+		runs += stroll_bops_hweightul(word & ~((word << 1) | carry));
+		carry = word >> (__WORDSIZE - 1);
+	}
+
+	return runs;
+}
+
+/* Convert an array or bitmap container to a run container. */
+static __nothrow __warn_result
+int
+stroll_rbmap_std_to_run(struct stroll_rbmap_cont * __restrict cont,
+                        unsigned int                          runs_nr)
+{
+	stroll_rbmap_assert_intern(cont->type != STROLL_RBMAP_RUN_TYPE);
+
+	struct stroll_rbmap_run * runs;
+	unsigned int              r = 0;
+
+	runs = malloc(runs_nr * sizeof(runs[0]));
+	if (!runs)
+		return -ENOMEM;
+
+	if (cont->type == STROLL_RBMAP_ARRAY_TYPE) {
+		unsigned int e;
+
+		for (e = 0; e < cont->nr; e++)
+			stroll_rbmap_push_run(runs, &r, cont->array[e]);
+	}
+	else {
+		unsigned int w;
+
+		for (w = 0; w < STROLL_RBMAP_BITMAP_WORDS; w++) {
+			unsigned long word = cont->bitmap[w];
+
+			while (word) {
+				stroll_rbmap_push_run(
+					runs,
+					&r,
+					(w << STROLL_WORD_SHIFT) +
+					stroll_bops_ffsul(word) - 1);
+				word &= word - 1;
+			}
+		}
+	}
+
+	stroll_rbmap_assert_intern(r == runs_nr);
+
+	free(cont->array);
+	cont->type = STROLL_RBMAP_RUN_TYPE;
+	cont->nr = runs_nr;
+	cont->size = runs_nr;
+	cont->runs = runs;
+
+	return 0;
+}
+
+static __pure __nothrow __warn_result
+bool
+stroll_rbmap_cont_contains(const struct stroll_rbmap_cont * __restrict cont,
+                           uint16_t                                    low)
+{
+	unsigned int idx;
+
+	switch (cont->type) {
+	case STROLL_RBMAP_ARRAY_TYPE:
+		idx = stroll_rbmap_array_search(cont->array, cont->nr, low);
+		return (idx < cont->nr) && (cont->array[idx] == low);
+
+	case STROLL_RBMAP_BITMAP_TYPE:
+		return _stroll_fbmap_test(cont->bitmap, low);
+
+	default:
+		stroll_rbmap_assert_intern(cont->type ==
+		                           STROLL_RBMAP_RUN_TYPE);
+		idx = stroll_rbmap_run_search(cont->runs, cont->nr, low);
+		return (idx < cont->nr) &&
+		       (low <= stroll_rbmap_run_end(&cont->runs[idx]));
+	}
+}
+
+static __nothrow __warn_result
+int
+stroll_rbmap_array_add(struct stroll_rbmap_cont * __restrict cont,
+                       uint16_t                              low)
+{
+	unsigned int idx;
+	int          err;
+
+	idx = stroll_rbmap_array_search(cont->array, cont->nr, low);
+	if ((idx < cont->nr) && (cont->array[idx] == low))
+		return 0;
+
+	if (cont->card == STROLL_RBMAP_ARRAY_MAX) {
+		err = stroll_rbmap_array_to_bitmap(cont);
+		if (err)
+			return err;
+
+		_stroll_fbmap_set(cont->bitmap, low);
+		cont->card++;
+
+		return 0;
+	}
+
+	err = stroll_rbmap_cont_reserve(cont,
+	                                cont->nr + 1,
+	                                sizeof(cont->array[0]));
+	if (err)
+		return err;
+
+	memmove(&cont->array[idx + 1],
+	        &cont->array[idx],
+	        (cont->nr - idx) * sizeof(cont->array[0]));
+	cont->array[idx] = low;
+	cont->nr++;
+	cont->card++;
+
+	return 0;
+}
+
+static __nothrow __warn_result
+int
+stroll_rbmap_run_add(struct stroll_rbmap_cont * __restrict cont,
+                     uint16_t                              low)
+{
+	struct stroll_rbmap_run * runs = cont->runs;
+	unsigned int              nr = cont->nr;
+	unsigned int              idx;
+	unsigned int              nxt;
+	bool                      prev;
+	bool                      next;
+
+	idx = stroll_rbmap_run_search(runs, nr, low);
+	if ((idx < nr) && (low <= stroll_rbmap_run_end(&runs[idx])))
+		return 0;
+
+	nxt = (idx < nr) ? idx + 1 : 0;
+	prev = (idx < nr) && (low == (stroll_rbmap_run_end(&runs[idx]) + 1));
+	next = (nxt < nr) && (((unsigned int)low + 1) == runs[nxt].start);
+
+	if (prev && next) {
+		/* Merge preceding and following runs. */
+		runs[idx].len = (uint16_t)(runs[idx].len + runs[nxt].len + 2);
+		memmove(&runs[nxt],
+		        &runs[nxt + 1],
+		        (nr - nxt - 1) * sizeof(runs[0]));
+		cont->nr--;
+	}
+	else if (prev)
+		runs[idx].len++;
+	else if (next) {
+		runs[nxt].start--;
+		runs[nxt].len++;
+	}
+	else {
+		int err;
+
+		err = stroll_rbmap_cont_reserve(cont, nr + 1, sizeof(runs[0]));
+		if (err)
+			return err;
+
+		runs = cont->runs;
+		memmove(&runs[nxt + 1],
+		        &runs[nxt],
+		        (nr - nxt) * sizeof(runs[0]));
+		runs[nxt].start = low;
+		runs[nxt].len = 0;
+		cont->nr++;
+	}
+
+	cont->card++;
+
+	return 0;
+}
+
+static __nothrow __warn_result
+int
+stroll_rbmap_cont_add(struct stroll_rbmap_cont * __restrict cont,
+                      uint16_t                              low)
+{
+	switch (cont->type) {
+	case STROLL_RBMAP_ARRAY_TYPE:
+		return stroll_rbmap_array_add(cont, low);
+
+	case STROLL_RBMAP_BITMAP_TYPE:
+		if (!_stroll_fbmap_test(cont->bitmap, low)) {
+			_stroll_fbmap_set(cont->bitmap, low);
+			cont->card++;
+		}
+		return 0;
+
+	default:
+		stroll_rbmap_assert_intern(cont->type ==
+		                           STROLL_RBMAP_RUN_TYPE);
+		return stroll_rbmap_run_add(cont, low);
+	}
+}
+
+static __nothrow
+void
+stroll_rbmap_array_remove(struct stroll_rbmap_cont * __restrict cont,
+                          uint16_t                              low)
+{
+	unsigned int idx;
+
+	idx = stroll_rbmap_array_search(cont->array, cont->nr, low);
+	if ((idx == cont->nr) || (cont->array[idx] != low))
+		return;
+
+	memmove(&cont->array[idx],
+	        &cont->array[idx + 1],
+	        (cont->nr - idx - 1) * sizeof(cont->array[0]));
+	cont->nr--;
+	cont->card--;
+}
+
+static __nothrow __warn_result
+int
+stroll_rbmap_bitmap_remove(struct stroll_rbmap_cont * __restrict cont,
+                           uint16_t                              low)
+{
+	if (!_stroll_fbmap_test(cont->bitmap, low))
+		return 0;
+
+	_stroll_fbmap_clear(cont->bitmap, low);
+	if (--cont->card == STROLL_RBMAP_ARRAY_MAX) {
+		int err;
+
+		err = stroll_rbmap_bitmap_to_array(cont);
+		if (err) {
+			/* Restore original state. */
+			_stroll_fbmap_set(cont->bitmap, low);
+			cont->card++;
+			return err;
+		}
+	}
+
+	return 0;
+}
+
+static __nothrow __warn_result
+int
+stroll_rbmap_run_remove(struct stroll_rbmap_cont * __restrict cont,
+                        uint16_t                              low)
+{
+	struct stroll_rbmap_run * runs = cont->runs;
+	unsigned int              nr = cont->nr;
+	unsigned int              idx;
+	unsigned int              start;
+	unsigned int              end;
+
+	idx = stroll_rbmap_run_search(runs, nr, low);
+	if (idx == nr)
+		return 0;
+
+	start = runs[idx].start;
+	end = stroll_rbmap_run_end(&runs[idx]);
+	if (low > end)
+		return 0;
+
+	if (start == end) {
+		memmove(&runs[idx],
+		        &runs[idx + 1],
+		        (nr - idx - 1) * sizeof(runs[0]));
+		cont->nr--;
+	}
+	else if (low == start) {
+		runs[idx].start++;
+		runs[idx].len--;
+	}
+	else if (low == end)
+		runs[idx].len--;
+	else {
+		/* Split run in 2. */
+		int err;
+
+		err = stroll_rbmap_cont_reserve(cont, nr + 1, sizeof(runs[0]));
+		if (err)
+			return err;
+
+		runs = cont->runs;
+		memmove(&runs[idx + 2],
+		        &runs[idx + 1],
+		        (nr - idx - 1) * sizeof(runs[0]));
+		runs[idx + 1].start = (uint16_t)(low + 1);
+		runs[idx + 1].len = (uint16_t)(end - low - 1);
+		runs[idx].len = (uint16_t)(low - start - 1);
+		cont->nr++;
+	}
+
+	cont->card--;
+
+	return 0;
+}
+
+static __nothrow __warn_result
+int
+stroll_rbmap_cont_remove(struct stroll_rbmap_cont * __restrict cont,
+                         uint16_t                              low)
+{
+	switch (cont->type) {
+	case STROLL_RBMAP_ARRAY_TYPE:
+		stroll_rbmap_array_remove(cont, low);
+		return 0;
+
+	case STROLL_RBMAP_BITMAP_TYPE:
+		return stroll_rbmap_bitmap_remove(cont, low);
+
+	default:
+		stroll_rbmap_assert_intern(cont->type ==
+		                           STROLL_RBMAP_RUN_TYPE);
+		return stroll_rbmap_run_remove(cont, low);
+	}
+}
+
+static __nothrow __warn_result
+int
+stroll_rbmap_cont_clone(struct stroll_rbmap_cont * __restrict       clone,
+                        const struct stroll_rbmap_cont * __restrict orig)
+{
+	size_t sz;
+
+	switch (orig->type) {
+	case STROLL_RBMAP_ARRAY_TYPE:
+		sz = orig->nr * sizeof(orig->array[0]);
+		break;
+
+	case STROLL_RBMAP_BITMAP_TYPE:
+		sz = STROLL_RBMAP_BITMAP_SIZE;
+		break;
+
+	default:
+		stroll_rbmap_assert_intern(orig->type ==
+		                           STROLL_RBMAP_RUN_TYPE);
+		sz = orig->nr * sizeof(orig->runs[0]);
+		break;
+	}
+
+	*clone = *orig;
+	clone->size = orig->nr;
+	clone->array = malloc(sz);
+	if (!clone->array)
+		return -ENOMEM;
+
+	memcpy(clone->array, orig->array, sz);
+
+	return 0;
+}
+
+/******************************************************************************
+ * Compressed bitmap primitives
+ ******************************************************************************/
+
+/* Return index of first container which key is greater than or equal to key. */
+static __pure __nothrow __warn_result
+unsigned int
+stroll_rbmap_search(const struct stroll_rbmap * __restrict rbmap, uint16_t key)
+{
+	unsigned int lo = 0;
+	unsigned int hi = rbmap->nr;
+
+	while (lo < hi) {
+		unsigned int mid = (lo + hi) / 2;
+
+		if (rbmap->conts[mid].key < key)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+static __nothrow __warn_result
+int
+stroll_rbmap_insert_cont(struct stroll_rbmap * __restrict rbmap,
+                         unsigned int                     idx,
+                         uint16_t                         key)
+{
+	if (rbmap->nr == rbmap->size) {
+		unsigned int               size = stroll_max(2 * rbmap->size,
+		                                             4U);
+		struct stroll_rbmap_cont * conts;
+
+		conts = realloc(rbmap->conts, size * sizeof(conts[0]));
+		if (!conts)
+			return -ENOMEM;
+
+		rbmap->conts = conts;
+		rbmap->size = size;
+	}
+
+	memmove(&rbmap->conts[idx + 1],
+	        &rbmap->conts[idx],
+	        (rbmap->nr - idx) * sizeof(rbmap->conts[0]));
+	rbmap->conts[idx] = (struct stroll_rbmap_cont){
+		.key   = key,
+		.type  = STROLL_RBMAP_ARRAY_TYPE,
+		.card  = 0,
+		.nr    = 0,
+		.size  = 0,
+		.array = NULL
+	};
+	rbmap->nr++;
+
+	return 0;
+}
+
+static __nothrow
+void
+stroll_rbmap_delete_cont(struct stroll_rbmap * __restrict rbmap,
+                         unsigned int                     idx)
+{
+	stroll_rbmap_cont_fini(&rbmap->conts[idx]);
+	memmove(&rbmap->conts[idx],
+	        &rbmap->conts[idx + 1],
+	        (rbmap->nr - idx - 1) * sizeof(rbmap->conts[0]));
+	rbmap->nr--;
+}
+
+uint64_t
+stroll_rbmap_cardinality(const struct stroll_rbmap * __restrict rbmap)
+{
+	stroll_rbmap_assert_map_api(rbmap);
+
+	uint64_t     card = 0;
+	unsigned int c;
+
+	for (c = 0; c < rbmap->nr; c++)
+		card += rbmap->conts[c].card;
+
+	return card;
+}
+
+bool
+stroll_rbmap_contains(const struct stroll_rbmap * __restrict rbmap,
+                      uint32_t                               value)
+{
+	stroll_rbmap_assert_map_api(rbmap);
+
+	uint16_t     key = stroll_rbmap_key(value);
+	unsigned int idx;
+
+	idx = stroll_rbmap_search(rbmap, key);
+	if ((idx == rbmap->nr) || (rbmap->conts[idx].key != key))
+		return false;
+
+	return stroll_rbmap_cont_contains(&rbmap->conts[idx],
+	                                  stroll_rbmap_low(value));
+}
+
+int
+stroll_rbmap_add(struct stroll_rbmap * __restrict rbmap, uint32_t value)
+{
+	stroll_rbmap_assert_map_api(rbmap);
+
+	uint16_t     key = stroll_rbmap_key(value);
+	unsigned int idx;
+	int          err;
+
+	idx = stroll_rbmap_search(rbmap, key);
+	if ((idx == rbmap->nr) || (rbmap->conts[idx].key != key)) {
+		err = stroll_rbmap_insert_cont(rbmap, idx, key);
+		if (err)
+			return err;
+	}
+
+	err = stroll_rbmap_cont_add(&rbmap->conts[idx],
+	                            stroll_rbmap_low(value));
+	if (err && !rbmap->conts[idx].card)
+		stroll_rbmap_delete_cont(rbmap, idx);
+
+	return err;
+}
+
+int
+stroll_rbmap_remove(struct stroll_rbmap * __restrict rbmap, uint32_t value)
+{
+	stroll_rbmap_assert_map_api(rbmap);
+
+	uint16_t     key = stroll_rbmap_key(value);
+	unsigned int idx;
+	int          err;
+
+	idx = stroll_rbmap_search(rbmap, key);
+	if ((idx == rbmap->nr) || (rbmap->conts[idx].key != key))
+		return 0;
+
+	err = stroll_rbmap_cont_remove(&rbmap->conts[idx],
+	                               stroll_rbmap_low(value));
+	if (err)
+		return err;
+
+	if (!rbmap->conts[idx].card)
+		stroll_rbmap_delete_cont(rbmap, idx);
+
+	return 0;
+}
+
+void
+stroll_rbmap_fini(struct stroll_rbmap * __restrict rbmap)
+{
+	stroll_rbmap_assert_map_api(rbmap);
+
+	unsigned int c;
+
+	for (c = 0; c < rbmap->nr; c++)
+		stroll_rbmap_cont_fini(&rbmap->conts[c]);
+
+	free(rbmap->conts);
+}
+
+/******************************************************************************
+ * Logical operations
+ ******************************************************************************/
+
+/*
+ * Logical operations are described by the set of integers they keep, i.e.
+ * integers held by first operand only, by second operand only and / or by
+ * both operands.
+ */
+#define STROLL_RBMAP_KEEP_FIRST  (1U << 0)
+#define STROLL_RBMAP_KEEP_SECOND (1U << 1)
+#define STROLL_RBMAP_KEEP_BOTH   (1U << 2)
+
+struct stroll_rbmap_op {
+	unsigned int keep;
+	void         (*bits)(unsigned long *       result,
+	                     const unsigned long * first,
+	                     const unsigned long * second,
+	                     unsigned int          nr);
+};
+
+static const struct stroll_rbmap_op stroll_rbmap_and_op = {
+	.keep = STROLL_RBMAP_KEEP_BOTH,
+	.bits = _stroll_fbmap_and
+};
+
+static const struct stroll_rbmap_op stroll_rbmap_or_op = {
+	.keep = STROLL_RBMAP_KEEP_FIRST |
+	        STROLL_RBMAP_KEEP_SECOND |
+	        STROLL_RBMAP_KEEP_BOTH,
+	.bits = _stroll_fbmap_or
+};
+
+static const struct stroll_rbmap_op stroll_rbmap_xor_op = {
+	.keep = STROLL_RBMAP_KEEP_FIRST | STROLL_RBMAP_KEEP_SECOND,
+	.bits = _stroll_fbmap_xor
+};
+
+static const struct stroll_rbmap_op stroll_rbmap_andnot_op = {
+	.keep = STROLL_RBMAP_KEEP_FIRST,
+	.bits = _stroll_fbmap_andnot
+};
+
+static __nothrow __warn_result
+unsigned int
+stroll_rbmap_merge_arrays(uint16_t * __restrict       result,
+                          const uint16_t * __restrict first,
+                          unsigned int                first_nr,
+                          const uint16_t * __restrict second,
+                          unsigned int                second_nr,
+                          unsigned int                keep)
+{
+	unsigned int f = 0;
+	unsigned int s = 0;
+	unsigned int n = 0;
+
+	while ((f < first_nr) && (s < second_nr)) {
+		if (first[f] < second[s]) {
+			if (keep & STROLL_RBMAP_KEEP_FIRST)
+				result[n++] = first[f];
+			f++;
+		}
+		else if (first[f] > second[s]) {
+			if (keep & STROLL_RBMAP_KEEP_SECOND)
+				result[n++] = second[s];
+			s++;
+		}
+		else {
+			if (keep & STROLL_RBMAP_KEEP_BOTH)
+				result[n++] = first[f];
+			f++;
+			s++;
+		}
+	}
+
+	if (keep & STROLL_RBMAP_KEEP_FIRST)
+		while (f < first_nr)
+			result[n++] = first[f++];
+
+	if (keep & STROLL_RBMAP_KEEP_SECOND)
+		while (s < second_nr)
+			result[n++] = second[s++];
+
+	return n;
+}
+
+/* Return container content as a bitmap, using scratch if required. */
+static __nothrow __warn_result
+const unsigned long *
+stroll_rbmap_cont_bits(const struct stroll_rbmap_cont * __restrict cont,
+                       unsigned long * __restrict                  scratch)
+{
+	unsigned int e;
+
+	switch (cont->type) {
+	case STROLL_RBMAP_ARRAY_TYPE:
+		memset(scratch, 0, STROLL_RBMAP_BITMAP_SIZE);
+		for (e = 0; e < cont->nr; e++)
+			_stroll_fbmap_set(scratch, cont->array[e]);
+		return scratch;
+
+	case STROLL_RBMAP_BITMAP_TYPE:
+		return cont->bitmap;
+
+	default:
+		stroll_rbmap_assert_intern(cont->type ==
+		                           STROLL_RBMAP_RUN_TYPE);
+		memset(scratch, 0, STROLL_RBMAP_BITMAP_SIZE);
+		for (e = 0; e < cont->nr; e++)
+			stroll_rbmap_bitmap_fill(
+				scratch,
+				cont->runs[e].start,
+				(unsigned int)cont->runs[e].len + 1);
+		return scratch;
+	}
+}
+
+/*
+ * Apply logical operation between 2 containers sharing the same key.
+ *
+ * Sparse array containers are merged directly. Otherwise, operands are
+ * expanded as bitmaps so that operation may be performed thanks to the
+ * (vectorized) stroll_fbmap word kernels.
+ */
+static __nothrow __warn_result
+int
+stroll_rbmap_cont_op(struct stroll_rbmap_cont * __restrict       result,
+                     const struct stroll_rbmap_cont * __restrict first,
+                     const struct stroll_rbmap_cont * __restrict second,
+                     const struct stroll_rbmap_op * __restrict   op,
+                     unsigned long ** __restrict                 scratch)
+{
+	const unsigned long * fbits;
+	const unsigned long * sbits;
+	unsigned long *       rbits;
+	unsigned int          card;
+
+	*result = (struct stroll_rbmap_cont){
+		.key   = first->key,
+		.type  = STROLL_RBMAP_ARRAY_TYPE,
+		.card  = 0,
+		.nr    = 0,
+		.size  = 0,
+		.array = NULL
+	};
+
+	if ((first->type == STROLL_RBMAP_ARRAY_TYPE) &&
+	    (second->type == STROLL_RBMAP_ARRAY_TYPE)) {
+		uint16_t * array;
+
+		array = malloc((first->nr + second->nr) * sizeof(array[0]));
+		if (!array)
+			return -ENOMEM;
+
+		card = stroll_rbmap_merge_arrays(array,
+		                                 first->array,
+		                                 first->nr,
+		                                 second->array,
+		                                 second->nr,
+		                                 op->keep);
+		if (!card) {
+			free(array);
+			return 0;
+		}
+
+		result->card = card;
+		result->nr = card;
+		result->size = first->nr + second->nr;
+		result->array = array;
+		if (card > STROLL_RBMAP_ARRAY_MAX) {
+			int err;
+
+			err = stroll_rbmap_array_to_bitmap(result);
+			if (err) {
+				free(array);
+				return err;
+			}
+		}
+
+		return 0;
+	}
+
+	if (!*scratch) {
+		*scratch = malloc(3 * STROLL_RBMAP_BITMAP_SIZE);
+		if (!*scratch)
+			return -ENOMEM;
+	}
+
+	fbits = stroll_rbmap_cont_bits(first, *scratch);
+	sbits = stroll_rbmap_cont_bits(second,
+	                               &(*scratch)[STROLL_RBMAP_BITMAP_WORDS]);
+	rbits = &(*scratch)[2 * STROLL_RBMAP_BITMAP_WORDS];
+
+	op->bits(rbits, fbits, sbits, STROLL_RBMAP_CHUNK_BITS);
+	card = _stroll_fbmap_hweight(rbits, STROLL_RBMAP_CHUNK_BITS);
+	if (!card)
+		return 0;
+
+	if (card <= STROLL_RBMAP_ARRAY_MAX) {
+		result->array = stroll_rbmap_bitmap_extract(rbits, card);
+		if (!result->array)
+			return -ENOMEM;
+		result->nr = card;
+		result->size = card;
+	}
+	else {
+		result->bitmap = malloc(STROLL_RBMAP_BITMAP_SIZE);
+		if (!result->bitmap)
+			return -ENOMEM;
+		memcpy(result->bitmap, rbits, STROLL_RBMAP_BITMAP_SIZE);
+		result->type = STROLL_RBMAP_BITMAP_TYPE;
+	}
+
+	result->card = card;
+
+	return 0;
+}
+
+static __nothrow __warn_result
+int
+stroll_rbmap_op(struct stroll_rbmap *                   result,
+                const struct stroll_rbmap *             first,
+                const struct stroll_rbmap *             second,
+                const struct stroll_rbmap_op * __restrict op)
+{
+	stroll_rbmap_assert_map_api(result);
+	stroll_rbmap_assert_map_api(first);
+	stroll_rbmap_assert_map_api(second);
+
+	unsigned int               size = first->nr + second->nr;
+	struct stroll_rbmap_cont * conts = NULL;
+	unsigned int               nr = 0;
+	unsigned int               f = 0;
+	unsigned int               s = 0;
+	unsigned long *            scratch = NULL;
+	int                        err = 0;
+
+	if (size) {
+		conts = malloc(size * sizeof(conts[0]));
+		if (!conts)
+			return -ENOMEM;
+	}
+
+	while ((f < first->nr) || (s < second->nr)) {
+		const struct stroll_rbmap_cont * fcont;
+		const struct stroll_rbmap_cont * scont;
+
+		fcont = (f < first->nr) ? &first->conts[f] : NULL;
+		scont = (s < second->nr) ? &second->conts[s] : NULL;
+
+		if (!scont || (fcont && (fcont->key < scont->key))) {
+			f++;
+			if (!(op->keep & STROLL_RBMAP_KEEP_FIRST))
+				continue;
+			err = stroll_rbmap_cont_clone(&conts[nr], fcont);
+		}
+		else if (!fcont || (fcont->key > scont->key)) {
+			s++;
+			if (!(op->keep & STROLL_RBMAP_KEEP_SECOND))
+				continue;
+			err = stroll_rbmap_cont_clone(&conts[nr], scont);
+		}
+		else {
+			f++;
+			s++;
+			err = stroll_rbmap_cont_op(&conts[nr],
+			                           fcont,
+			                           scont,
+			                           op,
+			                           &scratch);
+		}
+
+		if (err)
+			goto free;
+
+		if (conts[nr].card)
+			nr++;
+	}
+
+	free(scratch);
+
+	/* Operands may alias result: release its content last. */
+	stroll_rbmap_fini(result);
+	result->nr = nr;
+	result->size = size;
+	result->conts = conts;
+
+	return 0;
+
+free:
+	free(scratch);
+	while (nr--)
+		stroll_rbmap_cont_fini(&conts[nr]);
+	free(conts);
+
+	return err;
+}
+
+int
+stroll_rbmap_and(struct stroll_rbmap *       result,
+                 const struct stroll_rbmap * first,
+                 const struct stroll_rbmap * second)
+{
+	return stroll_rbmap_op(result, first, second, &stroll_rbmap_and_op);
+}
+
+int
+stroll_rbmap_or(struct stroll_rbmap *       result,
+                const struct stroll_rbmap * first,
+                const struct stroll_rbmap * second)
+{
+	return stroll_rbmap_op(result, first, second, &stroll_rbmap_or_op);
+}
+
+int
+stroll_rbmap_xor(struct stroll_rbmap *       result,
+                 const struct stroll_rbmap * first,
+                 const struct stroll_rbmap * second)
+{
+	return stroll_rbmap_op(result, first, second, &stroll_rbmap_xor_op);
+}
+
+int
+stroll_rbmap_andnot(struct stroll_rbmap *       result,
+                    const struct stroll_rbmap * first,
+                    const struct stroll_rbmap * second)
+{
+	return stroll_rbmap_op(result, first, second, &stroll_rbmap_andnot_op);
+}
+
+/******************************************************************************
+ * Run optimization
+ ******************************************************************************/
+
+/* Size of container serialized form, also a good proxy of memory usage. */
+static __pure __nothrow __warn_result
+size_t
+stroll_rbmap_cont_serialized_size(
+	const struct stroll_rbmap_cont * __restrict cont)
+{
+	switch (cont->type) {
+	case STROLL_RBMAP_ARRAY_TYPE:
+		return cont->card * sizeof(uint16_t);
+
+	case STROLL_RBMAP_BITMAP_TYPE:
+		return STROLL_RBMAP_CHUNK_BITS / 8;
+
+	default:
+		stroll_rbmap_assert_intern(cont->type ==
+		                           STROLL_RBMAP_RUN_TYPE);
+		return sizeof(uint16_t) + (cont->nr * 2 * sizeof(uint16_t));
+	}
+}
+
+static __nothrow __warn_result
+int
+stroll_rbmap_cont_optimize(struct stroll_rbmap_cont * __restrict cont)
+{
+	size_t       std;
+	unsigned int runs;
+
+	std = (cont->card <= STROLL_RBMAP_ARRAY_MAX)
+	      ? cont->card * sizeof(uint16_t)
+	      : STROLL_RBMAP_CHUNK_BITS / 8;
+
+	switch (cont->type) {
+	case STROLL_RBMAP_ARRAY_TYPE:
+		runs = stroll_rbmap_array_count_runs(cont->array, cont->nr);
+		break;
+
+	case STROLL_RBMAP_BITMAP_TYPE:
+		runs = stroll_rbmap_bitmap_count_runs(cont->bitmap);
+		break;
+
+	default:
+		stroll_rbmap_assert_intern(cont->type ==
+		                           STROLL_RBMAP_RUN_TYPE);
+		if ((sizeof(uint16_t) + (cont->nr * 2 * sizeof(uint16_t))) >=
+		    std)
+			return stroll_rbmap_run_to_std(cont);
+		return 0;
+	}
+
+	if ((sizeof(uint16_t) + (runs * 2 * sizeof(uint16_t))) < std)
+		return stroll_rbmap_std_to_run(cont, runs);
+
+	return 0;
+}
+
+int
+stroll_rbmap_optimize(struct stroll_rbmap * __restrict rbmap)
+{
+	stroll_rbmap_assert_map_api(rbmap);
+
+	unsigned int c;
+
+	for (c = 0; c < rbmap->nr; c++) {
+		int err;
+
+		err = stroll_rbmap_cont_optimize(&rbmap->conts[c]);
+		if (err)
+			return err;
+	}
+
+	return 0;
+}
+
+/******************************************************************************
+ * Iteration
+ ******************************************************************************/
+
+static __nothrow
+void
+stroll_rbmap_load_iter(struct stroll_rbmap_iter * __restrict iter)
+{
+	const struct stroll_rbmap_cont * cont = &iter->rbmap->conts[iter->cont];
+
+	iter->index = 0;
+	if (cont->type == STROLL_RBMAP_BITMAP_TYPE)
+		iter->word = cont->bitmap[0];
+	else if (cont->type == STROLL_RBMAP_RUN_TYPE)
+		iter->value = cont->runs[0].start;
+}
+
+int64_t
+stroll_rbmap_step_iter(struct stroll_rbmap_iter * __restrict iter)
+{
+	stroll_rbmap_assert_api(iter);
+	stroll_rbmap_assert_map_api(iter->rbmap);
+
+	const struct stroll_rbmap * rbmap = iter->rbmap;
+
+	while (iter->cont < rbmap->nr) {
+		const struct stroll_rbmap_cont * cont;
+		uint32_t                         base;
+
+		cont = &rbmap->conts[iter->cont];
+		base = (uint32_t)cont->key << 16;
+		switch (cont->type) {
+		case STROLL_RBMAP_ARRAY_TYPE:
+			if (iter->index < cont->nr)
+				return base | cont->array[iter->index++];
+			break;
+
+		case STROLL_RBMAP_BITMAP_TYPE:
+			while (true) {
+				if (iter->word) {
+					unsigned int bit;
+
+					bit = stroll_bops_ffsul(iter->word) - 1;
+					iter->word &= iter->word - 1;
+
+					return base |
+					       ((iter->index <<
+					         STROLL_WORD_SHIFT) + bit);
+				}
+
+				if (++iter->index == STROLL_RBMAP_BITMAP_WORDS)
+					break;
+				iter->word = cont->bitmap[iter->index];
+			}
+			break;
+
+		default:
+			stroll_rbmap_assert_intern(cont->type ==
+			                           STROLL_RBMAP_RUN_TYPE);
+			if (iter->index < cont->nr) {
+				const struct stroll_rbmap_run * run =
+					&cont->runs[iter->index];
+				unsigned int                    value =
+					iter->value;
+
+				if (value == stroll_rbmap_run_end(run)) {
+					if (++iter->index < cont->nr)
+						iter->value =
+							run[1].start;
+				}
+				else
+					iter->value++;
+
+				return base | value;
+			}
+			break;
+		}
+
+		if (++iter->cont < rbmap->nr)
+			stroll_rbmap_load_iter(iter);
+	}
+
+	return -ENOENT;
+}
+
+int64_t
+stroll_rbmap_init_iter(struct stroll_rbmap_iter * __restrict  iter,
+                       const struct stroll_rbmap * __restrict rbmap)
+{
+	stroll_rbmap_assert_api(iter);
+	stroll_rbmap_assert_map_api(rbmap);
+
+	iter->rbmap = rbmap;
+	iter->cont = 0;
+	if (rbmap->nr)
+		stroll_rbmap_load_iter(iter);
+
+	return stroll_rbmap_step_iter(iter);
+}
+
+/******************************************************************************
+ * Serialization
+ *
+ * Implements the portable Roaring bitmap serialization format, i.e.:
+ * - a cookie: either a 32-bit STROLL_RBMAP_NORUN_COOKIE followed by a 32-bit
+ *   number of containers when there are no run containers, or a 16-bit
+ *   STROLL_RBMAP_RUN_COOKIE followed by a 16-bit number of containers minus 1
+ *   and a bitset telling which containers are run containers,
+ * - a descriptive header made of a 16-bit key and a 16-bit cardinality minus 1
+ *   for each container,
+ * - an offset header made of the 32-bit byte offset of each container,
+ *   omitted when there are run containers and less than
+ *   STROLL_RBMAP_NO_OFFSET_THRESHOLD containers,
+ * - containers content: sorted 16-bit values for array containers, 1024
+ *   64-bit words for bitmap containers and a 16-bit number of runs followed by
+ *   16-bit start / length minus 1 pairs for run containers.
+ *
+ * All fields are stored in little-endian byte order.
+ ******************************************************************************/
+
+#define STROLL_RBMAP_NORUN_COOKIE        (12346U)
+#define STROLL_RBMAP_RUN_COOKIE          (12347U)
+#define STROLL_RBMAP_NO_OFFSET_THRESHOLD (4U)
+
+static __pure __nothrow __warn_result
+bool
+stroll_rbmap_has_runs(const struct stroll_rbmap * __restrict rbmap)
+{
+	unsigned int c;
+
+	for (c = 0; c < rbmap->nr; c++)
+		if (rbmap->conts[c].type == STROLL_RBMAP_RUN_TYPE)
+			return true;
+
+	return false;
+}
+
+static __const __nothrow __warn_result
+bool
+stroll_rbmap_has_offsets(unsigned int nr, bool runs)
+{
+	return !runs || (nr >= STROLL_RBMAP_NO_OFFSET_THRESHOLD);
+}
+
+static __const __nothrow __warn_result
+size_t
+stroll_rbmap_header_size(unsigned int nr, bool runs)
+{
+	size_t sz;
+
+	if (runs)
+		sz = sizeof(uint32_t) + ((nr + 7) / 8);
+	else
+		sz = 2 * sizeof(uint32_t);
+
+	sz += nr * 2 * sizeof(uint16_t);
+	if (stroll_rbmap_has_offsets(nr, runs))
+		sz += nr * sizeof(uint32_t);
+
+	return sz;
+}
+
+static __nothrow
+uint8_t *
+stroll_rbmap_put16(uint8_t * __restrict data, unsigned int value)
+{
+	data[0] = (uint8_t)value;
+	data[1] = (uint8_t)(value >> 8);
+
+	return &data[2];
+}
+
+static __nothrow
+uint8_t *
+stroll_rbmap_put32(uint8_t * __restrict data, uint32_t value)
+{
+	data[0] = (uint8_t)value;
+	data[1] = (uint8_t)(value >> 8);
+	data[2] = (uint8_t)(value >> 16);
+	data[3] = (uint8_t)(value >> 24);
+
+	return &data[4];
+}
+
+static __pure __nothrow __warn_result
+unsigned int
+stroll_rbmap_get16(const uint8_t * __restrict data)
+{
+	return (unsigned int)data[0] | ((unsigned int)data[1] << 8);
+}
+
+static __pure __nothrow __warn_result
+uint32_t
+stroll_rbmap_get32(const uint8_t * __restrict data)
+{
+	return (uint32_t)data[0] |
+	       ((uint32_t)data[1] << 8) |
+	       ((uint32_t)data[2] << 16) |
+	       ((uint32_t)data[3] << 24);
+}
+
+size_t
+stroll_rbmap_serialized_size(const struct stroll_rbmap * __restrict rbmap)
+{
+	stroll_rbmap_assert_map_api(rbmap);
+
+	size_t       sz;
+	unsigned int c;
+
+	sz = stroll_rbmap_header_size(rbmap->nr, stroll_rbmap_has_runs(rbmap));
+	for (c = 0; c < rbmap->nr; c++)
+		sz += stroll_rbmap_cont_serialized_size(&rbmap->conts[c]);
+
+	return sz;
+}
+
+static __nothrow
+uint8_t *
+stroll_rbmap_serialize_cont(const struct stroll_rbmap_cont * __restrict cont,
+                            uint8_t * __restrict                        data)
+{
+	unsigned int e;
+
+	switch (cont->type) {
+	case STROLL_RBMAP_ARRAY_TYPE:
+		for (e = 0; e < cont->nr; e++)
+			data = stroll_rbmap_put16(data, cont->array[e]);
+		break;
+
+	case STROLL_RBMAP_BITMAP_TYPE:
+		/*
+		 * Byte n of a little-endian array of 64-bit words holds bits
+		 * [8 * n, 8 * n + 7] whatever the machine word size.
+		 */
+		for (e = 0; e < (STROLL_RBMAP_CHUNK_BITS / 8); e++)
+			*data++ = (uint8_t)
+			          (cont->bitmap[e / sizeof(unsigned long)] >>
+			           (8 * (e % sizeof(unsigned long))));
+		break;
+
+	default:
+		stroll_rbmap_assert_intern(cont->type ==
+		                           STROLL_RBMAP_RUN_TYPE);
+		data = stroll_rbmap_put16(data, cont->nr);
+		for (e = 0; e < cont->nr; e++) {
+			data = stroll_rbmap_put16(data, cont->runs[e].start);
+			data = stroll_rbmap_put16(data, cont->runs[e].len);
+		}
+		break;
+	}
+
+	return data;
+}
+
+ssize_t
+stroll_rbmap_serialize(const struct stroll_rbmap * __restrict rbmap,
+                       void * __restrict                      buffer,
+                       size_t                                 size)
+{
+	stroll_rbmap_assert_map_api(rbmap);
+	stroll_rbmap_assert_api(buffer);
+
+	unsigned int nr = rbmap->nr;
+	bool         runs = stroll_rbmap_has_runs(rbmap);
+	size_t       sz = stroll_rbmap_serialized_size(rbmap);
+	uint8_t *    data = buffer;
+	unsigned int c;
+
+	if (size < sz)
+		return -ENOSPC;
+
+	if (runs) {
+		data = stroll_rbmap_put16(data, STROLL_RBMAP_RUN_COOKIE);
+		data = stroll_rbmap_put16(data, nr - 1);
+		memset(data, 0, (nr + 7) / 8);
+		for (c = 0; c < nr; c++)
+			if (rbmap->conts[c].type == STROLL_RBMAP_RUN_TYPE)
+				data[c / 8] |= (uint8_t)(1U << (c % 8));
+		data += (nr + 7) / 8;
+	}
+	else {
+		data = stroll_rbmap_put32(data, STROLL_RBMAP_NORUN_COOKIE);
+		data = stroll_rbmap_put32(data, nr);
+	}
+
+	for (c = 0; c < nr; c++) {
+		data = stroll_rbmap_put16(data, rbmap->conts[c].key);
+		data = stroll_rbmap_put16(data, rbmap->conts[c].card - 1);
+	}
+
+	if (stroll_rbmap_has_offsets(nr, runs)) {
+		size_t off = stroll_rbmap_header_size(nr, runs);
+
+		for (c = 0; c < nr; c++) {
+			data = stroll_rbmap_put32(data, (uint32_t)off);
+			off += stroll_rbmap_cont_serialized_size(
+				&rbmap->conts[c]);
+		}
+	}
+
+	for (c = 0; c < nr; c++)
+		data = stroll_rbmap_serialize_cont(&rbmap->conts[c], data);
+
+	stroll_rbmap_assert_intern((size_t)(data - (uint8_t *)buffer) == sz);
+
+	return (ssize_t)sz;
+}
+
+static __nothrow __warn_result
+int
+stroll_rbmap_deserialize_array(struct stroll_rbmap_cont * __restrict cont,
+                               const uint8_t ** __restrict           data,
+                               const uint8_t * __restrict            end)
+{
+	const uint8_t * src = *data;
+	unsigned int    e;
+
+	if ((size_t)(end - src) < (cont->card * sizeof(uint16_t)))
+		return -EINVAL;
+
+	cont->array = malloc(cont->card * sizeof(cont->array[0]));
+	if (!cont->array)
+		return -ENOMEM;
+
+	for (e = 0; e < cont->card; e++, src += sizeof(uint16_t)) {
+		cont->array[e] = (uint16_t)stroll_rbmap_get16(src);
+		if (e && (cont->array[e] <= cont->array[e - 1]))
+			return -EINVAL;
+	}
+
+	cont->type = STROLL_RBMAP_ARRAY_TYPE;
+	cont->nr = cont->card;
+	cont->size = cont->card;
+	*data = src;
+
+	return 0;
+}
+
+static __nothrow __warn_result
+int
+stroll_rbmap_deserialize_bitmap(struct stroll_rbmap_cont * __restrict cont,
+                                const uint8_t ** __restrict           data,
+                                const uint8_t * __restrict            end)
+{
+	const uint8_t * src = *data;
+	unsigned int    e;
+
+	if ((size_t)(end - src) < (STROLL_RBMAP_CHUNK_BITS / 8))
+		return -EINVAL;
+
+	cont->bitmap = calloc(STROLL_RBMAP_BITMAP_WORDS,
+	                      sizeof(cont->bitmap[0]));
+	if (!cont->bitmap)
+		return -ENOMEM;
+
+	for (e = 0; e < (STROLL_RBMAP_CHUNK_BITS / 8); e++)
+		cont->bitmap[e / sizeof(unsigned long)] |=
+			(unsigned long)src[e] <<
+			(8 * (e % sizeof(unsigned long)));
+
+	cont->type = STROLL_RBMAP_BITMAP_TYPE;
+	if (_stroll_fbmap_hweight(cont->bitmap, STROLL_RBMAP_CHUNK_BITS) !=
+	    cont->card)
+		return -EINVAL;
+
+	*data = &src[STROLL_RBMAP_CHUNK_BITS / 8];
+
+	return 0;
+}
+
+static __nothrow __warn_result
+int
+stroll_rbmap_deserialize_runs(struct stroll_rbmap_cont * __restrict cont,
+                              const uint8_t ** __restrict           data,
+                              const uint8_t * __restrict            end)
+{
+	const uint8_t * src = *data;
+	unsigned int    nr;
+	unsigned int    r;
+	unsigned int    card = 0;
+
+	if ((size_t)(end - src) < sizeof(uint16_t))
+		return -EINVAL;
+
+	nr = stroll_rbmap_get16(src);
+	src += sizeof(uint16_t);
+	if (!nr || ((size_t)(end - src) < (nr * 2 * sizeof(uint16_t))))
+		return -EINVAL;
+
+	cont->runs = malloc(nr * sizeof(cont->runs[0]));
+	if (!cont->runs)
+		return -ENOMEM;
+	cont->type = STROLL_RBMAP_RUN_TYPE;
+	cont->size = nr;
+	cont->nr = 0;
+
+	for (r = 0; r < nr; r++, src += 2 * sizeof(uint16_t)) {
+		unsigned int start = stroll_rbmap_get16(src);
+		unsigned int len = stroll_rbmap_get16(&src[sizeof(uint16_t)]);
+
+		if ((start + len) > 0xffffU)
+			return -EINVAL;
+
+		if (cont->nr) {
+			struct stroll_rbmap_run * last;
+
+			last = &cont->runs[cont->nr - 1];
+			if (start <= stroll_rbmap_run_end(last))
+				/* Unsorted or overlapping runs. */
+				return -EINVAL;
+
+			if (start == (stroll_rbmap_run_end(last) + 1)) {
+				/* Coalesce adjacent runs. */
+				last->len = (uint16_t)(last->len + len + 1);
+				card += len + 1;
+				continue;
+			}
+		}
+
+		cont->runs[cont->nr].start = (uint16_t)start;
+		cont->runs[cont->nr].len = (uint16_t)len;
+		cont->nr++;
+		card += len + 1;
+	}
+
+	if (card != cont->card)
+		return -EINVAL;
+
+	*data = src;
+
+	return 0;
+}
+
+int
+stroll_rbmap_init_deserialize(struct stroll_rbmap * __restrict rbmap,
+                              const void * __restrict          buffer,
+                              size_t                           size)
+{
+	stroll_rbmap_assert_api(rbmap);
+	stroll_rbmap_assert_api(buffer);
+
+	const uint8_t * data = buffer;
+	const uint8_t * end = &data[size];
+	const uint8_t * runs = NULL;
+	const uint8_t * desc;
+	uint32_t        cookie;
+	unsigned int    nr;
+	unsigned int    c;
+	int             err = -EINVAL;
+
+	stroll_rbmap_init(rbmap);
+
+	if (size < sizeof(uint32_t))
+		return -EINVAL;
+
+	cookie = stroll_rbmap_get32(data);
+	if ((cookie & 0xffffU) == STROLL_RBMAP_RUN_COOKIE) {
+		nr = (cookie >> 16) + 1;
+		data += sizeof(uint32_t);
+		if ((size_t)(end - data) < ((nr + 7) / 8))
+			return -EINVAL;
+		runs = data;
+		data += (nr + 7) / 8;
+	}
+	else if (cookie == STROLL_RBMAP_NORUN_COOKIE) {
+		if (size < (2 * sizeof(uint32_t)))
+			return -EINVAL;
+		nr = stroll_rbmap_get32(&data[sizeof(uint32_t)]);
+		if (nr > STROLL_RBMAP_CHUNK_BITS)
+			return -EINVAL;
+		data += 2 * sizeof(uint32_t);
+	}
+	else
+		return -EINVAL;
+
+	if ((size_t)(end - data) < (nr * 2 * sizeof(uint16_t)))
+		return -EINVAL;
+	desc = data;
+	data += nr * 2 * sizeof(uint16_t);
+
+	if (stroll_rbmap_has_offsets(nr, !!runs)) {
+		/* Containers are loaded sequentially: skip offsets. */
+		if ((size_t)(end - data) < (nr * sizeof(uint32_t)))
+			return -EINVAL;
+		data += nr * sizeof(uint32_t);
+	}
+
+	if (!nr)
+		return 0;
+
+	rbmap->conts = malloc(nr * sizeof(rbmap->conts[0]));
+	if (!rbmap->conts)
+		return -ENOMEM;
+	rbmap->size = nr;
+
+	for (c = 0; c < nr; c++) {
+		struct stroll_rbmap_cont * cont = &rbmap->conts[c];
+		const uint8_t *            hdr;
+
+		hdr = &desc[c * 2 * sizeof(uint16_t)];
+		*cont = (struct stroll_rbmap_cont){
+			.key   = (uint16_t)stroll_rbmap_get16(hdr),
+			.type  = STROLL_RBMAP_ARRAY_TYPE,
+			.card  = stroll_rbmap_get16(&hdr[sizeof(uint16_t)]) + 1,
+			.nr    = 0,
+			.size  = 0,
+			.array = NULL
+		};
+		rbmap->nr = c + 1;
+
+		if (c && (cont->key <= rbmap->conts[c - 1].key)) {
+			err = -EINVAL;
+			goto fini;
+		}
+
+		if (runs && (runs[c / 8] & (1U << (c % 8))))
+			err = stroll_rbmap_deserialize_runs(cont, &data, end);
+		else if (cont->card <= STROLL_RBMAP_ARRAY_MAX)
+			err = stroll_rbmap_deserialize_array(cont, &data, end);
+		else
+			err = stroll_rbmap_deserialize_bitmap(cont, &data, end);
+		if (err)
+			goto fini;
+	}
+
+	return 0;
+
+fini:
+	stroll_rbmap_fini(rbmap);
+
+	return err;
+}
@@ -9,6 +9,7 @@
 #include <cute/cute.h>
 #include <cute/check.h>
 #include <cute/expect.h>
+#include <stdlib.h>
 #include <string.h>
 
 #define STROLLUT_ARRAY_UNSUP(_setup) \
@@ -211,11 +212,12 @@ CUTE_SUITE_EXTERN(strollut_array_bisect_suite,
 
 #include "array_data.h"
 
-#define STROLLUT_ARRAY_SORT_ALGO_SUP(_setup, _sort, _stable) \
+#define STROLLUT_ARRAY_SORT_ALGO_SUP(_setup, _sort, _stable, _cmp_fact) \
 	static void _setup(void) \
 	{ \
 		strollut_array_sort = _sort; \
 		strollut_array_stable_sort = _stable; \
+		strollut_array_cmp_fact = _cmp_fact; \
 	}
 
 static void (*strollut_array_sort)(void *                array,
@@ -226,6 +228,16 @@ static void (*strollut_array_sort)(void *                array,
 
 static bool strollut_array_stable_sort;
 
+/*
+ * Maximum number of comparisons sorting algorithm under test may perform
+ * expressed as a factor of n.log2(n), where n is the number of elements to
+ * sort. Zero means no bound, i.e. for quadratic algorithms.
+ */
+static unsigned int strollut_array_cmp_fact;
+
+/* Number of comparisons performed by sorting algorithm under test. */
+static unsigned long strollut_array_cmp_cnt;
+
 static int
 strollut_array_compare_min(const void * first,
                            const void * second,
@@ -1050,6 +1062,294 @@ CUTE_TEST(strollut_array_sort_str_postorder)
 			strollut_array_compare_str_postorder);
 }
 
+/*
+ * Adversarial input patterns meant to defeat median-of-three pivot selection
+ * and force quicksort based algorithms into their worst case behavior, i.e.
+ * exercise the heapsort fallback once partitioning goes too deep.
+ *
+ * Besides checking the result is properly sorted, make sure the number of
+ * comparisons stays within the bound given by strollut_array_cmp_fact so that
+ * a missing or ineffective fallback is detected.
+ */
+#define STROLLUT_ARRAY_ADVERS_NR   (2048U)
+#define STROLLUT_ARRAY_ADVERS_LOG2 (11U)
+
+struct strollut_array_advers64b {
+	int  value;
+	char data[60];
+};
+
+static int strollut_array_advers_vals[STROLLUT_ARRAY_ADVERS_NR];
+static int strollut_array_advers_exp[STROLLUT_ARRAY_ADVERS_NR];
+static int strollut_array_advers32[STROLLUT_ARRAY_ADVERS_NR];
+static struct strollut_array_advers64b
+strollut_array_advers64b[STROLLUT_ARRAY_ADVERS_NR];
+
+static int
+strollut_array_compare_count(const void * first,
+                             const void * second,
+                             void *       data)
+{
+	strollut_array_cmp_cnt++;
+
+	return strollut_array_compare_min(first, second, data);
+}
+
+#define strollut_array_check_cmp_cnt() \
+	do { \
+		if (strollut_array_cmp_fact) \
+			cute_check_uint(strollut_array_cmp_cnt, \
+			                lower_equal, \
+			                strollut_array_cmp_fact * \
+			                STROLLUT_ARRAY_ADVERS_NR * \
+			                STROLLUT_ARRAY_ADVERS_LOG2); \
+	} while (0)
+
+static int
+strollut_array_advers_qsort_cmp(const void * first, const void * second)
+{
+	return strollut_array_compare_min(first, second, NULL);
+}
+
+static void
+strollut_array_check_advers(void)
+{
+	unsigned int v;
+
+	memcpy(strollut_array_advers_exp,
+	       strollut_array_advers_vals,
+	       sizeof(strollut_array_advers_exp));
+	qsort(strollut_array_advers_exp,
+	      STROLLUT_ARRAY_ADVERS_NR,
+	      sizeof(strollut_array_advers_exp[0]),
+	      strollut_array_advers_qsort_cmp);
+
+	memcpy(strollut_array_advers32,
+	       strollut_array_advers_vals,
+	       sizeof(strollut_array_advers32));
+	strollut_array_cmp_cnt = 0;
+	strollut_array_sort(strollut_array_advers32,
+	                    STROLLUT_ARRAY_ADVERS_NR,
+	                    sizeof(strollut_array_advers32[0]),
+	                    strollut_array_compare_count,
+	                    NULL);
+	strollut_array_check_cmp_cnt();
+	for (v = 0; v < STROLLUT_ARRAY_ADVERS_NR; v++)
+		cute_check_sint(strollut_array_advers32[v],
+		                equal,
+		                strollut_array_advers_exp[v]);
+
+	for (v = 0; v < STROLLUT_ARRAY_ADVERS_NR; v++)
+		strollut_array_advers64b[v].value =
+			strollut_array_advers_vals[v];
+	strollut_array_cmp_cnt = 0;
+	strollut_array_sort(strollut_array_advers64b,
+	                    STROLLUT_ARRAY_ADVERS_NR,
+	                    sizeof(strollut_array_advers64b[0]),
+	                    strollut_array_compare_count,
+	                    NULL);
+	strollut_array_check_cmp_cnt();
+	for (v = 0; v < STROLLUT_ARRAY_ADVERS_NR; v++)
+		cute_check_sint(strollut_array_advers64b[v].value,
+		                equal,
+		                strollut_array_advers_exp[v]);
+}
+
+CUTE_TEST(strollut_array_sort_organ_pipe)
+{
+	unsigned int v;
+
+	for (v = 0; v < STROLLUT_ARRAY_ADVERS_NR; v++)
+		strollut_array_advers_vals[v] =
+			(int)stroll_min(v, STROLLUT_ARRAY_ADVERS_NR - 1 - v);
+
+	strollut_array_check_advers();
+}
+
+CUTE_TEST(strollut_array_sort_sawtooth)
+{
+	unsigned int v;
+
+	for (v = 0; v < STROLLUT_ARRAY_ADVERS_NR; v++)
+		strollut_array_advers_vals[v] = (int)(v % 4);
+
+	strollut_array_check_advers();
+}
+
+/*
+ * Median-of-3 killer sequence as described in "Introspective Sorting and
+ * Selection Algorithms", David R. Musser, 1997.
+ */
+CUTE_TEST(strollut_array_sort_median3_killer)
+{
+	unsigned int k = STROLLUT_ARRAY_ADVERS_NR / 2;
+	unsigned int v;
+
+	for (v = 1; v <= k; v++) {
+		if (v & 1) {
+			strollut_array_advers_vals[v - 1] = (int)v;
+			strollut_array_advers_vals[v] = (int)(k + v);
+		}
+		strollut_array_advers_vals[k + v - 1] = (int)(2 * v);
+	}
+
+	strollut_array_check_advers();
+}
+
+/*
+ * McIlroy's adversary as described in "A Killer Adversary for Quicksort",
+ * M. D. McIlroy, 1999.
+ *
+ * Elements to sort are identifiers which values are lazily assigned by the
+ * comparison function. All values are initially "gas", i.e. greater than any
+ * other value. Whenever 2 gas elements are compared, one of them is "frozen"
+ * to the lowest value not assigned yet, favoring the element that was most
+ * recently compared against a frozen one, i.e. the likely pivot. This
+ * consistently drives pivot selection towards extremes, defeating the
+ * partitioning scheme of quicksort based algorithms whatever their pivot
+ * selection strategy. For pattern-defeating quicksort, this forces repeated
+ * bad partitions and the heapsort fallback.
+ */
+#define STROLLUT_ARRAY_MCILROY_GAS ((int)STROLLUT_ARRAY_ADVERS_NR)
+
+static int          strollut_array_mcilroy_vals[STROLLUT_ARRAY_ADVERS_NR];
+static int          strollut_array_mcilroy_solid;
+static unsigned int strollut_array_mcilroy_cand;
+
+static int
+strollut_array_mcilroy_cmp(const void * first,
+                           const void * second,
+                           void *       data __unused)
+{
+	unsigned int f = (unsigned int)*(const int *)first;
+	unsigned int s = (unsigned int)*(const int *)second;
+	int *        vals = strollut_array_mcilroy_vals;
+
+	strollut_array_cmp_cnt++;
+
+	if ((vals[f] == STROLLUT_ARRAY_MCILROY_GAS) &&
+	    (vals[s] == STROLLUT_ARRAY_MCILROY_GAS)) {
+		if (f == strollut_array_mcilroy_cand)
+			vals[f] = strollut_array_mcilroy_solid++;
+		else
+			vals[s] = strollut_array_mcilroy_solid++;
+	}
+
+	if (vals[f] == STROLLUT_ARRAY_MCILROY_GAS)
+		strollut_array_mcilroy_cand = f;
+	else if (vals[s] == STROLLUT_ARRAY_MCILROY_GAS)
+		strollut_array_mcilroy_cand = s;
+
+	return (vals[f] > vals[s]) - (vals[f] < vals[s]);
+}
+
+static void
+strollut_array_mcilroy_init(void)
+{
+	unsigned int v;
+
+	for (v = 0; v < STROLLUT_ARRAY_ADVERS_NR; v++)
+		strollut_array_mcilroy_vals[v] = STROLLUT_ARRAY_MCILROY_GAS;
+	strollut_array_mcilroy_solid = 0;
+	strollut_array_mcilroy_cand = 0;
+	strollut_array_cmp_cnt = 0;
+}
+
+/*
+ * Elements left as gas were never ordered against each other: at most one may
+ * remain once sorted, which is greater than all others.
+ */
+#define strollut_array_check_mcilroy(_array, _field) \
+	do { \
+		unsigned int _v; \
+		\
+		for (_v = 1; _v < STROLLUT_ARRAY_ADVERS_NR; _v++) \
+			cute_check_sint( \
+				strollut_array_mcilroy_vals[ \
+					(_array)[_v - 1]_field], \
+				lower, \
+				strollut_array_mcilroy_vals[ \
+					(_array)[_v]_field]); \
+	} while (0)
+
+CUTE_TEST(strollut_array_sort_mcilroy)
+{
+	unsigned int v;
+
+	strollut_array_mcilroy_init();
+	for (v = 0; v < STROLLUT_ARRAY_ADVERS_NR; v++)
+		strollut_array_advers32[v] = (int)v;
+	strollut_array_sort(strollut_array_advers32,
+	                    STROLLUT_ARRAY_ADVERS_NR,
+	                    sizeof(strollut_array_advers32[0]),
+	                    strollut_array_mcilroy_cmp,
+	                    NULL);
+	strollut_array_check_mcilroy(strollut_array_advers32, );
+	strollut_array_check_cmp_cnt();
+
+	strollut_array_mcilroy_init();
+	for (v = 0; v < STROLLUT_ARRAY_ADVERS_NR; v++)
+		strollut_array_advers64b[v].value = (int)v;
+	strollut_array_sort(strollut_array_advers64b,
+	                    STROLLUT_ARRAY_ADVERS_NR,
+	                    sizeof(strollut_array_advers64b[0]),
+	                    strollut_array_mcilroy_cmp,
+	                    NULL);
+	strollut_array_check_mcilroy(strollut_array_advers64b, .value);
+	strollut_array_check_cmp_cnt();
+}
+
+/*
+ * Concatenations of sorted runs of varying lengths, as natural merge sort
+ * based algorithms are expected to detect and merge them.
+ */
+CUTE_TEST(strollut_array_sort_ascending_runs)
+{
+	unsigned int v = 0;
+	unsigned int r;
+
+	for (r = 1; v < STROLLUT_ARRAY_ADVERS_NR; r++) {
+		unsigned int n;
+
+		for (n = 0;
+		     (n < (r * 7)) && (v < STROLLUT_ARRAY_ADVERS_NR);
+		     n++)
+			strollut_array_advers_vals[v++] = (int)((n * 3) + r);
+	}
+
+	strollut_array_check_advers();
+}
+
+CUTE_TEST(strollut_array_sort_descending_runs)
+{
+	unsigned int v = 0;
+	unsigned int r;
+
+	for (r = 1; v < STROLLUT_ARRAY_ADVERS_NR; r++) {
+		unsigned int n;
+
+		for (n = r * 11; n && (v < STROLLUT_ARRAY_ADVERS_NR); n--)
+			strollut_array_advers_vals[v++] =
+				(int)((n * 2) + (r & 3));
+	}
+
+	strollut_array_check_advers();
+}
+
+CUTE_TEST(strollut_array_sort_interleaved_runs)
+{
+	unsigned int v;
+
+	unsigned int half = STROLLUT_ARRAY_ADVERS_NR / 2;
+
+	for (v = 0; v < half; v++) {
+		strollut_array_advers_vals[v] = (int)(2 * v);
+		strollut_array_advers_vals[half + v] = (int)((2 * v) + 1);
+	}
+
+	strollut_array_check_advers();
+}
+
 CUTE_GROUP(strollut_array_sort_group) = {
 	CUTE_REF(strollut_array_sort_single32),
 	CUTE_REF(strollut_array_sort_single64),
@@ -1087,13 +1387,23 @@ CUTE_GROUP(strollut_array_sort_group) = {
 	CUTE_REF(strollut_array_sort_postorder),
 
 	CUTE_REF(strollut_array_sort_str_inorder),
-	CUTE_REF(strollut_array_sort_str_postorder)
+	CUTE_REF(strollut_array_sort_str_postorder),
+
+	CUTE_REF(strollut_array_sort_organ_pipe),
+	CUTE_REF(strollut_array_sort_sawtooth),
+	CUTE_REF(strollut_array_sort_median3_killer),
+	CUTE_REF(strollut_array_sort_mcilroy),
+
+	CUTE_REF(strollut_array_sort_ascending_runs),
+	CUTE_REF(strollut_array_sort_descending_runs),
+	CUTE_REF(strollut_array_sort_interleaved_runs)
 };
 
 #if defined(CONFIG_STROLL_ARRAY_BUBBLE_SORT)
 STROLLUT_ARRAY_SORT_ALGO_SUP(strollut_array_bubble_setup,
                              stroll_array_bubble_sort,
-                             true)
+                             true,
+                             0)
 #else   /* !defined(CONFIG_STROLL_ARRAY_BUBBLE_SORT) */
 STROLLUT_ARRAY_UNSUP(strollut_array_bubble_setup)
 #endif  /* defined(CONFIG_STROLL_ARRAY_BUBBLE_SORT) */
@@ -1107,7 +1417,8 @@ CUTE_SUITE_STATIC(strollut_array_bubble_suite,
 #if defined(CONFIG_STROLL_ARRAY_SELECT_SORT)
 STROLLUT_ARRAY_SORT_ALGO_SUP(strollut_array_select_setup,
                              stroll_array_select_sort,
-                             false)
+                             false,
+                             0)
 #else   /* !defined(CONFIG_STROLL_ARRAY_SELECT_SORT) */
 STROLLUT_ARRAY_UNSUP(strollut_array_select_setup)
 #endif  /* defined(CONFIG_STROLL_ARRAY_SELECT_SORT) */
@@ -1121,7 +1432,8 @@ CUTE_SUITE_STATIC(strollut_array_select_suite,
 #if defined(CONFIG_STROLL_ARRAY_INSERT_SORT)
 STROLLUT_ARRAY_SORT_ALGO_SUP(strollut_array_insert_setup,
                              stroll_array_insert_sort,
-                             true)
+                             true,
+                             0)
 #else   /* !defined(CONFIG_STROLL_ARRAY_INSERT_SORT) */
 STROLLUT_ARRAY_UNSUP(strollut_array_insert_setup)
 #endif  /* defined(CONFIG_STROLL_ARRAY_INSERT_SORT) */
@@ -1135,7 +1447,8 @@ CUTE_SUITE_STATIC(strollut_array_insert_suite,
 #if defined(CONFIG_STROLL_ARRAY_QUICK_SORT)
 STROLLUT_ARRAY_SORT_ALGO_SUP(strollut_array_quick_setup,
                              stroll_array_quick_sort,
-                             false)
+                             false,
+                             4)
 #else   /* !defined(CONFIG_STROLL_ARRAY_QUICK_SORT) */
 STROLLUT_ARRAY_UNSUP(strollut_array_quick_setup)
 #endif  /* defined(CONFIG_STROLL_ARRAY_QUICK_SORT) */
@@ -1149,7 +1462,8 @@ CUTE_SUITE_STATIC(strollut_array_quick_suite,
 #if defined(CONFIG_STROLL_ARRAY_3WQUICK_SORT)
 STROLLUT_ARRAY_SORT_ALGO_SUP(strollut_array_3wquick_setup,
                              stroll_array_3wquick_sort,
-                             false)
+                             false,
+                             4)
 #else   /* !defined(CONFIG_STROLL_ARRAY_3WQUICK_SORT) */
 STROLLUT_ARRAY_UNSUP(strollut_array_3wquick_setup)
 #endif  /* defined(CONFIG_STROLL_ARRAY_3WQUICK_SORT) */
@@ -1160,6 +1474,21 @@ CUTE_SUITE_STATIC(strollut_array_3wquick_suite,
                   CUTE_NULL_TEARDOWN,
                   CUTE_DFLT_TMOUT);
 
+#if defined(CONFIG_STROLL_ARRAY_PDQUICK_SORT)
+STROLLUT_ARRAY_SORT_ALGO_SUP(strollut_array_pdquick_setup,
+                             stroll_array_pdquick_sort,
+                             false,
+                             4)
+#else   /* !defined(CONFIG_STROLL_ARRAY_PDQUICK_SORT) */
+STROLLUT_ARRAY_UNSUP(strollut_array_pdquick_setup)
+#endif  /* defined(CONFIG_STROLL_ARRAY_PDQUICK_SORT) */
+
+CUTE_SUITE_STATIC(strollut_array_pdquick_suite,
+                  strollut_array_sort_group,
+                  strollut_array_pdquick_setup,
+                  CUTE_NULL_TEARDOWN,
+                  CUTE_DFLT_TMOUT);
+
 #if defined(CONFIG_STROLL_ARRAY_MERGE_SORT)
 
 static void
@@ -1177,7 +1506,8 @@ strollut_array_merge_sort(void * __restrict     array,
 
 STROLLUT_ARRAY_SORT_ALGO_SUP(strollut_array_merge_setup,
                              strollut_array_merge_sort,
-                             true)
+                             true,
+                             2)
 #else   /* !defined(CONFIG_STROLL_ARRAY_MERGE_SORT) */
 STROLLUT_ARRAY_UNSUP(strollut_array_merge_setup)
 #endif  /* defined(CONFIG_STROLL_ARRAY_MERGE_SORT) */
@@ -1188,11 +1518,110 @@ CUTE_SUITE_STATIC(strollut_array_merge_suite,
                   CUTE_NULL_TEARDOWN,
                   CUTE_DFLT_TMOUT);
 
+#if defined(CONFIG_STROLL_ARRAY_MERGE_SORT) || \
+    defined(CONFIG_STROLL_ARRAY_FWHEAP_SORT)
+
+/*
+ * Scratch buffer shared by all sorts run with a caller supplied workspace.
+ * Large enough to sort the biggest arrays of strollut_array_sort_group.
+ */
+static unsigned long strollut_array_scratch[
+	((STROLLUT_ARRAY_ADVERS_NR * sizeof(struct strollut_array_advers64b)) /
+	 sizeof(unsigned long)) + 1];
+
+#endif /* defined(CONFIG_STROLL_ARRAY_MERGE_SORT) || \
+          defined(CONFIG_STROLL_ARRAY_FWHEAP_SORT) */
+
+#if defined(CONFIG_STROLL_ARRAY_MERGE_SORT)
+
+/*
+ * Give a scratch buffer misaligned on purpose so that the generic merging
+ * implementation is exercised for word sized elements too.
+ */
+static void
+strollut_array_merge_scratch_sort(void * __restrict     array,
+                                  unsigned int          nr,
+                                  size_t                size,
+                                  stroll_array_cmp_fn * compare,
+                                  void *                data)
+{
+	cute_check_uint(stroll_array_merge_sort_scratch_size(nr, size),
+	                lower_equal,
+	                sizeof(strollut_array_scratch) - 1);
+
+	stroll_array_merge_sort_with_scratch(
+		array,
+		nr,
+		size,
+		compare,
+		data,
+		&((char *)strollut_array_scratch)[1]);
+}
+
+STROLLUT_ARRAY_SORT_ALGO_SUP(strollut_array_merge_scratch_setup,
+                             strollut_array_merge_scratch_sort,
+                             true,
+                             2)
+#else   /* !defined(CONFIG_STROLL_ARRAY_MERGE_SORT) */
+STROLLUT_ARRAY_UNSUP(strollut_array_merge_scratch_setup)
+#endif  /* defined(CONFIG_STROLL_ARRAY_MERGE_SORT) */
+
+CUTE_SUITE_STATIC(strollut_array_merge_scratch_suite,
+                  strollut_array_sort_group,
+                  strollut_array_merge_scratch_setup,
+                  CUTE_NULL_TEARDOWN,
+                  CUTE_DFLT_TMOUT);
+
+#if defined(CONFIG_STROLL_ARRAY_INPLACE_MERGE_SORT)
+STROLLUT_ARRAY_SORT_ALGO_SUP(strollut_array_inpmerge_setup,
+                             stroll_array_inplace_merge_sort,
+                             true,
+                             2)
+#else   /* !defined(CONFIG_STROLL_ARRAY_INPLACE_MERGE_SORT) */
+STROLLUT_ARRAY_UNSUP(strollut_array_inpmerge_setup)
+#endif  /* defined(CONFIG_STROLL_ARRAY_INPLACE_MERGE_SORT) */
+
+CUTE_SUITE_STATIC(strollut_array_inpmerge_suite,
+                  strollut_array_sort_group,
+                  strollut_array_inpmerge_setup,
+                  CUTE_NULL_TEARDOWN,
+                  CUTE_DFLT_TMOUT);
+
+#if defined(CONFIG_STROLL_ARRAY_POWER_SORT)
+
+static void
+strollut_array_power_sort(void * __restrict     array,
+                          unsigned int          nr,
+                          size_t                size,
+                          stroll_array_cmp_fn * compare,
+                          void *                data)
+{
+	int err;
+
+	err = stroll_array_power_sort(array, nr, size, compare, data);
+	cute_check_sint(err, equal, 0);
+}
+
+STROLLUT_ARRAY_SORT_ALGO_SUP(strollut_array_power_setup,
+                             strollut_array_power_sort,
+                             true,
+                             2)
+#else   /* !defined(CONFIG_STROLL_ARRAY_POWER_SORT) */
+STROLLUT_ARRAY_UNSUP(strollut_array_power_setup)
+#endif  /* defined(CONFIG_STROLL_ARRAY_POWER_SORT) */
+
+CUTE_SUITE_STATIC(strollut_array_power_suite,
+                  strollut_array_sort_group,
+                  strollut_array_power_setup,
+                  CUTE_NULL_TEARDOWN,
+                  CUTE_DFLT_TMOUT);
+
 #if defined(CONFIG_STROLL_ARRAY_FBHEAP_SORT)
 
 STROLLUT_ARRAY_SORT_ALGO_SUP(strollut_array_fbheap_setup,
                              stroll_array_fbheap_sort,
-                             false)
+                             false,
+                             2)
 #else   /* !defined(CONFIG_STROLL_ARRAY_FBHEAP_SORT) */
 STROLLUT_ARRAY_UNSUP(strollut_array_fbheap_setup)
 #endif  /* defined(CONFIG_STROLL_ARRAY_FBHEAP_SORT) */
@@ -1220,7 +1649,8 @@ strollut_array_fwheap_sort(void * __restrict     array,
 
 STROLLUT_ARRAY_SORT_ALGO_SUP(strollut_array_fwheap_setup,
                              strollut_array_fwheap_sort,
-                             false)
+                             false,
+                             2)
 #else   /* !defined(CONFIG_STROLL_ARRAY_FWHEAP_SORT) */
 STROLLUT_ARRAY_UNSUP(strollut_array_fwheap_setup)
 #endif  /* defined(CONFIG_STROLL_ARRAY_FWHEAP_SORT) */
@@ -1231,6 +1661,1897 @@ CUTE_SUITE_STATIC(strollut_array_fwheap_suite,
                   CUTE_NULL_TEARDOWN,
                   CUTE_DFLT_TMOUT);
 
+#if defined(CONFIG_STROLL_ARRAY_FWHEAP_SORT)
+
+static void
+strollut_array_fwheap_scratch_sort(void * __restrict     array,
+                                   unsigned int          nr,
+                                   size_t                size,
+                                   stroll_array_cmp_fn * compare,
+                                   void *                data)
+{
+	cute_check_uint(stroll_array_fwheap_sort_scratch_size(nr),
+	                lower_equal,
+	                sizeof(strollut_array_scratch));
+
+	/* Fill scratch buffer with garbage left over by a previous sort. */
+	memset(strollut_array_scratch, 0xa5, sizeof(strollut_array_scratch));
+
+	stroll_array_fwheap_sort_with_scratch(array,
+	                                      nr,
+	                                      size,
+	                                      compare,
+	                                      data,
+	                                      strollut_array_scratch);
+}
+
+STROLLUT_ARRAY_SORT_ALGO_SUP(strollut_array_fwheap_scratch_setup,
+                             strollut_array_fwheap_scratch_sort,
+                             false,
+                             2)
+#else   /* !defined(CONFIG_STROLL_ARRAY_FWHEAP_SORT) */
+STROLLUT_ARRAY_UNSUP(strollut_array_fwheap_scratch_setup)
+#endif  /* defined(CONFIG_STROLL_ARRAY_FWHEAP_SORT) */
+
+CUTE_SUITE_STATIC(strollut_array_fwheap_scratch_suite,
+                  strollut_array_sort_group,
+                  strollut_array_fwheap_scratch_setup,
+                  CUTE_NULL_TEARDOWN,
+                  CUTE_DFLT_TMOUT);
+
+/******************************************************************************
+ * Indirect sorting tests
+ ******************************************************************************/
+
+#if defined(CONFIG_STROLL_ARRAY_INDIRECT_SORT)
+
+#include <stdint.h>
+
+static void
+strollut_array_indirect_sort(void * __restrict     array,
+                             unsigned int          nr,
+                             size_t                size,
+                             stroll_array_cmp_fn * compare,
+                             void *                data)
+{
+	int err;
+
+	err = stroll_array_indirect_sort(array, nr, size, compare, data);
+	cute_check_sint(err, equal, 0);
+}
+
+STROLLUT_ARRAY_SORT_ALGO_SUP(strollut_array_indirect_setup,
+                             strollut_array_indirect_sort,
+                             true,
+                             2)
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_array_indirect_assert)
+{
+	int          array[4] = { 3, 2, 1, 0 };
+	unsigned int indices[4] = { 3, 2, 1, 0 };
+	int          ret __unused;
+
+	cute_expect_assertion(
+		ret = stroll_array_argsort(NULL,
+		                           4,
+		                           sizeof(array[0]),
+		                           strollut_array_compare_min,
+		                           NULL,
+		                           indices));
+	cute_expect_assertion(
+		ret = stroll_array_argsort(array,
+		                           0,
+		                           sizeof(array[0]),
+		                           strollut_array_compare_min,
+		                           NULL,
+		                           indices));
+	cute_expect_assertion(
+		ret = stroll_array_argsort(array,
+		                           4,
+		                           0,
+		                           strollut_array_compare_min,
+		                           NULL,
+		                           indices));
+	cute_expect_assertion(
+		ret = stroll_array_argsort(array,
+		                           4,
+		                           sizeof(array[0]),
+		                           NULL,
+		                           NULL,
+		                           indices));
+	cute_expect_assertion(
+		ret = stroll_array_argsort(array,
+		                           4,
+		                           sizeof(array[0]),
+		                           strollut_array_compare_min,
+		                           NULL,
+		                           NULL));
+
+	cute_expect_assertion(
+		stroll_array_permute(NULL, 4, sizeof(array[0]), indices));
+	cute_expect_assertion(
+		stroll_array_permute(array, 0, sizeof(array[0]), indices));
+	cute_expect_assertion(stroll_array_permute(array, 4, 0, indices));
+	cute_expect_assertion(
+		stroll_array_permute(array, 4, sizeof(array[0]), NULL));
+}
+#else
+CUTE_TEST(strollut_array_indirect_assert)
+{
+	cute_skip("assertion unsupported");
+}
+#endif
+
+#define STROLLUT_ARRAY_INDIRECT_NR (1000U)
+
+static uint64_t strollut_array_indirect_seed = UINT64_C(0x3c6ef372fe94f82b);
+
+static unsigned int
+strollut_array_indirect_rand(unsigned int max)
+{
+	strollut_array_indirect_seed ^= strollut_array_indirect_seed << 13;
+	strollut_array_indirect_seed ^= strollut_array_indirect_seed >> 7;
+	strollut_array_indirect_seed ^= strollut_array_indirect_seed << 17;
+
+	return (unsigned int)(strollut_array_indirect_seed % max);
+}
+
+struct strollut_array_indirect_rec {
+	unsigned int key;
+	unsigned int id;
+	char         data[248];
+};
+
+static int
+strollut_array_indirect_cmp(const void * __restrict first,
+                            const void * __restrict second,
+                            void *                  data __unused)
+{
+	const struct strollut_array_indirect_rec * fst = first;
+	const struct strollut_array_indirect_rec * snd = second;
+
+	return (fst->key > snd->key) - (fst->key < snd->key);
+}
+
+CUTE_TEST(strollut_array_argsort)
+{
+	struct strollut_array_indirect_rec * array;
+	struct strollut_array_indirect_rec * orig;
+	unsigned int *                       indices;
+	unsigned int                         r;
+
+	array = malloc(STROLLUT_ARRAY_INDIRECT_NR * sizeof(array[0]));
+	orig = malloc(STROLLUT_ARRAY_INDIRECT_NR * sizeof(orig[0]));
+	indices = malloc(STROLLUT_ARRAY_INDIRECT_NR * sizeof(indices[0]));
+	cute_check_ptr(array, unequal, NULL);
+	cute_check_ptr(orig, unequal, NULL);
+	cute_check_ptr(indices, unequal, NULL);
+
+	for (r = 0; r < STROLLUT_ARRAY_INDIRECT_NR; r++) {
+		array[r].key = strollut_array_indirect_rand(37);
+		array[r].id = r;
+		memset(array[r].data, (int)(r & 0xff), sizeof(array[r].data));
+	}
+	memcpy(orig, array, STROLLUT_ARRAY_INDIRECT_NR * sizeof(array[0]));
+
+	cute_check_sint(stroll_array_argsort(array,
+	                                     STROLLUT_ARRAY_INDIRECT_NR,
+	                                     sizeof(array[0]),
+	                                     strollut_array_indirect_cmp,
+	                                     NULL,
+	                                     indices),
+	                equal,
+	                0);
+
+	/* Input array must be left untouched. */
+	cute_check_sint(memcmp(array,
+	                       orig,
+	                       STROLLUT_ARRAY_INDIRECT_NR * sizeof(array[0])),
+	                equal,
+	                0);
+
+	/* Indices must be given in ascending key order, then stable order. */
+	for (r = 1; r < STROLLUT_ARRAY_INDIRECT_NR; r++) {
+		const struct strollut_array_indirect_rec * prev;
+		const struct strollut_array_indirect_rec * curr;
+
+		cute_check_uint(indices[r], lower, STROLLUT_ARRAY_INDIRECT_NR);
+		prev = &array[indices[r - 1]];
+		curr = &array[indices[r]];
+		cute_check_uint(prev->key, lower_equal, curr->key);
+		if (prev->key == curr->key)
+			cute_check_uint(prev->id, lower, curr->id);
+	}
+
+	/* Applying permutation must sort the array. */
+	stroll_array_permute(array,
+	                     STROLLUT_ARRAY_INDIRECT_NR,
+	                     sizeof(array[0]),
+	                     indices);
+	for (r = 0; r < STROLLUT_ARRAY_INDIRECT_NR; r++) {
+		cute_check_uint(indices[r], equal, r);
+		if (r)
+			cute_check_uint(array[r - 1].key,
+			                lower_equal,
+			                array[r].key);
+		cute_check_sint(memcmp(&array[r],
+		                       &orig[array[r].id],
+		                       sizeof(array[r])),
+		                equal,
+		                0);
+	}
+
+	free(indices);
+	free(orig);
+	free(array);
+}
+
+/*
+ * Check stability of argsort against inputs made of a few distinct keys, i.e.
+ * with long sequences of equal keys, where indices of equal keys must be given
+ * in ascending order.
+ */
+#define STROLLUT_ARRAY_ARGSORT_DUPS_NR (20000U)
+
+CUTE_TEST(strollut_array_argsort_dups)
+{
+	int *          array;
+	unsigned int * indices;
+	unsigned int   k;
+
+	array = malloc(STROLLUT_ARRAY_ARGSORT_DUPS_NR * sizeof(array[0]));
+	indices = malloc(STROLLUT_ARRAY_ARGSORT_DUPS_NR * sizeof(indices[0]));
+	cute_check_ptr(array, unequal, NULL);
+	cute_check_ptr(indices, unequal, NULL);
+
+	for (k = 2; k <= 4; k++) {
+		unsigned int r;
+
+		for (r = 0; r < STROLLUT_ARRAY_ARGSORT_DUPS_NR; r++)
+			array[r] = (int)strollut_array_indirect_rand(k);
+
+		cute_check_sint(
+			stroll_array_argsort(array,
+			                     STROLLUT_ARRAY_ARGSORT_DUPS_NR,
+			                     sizeof(array[0]),
+			                     strollut_array_compare_min,
+			                     NULL,
+			                     indices),
+			equal,
+			0);
+
+		for (r = 1; r < STROLLUT_ARRAY_ARGSORT_DUPS_NR; r++) {
+			int prev = array[indices[r - 1]];
+			int curr = array[indices[r]];
+
+			cute_check_sint(prev, lower_equal, curr);
+			if (prev == curr)
+				cute_check_uint(indices[r - 1],
+				                lower,
+				                indices[r]);
+		}
+	}
+
+	free(indices);
+	free(array);
+}
+
+static void
+strollut_array_permute_fill(char * __restrict rec,
+                            unsigned int      idx,
+                            size_t            size)
+{
+	size_t b;
+
+	for (b = 0; b < size; b++)
+		rec[b] = (char)((idx * 7) + b);
+}
+
+static void
+strollut_array_check_permute(unsigned int nr, size_t size)
+{
+	char *         array;
+	char *         expect;
+	unsigned int * indices;
+	unsigned int * perm;
+	unsigned int   r;
+
+	array = malloc(nr * size);
+	expect = malloc(size);
+	indices = malloc(nr * sizeof(indices[0]));
+	perm = malloc(nr * sizeof(perm[0]));
+	cute_check_ptr(array, unequal, NULL);
+	cute_check_ptr(expect, unequal, NULL);
+	cute_check_ptr(indices, unequal, NULL);
+	cute_check_ptr(perm, unequal, NULL);
+
+	/* Build a random permutation using Fisher-Yates shuffle. */
+	for (r = 0; r < nr; r++) {
+		strollut_array_permute_fill(&array[r * size], r, size);
+		perm[r] = r;
+	}
+	for (r = nr; r > 1; r--) {
+		unsigned int swap = strollut_array_indirect_rand(r);
+		unsigned int tmp = perm[r - 1];
+
+		perm[r - 1] = perm[swap];
+		perm[swap] = tmp;
+	}
+	memcpy(indices, perm, nr * sizeof(indices[0]));
+
+	stroll_array_permute(array, nr, size, indices);
+
+	for (r = 0; r < nr; r++) {
+		cute_check_uint(indices[r], equal, r);
+		strollut_array_permute_fill(expect, perm[r], size);
+		cute_check_sint(memcmp(&array[r * size], expect, size),
+		                equal,
+		                0);
+	}
+
+	free(perm);
+	free(indices);
+	free(expect);
+	free(array);
+}
+
+CUTE_TEST(strollut_array_permute_single)
+{
+	strollut_array_check_permute(1, sizeof(uint32_t));
+	strollut_array_check_permute(1, 3);
+}
+
+CUTE_TEST(strollut_array_permute32)
+{
+	strollut_array_check_permute(STROLLUT_ARRAY_INDIRECT_NR,
+	                             sizeof(uint32_t));
+}
+
+CUTE_TEST(strollut_array_permute64)
+{
+	strollut_array_check_permute(STROLLUT_ARRAY_INDIRECT_NR,
+	                             sizeof(uint64_t));
+}
+
+CUTE_TEST(strollut_array_permute_mem)
+{
+	strollut_array_check_permute(STROLLUT_ARRAY_INDIRECT_NR, 12);
+	strollut_array_check_permute(STROLLUT_ARRAY_INDIRECT_NR, 256);
+}
+
+/* Records larger than permutation buffer are permuted by slices. */
+CUTE_TEST(strollut_array_permute_large)
+{
+	strollut_array_check_permute(100, 1500);
+	strollut_array_check_permute(100, 4096);
+}
+
+#else  /* !defined(CONFIG_STROLL_ARRAY_INDIRECT_SORT) */
+
+STROLLUT_ARRAY_UNSUP(strollut_array_indirect_setup)
+
+CUTE_TEST(strollut_array_indirect_assert)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_argsort)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_argsort_dups)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_permute_single)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_permute32)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_permute64)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_permute_mem)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_permute_large)
+{
+	cute_skip("support not compiled-in");
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_INDIRECT_SORT) */
+
+CUTE_SUITE_STATIC(strollut_array_indirect_suite,
+                  strollut_array_sort_group,
+                  strollut_array_indirect_setup,
+                  CUTE_NULL_TEARDOWN,
+                  CUTE_DFLT_TMOUT);
+
+CUTE_GROUP(strollut_array_permute_group) = {
+	CUTE_REF(strollut_array_indirect_assert),
+	CUTE_REF(strollut_array_argsort),
+	CUTE_REF(strollut_array_argsort_dups),
+	CUTE_REF(strollut_array_permute_single),
+	CUTE_REF(strollut_array_permute32),
+	CUTE_REF(strollut_array_permute64),
+	CUTE_REF(strollut_array_permute_mem),
+	CUTE_REF(strollut_array_permute_large)
+};
+
+CUTE_SUITE_STATIC(strollut_array_permute_suite,
+                  strollut_array_permute_group,
+                  CUTE_NULL_SETUP,
+                  CUTE_NULL_TEARDOWN,
+                  CUTE_DFLT_TMOUT);
+
+/******************************************************************************
+ * Radix sorting tests
+ ******************************************************************************/
+
+#if defined(CONFIG_STROLL_ARRAY_RADIX_SORT)
+
+#include <stdint.h>
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_array_radix_assert)
+{
+	uint32_t array[4] = { 3, 2, 1, 0 };
+	int      ret __unused;
+
+	cute_expect_assertion(ret = stroll_array_radix_sort(NULL, 4, 4, 0, 4));
+	cute_expect_assertion(ret = stroll_array_radix_sort(array, 0, 4, 0, 4));
+	cute_expect_assertion(ret = stroll_array_radix_sort(array, 4, 0, 0, 4));
+	cute_expect_assertion(ret = stroll_array_radix_sort(array, 4, 4, 0, 3));
+	cute_expect_assertion(ret = stroll_array_radix_sort(array, 4, 4, 1, 4));
+
+	cute_expect_assertion(stroll_array_msd_radix_sort(NULL, 4, 4, 0, 4));
+	cute_expect_assertion(stroll_array_msd_radix_sort(array, 0, 4, 0, 4));
+	cute_expect_assertion(stroll_array_msd_radix_sort(array, 4, 0, 0, 4));
+	cute_expect_assertion(stroll_array_msd_radix_sort(array, 4, 4, 0, 3));
+	cute_expect_assertion(stroll_array_msd_radix_sort(array, 4, 4, 1, 4));
+}
+#else
+CUTE_TEST(strollut_array_radix_assert)
+{
+	cute_skip("assertion unsupported");
+}
+#endif
+
+struct strollut_array_radix_ref {
+	uint64_t     key;
+	unsigned int seq;
+};
+
+static uint64_t strollut_array_radix_seed = UINT64_C(0x9e3779b97f4a7c15);
+
+static uint64_t
+strollut_array_radix_rand(void)
+{
+	strollut_array_radix_seed ^= strollut_array_radix_seed << 13;
+	strollut_array_radix_seed ^= strollut_array_radix_seed >> 7;
+	strollut_array_radix_seed ^= strollut_array_radix_seed << 17;
+
+	return strollut_array_radix_seed;
+}
+
+static int
+strollut_array_radix_cmp(const void * first, const void * second)
+{
+	const struct strollut_array_radix_ref * fst = first;
+	const struct strollut_array_radix_ref * snd = second;
+
+	if (fst->key != snd->key)
+		return (fst->key > snd->key) - (fst->key < snd->key);
+
+	return (fst->seq > snd->seq) - (fst->seq < snd->seq);
+}
+
+static uint64_t
+strollut_array_radix_get(const char * elem, size_t ksz)
+{
+	uint8_t  k8;
+	uint16_t k16;
+	uint32_t k32;
+	uint64_t k64;
+
+	switch (ksz) {
+	case 1:
+		memcpy(&k8, elem, ksz);
+		return k8;
+	case 2:
+		memcpy(&k16, elem, ksz);
+		return k16;
+	case 4:
+		memcpy(&k32, elem, ksz);
+		return k32;
+	default:
+		memcpy(&k64, elem, ksz);
+		return k64;
+	}
+}
+
+static void
+strollut_array_radix_put(char * elem, size_t ksz, uint64_t key)
+{
+	uint8_t  k8 = (uint8_t)key;
+	uint16_t k16 = (uint16_t)key;
+	uint32_t k32 = (uint32_t)key;
+
+	switch (ksz) {
+	case 1:
+		memcpy(elem, &k8, ksz);
+		break;
+	case 2:
+		memcpy(elem, &k16, ksz);
+		break;
+	case 4:
+		memcpy(elem, &k32, ksz);
+		break;
+	default:
+		memcpy(elem, &key, ksz);
+	}
+}
+
+/*
+ * Sort nr elements of the given size holding a key of size ksz located at
+ * offset off. When the element is large enough, a sequence number is stored
+ * right after the key to check sorting stability.
+ */
+static void
+strollut_array_check_radix(unsigned int nr,
+                           size_t       size,
+                           size_t       off,
+                           size_t       ksz,
+                           uint64_t     range,
+                           bool         msd)
+{
+	bool                              seq;
+	char *                            array;
+	struct strollut_array_radix_ref * ref;
+	unsigned int                      n;
+
+	/* Append a sequence number to keys when elements are large enough. */
+	seq = (off + ksz + sizeof(n)) <= size;
+	array = calloc(nr, size);
+	cute_check_ptr(array, unequal, NULL);
+	ref = malloc(nr * sizeof(ref[0]));
+	cute_check_ptr(ref, unequal, NULL);
+
+	for (n = 0; n < nr; n++) {
+		uint64_t key = strollut_array_radix_rand();
+
+		if (range)
+			key %= range;
+		if (ksz < sizeof(uint64_t))
+			key &= (UINT64_C(1) << (ksz * 8)) - 1;
+
+		strollut_array_radix_put(&array[(n * size) + off], ksz, key);
+		if (seq)
+			memcpy(&array[(n * size) + off + ksz], &n, sizeof(n));
+
+		ref[n].key = key;
+		ref[n].seq = n;
+	}
+
+	qsort(ref, nr, sizeof(ref[0]), strollut_array_radix_cmp);
+
+	if (msd)
+		stroll_array_msd_radix_sort(array, nr, size, off, ksz);
+	else
+		cute_check_sint(stroll_array_radix_sort(array,
+		                                        nr,
+		                                        size,
+		                                        off,
+		                                        ksz),
+		                equal,
+		                0);
+
+	for (n = 0; n < nr; n++) {
+		const char * elem = &array[n * size];
+
+		cute_check_uint(strollut_array_radix_get(&elem[off], ksz),
+		                equal,
+		                ref[n].key);
+		if (seq && !msd) {
+			unsigned int s;
+
+			memcpy(&s, &elem[off + ksz], sizeof(s));
+			cute_check_uint(s, equal, ref[n].seq);
+		}
+	}
+
+	free(ref);
+	free(array);
+}
+
+CUTE_TEST(strollut_array_radix_single)
+{
+	uint32_t array[] = { 0xdeadbeef };
+	char     mem[4] = { 0x5a, 0x12, 0x34, 0x56 };
+
+	cute_check_sint(
+		stroll_array_radix_sort(array, 1, sizeof(array[0]), 0, 4),
+		equal,
+		0);
+	cute_check_uint(array[0], equal, 0xdeadbeef);
+
+	stroll_array_msd_radix_sort(array, 1, sizeof(array[0]), 0, 4);
+	cute_check_uint(array[0], equal, 0xdeadbeef);
+
+	/* Misaligned element of odd size. */
+	cute_check_sint(stroll_array_radix_sort(&mem[1], 1, 3, 1, 2),
+	                equal,
+	                0);
+	stroll_array_msd_radix_sort(&mem[1], 1, 3, 1, 2);
+	cute_check_mem(mem, equal, "\x5a\x12\x34\x56", sizeof(mem));
+}
+
+CUTE_TEST(strollut_array_radix_lsd32)
+{
+	strollut_array_check_radix(3, 4, 0, 4, 0, false);
+	strollut_array_check_radix(1000, 4, 0, 4, 0, false);
+	strollut_array_check_radix(1000, 4, 0, 4, 100, false);
+	strollut_array_check_radix(1000, 4, 1, 2, 0, false);
+	strollut_array_check_radix(1000, 4, 3, 1, 0, false);
+}
+
+CUTE_TEST(strollut_array_radix_lsd64)
+{
+	strollut_array_check_radix(1000, 8, 0, 8, 0, false);
+	strollut_array_check_radix(1000, 8, 0, 8, 1000, false);
+	strollut_array_check_radix(1000, 8, 0, 4, 0, false);
+	strollut_array_check_radix(1000, 8, 2, 2, 16, false);
+}
+
+CUTE_TEST(strollut_array_radix_lsd_mem)
+{
+	strollut_array_check_radix(1000, 12, 1, 2, 0, false);
+	strollut_array_check_radix(1000, 12, 3, 4, 0, false);
+	strollut_array_check_radix(1000, 17, 5, 8, 0, false);
+	strollut_array_check_radix(1000, 17, 5, 8, 7, false);
+	strollut_array_check_radix(1000, 3, 0, 1, 0, false);
+}
+
+CUTE_TEST(strollut_array_radix_msd32)
+{
+	strollut_array_check_radix(3, 4, 0, 4, 0, true);
+	strollut_array_check_radix(5000, 4, 0, 4, 0, true);
+	strollut_array_check_radix(5000, 4, 0, 4, 100, true);
+	strollut_array_check_radix(5000, 4, 1, 2, 0, true);
+	strollut_array_check_radix(5000, 4, 3, 1, 0, true);
+}
+
+CUTE_TEST(strollut_array_radix_msd64)
+{
+	strollut_array_check_radix(5000, 8, 0, 8, 0, true);
+	strollut_array_check_radix(5000, 8, 0, 8, 1000, true);
+	strollut_array_check_radix(5000, 8, 0, 4, 0, true);
+	strollut_array_check_radix(5000, 8, 2, 2, 16, true);
+}
+
+CUTE_TEST(strollut_array_radix_msd_mem)
+{
+	strollut_array_check_radix(5000, 12, 1, 2, 0, true);
+	strollut_array_check_radix(5000, 12, 3, 4, 0, true);
+	strollut_array_check_radix(5000, 17, 5, 8, 0, true);
+	strollut_array_check_radix(5000, 17, 5, 8, 7, true);
+	strollut_array_check_radix(5000, 3, 0, 1, 0, true);
+}
+
+#else  /* !defined(CONFIG_STROLL_ARRAY_RADIX_SORT) */
+
+CUTE_TEST(strollut_array_radix_assert)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_radix_single)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_radix_lsd32)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_radix_lsd64)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_radix_lsd_mem)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_radix_msd32)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_radix_msd64)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_radix_msd_mem)
+{
+	cute_skip("support not compiled-in");
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_RADIX_SORT) */
+
+CUTE_GROUP(strollut_array_radix_group) = {
+	CUTE_REF(strollut_array_radix_assert),
+	CUTE_REF(strollut_array_radix_single),
+	CUTE_REF(strollut_array_radix_lsd32),
+	CUTE_REF(strollut_array_radix_lsd64),
+	CUTE_REF(strollut_array_radix_lsd_mem),
+	CUTE_REF(strollut_array_radix_msd32),
+	CUTE_REF(strollut_array_radix_msd64),
+	CUTE_REF(strollut_array_radix_msd_mem)
+};
+
+CUTE_SUITE_STATIC(strollut_array_radix_suite,
+                  strollut_array_radix_group,
+                  CUTE_NULL_SETUP,
+                  CUTE_NULL_TEARDOWN,
+                  CUTE_DFLT_TMOUT);
+
+/******************************************************************************
+ * Sorting networks tests
+ ******************************************************************************/
+
+#if defined(CONFIG_STROLL_ARRAY_SORTNET)
+
+#include <stdint.h>
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_array_sortnet_assert)
+{
+	uint32_t u32[STROLL_ARRAY_SORTNET_MAX + 1] = { 0, };
+	int32_t  s32[STROLL_ARRAY_SORTNET_MAX + 1] = { 0, };
+	uint64_t u64[STROLL_ARRAY_SORTNET_MAX + 1] = { 0, };
+
+	cute_expect_assertion(stroll_array_sortnet_u32(NULL, 4));
+	cute_expect_assertion(stroll_array_sortnet_u32(u32, 0));
+	cute_expect_assertion(
+		stroll_array_sortnet_u32(u32, STROLL_ARRAY_SORTNET_MAX + 1));
+
+	cute_expect_assertion(stroll_array_sortnet_s32(NULL, 4));
+	cute_expect_assertion(stroll_array_sortnet_s32(s32, 0));
+	cute_expect_assertion(
+		stroll_array_sortnet_s32(s32, STROLL_ARRAY_SORTNET_MAX + 1));
+
+	cute_expect_assertion(stroll_array_sortnet_u64(NULL, 4));
+	cute_expect_assertion(stroll_array_sortnet_u64(u64, 0));
+	cute_expect_assertion(
+		stroll_array_sortnet_u64(u64, STROLL_ARRAY_SORTNET_MAX + 1));
+}
+#else
+CUTE_TEST(strollut_array_sortnet_assert)
+{
+	cute_skip("assertion unsupported");
+}
+#endif
+
+static uint64_t strollut_array_sortnet_seed = UINT64_C(0x2545f4914f6cdd1d);
+
+/*
+ * Generate random keys. Restricting the range every other round allows to
+ * exercise duplicate keys while extreme values are injected to check
+ * comparisons are performed over the full integer range.
+ */
+static uint64_t
+strollut_array_sortnet_rand(unsigned int round)
+{
+	strollut_array_sortnet_seed ^= strollut_array_sortnet_seed << 13;
+	strollut_array_sortnet_seed ^= strollut_array_sortnet_seed >> 7;
+	strollut_array_sortnet_seed ^= strollut_array_sortnet_seed << 17;
+
+	switch (strollut_array_sortnet_seed % 11) {
+	case 0:
+		return 0;
+	case 1:
+		return UINT64_MAX;
+	case 2:
+		return UINT64_C(1) << 63;
+	case 3:
+		return UINT64_C(1) << 31;
+	default:
+		break;
+	}
+
+	if (round & 1)
+		return strollut_array_sortnet_seed % 7;
+
+	return strollut_array_sortnet_seed;
+}
+
+static int
+strollut_array_sortnet_cmp_u32(const void * first, const void * second)
+{
+	uint32_t fst = *(const uint32_t *)first;
+	uint32_t snd = *(const uint32_t *)second;
+
+	return (fst > snd) - (fst < snd);
+}
+
+static int
+strollut_array_sortnet_cmp_s32(const void * first, const void * second)
+{
+	int32_t fst = *(const int32_t *)first;
+	int32_t snd = *(const int32_t *)second;
+
+	return (fst > snd) - (fst < snd);
+}
+
+static int
+strollut_array_sortnet_cmp_u64(const void * first, const void * second)
+{
+	uint64_t fst = *(const uint64_t *)first;
+	uint64_t snd = *(const uint64_t *)second;
+
+	return (fst > snd) - (fst < snd);
+}
+
+#define STROLLUT_ARRAY_SORTNET_ROUNDS (8U)
+
+static void
+strollut_array_sortnet_check_u32(unsigned int nr)
+{
+	unsigned int r;
+
+	for (r = 0; r < STROLLUT_ARRAY_SORTNET_ROUNDS; r++) {
+		uint32_t     keys[STROLL_ARRAY_SORTNET_MAX];
+		uint32_t     ref[STROLL_ARRAY_SORTNET_MAX];
+		unsigned int n;
+
+		for (n = 0; n < nr; n++) {
+			keys[n] = (uint32_t)strollut_array_sortnet_rand(r);
+			ref[n] = keys[n];
+		}
+
+		qsort(ref, nr, sizeof(ref[0]), strollut_array_sortnet_cmp_u32);
+		stroll_array_sortnet_u32(keys, nr);
+
+		for (n = 0; n < nr; n++)
+			cute_check_uint(keys[n], equal, ref[n]);
+	}
+}
+
+static void
+strollut_array_sortnet_check_s32(unsigned int nr)
+{
+	unsigned int r;
+
+	for (r = 0; r < STROLLUT_ARRAY_SORTNET_ROUNDS; r++) {
+		int32_t      keys[STROLL_ARRAY_SORTNET_MAX];
+		int32_t      ref[STROLL_ARRAY_SORTNET_MAX];
+		unsigned int n;
+
+		for (n = 0; n < nr; n++) {
+			keys[n] = (int32_t)
+			          (uint32_t)strollut_array_sortnet_rand(r);
+			ref[n] = keys[n];
+		}
+
+		qsort(ref, nr, sizeof(ref[0]), strollut_array_sortnet_cmp_s32);
+		stroll_array_sortnet_s32(keys, nr);
+
+		for (n = 0; n < nr; n++)
+			cute_check_sint(keys[n], equal, ref[n]);
+	}
+}
+
+static void
+strollut_array_sortnet_check_u64(unsigned int nr)
+{
+	unsigned int r;
+
+	for (r = 0; r < STROLLUT_ARRAY_SORTNET_ROUNDS; r++) {
+		uint64_t     keys[STROLL_ARRAY_SORTNET_MAX];
+		uint64_t     ref[STROLL_ARRAY_SORTNET_MAX];
+		unsigned int n;
+
+		for (n = 0; n < nr; n++) {
+			keys[n] = strollut_array_sortnet_rand(r);
+			ref[n] = keys[n];
+		}
+
+		qsort(ref, nr, sizeof(ref[0]), strollut_array_sortnet_cmp_u64);
+		stroll_array_sortnet_u64(keys, nr);
+
+		for (n = 0; n < nr; n++)
+			cute_check_uint(keys[n], equal, ref[n]);
+	}
+}
+
+/*
+ * Run a check against all supported key counts using all sorting kernels the
+ * CPU supports.
+ */
+static void
+strollut_array_sortnet_check(void (* check)(unsigned int))
+{
+	enum stroll_array_isa orig = stroll_array_get_isa();
+	int                   isa;
+
+	cute_check_sint(orig, greater_equal, STROLL_ARRAY_SCALAR_ISA);
+	cute_check_sint(orig, lower, STROLL_ARRAY_ISA_NR);
+
+	for (isa = STROLL_ARRAY_SCALAR_ISA; isa < STROLL_ARRAY_ISA_NR; isa++) {
+		unsigned int nr;
+
+		if (stroll_array_select_isa((enum stroll_array_isa)isa)) {
+			/* Load time selection picks the most capable ISA. */
+			cute_check_sint(isa, greater, orig);
+			continue;
+		}
+
+		cute_check_sint(stroll_array_get_isa(), equal, isa);
+		for (nr = 1; nr <= STROLL_ARRAY_SORTNET_MAX; nr++)
+			check(nr);
+	}
+
+	cute_check_sint(stroll_array_select_isa(orig), equal, 0);
+}
+
+CUTE_TEST(strollut_array_sortnet_u32)
+{
+	strollut_array_sortnet_check(strollut_array_sortnet_check_u32);
+}
+
+CUTE_TEST(strollut_array_sortnet_s32)
+{
+	strollut_array_sortnet_check(strollut_array_sortnet_check_s32);
+}
+
+CUTE_TEST(strollut_array_sortnet_u64)
+{
+	strollut_array_sortnet_check(strollut_array_sortnet_check_u64);
+}
+
+#else  /* !defined(CONFIG_STROLL_ARRAY_SORTNET) */
+
+CUTE_TEST(strollut_array_sortnet_assert)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_sortnet_u32)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_sortnet_s32)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_sortnet_u64)
+{
+	cute_skip("support not compiled-in");
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_SORTNET) */
+
+CUTE_GROUP(strollut_array_sortnet_group) = {
+	CUTE_REF(strollut_array_sortnet_assert),
+	CUTE_REF(strollut_array_sortnet_u32),
+	CUTE_REF(strollut_array_sortnet_s32),
+	CUTE_REF(strollut_array_sortnet_u64)
+};
+
+CUTE_SUITE_STATIC(strollut_array_sortnet_suite,
+                  strollut_array_sortnet_group,
+                  CUTE_NULL_SETUP,
+                  CUTE_NULL_TEARDOWN,
+                  CUTE_DFLT_TMOUT);
+
+/******************************************************************************
+ * Vectorized quick sort tests
+ ******************************************************************************/
+
+#if defined(CONFIG_STROLL_ARRAY_VQUICK_SORT)
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_array_vquick_assert)
+{
+	uint32_t u32[4] = { 3, 2, 1, 0 };
+	uint64_t u64[4] = { 3, 2, 1, 0 };
+
+	cute_expect_assertion(stroll_array_sort_u32(NULL, 4));
+	cute_expect_assertion(stroll_array_sort_u32(u32, 0));
+
+	cute_expect_assertion(stroll_array_sort_u64(NULL, 4));
+	cute_expect_assertion(stroll_array_sort_u64(u64, 0));
+}
+#else
+CUTE_TEST(strollut_array_vquick_assert)
+{
+	cute_skip("assertion unsupported");
+}
+#endif
+
+/*
+ * Key counts exercising sorting networks only, scalar and vectorized
+ * partitioning with and without remaining keys, as well as deep recursions.
+ */
+static const unsigned int strollut_array_vquick_nr[] = {
+	1, 2, 31, 32, 33, 47, 64, 100, 127, 128, 129, 1000, 4097, 20000
+};
+
+enum strollut_array_vquick_pattern {
+	STROLLUT_ARRAY_VQUICK_RANDOM_PATTERN,
+	STROLLUT_ARRAY_VQUICK_DUPS_PATTERN,
+	STROLLUT_ARRAY_VQUICK_ASCEND_PATTERN,
+	STROLLUT_ARRAY_VQUICK_DESCEND_PATTERN,
+	STROLLUT_ARRAY_VQUICK_ORGAN_PATTERN,
+	STROLLUT_ARRAY_VQUICK_EQUAL_PATTERN,
+	STROLLUT_ARRAY_VQUICK_PATTERN_NR
+};
+
+static uint64_t
+strollut_array_vquick_key(enum strollut_array_vquick_pattern pattern,
+                          unsigned int                       index,
+                          unsigned int                       nr)
+{
+	switch (pattern) {
+	case STROLLUT_ARRAY_VQUICK_RANDOM_PATTERN:
+		return strollut_array_sortnet_rand(0);
+	case STROLLUT_ARRAY_VQUICK_DUPS_PATTERN:
+		return strollut_array_sortnet_rand(1);
+	case STROLLUT_ARRAY_VQUICK_ASCEND_PATTERN:
+		return index;
+	case STROLLUT_ARRAY_VQUICK_DESCEND_PATTERN:
+		return nr - index;
+	case STROLLUT_ARRAY_VQUICK_ORGAN_PATTERN:
+		return (index < (nr / 2)) ? index : nr - index;
+	default:
+		return 7;
+	}
+}
+
+static void
+strollut_array_vquick_check_u32(unsigned int nr)
+{
+	uint32_t * keys;
+	uint32_t * ref;
+	int        pat;
+
+	keys = malloc(nr * sizeof(keys[0]));
+	cute_check_ptr(keys, unequal, NULL);
+	ref = malloc(nr * sizeof(ref[0]));
+	cute_check_ptr(ref, unequal, NULL);
+
+	for (pat = 0; pat < STROLLUT_ARRAY_VQUICK_PATTERN_NR; pat++) {
+		unsigned int n;
+
+		for (n = 0; n < nr; n++) {
+			keys[n] = (uint32_t)strollut_array_vquick_key(
+				(enum strollut_array_vquick_pattern)pat,
+				n,
+				nr);
+			ref[n] = keys[n];
+		}
+
+		qsort(ref, nr, sizeof(ref[0]), strollut_array_sortnet_cmp_u32);
+		stroll_array_sort_u32(keys, nr);
+
+		for (n = 0; n < nr; n++)
+			cute_check_uint(keys[n], equal, ref[n]);
+	}
+
+	free(ref);
+	free(keys);
+}
+
+static void
+strollut_array_vquick_check_u64(unsigned int nr)
+{
+	uint64_t * keys;
+	uint64_t * ref;
+	int        pat;
+
+	keys = malloc(nr * sizeof(keys[0]));
+	cute_check_ptr(keys, unequal, NULL);
+	ref = malloc(nr * sizeof(ref[0]));
+	cute_check_ptr(ref, unequal, NULL);
+
+	for (pat = 0; pat < STROLLUT_ARRAY_VQUICK_PATTERN_NR; pat++) {
+		unsigned int n;
+
+		for (n = 0; n < nr; n++) {
+			keys[n] = strollut_array_vquick_key(
+				(enum strollut_array_vquick_pattern)pat,
+				n,
+				nr);
+			ref[n] = keys[n];
+		}
+
+		qsort(ref, nr, sizeof(ref[0]), strollut_array_sortnet_cmp_u64);
+		stroll_array_sort_u64(keys, nr);
+
+		for (n = 0; n < nr; n++)
+			cute_check_uint(keys[n], equal, ref[n]);
+	}
+
+	free(ref);
+	free(keys);
+}
+
+/*
+ * Run a check against all key counts of strollut_array_vquick_nr using all
+ * sorting kernels the CPU supports.
+ */
+static void
+strollut_array_vquick_check(void (* check)(unsigned int))
+{
+	enum stroll_array_isa orig = stroll_array_get_isa();
+	int                   isa;
+
+	for (isa = STROLL_ARRAY_SCALAR_ISA; isa < STROLL_ARRAY_ISA_NR; isa++) {
+		unsigned int n;
+
+		if (stroll_array_select_isa((enum stroll_array_isa)isa))
+			continue;
+
+		for (n = 0; n < stroll_array_nr(strollut_array_vquick_nr); n++)
+			check(strollut_array_vquick_nr[n]);
+	}
+
+	cute_check_sint(stroll_array_select_isa(orig), equal, 0);
+}
+
+CUTE_TEST(strollut_array_vquick_u32)
+{
+	strollut_array_vquick_check(strollut_array_vquick_check_u32);
+}
+
+CUTE_TEST(strollut_array_vquick_u64)
+{
+	strollut_array_vquick_check(strollut_array_vquick_check_u64);
+}
+
+#else  /* !defined(CONFIG_STROLL_ARRAY_VQUICK_SORT) */
+
+CUTE_TEST(strollut_array_vquick_assert)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_vquick_u32)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_vquick_u64)
+{
+	cute_skip("support not compiled-in");
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_VQUICK_SORT) */
+
+CUTE_GROUP(strollut_array_vquick_group) = {
+	CUTE_REF(strollut_array_vquick_assert),
+	CUTE_REF(strollut_array_vquick_u32),
+	CUTE_REF(strollut_array_vquick_u64)
+};
+
+CUTE_SUITE_STATIC(strollut_array_vquick_suite,
+                  strollut_array_vquick_group,
+                  CUTE_NULL_SETUP,
+                  CUTE_NULL_TEARDOWN,
+                  CUTE_DFLT_TMOUT);
+
+/******************************************************************************
+ * Multi-threaded merge sort tests
+ ******************************************************************************/
+
+#if defined(CONFIG_STROLL_ARRAY_MERGE_SORT_MT)
+
+#include <stdint.h>
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_array_merge_mt_assert)
+{
+	int array[4] = { 3, 2, 1, 0 };
+	int ret __unused;
+
+	cute_expect_assertion(
+		ret = stroll_array_merge_sort_mt(NULL,
+		                                 4,
+		                                 sizeof(array[0]),
+		                                 strollut_array_compare_min,
+		                                 NULL,
+		                                 2));
+	cute_expect_assertion(
+		ret = stroll_array_merge_sort_mt(array,
+		                                 0,
+		                                 sizeof(array[0]),
+		                                 strollut_array_compare_min,
+		                                 NULL,
+		                                 2));
+	cute_expect_assertion(
+		ret = stroll_array_merge_sort_mt(array,
+		                                 4,
+		                                 0,
+		                                 strollut_array_compare_min,
+		                                 NULL,
+		                                 2));
+	cute_expect_assertion(
+		ret = stroll_array_merge_sort_mt(array,
+		                                 4,
+		                                 sizeof(array[0]),
+		                                 NULL,
+		                                 NULL,
+		                                 2));
+}
+#else
+CUTE_TEST(strollut_array_merge_mt_assert)
+{
+	cute_skip("assertion unsupported");
+}
+#endif
+
+/*
+ * Element counts exercising single threaded fallback as well as multi-threaded
+ * sorting with chunks of unequal lengths.
+ */
+static const unsigned int strollut_array_merge_mt_nr[] = {
+	1, 2, 1000, 16384, 100003
+};
+
+/* Thread counts, 0 meaning all online CPUs. */
+static const unsigned int strollut_array_merge_mt_thr[] = {
+	1, 2, 3, 5, 8, 0
+};
+
+enum strollut_array_merge_mt_pattern {
+	STROLLUT_ARRAY_MERGE_MT_RANDOM_PATTERN,
+	STROLLUT_ARRAY_MERGE_MT_DUPS_PATTERN,
+	STROLLUT_ARRAY_MERGE_MT_ASCEND_PATTERN,
+	STROLLUT_ARRAY_MERGE_MT_DESCEND_PATTERN,
+	STROLLUT_ARRAY_MERGE_MT_PATTERN_NR
+};
+
+static uint64_t strollut_array_merge_mt_seed = UINT64_C(0x9e3779b97f4a7c15);
+
+/*
+ * Return a sort key in the [0, 4096[ range. Keys are meant to be combined with
+ * their original element index so that stability may be checked.
+ */
+static uint32_t
+strollut_array_merge_mt_key(enum strollut_array_merge_mt_pattern pattern,
+                            unsigned int                         index,
+                            unsigned int                         nr)
+{
+	strollut_array_merge_mt_seed ^= strollut_array_merge_mt_seed << 13;
+	strollut_array_merge_mt_seed ^= strollut_array_merge_mt_seed >> 7;
+	strollut_array_merge_mt_seed ^= strollut_array_merge_mt_seed << 17;
+
+	switch (pattern) {
+	case STROLLUT_ARRAY_MERGE_MT_RANDOM_PATTERN:
+		return (uint32_t)(strollut_array_merge_mt_seed % 4096);
+	case STROLLUT_ARRAY_MERGE_MT_DUPS_PATTERN:
+		return (uint32_t)(strollut_array_merge_mt_seed % 5);
+	case STROLLUT_ARRAY_MERGE_MT_ASCEND_PATTERN:
+		return (uint32_t)(((unsigned long long)index * 4096) / nr);
+	default:
+		return (uint32_t)
+		       (((unsigned long long)(nr - 1 - index) * 4096) / nr);
+	}
+}
+
+/*
+ * 32-bit elements: sort key is stored into the 12 most significant bits while
+ * the original index is stored into the 20 least significant ones.
+ */
+static int
+strollut_array_merge_mt_cmp32(const void * __restrict first,
+                              const void * __restrict second,
+                              void *                  data __unused)
+{
+	uint32_t fst = *(const uint32_t *)first >> 20;
+	uint32_t snd = *(const uint32_t *)second >> 20;
+
+	return (fst > snd) - (fst < snd);
+}
+
+/*
+ * 64-bit elements: sort key is stored into the 32 most significant bits while
+ * the original index is stored into the 32 least significant ones.
+ */
+static int
+strollut_array_merge_mt_cmp64(const void * __restrict first,
+                              const void * __restrict second,
+                              void *                  data __unused)
+{
+	uint64_t fst = *(const uint64_t *)first >> 32;
+	uint64_t snd = *(const uint64_t *)second >> 32;
+
+	return (fst > snd) - (fst < snd);
+}
+
+/* Elements which size forces the use of the generic merging process. */
+struct strollut_array_merge_mt_elem {
+	uint32_t key;
+	uint32_t index;
+	uint32_t pad;
+};
+
+static int
+strollut_array_merge_mt_cmp_mem(const void * __restrict first,
+                                const void * __restrict second,
+                                void *                  data __unused)
+{
+	const struct strollut_array_merge_mt_elem * fst = first;
+	const struct strollut_array_merge_mt_elem * snd = second;
+
+	return (fst->key > snd->key) - (fst->key < snd->key);
+}
+
+static void
+strollut_array_merge_mt_check32(unsigned int nr,
+                                unsigned int nthreads,
+                                int          pattern)
+{
+	uint32_t *   array;
+	unsigned int n;
+
+	array = malloc(nr * sizeof(array[0]));
+	cute_check_ptr(array, unequal, NULL);
+
+	for (n = 0; n < nr; n++)
+		array[n] = (strollut_array_merge_mt_key(
+				(enum strollut_array_merge_mt_pattern)pattern,
+				n,
+				nr) << 20) | n;
+
+	cute_check_sint(stroll_array_merge_sort_mt(
+				array,
+				nr,
+				sizeof(array[0]),
+				strollut_array_merge_mt_cmp32,
+				NULL,
+				nthreads),
+	                equal,
+	                0);
+
+	/* Stable sorting implies that full values are strictly ascending. */
+	for (n = 1; n < nr; n++)
+		cute_check_uint(array[n - 1], lower, array[n]);
+
+	free(array);
+}
+
+static void
+strollut_array_merge_mt_check64(unsigned int nr,
+                                unsigned int nthreads,
+                                int          pattern)
+{
+	uint64_t *   array;
+	unsigned int n;
+
+	array = malloc(nr * sizeof(array[0]));
+	cute_check_ptr(array, unequal, NULL);
+
+	for (n = 0; n < nr; n++)
+		array[n] = ((uint64_t)strollut_array_merge_mt_key(
+				(enum strollut_array_merge_mt_pattern)pattern,
+				n,
+				nr) << 32) | n;
+
+	cute_check_sint(stroll_array_merge_sort_mt(
+				array,
+				nr,
+				sizeof(array[0]),
+				strollut_array_merge_mt_cmp64,
+				NULL,
+				nthreads),
+	                equal,
+	                0);
+
+	for (n = 1; n < nr; n++)
+		cute_check_uint(array[n - 1], lower, array[n]);
+
+	free(array);
+}
+
+static void
+strollut_array_merge_mt_check_mem(unsigned int nr,
+                                  unsigned int nthreads,
+                                  int          pattern)
+{
+	struct strollut_array_merge_mt_elem * array;
+	unsigned int                          n;
+
+	array = malloc(nr * sizeof(array[0]));
+	cute_check_ptr(array, unequal, NULL);
+
+	for (n = 0; n < nr; n++) {
+		array[n].key = strollut_array_merge_mt_key(
+			(enum strollut_array_merge_mt_pattern)pattern,
+			n,
+			nr);
+		array[n].index = n;
+		array[n].pad = ~n;
+	}
+
+	cute_check_sint(stroll_array_merge_sort_mt(
+				array,
+				nr,
+				sizeof(array[0]),
+				strollut_array_merge_mt_cmp_mem,
+				NULL,
+				nthreads),
+	                equal,
+	                0);
+
+	for (n = 1; n < nr; n++) {
+		cute_check_uint(array[n - 1].key, lower_equal, array[n].key);
+		if (array[n - 1].key == array[n].key)
+			cute_check_uint(array[n - 1].index,
+			                lower,
+			                array[n].index);
+		cute_check_uint(array[n].pad, equal, ~array[n].index);
+	}
+
+	free(array);
+}
+
+/*
+ * Run a check against all element counts of strollut_array_merge_mt_nr using
+ * all thread counts of strollut_array_merge_mt_thr and all patterns.
+ */
+static void
+strollut_array_merge_mt_check(void (* check)(unsigned int,
+                                             unsigned int,
+                                             int))
+{
+	unsigned int thr_nr = stroll_array_nr(strollut_array_merge_mt_thr);
+	unsigned int n;
+
+	for (n = 0; n < stroll_array_nr(strollut_array_merge_mt_nr); n++) {
+		unsigned int t;
+
+		for (t = 0; t < thr_nr; t++) {
+			int pat;
+
+			for (pat = 0;
+			     pat < STROLLUT_ARRAY_MERGE_MT_PATTERN_NR;
+			     pat++)
+				check(strollut_array_merge_mt_nr[n],
+				      strollut_array_merge_mt_thr[t],
+				      pat);
+		}
+	}
+}
+
+CUTE_TEST(strollut_array_merge_mt_32)
+{
+	strollut_array_merge_mt_check(strollut_array_merge_mt_check32);
+}
+
+CUTE_TEST(strollut_array_merge_mt_64)
+{
+	strollut_array_merge_mt_check(strollut_array_merge_mt_check64);
+}
+
+CUTE_TEST(strollut_array_merge_mt_mem)
+{
+	strollut_array_merge_mt_check(strollut_array_merge_mt_check_mem);
+}
+
+#else  /* !defined(CONFIG_STROLL_ARRAY_MERGE_SORT_MT) */
+
+CUTE_TEST(strollut_array_merge_mt_assert)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_merge_mt_32)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_merge_mt_64)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_merge_mt_mem)
+{
+	cute_skip("support not compiled-in");
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_MERGE_SORT_MT) */
+
+CUTE_GROUP(strollut_array_merge_mt_group) = {
+	CUTE_REF(strollut_array_merge_mt_assert),
+	CUTE_REF(strollut_array_merge_mt_32),
+	CUTE_REF(strollut_array_merge_mt_64),
+	CUTE_REF(strollut_array_merge_mt_mem)
+};
+
+CUTE_SUITE_STATIC(strollut_array_merge_mt_suite,
+                  strollut_array_merge_mt_group,
+                  CUTE_NULL_SETUP,
+                  CUTE_NULL_TEARDOWN,
+                  CUTE_DFLT_TMOUT);
+
+/******************************************************************************
+ * Multi-threaded sample sort tests
+ ******************************************************************************/
+
+#if defined(CONFIG_STROLL_ARRAY_SAMPLE_SORT_MT)
+
+#include <stdint.h>
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_array_sample_mt_assert)
+{
+	int array[4] = { 3, 2, 1, 0 };
+	int ret __unused;
+
+	cute_expect_assertion(
+		ret = stroll_array_sample_sort_mt(NULL,
+		                                  4,
+		                                  sizeof(array[0]),
+		                                  strollut_array_compare_min,
+		                                  NULL,
+		                                  2));
+	cute_expect_assertion(
+		ret = stroll_array_sample_sort_mt(array,
+		                                  0,
+		                                  sizeof(array[0]),
+		                                  strollut_array_compare_min,
+		                                  NULL,
+		                                  2));
+	cute_expect_assertion(
+		ret = stroll_array_sample_sort_mt(array,
+		                                  4,
+		                                  0,
+		                                  strollut_array_compare_min,
+		                                  NULL,
+		                                  2));
+	cute_expect_assertion(
+		ret = stroll_array_sample_sort_mt(array,
+		                                  4,
+		                                  sizeof(array[0]),
+		                                  NULL,
+		                                  NULL,
+		                                  2));
+}
+#else
+CUTE_TEST(strollut_array_sample_mt_assert)
+{
+	cute_skip("assertion unsupported");
+}
+#endif
+
+/*
+ * Element counts exercising single threaded fallback as well as multi-threaded
+ * sorting with chunks of unequal lengths.
+ */
+static const unsigned int strollut_array_sample_mt_nr[] = {
+	1, 2, 1000, 16384, 100003
+};
+
+/* Thread counts, 0 meaning all online CPUs. */
+static const unsigned int strollut_array_sample_mt_thr[] = {
+	1, 2, 3, 5, 8, 0
+};
+
+enum strollut_array_sample_mt_pattern {
+	STROLLUT_ARRAY_SAMPLE_MT_RANDOM_PATTERN,
+	STROLLUT_ARRAY_SAMPLE_MT_DUPS_PATTERN,
+	STROLLUT_ARRAY_SAMPLE_MT_ASCEND_PATTERN,
+	STROLLUT_ARRAY_SAMPLE_MT_DESCEND_PATTERN,
+	STROLLUT_ARRAY_SAMPLE_MT_EQUAL_PATTERN,
+	STROLLUT_ARRAY_SAMPLE_MT_PATTERN_NR
+};
+
+static uint64_t strollut_array_sample_mt_seed = UINT64_C(0x2545f4914f6cdd1d);
+
+static uint64_t
+strollut_array_sample_mt_key(enum strollut_array_sample_mt_pattern pattern,
+                             unsigned int                          index,
+                             unsigned int                          nr)
+{
+	strollut_array_sample_mt_seed ^= strollut_array_sample_mt_seed << 13;
+	strollut_array_sample_mt_seed ^= strollut_array_sample_mt_seed >> 7;
+	strollut_array_sample_mt_seed ^= strollut_array_sample_mt_seed << 17;
+
+	switch (pattern) {
+	case STROLLUT_ARRAY_SAMPLE_MT_RANDOM_PATTERN:
+		return strollut_array_sample_mt_seed;
+	case STROLLUT_ARRAY_SAMPLE_MT_DUPS_PATTERN:
+		return strollut_array_sample_mt_seed % 7;
+	case STROLLUT_ARRAY_SAMPLE_MT_ASCEND_PATTERN:
+		return index;
+	case STROLLUT_ARRAY_SAMPLE_MT_DESCEND_PATTERN:
+		return nr - index;
+	default:
+		return 3;
+	}
+}
+
+static int
+strollut_array_sample_mt_cmp32(const void * __restrict first,
+                               const void * __restrict second,
+                               void *                  data __unused)
+{
+	uint32_t fst = *(const uint32_t *)first;
+	uint32_t snd = *(const uint32_t *)second;
+
+	return (fst > snd) - (fst < snd);
+}
+
+static int
+strollut_array_sample_mt_qsort_cmp32(const void * first, const void * second)
+{
+	return strollut_array_sample_mt_cmp32(first, second, NULL);
+}
+
+static int
+strollut_array_sample_mt_cmp64(const void * __restrict first,
+                               const void * __restrict second,
+                               void *                  data __unused)
+{
+	uint64_t fst = *(const uint64_t *)first;
+	uint64_t snd = *(const uint64_t *)second;
+
+	return (fst > snd) - (fst < snd);
+}
+
+static int
+strollut_array_sample_mt_qsort_cmp64(const void * first, const void * second)
+{
+	return strollut_array_sample_mt_cmp64(first, second, NULL);
+}
+
+/* Elements which size forces the use of the generic sorting process. */
+struct strollut_array_sample_mt_elem {
+	uint32_t key;
+	uint32_t pad[2];
+};
+
+static int
+strollut_array_sample_mt_cmp_mem(const void * __restrict first,
+                                 const void * __restrict second,
+                                 void *                  data __unused)
+{
+	const struct strollut_array_sample_mt_elem * fst = first;
+	const struct strollut_array_sample_mt_elem * snd = second;
+
+	return (fst->key > snd->key) - (fst->key < snd->key);
+}
+
+static void
+strollut_array_sample_mt_check32(unsigned int nr,
+                                 unsigned int nthreads,
+                                 int          pattern)
+{
+	uint32_t *   array;
+	uint32_t *   ref;
+	unsigned int n;
+
+	array = malloc(nr * sizeof(array[0]));
+	cute_check_ptr(array, unequal, NULL);
+	ref = malloc(nr * sizeof(ref[0]));
+	cute_check_ptr(ref, unequal, NULL);
+
+	for (n = 0; n < nr; n++) {
+		array[n] = (uint32_t)strollut_array_sample_mt_key(
+			(enum strollut_array_sample_mt_pattern)pattern,
+			n,
+			nr);
+		ref[n] = array[n];
+	}
+
+	qsort(ref, nr, sizeof(ref[0]), strollut_array_sample_mt_qsort_cmp32);
+	cute_check_sint(stroll_array_sample_sort_mt(
+				array,
+				nr,
+				sizeof(array[0]),
+				strollut_array_sample_mt_cmp32,
+				NULL,
+				nthreads),
+	                equal,
+	                0);
+
+	for (n = 0; n < nr; n++)
+		cute_check_uint(array[n], equal, ref[n]);
+
+	free(ref);
+	free(array);
+}
+
+static void
+strollut_array_sample_mt_check64(unsigned int nr,
+                                 unsigned int nthreads,
+                                 int          pattern)
+{
+	uint64_t *   array;
+	uint64_t *   ref;
+	unsigned int n;
+
+	array = malloc(nr * sizeof(array[0]));
+	cute_check_ptr(array, unequal, NULL);
+	ref = malloc(nr * sizeof(ref[0]));
+	cute_check_ptr(ref, unequal, NULL);
+
+	for (n = 0; n < nr; n++) {
+		array[n] = strollut_array_sample_mt_key(
+			(enum strollut_array_sample_mt_pattern)pattern,
+			n,
+			nr);
+		ref[n] = array[n];
+	}
+
+	qsort(ref, nr, sizeof(ref[0]), strollut_array_sample_mt_qsort_cmp64);
+	cute_check_sint(stroll_array_sample_sort_mt(
+				array,
+				nr,
+				sizeof(array[0]),
+				strollut_array_sample_mt_cmp64,
+				NULL,
+				nthreads),
+	                equal,
+	                0);
+
+	for (n = 0; n < nr; n++)
+		cute_check_uint(array[n], equal, ref[n]);
+
+	free(ref);
+	free(array);
+}
+
+static void
+strollut_array_sample_mt_check_mem(unsigned int nr,
+                                   unsigned int nthreads,
+                                   int          pattern)
+{
+	struct strollut_array_sample_mt_elem * array;
+	unsigned long long                     sum = 0;
+	unsigned int                           n;
+
+	array = malloc(nr * sizeof(array[0]));
+	cute_check_ptr(array, unequal, NULL);
+
+	for (n = 0; n < nr; n++) {
+		array[n].key = (uint32_t)strollut_array_sample_mt_key(
+			(enum strollut_array_sample_mt_pattern)pattern,
+			n,
+			nr);
+		array[n].pad[0] = array[n].key;
+		array[n].pad[1] = ~array[n].key;
+		sum += array[n].key;
+	}
+
+	cute_check_sint(stroll_array_sample_sort_mt(
+				array,
+				nr,
+				sizeof(array[0]),
+				strollut_array_sample_mt_cmp_mem,
+				NULL,
+				nthreads),
+	                equal,
+	                0);
+
+	/*
+	 * Make sure elements are sorted and have been moved as a whole without
+	 * any loss.
+	 */
+	for (n = 0; n < nr; n++) {
+		if (n)
+			cute_check_uint(array[n - 1].key,
+			                lower_equal,
+			                array[n].key);
+		cute_check_uint(array[n].pad[0], equal, array[n].key);
+		cute_check_uint(array[n].pad[1], equal, ~array[n].key);
+		sum -= array[n].key;
+	}
+	cute_check_uint(sum, equal, 0);
+
+	free(array);
+}
+
+/*
+ * Run a check against all element counts of strollut_array_sample_mt_nr
+ * using all thread counts of strollut_array_sample_mt_thr and all patterns.
+ */
+static void
+strollut_array_sample_mt_check(void (* check)(unsigned int,
+                                              unsigned int,
+                                              int))
+{
+	unsigned int thr_nr = stroll_array_nr(strollut_array_sample_mt_thr);
+	unsigned int n;
+
+	for (n = 0; n < stroll_array_nr(strollut_array_sample_mt_nr); n++) {
+		unsigned int t;
+
+		for (t = 0; t < thr_nr; t++) {
+			int pat;
+
+			for (pat = 0;
+			     pat < STROLLUT_ARRAY_SAMPLE_MT_PATTERN_NR;
+			     pat++)
+				check(strollut_array_sample_mt_nr[n],
+				      strollut_array_sample_mt_thr[t],
+				      pat);
+		}
+	}
+}
+
+CUTE_TEST(strollut_array_sample_mt_32)
+{
+	strollut_array_sample_mt_check(strollut_array_sample_mt_check32);
+}
+
+CUTE_TEST(strollut_array_sample_mt_64)
+{
+	strollut_array_sample_mt_check(strollut_array_sample_mt_check64);
+}
+
+CUTE_TEST(strollut_array_sample_mt_mem)
+{
+	strollut_array_sample_mt_check(strollut_array_sample_mt_check_mem);
+}
+
+#else  /* !defined(CONFIG_STROLL_ARRAY_SAMPLE_SORT_MT) */
+
+CUTE_TEST(strollut_array_sample_mt_assert)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_sample_mt_32)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_sample_mt_64)
+{
+	cute_skip("support not compiled-in");
+}
+
+CUTE_TEST(strollut_array_sample_mt_mem)
+{
+	cute_skip("support not compiled-in");
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_SAMPLE_SORT_MT) */
+
+CUTE_GROUP(strollut_array_sample_mt_group) = {
+	CUTE_REF(strollut_array_sample_mt_assert),
+	CUTE_REF(strollut_array_sample_mt_32),
+	CUTE_REF(strollut_array_sample_mt_64),
+	CUTE_REF(strollut_array_sample_mt_mem)
+};
+
+CUTE_SUITE_STATIC(strollut_array_sample_mt_suite,
+                  strollut_array_sample_mt_group,
+                  CUTE_NULL_SETUP,
+                  CUTE_NULL_TEARDOWN,
+                  CUTE_DFLT_TMOUT);
+
 CUTE_GROUP(strollut_array_group) = {
 	CUTE_REF(strollut_array_bisect_suite),
 	CUTE_REF(strollut_array_bubble_suite),
@@ -1238,9 +3559,21 @@ CUTE_GROUP(strollut_array_group) = {
 	CUTE_REF(strollut_array_insert_suite),
 	CUTE_REF(strollut_array_quick_suite),
 	CUTE_REF(strollut_array_3wquick_suite),
+	CUTE_REF(strollut_array_pdquick_suite),
 	CUTE_REF(strollut_array_merge_suite),
+	CUTE_REF(strollut_array_merge_scratch_suite),
+	CUTE_REF(strollut_array_inpmerge_suite),
+	CUTE_REF(strollut_array_power_suite),
 	CUTE_REF(strollut_array_fbheap_suite),
-	CUTE_REF(strollut_array_fwheap_suite)
+	CUTE_REF(strollut_array_fwheap_suite),
+	CUTE_REF(strollut_array_fwheap_scratch_suite),
+	CUTE_REF(strollut_array_indirect_suite),
+	CUTE_REF(strollut_array_permute_suite),
+	CUTE_REF(strollut_array_radix_suite),
+	CUTE_REF(strollut_array_sortnet_suite),
+	CUTE_REF(strollut_array_vquick_suite),
+	CUTE_REF(strollut_array_merge_mt_suite),
+	CUTE_REF(strollut_array_sample_mt_suite)
 };
 
 CUTE_SUITE_EXTERN(strollut_array_suite,
@@ -0,0 +1,467 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#include "utest.h"
+#include "stroll/bloom.h"
+#include "stroll/hash.h"
+#include <cute/cute.h>
+#include <cute/check.h>
+#include <cute/expect.h>
+
+#define STROLLUT_BLOOM_NOASSERT(_test) \
+	CUTE_TEST(_test) { cute_skip("assertion unsupported"); }
+
+#define STROLLUT_BLOOM_KEY_NR   (4096U)
+#define STROLLUT_BLOOM_QUERY_NR (65536U)
+
+static struct stroll_bloom strollut_bloom;
+static struct stroll_bloom strollut_bloom_other;
+static bool                strollut_bloom_tofree;
+static bool                strollut_bloom_other_tofree;
+
+/* Generate distinct 64-bit keys spread over the whole key space. */
+static uint64_t
+strollut_bloom_key(unsigned int index)
+{
+	return stroll_hash_mix64((uint64_t)index *
+	                         UINT64_C(0x9e3779b97f4a7c15));
+}
+
+/*
+ * Generate strided keys sharing their low order bits, such as addresses of
+ * aligned memory areas.
+ */
+static uint64_t
+strollut_bloom_stride_key(unsigned int index)
+{
+	return (uint64_t)index << 16;
+}
+
+static void
+strollut_bloom_setup(void)
+{
+	strollut_bloom_tofree = false;
+	strollut_bloom_other_tofree = false;
+}
+
+static void
+strollut_bloom_teardown(void)
+{
+	if (strollut_bloom_tofree) {
+		stroll_bloom_fini(&strollut_bloom);
+		strollut_bloom_tofree = false;
+	}
+	if (strollut_bloom_other_tofree) {
+		stroll_bloom_fini(&strollut_bloom_other);
+		strollut_bloom_other_tofree = false;
+	}
+}
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_bloom_init_assert)
+{
+	int err __unused;
+
+	cute_expect_assertion(err = stroll_bloom_init(NULL, 1, 0.01));
+	cute_expect_assertion(err = stroll_bloom_init(&strollut_bloom,
+	                                              0,
+	                                              0.01));
+	cute_expect_assertion(err = stroll_bloom_init(&strollut_bloom, 1, 0.0));
+	cute_expect_assertion(err = stroll_bloom_init(&strollut_bloom, 1, 1.0));
+
+	cute_expect_assertion(err = stroll_bloom_init_blocked(NULL, 1, 0.01));
+	cute_expect_assertion(err = stroll_bloom_init_blocked(&strollut_bloom,
+	                                                      0,
+	                                                      0.01));
+	cute_expect_assertion(err = stroll_bloom_init_blocked(&strollut_bloom,
+	                                                      1,
+	                                                      0.0));
+	cute_expect_assertion(err = stroll_bloom_init_blocked(&strollut_bloom,
+	                                                      1,
+	                                                      1.0));
+}
+#else
+STROLLUT_BLOOM_NOASSERT(strollut_bloom_init_assert)
+#endif
+
+CUTE_TEST(strollut_bloom_init_range)
+{
+	cute_check_sint(stroll_bloom_init(&strollut_bloom, UINT_MAX, 1e-9),
+	                equal,
+	                -ERANGE);
+	cute_check_sint(stroll_bloom_init_blocked(&strollut_bloom,
+	                                          UINT_MAX,
+	                                          1e-9),
+	                equal,
+	                -ERANGE);
+}
+
+CUTE_TEST(strollut_bloom_init_std)
+{
+	cute_check_sint(stroll_bloom_init(&strollut_bloom, 1000, 0.01),
+	                equal,
+	                0);
+	strollut_bloom_tofree = true;
+
+	/* -1000 * ln(0.01) / ln(2)^2 rounded up. */
+	cute_check_uint(stroll_bloom_bit_nr(&strollut_bloom), equal, 9586);
+	/* 9586 / 1000 * ln(2) rounded to nearest. */
+	cute_check_uint(stroll_bloom_hash_nr(&strollut_bloom), equal, 7);
+	cute_check_bool(stroll_bloom_is_blocked(&strollut_bloom), is, false);
+	cute_check_bool(stroll_fbmap_test_all(&strollut_bloom.map), is, false);
+}
+
+CUTE_TEST(strollut_bloom_init_blocked)
+{
+	cute_check_sint(stroll_bloom_init_blocked(&strollut_bloom, 1000, 0.01),
+	                equal,
+	                0);
+	strollut_bloom_tofree = true;
+
+	/*
+	 * 9586 bits of the equivalent standard filter grown until the blocked
+	 * filter model meets the requested false positive rate.
+	 */
+	cute_check_uint(stroll_bloom_bit_nr(&strollut_bloom),
+	                equal,
+	                20 * STROLL_BLOOM_BLOCK_BITS);
+	cute_check_uint(stroll_bloom_hash_nr(&strollut_bloom), equal, 7);
+	cute_check_bool(stroll_bloom_is_blocked(&strollut_bloom), is, true);
+	cute_check_uint((unsigned long)strollut_bloom.map.bits %
+	                (STROLL_BLOOM_BLOCK_BITS / CHAR_BIT),
+	                equal,
+	                0);
+	cute_check_bool(stroll_fbmap_test_all(&strollut_bloom.map), is, false);
+}
+
+static void
+strollut_bloom_check_insert(double       fpr,
+                            double       max_fpr,
+                            unsigned int query_nr,
+                            uint64_t  (* key)(unsigned int))
+{
+	unsigned int k;
+	unsigned int fp = 0;
+
+	for (k = 0; k < STROLLUT_BLOOM_KEY_NR; k++)
+		stroll_bloom_insert(&strollut_bloom, key(k));
+
+	/* Bloom filters MUST NOT generate false negatives. */
+	for (k = 0; k < STROLLUT_BLOOM_KEY_NR; k++)
+		cute_check_bool(stroll_bloom_test(&strollut_bloom, key(k)),
+		                is,
+		                true);
+
+	/* Measure false positive rate using keys that were never inserted. */
+	for (k = 0; k < query_nr; k++)
+		fp += stroll_bloom_test(&strollut_bloom,
+		                        key(STROLLUT_BLOOM_KEY_NR + k));
+
+	cute_check_uint(fp,
+	                lower_equal,
+	                (unsigned int)(max_fpr * fpr * (double)query_nr));
+}
+
+CUTE_TEST(strollut_bloom_insert_std)
+{
+	cute_check_sint(stroll_bloom_init(&strollut_bloom,
+	                                  STROLLUT_BLOOM_KEY_NR,
+	                                  0.01),
+	                equal,
+	                0);
+	strollut_bloom_tofree = true;
+
+	strollut_bloom_check_insert(0.01, 1.5, STROLLUT_BLOOM_QUERY_NR,
+	                            strollut_bloom_key);
+}
+
+/*
+ * Strided keys MUST meet the requested false positive rate as well, which
+ * requires mixing all key bits before deriving bit indices.
+ */
+CUTE_TEST(strollut_bloom_insert_std_stride)
+{
+	cute_check_sint(stroll_bloom_init(&strollut_bloom,
+	                                  STROLLUT_BLOOM_KEY_NR,
+	                                  0.01),
+	                equal,
+	                0);
+	strollut_bloom_tofree = true;
+
+	strollut_bloom_check_insert(0.01, 1.2, 1U << 20,
+	                            strollut_bloom_stride_key);
+}
+
+CUTE_TEST(strollut_bloom_insert_blocked)
+{
+	cute_check_sint(stroll_bloom_init_blocked(&strollut_bloom,
+	                                          STROLLUT_BLOOM_KEY_NR,
+	                                          0.01),
+	                equal,
+	                0);
+	strollut_bloom_tofree = true;
+
+	strollut_bloom_check_insert(0.01, 1.5, STROLLUT_BLOOM_QUERY_NR,
+	                            strollut_bloom_key);
+}
+
+/*
+ * Blocked filters sized using the standard Bloom filter formula miss low false
+ * positive rates by a large factor. Query enough keys so that the measured rate
+ * is significant.
+ */
+CUTE_TEST(strollut_bloom_insert_blocked_1e3)
+{
+	cute_check_sint(stroll_bloom_init_blocked(&strollut_bloom,
+	                                          STROLLUT_BLOOM_KEY_NR,
+	                                          1e-3),
+	                equal,
+	                0);
+	strollut_bloom_tofree = true;
+
+	strollut_bloom_check_insert(1e-3, 1.5, 1U << 20,
+	                            strollut_bloom_key);
+}
+
+CUTE_TEST(strollut_bloom_insert_blocked_1e4)
+{
+	cute_check_sint(stroll_bloom_init_blocked(&strollut_bloom,
+	                                          STROLLUT_BLOOM_KEY_NR,
+	                                          1e-4),
+	                equal,
+	                0);
+	strollut_bloom_tofree = true;
+
+	strollut_bloom_check_insert(1e-4, 1.5, 1U << 22,
+	                            strollut_bloom_key);
+}
+
+static void
+strollut_bloom_check_batch(void)
+{
+	uint64_t     keys[STROLLUT_BLOOM_KEY_NR];
+	bool         res[2 * STROLLUT_BLOOM_KEY_NR];
+	uint64_t     queries[2 * STROLLUT_BLOOM_KEY_NR];
+	unsigned int k;
+	unsigned int cnt;
+	unsigned int pos = 0;
+
+	for (k = 0; k < STROLLUT_BLOOM_KEY_NR; k++)
+		keys[k] = strollut_bloom_key(k);
+	for (k = 0; k < stroll_array_nr(queries); k++)
+		queries[k] = strollut_bloom_key(k);
+
+	stroll_bloom_insert_batch(&strollut_bloom, keys, stroll_array_nr(keys));
+
+	cnt = stroll_bloom_test_batch(&strollut_bloom,
+	                              queries,
+	                              stroll_array_nr(queries),
+	                              res);
+	for (k = 0; k < stroll_array_nr(queries); k++) {
+		cute_check_bool(res[k],
+		                is,
+		                stroll_bloom_test(&strollut_bloom, queries[k]));
+		pos += res[k];
+	}
+
+	cute_check_uint(cnt, equal, pos);
+	cute_check_uint(cnt, greater_equal, STROLLUT_BLOOM_KEY_NR);
+}
+
+CUTE_TEST(strollut_bloom_batch_std)
+{
+	cute_check_sint(stroll_bloom_init(&strollut_bloom,
+	                                  STROLLUT_BLOOM_KEY_NR,
+	                                  0.01),
+	                equal,
+	                0);
+	strollut_bloom_tofree = true;
+
+	strollut_bloom_check_batch();
+}
+
+CUTE_TEST(strollut_bloom_batch_blocked)
+{
+	cute_check_sint(stroll_bloom_init_blocked(&strollut_bloom,
+	                                          STROLLUT_BLOOM_KEY_NR,
+	                                          0.01),
+	                equal,
+	                0);
+	strollut_bloom_tofree = true;
+
+	strollut_bloom_check_batch();
+}
+
+CUTE_TEST(strollut_bloom_clear)
+{
+	unsigned int k;
+
+	cute_check_sint(stroll_bloom_init(&strollut_bloom,
+	                                  STROLLUT_BLOOM_KEY_NR,
+	                                  0.01),
+	                equal,
+	                0);
+	strollut_bloom_tofree = true;
+
+	for (k = 0; k < STROLLUT_BLOOM_KEY_NR; k++)
+		stroll_bloom_insert(&strollut_bloom, strollut_bloom_key(k));
+
+	stroll_bloom_clear(&strollut_bloom);
+
+	for (k = 0; k < STROLLUT_BLOOM_KEY_NR; k++)
+		cute_check_bool(stroll_bloom_test(&strollut_bloom,
+		                                  strollut_bloom_key(k)),
+		                is,
+		                false);
+}
+
+typedef int (strollut_bloom_init_fn)(struct stroll_bloom * __restrict,
+                                     unsigned int,
+                                     double);
+
+static void
+strollut_bloom_check_unite(strollut_bloom_init_fn * init)
+{
+	unsigned int k;
+
+	cute_check_sint(init(&strollut_bloom, 2 * STROLLUT_BLOOM_KEY_NR, 0.01),
+	                equal,
+	                0);
+	strollut_bloom_tofree = true;
+	cute_check_sint(init(&strollut_bloom_other,
+	                     2 * STROLLUT_BLOOM_KEY_NR,
+	                     0.01),
+	                equal,
+	                0);
+	strollut_bloom_other_tofree = true;
+
+	for (k = 0; k < STROLLUT_BLOOM_KEY_NR; k++) {
+		stroll_bloom_insert(&strollut_bloom, strollut_bloom_key(k));
+		stroll_bloom_insert(
+			&strollut_bloom_other,
+			strollut_bloom_key(STROLLUT_BLOOM_KEY_NR + k));
+	}
+
+	stroll_bloom_unite(&strollut_bloom, &strollut_bloom_other);
+
+	for (k = 0; k < (2 * STROLLUT_BLOOM_KEY_NR); k++)
+		cute_check_bool(stroll_bloom_test(&strollut_bloom,
+		                                  strollut_bloom_key(k)),
+		                is,
+		                true);
+}
+
+CUTE_TEST(strollut_bloom_unite_std)
+{
+	strollut_bloom_check_unite(stroll_bloom_init);
+}
+
+CUTE_TEST(strollut_bloom_unite_blocked)
+{
+	strollut_bloom_check_unite(stroll_bloom_init_blocked);
+}
+
+static void
+strollut_bloom_check_intersect(strollut_bloom_init_fn * init)
+{
+	unsigned int k;
+	unsigned int fp = 0;
+
+	cute_check_sint(init(&strollut_bloom, STROLLUT_BLOOM_KEY_NR, 0.01),
+	                equal,
+	                0);
+	strollut_bloom_tofree = true;
+	cute_check_sint(init(&strollut_bloom_other,
+	                     STROLLUT_BLOOM_KEY_NR,
+	                     0.01),
+	                equal,
+	                0);
+	strollut_bloom_other_tofree = true;
+
+	/*
+	 * First filter holds keys [0, KEY_NR[, the second one holds keys
+	 * [KEY_NR / 2, 3 * KEY_NR / 2[.
+	 */
+	for (k = 0; k < STROLLUT_BLOOM_KEY_NR; k++) {
+		stroll_bloom_insert(&strollut_bloom, strollut_bloom_key(k));
+		stroll_bloom_insert(&strollut_bloom_other,
+		                    strollut_bloom_key((STROLLUT_BLOOM_KEY_NR /
+		                                        2) + k));
+	}
+
+	stroll_bloom_intersect(&strollut_bloom, &strollut_bloom_other);
+
+	for (k = STROLLUT_BLOOM_KEY_NR / 2; k < STROLLUT_BLOOM_KEY_NR; k++)
+		cute_check_bool(stroll_bloom_test(&strollut_bloom,
+		                                  strollut_bloom_key(k)),
+		                is,
+		                true);
+
+	/* Most keys outside of the intersection should be filtered out. */
+	for (k = 0; k < STROLLUT_BLOOM_KEY_NR / 2; k++)
+		fp += stroll_bloom_test(&strollut_bloom, strollut_bloom_key(k));
+	cute_check_uint(fp, lower, STROLLUT_BLOOM_KEY_NR / 20);
+}
+
+CUTE_TEST(strollut_bloom_intersect_std)
+{
+	strollut_bloom_check_intersect(stroll_bloom_init);
+}
+
+CUTE_TEST(strollut_bloom_intersect_blocked)
+{
+	strollut_bloom_check_intersect(stroll_bloom_init_blocked);
+}
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_bloom_unite_assert)
+{
+	cute_check_sint(stroll_bloom_init(&strollut_bloom, 1000, 0.01),
+	                equal,
+	                0);
+	strollut_bloom_tofree = true;
+	cute_check_sint(stroll_bloom_init_blocked(&strollut_bloom_other,
+	                                          1000,
+	                                          0.01),
+	                equal,
+	                0);
+	strollut_bloom_other_tofree = true;
+
+	cute_expect_assertion(stroll_bloom_unite(&strollut_bloom,
+	                                         &strollut_bloom_other));
+	cute_expect_assertion(stroll_bloom_intersect(&strollut_bloom,
+	                                             &strollut_bloom_other));
+}
+#else
+STROLLUT_BLOOM_NOASSERT(strollut_bloom_unite_assert)
+#endif
+
+CUTE_GROUP(strollut_bloom_group) = {
+	CUTE_REF(strollut_bloom_init_assert),
+	CUTE_REF(strollut_bloom_init_range),
+	CUTE_REF(strollut_bloom_init_std),
+	CUTE_REF(strollut_bloom_init_blocked),
+	CUTE_REF(strollut_bloom_insert_std),
+	CUTE_REF(strollut_bloom_insert_std_stride),
+	CUTE_REF(strollut_bloom_insert_blocked),
+	CUTE_REF(strollut_bloom_insert_blocked_1e3),
+	CUTE_REF(strollut_bloom_insert_blocked_1e4),
+	CUTE_REF(strollut_bloom_batch_std),
+	CUTE_REF(strollut_bloom_batch_blocked),
+	CUTE_REF(strollut_bloom_clear),
+	CUTE_REF(strollut_bloom_unite_std),
+	CUTE_REF(strollut_bloom_unite_blocked),
+	CUTE_REF(strollut_bloom_intersect_std),
+	CUTE_REF(strollut_bloom_intersect_blocked),
+	CUTE_REF(strollut_bloom_unite_assert)
+};
+
+CUTE_SUITE_EXTERN(strollut_bloom_suite,
+                  strollut_bloom_group,
+                  strollut_bloom_setup,
+                  strollut_bloom_teardown,
+                  CUTE_DFLT_TMOUT);
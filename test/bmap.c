@@ -3071,6 +3071,266 @@ CUTE_TEST(strollut_bmap_word_toggle_all)
 	}
 }
 
+static unsigned long
+strollut_bmap_word_atomic_set_mask_oper(unsigned long bmap, unsigned long mask)
+{
+	unsigned long bmp = bmap;
+
+	cute_check_hex(stroll_bmap_atomic_set_maskul(&bmp,
+	                                             mask,
+	                                             STROLL_ATOMIC_RELAXED),
+	               equal,
+	               bmap);
+
+	return bmp;
+}
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_bmap_word_atomic_set_mask_assert)
+{
+	unsigned long bmp = 0;
+
+	cute_expect_assertion(
+		stroll_bmap_atomic_set_maskul(NULL,
+		                              0xf,
+		                              STROLL_ATOMIC_RELAXED));
+	cute_expect_assertion(
+		stroll_bmap_atomic_set_maskul(&bmp,
+		                              0xf,
+		                              (enum stroll_atomic_order)-1));
+}
+#else
+CUTE_TEST(strollut_bmap_word_atomic_set_mask_assert)
+{
+	cute_skip("assertion unsupported");
+}
+#endif
+
+CUTE_TEST_STATIC(strollut_bmap_word_atomic_set_mask,
+                 strollut_bmap_word_setup_or,
+                 strollut_bmap_teardown,
+                 CUTE_DFLT_TMOUT)
+{
+	strollut_bmap_word_run_mask_oper(
+		strollut_bmap_word_atomic_set_mask_oper);
+}
+
+static unsigned long
+strollut_bmap_word_atomic_clear_mask_oper(unsigned long bmap,
+                                          unsigned long mask)
+{
+	unsigned long bmp = bmap;
+
+	cute_check_hex(stroll_bmap_atomic_clear_maskul(&bmp,
+	                                               mask,
+	                                               STROLL_ATOMIC_RELEASE),
+	               equal,
+	               bmap);
+
+	return bmp;
+}
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_bmap_word_atomic_clear_mask_assert)
+{
+	cute_expect_assertion(
+		stroll_bmap_atomic_clear_maskul(NULL,
+		                                0xf,
+		                                STROLL_ATOMIC_RELAXED));
+}
+#else
+CUTE_TEST(strollut_bmap_word_atomic_clear_mask_assert)
+{
+	cute_skip("assertion unsupported");
+}
+#endif
+
+CUTE_TEST_STATIC(strollut_bmap_word_atomic_clear_mask,
+                 strollut_bmap_word_setup_clear_mask,
+                 strollut_bmap_teardown,
+                 CUTE_DFLT_TMOUT)
+{
+	strollut_bmap_word_run_mask_oper(
+		strollut_bmap_word_atomic_clear_mask_oper);
+}
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_bmap_word_atomic_test_and_set_assert)
+{
+	unsigned long bmp = 0;
+	bool          res __unused;
+
+	cute_expect_assertion(
+		res = stroll_bmap_atomic_test_and_setul(NULL,
+		                                        0,
+		                                        STROLL_ATOMIC_ACQUIRE));
+	cute_expect_assertion(
+		res = stroll_bmap_atomic_test_and_setul(&bmp,
+		                                        __WORDSIZE,
+		                                        STROLL_ATOMIC_ACQUIRE));
+}
+#else
+CUTE_TEST(strollut_bmap_word_atomic_test_and_set_assert)
+{
+	cute_skip("assertion unsupported");
+}
+#endif
+
+CUTE_TEST(strollut_bmap_word_atomic_test_and_set)
+{
+	unsigned long            bmp = 0;
+	uint32_t                 bmp32 = 0;
+	uint64_t                 bmp64 = 0;
+	unsigned int             b;
+	enum stroll_atomic_order ord;
+
+	ord = STROLL_ATOMIC_ACQUIRE;
+	for (b = 0; b < stroll_bops_bitsof(bmp); b++) {
+		cute_check_bool(
+			stroll_bmap_atomic_test_and_setul(&bmp, b, ord),
+			is,
+			false);
+		cute_check_bool(
+			stroll_bmap_atomic_test_and_setul(&bmp, b, ord),
+			is,
+			true);
+		cute_check_hex(bmp, equal, stroll_bmap_maskul(0, b + 1));
+	}
+
+	ord = STROLL_ATOMIC_SEQ_CST;
+	for (b = 0; b < 32; b++) {
+		cute_check_bool(
+			stroll_bmap_atomic_test_and_set32(&bmp32, b, ord),
+			is,
+			false);
+		cute_check_hex(bmp32, equal, stroll_bmap_mask32(0, b + 1));
+	}
+
+	ord = STROLL_ATOMIC_ACQ_REL;
+	for (b = 0; b < 64; b++) {
+		cute_check_bool(
+			stroll_bmap_atomic_test_and_set64(&bmp64, b, ord),
+			is,
+			false);
+		cute_check_hex(bmp64, equal, stroll_bmap_mask64(0, b + 1));
+	}
+}
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_bmap_word_atomic_test_and_clear_assert)
+{
+	unsigned long bmp = 0;
+	bool          res __unused;
+
+	cute_expect_assertion(
+		res = stroll_bmap_atomic_test_and_clearul(
+			NULL,
+			0,
+			STROLL_ATOMIC_RELEASE));
+	cute_expect_assertion(
+		res = stroll_bmap_atomic_test_and_clearul(
+			&bmp,
+			__WORDSIZE,
+			STROLL_ATOMIC_RELEASE));
+}
+#else
+CUTE_TEST(strollut_bmap_word_atomic_test_and_clear_assert)
+{
+	cute_skip("assertion unsupported");
+}
+#endif
+
+CUTE_TEST(strollut_bmap_word_atomic_test_and_clear)
+{
+	unsigned long bmp = ~(0UL);
+	uint32_t      bmp32 = UINT32_MAX;
+	uint64_t      bmp64 = UINT64_MAX;
+	unsigned int  b;
+
+	for (b = 0; b < stroll_bops_bitsof(bmp); b++) {
+		cute_check_bool(
+			stroll_bmap_atomic_test_and_clearul(
+				&bmp,
+				b,
+				STROLL_ATOMIC_RELEASE),
+			is,
+			true);
+		cute_check_bool(
+			stroll_bmap_atomic_test_and_clearul(
+				&bmp,
+				b,
+				STROLL_ATOMIC_RELEASE),
+			is,
+			false);
+		cute_check_hex(bmp, equal, ~stroll_bmap_maskul(0, b + 1));
+	}
+
+	for (b = 0; b < 32; b++) {
+		cute_check_bool(
+			stroll_bmap_atomic_test_and_clear32(
+				&bmp32,
+				b,
+				STROLL_ATOMIC_RELAXED),
+			is,
+			true);
+		cute_check_hex(bmp32, equal, ~stroll_bmap_mask32(0, b + 1));
+	}
+
+	for (b = 0; b < 64; b++) {
+		cute_check_bool(
+			stroll_bmap_atomic_test_and_clear64(
+				&bmp64,
+				b,
+				STROLL_ATOMIC_RELAXED),
+			is,
+			true);
+		cute_check_hex(bmp64, equal, ~stroll_bmap_mask64(0, b + 1));
+	}
+}
+
+CUTE_TEST(strollut_bmap_word_atomic_cmpxchg)
+{
+	unsigned long bmp = 0xf0UL;
+	unsigned long xpct = 0x0fUL;
+	uint32_t      bmp32 = UINT32_C(0x1234);
+	uint32_t      xpct32 = UINT32_C(0x1234);
+	uint64_t      bmp64 = UINT64_C(0x5678);
+	uint64_t      xpct64 = 0;
+
+	cute_check_bool(stroll_bmap_atomic_cmpxchgul(&bmp,
+	                                             &xpct,
+	                                             0xffUL,
+	                                             STROLL_ATOMIC_ACQ_REL),
+	                is,
+	                false);
+	cute_check_hex(xpct, equal, 0xf0UL);
+	cute_check_hex(bmp, equal, 0xf0UL);
+	cute_check_bool(stroll_bmap_atomic_cmpxchgul(&bmp,
+	                                             &xpct,
+	                                             0xffUL,
+	                                             STROLL_ATOMIC_ACQ_REL),
+	                is,
+	                true);
+	cute_check_hex(bmp, equal, 0xffUL);
+
+	cute_check_bool(stroll_bmap_atomic_cmpxchg32(&bmp32,
+	                                             &xpct32,
+	                                             UINT32_C(0x4321),
+	                                             STROLL_ATOMIC_RELEASE),
+	                is,
+	                true);
+	cute_check_hex(bmp32, equal, UINT32_C(0x4321));
+
+	cute_check_bool(stroll_bmap_atomic_cmpxchg64(&bmp64,
+	                                             &xpct64,
+	                                             UINT64_C(0x8765),
+	                                             STROLL_ATOMIC_SEQ_CST),
+	                is,
+	                false);
+	cute_check_hex(xpct64, equal, UINT64_C(0x5678));
+	cute_check_hex(bmp64, equal, UINT64_C(0x5678));
+}
+
 #if defined(CONFIG_STROLL_ASSERT_API)
 CUTE_TEST(strollut_bmap_word_set_iter_assert)
 {
@@ -3245,6 +3505,16 @@ CUTE_GROUP(strollut_bmap_word_group) = {
 	CUTE_REF(strollut_bmap_word_toggle_all_assert),
 	CUTE_REF(strollut_bmap_word_toggle_all),
 
+	CUTE_REF(strollut_bmap_word_atomic_set_mask_assert),
+	CUTE_REF(strollut_bmap_word_atomic_set_mask),
+	CUTE_REF(strollut_bmap_word_atomic_clear_mask_assert),
+	CUTE_REF(strollut_bmap_word_atomic_clear_mask),
+	CUTE_REF(strollut_bmap_word_atomic_test_and_set_assert),
+	CUTE_REF(strollut_bmap_word_atomic_test_and_set),
+	CUTE_REF(strollut_bmap_word_atomic_test_and_clear_assert),
+	CUTE_REF(strollut_bmap_word_atomic_test_and_clear),
+	CUTE_REF(strollut_bmap_word_atomic_cmpxchg),
+
 	CUTE_REF(strollut_bmap_word_set_iter_assert),
 	CUTE_REF(strollut_bmap_word_set_iter),
 	CUTE_REF(strollut_bmap_word_clear_iter_assert),
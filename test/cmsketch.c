@@ -0,0 +1,422 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#include "utest.h"
+#include "stroll/cmsketch.h"
+#include <cute/cute.h>
+#include <cute/check.h>
+#include <cute/expect.h>
+
+#define STROLLUT_CMSKETCH_NOASSERT(_test) \
+	CUTE_TEST(_test) { cute_skip("assertion unsupported"); }
+
+#define STROLLUT_CMSKETCH_KEY_NR (4096U)
+
+static struct stroll_cmsketch strollut_cms;
+static struct stroll_cmsketch strollut_cms_other;
+static struct stroll_csketch  strollut_cs;
+static struct stroll_csketch  strollut_cs_other;
+static unsigned int           strollut_cmsketch_tofree;
+
+#define STROLLUT_CMS_TOFREE       (1U << 0)
+#define STROLLUT_CMS_OTHER_TOFREE (1U << 1)
+#define STROLLUT_CS_TOFREE        (1U << 2)
+#define STROLLUT_CS_OTHER_TOFREE  (1U << 3)
+
+static void
+strollut_cmsketch_setup(void)
+{
+	strollut_cmsketch_tofree = 0;
+}
+
+static void
+strollut_cmsketch_teardown(void)
+{
+	if (strollut_cmsketch_tofree & STROLLUT_CMS_TOFREE)
+		stroll_cmsketch_fini(&strollut_cms);
+	if (strollut_cmsketch_tofree & STROLLUT_CMS_OTHER_TOFREE)
+		stroll_cmsketch_fini(&strollut_cms_other);
+	if (strollut_cmsketch_tofree & STROLLUT_CS_TOFREE)
+		stroll_csketch_fini(&strollut_cs);
+	if (strollut_cmsketch_tofree & STROLLUT_CS_OTHER_TOFREE)
+		stroll_csketch_fini(&strollut_cs_other);
+
+	strollut_cmsketch_tofree = 0;
+}
+
+/* Skewed, Zipf like, number of occurrences of key of the given rank. */
+static uint32_t
+strollut_cmsketch_freq(unsigned int key)
+{
+	return (STROLLUT_CMSKETCH_KEY_NR / (key + 1)) + 1;
+}
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_cmsketch_init_assert)
+{
+	int err __unused;
+
+	cute_expect_assertion(err = stroll_cmsketch_init(NULL, 0.01, 0.01));
+	cute_expect_assertion(err = stroll_cmsketch_init(&strollut_cms,
+	                                                 0.0,
+	                                                 0.01));
+	cute_expect_assertion(err = stroll_cmsketch_init(&strollut_cms,
+	                                                 1.0,
+	                                                 0.01));
+	cute_expect_assertion(err = stroll_cmsketch_init(&strollut_cms,
+	                                                 0.01,
+	                                                 0.0));
+	cute_expect_assertion(err = stroll_cmsketch_init(&strollut_cms,
+	                                                 0.01,
+	                                                 1.0));
+
+	cute_expect_assertion(err = stroll_csketch_init(NULL, 0.01, 0.01));
+	cute_expect_assertion(err = stroll_csketch_init(&strollut_cs,
+	                                                0.0,
+	                                                0.01));
+	cute_expect_assertion(err = stroll_csketch_init(&strollut_cs,
+	                                                0.01,
+	                                                1.0));
+}
+#else
+STROLLUT_CMSKETCH_NOASSERT(strollut_cmsketch_init_assert)
+#endif
+
+CUTE_TEST(strollut_cmsketch_init_range)
+{
+	/* Too many rows required. */
+	cute_check_sint(stroll_cmsketch_init(&strollut_cms, 0.01, 1e-9),
+	                equal,
+	                -ERANGE);
+	/* Too many counters per row required. */
+	cute_check_sint(stroll_cmsketch_init(&strollut_cms, 1e-9, 0.01),
+	                equal,
+	                -ERANGE);
+
+	cute_check_sint(stroll_csketch_init(&strollut_cs, 0.01, 1e-9),
+	                equal,
+	                -ERANGE);
+	cute_check_sint(stroll_csketch_init(&strollut_cs, 1e-4, 0.01),
+	                equal,
+	                -ERANGE);
+}
+
+CUTE_TEST(strollut_cmsketch_init)
+{
+	unsigned int c;
+
+	cute_check_sint(stroll_cmsketch_init(&strollut_cms, 0.01, 0.01),
+	                equal,
+	                0);
+	strollut_cmsketch_tofree |= STROLLUT_CMS_TOFREE;
+
+	/* ceil(ln(1 / 0.01)) rows. */
+	cute_check_uint(stroll_cmsketch_depth(&strollut_cms), equal, 5);
+	/* e / 0.01 counters rounded up to the next power of 2. */
+	cute_check_uint(stroll_cmsketch_width(&strollut_cms), equal, 512);
+	for (c = 0; c < (5 * 512); c++)
+		cute_check_uint(stroll_cmsketch_counters(&strollut_cms)[c],
+		                equal,
+		                0);
+}
+
+CUTE_TEST(strollut_cmsketch_update)
+{
+	unsigned int k;
+	uint64_t     total = 0;
+	unsigned int over = 0;
+
+	cute_check_sint(stroll_cmsketch_init(&strollut_cms, 0.001, 0.01),
+	                equal,
+	                0);
+	strollut_cmsketch_tofree |= STROLLUT_CMS_TOFREE;
+
+	for (k = 0; k < STROLLUT_CMSKETCH_KEY_NR; k++) {
+		stroll_cmsketch_update(&strollut_cms,
+		                       k,
+		                       strollut_cmsketch_freq(k));
+		total += strollut_cmsketch_freq(k);
+	}
+
+	for (k = 0; k < STROLLUT_CMSKETCH_KEY_NR; k++) {
+		uint32_t est = stroll_cmsketch_estimate(&strollut_cms, k);
+
+		/* Count-Min sketches MUST NOT underestimate frequencies. */
+		cute_check_uint(est, greater_equal, strollut_cmsketch_freq(k));
+		if ((est - strollut_cmsketch_freq(k)) >
+		    (uint32_t)(0.001 * (double)total))
+			over++;
+	}
+
+	/* Error bound MAY be exceeded with probability 0.01. */
+	cute_check_uint(over,
+	                lower_equal,
+	                (unsigned int)(0.01 * STROLLUT_CMSKETCH_KEY_NR));
+}
+
+CUTE_TEST(strollut_cmsketch_saturate)
+{
+	cute_check_sint(stroll_cmsketch_init(&strollut_cms, 0.1, 0.1),
+	                equal,
+	                0);
+	strollut_cmsketch_tofree |= STROLLUT_CMS_TOFREE;
+
+	stroll_cmsketch_update(&strollut_cms, 1, UINT32_MAX - 1);
+	cute_check_uint(stroll_cmsketch_estimate(&strollut_cms, 1),
+	                equal,
+	                UINT32_MAX - 1);
+	stroll_cmsketch_update(&strollut_cms, 1, 2);
+	cute_check_uint(stroll_cmsketch_estimate(&strollut_cms, 1),
+	                equal,
+	                UINT32_MAX);
+}
+
+CUTE_TEST(strollut_cmsketch_merge)
+{
+	unsigned int k;
+
+	cute_check_sint(stroll_cmsketch_init(&strollut_cms, 0.01, 0.01),
+	                equal,
+	                0);
+	strollut_cmsketch_tofree |= STROLLUT_CMS_TOFREE;
+	cute_check_sint(stroll_cmsketch_init(&strollut_cms_other, 0.01, 0.01),
+	                equal,
+	                0);
+	strollut_cmsketch_tofree |= STROLLUT_CMS_OTHER_TOFREE;
+
+	for (k = 0; k < STROLLUT_CMSKETCH_KEY_NR; k++)
+		stroll_cmsketch_update((k & 1) ? &strollut_cms
+		                               : &strollut_cms_other,
+		                       k,
+		                       strollut_cmsketch_freq(k));
+	stroll_cmsketch_merge(&strollut_cms, &strollut_cms_other);
+
+	/* Build reference by registering all keys into a single sketch. */
+	stroll_cmsketch_clear(&strollut_cms_other);
+	for (k = 0; k < STROLLUT_CMSKETCH_KEY_NR; k++)
+		stroll_cmsketch_update(&strollut_cms_other,
+		                       k,
+		                       strollut_cmsketch_freq(k));
+
+	cute_check_mem(stroll_cmsketch_counters(&strollut_cms),
+	               equal,
+	               stroll_cmsketch_counters(&strollut_cms_other),
+	               stroll_cmsketch_depth(&strollut_cms) *
+	               stroll_cmsketch_width(&strollut_cms) *
+	               sizeof(uint32_t));
+}
+
+CUTE_TEST(strollut_cmsketch_clear)
+{
+	cute_check_sint(stroll_cmsketch_init(&strollut_cms, 0.01, 0.01),
+	                equal,
+	                0);
+	strollut_cmsketch_tofree |= STROLLUT_CMS_TOFREE;
+
+	stroll_cmsketch_update(&strollut_cms, 10, 10);
+	cute_check_uint(stroll_cmsketch_estimate(&strollut_cms, 10),
+	                equal,
+	                10);
+	stroll_cmsketch_clear(&strollut_cms);
+	cute_check_uint(stroll_cmsketch_estimate(&strollut_cms, 10),
+	                equal,
+	                0);
+}
+
+CUTE_TEST(strollut_csketch_init)
+{
+	cute_check_sint(stroll_csketch_init(&strollut_cs, 0.1, 0.05),
+	                equal,
+	                0);
+	strollut_cmsketch_tofree |= STROLLUT_CS_TOFREE;
+
+	/* ceil(ln(1 / 0.05)) rows rounded up to the next odd number. */
+	cute_check_uint(stroll_csketch_depth(&strollut_cs), equal, 3);
+	/* 3 / 0.1^2 counters rounded up to the next power of 2. */
+	cute_check_uint(stroll_csketch_width(&strollut_cs), equal, 512);
+
+	stroll_csketch_fini(&strollut_cs);
+
+	/* ceil(ln(1 / 0.01)) rows is already odd. */
+	cute_check_sint(stroll_csketch_init(&strollut_cs, 0.1, 0.01),
+	                equal,
+	                0);
+	cute_check_uint(stroll_csketch_depth(&strollut_cs), equal, 5);
+}
+
+CUTE_TEST(strollut_csketch_update)
+{
+	unsigned int k;
+	double       bound = 0.0;
+	unsigned int over = 0;
+	double       err;
+
+	cute_check_sint(stroll_csketch_init(&strollut_cs, 0.05, 0.01),
+	                equal,
+	                0);
+	strollut_cmsketch_tofree |= STROLLUT_CS_TOFREE;
+
+	/* Compute squared error bound, i.e. (0.05 * ||f||)^2. */
+	for (k = 0; k < STROLLUT_CMSKETCH_KEY_NR; k++) {
+		double freq = (double)strollut_cmsketch_freq(k);
+
+		stroll_csketch_update(&strollut_cs,
+		                      k,
+		                      (int32_t)strollut_cmsketch_freq(k));
+		bound += freq * freq;
+	}
+	bound *= 0.05 * 0.05;
+
+	for (k = 0; k < STROLLUT_CMSKETCH_KEY_NR; k++) {
+		err = (double)(stroll_csketch_estimate(&strollut_cs, k) -
+		               (int32_t)strollut_cmsketch_freq(k));
+		if ((err * err) > bound)
+			over++;
+	}
+
+	/* Error bound MAY be exceeded with probability 0.01. */
+	cute_check_uint(over,
+	                lower_equal,
+	                (unsigned int)(0.01 * STROLLUT_CMSKETCH_KEY_NR));
+
+	/* Heaviest hitter estimation should be accurate. */
+	err = (double)(stroll_csketch_estimate(&strollut_cs, 0) -
+	               (int32_t)strollut_cmsketch_freq(0));
+	cute_check_bool((err * err) <= bound, is, true);
+}
+
+CUTE_TEST(strollut_csketch_remove)
+{
+	unsigned int k;
+	unsigned int c;
+
+	cute_check_sint(stroll_csketch_init(&strollut_cs, 0.1, 0.1),
+	                equal,
+	                0);
+	strollut_cmsketch_tofree |= STROLLUT_CS_TOFREE;
+
+	for (k = 0; k < STROLLUT_CMSKETCH_KEY_NR; k++)
+		stroll_csketch_update(&strollut_cs,
+		                      k,
+		                      (int32_t)strollut_cmsketch_freq(k));
+	for (k = 0; k < STROLLUT_CMSKETCH_KEY_NR; k++)
+		stroll_csketch_update(&strollut_cs,
+		                      k,
+		                      -(int32_t)strollut_cmsketch_freq(k));
+
+	for (c = 0;
+	     c < (stroll_csketch_depth(&strollut_cs) *
+	          stroll_csketch_width(&strollut_cs));
+	     c++)
+		cute_check_sint(stroll_csketch_counters(&strollut_cs)[c],
+		                equal,
+		                0);
+}
+
+/*
+ * Counters wrap around using modular arithmetic: make sure extreme counts are
+ * handled without signed integer overflow.
+ */
+CUTE_TEST(strollut_csketch_extreme)
+{
+	cute_check_sint(stroll_csketch_init(&strollut_cs, 0.1, 0.1),
+	                equal,
+	                0);
+	strollut_cmsketch_tofree |= STROLLUT_CS_TOFREE;
+
+	stroll_csketch_update(&strollut_cs, 1, INT32_MIN);
+	cute_check_sint(stroll_csketch_estimate(&strollut_cs, 1),
+	                equal,
+	                INT32_MIN);
+
+	stroll_csketch_update(&strollut_cs, 1, INT32_MIN);
+	cute_check_sint(stroll_csketch_estimate(&strollut_cs, 1), equal, 0);
+
+	stroll_csketch_update(&strollut_cs, 1, INT32_MAX);
+	cute_check_sint(stroll_csketch_estimate(&strollut_cs, 1),
+	                equal,
+	                INT32_MAX);
+
+	stroll_csketch_update(&strollut_cs, 1, -INT32_MAX);
+	cute_check_sint(stroll_csketch_estimate(&strollut_cs, 1), equal, 0);
+}
+
+CUTE_TEST(strollut_csketch_merge)
+{
+	unsigned int k;
+
+	cute_check_sint(stroll_csketch_init(&strollut_cs, 0.1, 0.01),
+	                equal,
+	                0);
+	strollut_cmsketch_tofree |= STROLLUT_CS_TOFREE;
+	cute_check_sint(stroll_csketch_init(&strollut_cs_other, 0.1, 0.01),
+	                equal,
+	                0);
+	strollut_cmsketch_tofree |= STROLLUT_CS_OTHER_TOFREE;
+
+	for (k = 0; k < STROLLUT_CMSKETCH_KEY_NR; k++)
+		stroll_csketch_update((k & 1) ? &strollut_cs
+		                              : &strollut_cs_other,
+		                      k,
+		                      (int32_t)strollut_cmsketch_freq(k));
+	stroll_csketch_merge(&strollut_cs, &strollut_cs_other);
+
+	/* Build reference by registering all keys into a single sketch. */
+	stroll_csketch_clear(&strollut_cs_other);
+	for (k = 0; k < STROLLUT_CMSKETCH_KEY_NR; k++)
+		stroll_csketch_update(&strollut_cs_other,
+		                      k,
+		                      (int32_t)strollut_cmsketch_freq(k));
+
+	cute_check_mem(stroll_csketch_counters(&strollut_cs),
+	               equal,
+	               stroll_csketch_counters(&strollut_cs_other),
+	               stroll_csketch_depth(&strollut_cs) *
+	               stroll_csketch_width(&strollut_cs) *
+	               sizeof(int32_t));
+}
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_cmsketch_merge_assert)
+{
+	cute_check_sint(stroll_cmsketch_init(&strollut_cms, 0.01, 0.01),
+	                equal,
+	                0);
+	strollut_cmsketch_tofree |= STROLLUT_CMS_TOFREE;
+	cute_check_sint(stroll_cmsketch_init(&strollut_cms_other, 0.01, 0.1),
+	                equal,
+	                0);
+	strollut_cmsketch_tofree |= STROLLUT_CMS_OTHER_TOFREE;
+
+	cute_expect_assertion(stroll_cmsketch_merge(&strollut_cms,
+	                                            &strollut_cms_other));
+}
+#else
+STROLLUT_CMSKETCH_NOASSERT(strollut_cmsketch_merge_assert)
+#endif
+
+CUTE_GROUP(strollut_cmsketch_group) = {
+	CUTE_REF(strollut_cmsketch_init_assert),
+	CUTE_REF(strollut_cmsketch_init_range),
+	CUTE_REF(strollut_cmsketch_init),
+	CUTE_REF(strollut_cmsketch_update),
+	CUTE_REF(strollut_cmsketch_saturate),
+	CUTE_REF(strollut_cmsketch_merge),
+	CUTE_REF(strollut_cmsketch_clear),
+	CUTE_REF(strollut_csketch_init),
+	CUTE_REF(strollut_csketch_update),
+	CUTE_REF(strollut_csketch_remove),
+	CUTE_REF(strollut_csketch_extreme),
+	CUTE_REF(strollut_csketch_merge),
+	CUTE_REF(strollut_cmsketch_merge_assert)
+};
+
+CUTE_SUITE_EXTERN(strollut_cmsketch_suite,
+                  strollut_cmsketch_group,
+                  strollut_cmsketch_setup,
+                  strollut_cmsketch_teardown,
+                  CUTE_DFLT_TMOUT);
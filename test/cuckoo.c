@@ -0,0 +1,400 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#include "utest.h"
+#include "stroll/cuckoo.h"
+#include "stroll/hash.h"
+#include <cute/cute.h>
+#include <cute/check.h>
+#include <cute/expect.h>
+
+#define STROLLUT_CUCKOO_NOASSERT(_test) \
+	CUTE_TEST(_test) { cute_skip("assertion unsupported"); }
+
+#define STROLLUT_CUCKOO_KEY_NR   (4096U)
+#define STROLLUT_CUCKOO_QUERY_NR (65536U)
+
+static struct stroll_cuckoo strollut_cuckoo;
+static bool                 strollut_cuckoo_tofree;
+
+/* Generate distinct 64-bit keys spread over the whole key space. */
+static uint64_t
+strollut_cuckoo_key(unsigned int index)
+{
+	return stroll_hash_mix64((uint64_t)index *
+	                         UINT64_C(0x9e3779b97f4a7c15));
+}
+
+/* Generate dense sequential keys. */
+static uint64_t
+strollut_cuckoo_seq_key(unsigned int index)
+{
+	return index;
+}
+
+static void
+strollut_cuckoo_setup(void)
+{
+	strollut_cuckoo_tofree = false;
+}
+
+static void
+strollut_cuckoo_teardown(void)
+{
+	if (strollut_cuckoo_tofree) {
+		stroll_cuckoo_fini(&strollut_cuckoo);
+		strollut_cuckoo_tofree = false;
+	}
+}
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_cuckoo_init_assert)
+{
+	int err __unused;
+
+	cute_expect_assertion(err = stroll_cuckoo_init(NULL, 1, 0.01));
+	cute_expect_assertion(err = stroll_cuckoo_init(&strollut_cuckoo,
+	                                               0,
+	                                               0.01));
+	cute_expect_assertion(err = stroll_cuckoo_init(&strollut_cuckoo,
+	                                               1,
+	                                               0.0));
+	cute_expect_assertion(err = stroll_cuckoo_init(&strollut_cuckoo,
+	                                               1,
+	                                               1.0));
+}
+#else
+STROLLUT_CUCKOO_NOASSERT(strollut_cuckoo_init_assert)
+#endif
+
+CUTE_TEST(strollut_cuckoo_init_range)
+{
+	cute_check_sint(stroll_cuckoo_init(&strollut_cuckoo, 1000, 1e-12),
+	                equal,
+	                -ERANGE);
+	cute_check_sint(stroll_cuckoo_init(&strollut_cuckoo, UINT_MAX, 0.01),
+	                equal,
+	                -ERANGE);
+}
+
+static void
+strollut_cuckoo_check_init(unsigned int capacity,
+                           double       fpr,
+                           unsigned int slot_nr,
+                           unsigned int fp_bits)
+{
+	cute_check_sint(stroll_cuckoo_init(&strollut_cuckoo, capacity, fpr),
+	                equal,
+	                0);
+	strollut_cuckoo_tofree = true;
+
+	cute_check_uint(stroll_cuckoo_nr(&strollut_cuckoo), equal, 0);
+	cute_check_uint(stroll_cuckoo_slot_nr(&strollut_cuckoo),
+	                equal,
+	                slot_nr);
+	cute_check_uint(stroll_cuckoo_fp_bits(&strollut_cuckoo),
+	                equal,
+	                fp_bits);
+}
+
+CUTE_TEST(strollut_cuckoo_init_8bits)
+{
+	/* 400 keys / 4 slots / 0.95 load factor = 106 -> 128 buckets. */
+	strollut_cuckoo_check_init(400, 0.05, 128 * 4, 8);
+}
+
+CUTE_TEST(strollut_cuckoo_init_8bits_large)
+{
+	/*
+	 * 1000 keys / 4 slots / 0.95 load factor = 264 -> 512 buckets, i.e. too
+	 * many for 8-bit fingerprints.
+	 */
+	strollut_cuckoo_check_init(1000, 0.05, 512 * 4, 16);
+}
+
+CUTE_TEST(strollut_cuckoo_init_16bits)
+{
+	strollut_cuckoo_check_init(1000, 0.01, 512 * 4, 16);
+}
+
+CUTE_TEST(strollut_cuckoo_init_32bits)
+{
+	strollut_cuckoo_check_init(1000, 0.0001, 512 * 4, 32);
+}
+
+CUTE_TEST(strollut_cuckoo_init_tiny)
+{
+	strollut_cuckoo_check_init(1, 0.01, 2 * 4, 16);
+}
+
+static void
+strollut_cuckoo_check_insert(double fpr, uint64_t (* key)(unsigned int))
+{
+	unsigned int k;
+	unsigned int fp = 0;
+
+	cute_check_sint(stroll_cuckoo_init(&strollut_cuckoo,
+	                                   STROLLUT_CUCKOO_KEY_NR,
+	                                   fpr),
+	                equal,
+	                0);
+	strollut_cuckoo_tofree = true;
+
+	for (k = 0; k < STROLLUT_CUCKOO_KEY_NR; k++)
+		cute_check_sint(stroll_cuckoo_insert(&strollut_cuckoo, key(k)),
+		                equal,
+		                0);
+	cute_check_uint(stroll_cuckoo_nr(&strollut_cuckoo),
+	                equal,
+	                STROLLUT_CUCKOO_KEY_NR);
+
+	/* Cuckoo filters MUST NOT generate false negatives. */
+	for (k = 0; k < STROLLUT_CUCKOO_KEY_NR; k++)
+		cute_check_bool(stroll_cuckoo_test(&strollut_cuckoo, key(k)),
+		                is,
+		                true);
+
+	for (k = 0; k < STROLLUT_CUCKOO_QUERY_NR; k++)
+		fp += stroll_cuckoo_test(&strollut_cuckoo,
+		                         key(STROLLUT_CUCKOO_KEY_NR + k));
+	cute_check_uint(fp,
+	                lower_equal,
+	                (unsigned int)(fpr * STROLLUT_CUCKOO_QUERY_NR));
+}
+
+CUTE_TEST(strollut_cuckoo_insert_8bits)
+{
+	strollut_cuckoo_check_insert(0.05, strollut_cuckoo_key);
+}
+
+CUTE_TEST(strollut_cuckoo_insert_16bits)
+{
+	strollut_cuckoo_check_insert(0.01, strollut_cuckoo_key);
+}
+
+CUTE_TEST(strollut_cuckoo_insert_32bits)
+{
+	strollut_cuckoo_check_insert(0.0001, strollut_cuckoo_key);
+}
+
+/*
+ * Dense sequential keys MUST meet the requested false positive rate as well.
+ */
+CUTE_TEST(strollut_cuckoo_insert_seq_8bits)
+{
+	strollut_cuckoo_check_insert(0.05, strollut_cuckoo_seq_key);
+}
+
+CUTE_TEST(strollut_cuckoo_insert_seq_16bits)
+{
+	strollut_cuckoo_check_insert(0.01, strollut_cuckoo_seq_key);
+}
+
+CUTE_TEST(strollut_cuckoo_insert_seq_32bits)
+{
+	strollut_cuckoo_check_insert(0.0001, strollut_cuckoo_seq_key);
+}
+
+/*
+ * Large filters MUST accept as many keys as their declared capacity, i.e. up to
+ * a 95% load factor.
+ */
+CUTE_TEST(strollut_cuckoo_insert_capacity)
+{
+	/* 124518 keys / 4 slots / 0.95 load factor -> 32768 buckets. */
+	const unsigned int capacity = 124518;
+	unsigned int       k;
+	int                err = 0;
+
+	cute_check_sint(stroll_cuckoo_init(&strollut_cuckoo, capacity, 0.05),
+	                equal,
+	                0);
+	strollut_cuckoo_tofree = true;
+	cute_check_uint(stroll_cuckoo_slot_nr(&strollut_cuckoo),
+	                equal,
+	                32768 * 4);
+
+	for (k = 0; k < capacity; k++) {
+		err = stroll_cuckoo_insert(&strollut_cuckoo,
+		                           strollut_cuckoo_key(k));
+		if (err)
+			break;
+	}
+
+	cute_check_sint(err, equal, 0);
+	cute_check_uint(stroll_cuckoo_nr(&strollut_cuckoo), equal, capacity);
+}
+
+CUTE_TEST(strollut_cuckoo_insert_full)
+{
+	unsigned int k;
+	unsigned int slot_nr;
+	int          err = 0;
+
+	cute_check_sint(stroll_cuckoo_init(&strollut_cuckoo, 64, 0.01),
+	                equal,
+	                0);
+	strollut_cuckoo_tofree = true;
+	slot_nr = stroll_cuckoo_slot_nr(&strollut_cuckoo);
+
+	/* Fill the filter up until no more room may be found. */
+	for (k = 0; k <= slot_nr; k++) {
+		err = stroll_cuckoo_insert(&strollut_cuckoo,
+		                           strollut_cuckoo_key(k));
+		if (err)
+			break;
+	}
+
+	cute_check_sint(err, equal, -ENOSPC);
+	cute_check_uint(stroll_cuckoo_nr(&strollut_cuckoo), equal, k);
+	/* Partial-key cuckoo hashing should reach a high load factor. */
+	cute_check_uint(k, greater_equal, (slot_nr * 85) / 100);
+
+	/* A failed insertion MUST leave previous keys untouched. */
+	while (k--)
+		cute_check_bool(stroll_cuckoo_test(&strollut_cuckoo,
+		                                   strollut_cuckoo_key(k)),
+		                is,
+		                true);
+}
+
+CUTE_TEST(strollut_cuckoo_delete)
+{
+	unsigned int k;
+
+	cute_check_sint(stroll_cuckoo_init(&strollut_cuckoo,
+	                                   STROLLUT_CUCKOO_KEY_NR,
+	                                   0.0001),
+	                equal,
+	                0);
+	strollut_cuckoo_tofree = true;
+
+	for (k = 0; k < STROLLUT_CUCKOO_KEY_NR; k++)
+		cute_check_sint(stroll_cuckoo_insert(&strollut_cuckoo,
+		                                     strollut_cuckoo_key(k)),
+		                equal,
+		                0);
+
+	/* Delete even keys. */
+	for (k = 0; k < STROLLUT_CUCKOO_KEY_NR; k += 2)
+		cute_check_sint(stroll_cuckoo_delete(&strollut_cuckoo,
+		                                     strollut_cuckoo_key(k)),
+		                equal,
+		                0);
+	cute_check_uint(stroll_cuckoo_nr(&strollut_cuckoo),
+	                equal,
+	                STROLLUT_CUCKOO_KEY_NR / 2);
+
+	/* Odd keys MUST still be found. */
+	for (k = 1; k < STROLLUT_CUCKOO_KEY_NR; k += 2)
+		cute_check_bool(stroll_cuckoo_test(&strollut_cuckoo,
+		                                   strollut_cuckoo_key(k)),
+		                is,
+		                true);
+
+	/* Delete odd keys: filter should end up empty. */
+	for (k = 1; k < STROLLUT_CUCKOO_KEY_NR; k += 2)
+		cute_check_sint(stroll_cuckoo_delete(&strollut_cuckoo,
+		                                     strollut_cuckoo_key(k)),
+		                equal,
+		                0);
+	cute_check_uint(stroll_cuckoo_nr(&strollut_cuckoo), equal, 0);
+
+	for (k = 0; k < STROLLUT_CUCKOO_KEY_NR; k++) {
+		cute_check_bool(stroll_cuckoo_test(&strollut_cuckoo,
+		                                   strollut_cuckoo_key(k)),
+		                is,
+		                false);
+		cute_check_sint(stroll_cuckoo_delete(&strollut_cuckoo,
+		                                     strollut_cuckoo_key(k)),
+		                equal,
+		                -ENOENT);
+	}
+}
+
+CUTE_TEST(strollut_cuckoo_duplicate)
+{
+	cute_check_sint(stroll_cuckoo_init(&strollut_cuckoo, 16, 0.01),
+	                equal,
+	                0);
+	strollut_cuckoo_tofree = true;
+
+	cute_check_sint(stroll_cuckoo_insert(&strollut_cuckoo, 0xdeadbeef),
+	                equal,
+	                0);
+	cute_check_sint(stroll_cuckoo_insert(&strollut_cuckoo, 0xdeadbeef),
+	                equal,
+	                0);
+	cute_check_uint(stroll_cuckoo_nr(&strollut_cuckoo), equal, 2);
+
+	cute_check_sint(stroll_cuckoo_delete(&strollut_cuckoo, 0xdeadbeef),
+	                equal,
+	                0);
+	cute_check_bool(stroll_cuckoo_test(&strollut_cuckoo, 0xdeadbeef),
+	                is,
+	                true);
+	cute_check_sint(stroll_cuckoo_delete(&strollut_cuckoo, 0xdeadbeef),
+	                equal,
+	                0);
+	cute_check_bool(stroll_cuckoo_test(&strollut_cuckoo, 0xdeadbeef),
+	                is,
+	                false);
+}
+
+CUTE_TEST(strollut_cuckoo_clear)
+{
+	unsigned int k;
+
+	cute_check_sint(stroll_cuckoo_init(&strollut_cuckoo,
+	                                   STROLLUT_CUCKOO_KEY_NR,
+	                                   0.05),
+	                equal,
+	                0);
+	strollut_cuckoo_tofree = true;
+
+	for (k = 0; k < STROLLUT_CUCKOO_KEY_NR; k++)
+		cute_check_sint(stroll_cuckoo_insert(&strollut_cuckoo,
+		                                     strollut_cuckoo_key(k)),
+		                equal,
+		                0);
+
+	stroll_cuckoo_clear(&strollut_cuckoo);
+	cute_check_uint(stroll_cuckoo_nr(&strollut_cuckoo), equal, 0);
+
+	for (k = 0; k < STROLLUT_CUCKOO_KEY_NR; k++)
+		cute_check_bool(stroll_cuckoo_test(&strollut_cuckoo,
+		                                   strollut_cuckoo_key(k)),
+		                is,
+		                false);
+}
+
+CUTE_GROUP(strollut_cuckoo_group) = {
+	CUTE_REF(strollut_cuckoo_init_assert),
+	CUTE_REF(strollut_cuckoo_init_range),
+	CUTE_REF(strollut_cuckoo_init_8bits),
+	CUTE_REF(strollut_cuckoo_init_8bits_large),
+	CUTE_REF(strollut_cuckoo_init_16bits),
+	CUTE_REF(strollut_cuckoo_init_32bits),
+	CUTE_REF(strollut_cuckoo_init_tiny),
+	CUTE_REF(strollut_cuckoo_insert_8bits),
+	CUTE_REF(strollut_cuckoo_insert_16bits),
+	CUTE_REF(strollut_cuckoo_insert_32bits),
+	CUTE_REF(strollut_cuckoo_insert_seq_8bits),
+	CUTE_REF(strollut_cuckoo_insert_seq_16bits),
+	CUTE_REF(strollut_cuckoo_insert_seq_32bits),
+	CUTE_REF(strollut_cuckoo_insert_capacity),
+	CUTE_REF(strollut_cuckoo_insert_full),
+	CUTE_REF(strollut_cuckoo_delete),
+	CUTE_REF(strollut_cuckoo_duplicate),
+	CUTE_REF(strollut_cuckoo_clear)
+};
+
+CUTE_SUITE_EXTERN(strollut_cuckoo_suite,
+                  strollut_cuckoo_group,
+                  strollut_cuckoo_setup,
+                  strollut_cuckoo_teardown,
+                  CUTE_DFLT_TMOUT);
@@ -68,12 +68,19 @@ stroll-utest-objs    += $(call kconf_enabled,STROLL_BOPS,bops.o)
 stroll-utest-objs    += $(call kconf_enabled,STROLL_POW2,pow2.o)
 stroll-utest-objs    += $(call kconf_enabled,STROLL_BMAP,bmap.o)
 stroll-utest-objs    += $(call kconf_enabled,STROLL_FBMAP,fbmap.o)
+stroll-utest-objs    += $(call kconf_enabled,STROLL_HBMAP,hbmap.o)
+stroll-utest-objs    += $(call kconf_enabled,STROLL_IDALLOC,idalloc.o)
+stroll-utest-objs    += $(call kconf_enabled,STROLL_RBMAP,rbmap.o)
 stroll-utest-objs    += $(call kconf_enabled,STROLL_LVSTR,lvstr.o)
 stroll-utest-objs    += $(call kconf_enabled,STROLL_ARRAY,array.o)
 stroll-utest-objs    += $(call kconf_enabled,STROLL_HEAP,heap.o)
 stroll-utest-objs    += $(call kconf_enabled,STROLL_SLIST,slist.o)
 stroll-utest-objs    += $(call kconf_enabled,STROLL_DLIST,dlist.o)
 stroll-utest-objs    += $(call kconf_enabled,STROLL_MSG,message.o)
+stroll-utest-objs    += $(call kconf_enabled,STROLL_BLOOM,bloom.o)
+stroll-utest-objs    += $(call kconf_enabled,STROLL_CUCKOO,cuckoo.o)
+stroll-utest-objs    += $(call kconf_enabled,STROLL_HLL,hll.o)
+stroll-utest-objs    += $(call kconf_enabled,STROLL_CMSKETCH,cmsketch.o)
 ifneq ($(filter y,$(prheap_kconf)),)
 stroll-utest-objs    += theap.o
 endif # ($(filter y,$(prheap_kconf)),)
@@ -92,7 +99,10 @@ ifneq ($(filter y,$(CONFIG_STROLL_ARRAY) $(list_kconf)),)
 checkbins                 += stroll-sort-ptest
 stroll-sort-ptest-objs    := sort_ptest.o
 stroll-sort-ptest-cflags  := $(test-cflags)
-stroll-sort-ptest-ldflags := $(ptest-ldflags) -lm
+stroll-sort-ptest-ldflags := $(ptest-ldflags) \
+                             $(call kconf_enabled,STROLL_ARRAY_MT_UTILS,\
+                                    -lpthread) \
+                             -lm
 
 endif # ($(filter y,$(CONFIG_STROLL_ARRAY) $(list_kconf)),)
 
@@ -101,6 +111,42 @@ stroll-heap-ptest-objs    := heap_ptest.o
 stroll-heap-ptest-cflags  := $(test-cflags)
 stroll-heap-ptest-ldflags := $(ptest-ldflags) -lm
 
+ifneq ($(filter y,$(CONFIG_STROLL_BLOOM) $(CONFIG_STROLL_CUCKOO)),)
+
+checkbins                   += stroll-filter-ptest
+stroll-filter-ptest-objs    := filter_ptest.o
+stroll-filter-ptest-cflags  := $(test-cflags)
+stroll-filter-ptest-ldflags := $(ptest-ldflags) -lm
+
+endif # ($(filter y,$(CONFIG_STROLL_BLOOM) $(CONFIG_STROLL_CUCKOO)),)
+
+checkbins                  += $(call kconf_enabled,STROLL_FBMAP_SIMD,\
+                                     stroll-fbmap-ptest)
+stroll-fbmap-ptest-objs    := fbmap_ptest.o
+stroll-fbmap-ptest-cflags  := $(test-cflags)
+stroll-fbmap-ptest-ldflags := $(ptest-ldflags) -lm
+
+ifeq ($(CONFIG_STROLL_HBMAP)$(CONFIG_STROLL_FBMAP),yy)
+
+checkbins                  += stroll-hbmap-ptest
+stroll-hbmap-ptest-objs    := hbmap_ptest.o
+stroll-hbmap-ptest-cflags  := $(test-cflags)
+stroll-hbmap-ptest-ldflags := $(ptest-ldflags) -lm
+
+endif # ($(CONFIG_STROLL_HBMAP)$(CONFIG_STROLL_FBMAP),yy)
+
+checkbins                    += $(call kconf_enabled,STROLL_IDALLOC,\
+                                       stroll-idalloc-ptest)
+stroll-idalloc-ptest-objs    := idalloc_ptest.o
+stroll-idalloc-ptest-cflags  := $(test-cflags)
+stroll-idalloc-ptest-ldflags := $(ptest-ldflags) -lpthread -lm
+
+checkbins                    += $(call kconf_enabled,STROLL_RBMAP,\
+                                       stroll-rbmap-ptest)
+stroll-rbmap-ptest-objs      := rbmap_ptest.o
+stroll-rbmap-ptest-cflags    := $(test-cflags)
+stroll-rbmap-ptest-ldflags   := $(ptest-ldflags) -lm
+
 define ptest_data_files_cmds
 for n in $(1); do
 	for s in $(2); do
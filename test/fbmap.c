@@ -12,6 +12,9 @@
 #include <cute/expect.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #if (__WORDSIZE != 32) && (__WORDSIZE != 64)
 #error "Unsupported machine word size !"
@@ -656,11 +659,15 @@ STROLLUT_FBMAP_NO64BITS(strollut_fbmap_test_range_129)
 
 static struct stroll_fbmap strollut_fbmap;
 static bool                strollut_fbmap_tofree;
+static struct stroll_fbmap strollut_fbmap_first;
+static struct stroll_fbmap strollut_fbmap_second;
+static bool                strollut_fbmap_operands_tofree;
 
 static void
 strollut_fbmap_setup(void)
 {
 	strollut_fbmap_tofree = false;
+	strollut_fbmap_operands_tofree = false;
 }
 
 static void
@@ -670,6 +677,12 @@ strollut_fbmap_teardown(void)
 		stroll_fbmap_fini(&strollut_fbmap);
 		strollut_fbmap_tofree = false;
 	}
+
+	if (strollut_fbmap_operands_tofree) {
+		stroll_fbmap_fini(&strollut_fbmap_first);
+		stroll_fbmap_fini(&strollut_fbmap_second);
+		strollut_fbmap_operands_tofree = false;
+	}
 }
 
 static void
@@ -1455,6 +1468,1585 @@ STROLLUT_FBMAP_NO64BITS(strollut_fbmap_toggle_all_128)
 STROLLUT_FBMAP_NO64BITS(strollut_fbmap_toggle_all_129)
 #endif /* __WORDSIZE == 64 */
 
+/*
+ * Bit counts exercising partial head / tail words as well as partial and whole
+ * vectors of all supported instruction sets.
+ */
+static const unsigned int strollut_fbmap_bulk_nr[] = {
+	1, 63, 64, 65, 127, 128, 129, 255, 256, 257, 511, 512, 513,
+	1023, 1024, 1025, 2047, 2048, 2049, 4095, 4096, 4097, 10000
+};
+
+#if defined(CONFIG_STROLL_FBMAP_SIMD)
+
+static unsigned int
+strollut_fbmap_simd_hweight(const struct stroll_fbmap * bmap)
+{
+	unsigned int b;
+	unsigned int hw = 0;
+
+	for (b = 0; b < bmap->nr; b++)
+		hw += stroll_fbmap_test(bmap, b);
+
+	return hw;
+}
+
+static bool
+strollut_fbmap_simd_test_range(const struct stroll_fbmap * bmap,
+                               unsigned int                start_bit,
+                               unsigned int                bit_count)
+{
+	unsigned int b;
+
+	for (b = start_bit; b < (start_bit + bit_count); b++)
+		if (stroll_fbmap_test(bmap, b))
+			return true;
+
+	return false;
+}
+
+static void
+strollut_fbmap_simd_check_ranges(const struct stroll_fbmap * bmap)
+{
+	unsigned int start;
+
+	for (start = 0; start < bmap->nr; start += 61) {
+		unsigned int cnt;
+
+		for (cnt = 1; (start + cnt) <= bmap->nr; cnt = (cnt * 3) + 1)
+			cute_check_bool(
+				stroll_fbmap_test_range(bmap, start, cnt),
+				is,
+				strollut_fbmap_simd_test_range(bmap,
+				                               start,
+				                               cnt));
+	}
+}
+
+static void
+strollut_fbmap_simd_check(unsigned int nr)
+{
+	struct stroll_fbmap ref;
+	unsigned int        b;
+
+	cute_check_sint(stroll_fbmap_init_clear(&strollut_fbmap, nr),
+	                equal,
+	                0);
+	strollut_fbmap_tofree = true;
+
+	/* Empty bitmap with garbage bits beyond the last significant one. */
+	if (stroll_fbmap_word_bit_no(nr))
+		strollut_fbmap.bits[stroll_fbmap_word_nr(nr) - 1] =
+			~((1UL << stroll_fbmap_word_bit_no(nr)) - 1);
+	cute_check_uint(stroll_fbmap_hweight(&strollut_fbmap), equal, 0);
+	cute_check_bool(stroll_fbmap_test_all(&strollut_fbmap), is, false);
+	strollut_fbmap_simd_check_ranges(&strollut_fbmap);
+
+	/* Single bit set at the last position. */
+	stroll_fbmap_set(&strollut_fbmap, nr - 1);
+	cute_check_uint(stroll_fbmap_hweight(&strollut_fbmap), equal, 1);
+	cute_check_bool(stroll_fbmap_test_all(&strollut_fbmap), is, true);
+	strollut_fbmap_simd_check_ranges(&strollut_fbmap);
+
+	/* Sparse pseudo random content. */
+	stroll_fbmap_clear_all(&strollut_fbmap);
+	for (b = 0; b < nr; b += (b % 7) + (b % 13) + 1)
+		stroll_fbmap_set(&strollut_fbmap, b);
+	cute_check_uint(stroll_fbmap_hweight(&strollut_fbmap),
+	                equal,
+	                strollut_fbmap_simd_hweight(&strollut_fbmap));
+	strollut_fbmap_simd_check_ranges(&strollut_fbmap);
+
+	/* Toggling MUST invert all significant bits. */
+	cute_check_sint(stroll_fbmap_init_dup(&ref, &strollut_fbmap),
+	                equal,
+	                0);
+	stroll_fbmap_toggle_all(&strollut_fbmap);
+	for (b = 0; b < nr; b++)
+		cute_check_bool(stroll_fbmap_test(&strollut_fbmap, b),
+		                is,
+		                !stroll_fbmap_test(&ref, b));
+	cute_check_uint(stroll_fbmap_hweight(&strollut_fbmap),
+	                equal,
+	                nr - stroll_fbmap_hweight(&ref));
+	strollut_fbmap_simd_check_ranges(&strollut_fbmap);
+	stroll_fbmap_fini(&ref);
+
+	stroll_fbmap_fini(&strollut_fbmap);
+	strollut_fbmap_tofree = false;
+}
+
+CUTE_TEST(strollut_fbmap_simd)
+{
+	enum stroll_fbmap_isa orig = stroll_fbmap_get_isa();
+	int                   isa;
+
+	cute_check_sint(orig, greater_equal, STROLL_FBMAP_SCALAR_ISA);
+	cute_check_sint(orig, lower, STROLL_FBMAP_ISA_NR);
+
+	for (isa = STROLL_FBMAP_SCALAR_ISA; isa < STROLL_FBMAP_ISA_NR; isa++) {
+		unsigned int n;
+
+		if (stroll_fbmap_select_isa((enum stroll_fbmap_isa)isa)) {
+			/* Load time selection picks the most capable ISA. */
+			cute_check_sint(isa, greater, orig);
+			continue;
+		}
+
+		cute_check_sint(stroll_fbmap_get_isa(), equal, isa);
+		for (n = 0; n < stroll_array_nr(strollut_fbmap_bulk_nr); n++)
+			strollut_fbmap_simd_check(strollut_fbmap_bulk_nr[n]);
+	}
+
+	cute_check_sint(stroll_fbmap_select_isa(orig), equal, 0);
+}
+
+#else  /* !defined(CONFIG_STROLL_FBMAP_SIMD) */
+
+CUTE_TEST(strollut_fbmap_simd)
+{
+	cute_skip("SIMD support not compiled in");
+}
+
+#endif /* defined(CONFIG_STROLL_FBMAP_SIMD) */
+
+/*
+ * Run a check against all bit counts of strollut_fbmap_bulk_nr using all bulk
+ * kernels the CPU supports.
+ */
+static void
+strollut_fbmap_check_bulk(void (* check)(unsigned int))
+{
+	unsigned int n;
+
+#if defined(CONFIG_STROLL_FBMAP_SIMD)
+	enum stroll_fbmap_isa orig = stroll_fbmap_get_isa();
+	int                   isa;
+
+	for (isa = STROLL_FBMAP_SCALAR_ISA; isa < STROLL_FBMAP_ISA_NR; isa++) {
+		if (stroll_fbmap_select_isa((enum stroll_fbmap_isa)isa))
+			continue;
+
+		for (n = 0; n < stroll_array_nr(strollut_fbmap_bulk_nr); n++)
+			check(strollut_fbmap_bulk_nr[n]);
+	}
+
+	cute_check_sint(stroll_fbmap_select_isa(orig), equal, 0);
+#else  /* !defined(CONFIG_STROLL_FBMAP_SIMD) */
+	for (n = 0; n < stroll_array_nr(strollut_fbmap_bulk_nr); n++)
+		check(strollut_fbmap_bulk_nr[n]);
+#endif /* defined(CONFIG_STROLL_FBMAP_SIMD) */
+}
+
+/*
+ * Initialize operand bitmaps with patterns giving bits set into first only,
+ * second only, both and none.
+ */
+static void
+strollut_fbmap_init_operands(unsigned int nr)
+{
+	unsigned int b;
+
+	cute_check_sint(stroll_fbmap_init_clear(&strollut_fbmap_first, nr),
+	                equal,
+	                0);
+	cute_check_sint(stroll_fbmap_init_clear(&strollut_fbmap_second, nr),
+	                equal,
+	                0);
+	strollut_fbmap_operands_tofree = true;
+	cute_check_sint(stroll_fbmap_init_clear(&strollut_fbmap, nr),
+	                equal,
+	                0);
+	strollut_fbmap_tofree = true;
+
+	for (b = 0; b < nr; b++) {
+		if (!(b % 3) || ((b % 7) == 1))
+			stroll_fbmap_set(&strollut_fbmap_first, b);
+		if ((b % 5) < 2)
+			stroll_fbmap_set(&strollut_fbmap_second, b);
+	}
+}
+
+static void
+strollut_fbmap_fini_operands(void)
+{
+	stroll_fbmap_fini(&strollut_fbmap_first);
+	stroll_fbmap_fini(&strollut_fbmap_second);
+	strollut_fbmap_operands_tofree = false;
+	stroll_fbmap_fini(&strollut_fbmap);
+	strollut_fbmap_tofree = false;
+}
+
+#define STROLLUT_FBMAP_DEFINE_CHECK_BINOP(_check, _func, _op) \
+	static void \
+	_check(unsigned int nr) \
+	{ \
+		unsigned int b; \
+		bool         fst; \
+		bool         snd; \
+		\
+		strollut_fbmap_init_operands(nr); \
+		\
+		_func(&strollut_fbmap, \
+		      &strollut_fbmap_first, \
+		      &strollut_fbmap_second); \
+		for (b = 0; b < nr; b++) { \
+			fst = stroll_fbmap_test(&strollut_fbmap_first, b); \
+			snd = stroll_fbmap_test(&strollut_fbmap_second, b); \
+			cute_check_bool(stroll_fbmap_test(&strollut_fbmap, b), \
+			                is, \
+			                fst _op snd); \
+		} \
+		\
+		/* Result may be stored into the first operand. */ \
+		_func(&strollut_fbmap_first, \
+		      &strollut_fbmap_first, \
+		      &strollut_fbmap_second); \
+		cute_check_mem(strollut_fbmap_first.bits, \
+		               equal, \
+		               strollut_fbmap.bits, \
+		               stroll_fbmap_word_nr(nr) * \
+		               sizeof(strollut_fbmap.bits[0])); \
+		\
+		strollut_fbmap_fini_operands(); \
+	}
+
+STROLLUT_FBMAP_DEFINE_CHECK_BINOP(strollut_fbmap_check_and,
+                                  stroll_fbmap_and,
+                                  &&)
+STROLLUT_FBMAP_DEFINE_CHECK_BINOP(strollut_fbmap_check_or,
+                                  stroll_fbmap_or,
+                                  ||)
+STROLLUT_FBMAP_DEFINE_CHECK_BINOP(strollut_fbmap_check_xor,
+                                  stroll_fbmap_xor,
+                                  !=)
+STROLLUT_FBMAP_DEFINE_CHECK_BINOP(strollut_fbmap_check_andnot,
+                                  stroll_fbmap_andnot,
+                                  > )
+
+CUTE_TEST(strollut_fbmap_and)
+{
+	strollut_fbmap_check_bulk(strollut_fbmap_check_and);
+}
+
+CUTE_TEST(strollut_fbmap_or)
+{
+	strollut_fbmap_check_bulk(strollut_fbmap_check_or);
+}
+
+CUTE_TEST(strollut_fbmap_xor)
+{
+	strollut_fbmap_check_bulk(strollut_fbmap_check_xor);
+}
+
+CUTE_TEST(strollut_fbmap_andnot)
+{
+	strollut_fbmap_check_bulk(strollut_fbmap_check_andnot);
+}
+
+static void
+strollut_fbmap_check_hweight_and(unsigned int nr)
+{
+	unsigned int b;
+	unsigned int hw = 0;
+
+	strollut_fbmap_init_operands(nr);
+
+	for (b = 0; b < nr; b++)
+		hw += stroll_fbmap_test(&strollut_fbmap_first, b) &&
+		      stroll_fbmap_test(&strollut_fbmap_second, b);
+	cute_check_uint(stroll_fbmap_hweight_and(&strollut_fbmap_first,
+	                                         &strollut_fbmap_second),
+	                equal,
+	                hw);
+
+	/* Bits beyond the last significant one MUST be ignored. */
+	stroll_fbmap_set_all(&strollut_fbmap_first);
+	if (stroll_fbmap_word_bit_no(nr))
+		strollut_fbmap.bits[stroll_fbmap_word_nr(nr) - 1] =
+			~((1UL << stroll_fbmap_word_bit_no(nr)) - 1);
+	cute_check_uint(stroll_fbmap_hweight_and(&strollut_fbmap_first,
+	                                         &strollut_fbmap),
+	                equal,
+	                0);
+	cute_check_uint(stroll_fbmap_hweight_and(&strollut_fbmap_first,
+	                                         &strollut_fbmap_first),
+	                equal,
+	                nr);
+
+	strollut_fbmap_fini_operands();
+}
+
+CUTE_TEST(strollut_fbmap_hweight_and)
+{
+	strollut_fbmap_check_bulk(strollut_fbmap_check_hweight_and);
+}
+
+static void
+strollut_fbmap_check_intersects(unsigned int nr)
+{
+	unsigned int b;
+
+	strollut_fbmap_init_operands(nr);
+
+	/* Build disjoint bitmaps. */
+	stroll_fbmap_andnot(&strollut_fbmap,
+	                    &strollut_fbmap_first,
+	                    &strollut_fbmap_second);
+	cute_check_bool(stroll_fbmap_intersects(&strollut_fbmap,
+	                                        &strollut_fbmap_second),
+	                is,
+	                false);
+
+	/* Bits beyond the last significant one MUST be ignored. */
+	if (stroll_fbmap_word_bit_no(nr)) {
+		unsigned int  bit = stroll_fbmap_word_bit_no(nr);
+		unsigned long msk = ~((1UL << bit) - 1);
+
+		strollut_fbmap.bits[stroll_fbmap_word_nr(nr) - 1] |= msk;
+		strollut_fbmap_second.bits[stroll_fbmap_word_nr(nr) - 1] |= msk;
+		cute_check_bool(stroll_fbmap_intersects(&strollut_fbmap,
+		                                        &strollut_fbmap_second),
+		                is,
+		                false);
+	}
+
+	/* Make them share a single bit. */
+	for (b = 0; b < nr; b += 97) {
+		bool fst = stroll_fbmap_test(&strollut_fbmap, b);
+		bool snd = stroll_fbmap_test(&strollut_fbmap_second, b);
+
+		stroll_fbmap_set(&strollut_fbmap, b);
+		stroll_fbmap_set(&strollut_fbmap_second, b);
+		cute_check_bool(stroll_fbmap_intersects(&strollut_fbmap,
+		                                        &strollut_fbmap_second),
+		                is,
+		                true);
+		cute_check_bool(stroll_fbmap_intersects(&strollut_fbmap_second,
+		                                        &strollut_fbmap),
+		                is,
+		                true);
+
+		if (!fst)
+			stroll_fbmap_clear(&strollut_fbmap, b);
+		if (!snd)
+			stroll_fbmap_clear(&strollut_fbmap_second, b);
+	}
+
+	strollut_fbmap_fini_operands();
+}
+
+CUTE_TEST(strollut_fbmap_intersects)
+{
+	strollut_fbmap_check_bulk(strollut_fbmap_check_intersects);
+}
+
+static void
+strollut_fbmap_check_is_subset(unsigned int nr)
+{
+	unsigned int b;
+
+	strollut_fbmap_init_operands(nr);
+
+	/* Empty bitmap is a subset of any bitmap. */
+	cute_check_bool(stroll_fbmap_is_subset(&strollut_fbmap,
+	                                       &strollut_fbmap_first),
+	                is,
+	                true);
+
+	/* Intersection is a subset of both operands. */
+	stroll_fbmap_and(&strollut_fbmap,
+	                 &strollut_fbmap_first,
+	                 &strollut_fbmap_second);
+	cute_check_bool(stroll_fbmap_is_subset(&strollut_fbmap,
+	                                       &strollut_fbmap_first),
+	                is,
+	                true);
+	cute_check_bool(stroll_fbmap_is_subset(&strollut_fbmap,
+	                                       &strollut_fbmap_second),
+	                is,
+	                true);
+	cute_check_bool(stroll_fbmap_is_subset(&strollut_fbmap,
+	                                       &strollut_fbmap),
+	                is,
+	                true);
+
+	/* Bits beyond the last significant one MUST be ignored. */
+	if (stroll_fbmap_word_bit_no(nr)) {
+		strollut_fbmap.bits[stroll_fbmap_word_nr(nr) - 1] |=
+			~((1UL << stroll_fbmap_word_bit_no(nr)) - 1);
+		cute_check_bool(stroll_fbmap_is_subset(&strollut_fbmap,
+		                                       &strollut_fbmap_first),
+		                is,
+		                true);
+	}
+
+	/* A single extra bit breaks inclusion. */
+	for (b = 0; b < nr; b += 97) {
+		if (stroll_fbmap_test(&strollut_fbmap_first, b))
+			continue;
+
+		stroll_fbmap_set(&strollut_fbmap, b);
+		cute_check_bool(stroll_fbmap_is_subset(&strollut_fbmap,
+		                                       &strollut_fbmap_first),
+		                is,
+		                false);
+		stroll_fbmap_clear(&strollut_fbmap, b);
+	}
+
+	strollut_fbmap_fini_operands();
+}
+
+CUTE_TEST(strollut_fbmap_is_subset)
+{
+	strollut_fbmap_check_bulk(strollut_fbmap_check_is_subset);
+}
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_fbmap_binop_assert)
+{
+	bool         res __unused;
+	unsigned int hw __unused;
+
+	cute_check_sint(stroll_fbmap_init_clear(&strollut_fbmap_first, 64),
+	                equal,
+	                0);
+	cute_check_sint(stroll_fbmap_init_clear(&strollut_fbmap_second, 65),
+	                equal,
+	                0);
+	strollut_fbmap_operands_tofree = true;
+	cute_check_sint(stroll_fbmap_init_clear(&strollut_fbmap, 64),
+	                equal,
+	                0);
+	strollut_fbmap_tofree = true;
+
+	cute_expect_assertion(stroll_fbmap_and(&strollut_fbmap,
+	                                       &strollut_fbmap_first,
+	                                       &strollut_fbmap_second));
+	cute_expect_assertion(stroll_fbmap_or(&strollut_fbmap,
+	                                      &strollut_fbmap_second,
+	                                      &strollut_fbmap_first));
+	cute_expect_assertion(stroll_fbmap_xor(&strollut_fbmap_second,
+	                                       &strollut_fbmap,
+	                                       &strollut_fbmap_first));
+	cute_expect_assertion(hw = stroll_fbmap_hweight_and(
+		&strollut_fbmap_first,
+		&strollut_fbmap_second));
+	cute_expect_assertion(res = stroll_fbmap_intersects(
+		&strollut_fbmap_first,
+		&strollut_fbmap_second));
+	cute_expect_assertion(res = stroll_fbmap_is_subset(
+		&strollut_fbmap_first,
+		&strollut_fbmap_second));
+
+	strollut_fbmap_fini_operands();
+}
+#else
+STROLLUT_FBMAP_NOASSERT(strollut_fbmap_binop_assert)
+#endif
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_fbmap_extract_set_assert)
+{
+	uint32_t     idx[4];
+	unsigned int cnt __unused;
+
+	cute_check_sint(stroll_fbmap_init_clear(&strollut_fbmap, 65),
+	                equal,
+	                0);
+	strollut_fbmap_tofree = true;
+
+	cute_expect_assertion(cnt = stroll_fbmap_extract_set(NULL, 0, idx, 4));
+	cute_expect_assertion(
+		cnt = stroll_fbmap_extract_set(&strollut_fbmap, 66, idx, 4));
+	cute_expect_assertion(
+		cnt = stroll_fbmap_extract_set(&strollut_fbmap, 0, NULL, 4));
+	cute_expect_assertion(
+		cnt = stroll_fbmap_extract_set(&strollut_fbmap, 0, idx, 0));
+}
+#else
+STROLLUT_FBMAP_NOASSERT(strollut_fbmap_extract_set_assert)
+#endif
+
+/*
+ * Check stroll_fbmap_extract_set() output against stroll_fbmap_foreach_set()
+ * for multiple start bits and output array sizes, resuming decoding until the
+ * end of bitmap is reached.
+ */
+static void
+strollut_fbmap_check_extract_bmap(const struct stroll_fbmap * bmap)
+{
+	static const unsigned int maxes[] = { 1, 7, 8, 16, 17, 63, 100 };
+	unsigned int              nr = stroll_fbmap_nr(bmap);
+	unsigned int              starts[] = { 0, 1, 63, 64, 65, nr / 2, nr };
+	struct stroll_fbmap_iter  iter;
+	int                       b;
+	uint32_t *                xpct;
+	uint32_t *                idx;
+	unsigned int              hw = 0;
+	unsigned int              s;
+
+	xpct = malloc(nr * sizeof(xpct[0]));
+	cute_check_ptr(xpct, unequal, NULL);
+	idx = malloc(nr * sizeof(idx[0]));
+	cute_check_ptr(idx, unequal, NULL);
+
+	stroll_fbmap_foreach_set(&iter, bmap, b)
+		xpct[hw++] = (uint32_t)b;
+
+	for (s = 0; s < stroll_array_nr(starts); s++) {
+		unsigned int start = starts[s];
+		unsigned int first = 0;
+		unsigned int m;
+
+		if (start > nr)
+			continue;
+
+		while ((first < hw) && (xpct[first] < start))
+			first++;
+
+		/* Decode all at once. */
+		cute_check_uint(stroll_fbmap_extract_set(bmap, start, idx, nr),
+		                equal,
+		                hw - first);
+		cute_check_mem(idx, equal, &xpct[first], (hw - first) * 4);
+
+		/* Decode into a limited output array, resuming till the end. */
+		for (m = 0; m < stroll_array_nr(maxes); m++) {
+			unsigned int max = stroll_min(maxes[m], nr);
+			unsigned int bit = start;
+			unsigned int cnt = first;
+
+			while (true) {
+				unsigned int n;
+
+				n = stroll_fbmap_extract_set(bmap,
+				                             bit,
+				                             idx,
+				                             max);
+				cute_check_uint(n, lower_equal, max);
+				cute_check_uint(n, lower_equal, hw - cnt);
+				cute_check_mem(idx, equal, &xpct[cnt], n * 4);
+				cnt += n;
+				if (n < max)
+					break;
+				bit = idx[n - 1] + 1;
+			}
+
+			cute_check_uint(cnt, equal, hw);
+		}
+	}
+
+	free(idx);
+	free(xpct);
+}
+
+static void
+strollut_fbmap_check_extract(unsigned int nr)
+{
+	unsigned int b;
+
+	strollut_fbmap_init_operands(nr);
+
+	/* Mixed density patterns. */
+	strollut_fbmap_check_extract_bmap(&strollut_fbmap_first);
+	strollut_fbmap_check_extract_bmap(&strollut_fbmap_second);
+
+	/* Sparse. */
+	for (b = 0; b < nr; b += 37)
+		stroll_fbmap_set(&strollut_fbmap, b);
+	strollut_fbmap_check_extract_bmap(&strollut_fbmap);
+
+	/* Dense. */
+	stroll_fbmap_set_all(&strollut_fbmap);
+	strollut_fbmap_check_extract_bmap(&strollut_fbmap);
+
+	/* Empty. */
+	stroll_fbmap_clear_all(&strollut_fbmap);
+	strollut_fbmap_check_extract_bmap(&strollut_fbmap);
+
+	strollut_fbmap_fini_operands();
+}
+
+CUTE_TEST(strollut_fbmap_extract_set)
+{
+	strollut_fbmap_check_bulk(strollut_fbmap_check_extract);
+}
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_fbmap_find_clear_run_assert)
+{
+	int err __unused;
+
+	cute_check_sint(stroll_fbmap_init_clear(&strollut_fbmap, 65),
+	                equal,
+	                0);
+	strollut_fbmap_tofree = true;
+
+	cute_expect_assertion(err = stroll_fbmap_find_clear_run(NULL, 1, 0));
+	cute_expect_assertion(
+		err = stroll_fbmap_find_clear_run(&strollut_fbmap, 0, 0));
+	cute_expect_assertion(
+		err = stroll_fbmap_find_clear_run(&strollut_fbmap, 1, 66));
+	cute_expect_assertion(err = stroll_fbmap_find_best_clear_run(NULL, 1));
+	cute_expect_assertion(
+		err = stroll_fbmap_find_best_clear_run(&strollut_fbmap, 0));
+}
+#else
+STROLLUT_FBMAP_NOASSERT(strollut_fbmap_find_clear_run_assert)
+#endif
+
+/*
+ * Check stroll_fbmap_find_clear_run() and stroll_fbmap_find_best_clear_run()
+ * results against a reference computed from the length of cleared runs
+ * starting at each bit of bitmap.
+ */
+static void
+strollut_fbmap_check_clear_run_bmap(const struct stroll_fbmap * bmap)
+{
+	static const unsigned int lens[] = {
+		1, 2, 3, 31, 63, 64, 65, 100, 129, 200
+	};
+	unsigned int              nr = stroll_fbmap_nr(bmap);
+	unsigned int              hints[] = {
+		0, 1, 63, 64, nr / 2, nr - 1, nr
+	};
+	unsigned int *            runs;
+	unsigned int              l;
+	unsigned int              b;
+
+	runs = malloc((nr + 1) * sizeof(runs[0]));
+	cute_check_ptr(runs, unequal, NULL);
+
+	runs[nr] = 0;
+	for (b = nr; b-- > 0;)
+		runs[b] = stroll_fbmap_test(bmap, b) ? 0 : runs[b + 1] + 1;
+
+	for (l = 0; l < stroll_array_nr(lens); l++) {
+		unsigned int len = lens[l];
+		unsigned int h;
+		int          xpct = -ENOSPC;
+
+		/* Best fit: smallest run first, lowest one on equality. */
+		for (b = 0; b < nr; b++) {
+			if ((!b || !runs[b - 1]) && (runs[b] >= len) &&
+			    ((xpct < 0) || (runs[b] < runs[xpct])))
+				xpct = (int)b;
+		}
+		cute_check_sint(stroll_fbmap_find_best_clear_run(bmap, len),
+		                equal,
+		                xpct);
+
+		/* Next fit: first fit from hint, then wrap around. */
+		for (h = 0; h < stroll_array_nr(hints); h++) {
+			unsigned int hint = (hints[h] == nr) ? 0 : hints[h];
+
+			if (hints[h] > nr)
+				continue;
+
+			xpct = -ENOSPC;
+			for (b = hint; b < nr; b++) {
+				if (runs[b] >= len) {
+					xpct = (int)b;
+					break;
+				}
+			}
+			for (b = 0; (xpct < 0) && (b < hint); b++) {
+				if (runs[b] >= len) {
+					xpct = (int)b;
+					break;
+				}
+			}
+
+			cute_check_sint(stroll_fbmap_find_clear_run(bmap,
+			                                            len,
+			                                            hints[h]),
+			                equal,
+			                xpct);
+		}
+	}
+
+	free(runs);
+}
+
+CUTE_TEST(strollut_fbmap_find_clear_run)
+{
+	unsigned int n;
+
+	for (n = 0; n < stroll_array_nr(strollut_fbmap_bulk_nr); n++) {
+		unsigned int nr = strollut_fbmap_bulk_nr[n];
+		unsigned int gap = 1;
+		unsigned int b;
+
+		strollut_fbmap_init_operands(nr);
+
+		/* Short runs. */
+		strollut_fbmap_check_clear_run_bmap(&strollut_fbmap_first);
+		strollut_fbmap_check_clear_run_bmap(&strollut_fbmap_second);
+
+		/* Empty. */
+		strollut_fbmap_check_clear_run_bmap(&strollut_fbmap);
+
+		/* Runs of varying lengths, up to a few words. */
+		for (b = 0; b < nr; b += gap) {
+			stroll_fbmap_set(&strollut_fbmap, b);
+			gap = ((gap * 7) % 211) + 1;
+		}
+		strollut_fbmap_check_clear_run_bmap(&strollut_fbmap);
+
+		/* Single run at the end. */
+		stroll_fbmap_set_all(&strollut_fbmap);
+		for (b = nr - stroll_min(nr, 130U); b < nr; b++)
+			stroll_fbmap_clear(&strollut_fbmap, b);
+		strollut_fbmap_check_clear_run_bmap(&strollut_fbmap);
+
+		/* Full. */
+		stroll_fbmap_set_all(&strollut_fbmap);
+		strollut_fbmap_check_clear_run_bmap(&strollut_fbmap);
+
+		strollut_fbmap_fini_operands();
+	}
+}
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_fbmap_rank_assert)
+{
+	struct stroll_fbmap_rank rank;
+	unsigned int             cnt __unused;
+	int                      err __unused;
+
+	cute_check_sint(stroll_fbmap_init_clear(&strollut_fbmap, 65),
+	                equal,
+	                0);
+	strollut_fbmap_tofree = true;
+
+	cute_expect_assertion(err = stroll_fbmap_init_rank(NULL,
+	                                                   &strollut_fbmap));
+	cute_expect_assertion(err = stroll_fbmap_init_rank(&rank, NULL));
+
+	cute_check_sint(stroll_fbmap_init_rank(&rank, &strollut_fbmap),
+	                equal,
+	                0);
+	cute_expect_assertion(cnt = stroll_fbmap_rank(NULL, 0));
+	cute_expect_assertion(cnt = stroll_fbmap_rank(&rank, 66));
+	cute_expect_assertion(err = stroll_fbmap_select(NULL, 0));
+	cute_expect_assertion(cnt = stroll_fbmap_rank_hweight(NULL));
+	cute_expect_assertion(stroll_fbmap_fini_rank(NULL));
+	stroll_fbmap_fini_rank(&rank);
+}
+#else
+STROLLUT_FBMAP_NOASSERT(strollut_fbmap_rank_assert)
+#endif
+
+/*
+ * Check rank and select results against a linear scan of bitmap for all
+ * possible bit indices and ranks.
+ */
+static void
+strollut_fbmap_check_rank_bmap(const struct stroll_fbmap * bmap)
+{
+	struct stroll_fbmap_rank rank;
+	unsigned int             nr = stroll_fbmap_nr(bmap);
+	unsigned int             cnt = 0;
+	unsigned int             b;
+
+	cute_check_sint(stroll_fbmap_init_rank(&rank, bmap), equal, 0);
+
+	for (b = 0; b < nr; b++) {
+		cute_check_uint(stroll_fbmap_rank(&rank, b), equal, cnt);
+		if (stroll_fbmap_test(bmap, b)) {
+			cute_check_sint(stroll_fbmap_select(&rank, cnt),
+			                equal,
+			                (int)b);
+			cnt++;
+		}
+	}
+
+	cute_check_uint(stroll_fbmap_rank(&rank, nr), equal, cnt);
+	cute_check_uint(stroll_fbmap_rank_hweight(&rank),
+	                equal,
+	                stroll_fbmap_hweight(bmap));
+	cute_check_sint(stroll_fbmap_select(&rank, cnt), equal, -ENOENT);
+
+	stroll_fbmap_fini_rank(&rank);
+}
+
+static void
+strollut_fbmap_check_rank(unsigned int nr)
+{
+	unsigned int b;
+
+	strollut_fbmap_init_operands(nr);
+
+	/* Mixed density patterns. */
+	strollut_fbmap_check_rank_bmap(&strollut_fbmap_first);
+	strollut_fbmap_check_rank_bmap(&strollut_fbmap_second);
+
+	/* Empty. */
+	strollut_fbmap_check_rank_bmap(&strollut_fbmap);
+
+	/* Sparse. */
+	for (b = 0; b < nr; b += 37)
+		stroll_fbmap_set(&strollut_fbmap, b);
+	strollut_fbmap_check_rank_bmap(&strollut_fbmap);
+
+	/* Dense. */
+	stroll_fbmap_set_all(&strollut_fbmap);
+	strollut_fbmap_check_rank_bmap(&strollut_fbmap);
+
+	/* Dense head followed by a sparse tail. */
+	for (b = nr / 2; b < nr; b++)
+		if (b % 1021)
+			stroll_fbmap_clear(&strollut_fbmap, b);
+	strollut_fbmap_check_rank_bmap(&strollut_fbmap);
+
+	strollut_fbmap_fini_operands();
+}
+
+CUTE_TEST(strollut_fbmap_rank)
+{
+	/* Give select samples a chance to be exercised. */
+	static const unsigned int nrs[] = { 8191, 8192, 8193, 65537 };
+	unsigned int              n;
+
+	strollut_fbmap_check_bulk(strollut_fbmap_check_rank);
+	for (n = 0; n < stroll_array_nr(nrs); n++)
+		strollut_fbmap_check_rank(nrs[n]);
+}
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_fbmap_dyn_assert)
+{
+	struct stroll_fbmap_dyn dyn;
+	int                     err __unused;
+
+	cute_expect_assertion(err = stroll_fbmap_init_dyn(NULL, 1));
+	cute_expect_assertion(err = stroll_fbmap_init_dyn(&dyn, 0));
+	cute_expect_assertion(
+		err = stroll_fbmap_init_dyn(&dyn, (unsigned int)INT_MAX + 1));
+
+	cute_check_sint(stroll_fbmap_init_dyn(&dyn, 1), equal, 0);
+	cute_expect_assertion(err = stroll_fbmap_resize_dyn(NULL, 1));
+	cute_expect_assertion(err = stroll_fbmap_resize_dyn(&dyn, 0));
+	cute_expect_assertion(
+		err = stroll_fbmap_resize_dyn(&dyn, (unsigned int)INT_MAX + 1));
+	cute_expect_assertion(stroll_fbmap_fini_dyn(NULL));
+	stroll_fbmap_fini_dyn(&dyn);
+}
+#else
+STROLLUT_FBMAP_NOASSERT(strollut_fbmap_dyn_assert)
+#endif
+
+/*
+ * Check that bits located below old_nr hold the every third bit pattern and
+ * that bits located beyond are cleared.
+ */
+static void
+strollut_fbmap_check_dyn_bits(const struct stroll_fbmap * bmap,
+                              unsigned int                old_nr)
+{
+	unsigned int nr = stroll_fbmap_nr(bmap);
+	unsigned int b;
+
+	for (b = 0; b < stroll_min(old_nr, nr); b++)
+		cute_check_bool(stroll_fbmap_test(bmap, b), is, !(b % 3));
+	if (nr > old_nr)
+		cute_check_bool(stroll_fbmap_test_range(bmap,
+		                                        old_nr,
+		                                        nr - old_nr),
+		                is,
+		                false);
+}
+
+CUTE_TEST(strollut_fbmap_dyn)
+{
+	/*
+	 * Cross the threshold above which growable bitmaps are backed by
+	 * memory mappings, then shrink and grow back again.
+	 */
+	static const unsigned int nrs[] = {
+		1, 2, 63, 64, 65, 1000, 1024 * 1024, 1024 * 1024 + 1,
+		4 * 1024 * 1024 + 3, 100, 3 * 1024 * 1024, 1, 129, 33
+	};
+	struct stroll_fbmap_dyn   dyn;
+	struct stroll_fbmap *     bmap;
+	unsigned int              n;
+
+	cute_check_sint(stroll_fbmap_init_dyn(&dyn, nrs[0]), equal, 0);
+	bmap = stroll_fbmap_dyn_map(&dyn);
+	cute_check_uint(stroll_fbmap_nr(bmap), equal, nrs[0]);
+	cute_check_bool(stroll_fbmap_test(bmap, 0), is, false);
+
+	for (n = 1; n < stroll_array_nr(nrs); n++) {
+		unsigned int old_nr = stroll_fbmap_nr(bmap);
+		unsigned int b;
+
+		/* Set every third bit, making sure trailing bits are set. */
+		stroll_fbmap_set_all(bmap);
+		for (b = 0; b < old_nr; b++)
+			if (b % 3)
+				stroll_fbmap_clear(bmap, b);
+
+		cute_check_sint(stroll_fbmap_resize_dyn(&dyn, nrs[n]),
+		                equal,
+		                0);
+		cute_check_ptr(stroll_fbmap_dyn_map(&dyn), equal, bmap);
+		cute_check_uint(stroll_fbmap_nr(bmap), equal, nrs[n]);
+		strollut_fbmap_check_dyn_bits(bmap, old_nr);
+	}
+
+	stroll_fbmap_fini_dyn(&dyn);
+}
+
+#if defined(CONFIG_STROLL_FBMAP_FILE)
+
+static char strollut_fbmap_path[64];
+
+/*
+ * Generate an unpredictable file path. Remove the file mkstemp() creates since
+ * stroll_fbmap_create_file() requires a path to a non existing file.
+ */
+static void
+strollut_fbmap_setup_path(void)
+{
+	int fd;
+
+	strcpy(strollut_fbmap_path, "/tmp/strollut-fbmap-XXXXXX");
+	fd = mkstemp(strollut_fbmap_path);
+	cute_check_sint(fd, greater_equal, 0);
+
+	close(fd);
+	unlink(strollut_fbmap_path);
+}
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_fbmap_file_assert)
+{
+	struct stroll_fbmap_file file;
+	int                      err __unused;
+
+	strollut_fbmap_setup_path();
+
+	cute_expect_assertion(
+		err = stroll_fbmap_create_file(NULL,
+		                               strollut_fbmap_path,
+		                               1,
+		                               0600));
+	cute_expect_assertion(
+		err = stroll_fbmap_create_file(&file, NULL, 1, 0600));
+	cute_expect_assertion(
+		err = stroll_fbmap_create_file(&file,
+		                               strollut_fbmap_path,
+		                               0,
+		                               0600));
+	cute_expect_assertion(
+		err = stroll_fbmap_open_file(NULL, strollut_fbmap_path, 0));
+	cute_expect_assertion(err = stroll_fbmap_open_file(&file, NULL, 0));
+	cute_expect_assertion(
+		err = stroll_fbmap_open_file(&file, strollut_fbmap_path, 4));
+
+	cute_check_sint(stroll_fbmap_create_file(&file,
+	                                         strollut_fbmap_path,
+	                                         65,
+	                                         0600),
+	                equal,
+	                0);
+	cute_expect_assertion(err = stroll_fbmap_flush_file_range(NULL, 0, 1));
+	cute_expect_assertion(
+		err = stroll_fbmap_flush_file_range(&file, 0, 0));
+	cute_expect_assertion(
+		err = stroll_fbmap_flush_file_range(&file, 60, 6));
+	cute_expect_assertion(err = stroll_fbmap_sync_file(NULL));
+	cute_expect_assertion(err = stroll_fbmap_close_file(NULL));
+	cute_check_sint(stroll_fbmap_close_file(&file), equal, 0);
+
+	cute_check_sint(stroll_fbmap_open_file(&file,
+	                                       strollut_fbmap_path,
+	                                       STROLL_FBMAP_FILE_RDONLY),
+	                equal,
+	                0);
+	cute_expect_assertion(
+		err = stroll_fbmap_flush_file_range(&file, 0, 1));
+	cute_expect_assertion(err = stroll_fbmap_sync_file(&file));
+	cute_check_sint(stroll_fbmap_close_file(&file), equal, 0);
+
+	unlink(strollut_fbmap_path);
+}
+#else
+STROLLUT_FBMAP_NOASSERT(strollut_fbmap_file_assert)
+#endif
+
+static void
+strollut_fbmap_check_file_bits(const struct stroll_fbmap * bmap,
+                               unsigned int                nr)
+{
+	unsigned int b;
+
+	cute_check_uint(stroll_fbmap_nr(bmap), equal, nr);
+	for (b = 0; b < nr; b++)
+		cute_check_bool(stroll_fbmap_test(bmap, b), is, !(b % 3));
+}
+
+CUTE_TEST(strollut_fbmap_file)
+{
+	static const unsigned int nrs[] = { 1, 63, 64, 65, 100000 };
+	unsigned int              n;
+
+	strollut_fbmap_setup_path();
+
+	for (n = 0; n < stroll_array_nr(nrs); n++) {
+		unsigned int             nr = nrs[n];
+		struct stroll_fbmap_file file;
+		struct stroll_fbmap_file other;
+		struct stroll_fbmap *    bmap;
+		unsigned int             b;
+
+		cute_check_sint(stroll_fbmap_create_file(&file,
+		                                         strollut_fbmap_path,
+		                                         nr,
+		                                         0600),
+		                equal,
+		                0);
+		bmap = stroll_fbmap_file_map(&file);
+		cute_check_uint(stroll_fbmap_nr(bmap), equal, nr);
+		cute_check_uint(stroll_fbmap_hweight(bmap), equal, 0);
+
+		/* Freshly created files are consistent even if never synced. */
+		cute_check_sint(stroll_fbmap_open_file(
+					&other,
+					strollut_fbmap_path,
+					STROLL_FBMAP_FILE_RDONLY |
+					STROLL_FBMAP_FILE_VERIFY),
+		                equal,
+		                0);
+		cute_check_uint(stroll_fbmap_hweight(
+					stroll_fbmap_file_map(&other)),
+		                equal,
+		                0);
+		cute_check_sint(stroll_fbmap_close_file(&other), equal, 0);
+
+		/* Make sure trailing bits do not alter checksum. */
+		stroll_fbmap_set_all(bmap);
+		for (b = 0; b < nr; b++)
+			if (b % 3)
+				stroll_fbmap_clear(bmap, b);
+		cute_check_sint(stroll_fbmap_flush_file_range(&file, 0, nr),
+		                equal,
+		                0);
+		cute_check_sint(stroll_fbmap_flush_file_range(&file, nr - 1, 1),
+		                equal,
+		                0);
+		cute_check_sint(stroll_fbmap_close_file(&file), equal, 0);
+
+		/* Existing files cannot be re-created. */
+		cute_check_sint(stroll_fbmap_create_file(&file,
+		                                         strollut_fbmap_path,
+		                                         nr,
+		                                         0600),
+		                equal,
+		                -EEXIST);
+
+		/* Multiple read-only mappings share the same content. */
+		cute_check_sint(stroll_fbmap_open_file(
+					&file,
+					strollut_fbmap_path,
+					STROLL_FBMAP_FILE_RDONLY |
+					STROLL_FBMAP_FILE_VERIFY),
+		                equal,
+		                0);
+		cute_check_sint(stroll_fbmap_open_file(
+					&other,
+					strollut_fbmap_path,
+					STROLL_FBMAP_FILE_RDONLY),
+		                equal,
+		                0);
+		strollut_fbmap_check_file_bits(stroll_fbmap_file_map(&file),
+		                               nr);
+		strollut_fbmap_check_file_bits(stroll_fbmap_file_map(&other),
+		                               nr);
+		cute_check_sint(stroll_fbmap_close_file(&other), equal, 0);
+		cute_check_sint(stroll_fbmap_close_file(&file), equal, 0);
+
+		/* Modifications are persisted at closing time. */
+		cute_check_sint(
+			stroll_fbmap_open_file(&file, strollut_fbmap_path, 0),
+			equal,
+			0);
+		bmap = stroll_fbmap_file_map(&file);
+		strollut_fbmap_check_file_bits(bmap, nr);
+		stroll_fbmap_toggle(bmap, nr - 1);
+		cute_check_sint(stroll_fbmap_close_file(&file), equal, 0);
+
+		cute_check_sint(
+			stroll_fbmap_open_file(&file,
+			                       strollut_fbmap_path,
+			                       STROLL_FBMAP_FILE_VERIFY),
+			equal,
+			0);
+		bmap = stroll_fbmap_file_map(&file);
+		cute_check_bool(stroll_fbmap_test(bmap, nr - 1),
+		                is,
+		                !!((nr - 1) % 3));
+		stroll_fbmap_toggle(bmap, nr - 1);
+		cute_check_sint(stroll_fbmap_sync_file(&file), equal, 0);
+		cute_check_sint(stroll_fbmap_close_file(&file), equal, 0);
+
+		unlink(strollut_fbmap_path);
+	}
+}
+
+CUTE_TEST(strollut_fbmap_file_corrupt)
+{
+	struct stroll_fbmap_file file;
+	unsigned long            word = ~(0UL);
+	int                      fd;
+
+	strollut_fbmap_setup_path();
+
+	cute_check_sint(stroll_fbmap_open_file(&file, strollut_fbmap_path, 0),
+	                equal,
+	                -ENOENT);
+
+	cute_check_sint(stroll_fbmap_create_file(&file,
+	                                         strollut_fbmap_path,
+	                                         1000,
+	                                         0600),
+	                equal,
+	                0);
+	cute_check_sint(stroll_fbmap_close_file(&file), equal, 0);
+
+	/* Alter bit values behind checksum's back. */
+	fd = open(strollut_fbmap_path, O_WRONLY);
+	cute_check_sint(fd, greater_equal, 0);
+	cute_check_sint(pwrite(fd, &word, sizeof(word), 64 + sizeof(word)),
+	                equal,
+	                sizeof(word));
+
+	cute_check_sint(stroll_fbmap_open_file(&file,
+	                                       strollut_fbmap_path,
+	                                       STROLL_FBMAP_FILE_VERIFY),
+	                equal,
+	                -EBADMSG);
+	cute_check_sint(stroll_fbmap_open_file(&file,
+	                                       strollut_fbmap_path,
+	                                       STROLL_FBMAP_FILE_RDONLY),
+	                equal,
+	                0);
+	cute_check_uint(stroll_fbmap_hweight(stroll_fbmap_file_map(&file)),
+	                equal,
+	                __WORDSIZE);
+	cute_check_sint(stroll_fbmap_close_file(&file), equal, 0);
+
+	/* Truncated file. */
+	cute_check_sint(ftruncate(fd, 64 + sizeof(word)), equal, 0);
+	cute_check_sint(stroll_fbmap_open_file(&file, strollut_fbmap_path, 0),
+	                equal,
+	                -EBADMSG);
+
+	/* Invalid magic. */
+	cute_check_sint(pwrite(fd, &word, sizeof(word), 0),
+	                equal,
+	                sizeof(word));
+	cute_check_sint(stroll_fbmap_open_file(&file, strollut_fbmap_path, 0),
+	                equal,
+	                -EBADMSG);
+
+	close(fd);
+	unlink(strollut_fbmap_path);
+}
+
+#else  /* !defined(CONFIG_STROLL_FBMAP_FILE) */
+
+CUTE_TEST(strollut_fbmap_file_assert)
+{
+	cute_skip("file persistence support not compiled in");
+}
+
+CUTE_TEST(strollut_fbmap_file)
+{
+	cute_skip("file persistence support not compiled in");
+}
+
+CUTE_TEST(strollut_fbmap_file_corrupt)
+{
+	cute_skip("file persistence support not compiled in");
+}
+
+#endif /* defined(CONFIG_STROLL_FBMAP_FILE) */
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_fbmap_atomic_assert)
+{
+	bool          res __unused;
+	int           err __unused;
+	unsigned long xpct = 0;
+
+	cute_check_sint(stroll_fbmap_init_clear(&strollut_fbmap, 65),
+	                equal,
+	                0);
+	strollut_fbmap_tofree = true;
+
+	cute_expect_assertion(
+		res = stroll_fbmap_atomic_test(NULL, 0, STROLL_ATOMIC_RELAXED));
+	cute_expect_assertion(
+		res = stroll_fbmap_atomic_test(&strollut_fbmap,
+		                               65,
+		                               STROLL_ATOMIC_RELAXED));
+	cute_expect_assertion(
+		res = stroll_fbmap_atomic_test(&strollut_fbmap,
+		                               0,
+		                               STROLL_ATOMIC_RELEASE));
+	cute_expect_assertion(
+		res = stroll_fbmap_atomic_test_and_set(&strollut_fbmap,
+		                                       65,
+		                                       STROLL_ATOMIC_ACQUIRE));
+	cute_expect_assertion(
+		res = stroll_fbmap_atomic_test_and_clear(
+			&strollut_fbmap,
+			65,
+			STROLL_ATOMIC_RELEASE));
+	cute_expect_assertion(
+		stroll_fbmap_atomic_set_range(&strollut_fbmap,
+		                              0,
+		                              0,
+		                              STROLL_ATOMIC_RELAXED));
+	cute_expect_assertion(
+		stroll_fbmap_atomic_set_range(&strollut_fbmap,
+		                              60,
+		                              6,
+		                              STROLL_ATOMIC_RELAXED));
+	cute_expect_assertion(
+		stroll_fbmap_atomic_clear_range(&strollut_fbmap,
+		                                65,
+		                                1,
+		                                STROLL_ATOMIC_RELAXED));
+	cute_expect_assertion(
+		err = stroll_fbmap_atomic_find_and_set_first_clear(
+			NULL,
+			STROLL_ATOMIC_ACQUIRE));
+	cute_expect_assertion(
+		res = stroll_fbmap_atomic_cmpxchg_range(&strollut_fbmap,
+		                                        0,
+		                                        0,
+		                                        &xpct,
+		                                        1,
+		                                        STROLL_ATOMIC_ACQ_REL));
+	cute_expect_assertion(
+		res = stroll_fbmap_atomic_cmpxchg_range(&strollut_fbmap,
+		                                        __WORDSIZE - 1,
+		                                        2,
+		                                        &xpct,
+		                                        1,
+		                                        STROLL_ATOMIC_ACQ_REL));
+	cute_expect_assertion(
+		res = stroll_fbmap_atomic_cmpxchg_range(&strollut_fbmap,
+		                                        0,
+		                                        1,
+		                                        NULL,
+		                                        1,
+		                                        STROLL_ATOMIC_ACQ_REL));
+}
+#else
+STROLLUT_FBMAP_NOASSERT(strollut_fbmap_atomic_assert)
+#endif
+
+CUTE_TEST(strollut_fbmap_atomic_test_and_set)
+{
+	unsigned int n;
+
+	for (n = 0; n < stroll_array_nr(strollut_fbmap_bulk_nr); n++) {
+		unsigned int nr = strollut_fbmap_bulk_nr[n];
+		unsigned int b;
+
+		cute_check_sint(stroll_fbmap_init_clear(&strollut_fbmap, nr),
+		                equal,
+		                0);
+		strollut_fbmap_tofree = true;
+
+		for (b = 0; b < nr; b += 3) {
+			cute_check_bool(
+				stroll_fbmap_atomic_test_and_set(
+					&strollut_fbmap,
+					b,
+					STROLL_ATOMIC_ACQUIRE),
+				is,
+				false);
+			cute_check_bool(
+				stroll_fbmap_atomic_test_and_set(
+					&strollut_fbmap,
+					b,
+					STROLL_ATOMIC_ACQUIRE),
+				is,
+				true);
+		}
+
+		for (b = 0; b < nr; b++)
+			cute_check_bool(
+				stroll_fbmap_atomic_test(&strollut_fbmap,
+				                         b,
+				                         STROLL_ATOMIC_ACQUIRE),
+				is,
+				!(b % 3));
+
+		stroll_fbmap_fini(&strollut_fbmap);
+		strollut_fbmap_tofree = false;
+	}
+}
+
+CUTE_TEST(strollut_fbmap_atomic_test_and_clear)
+{
+	unsigned int n;
+
+	for (n = 0; n < stroll_array_nr(strollut_fbmap_bulk_nr); n++) {
+		unsigned int nr = strollut_fbmap_bulk_nr[n];
+		unsigned int b;
+
+		cute_check_sint(stroll_fbmap_init_set(&strollut_fbmap, nr),
+		                equal,
+		                0);
+		strollut_fbmap_tofree = true;
+
+		for (b = 0; b < nr; b += 3) {
+			cute_check_bool(
+				stroll_fbmap_atomic_test_and_clear(
+					&strollut_fbmap,
+					b,
+					STROLL_ATOMIC_RELEASE),
+				is,
+				true);
+			cute_check_bool(
+				stroll_fbmap_atomic_test_and_clear(
+					&strollut_fbmap,
+					b,
+					STROLL_ATOMIC_RELEASE),
+				is,
+				false);
+		}
+
+		for (b = 0; b < nr; b++)
+			cute_check_bool(stroll_fbmap_test(&strollut_fbmap, b),
+			                is,
+			                !!(b % 3));
+
+		stroll_fbmap_fini(&strollut_fbmap);
+		strollut_fbmap_tofree = false;
+	}
+}
+
+static const struct {
+	unsigned int start;
+	unsigned int count;
+} strollut_fbmap_atomic_ranges[] = {
+	{ .start = 0,   .count = 1 },
+	{ .start = 3,   .count = 5 },
+	{ .start = 0,   .count = 64 },
+	{ .start = 31,  .count = 2 },
+	{ .start = 60,  .count = 10 },
+	{ .start = 1,   .count = 190 },
+	{ .start = 64,  .count = 127 },
+	{ .start = 190, .count = 1 }
+};
+
+static void
+strollut_fbmap_check_atomic_range(bool set, enum stroll_atomic_order order)
+{
+	unsigned int r;
+
+	for (r = 0; r < stroll_array_nr(strollut_fbmap_atomic_ranges); r++) {
+		unsigned int start = strollut_fbmap_atomic_ranges[r].start;
+		unsigned int count = strollut_fbmap_atomic_ranges[r].count;
+		unsigned int b;
+
+		if (set) {
+			cute_check_sint(stroll_fbmap_init_clear(&strollut_fbmap,
+			                                        191),
+			                equal,
+			                0);
+			strollut_fbmap_tofree = true;
+			stroll_fbmap_atomic_set_range(&strollut_fbmap,
+			                              start,
+			                              count,
+			                              order);
+		}
+		else {
+			cute_check_sint(stroll_fbmap_init_set(&strollut_fbmap,
+			                                      191),
+			                equal,
+			                0);
+			strollut_fbmap_tofree = true;
+			stroll_fbmap_atomic_clear_range(&strollut_fbmap,
+			                                start,
+			                                count,
+			                                order);
+		}
+
+		for (b = 0; b < 191; b++) {
+			bool in = (b >= start) && (b < (start + count));
+
+			cute_check_bool(stroll_fbmap_test(&strollut_fbmap, b),
+			                is,
+			                in == set);
+		}
+
+		stroll_fbmap_fini(&strollut_fbmap);
+		strollut_fbmap_tofree = false;
+	}
+}
+
+/*
+ * Range operations accept all memory orders, including those that are not
+ * valid for plain stores.
+ */
+static const enum stroll_atomic_order strollut_fbmap_atomic_orders[] = {
+	STROLL_ATOMIC_RELAXED,
+	STROLL_ATOMIC_ACQUIRE,
+	STROLL_ATOMIC_RELEASE,
+	STROLL_ATOMIC_ACQ_REL,
+	STROLL_ATOMIC_SEQ_CST
+};
+
+CUTE_TEST(strollut_fbmap_atomic_set_range)
+{
+	unsigned int o;
+
+	for (o = 0; o < stroll_array_nr(strollut_fbmap_atomic_orders); o++)
+		strollut_fbmap_check_atomic_range(
+			true,
+			strollut_fbmap_atomic_orders[o]);
+}
+
+CUTE_TEST(strollut_fbmap_atomic_clear_range)
+{
+	unsigned int o;
+
+	for (o = 0; o < stroll_array_nr(strollut_fbmap_atomic_orders); o++)
+		strollut_fbmap_check_atomic_range(
+			false,
+			strollut_fbmap_atomic_orders[o]);
+}
+
+CUTE_TEST(strollut_fbmap_atomic_find_and_set_first_clear)
+{
+	unsigned int n;
+
+	for (n = 0; n < stroll_array_nr(strollut_fbmap_bulk_nr); n++) {
+		unsigned int nr = strollut_fbmap_bulk_nr[n];
+		unsigned int b;
+
+		cute_check_sint(stroll_fbmap_init_clear(&strollut_fbmap, nr),
+		                equal,
+		                0);
+		strollut_fbmap_tofree = true;
+
+		/* Pre-occupy every other bit. */
+		for (b = 0; b < nr; b += 2)
+			stroll_fbmap_set(&strollut_fbmap, b);
+
+		for (b = 1; b < nr; b += 2)
+			cute_check_sint(
+				stroll_fbmap_atomic_find_and_set_first_clear(
+					&strollut_fbmap,
+					STROLL_ATOMIC_ACQUIRE),
+				equal,
+				(int)b);
+
+		/* Bits beyond the last one MUST never be returned. */
+		cute_check_sint(
+			stroll_fbmap_atomic_find_and_set_first_clear(
+				&strollut_fbmap,
+				STROLL_ATOMIC_ACQUIRE),
+			equal,
+			-ENOSPC);
+
+		/* Released bits MUST be found again. */
+		stroll_fbmap_clear(&strollut_fbmap, nr / 2);
+		cute_check_sint(
+			stroll_fbmap_atomic_find_and_set_first_clear(
+				&strollut_fbmap,
+				STROLL_ATOMIC_SEQ_CST),
+			equal,
+			(int)(nr / 2));
+
+		stroll_fbmap_fini(&strollut_fbmap);
+		strollut_fbmap_tofree = false;
+	}
+}
+
+CUTE_TEST(strollut_fbmap_atomic_cmpxchg_range)
+{
+	unsigned long xpct = 0;
+
+	cute_check_sint(stroll_fbmap_init_clear(&strollut_fbmap, 129),
+	                equal,
+	                0);
+	strollut_fbmap_tofree = true;
+
+	/* Bits surrounding the range MUST be left untouched. */
+	stroll_fbmap_set(&strollut_fbmap, 3);
+	stroll_fbmap_set(&strollut_fbmap, 12);
+
+	cute_check_bool(
+		stroll_fbmap_atomic_cmpxchg_range(&strollut_fbmap,
+		                                  4,
+		                                  8,
+		                                  &xpct,
+		                                  0xa5,
+		                                  STROLL_ATOMIC_ACQ_REL),
+		is,
+		true);
+	cute_check_hex(strollut_fbmap.bits[0], equal, 0x1a58UL);
+
+	xpct = 0;
+	cute_check_bool(
+		stroll_fbmap_atomic_cmpxchg_range(&strollut_fbmap,
+		                                  4,
+		                                  8,
+		                                  &xpct,
+		                                  0x5a,
+		                                  STROLL_ATOMIC_ACQ_REL),
+		is,
+		false);
+	cute_check_hex(xpct, equal, 0xa5UL);
+	cute_check_hex(strollut_fbmap.bits[0], equal, 0x1a58UL);
+
+	cute_check_bool(
+		stroll_fbmap_atomic_cmpxchg_range(&strollut_fbmap,
+		                                  4,
+		                                  8,
+		                                  &xpct,
+		                                  0x5a,
+		                                  STROLL_ATOMIC_RELEASE),
+		is,
+		true);
+	cute_check_hex(strollut_fbmap.bits[0], equal, 0x15a8UL);
+
+	/* Whole word range. */
+	xpct = 0;
+	cute_check_bool(
+		stroll_fbmap_atomic_cmpxchg_range(&strollut_fbmap,
+		                                  __WORDSIZE,
+		                                  __WORDSIZE,
+		                                  &xpct,
+		                                  ~(0UL),
+		                                  STROLL_ATOMIC_SEQ_CST),
+		is,
+		true);
+	cute_check_hex(strollut_fbmap.bits[1], equal, ~(0UL));
+
+	/* Last bit of bitmap. */
+	xpct = 0;
+	cute_check_bool(
+		stroll_fbmap_atomic_cmpxchg_range(&strollut_fbmap,
+		                                  128,
+		                                  1,
+		                                  &xpct,
+		                                  1,
+		                                  STROLL_ATOMIC_RELAXED),
+		is,
+		true);
+	cute_check_bool(stroll_fbmap_test(&strollut_fbmap, 128), is, true);
+}
+
 #if defined(CONFIG_STROLL_ASSERT_API)
 CUTE_TEST(strollut_fbmap_iter_set_assert)
 {
@@ -2159,6 +3751,35 @@ CUTE_GROUP(strollut_fbmap_group) = {
 	CUTE_REF(strollut_fbmap_toggle_all_128),
 	CUTE_REF(strollut_fbmap_toggle_all_129),
 
+	CUTE_REF(strollut_fbmap_simd),
+	CUTE_REF(strollut_fbmap_and),
+	CUTE_REF(strollut_fbmap_or),
+	CUTE_REF(strollut_fbmap_xor),
+	CUTE_REF(strollut_fbmap_andnot),
+	CUTE_REF(strollut_fbmap_hweight_and),
+	CUTE_REF(strollut_fbmap_intersects),
+	CUTE_REF(strollut_fbmap_is_subset),
+	CUTE_REF(strollut_fbmap_binop_assert),
+	CUTE_REF(strollut_fbmap_extract_set_assert),
+	CUTE_REF(strollut_fbmap_extract_set),
+	CUTE_REF(strollut_fbmap_find_clear_run_assert),
+	CUTE_REF(strollut_fbmap_find_clear_run),
+	CUTE_REF(strollut_fbmap_rank_assert),
+	CUTE_REF(strollut_fbmap_rank),
+	CUTE_REF(strollut_fbmap_dyn_assert),
+	CUTE_REF(strollut_fbmap_dyn),
+	CUTE_REF(strollut_fbmap_file_assert),
+	CUTE_REF(strollut_fbmap_file),
+	CUTE_REF(strollut_fbmap_file_corrupt),
+
+	CUTE_REF(strollut_fbmap_atomic_assert),
+	CUTE_REF(strollut_fbmap_atomic_test_and_set),
+	CUTE_REF(strollut_fbmap_atomic_test_and_clear),
+	CUTE_REF(strollut_fbmap_atomic_set_range),
+	CUTE_REF(strollut_fbmap_atomic_clear_range),
+	CUTE_REF(strollut_fbmap_atomic_find_and_set_first_clear),
+	CUTE_REF(strollut_fbmap_atomic_cmpxchg_range),
+
 	CUTE_REF(strollut_fbmap_iter_set_assert),
 	CUTE_REF(strollut_fbmap_iter_set_14),
 	CUTE_REF(strollut_fbmap_iter_set_32),
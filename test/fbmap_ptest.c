@@ -0,0 +1,486 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#include "ptest.h"
+#include "stroll/fbmap.h"
+#include <stdint.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <math.h>
+
+struct strollpt_fbmap_op {
+	const char * name;
+	void         (*prepare)(struct stroll_fbmap *);
+	unsigned int (*run)(struct stroll_fbmap *);
+};
+
+static const char * strollpt_fbmap_isas[] = {
+	[STROLL_FBMAP_SCALAR_ISA] = "scalar",
+	[STROLL_FBMAP_SSE_ISA]    = "sse4.2",
+	[STROLL_FBMAP_AVX2_ISA]   = "avx2",
+	[STROLL_FBMAP_AVX512_ISA] = "avx512"
+};
+
+/* Second operand of binary operations. */
+static struct stroll_fbmap strollpt_fbmap_other;
+
+/* Output array of set bit decoding operations. */
+static uint32_t * strollpt_fbmap_indices;
+
+/*
+ * Fill bitmap with pseudo random content using a xorshift64 sequence.
+ */
+static void
+strollpt_fbmap_prepare_random(struct stroll_fbmap * bmap)
+{
+	uint64_t     seed = UINT64_C(0x2545f4914f6cdd1d);
+	unsigned int b;
+
+	stroll_fbmap_clear_all(bmap);
+	for (b = 0; b < stroll_fbmap_nr(bmap); b++) {
+		seed ^= seed << 13;
+		seed ^= seed >> 7;
+		seed ^= seed << 17;
+		if (seed & 1)
+			stroll_fbmap_set(bmap, b);
+	}
+}
+
+/*
+ * Clear the whole bitmap so that testing operations have to scan all words.
+ */
+static void
+strollpt_fbmap_prepare_clear(struct stroll_fbmap * bmap)
+{
+	stroll_fbmap_clear_all(bmap);
+}
+
+/*
+ * Make operands complementary so that intersection testing has to scan all
+ * words.
+ */
+static void
+strollpt_fbmap_prepare_disjoint(struct stroll_fbmap * bmap)
+{
+	strollpt_fbmap_prepare_random(bmap);
+	memcpy(strollpt_fbmap_other.bits,
+	       bmap->bits,
+	       stroll_fbmap_word_nr(stroll_fbmap_nr(bmap)) *
+	       sizeof(bmap->bits[0]));
+	stroll_fbmap_toggle_all(&strollpt_fbmap_other);
+}
+
+/*
+ * Make operands identical so that inclusion testing has to scan all words.
+ */
+static void
+strollpt_fbmap_prepare_equal(struct stroll_fbmap * bmap)
+{
+	strollpt_fbmap_prepare_random(bmap);
+	memcpy(strollpt_fbmap_other.bits,
+	       bmap->bits,
+	       stroll_fbmap_word_nr(stroll_fbmap_nr(bmap)) *
+	       sizeof(bmap->bits[0]));
+}
+
+static unsigned int
+strollpt_fbmap_run_hweight(struct stroll_fbmap * bmap)
+{
+	return stroll_fbmap_hweight(bmap);
+}
+
+static unsigned int
+strollpt_fbmap_run_test_all(struct stroll_fbmap * bmap)
+{
+	return stroll_fbmap_test_all(bmap);
+}
+
+static unsigned int
+strollpt_fbmap_run_test_range(struct stroll_fbmap * bmap)
+{
+	/* Give range unaligned head and tail words. */
+	return stroll_fbmap_test_range(bmap, 1, stroll_fbmap_nr(bmap) - 1);
+}
+
+static unsigned int
+strollpt_fbmap_run_toggle_all(struct stroll_fbmap * bmap)
+{
+	stroll_fbmap_toggle_all(bmap);
+
+	return 0;
+}
+
+static unsigned int
+strollpt_fbmap_run_and(struct stroll_fbmap * bmap)
+{
+	stroll_fbmap_and(bmap, bmap, &strollpt_fbmap_other);
+
+	return 0;
+}
+
+static unsigned int
+strollpt_fbmap_run_hweight_and(struct stroll_fbmap * bmap)
+{
+	return stroll_fbmap_hweight_and(bmap, &strollpt_fbmap_other);
+}
+
+static unsigned int
+strollpt_fbmap_run_intersects(struct stroll_fbmap * bmap)
+{
+	return stroll_fbmap_intersects(bmap, &strollpt_fbmap_other);
+}
+
+static unsigned int
+strollpt_fbmap_run_is_subset(struct stroll_fbmap * bmap)
+{
+	return stroll_fbmap_is_subset(bmap, &strollpt_fbmap_other);
+}
+
+static unsigned int
+strollpt_fbmap_run_extract(struct stroll_fbmap * bmap)
+{
+	return stroll_fbmap_extract_set(bmap,
+	                                0,
+	                                strollpt_fbmap_indices,
+	                                stroll_fbmap_nr(bmap));
+}
+
+/*
+ * Baseline for stroll_fbmap_extract_set(): decode set bits one at a time using
+ * the iterator interface.
+ */
+static unsigned int
+strollpt_fbmap_run_iterate(struct stroll_fbmap * bmap)
+{
+	struct stroll_fbmap_iter iter;
+	int                      b;
+	unsigned int             cnt = 0;
+
+	stroll_fbmap_foreach_set(&iter, bmap, b)
+		strollpt_fbmap_indices[cnt++] = (uint32_t)b;
+
+	return cnt;
+}
+
+/*
+ * Searching for runs of 16 cleared bits within a random bitmap requires to
+ * scan a significant part of it.
+ */
+static unsigned int
+strollpt_fbmap_run_find_clear_run(struct stroll_fbmap * bmap)
+{
+	return (unsigned int)stroll_fbmap_find_clear_run(bmap, 16, 0);
+}
+
+static unsigned int
+strollpt_fbmap_run_find_best_clear_run(struct stroll_fbmap * bmap)
+{
+	return (unsigned int)stroll_fbmap_find_best_clear_run(bmap, 16);
+}
+
+static const struct strollpt_fbmap_op strollpt_fbmap_ops[] = {
+	{
+		.name    = "hweight",
+		.prepare = strollpt_fbmap_prepare_random,
+		.run     = strollpt_fbmap_run_hweight
+	},
+	{
+		.name    = "test_all",
+		.prepare = strollpt_fbmap_prepare_clear,
+		.run     = strollpt_fbmap_run_test_all
+	},
+	{
+		.name    = "test_range",
+		.prepare = strollpt_fbmap_prepare_clear,
+		.run     = strollpt_fbmap_run_test_range
+	},
+	{
+		.name    = "toggle_all",
+		.prepare = strollpt_fbmap_prepare_random,
+		.run     = strollpt_fbmap_run_toggle_all
+	},
+	{
+		.name    = "and",
+		.prepare = strollpt_fbmap_prepare_equal,
+		.run     = strollpt_fbmap_run_and
+	},
+	{
+		.name    = "hweight_and",
+		.prepare = strollpt_fbmap_prepare_disjoint,
+		.run     = strollpt_fbmap_run_hweight_and
+	},
+	{
+		.name    = "intersects",
+		.prepare = strollpt_fbmap_prepare_disjoint,
+		.run     = strollpt_fbmap_run_intersects
+	},
+	{
+		.name    = "is_subset",
+		.prepare = strollpt_fbmap_prepare_equal,
+		.run     = strollpt_fbmap_run_is_subset
+	},
+	{
+		.name    = "extract",
+		.prepare = strollpt_fbmap_prepare_random,
+		.run     = strollpt_fbmap_run_extract
+	},
+	{
+		.name    = "iterate",
+		.prepare = strollpt_fbmap_prepare_random,
+		.run     = strollpt_fbmap_run_iterate
+	},
+	{
+		.name    = "find_clear_run",
+		.prepare = strollpt_fbmap_prepare_random,
+		.run     = strollpt_fbmap_run_find_clear_run
+	},
+	{
+		.name    = "find_best_clear_run",
+		.prepare = strollpt_fbmap_prepare_random,
+		.run     = strollpt_fbmap_run_find_best_clear_run
+	}
+};
+
+/*
+ * Prevent the compiler from optimizing out measured operations.
+ */
+static volatile unsigned int strollpt_fbmap_sink;
+
+static void
+strollpt_fbmap_measure(const struct strollpt_fbmap_op * __restrict op,
+                       struct stroll_fbmap * __restrict            bmap,
+                       unsigned long long * __restrict             nsecs,
+                       unsigned int                                loops)
+{
+	unsigned int l;
+
+	op->prepare(bmap);
+
+	for (l = 0; l < loops; l++) {
+		struct timespec start, elapse;
+		unsigned int    res;
+
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+		res = op->run(bmap);
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &elapse);
+
+		strollpt_fbmap_sink = res;
+		elapse = strollpt_tspec_sub(&elapse, &start);
+		nsecs[l] = strollpt_tspec2ns(&elapse);
+	}
+}
+
+static int
+strollpt_fbmap_parse_op(const char * __restrict                      arg,
+                        const struct strollpt_fbmap_op ** __restrict op)
+{
+	unsigned int o;
+
+	for (o = 0; o < stroll_array_nr(strollpt_fbmap_ops); o++) {
+		if (!strcmp(arg, strollpt_fbmap_ops[o].name)) {
+			*op = &strollpt_fbmap_ops[o];
+			return EXIT_SUCCESS;
+		}
+	}
+
+	strollpt_err("invalid '%s' bitmap operation.\n", arg);
+
+	return EXIT_FAILURE;
+}
+
+static int
+strollpt_fbmap_parse_bit_nr(const char * __restrict   arg,
+                            unsigned int * __restrict bit_nr)
+{
+	char *        str;
+	unsigned long nr;
+
+	nr = strtoul(arg, &str, 0);
+	if (*str || (nr < 2) || (nr > INT_MAX)) {
+		strollpt_err("invalid number of bits '%s' specified: "
+		             "integer within [2, INT_MAX] range expected.\n",
+		             arg);
+		return EXIT_FAILURE;
+	}
+
+	*bit_nr = (unsigned int)nr;
+
+	return EXIT_SUCCESS;
+}
+
+static int
+strollpt_fbmap_show_stats(enum stroll_fbmap_isa isa,
+                          unsigned long long *  nsecs,
+                          unsigned int          loops)
+{
+	struct strollpt_stats stats;
+
+	if (strollpt_calc_stats(&stats, nsecs, 1, loops))
+		return EXIT_FAILURE;
+
+	printf("%s:\n"
+	       "    #Inliers:   %u (%.2lf%%)\n"
+	       "    Mininum:    %llu nSec\n"
+	       "    Maximum:    %llu nSec\n"
+	       "    Deviation:  %llu nSec\n"
+	       "    Median:     %llu nSec\n"
+	       "    Mean:       %llu nSec\n",
+	       strollpt_fbmap_isas[isa],
+	       stats.count, ((double)stats.count * 100.0) / (double)loops,
+	       stats.min,
+	       stats.max,
+	       (unsigned long long)round(stats.stdev),
+	       stats.med,
+	       (unsigned long long)round(stats.mean));
+
+	return EXIT_SUCCESS;
+}
+
+static void
+strollpt_fbmap_usage(FILE * __restrict stdio)
+{
+	fprintf(stdio,
+	        "Usage: %s [OPTIONS] OPERATION BITS LOOPS\n"
+	        "where OPTIONS:\n"
+	        "    -p|--prio PRIORITY\n"
+	        "    -h|--help\n"
+	        "OPERATION:\n"
+	        "    hweight|test_all|test_range|toggle_all|\n"
+	        "    and|hweight_and|intersects|is_subset|\n"
+	        "    extract|iterate|find_clear_run|find_best_clear_run\n",
+	        program_invocation_short_name);
+}
+
+int main(int argc, char *argv[])
+{
+	const struct strollpt_fbmap_op * op;
+	unsigned int                     nr;
+	unsigned int                     loops;
+	int                              prio = 0;
+	struct stroll_fbmap              bmap;
+	unsigned long long *             nsecs;
+	enum stroll_fbmap_isa            orig;
+	int                              isa;
+	int                              ret = EXIT_FAILURE;
+
+	while (true) {
+		int                        opt;
+		static const struct option lopts[] = {
+			{"help", 0, NULL, 'h'},
+			{"prio", 1, NULL, 'p'},
+			{0,      0, 0,    0}
+		};
+
+		opt = getopt_long(argc, argv, "hp:", lopts, NULL);
+		if (opt < 0)
+			/* No more options: go parsing positional arguments. */
+			break;
+
+		switch (opt) {
+		case 'p': /* priority */
+			if (strollpt_parse_sched_prio(optarg, &prio)) {
+				strollpt_fbmap_usage(stderr);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 'h': /* Help message. */
+			strollpt_fbmap_usage(stdout);
+			exit(EXIT_SUCCESS);
+
+		case '?': /* Unknown option. */
+		default:
+			strollpt_fbmap_usage(stderr);
+			return EXIT_FAILURE;
+		}
+	}
+
+	/*
+	 * Check positional arguments are properly specified on command
+	 * line.
+	 */
+	argc -= optind;
+	if (argc != 3) {
+		strollpt_err("invalid number of arguments.\n");
+		strollpt_fbmap_usage(stderr);
+		return EXIT_FAILURE;
+	}
+
+	if (strollpt_fbmap_parse_op(argv[optind], &op))
+		return EXIT_FAILURE;
+
+	if (strollpt_fbmap_parse_bit_nr(argv[optind + 1], &nr))
+		return EXIT_FAILURE;
+
+	if (strollpt_parse_loop_nr(argv[optind + 2], &loops))
+		return EXIT_FAILURE;
+
+	if (stroll_fbmap_init_clear(&bmap, nr)) {
+		strollpt_err("cannot allocate bitmap: %s (%d).\n",
+		             strerror(errno),
+		             errno);
+		return EXIT_FAILURE;
+	}
+
+	if (stroll_fbmap_init_clear(&strollpt_fbmap_other, nr)) {
+		strollpt_err("cannot allocate bitmap: %s (%d).\n",
+		             strerror(errno),
+		             errno);
+		goto fini;
+	}
+
+	strollpt_fbmap_indices = malloc(nr * sizeof(strollpt_fbmap_indices[0]));
+	if (!strollpt_fbmap_indices)
+		goto fini_other;
+
+	nsecs = malloc(loops * sizeof(nsecs[0]));
+	if (!nsecs)
+		goto free_indices;
+
+	if (strollpt_setup_sched_prio(prio))
+		goto free_nsecs;
+
+	printf("#Bits:          %u\n"
+	       "Operation:      %s\n"
+	       "#Loops:         %u\n",
+	       nr,
+	       op->name,
+	       loops);
+
+	orig = stroll_fbmap_get_isa();
+	for (isa = STROLL_FBMAP_SCALAR_ISA; isa < STROLL_FBMAP_ISA_NR; isa++) {
+		if (stroll_fbmap_select_isa((enum stroll_fbmap_isa)isa))
+			/* Not supported by this CPU. */
+			continue;
+
+		strollpt_fbmap_measure(op, &bmap, nsecs, loops);
+		if (strollpt_fbmap_show_stats((enum stroll_fbmap_isa)isa,
+		                              nsecs,
+		                              loops))
+			goto restore;
+	}
+
+	ret = EXIT_SUCCESS;
+
+restore:
+	if (stroll_fbmap_select_isa(orig))
+		ret = EXIT_FAILURE;
+free_nsecs:
+	free(nsecs);
+free_indices:
+	free(strollpt_fbmap_indices);
+fini_other:
+	stroll_fbmap_fini(&strollpt_fbmap_other);
+fini:
+	stroll_fbmap_fini(&bmap);
+
+	return ret;
+}
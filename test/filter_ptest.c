@@ -0,0 +1,503 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#include "ptest.h"
+#include <stdint.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <math.h>
+
+#if defined(CONFIG_STROLL_BLOOM)
+#include "stroll/bloom.h"
+#endif
+#if defined(CONFIG_STROLL_CUCKOO)
+#include "stroll/cuckoo.h"
+#endif
+
+enum strollpt_filter_op {
+	STROLLPT_FILTER_INSERT_OP = 0,
+	STROLLPT_FILTER_HIT_OP    = 1,
+	STROLLPT_FILTER_MISS_OP   = 2,
+	STROLLPT_FILTER_DELETE_OP = 3,
+	STROLLPT_FILTER_OP_NR
+};
+
+static const char * strollpt_filter_operations[] = {
+	[STROLLPT_FILTER_INSERT_OP] = "insert",
+	[STROLLPT_FILTER_HIT_OP]    = "hit",
+	[STROLLPT_FILTER_MISS_OP]   = "miss",
+	[STROLLPT_FILTER_DELETE_OP] = "delete"
+};
+
+struct strollpt_filter_algo {
+	const char * name;
+	int          (*init)(unsigned int, double);
+	void         (*fini)(void);
+	size_t       (*size)(void);
+	int          (*insert)(uint64_t);
+	bool         (*test)(uint64_t);
+	int          (*delete)(uint64_t);
+};
+
+#if defined(CONFIG_STROLL_BLOOM)
+
+static struct stroll_bloom strollpt_bloom;
+
+static int
+strollpt_filter_init_bloom(unsigned int nr, double fpr)
+{
+	return stroll_bloom_init(&strollpt_bloom, nr, fpr);
+}
+
+static int
+strollpt_filter_init_bloom_blocked(unsigned int nr, double fpr)
+{
+	return stroll_bloom_init_blocked(&strollpt_bloom, nr, fpr);
+}
+
+static void
+strollpt_filter_fini_bloom(void)
+{
+	stroll_bloom_fini(&strollpt_bloom);
+}
+
+static size_t
+strollpt_filter_size_bloom(void)
+{
+	return stroll_bloom_bit_nr(&strollpt_bloom) / CHAR_BIT;
+}
+
+static int
+strollpt_filter_insert_bloom(uint64_t key)
+{
+	stroll_bloom_insert(&strollpt_bloom, key);
+
+	return 0;
+}
+
+static bool
+strollpt_filter_test_bloom(uint64_t key)
+{
+	return stroll_bloom_test(&strollpt_bloom, key);
+}
+
+#endif /* defined(CONFIG_STROLL_BLOOM) */
+
+#if defined(CONFIG_STROLL_CUCKOO)
+
+static struct stroll_cuckoo strollpt_cuckoo;
+
+static int
+strollpt_filter_init_cuckoo(unsigned int nr, double fpr)
+{
+	return stroll_cuckoo_init(&strollpt_cuckoo, nr, fpr);
+}
+
+static void
+strollpt_filter_fini_cuckoo(void)
+{
+	stroll_cuckoo_fini(&strollpt_cuckoo);
+}
+
+static size_t
+strollpt_filter_size_cuckoo(void)
+{
+	return (size_t)stroll_cuckoo_slot_nr(&strollpt_cuckoo) *
+	       stroll_cuckoo_fp_bits(&strollpt_cuckoo) / CHAR_BIT;
+}
+
+static int
+strollpt_filter_insert_cuckoo(uint64_t key)
+{
+	return stroll_cuckoo_insert(&strollpt_cuckoo, key);
+}
+
+static bool
+strollpt_filter_test_cuckoo(uint64_t key)
+{
+	return stroll_cuckoo_test(&strollpt_cuckoo, key);
+}
+
+static int
+strollpt_filter_delete_cuckoo(uint64_t key)
+{
+	return stroll_cuckoo_delete(&strollpt_cuckoo, key);
+}
+
+#endif /* defined(CONFIG_STROLL_CUCKOO) */
+
+static const struct strollpt_filter_algo strollpt_filter_algos[] = {
+#if defined(CONFIG_STROLL_BLOOM)
+	{
+		.name   = "bloom",
+		.init   = strollpt_filter_init_bloom,
+		.fini   = strollpt_filter_fini_bloom,
+		.size   = strollpt_filter_size_bloom,
+		.insert = strollpt_filter_insert_bloom,
+		.test   = strollpt_filter_test_bloom,
+		.delete = NULL
+	},
+	{
+		.name   = "bloom_blocked",
+		.init   = strollpt_filter_init_bloom_blocked,
+		.fini   = strollpt_filter_fini_bloom,
+		.size   = strollpt_filter_size_bloom,
+		.insert = strollpt_filter_insert_bloom,
+		.test   = strollpt_filter_test_bloom,
+		.delete = NULL
+	},
+#endif
+#if defined(CONFIG_STROLL_CUCKOO)
+	{
+		.name   = "cuckoo",
+		.init   = strollpt_filter_init_cuckoo,
+		.fini   = strollpt_filter_fini_cuckoo,
+		.size   = strollpt_filter_size_cuckoo,
+		.insert = strollpt_filter_insert_cuckoo,
+		.test   = strollpt_filter_test_cuckoo,
+		.delete = strollpt_filter_delete_cuckoo
+	},
+#endif
+};
+
+/*
+ * Generate distinct 64-bit keys spread over the whole key space using a
+ * splitmix64 sequence.
+ */
+static uint64_t *
+strollpt_filter_create_keys(unsigned int nr)
+{
+	uint64_t *   keys;
+	uint64_t     seed = UINT64_C(0x2545f4914f6cdd1d);
+	unsigned int k;
+
+	keys = malloc(nr * sizeof(keys[0]));
+	if (!keys) {
+		strollpt_err("cannot allocate keys: %s (%d).\n",
+		             strerror(errno),
+		             errno);
+		return NULL;
+	}
+
+	for (k = 0; k < nr; k++) {
+		uint64_t key;
+
+		seed += UINT64_C(0x9e3779b97f4a7c15);
+		key = seed;
+		key = (key ^ (key >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+		key = (key ^ (key >> 27)) * UINT64_C(0x94d049bb133111eb);
+		keys[k] = key ^ (key >> 31);
+	}
+
+	return keys;
+}
+
+static int
+strollpt_filter_measure(const struct strollpt_filter_algo * __restrict algo,
+                        const uint64_t * __restrict                   keys,
+                        unsigned int                                  nr,
+                        double                                        fpr,
+                        unsigned long long * __restrict               nsecs,
+                        unsigned int * __restrict                     fpos)
+{
+	struct timespec start, elapse;
+	unsigned int    k;
+	unsigned int    cnt = 0;
+	int             err;
+
+	err = algo->init(nr, fpr);
+	if (err) {
+		strollpt_err("cannot initialize filter: %s (%d).\n",
+		             strerror(-err),
+		             -err);
+		return EXIT_FAILURE;
+	}
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+	for (k = 0; k < nr; k++)
+		err |= algo->insert(keys[k]);
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &elapse);
+	if (err) {
+		strollpt_err("cannot insert keys: filter overloaded.\n");
+		goto fini;
+	}
+	elapse = strollpt_tspec_sub(&elapse, &start);
+	nsecs[STROLLPT_FILTER_INSERT_OP] = strollpt_tspec2ns(&elapse);
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+	for (k = 0; k < nr; k++)
+		cnt += algo->test(keys[k]);
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &elapse);
+	if (cnt != nr) {
+		strollpt_err("false negatives detected.\n");
+		err = -EINVAL;
+		goto fini;
+	}
+	elapse = strollpt_tspec_sub(&elapse, &start);
+	nsecs[STROLLPT_FILTER_HIT_OP] = strollpt_tspec2ns(&elapse);
+
+	/* Second half of keys have never been inserted. */
+	cnt = 0;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+	for (k = nr; k < (2 * nr); k++)
+		cnt += algo->test(keys[k]);
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &elapse);
+	elapse = strollpt_tspec_sub(&elapse, &start);
+	nsecs[STROLLPT_FILTER_MISS_OP] = strollpt_tspec2ns(&elapse);
+	*fpos = cnt;
+
+	nsecs[STROLLPT_FILTER_DELETE_OP] = 0;
+	if (algo->delete) {
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+		for (k = 0; k < nr; k++)
+			err |= algo->delete(keys[k]);
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &elapse);
+		if (err) {
+			strollpt_err("cannot delete keys.\n");
+			goto fini;
+		}
+		elapse = strollpt_tspec_sub(&elapse, &start);
+		nsecs[STROLLPT_FILTER_DELETE_OP] = strollpt_tspec2ns(&elapse);
+	}
+
+fini:
+	algo->fini();
+
+	return err ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+static int
+strollpt_filter_parse_algo(
+	const char * __restrict                         arg,
+	const struct strollpt_filter_algo ** __restrict algo)
+{
+	unsigned int a;
+
+	for (a = 0; a < stroll_array_nr(strollpt_filter_algos); a++) {
+		if (!strcmp(arg, strollpt_filter_algos[a].name)) {
+			*algo = &strollpt_filter_algos[a];
+			return EXIT_SUCCESS;
+		}
+	}
+
+	strollpt_err("invalid '%s' filter algorithm.\n", arg);
+
+	return EXIT_FAILURE;
+}
+
+static int
+strollpt_filter_parse_key_nr(const char * __restrict   arg,
+                             unsigned int * __restrict key_nr)
+{
+	char *        str;
+	unsigned long nr;
+
+	nr = strtoul(arg, &str, 0);
+	if (*str || !nr || (nr > (UINT_MAX / 2))) {
+		strollpt_err("invalid number of keys '%s' specified: "
+		             "positive integer <= UINT_MAX / 2 expected.\n",
+		             arg);
+		return EXIT_FAILURE;
+	}
+
+	*key_nr = (unsigned int)nr;
+
+	return EXIT_SUCCESS;
+}
+
+static int
+strollpt_filter_parse_fpr(const char * __restrict arg,
+                          double * __restrict     fpr)
+{
+	char * str;
+	double rate;
+
+	rate = strtod(arg, &str);
+	if (*str || (rate <= 0.0) || (rate >= 1.0)) {
+		strollpt_err("invalid false positive rate '%s' specified: "
+		             "real number within ]0, 1[ range expected.\n",
+		             arg);
+		return EXIT_FAILURE;
+	}
+
+	*fpr = rate;
+
+	return EXIT_SUCCESS;
+}
+
+static int
+strollpt_filter_show_stats(enum strollpt_filter_op operation,
+                           unsigned long long *    nsecs,
+                           unsigned int            loops)
+{
+	struct strollpt_stats stats;
+
+	if (strollpt_calc_stats(&stats,
+	                        &nsecs[operation],
+	                        STROLLPT_FILTER_OP_NR,
+	                        loops))
+		return EXIT_FAILURE;
+
+	printf("%s:\n"
+	       "    #Inliers:   %u (%.2lf%%)\n"
+	       "    Mininum:    %llu nSec\n"
+	       "    Maximum:    %llu nSec\n"
+	       "    Deviation:  %llu nSec\n"
+	       "    Median:     %llu nSec\n"
+	       "    Mean:       %llu nSec\n",
+	       strollpt_filter_operations[operation],
+	       stats.count, ((double)stats.count * 100.0) / (double)loops,
+	       stats.min,
+	       stats.max,
+	       (unsigned long long)round(stats.stdev),
+	       stats.med,
+	       (unsigned long long)round(stats.mean));
+
+	return EXIT_SUCCESS;
+}
+
+static void
+strollpt_filter_usage(FILE * __restrict stdio)
+{
+	fprintf(stdio,
+	        "Usage: %s [OPTIONS] ALGORITHM KEYS FPR LOOPS\n"
+	        "where OPTIONS:\n"
+	        "    -p|--prio PRIORITY\n"
+	        "    -h|--help\n",
+	        program_invocation_short_name);
+}
+
+int main(int argc, char *argv[])
+{
+	const struct strollpt_filter_algo * algo;
+	unsigned int                        nr;
+	double                              fpr;
+	unsigned int                        loops;
+	int                                 prio = 0;
+	uint64_t *                          keys;
+	unsigned long long *                nsecs;
+	unsigned int                        fpos = 0;
+	size_t                              sz;
+	unsigned int                        i;
+	int                                 ret = EXIT_FAILURE;
+
+	while (true) {
+		int                        opt;
+		static const struct option lopts[] = {
+			{"help", 0, NULL, 'h'},
+			{"prio", 1, NULL, 'p'},
+			{0,      0, 0,    0}
+		};
+
+		opt = getopt_long(argc, argv, "hp:", lopts, NULL);
+		if (opt < 0)
+			/* No more options: go parsing positional arguments. */
+			break;
+
+		switch (opt) {
+		case 'p': /* priority */
+			if (strollpt_parse_sched_prio(optarg, &prio)) {
+				strollpt_filter_usage(stderr);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 'h': /* Help message. */
+			strollpt_filter_usage(stdout);
+			exit(EXIT_SUCCESS);
+
+		case '?': /* Unknown option. */
+		default:
+			strollpt_filter_usage(stderr);
+			return EXIT_FAILURE;
+		}
+	}
+
+	/*
+	 * Check positional arguments are properly specified on command
+	 * line.
+	 */
+	argc -= optind;
+	if (argc != 4) {
+		strollpt_err("invalid number of arguments.\n");
+		strollpt_filter_usage(stderr);
+		return EXIT_FAILURE;
+	}
+
+	if (strollpt_filter_parse_algo(argv[optind], &algo))
+		return EXIT_FAILURE;
+
+	if (strollpt_filter_parse_key_nr(argv[optind + 1], &nr))
+		return EXIT_FAILURE;
+
+	if (strollpt_filter_parse_fpr(argv[optind + 2], &fpr))
+		return EXIT_FAILURE;
+
+	if (strollpt_parse_loop_nr(argv[optind + 3], &loops))
+		return EXIT_FAILURE;
+
+	/* First half is inserted, second half is used to probe misses. */
+	keys = strollpt_filter_create_keys(2 * nr);
+	if (!keys)
+		return EXIT_FAILURE;
+
+	nsecs = malloc(STROLLPT_FILTER_OP_NR * loops * sizeof(nsecs[0]));
+	if (!nsecs)
+		goto free_keys;
+
+	if (algo->init(nr, fpr))
+		goto free_nsecs;
+	sz = algo->size();
+	algo->fini();
+
+	if (strollpt_setup_sched_prio(prio))
+		goto free_nsecs;
+
+	for (i = 0; i < loops; i++) {
+		if (strollpt_filter_measure(algo,
+		                            keys,
+		                            nr,
+		                            fpr,
+		                            &nsecs[i * STROLLPT_FILTER_OP_NR],
+		                            &fpos))
+		    goto free_nsecs;
+	}
+
+	printf("#Keys:          %u\n"
+	       "Algorithm:      %s\n"
+	       "Expected FPR:   %.6lf\n"
+	       "Measured FPR:   %.6lf\n"
+	       "Memory size:    %zu\n"
+	       "Bits per key:   %.2lf\n"
+	       "#Loops:         %u\n",
+	       nr,
+	       algo->name,
+	       fpr,
+	       (double)fpos / (double)nr,
+	       sz,
+	       (double)sz * CHAR_BIT / (double)nr,
+	       loops);
+	for (i = 0; i < STROLLPT_FILTER_OP_NR; i++) {
+		if ((i == STROLLPT_FILTER_DELETE_OP) && !algo->delete)
+			continue;
+		if (strollpt_filter_show_stats(i, nsecs, loops))
+			goto free_nsecs;
+	}
+
+	ret = EXIT_SUCCESS;
+
+free_nsecs:
+	free(nsecs);
+free_keys:
+	free(keys);
+
+	return ret;
+}
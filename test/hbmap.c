@@ -0,0 +1,432 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#include "utest.h"
+#include "stroll/hbmap.h"
+#include <cute/cute.h>
+#include <cute/check.h>
+#include <cute/expect.h>
+#include <errno.h>
+
+#define STROLLUT_HBMAP_NOASSERT(_test) \
+	CUTE_TEST(_test) { cute_skip("assertion unsupported"); }
+
+/*
+ * Bit counts exercising single / multiple summary levels as well as partial
+ * last words.
+ */
+static const unsigned int strollut_hbmap_nr[] = {
+	1, 2, 63, 64, 65, 127, 128, 129, 4095, 4096, 4097, 262144, 262145
+};
+
+static struct stroll_hbmap strollut_hbmap;
+static bool *              strollut_hbmap_ref;
+static bool                strollut_hbmap_tofree;
+static uint64_t            strollut_hbmap_seed;
+
+static void
+strollut_hbmap_setup(void)
+{
+	strollut_hbmap_tofree = false;
+	strollut_hbmap_ref = NULL;
+	strollut_hbmap_seed = UINT64_C(0x2545f4914f6cdd1d);
+}
+
+static void
+strollut_hbmap_teardown(void)
+{
+	if (strollut_hbmap_tofree) {
+		stroll_hbmap_fini(&strollut_hbmap);
+		strollut_hbmap_tofree = false;
+	}
+
+	free(strollut_hbmap_ref);
+	strollut_hbmap_ref = NULL;
+}
+
+static unsigned int
+strollut_hbmap_rand(unsigned int max)
+{
+	strollut_hbmap_seed ^= strollut_hbmap_seed << 13;
+	strollut_hbmap_seed ^= strollut_hbmap_seed >> 7;
+	strollut_hbmap_seed ^= strollut_hbmap_seed << 17;
+
+	return (unsigned int)(strollut_hbmap_seed % max);
+}
+
+static void
+strollut_hbmap_prepare(unsigned int nr, bool set)
+{
+	unsigned int b;
+
+	if (set)
+		cute_check_sint(stroll_hbmap_init_set(&strollut_hbmap, nr),
+		                equal,
+		                0);
+	else
+		cute_check_sint(stroll_hbmap_init_clear(&strollut_hbmap, nr),
+		                equal,
+		                0);
+	strollut_hbmap_tofree = true;
+
+	strollut_hbmap_ref = malloc(nr * sizeof(strollut_hbmap_ref[0]));
+	cute_check_ptr(strollut_hbmap_ref, unequal, NULL);
+	for (b = 0; b < nr; b++)
+		strollut_hbmap_ref[b] = set;
+}
+
+static void
+strollut_hbmap_release(void)
+{
+	stroll_hbmap_fini(&strollut_hbmap);
+	strollut_hbmap_tofree = false;
+
+	free(strollut_hbmap_ref);
+	strollut_hbmap_ref = NULL;
+}
+
+/*
+ * Check bitmap content as well as searching results starting from all
+ * possible bit positions against the reference array.
+ */
+static void
+strollut_hbmap_check(void)
+{
+	unsigned int b = stroll_hbmap_nr(&strollut_hbmap);
+	int          set = -ENOENT;
+	int          clr = -ENOENT;
+
+	cute_check_sint(stroll_hbmap_find_next_set(&strollut_hbmap, b),
+	                equal,
+	                -ENOENT);
+	cute_check_sint(stroll_hbmap_find_next_clear(&strollut_hbmap, b),
+	                equal,
+	                -ENOENT);
+
+	while (b--) {
+		if (strollut_hbmap_ref[b])
+			set = (int)b;
+		else
+			clr = (int)b;
+
+		cute_check_bool(stroll_hbmap_test(&strollut_hbmap, b),
+		                is,
+		                strollut_hbmap_ref[b]);
+		cute_check_sint(stroll_hbmap_find_next_set(&strollut_hbmap, b),
+		                equal,
+		                set);
+		cute_check_sint(stroll_hbmap_find_next_clear(&strollut_hbmap,
+		                                             b),
+		                equal,
+		                clr);
+	}
+
+	cute_check_sint(stroll_hbmap_find_first_set(&strollut_hbmap),
+	                equal,
+	                set);
+	cute_check_sint(stroll_hbmap_find_first_clear(&strollut_hbmap),
+	                equal,
+	                clr);
+}
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_hbmap_init_assert)
+{
+	int err __unused;
+
+	cute_expect_assertion(err = stroll_hbmap_init_clear(NULL, 1));
+	cute_expect_assertion(err = stroll_hbmap_init_clear(&strollut_hbmap,
+	                                                    0));
+	cute_expect_assertion(err = stroll_hbmap_init_clear(
+		&strollut_hbmap,
+		(unsigned int)INT_MAX + 1));
+	cute_expect_assertion(err = stroll_hbmap_init_set(NULL, 1));
+	cute_expect_assertion(err = stroll_hbmap_init_set(&strollut_hbmap, 0));
+}
+#else
+STROLLUT_HBMAP_NOASSERT(strollut_hbmap_init_assert)
+#endif
+
+CUTE_TEST(strollut_hbmap_init_clear)
+{
+	unsigned int n;
+
+	for (n = 0; n < stroll_array_nr(strollut_hbmap_nr); n++) {
+		strollut_hbmap_prepare(strollut_hbmap_nr[n], false);
+
+		cute_check_uint(stroll_hbmap_nr(&strollut_hbmap),
+		                equal,
+		                strollut_hbmap_nr[n]);
+		cute_check_uint(strollut_hbmap.depth,
+		                lower_equal,
+		                STROLL_HBMAP_DEPTH_MAX);
+		strollut_hbmap_check();
+
+		strollut_hbmap_release();
+	}
+}
+
+CUTE_TEST(strollut_hbmap_init_set)
+{
+	unsigned int n;
+
+	for (n = 0; n < stroll_array_nr(strollut_hbmap_nr); n++) {
+		strollut_hbmap_prepare(strollut_hbmap_nr[n], true);
+
+		cute_check_uint(stroll_hbmap_nr(&strollut_hbmap),
+		                equal,
+		                strollut_hbmap_nr[n]);
+		strollut_hbmap_check();
+
+		strollut_hbmap_release();
+	}
+}
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_hbmap_bit_assert)
+{
+	bool res __unused;
+	int  err __unused;
+
+	strollut_hbmap_prepare(65, false);
+
+	cute_expect_assertion(res = stroll_hbmap_test(&strollut_hbmap, 65));
+	cute_expect_assertion(stroll_hbmap_set(&strollut_hbmap, 65));
+	cute_expect_assertion(stroll_hbmap_clear(&strollut_hbmap, 65));
+	cute_expect_assertion(stroll_hbmap_set_range(&strollut_hbmap, 0, 0));
+	cute_expect_assertion(stroll_hbmap_set_range(&strollut_hbmap, 64, 2));
+	cute_expect_assertion(stroll_hbmap_clear_range(&strollut_hbmap, 0, 0));
+	cute_expect_assertion(stroll_hbmap_clear_range(&strollut_hbmap,
+	                                               65,
+	                                               1));
+	cute_expect_assertion(err = stroll_hbmap_find_next_set(&strollut_hbmap,
+	                                                       66));
+	cute_expect_assertion(err = stroll_hbmap_find_next_clear(
+		&strollut_hbmap,
+		66));
+}
+#else
+STROLLUT_HBMAP_NOASSERT(strollut_hbmap_bit_assert)
+#endif
+
+/*
+ * Toggle bits one at a time, located near word / summary word boundaries
+ * first, then at random positions.
+ */
+static void
+strollut_hbmap_check_bits(unsigned int nr, bool set)
+{
+	static const unsigned int bits[] = {
+		0, 1, 62, 63, 64, 65, 127, 128, 4095, 4096, 4097, 262143, 262144
+	};
+	unsigned int              b;
+
+	strollut_hbmap_prepare(nr, set);
+
+	for (b = 0; b < stroll_array_nr(bits); b++) {
+		if (bits[b] >= nr)
+			break;
+
+		if (set)
+			stroll_hbmap_clear(&strollut_hbmap, bits[b]);
+		else
+			stroll_hbmap_set(&strollut_hbmap, bits[b]);
+		strollut_hbmap_ref[bits[b]] = !set;
+	}
+	strollut_hbmap_check();
+
+	for (b = 0; b < 256; b++) {
+		unsigned int bit_no = strollut_hbmap_rand(nr);
+
+		if (strollut_hbmap_ref[bit_no])
+			stroll_hbmap_clear(&strollut_hbmap, bit_no);
+		else
+			stroll_hbmap_set(&strollut_hbmap, bit_no);
+		strollut_hbmap_ref[bit_no] = !strollut_hbmap_ref[bit_no];
+	}
+	strollut_hbmap_check();
+
+	/* Restore initial state. */
+	for (b = 0; b < nr; b++) {
+		if (set)
+			stroll_hbmap_set(&strollut_hbmap, b);
+		else
+			stroll_hbmap_clear(&strollut_hbmap, b);
+		strollut_hbmap_ref[b] = set;
+	}
+	strollut_hbmap_check();
+
+	strollut_hbmap_release();
+}
+
+CUTE_TEST(strollut_hbmap_set)
+{
+	unsigned int n;
+
+	for (n = 0; n < stroll_array_nr(strollut_hbmap_nr); n++)
+		strollut_hbmap_check_bits(strollut_hbmap_nr[n], false);
+}
+
+CUTE_TEST(strollut_hbmap_clear)
+{
+	unsigned int n;
+
+	for (n = 0; n < stroll_array_nr(strollut_hbmap_nr); n++)
+		strollut_hbmap_check_bits(strollut_hbmap_nr[n], true);
+}
+
+static void
+strollut_hbmap_check_ranges(unsigned int nr)
+{
+	unsigned int r;
+
+	strollut_hbmap_prepare(nr, false);
+
+	for (r = 0; r < 64; r++) {
+		unsigned int start = strollut_hbmap_rand(nr);
+		unsigned int cnt = strollut_hbmap_rand(nr - start) + 1;
+		bool         set = r & 1;
+		unsigned int b;
+
+		/* Give short ranges a chance. */
+		if (r & 2)
+			cnt = (cnt % 130) ? (cnt % 130) : 1;
+		cnt = stroll_min(cnt, nr - start);
+
+		if (set)
+			stroll_hbmap_set_range(&strollut_hbmap, start, cnt);
+		else
+			stroll_hbmap_clear_range(&strollut_hbmap, start, cnt);
+		for (b = start; b < (start + cnt); b++)
+			strollut_hbmap_ref[b] = set;
+
+		/* Full checking is expensive for large bitmaps. */
+		if ((nr < 10000) || !(r % 16))
+			strollut_hbmap_check();
+	}
+
+	stroll_hbmap_set_range(&strollut_hbmap, 0, nr);
+	for (r = 0; r < nr; r++)
+		strollut_hbmap_ref[r] = true;
+	strollut_hbmap_check();
+
+	stroll_hbmap_clear_range(&strollut_hbmap, 0, nr);
+	for (r = 0; r < nr; r++)
+		strollut_hbmap_ref[r] = false;
+	strollut_hbmap_check();
+
+	strollut_hbmap_release();
+}
+
+CUTE_TEST(strollut_hbmap_range)
+{
+	unsigned int n;
+
+	for (n = 0; n < stroll_array_nr(strollut_hbmap_nr); n++)
+		strollut_hbmap_check_ranges(strollut_hbmap_nr[n]);
+}
+
+CUTE_TEST(strollut_hbmap_find_sparse)
+{
+	unsigned int nr = 262145;
+	unsigned int b;
+
+	strollut_hbmap_prepare(nr, false);
+
+	/* Single set bit into an otherwise empty bitmap. */
+	for (b = 0; b < nr; b += 4099) {
+		stroll_hbmap_set(&strollut_hbmap, b);
+		cute_check_sint(stroll_hbmap_find_first_set(&strollut_hbmap),
+		                equal,
+		                (int)b);
+		cute_check_sint(stroll_hbmap_find_next_set(&strollut_hbmap,
+		                                           b / 2),
+		                equal,
+		                (int)b);
+		cute_check_sint(stroll_hbmap_find_next_set(&strollut_hbmap,
+		                                           b + 1),
+		                equal,
+		                -ENOENT);
+		stroll_hbmap_clear(&strollut_hbmap, b);
+	}
+	cute_check_sint(stroll_hbmap_find_first_set(&strollut_hbmap),
+	                equal,
+	                -ENOENT);
+
+	/* Single cleared bit into an otherwise full bitmap. */
+	stroll_hbmap_set_range(&strollut_hbmap, 0, nr);
+	for (b = 0; b < nr; b += 4099) {
+		stroll_hbmap_clear(&strollut_hbmap, b);
+		cute_check_sint(stroll_hbmap_find_first_clear(&strollut_hbmap),
+		                equal,
+		                (int)b);
+		cute_check_sint(stroll_hbmap_find_next_clear(&strollut_hbmap,
+		                                             b / 2),
+		                equal,
+		                (int)b);
+		cute_check_sint(stroll_hbmap_find_next_clear(&strollut_hbmap,
+		                                             b + 1),
+		                equal,
+		                -ENOENT);
+		stroll_hbmap_set(&strollut_hbmap, b);
+	}
+	cute_check_sint(stroll_hbmap_find_first_clear(&strollut_hbmap),
+	                equal,
+	                -ENOENT);
+
+	strollut_hbmap_release();
+}
+
+CUTE_TEST(strollut_hbmap_foreach)
+{
+	unsigned int nr = 4097;
+	unsigned int cnt = 0;
+	int          b;
+	int          prev;
+
+	strollut_hbmap_prepare(nr, false);
+
+	for (b = 0; b < (int)nr; b += 7)
+		stroll_hbmap_set(&strollut_hbmap, (unsigned int)b);
+
+	prev = -7;
+	stroll_hbmap_foreach_set(&strollut_hbmap, b) {
+		cute_check_sint(b, equal, prev + 7);
+		prev = b;
+		cnt++;
+	}
+	cute_check_uint(cnt, equal, (nr + 6) / 7);
+
+	prev = -1;
+	stroll_hbmap_foreach_clear(&strollut_hbmap, b) {
+		cute_check_bool(!!(b % 7), is, true);
+		cute_check_sint(b, greater, prev);
+		prev = b;
+		cnt++;
+	}
+	cute_check_uint(cnt, equal, nr);
+
+	strollut_hbmap_release();
+}
+
+CUTE_GROUP(strollut_hbmap_group) = {
+	CUTE_REF(strollut_hbmap_init_assert),
+	CUTE_REF(strollut_hbmap_init_clear),
+	CUTE_REF(strollut_hbmap_init_set),
+	CUTE_REF(strollut_hbmap_bit_assert),
+	CUTE_REF(strollut_hbmap_set),
+	CUTE_REF(strollut_hbmap_clear),
+	CUTE_REF(strollut_hbmap_range),
+	CUTE_REF(strollut_hbmap_find_sparse),
+	CUTE_REF(strollut_hbmap_foreach)
+};
+
+CUTE_SUITE_EXTERN(strollut_hbmap_suite,
+                  strollut_hbmap_group,
+                  strollut_hbmap_setup,
+                  strollut_hbmap_teardown,
+                  CUTE_DFLT_TMOUT);
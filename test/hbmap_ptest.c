@@ -0,0 +1,246 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#include "ptest.h"
+#include "stroll/hbmap.h"
+#include "stroll/fbmap.h"
+#include <stdint.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <math.h>
+
+/*
+ * Compare searching for the first cleared bit of an almost full bitmap, i.e.
+ * the typical slot allocation scenario, using a linear scan of a fixed sized
+ * bitmap versus a hierarchical bitmap lookup.
+ */
+enum strollpt_hbmap_algo {
+	STROLLPT_HBMAP_FBMAP_ALGO = 0,
+	STROLLPT_HBMAP_HBMAP_ALGO = 1,
+	STROLLPT_HBMAP_ALGO_NR
+};
+
+static const char * strollpt_hbmap_algos[] = {
+	[STROLLPT_HBMAP_FBMAP_ALGO] = "fbmap",
+	[STROLLPT_HBMAP_HBMAP_ALGO] = "hbmap"
+};
+
+static uint64_t strollpt_hbmap_seed = UINT64_C(0x2545f4914f6cdd1d);
+
+static unsigned int
+strollpt_hbmap_rand(unsigned int max)
+{
+	strollpt_hbmap_seed ^= strollpt_hbmap_seed << 13;
+	strollpt_hbmap_seed ^= strollpt_hbmap_seed >> 7;
+	strollpt_hbmap_seed ^= strollpt_hbmap_seed << 17;
+
+	return (unsigned int)(strollpt_hbmap_seed % max);
+}
+
+static int
+strollpt_hbmap_measure(struct stroll_fbmap * __restrict fbmap,
+                       struct stroll_hbmap * __restrict hbmap,
+                       unsigned long long * __restrict  nsecs)
+{
+	unsigned int             bit_no = strollpt_hbmap_rand(fbmap->nr);
+	struct stroll_fbmap_iter iter;
+	struct timespec          start, elapse;
+	int                      fres, hres;
+
+	/* Clear a single bit at a random location. */
+	stroll_fbmap_clear(fbmap, bit_no);
+	stroll_hbmap_clear(hbmap, bit_no);
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+	fres = stroll_fbmap_init_iter_clear(&iter, fbmap);
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &elapse);
+	elapse = strollpt_tspec_sub(&elapse, &start);
+	nsecs[STROLLPT_HBMAP_FBMAP_ALGO] = strollpt_tspec2ns(&elapse);
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+	hres = stroll_hbmap_find_first_clear(hbmap);
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &elapse);
+	elapse = strollpt_tspec_sub(&elapse, &start);
+	nsecs[STROLLPT_HBMAP_HBMAP_ALGO] = strollpt_tspec2ns(&elapse);
+
+	stroll_fbmap_set(fbmap, bit_no);
+	stroll_hbmap_set(hbmap, bit_no);
+
+	if ((fres != (int)bit_no) || (hres != (int)bit_no)) {
+		strollpt_err("unexpected search result.\n");
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static int
+strollpt_hbmap_parse_bit_nr(const char * __restrict   arg,
+                            unsigned int * __restrict bit_nr)
+{
+	char *        str;
+	unsigned long nr;
+
+	nr = strtoul(arg, &str, 0);
+	if (*str || !nr || (nr > INT_MAX)) {
+		strollpt_err("invalid number of bits '%s' specified: "
+		             "integer within [1, INT_MAX] range expected.\n",
+		             arg);
+		return EXIT_FAILURE;
+	}
+
+	*bit_nr = (unsigned int)nr;
+
+	return EXIT_SUCCESS;
+}
+
+static int
+strollpt_hbmap_show_stats(enum strollpt_hbmap_algo algo,
+                          unsigned long long *     nsecs,
+                          unsigned int             loops)
+{
+	struct strollpt_stats stats;
+
+	if (strollpt_calc_stats(&stats,
+	                        &nsecs[algo],
+	                        STROLLPT_HBMAP_ALGO_NR,
+	                        loops))
+		return EXIT_FAILURE;
+
+	printf("%s:\n"
+	       "    #Inliers:   %u (%.2lf%%)\n"
+	       "    Mininum:    %llu nSec\n"
+	       "    Maximum:    %llu nSec\n"
+	       "    Deviation:  %llu nSec\n"
+	       "    Median:     %llu nSec\n"
+	       "    Mean:       %llu nSec\n",
+	       strollpt_hbmap_algos[algo],
+	       stats.count, ((double)stats.count * 100.0) / (double)loops,
+	       stats.min,
+	       stats.max,
+	       (unsigned long long)round(stats.stdev),
+	       stats.med,
+	       (unsigned long long)round(stats.mean));
+
+	return EXIT_SUCCESS;
+}
+
+static void
+strollpt_hbmap_usage(FILE * __restrict stdio)
+{
+	fprintf(stdio,
+	        "Usage: %s [OPTIONS] BITS LOOPS\n"
+	        "where OPTIONS:\n"
+	        "    -p|--prio PRIORITY\n"
+	        "    -h|--help\n",
+	        program_invocation_short_name);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned int         nr;
+	unsigned int         loops;
+	int                  prio = 0;
+	struct stroll_fbmap  fbmap;
+	struct stroll_hbmap  hbmap;
+	unsigned long long * nsecs;
+	unsigned int         i;
+	int                  ret = EXIT_FAILURE;
+
+	while (true) {
+		int                        opt;
+		static const struct option lopts[] = {
+			{"help", 0, NULL, 'h'},
+			{"prio", 1, NULL, 'p'},
+			{0,      0, 0,    0}
+		};
+
+		opt = getopt_long(argc, argv, "hp:", lopts, NULL);
+		if (opt < 0)
+			/* No more options: go parsing positional arguments. */
+			break;
+
+		switch (opt) {
+		case 'p': /* priority */
+			if (strollpt_parse_sched_prio(optarg, &prio)) {
+				strollpt_hbmap_usage(stderr);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 'h': /* Help message. */
+			strollpt_hbmap_usage(stdout);
+			exit(EXIT_SUCCESS);
+
+		case '?': /* Unknown option. */
+		default:
+			strollpt_hbmap_usage(stderr);
+			return EXIT_FAILURE;
+		}
+	}
+
+	/*
+	 * Check positional arguments are properly specified on command
+	 * line.
+	 */
+	argc -= optind;
+	if (argc != 2) {
+		strollpt_err("invalid number of arguments.\n");
+		strollpt_hbmap_usage(stderr);
+		return EXIT_FAILURE;
+	}
+
+	if (strollpt_hbmap_parse_bit_nr(argv[optind], &nr))
+		return EXIT_FAILURE;
+
+	if (strollpt_parse_loop_nr(argv[optind + 1], &loops))
+		return EXIT_FAILURE;
+
+	nsecs = malloc(STROLLPT_HBMAP_ALGO_NR * loops * sizeof(nsecs[0]));
+	if (!nsecs)
+		return EXIT_FAILURE;
+
+	if (stroll_fbmap_init_set(&fbmap, nr))
+		goto free_nsecs;
+
+	if (stroll_hbmap_init_set(&hbmap, nr))
+		goto fini_fbmap;
+
+	if (strollpt_setup_sched_prio(prio))
+		goto fini_hbmap;
+
+	for (i = 0; i < loops; i++) {
+		if (strollpt_hbmap_measure(&fbmap,
+		                           &hbmap,
+		                           &nsecs[i * STROLLPT_HBMAP_ALGO_NR]))
+			goto fini_hbmap;
+	}
+
+	printf("#Bits:          %u\n"
+	       "#Loops:         %u\n",
+	       nr,
+	       loops);
+	for (i = 0; i < STROLLPT_HBMAP_ALGO_NR; i++) {
+		if (strollpt_hbmap_show_stats(i, nsecs, loops))
+			goto fini_hbmap;
+	}
+
+	ret = EXIT_SUCCESS;
+
+fini_hbmap:
+	stroll_hbmap_fini(&hbmap);
+fini_fbmap:
+	stroll_fbmap_fini(&fbmap);
+free_nsecs:
+	free(nsecs);
+
+	return ret;
+}
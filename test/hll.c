@@ -0,0 +1,300 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#include "utest.h"
+#include "stroll/hll.h"
+#include <cute/cute.h>
+#include <cute/check.h>
+#include <cute/expect.h>
+
+#define STROLLUT_HLL_NOASSERT(_test) \
+	CUTE_TEST(_test) { cute_skip("assertion unsupported"); }
+
+static struct stroll_hll strollut_hll;
+static struct stroll_hll strollut_hll_other;
+static struct stroll_hll strollut_hll_ref;
+static bool              strollut_hll_tofree;
+
+static void
+strollut_hll_setup(void)
+{
+	strollut_hll_tofree = false;
+}
+
+static void
+strollut_hll_teardown(void)
+{
+	if (strollut_hll_tofree) {
+		stroll_hll_fini(&strollut_hll);
+		stroll_hll_fini(&strollut_hll_other);
+		stroll_hll_fini(&strollut_hll_ref);
+		strollut_hll_tofree = false;
+	}
+}
+
+static void
+strollut_hll_prepare(unsigned int prec)
+{
+	stroll_hll_init(&strollut_hll, prec);
+	stroll_hll_init(&strollut_hll_other, prec);
+	stroll_hll_init(&strollut_hll_ref, prec);
+	strollut_hll_tofree = true;
+}
+
+static void
+strollut_hll_fill(struct stroll_hll * hll,
+                  uint64_t            first,
+                  uint64_t            nr)
+{
+	uint64_t k;
+
+	for (k = first; k < (first + nr); k++)
+		cute_check_sint(stroll_hll_insert(hll, k), equal, 0);
+}
+
+/*
+ * Check estimation lies within `sigmas` standard errors, i.e.
+ * 1.04 / sqrt(2^prec), of the real cardinality.
+ */
+static void
+strollut_hll_check_count(const struct stroll_hll * hll,
+                         uint64_t                  nr,
+                         unsigned int              sigmas)
+{
+	double   err = 1.04 / (double)(1U << (stroll_hll_prec(hll) / 2));
+	uint64_t delta = (uint64_t)((double)nr * err * sigmas) + 1;
+
+	cute_check_uint_range(stroll_hll_count(hll),
+	                      in,
+	                      CUTE_UINT_RANGE(nr - delta, nr + delta));
+}
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_hll_init_assert)
+{
+	cute_expect_assertion(stroll_hll_init(NULL, STROLL_HLL_PREC_MIN));
+	cute_expect_assertion(stroll_hll_init(&strollut_hll,
+	                                      STROLL_HLL_PREC_MIN - 1));
+	cute_expect_assertion(stroll_hll_init(&strollut_hll,
+	                                      STROLL_HLL_PREC_MAX + 1));
+}
+#else
+STROLLUT_HLL_NOASSERT(strollut_hll_init_assert)
+#endif
+
+CUTE_TEST(strollut_hll_init)
+{
+	strollut_hll_prepare(14);
+
+	cute_check_uint(stroll_hll_prec(&strollut_hll), equal, 14);
+	cute_check_uint(stroll_hll_reg_nr(&strollut_hll), equal, 1U << 14);
+	cute_check_bool(stroll_hll_is_sparse(&strollut_hll), is, true);
+	cute_check_ptr(stroll_hll_regs(&strollut_hll), equal, NULL);
+	cute_check_uint(stroll_hll_count(&strollut_hll), equal, 0);
+}
+
+CUTE_TEST(strollut_hll_insert_sparse)
+{
+	strollut_hll_prepare(14);
+
+	strollut_hll_fill(&strollut_hll, 0, 1000);
+	cute_check_bool(stroll_hll_is_sparse(&strollut_hll), is, true);
+	strollut_hll_check_count(&strollut_hll, 1000, 1);
+
+	/* Registering the same keys again MUST NOT change estimation. */
+	strollut_hll_fill(&strollut_hll_ref, 0, 1000);
+	strollut_hll_fill(&strollut_hll_ref, 0, 1000);
+	cute_check_uint(stroll_hll_count(&strollut_hll_ref),
+	                equal,
+	                stroll_hll_count(&strollut_hll));
+}
+
+CUTE_TEST(strollut_hll_insert_dense)
+{
+	strollut_hll_prepare(12);
+
+	strollut_hll_fill(&strollut_hll, 0, 100000);
+	cute_check_bool(stroll_hll_is_sparse(&strollut_hll), is, false);
+	cute_check_ptr(stroll_hll_regs(&strollut_hll), unequal, NULL);
+	strollut_hll_check_count(&strollut_hll, 100000, 3);
+
+	strollut_hll_fill(&strollut_hll_other,
+	                  UINT64_C(0xdeadbeef00000000),
+	                  1000000);
+	strollut_hll_check_count(&strollut_hll_other, 1000000, 3);
+}
+
+CUTE_TEST(strollut_hll_insert_min_prec)
+{
+	strollut_hll_prepare(STROLL_HLL_PREC_MIN);
+
+	strollut_hll_fill(&strollut_hll, 0, 3);
+	cute_check_bool(stroll_hll_is_sparse(&strollut_hll), is, true);
+	strollut_hll_fill(&strollut_hll, 0, 10000);
+	cute_check_bool(stroll_hll_is_sparse(&strollut_hll), is, false);
+	strollut_hll_check_count(&strollut_hll, 10000, 3);
+}
+
+CUTE_TEST(strollut_hll_densify)
+{
+	uint64_t cnt;
+
+	strollut_hll_prepare(10);
+
+	strollut_hll_fill(&strollut_hll, 0, 100);
+	cnt = stroll_hll_count(&strollut_hll);
+	cute_check_bool(stroll_hll_is_sparse(&strollut_hll), is, true);
+
+	cute_check_sint(stroll_hll_densify(&strollut_hll), equal, 0);
+	cute_check_bool(stroll_hll_is_sparse(&strollut_hll), is, false);
+	cute_check_uint(stroll_hll_count(&strollut_hll), equal, cnt);
+
+	/* Densifying twice is harmless. */
+	cute_check_sint(stroll_hll_densify(&strollut_hll), equal, 0);
+	cute_check_uint(stroll_hll_count(&strollut_hll), equal, cnt);
+}
+
+CUTE_TEST(strollut_hll_merge_sparse)
+{
+	strollut_hll_prepare(14);
+
+	strollut_hll_fill(&strollut_hll, 0, 300);
+	strollut_hll_fill(&strollut_hll_other, 200, 300);
+	strollut_hll_fill(&strollut_hll_ref, 0, 500);
+
+	cute_check_sint(stroll_hll_merge(&strollut_hll, &strollut_hll_other),
+	                equal,
+	                0);
+	cute_check_bool(stroll_hll_is_sparse(&strollut_hll), is, true);
+	cute_check_uint(stroll_hll_count(&strollut_hll),
+	                equal,
+	                stroll_hll_count(&strollut_hll_ref));
+	strollut_hll_check_count(&strollut_hll, 500, 1);
+}
+
+/*
+ * Merging estimators MUST give the same registers as registering all keys into
+ * a single estimator.
+ */
+static void
+strollut_hll_check_merge(uint64_t nr, uint64_t other_nr)
+{
+	cute_check_sint(stroll_hll_densify(&strollut_hll_ref), equal, 0);
+	strollut_hll_fill(&strollut_hll, 0, nr);
+	strollut_hll_fill(&strollut_hll_other, nr, other_nr);
+	strollut_hll_fill(&strollut_hll_ref, 0, nr + other_nr);
+
+	cute_check_sint(stroll_hll_merge(&strollut_hll, &strollut_hll_other),
+	                equal,
+	                0);
+	cute_check_bool(stroll_hll_is_sparse(&strollut_hll), is, false);
+	cute_check_mem(stroll_hll_regs(&strollut_hll),
+	               equal,
+	               stroll_hll_regs(&strollut_hll_ref),
+	               stroll_hll_reg_nr(&strollut_hll));
+	cute_check_uint(stroll_hll_count(&strollut_hll),
+	                equal,
+	                stroll_hll_count(&strollut_hll_ref));
+}
+
+CUTE_TEST(strollut_hll_merge_dense)
+{
+	strollut_hll_prepare(12);
+	strollut_hll_check_merge(50000, 50000);
+}
+
+CUTE_TEST(strollut_hll_merge_sparse_dense)
+{
+	strollut_hll_prepare(12);
+	strollut_hll_check_merge(100, 50000);
+}
+
+CUTE_TEST(strollut_hll_merge_dense_sparse)
+{
+	strollut_hll_prepare(12);
+	strollut_hll_check_merge(50000, 100);
+}
+
+CUTE_TEST(strollut_hll_merge_sparse_overflow)
+{
+	/* Both estimators are sparse but their union does not fit. */
+	strollut_hll_prepare(8);
+	strollut_hll_check_merge(40, 40);
+}
+
+CUTE_TEST(strollut_hll_merge_regs)
+{
+	uint8_t      res[1U << STROLL_HLL_PREC_MIN];
+	uint8_t      regs[1U << STROLL_HLL_PREC_MIN];
+	uint8_t      ref[1U << STROLL_HLL_PREC_MIN];
+	unsigned int r;
+
+	for (r = 0; r < stroll_array_nr(res); r++) {
+		res[r] = (uint8_t)r;
+		regs[r] = (uint8_t)(stroll_array_nr(res) - r);
+		ref[r] = (uint8_t)stroll_max(res[r], regs[r]);
+	}
+
+	stroll_hll_merge_regs(res, regs, STROLL_HLL_PREC_MIN);
+	cute_check_mem(res, equal, ref, sizeof(ref));
+}
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_hll_merge_assert)
+{
+	int err __unused;
+
+	stroll_hll_init(&strollut_hll, 10);
+	stroll_hll_init(&strollut_hll_other, 11);
+	stroll_hll_init(&strollut_hll_ref, 10);
+	strollut_hll_tofree = true;
+
+	cute_expect_assertion(err = stroll_hll_merge(&strollut_hll,
+	                                             &strollut_hll_other));
+}
+#else
+STROLLUT_HLL_NOASSERT(strollut_hll_merge_assert)
+#endif
+
+CUTE_TEST(strollut_hll_clear)
+{
+	strollut_hll_prepare(10);
+
+	strollut_hll_fill(&strollut_hll, 0, 10);
+	stroll_hll_clear(&strollut_hll);
+	cute_check_bool(stroll_hll_is_sparse(&strollut_hll), is, true);
+	cute_check_uint(stroll_hll_count(&strollut_hll), equal, 0);
+
+	strollut_hll_fill(&strollut_hll, 0, 10000);
+	cute_check_bool(stroll_hll_is_sparse(&strollut_hll), is, false);
+	stroll_hll_clear(&strollut_hll);
+	cute_check_bool(stroll_hll_is_sparse(&strollut_hll), is, false);
+	cute_check_uint(stroll_hll_count(&strollut_hll), equal, 0);
+}
+
+CUTE_GROUP(strollut_hll_group) = {
+	CUTE_REF(strollut_hll_init_assert),
+	CUTE_REF(strollut_hll_init),
+	CUTE_REF(strollut_hll_insert_sparse),
+	CUTE_REF(strollut_hll_insert_dense),
+	CUTE_REF(strollut_hll_insert_min_prec),
+	CUTE_REF(strollut_hll_densify),
+	CUTE_REF(strollut_hll_merge_sparse),
+	CUTE_REF(strollut_hll_merge_dense),
+	CUTE_REF(strollut_hll_merge_sparse_dense),
+	CUTE_REF(strollut_hll_merge_dense_sparse),
+	CUTE_REF(strollut_hll_merge_sparse_overflow),
+	CUTE_REF(strollut_hll_merge_regs),
+	CUTE_REF(strollut_hll_merge_assert),
+	CUTE_REF(strollut_hll_clear)
+};
+
+CUTE_SUITE_EXTERN(strollut_hll_suite,
+                  strollut_hll_group,
+                  strollut_hll_setup,
+                  strollut_hll_teardown,
+                  CUTE_DFLT_TMOUT);
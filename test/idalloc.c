@@ -0,0 +1,409 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#include "utest.h"
+#include "stroll/idalloc.h"
+#include <cute/cute.h>
+#include <cute/check.h>
+#include <cute/expect.h>
+#include <errno.h>
+
+#define STROLLUT_IDALLOC_NOASSERT(_test) \
+	CUTE_TEST(_test) { cute_skip("assertion unsupported"); }
+
+/* Identifier counts exercising single / multiple and partial last words. */
+static const unsigned int strollut_idalloc_nr[] = {
+	1, 2, 63, 64, 65, 127, 128, 129, 1000
+};
+
+static struct stroll_idalloc strollut_idalloc;
+static bool                  strollut_idalloc_tofree;
+
+static void
+strollut_idalloc_setup(void)
+{
+	strollut_idalloc_tofree = false;
+}
+
+static void
+strollut_idalloc_teardown(void)
+{
+	if (strollut_idalloc_tofree) {
+		stroll_idalloc_fini(&strollut_idalloc);
+		strollut_idalloc_tofree = false;
+	}
+}
+
+static void
+strollut_idalloc_prepare(unsigned int nr)
+{
+	cute_check_sint(stroll_idalloc_init(&strollut_idalloc, nr), equal, 0);
+	strollut_idalloc_tofree = true;
+}
+
+static void
+strollut_idalloc_release(void)
+{
+	stroll_idalloc_fini(&strollut_idalloc);
+	strollut_idalloc_tofree = false;
+}
+
+static void
+strollut_idalloc_check_busy(unsigned int start_id,
+                            unsigned int id_count,
+                            bool         busy)
+{
+	unsigned int id;
+
+	for (id = start_id; id < (start_id + id_count); id++)
+		cute_check_bool(stroll_idalloc_is_busy(&strollut_idalloc, id),
+		                is,
+		                busy);
+}
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_idalloc_init_assert)
+{
+	int err __unused;
+
+	cute_expect_assertion(err = stroll_idalloc_init(NULL, 1));
+	cute_expect_assertion(err = stroll_idalloc_init(&strollut_idalloc, 0));
+	cute_expect_assertion(err = stroll_idalloc_init(
+		&strollut_idalloc,
+		(unsigned int)INT_MAX + 1));
+}
+#else
+STROLLUT_IDALLOC_NOASSERT(strollut_idalloc_init_assert)
+#endif
+
+CUTE_TEST(strollut_idalloc_init)
+{
+	unsigned int n;
+
+	for (n = 0; n < stroll_array_nr(strollut_idalloc_nr); n++) {
+		strollut_idalloc_prepare(strollut_idalloc_nr[n]);
+
+		cute_check_uint(stroll_idalloc_nr(&strollut_idalloc),
+		                equal,
+		                strollut_idalloc_nr[n]);
+		strollut_idalloc_check_busy(0, strollut_idalloc_nr[n], false);
+
+		strollut_idalloc_release();
+	}
+}
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_idalloc_id_assert)
+{
+	bool res __unused;
+	int  err __unused;
+
+	strollut_idalloc_prepare(65);
+
+	cute_expect_assertion(res = stroll_idalloc_is_busy(&strollut_idalloc,
+	                                                   65));
+	cute_expect_assertion(stroll_idalloc_free(&strollut_idalloc, 65));
+	/* Releasing a free identifier. */
+	cute_expect_assertion(stroll_idalloc_free(&strollut_idalloc, 3));
+	cute_expect_assertion(err = stroll_idalloc_reserve_range(
+		&strollut_idalloc, 0, 0));
+	cute_expect_assertion(err = stroll_idalloc_reserve_range(
+		&strollut_idalloc, 60, 6));
+	cute_expect_assertion(err = stroll_idalloc_alloc_range(
+		&strollut_idalloc, 0));
+	cute_expect_assertion(err = stroll_idalloc_alloc_range(
+		&strollut_idalloc, 66));
+	cute_expect_assertion(stroll_idalloc_free_range(&strollut_idalloc,
+	                                                64,
+	                                                2));
+
+	strollut_idalloc_release();
+}
+#else
+STROLLUT_IDALLOC_NOASSERT(strollut_idalloc_id_assert)
+#endif
+
+CUTE_TEST(strollut_idalloc_alloc)
+{
+	unsigned int n;
+
+	for (n = 0; n < stroll_array_nr(strollut_idalloc_nr); n++) {
+		unsigned int nr = strollut_idalloc_nr[n];
+		unsigned int id;
+
+		strollut_idalloc_prepare(nr);
+
+		for (id = 0; id < nr; id++)
+			cute_check_sint(stroll_idalloc_alloc(&strollut_idalloc),
+			                equal,
+			                (int)id);
+		cute_check_sint(stroll_idalloc_alloc(&strollut_idalloc),
+		                equal,
+		                -ENOSPC);
+		strollut_idalloc_check_busy(0, nr, true);
+
+		for (id = 0; id < nr; id += 3)
+			stroll_idalloc_free(&strollut_idalloc, id);
+		for (id = 0; id < nr; id++)
+			cute_check_bool(
+				stroll_idalloc_is_busy(&strollut_idalloc, id),
+				is,
+				!!(id % 3));
+
+		for (id = 0; id < nr; id += 3) {
+			int ret = stroll_idalloc_alloc(&strollut_idalloc);
+
+			cute_check_sint(ret, greater_equal, 0);
+			cute_check_sint(ret % 3, equal, 0);
+		}
+		cute_check_sint(stroll_idalloc_alloc(&strollut_idalloc),
+		                equal,
+		                -ENOSPC);
+		strollut_idalloc_check_busy(0, nr, true);
+
+		strollut_idalloc_release();
+	}
+}
+
+CUTE_TEST(strollut_idalloc_next_fit)
+{
+	unsigned int id;
+
+	strollut_idalloc_prepare(200);
+
+	for (id = 0; id < 130; id++)
+		cute_check_sint(stroll_idalloc_alloc(&strollut_idalloc),
+		                equal,
+		                (int)id);
+
+	/* Released identifier located before cursor is not re-used first... */
+	stroll_idalloc_free(&strollut_idalloc, 5);
+	for (id = 130; id < 200; id++)
+		cute_check_sint(stroll_idalloc_alloc(&strollut_idalloc),
+		                equal,
+		                (int)id);
+
+	/* ...until the search wraps around. */
+	cute_check_sint(stroll_idalloc_alloc(&strollut_idalloc), equal, 5);
+	cute_check_sint(stroll_idalloc_alloc(&strollut_idalloc),
+	                equal,
+	                -ENOSPC);
+
+	strollut_idalloc_release();
+}
+
+CUTE_TEST(strollut_idalloc_reserve_range)
+{
+	strollut_idalloc_prepare(200);
+
+	cute_check_sint(stroll_idalloc_reserve_range(&strollut_idalloc, 60, 10),
+	                equal,
+	                0);
+	strollut_idalloc_check_busy(0, 60, false);
+	strollut_idalloc_check_busy(60, 10, true);
+	strollut_idalloc_check_busy(70, 130, false);
+
+	cute_check_sint(stroll_idalloc_reserve_range(&strollut_idalloc, 65, 1),
+	                equal,
+	                -EBUSY);
+	/* Claimed words must be rolled back on failure. */
+	cute_check_sint(stroll_idalloc_reserve_range(&strollut_idalloc, 0, 61),
+	                equal,
+	                -EBUSY);
+	cute_check_sint(stroll_idalloc_reserve_range(&strollut_idalloc,
+	                                             69,
+	                                             131),
+	                equal,
+	                -EBUSY);
+	strollut_idalloc_check_busy(0, 60, false);
+	strollut_idalloc_check_busy(60, 10, true);
+	strollut_idalloc_check_busy(70, 130, false);
+
+	cute_check_sint(stroll_idalloc_reserve_range(&strollut_idalloc,
+	                                             70,
+	                                             130),
+	                equal,
+	                0);
+	strollut_idalloc_check_busy(60, 140, true);
+
+	stroll_idalloc_free_range(&strollut_idalloc, 60, 140);
+	strollut_idalloc_check_busy(0, 200, false);
+
+	cute_check_sint(stroll_idalloc_reserve_range(&strollut_idalloc, 0, 200),
+	                equal,
+	                0);
+	cute_check_sint(stroll_idalloc_alloc(&strollut_idalloc),
+	                equal,
+	                -ENOSPC);
+
+	strollut_idalloc_release();
+}
+
+CUTE_TEST(strollut_idalloc_alloc_range)
+{
+	strollut_idalloc_prepare(256);
+
+	cute_check_sint(stroll_idalloc_alloc_range(&strollut_idalloc, 100),
+	                equal,
+	                0);
+	cute_check_sint(stroll_idalloc_alloc_range(&strollut_idalloc, 100),
+	                equal,
+	                100);
+	cute_check_sint(stroll_idalloc_alloc_range(&strollut_idalloc, 100),
+	                equal,
+	                -ENOSPC);
+	strollut_idalloc_check_busy(0, 200, true);
+	strollut_idalloc_check_busy(200, 56, false);
+
+	/* Search must wrap around. */
+	stroll_idalloc_free_range(&strollut_idalloc, 0, 100);
+	cute_check_sint(stroll_idalloc_alloc_range(&strollut_idalloc, 100),
+	                equal,
+	                0);
+	cute_check_sint(stroll_idalloc_alloc_range(&strollut_idalloc, 56),
+	                equal,
+	                200);
+	cute_check_sint(stroll_idalloc_alloc_range(&strollut_idalloc, 1),
+	                equal,
+	                -ENOSPC);
+	stroll_idalloc_free_range(&strollut_idalloc, 0, 256);
+	strollut_idalloc_check_busy(0, 256, false);
+
+	strollut_idalloc_release();
+}
+
+CUTE_TEST(strollut_idalloc_alloc_range_frag)
+{
+	strollut_idalloc_prepare(256);
+
+	cute_check_sint(stroll_idalloc_reserve_range(&strollut_idalloc, 10, 1),
+	                equal,
+	                0);
+	cute_check_sint(stroll_idalloc_reserve_range(&strollut_idalloc, 80, 1),
+	                equal,
+	                0);
+	cute_check_sint(stroll_idalloc_reserve_range(&strollut_idalloc,
+	                                             130,
+	                                             126),
+	                equal,
+	                0);
+
+	cute_check_sint(stroll_idalloc_alloc_range(&strollut_idalloc, 50),
+	                equal,
+	                11);
+	cute_check_sint(stroll_idalloc_alloc_range(&strollut_idalloc, 49),
+	                equal,
+	                81);
+	/* Skip runs too short to hold requested range. */
+	cute_check_sint(stroll_idalloc_alloc_range(&strollut_idalloc, 20),
+	                equal,
+	                -ENOSPC);
+	cute_check_sint(stroll_idalloc_alloc_range(&strollut_idalloc, 10),
+	                equal,
+	                0);
+	strollut_idalloc_check_busy(0, 61, true);
+	strollut_idalloc_check_busy(61, 19, false);
+	strollut_idalloc_check_busy(80, 176, true);
+
+	cute_check_sint(stroll_idalloc_alloc_range(&strollut_idalloc, 19),
+	                equal,
+	                61);
+	cute_check_sint(stroll_idalloc_alloc(&strollut_idalloc),
+	                equal,
+	                -ENOSPC);
+
+	strollut_idalloc_release();
+}
+
+CUTE_TEST(strollut_idalloc_cached)
+{
+	struct stroll_idalloc_cache cache = STROLL_IDALLOC_CACHE_INIT;
+	unsigned int                id;
+
+	strollut_idalloc_prepare(130);
+
+	/* First refill grabs all identifiers of the first word. */
+	cute_check_sint(stroll_idalloc_alloc_cached(&strollut_idalloc, &cache),
+	                equal,
+	                0);
+	strollut_idalloc_check_busy(0, 64, true);
+	cute_check_sint(stroll_idalloc_alloc(&strollut_idalloc), equal, 64);
+
+	for (id = 1; id < 64; id++)
+		cute_check_sint(stroll_idalloc_alloc_cached(&strollut_idalloc,
+		                                            &cache),
+		                equal,
+		                (int)id);
+
+	/* Identifiers of the cached word are given back to the cache... */
+	stroll_idalloc_free_cached(&strollut_idalloc, &cache, 3);
+	cute_check_bool(stroll_idalloc_is_busy(&strollut_idalloc, 3),
+	                is,
+	                true);
+	cute_check_sint(stroll_idalloc_alloc_cached(&strollut_idalloc, &cache),
+	                equal,
+	                3);
+
+	/* ...whereas others are released into the allocator. */
+	stroll_idalloc_free_cached(&strollut_idalloc, &cache, 64);
+	cute_check_bool(stroll_idalloc_is_busy(&strollut_idalloc, 64),
+	                is,
+	                false);
+
+	/* Next refill grabs remaining identifiers of the second word. */
+	cute_check_sint(stroll_idalloc_alloc_cached(&strollut_idalloc, &cache),
+	                equal,
+	                64);
+	strollut_idalloc_check_busy(64, 64, true);
+	strollut_idalloc_check_busy(128, 2, false);
+	stroll_idalloc_flush_cache(&strollut_idalloc, &cache);
+	strollut_idalloc_check_busy(0, 64, true);
+	strollut_idalloc_check_busy(64, 1, true);
+	strollut_idalloc_check_busy(65, 65, false);
+
+	/* Identifiers beyond the last one must never be handed out. */
+	cute_check_sint(stroll_idalloc_reserve_range(&strollut_idalloc, 65, 63),
+	                equal,
+	                0);
+	cute_check_sint(stroll_idalloc_alloc_cached(&strollut_idalloc, &cache),
+	                equal,
+	                128);
+	cute_check_sint(stroll_idalloc_alloc_cached(&strollut_idalloc, &cache),
+	                equal,
+	                129);
+	cute_check_sint(stroll_idalloc_alloc_cached(&strollut_idalloc, &cache),
+	                equal,
+	                -ENOSPC);
+	strollut_idalloc_check_busy(0, 130, true);
+
+	stroll_idalloc_flush_cache(&strollut_idalloc, &cache);
+	strollut_idalloc_check_busy(0, 130, true);
+	stroll_idalloc_free_cached(&strollut_idalloc, &cache, 129);
+	cute_check_bool(stroll_idalloc_is_busy(&strollut_idalloc, 129),
+	                is,
+	                false);
+
+	strollut_idalloc_release();
+}
+
+CUTE_GROUP(strollut_idalloc_group) = {
+	CUTE_REF(strollut_idalloc_init_assert),
+	CUTE_REF(strollut_idalloc_init),
+	CUTE_REF(strollut_idalloc_id_assert),
+	CUTE_REF(strollut_idalloc_alloc),
+	CUTE_REF(strollut_idalloc_next_fit),
+	CUTE_REF(strollut_idalloc_reserve_range),
+	CUTE_REF(strollut_idalloc_alloc_range),
+	CUTE_REF(strollut_idalloc_alloc_range_frag),
+	CUTE_REF(strollut_idalloc_cached)
+};
+
+CUTE_SUITE_EXTERN(strollut_idalloc_suite,
+                  strollut_idalloc_group,
+                  strollut_idalloc_setup,
+                  strollut_idalloc_teardown,
+                  CUTE_DFLT_TMOUT);
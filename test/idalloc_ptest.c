@@ -0,0 +1,334 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#include "ptest.h"
+#include "stroll/idalloc.h"
+#include <stdint.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <math.h>
+
+/*
+ * Measure the time taken by multiple threads concurrently allocating then
+ * releasing bursts of identifiers, either directly from the shared allocator
+ * or through per-thread caches.
+ */
+enum strollpt_idalloc_algo {
+	STROLLPT_IDALLOC_SHARED_ALGO = 0,
+	STROLLPT_IDALLOC_CACHED_ALGO = 1,
+	STROLLPT_IDALLOC_ALGO_NR
+};
+
+static const char * strollpt_idalloc_algos[] = {
+	[STROLLPT_IDALLOC_SHARED_ALGO] = "shared",
+	[STROLLPT_IDALLOC_CACHED_ALGO] = "cached"
+};
+
+#define STROLLPT_IDALLOC_BURST_NR (32U)
+#define STROLLPT_IDALLOC_ROUND_NR (1024U)
+#define STROLLPT_IDALLOC_THREAD_MAX (256U)
+
+struct strollpt_idalloc_worker {
+	pthread_t                  thread;
+	struct stroll_idalloc *    alloc;
+	enum strollpt_idalloc_algo algo;
+	int                        err;
+	unsigned int               ids[STROLLPT_IDALLOC_BURST_NR];
+};
+
+static void *
+strollpt_idalloc_run(void * arg)
+{
+	struct strollpt_idalloc_worker * wrk = arg;
+	struct stroll_idalloc_cache      cache = STROLL_IDALLOC_CACHE_INIT;
+	unsigned int                     r;
+
+	wrk->err = 0;
+	for (r = 0; r < STROLLPT_IDALLOC_ROUND_NR; r++) {
+		unsigned int i;
+
+		for (i = 0; i < STROLLPT_IDALLOC_BURST_NR; i++) {
+			int id;
+
+			if (wrk->algo == STROLLPT_IDALLOC_CACHED_ALGO)
+				id = stroll_idalloc_alloc_cached(wrk->alloc,
+				                                 &cache);
+			else
+				id = stroll_idalloc_alloc(wrk->alloc);
+			if (id < 0) {
+				wrk->err = id;
+				goto flush;
+			}
+
+			wrk->ids[i] = (unsigned int)id;
+		}
+
+		for (i = 0; i < STROLLPT_IDALLOC_BURST_NR; i++) {
+			if (wrk->algo == STROLLPT_IDALLOC_CACHED_ALGO)
+				stroll_idalloc_free_cached(wrk->alloc,
+				                           &cache,
+				                           wrk->ids[i]);
+			else
+				stroll_idalloc_free(wrk->alloc, wrk->ids[i]);
+		}
+	}
+
+flush:
+	stroll_idalloc_flush_cache(wrk->alloc, &cache);
+
+	return NULL;
+}
+
+static int
+strollpt_idalloc_measure(struct stroll_idalloc * __restrict          alloc,
+                         struct strollpt_idalloc_worker * __restrict workers,
+                         unsigned int                                nr,
+                         enum strollpt_idalloc_algo                  algo,
+                         unsigned long long * __restrict             nsecs)
+{
+	struct timespec start, elapse;
+	unsigned int    w;
+	int             ret = EXIT_SUCCESS;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (w = 0; w < nr; w++) {
+		workers[w].alloc = alloc;
+		workers[w].algo = algo;
+		if (pthread_create(&workers[w].thread,
+		                   NULL,
+		                   strollpt_idalloc_run,
+		                   &workers[w])) {
+			strollpt_err("cannot create thread.\n");
+			ret = EXIT_FAILURE;
+			break;
+		}
+	}
+
+	nr = w;
+	for (w = 0; w < nr; w++) {
+		pthread_join(workers[w].thread, NULL);
+		if (workers[w].err) {
+			strollpt_err("cannot allocate identifier: %s (%d).\n",
+			             strerror(-workers[w].err),
+			             -workers[w].err);
+			ret = EXIT_FAILURE;
+		}
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &elapse);
+	elapse = strollpt_tspec_sub(&elapse, &start);
+	nsecs[algo] = strollpt_tspec2ns(&elapse);
+
+	return ret;
+}
+
+static int
+strollpt_idalloc_parse_uint(const char * __restrict   arg,
+                            const char * __restrict   name,
+                            unsigned int              max,
+                            unsigned int * __restrict value)
+{
+	char *        str;
+	unsigned long nr;
+
+	nr = strtoul(arg, &str, 0);
+	if (*str || !nr || (nr > max)) {
+		strollpt_err("invalid number of %s '%s' specified: "
+		             "integer within [1, %u] range expected.\n",
+		             name,
+		             arg,
+		             max);
+		return EXIT_FAILURE;
+	}
+
+	*value = (unsigned int)nr;
+
+	return EXIT_SUCCESS;
+}
+
+static int
+strollpt_idalloc_show_stats(enum strollpt_idalloc_algo algo,
+                            unsigned long long *       nsecs,
+                            unsigned int               loops)
+{
+	struct strollpt_stats stats;
+
+	if (strollpt_calc_stats(&stats,
+	                        &nsecs[algo],
+	                        STROLLPT_IDALLOC_ALGO_NR,
+	                        loops))
+		return EXIT_FAILURE;
+
+	printf("%s:\n"
+	       "    #Inliers:   %u (%.2lf%%)\n"
+	       "    Mininum:    %llu nSec\n"
+	       "    Maximum:    %llu nSec\n"
+	       "    Deviation:  %llu nSec\n"
+	       "    Median:     %llu nSec\n"
+	       "    Mean:       %llu nSec\n",
+	       strollpt_idalloc_algos[algo],
+	       stats.count, ((double)stats.count * 100.0) / (double)loops,
+	       stats.min,
+	       stats.max,
+	       (unsigned long long)round(stats.stdev),
+	       stats.med,
+	       (unsigned long long)round(stats.mean));
+
+	return EXIT_SUCCESS;
+}
+
+static void
+strollpt_idalloc_usage(FILE * __restrict stdio)
+{
+	fprintf(stdio,
+	        "Usage: %s [OPTIONS] IDS THREADS LOOPS\n"
+	        "where OPTIONS:\n"
+	        "    -p|--prio PRIORITY\n"
+	        "    -h|--help\n",
+	        program_invocation_short_name);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned int                     nr;
+	unsigned int                     thr_nr;
+	unsigned int                     loops;
+	int                              prio = 0;
+	struct stroll_idalloc            alloc;
+	struct strollpt_idalloc_worker * workers;
+	unsigned long long *             nsecs;
+	unsigned int                     i;
+	int                              ret = EXIT_FAILURE;
+
+	while (true) {
+		int                        opt;
+		static const struct option lopts[] = {
+			{"help", 0, NULL, 'h'},
+			{"prio", 1, NULL, 'p'},
+			{0,      0, 0,    0}
+		};
+
+		opt = getopt_long(argc, argv, "hp:", lopts, NULL);
+		if (opt < 0)
+			/* No more options: go parsing positional arguments. */
+			break;
+
+		switch (opt) {
+		case 'p': /* priority */
+			if (strollpt_parse_sched_prio(optarg, &prio)) {
+				strollpt_idalloc_usage(stderr);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 'h': /* Help message. */
+			strollpt_idalloc_usage(stdout);
+			exit(EXIT_SUCCESS);
+
+		case '?': /* Unknown option. */
+		default:
+			strollpt_idalloc_usage(stderr);
+			return EXIT_FAILURE;
+		}
+	}
+
+	/*
+	 * Check positional arguments are properly specified on command
+	 * line.
+	 */
+	argc -= optind;
+	if (argc != 3) {
+		strollpt_err("invalid number of arguments.\n");
+		strollpt_idalloc_usage(stderr);
+		return EXIT_FAILURE;
+	}
+
+	if (strollpt_idalloc_parse_uint(argv[optind],
+	                                "identifiers",
+	                                INT_MAX,
+	                                &nr))
+		return EXIT_FAILURE;
+
+	if (strollpt_idalloc_parse_uint(argv[optind + 1],
+	                                "threads",
+	                                STROLLPT_IDALLOC_THREAD_MAX,
+	                                &thr_nr))
+		return EXIT_FAILURE;
+
+	if (strollpt_parse_loop_nr(argv[optind + 2], &loops))
+		return EXIT_FAILURE;
+
+	/*
+	 * Each thread may hold up to a burst of identifiers plus a whole word
+	 * worth of cached identifiers.
+	 */
+	if (nr < (thr_nr * (STROLLPT_IDALLOC_BURST_NR + __WORDSIZE))) {
+		strollpt_err("invalid number of identifiers '%s' specified: "
+		             "at least %u required.\n",
+		             argv[optind],
+		             thr_nr * (STROLLPT_IDALLOC_BURST_NR + __WORDSIZE));
+		return EXIT_FAILURE;
+	}
+
+	nsecs = malloc(STROLLPT_IDALLOC_ALGO_NR * loops * sizeof(nsecs[0]));
+	if (!nsecs)
+		return EXIT_FAILURE;
+
+	workers = malloc(thr_nr * sizeof(workers[0]));
+	if (!workers)
+		goto free_nsecs;
+
+	if (stroll_idalloc_init(&alloc, nr))
+		goto free_workers;
+
+	if (strollpt_setup_sched_prio(prio))
+		goto fini_alloc;
+
+	for (i = 0; i < loops; i++) {
+		unsigned int a;
+
+		for (a = 0; a < STROLLPT_IDALLOC_ALGO_NR; a++) {
+			if (strollpt_idalloc_measure(
+				&alloc,
+				workers,
+				thr_nr,
+				(enum strollpt_idalloc_algo)a,
+				&nsecs[i * STROLLPT_IDALLOC_ALGO_NR]))
+				goto fini_alloc;
+		}
+	}
+
+	printf("#Identifiers:   %u\n"
+	       "#Threads:       %u\n"
+	       "#Operations:    %u\n"
+	       "#Loops:         %u\n",
+	       nr,
+	       thr_nr,
+	       thr_nr * STROLLPT_IDALLOC_ROUND_NR * STROLLPT_IDALLOC_BURST_NR,
+	       loops);
+	for (i = 0; i < STROLLPT_IDALLOC_ALGO_NR; i++) {
+		if (strollpt_idalloc_show_stats(i, nsecs, loops))
+			goto fini_alloc;
+	}
+
+	ret = EXIT_SUCCESS;
+
+fini_alloc:
+	stroll_idalloc_fini(&alloc);
+free_workers:
+	free(workers);
+free_nsecs:
+	free(nsecs);
+
+	return ret;
+}
@@ -0,0 +1,509 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#include "utest.h"
+#include "stroll/rbmap.h"
+#include <cute/cute.h>
+#include <cute/check.h>
+#include <cute/expect.h>
+#include <errno.h>
+
+#define STROLLUT_RBMAP_NOASSERT(_test) \
+	CUTE_TEST(_test) { cute_skip("assertion unsupported"); }
+
+#define STROLLUT_RBMAP_CHUNK_NR (1U << 16)
+
+/* Chunks exercised, i.e. 16 most significant bits of integers. */
+static const uint32_t strollut_rbmap_keys[] = { 0, 1, 7, 0xffff };
+
+#define STROLLUT_RBMAP_KEY_NR stroll_array_nr(strollut_rbmap_keys)
+
+typedef bool strollut_rbmap_ref_t[STROLLUT_RBMAP_KEY_NR]
+                                 [STROLLUT_RBMAP_CHUNK_NR];
+
+static struct stroll_rbmap    strollut_rbmap_maps[3];
+static strollut_rbmap_ref_t * strollut_rbmap_refs;
+static uint64_t               strollut_rbmap_seed;
+
+static void
+strollut_rbmap_setup(void)
+{
+	unsigned int m;
+
+	for (m = 0; m < stroll_array_nr(strollut_rbmap_maps); m++)
+		stroll_rbmap_init(&strollut_rbmap_maps[m]);
+
+	strollut_rbmap_refs = calloc(3, sizeof(strollut_rbmap_refs[0]));
+	strollut_rbmap_seed = UINT64_C(0x2545f4914f6cdd1d);
+}
+
+static void
+strollut_rbmap_teardown(void)
+{
+	unsigned int m;
+
+	for (m = 0; m < stroll_array_nr(strollut_rbmap_maps); m++)
+		stroll_rbmap_fini(&strollut_rbmap_maps[m]);
+
+	free(strollut_rbmap_refs);
+}
+
+static unsigned int
+strollut_rbmap_rand(unsigned int max)
+{
+	strollut_rbmap_seed ^= strollut_rbmap_seed << 13;
+	strollut_rbmap_seed ^= strollut_rbmap_seed >> 7;
+	strollut_rbmap_seed ^= strollut_rbmap_seed << 17;
+
+	return (unsigned int)(strollut_rbmap_seed % max);
+}
+
+static uint32_t
+strollut_rbmap_value(unsigned int key, unsigned int low)
+{
+	return (strollut_rbmap_keys[key] << 16) | low;
+}
+
+static void
+strollut_rbmap_add(unsigned int map, unsigned int key, unsigned int low)
+{
+	cute_check_sint(stroll_rbmap_add(&strollut_rbmap_maps[map],
+	                                 strollut_rbmap_value(key, low)),
+	                equal,
+	                0);
+	strollut_rbmap_refs[map][key][low] = true;
+}
+
+static void
+strollut_rbmap_add_range(unsigned int map,
+                         unsigned int key,
+                         unsigned int start,
+                         unsigned int count)
+{
+	while (count--)
+		strollut_rbmap_add(map, key, start++);
+}
+
+static void
+strollut_rbmap_remove(unsigned int map, unsigned int key, unsigned int low)
+{
+	cute_check_sint(stroll_rbmap_remove(&strollut_rbmap_maps[map],
+	                                    strollut_rbmap_value(key, low)),
+	                equal,
+	                0);
+	strollut_rbmap_refs[map][key][low] = false;
+}
+
+/*
+ * Check content of a compressed bitmap against its reference using both
+ * membership tests and iteration.
+ */
+static void
+strollut_rbmap_check(const struct stroll_rbmap * rbmap,
+                     strollut_rbmap_ref_t *      ref)
+{
+	struct stroll_rbmap_iter iter;
+	int64_t                  value;
+	uint64_t                 card = 0;
+	unsigned int             k;
+	unsigned int             l;
+
+	value = stroll_rbmap_init_iter(&iter, rbmap);
+	for (k = 0; k < STROLLUT_RBMAP_KEY_NR; k++) {
+		for (l = 0; l < STROLLUT_RBMAP_CHUNK_NR; l++) {
+			uint32_t v = strollut_rbmap_value(k, l);
+
+			cute_check_bool(stroll_rbmap_contains(rbmap, v),
+			                is,
+			                (*ref)[k][l]);
+			if (!(*ref)[k][l])
+				continue;
+
+			cute_check_sint(value, equal, (int64_t)v);
+			value = stroll_rbmap_step_iter(&iter);
+			card++;
+		}
+	}
+
+	cute_check_sint(value, equal, -ENOENT);
+	cute_check_uint(stroll_rbmap_cardinality(rbmap), equal, card);
+	cute_check_bool(stroll_rbmap_empty(rbmap), is, !card);
+
+	/* Chunk not exercised. */
+	cute_check_bool(stroll_rbmap_contains(rbmap, UINT32_C(0x20005)),
+	                is,
+	                false);
+}
+
+/* Check serialization / deserialization round trip. */
+static void
+strollut_rbmap_check_serial(const struct stroll_rbmap * rbmap,
+                            strollut_rbmap_ref_t *      ref)
+{
+	size_t              sz = stroll_rbmap_serialized_size(rbmap);
+	uint8_t *           buff;
+	struct stroll_rbmap load;
+
+	buff = malloc(sz);
+	cute_check_ptr(buff, unequal, NULL);
+
+	cute_check_sint(stroll_rbmap_serialize(rbmap, buff, sz - 1),
+	                equal,
+	                -ENOSPC);
+	cute_check_sint(stroll_rbmap_serialize(rbmap, buff, sz),
+	                equal,
+	                (ssize_t)sz);
+
+	cute_check_sint(stroll_rbmap_init_deserialize(&load, buff, sz - 1),
+	                equal,
+	                -EINVAL);
+	cute_check_sint(stroll_rbmap_init_deserialize(&load, buff, sz),
+	                equal,
+	                0);
+	strollut_rbmap_check(&load, ref);
+	cute_check_uint(stroll_rbmap_serialized_size(&load), equal, sz);
+	stroll_rbmap_fini(&load);
+
+	free(buff);
+}
+
+#if defined(CONFIG_STROLL_ASSERT_API)
+CUTE_TEST(strollut_rbmap_assert)
+{
+	struct stroll_rbmap_iter iter;
+	uint64_t                 card __unused;
+	int64_t                  val __unused;
+	bool                     res __unused;
+	int                      err __unused;
+	uint8_t                  buff[8];
+
+	cute_expect_assertion(stroll_rbmap_init(NULL));
+	cute_expect_assertion(card = stroll_rbmap_cardinality(NULL));
+	cute_expect_assertion(res = stroll_rbmap_contains(NULL, 0));
+	cute_expect_assertion(err = stroll_rbmap_add(NULL, 0));
+	cute_expect_assertion(err = stroll_rbmap_remove(NULL, 0));
+	cute_expect_assertion(err = stroll_rbmap_optimize(NULL));
+	cute_expect_assertion(val = stroll_rbmap_init_iter(&iter, NULL));
+	cute_expect_assertion(err = stroll_rbmap_init_deserialize(NULL,
+	                                                          buff,
+	                                                          8));
+}
+#else
+STROLLUT_RBMAP_NOASSERT(strollut_rbmap_assert)
+#endif
+
+CUTE_TEST(strollut_rbmap_empty)
+{
+	strollut_rbmap_check(&strollut_rbmap_maps[0], &strollut_rbmap_refs[0]);
+	cute_check_uint(stroll_rbmap_serialized_size(&strollut_rbmap_maps[0]),
+	                equal,
+	                8);
+	strollut_rbmap_check_serial(&strollut_rbmap_maps[0],
+	                            &strollut_rbmap_refs[0]);
+
+	/* Removing from empty bitmap is a no-op. */
+	cute_check_sint(stroll_rbmap_remove(&strollut_rbmap_maps[0], 5),
+	                equal,
+	                0);
+	strollut_rbmap_check(&strollut_rbmap_maps[0], &strollut_rbmap_refs[0]);
+}
+
+CUTE_TEST(strollut_rbmap_sparse)
+{
+	unsigned int k;
+	unsigned int n;
+
+	for (k = 0; k < STROLLUT_RBMAP_KEY_NR; k++)
+		for (n = 0; n < 1000; n++)
+			strollut_rbmap_add(
+				0,
+				k,
+				strollut_rbmap_rand(STROLLUT_RBMAP_CHUNK_NR));
+	/* Duplicates are no-ops. */
+	strollut_rbmap_add(0, 2, 100);
+	strollut_rbmap_add(0, 2, 100);
+	strollut_rbmap_check(&strollut_rbmap_maps[0], &strollut_rbmap_refs[0]);
+
+	for (k = 0; k < STROLLUT_RBMAP_KEY_NR; k++)
+		for (n = 0; n < STROLLUT_RBMAP_CHUNK_NR; n += 2)
+			strollut_rbmap_remove(0, k, n);
+	strollut_rbmap_check(&strollut_rbmap_maps[0], &strollut_rbmap_refs[0]);
+	strollut_rbmap_check_serial(&strollut_rbmap_maps[0],
+	                            &strollut_rbmap_refs[0]);
+
+	/* Emptying chunks must release their containers. */
+	for (n = 0; n < STROLLUT_RBMAP_CHUNK_NR; n++)
+		strollut_rbmap_remove(0, 1, n);
+	strollut_rbmap_check(&strollut_rbmap_maps[0], &strollut_rbmap_refs[0]);
+	cute_check_uint(strollut_rbmap_maps[0].nr,
+	                equal,
+	                STROLLUT_RBMAP_KEY_NR - 1);
+}
+
+CUTE_TEST(strollut_rbmap_dense)
+{
+	unsigned int n;
+
+	/* Turn array container into a bitmap one... */
+	for (n = 0; n < 10000; n++)
+		strollut_rbmap_add(0, 3, (n * 5) % STROLLUT_RBMAP_CHUNK_NR);
+	strollut_rbmap_check(&strollut_rbmap_maps[0], &strollut_rbmap_refs[0]);
+	strollut_rbmap_check_serial(&strollut_rbmap_maps[0],
+	                            &strollut_rbmap_refs[0]);
+
+	/* ...and back to array container. */
+	for (n = 0; n < 6000; n++)
+		strollut_rbmap_remove(0, 3, n * 5);
+	strollut_rbmap_check(&strollut_rbmap_maps[0], &strollut_rbmap_refs[0]);
+	strollut_rbmap_check_serial(&strollut_rbmap_maps[0],
+	                            &strollut_rbmap_refs[0]);
+
+	/* Full chunk. */
+	strollut_rbmap_add_range(0, 0, 0, STROLLUT_RBMAP_CHUNK_NR);
+	strollut_rbmap_check(&strollut_rbmap_maps[0], &strollut_rbmap_refs[0]);
+	strollut_rbmap_check_serial(&strollut_rbmap_maps[0],
+	                            &strollut_rbmap_refs[0]);
+}
+
+CUTE_TEST(strollut_rbmap_runs)
+{
+	unsigned int n;
+
+	strollut_rbmap_add_range(0, 0, 10, 100);
+	strollut_rbmap_add_range(0, 0, 1000, 20);
+	strollut_rbmap_add_range(0, 1, 0, 30000);
+	strollut_rbmap_add_range(0, 1, 40000, 25536);
+	strollut_rbmap_add_range(0, 2, 5, 1);
+	strollut_rbmap_add_range(0, 2, 7, 1);
+	strollut_rbmap_add_range(0, 3, 65500, 36);
+
+	cute_check_sint(stroll_rbmap_optimize(&strollut_rbmap_maps[0]),
+	                equal,
+	                0);
+	strollut_rbmap_check(&strollut_rbmap_maps[0], &strollut_rbmap_refs[0]);
+	strollut_rbmap_check_serial(&strollut_rbmap_maps[0],
+	                            &strollut_rbmap_refs[0]);
+
+	/* Extend, merge and create runs. */
+	strollut_rbmap_add(0, 0, 9);
+	strollut_rbmap_add(0, 0, 110);
+	strollut_rbmap_add(0, 0, 500);
+	for (n = 111; n < 1000; n++)
+		strollut_rbmap_add(0, 0, n);
+	strollut_rbmap_add(0, 1, 39999);
+	strollut_rbmap_add(0, 1, 30000);
+	strollut_rbmap_check(&strollut_rbmap_maps[0], &strollut_rbmap_refs[0]);
+
+	/* Shrink, split and delete runs. */
+	strollut_rbmap_remove(0, 0, 9);
+	strollut_rbmap_remove(0, 0, 1019);
+	strollut_rbmap_remove(0, 0, 555);
+	strollut_rbmap_remove(0, 1, 12345);
+	strollut_rbmap_remove(0, 1, 0);
+	strollut_rbmap_remove(0, 1, 65535);
+	strollut_rbmap_remove(0, 2, 5);
+	strollut_rbmap_remove(0, 2, 7);
+	strollut_rbmap_check(&strollut_rbmap_maps[0], &strollut_rbmap_refs[0]);
+	strollut_rbmap_check_serial(&strollut_rbmap_maps[0],
+	                            &strollut_rbmap_refs[0]);
+
+	/* Fragment runs so that optimization converts them back. */
+	for (n = 0; n < 30000; n += 2)
+		strollut_rbmap_remove(0, 1, n);
+	strollut_rbmap_check(&strollut_rbmap_maps[0], &strollut_rbmap_refs[0]);
+	cute_check_sint(stroll_rbmap_optimize(&strollut_rbmap_maps[0]),
+	                equal,
+	                0);
+	strollut_rbmap_check(&strollut_rbmap_maps[0], &strollut_rbmap_refs[0]);
+	strollut_rbmap_check_serial(&strollut_rbmap_maps[0],
+	                            &strollut_rbmap_refs[0]);
+}
+
+/*
+ * Fill both operands with a mix of array, bitmap and run containers, some of
+ * them sharing the same chunks.
+ */
+static void
+strollut_rbmap_fill_operands(void)
+{
+	unsigned int n;
+
+	for (n = 0; n < 3000; n++) {
+		strollut_rbmap_add(0, 0, strollut_rbmap_rand(20000));
+		strollut_rbmap_add(1, 0, strollut_rbmap_rand(20000));
+	}
+	for (n = 0; n < 20000; n++) {
+		strollut_rbmap_add(0, 1, strollut_rbmap_rand(30000));
+		strollut_rbmap_add(1, 2, strollut_rbmap_rand(30000));
+	}
+	strollut_rbmap_add_range(0, 2, 1000, 5000);
+	strollut_rbmap_add_range(1, 1, 100, 8000);
+	strollut_rbmap_add_range(0, 3, 0, 10);
+	strollut_rbmap_add_range(1, 3, 5, 10);
+	cute_check_sint(stroll_rbmap_optimize(&strollut_rbmap_maps[0]),
+	                equal,
+	                0);
+	for (n = 0; n < 200; n++)
+		strollut_rbmap_add(1, 3, strollut_rbmap_rand(1000));
+
+	strollut_rbmap_check(&strollut_rbmap_maps[0], &strollut_rbmap_refs[0]);
+	strollut_rbmap_check(&strollut_rbmap_maps[1], &strollut_rbmap_refs[1]);
+}
+
+typedef int (strollut_rbmap_op_fn)(struct stroll_rbmap *,
+                                   const struct stroll_rbmap *,
+                                   const struct stroll_rbmap *);
+
+static void
+strollut_rbmap_check_op(strollut_rbmap_op_fn * op,
+                        bool (*ref_op)(bool, bool))
+{
+	unsigned int k;
+	unsigned int l;
+
+	strollut_rbmap_fill_operands();
+
+	for (k = 0; k < STROLLUT_RBMAP_KEY_NR; k++)
+		for (l = 0; l < STROLLUT_RBMAP_CHUNK_NR; l++)
+			strollut_rbmap_refs[2][k][l] =
+				ref_op(strollut_rbmap_refs[0][k][l],
+				       strollut_rbmap_refs[1][k][l]);
+
+	cute_check_sint(op(&strollut_rbmap_maps[2],
+	                   &strollut_rbmap_maps[0],
+	                   &strollut_rbmap_maps[1]),
+	                equal,
+	                0);
+	strollut_rbmap_check(&strollut_rbmap_maps[2], &strollut_rbmap_refs[2]);
+	strollut_rbmap_check_serial(&strollut_rbmap_maps[2],
+	                            &strollut_rbmap_refs[2]);
+
+	/* Operands must be left untouched... */
+	strollut_rbmap_check(&strollut_rbmap_maps[0], &strollut_rbmap_refs[0]);
+	strollut_rbmap_check(&strollut_rbmap_maps[1], &strollut_rbmap_refs[1]);
+
+	/* ...unless result refers to one of them. */
+	cute_check_sint(op(&strollut_rbmap_maps[0],
+	                   &strollut_rbmap_maps[0],
+	                   &strollut_rbmap_maps[1]),
+	                equal,
+	                0);
+	strollut_rbmap_check(&strollut_rbmap_maps[0], &strollut_rbmap_refs[2]);
+}
+
+static bool strollut_rbmap_and_ref(bool a, bool b)    { return a && b; }
+static bool strollut_rbmap_or_ref(bool a, bool b)     { return a || b; }
+static bool strollut_rbmap_xor_ref(bool a, bool b)    { return a != b; }
+static bool strollut_rbmap_andnot_ref(bool a, bool b) { return a && !b; }
+
+CUTE_TEST(strollut_rbmap_and)
+{
+	strollut_rbmap_check_op(stroll_rbmap_and, strollut_rbmap_and_ref);
+}
+
+CUTE_TEST(strollut_rbmap_or)
+{
+	strollut_rbmap_check_op(stroll_rbmap_or, strollut_rbmap_or_ref);
+}
+
+CUTE_TEST(strollut_rbmap_xor)
+{
+	strollut_rbmap_check_op(stroll_rbmap_xor, strollut_rbmap_xor_ref);
+}
+
+CUTE_TEST(strollut_rbmap_andnot)
+{
+	strollut_rbmap_check_op(stroll_rbmap_andnot, strollut_rbmap_andnot_ref);
+}
+
+CUTE_TEST(strollut_rbmap_serial_format)
+{
+	/* Reference portable serialization of { 1, 2, 3, 0x10000 }. */
+	static const uint8_t     ref[] = {
+		0x3a, 0x30, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00,
+		0x18, 0x00, 0x00, 0x00, 0x1e, 0x00, 0x00, 0x00,
+		0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x00
+	};
+	/* Reference portable serialization of [10, 20[ as a run. */
+	static const uint8_t     run[] = {
+		0x3b, 0x30, 0x00, 0x00, 0x01, 0x00, 0x00, 0x09,
+		0x00, 0x01, 0x00, 0x0a, 0x00, 0x09, 0x00
+	};
+	uint8_t                  buff[sizeof(ref)];
+	struct stroll_rbmap      load;
+	struct stroll_rbmap_iter iter;
+	int64_t                  value;
+	uint8_t                  bad[sizeof(ref)];
+
+	strollut_rbmap_add(0, 0, 1);
+	strollut_rbmap_add(0, 0, 2);
+	strollut_rbmap_add(0, 0, 3);
+	strollut_rbmap_add(0, 1, 0);
+
+	cute_check_uint(stroll_rbmap_serialized_size(&strollut_rbmap_maps[0]),
+	                equal,
+	                sizeof(ref));
+	cute_check_sint(stroll_rbmap_serialize(&strollut_rbmap_maps[0],
+	                                       buff,
+	                                       sizeof(buff)),
+	                equal,
+	                (ssize_t)sizeof(ref));
+	cute_check_mem(buff, equal, ref, sizeof(ref));
+
+	cute_check_sint(stroll_rbmap_init_deserialize(&load, run, sizeof(run)),
+	                equal,
+	                0);
+	cute_check_uint(stroll_rbmap_cardinality(&load), equal, 10);
+	value = 10;
+	stroll_rbmap_foreach(&iter, &load, value) {
+		cute_check_bool(value >= 10, is, true);
+		cute_check_bool(value < 20, is, true);
+	}
+	stroll_rbmap_fini(&load);
+
+	/* Malformed forms. */
+	memcpy(bad, ref, sizeof(ref));
+	bad[0] = 0;
+	cute_check_sint(stroll_rbmap_init_deserialize(&load, bad, sizeof(bad)),
+	                equal,
+	                -EINVAL);
+	memcpy(bad, ref, sizeof(ref));
+	bad[12] = 0;
+	cute_check_sint(stroll_rbmap_init_deserialize(&load, bad, sizeof(bad)),
+	                equal,
+	                -EINVAL);
+	memcpy(bad, ref, sizeof(ref));
+	bad[26] = 1;
+	cute_check_sint(stroll_rbmap_init_deserialize(&load, bad, sizeof(bad)),
+	                equal,
+	                -EINVAL);
+	memcpy(bad, run, sizeof(run));
+	bad[13] = 0x0a;
+	cute_check_sint(stroll_rbmap_init_deserialize(&load, bad, sizeof(run)),
+	                equal,
+	                -EINVAL);
+}
+
+CUTE_GROUP(strollut_rbmap_group) = {
+	CUTE_REF(strollut_rbmap_assert),
+	CUTE_REF(strollut_rbmap_empty),
+	CUTE_REF(strollut_rbmap_sparse),
+	CUTE_REF(strollut_rbmap_dense),
+	CUTE_REF(strollut_rbmap_runs),
+	CUTE_REF(strollut_rbmap_and),
+	CUTE_REF(strollut_rbmap_or),
+	CUTE_REF(strollut_rbmap_xor),
+	CUTE_REF(strollut_rbmap_andnot),
+	CUTE_REF(strollut_rbmap_serial_format)
+};
+
+CUTE_SUITE_EXTERN(strollut_rbmap_suite,
+                  strollut_rbmap_group,
+                  strollut_rbmap_setup,
+                  strollut_rbmap_teardown,
+                  CUTE_DFLT_TMOUT);
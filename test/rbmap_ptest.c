@@ -0,0 +1,298 @@
+/******************************************************************************
+ * SPDX-License-Identifier: LGPL-3.0-only
+ *
+ * This file is part of Stroll.
+ * Copyright (C) 2026 Grégor Boirie <gregor.boirie@free.fr>
+ ******************************************************************************/
+
+#include "ptest.h"
+#include "stroll/rbmap.h"
+#include <stdint.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <math.h>
+
+/*
+ * Measure logical operations between 2 compressed bitmaps holding a given
+ * number of random integers spread over a given range, optionally clustered
+ * into runs of consecutive integers.
+ */
+typedef int (strollpt_rbmap_op_fn)(struct stroll_rbmap *,
+                                   const struct stroll_rbmap *,
+                                   const struct stroll_rbmap *);
+
+struct strollpt_rbmap_op {
+	const char *           name;
+	strollpt_rbmap_op_fn * run;
+};
+
+static const struct strollpt_rbmap_op strollpt_rbmap_ops[] = {
+	{ .name = "and",    .run = stroll_rbmap_and },
+	{ .name = "or",     .run = stroll_rbmap_or },
+	{ .name = "xor",    .run = stroll_rbmap_xor },
+	{ .name = "andnot", .run = stroll_rbmap_andnot }
+};
+
+static uint64_t strollpt_rbmap_seed = UINT64_C(0x2545f4914f6cdd1d);
+
+static uint32_t
+strollpt_rbmap_rand(uint64_t max)
+{
+	strollpt_rbmap_seed ^= strollpt_rbmap_seed << 13;
+	strollpt_rbmap_seed ^= strollpt_rbmap_seed >> 7;
+	strollpt_rbmap_seed ^= strollpt_rbmap_seed << 17;
+
+	return (uint32_t)(strollpt_rbmap_seed % max);
+}
+
+static int
+strollpt_rbmap_fill(struct stroll_rbmap * __restrict rbmap,
+                    unsigned int                     nr,
+                    uint64_t                         range,
+                    unsigned int                     run)
+{
+	unsigned int n = 0;
+
+	while (n < nr) {
+		uint32_t     start = strollpt_rbmap_rand(range);
+		unsigned int r;
+
+		for (r = 0; (r < run) && (n < nr); r++, n++)
+			if (stroll_rbmap_add(rbmap, start + r))
+				return EXIT_FAILURE;
+	}
+
+	if (stroll_rbmap_optimize(rbmap))
+		return EXIT_FAILURE;
+
+	return EXIT_SUCCESS;
+}
+
+static int
+strollpt_rbmap_parse_uint(const char * __restrict   arg,
+                          const char * __restrict   name,
+                          unsigned long long        max,
+                          unsigned long long * __restrict value)
+{
+	char *             str;
+	unsigned long long val;
+
+	val = strtoull(arg, &str, 0);
+	if (*str || !val || (val > max)) {
+		strollpt_err("invalid %s '%s' specified: "
+		             "integer within [1, %llu] range expected.\n",
+		             name,
+		             arg,
+		             max);
+		return EXIT_FAILURE;
+	}
+
+	*value = val;
+
+	return EXIT_SUCCESS;
+}
+
+static int
+strollpt_rbmap_parse_op(const char * __restrict                      arg,
+                        const struct strollpt_rbmap_op ** __restrict op)
+{
+	unsigned int o;
+
+	for (o = 0; o < stroll_array_nr(strollpt_rbmap_ops); o++) {
+		if (!strcmp(arg, strollpt_rbmap_ops[o].name)) {
+			*op = &strollpt_rbmap_ops[o];
+			return EXIT_SUCCESS;
+		}
+	}
+
+	strollpt_err("invalid '%s' operation specified.\n", arg);
+
+	return EXIT_FAILURE;
+}
+
+static void
+strollpt_rbmap_usage(FILE * __restrict stdio)
+{
+	fprintf(stdio,
+	        "Usage: %s [OPTIONS] OPERATION COUNT RANGE LOOPS\n"
+	        "where OPTIONS:\n"
+	        "    -r|--run LENGTH\n"
+	        "    -p|--prio PRIORITY\n"
+	        "    -h|--help\n"
+	        "where OPERATION:\n"
+	        "    and|or|xor|andnot\n",
+	        program_invocation_short_name);
+}
+
+int main(int argc, char *argv[])
+{
+	const struct strollpt_rbmap_op * op;
+	unsigned long long               nr;
+	unsigned long long               range;
+	unsigned long long               run = 1;
+	unsigned int                     loops;
+	int                              prio = 0;
+	struct stroll_rbmap              maps[3];
+	unsigned long long *             nsecs;
+	struct strollpt_stats            stats;
+	unsigned int                     i;
+	int                              ret = EXIT_FAILURE;
+
+	while (true) {
+		int                        opt;
+		static const struct option lopts[] = {
+			{"help", 0, NULL, 'h'},
+			{"run",  1, NULL, 'r'},
+			{"prio", 1, NULL, 'p'},
+			{0,      0, 0,    0}
+		};
+
+		opt = getopt_long(argc, argv, "hr:p:", lopts, NULL);
+		if (opt < 0)
+			/* No more options: go parsing positional arguments. */
+			break;
+
+		switch (opt) {
+		case 'r': /* run length */
+			if (strollpt_rbmap_parse_uint(optarg,
+			                              "run length",
+			                              UINT16_MAX,
+			                              &run)) {
+				strollpt_rbmap_usage(stderr);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 'p': /* priority */
+			if (strollpt_parse_sched_prio(optarg, &prio)) {
+				strollpt_rbmap_usage(stderr);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
+		case 'h': /* Help message. */
+			strollpt_rbmap_usage(stdout);
+			exit(EXIT_SUCCESS);
+
+		case '?': /* Unknown option. */
+		default:
+			strollpt_rbmap_usage(stderr);
+			return EXIT_FAILURE;
+		}
+	}
+
+	/*
+	 * Check positional arguments are properly specified on command
+	 * line.
+	 */
+	argc -= optind;
+	if (argc != 4) {
+		strollpt_err("invalid number of arguments.\n");
+		strollpt_rbmap_usage(stderr);
+		return EXIT_FAILURE;
+	}
+
+	if (strollpt_rbmap_parse_op(argv[optind], &op))
+		return EXIT_FAILURE;
+
+	if (strollpt_rbmap_parse_uint(argv[optind + 1],
+	                              "integer count",
+	                              UINT32_MAX,
+	                              &nr))
+		return EXIT_FAILURE;
+
+	if (strollpt_rbmap_parse_uint(argv[optind + 2],
+	                              "integer range",
+	                              (unsigned long long)UINT32_MAX + 1 - run,
+	                              &range))
+		return EXIT_FAILURE;
+
+	if (strollpt_parse_loop_nr(argv[optind + 3], &loops))
+		return EXIT_FAILURE;
+
+	nsecs = malloc(loops * sizeof(nsecs[0]));
+	if (!nsecs)
+		return EXIT_FAILURE;
+
+	for (i = 0; i < stroll_array_nr(maps); i++)
+		stroll_rbmap_init(&maps[i]);
+
+	if (strollpt_rbmap_fill(&maps[0],
+	                        (unsigned int)nr,
+	                        range,
+	                        (unsigned int)run) ||
+	    strollpt_rbmap_fill(&maps[1],
+	                        (unsigned int)nr,
+	                        range,
+	                        (unsigned int)run)) {
+		strollpt_err("cannot fill compressed bitmaps.\n");
+		goto fini;
+	}
+
+	if (strollpt_setup_sched_prio(prio))
+		goto fini;
+
+	for (i = 0; i < loops; i++) {
+		struct timespec start, elapse;
+		int             err;
+
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+		err = op->run(&maps[2], &maps[0], &maps[1]);
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &elapse);
+		if (err) {
+			strollpt_err("cannot run operation: %s (%d).\n",
+			             strerror(-err),
+			             -err);
+			goto fini;
+		}
+
+		elapse = strollpt_tspec_sub(&elapse, &start);
+		nsecs[i] = strollpt_tspec2ns(&elapse);
+	}
+
+	if (strollpt_calc_stats(&stats, nsecs, 1, loops))
+		goto fini;
+
+	printf("#Integers:      %llu\n"
+	       "#Range:         %llu\n"
+	       "#Run:           %llu\n"
+	       "#Loops:         %u\n"
+	       "Cardinality:    %llu\n"
+	       "Serial size:    %zu bytes\n"
+	       "Flat size:      %llu bytes\n"
+	       "%s:\n"
+	       "    #Inliers:   %u (%.2lf%%)\n"
+	       "    Mininum:    %llu nSec\n"
+	       "    Maximum:    %llu nSec\n"
+	       "    Deviation:  %llu nSec\n"
+	       "    Median:     %llu nSec\n"
+	       "    Mean:       %llu nSec\n",
+	       nr,
+	       range,
+	       run,
+	       loops,
+	       (unsigned long long)stroll_rbmap_cardinality(&maps[0]),
+	       stroll_rbmap_serialized_size(&maps[0]),
+	       (range + run + 7) / 8,
+	       op->name,
+	       stats.count, ((double)stats.count * 100.0) / (double)loops,
+	       stats.min,
+	       stats.max,
+	       (unsigned long long)round(stats.stdev),
+	       stats.med,
+	       (unsigned long long)round(stats.mean));
+
+	ret = EXIT_SUCCESS;
+
+fini:
+	for (i = 0; i < stroll_array_nr(maps); i++)
+		stroll_rbmap_fini(&maps[i]);
+	free(nsecs);
+
+	return ret;
+}
@@ -53,6 +53,62 @@ sort_ptest_run()
 	return 0
 }
 
+ptest_parse_mt_awk='
+/^Algorithm/      { algo=$2 }
+/^#Samples/       { nr=$2 }
+/^Distinct ratio/ { single=$2 }
+/^Order ratio/    { order=$2 }
+/^Data size/      { size=$2 }
+/^#Threads/       { thr=$2 }
+/^Mean/           { mean=$2 }
+END               {
+	if (!base)
+		base=mean
+	printf("%-16s %10u         %3u      %3u    %4u     %3u %10u   %6.2f\n", algo, nr, single, order, size, thr, mean, base / mean)
+}
+'
+
+# Run a multi-threaded algorithm performance test using the given number of
+# threads. Speedup is computed against the given single threaded mean time,
+# if any.
+sort_ptest_run_mt()
+{
+	local algo="$1"
+	local path="$2"
+	local size=$3
+	local prio=""
+	local loops=$5
+	local thr=$6
+	local base=$7
+	local out
+
+	if [ $4 -gt 0 ]; then
+		prio="--prio $4"
+	fi
+
+	if ! out=$($SORT_PTEST_BIN $prio \
+	                           --threads $thr \
+	                           "$path" \
+	                           "$algo" \
+	                           $size \
+	                           $loops); then
+		return 1
+	fi
+	if ! echo -n "$out" | awk -F': *' \
+	                          -v base=$base \
+	                          "$ptest_parse_mt_awk"; then
+		return 1
+	fi
+
+	return 0
+}
+
+# Extract mean time out of a multi-threaded performance test result.
+sort_ptest_mean()
+{
+	echo "$1" | awk '{ print $7 }'
+}
+
 sort_algos='
 array_bubble     4096
 array_select     4096
@@ -66,7 +122,16 @@ dlist_insert     4096
 array_qsort   1048576
 array_quick   1048576
 array_3wquick 1048576
+array_sample_mt 1048576
+array_pdquick 1048576
 array_merge   1048576
+array_merge_mt 1048576
+array_inpmerge 1048576
+array_indirect 1048576
+array_power   1048576
+array_radix   1048576
+array_msdradix 1048576
+array_vquick  1048576 4
 array_fbheap  1048576
 array_fwheap  1048576
 slist_merge   1048576
@@ -114,6 +179,47 @@ sort_algo_max_nr()
 	_EOF
 }
 
+# Return the maximum data size an algorithm supports, if any.
+sort_algo_max_size()
+{
+	local name="$1"
+	local algo
+	local max_nr
+	local max_sz
+	local dummy
+
+	while read algo max_nr max_sz dummy; do
+		if [ "$algo" = "$name" ]; then
+			echo $max_sz
+		fi
+	done <<-_EOF
+	$sort_algos
+	_EOF
+}
+
+# Multi-threaded algorithms are named after a "_mt" suffix.
+sort_algo_threaded()
+{
+	case "$1" in
+	*_mt) return 0;;
+	*)    return 1;;
+	esac
+}
+
+# List number of threads multi-threaded algorithms are run with, i.e. powers of
+# 2 up to the number of online CPUs, the number of online CPUs included.
+sort_list_threads()
+{
+	local cpus=$(nproc)
+	local thr=1
+
+	while [ $thr -lt $cpus ]; do
+		echo -n "$thr "
+		thr=$((thr * 2))
+	done
+	echo $cpus
+}
+
 algos=$(sort_list_algos)
 
 if [ $show -eq 1 ]; then
@@ -122,6 +228,7 @@ if [ $show -eq 1 ]; then
 	echo "Order ratios:    $orders"
 	echo "Data sizes:      $sizes"
 	echo "Algorithms:      $algos"
+	echo "#Threads:        $(sort_list_threads)"
 	exit 0
 fi
 
@@ -151,10 +258,18 @@ echo "#Loops:          $loops" >>$output
 echo >>$output
 echo "Algorithm          #Samples Distinct(%) Order(%) Size(B)   Mean(ns)" >>$output
 
+mt_algos=""
 for a in $algos; do
+	if sort_algo_threaded "$a"; then
+		# Multi-threaded algorithms are reported separately.
+		mt_algos="$mt_algos $a"
+		continue
+	fi
+
 	# Restrict number of test data samples to 8192 since these may take
 	# quite a long time to complete (up to several tenth of minutes...).
 	maxnr=$(sort_algo_max_nr "$a")
+	maxsz=$(sort_algo_max_size "$a")
 	for n in $nr; do
 		if [ $n -gt $maxnr ]; then
 			continue
@@ -170,6 +285,10 @@ for a in $algos; do
 					continue
 				fi
 				for s in $sizes; do
+					if [ -n "$maxsz" ] && \
+					   [ $s -gt $maxsz ]; then
+						continue
+					fi
 					if ! sort_ptest_run "$a" \
 					                    "$path" \
 					                    "$s" \
@@ -184,3 +303,52 @@ for a in $algos; do
 		done
 	done
 done
+
+if [ -z "$mt_algos" ]; then
+	exit 0
+fi
+
+threads=$(sort_list_threads)
+
+echo >>$output
+echo "Algorithm          #Samples Distinct(%) Order(%) Size(B) Threads   Mean(ns)  Speedup" >>$output
+
+for a in $mt_algos; do
+	maxnr=$(sort_algo_max_nr "$a")
+	for n in $nr; do
+		if [ $n -gt $maxnr ]; then
+			continue
+		fi
+		for o in $orders; do
+			for i in $singles; do
+				path=$(ptest_data_path \
+				       "$ptest_data_base" \
+				       "$n" \
+				       "$i" \
+				       "$o")
+				if [ ! -r "$path" ]; then
+					continue
+				fi
+				for s in $sizes; do
+					base=0
+					for t in $threads; do
+						if ! res=$(sort_ptest_run_mt \
+						           "$a" \
+						           "$path" \
+						           "$s" \
+						           "$prio" \
+						           "$loops" \
+						           "$t" \
+						           "$base");
+						then
+							exit 1
+						fi
+						echo "$res" >>$output
+						[ $base -ne 0 ] || \
+						base=$(sort_ptest_mean "$res")
+					done
+				done
+			done
+		done
+	done
+done
@@ -22,8 +22,12 @@ struct strollpt_sort_algo {
 	const char *                name;
 	strollpt_sort_validate_fn * validate;
 	strollpt_sort_measure_fn *  measure;
+	bool                        threaded;
 };
 
+/* Number of threads multi-threaded algorithms run with, 0 meaning all CPUs. */
+static unsigned int strollpt_sort_threads;
+
 #if defined(CONFIG_STROLL_ARRAY)
 
 #include "stroll/array.h"
@@ -145,6 +149,41 @@ strollpt_sort_measure_array(const unsigned int * __restrict elements,
 	return EXIT_SUCCESS;
 }
 
+#if defined(CONFIG_STROLL_ARRAY_MT_UTILS)
+
+/*
+ * Unlike strollpt_sort_measure_array(), measure elapsed wall-clock time since
+ * the calling thread's CPU time does not account for the work performed by
+ * other threads.
+ */
+static int
+strollpt_sort_measure_array_mt(const unsigned int * __restrict elements,
+                               unsigned int                    nr,
+                               size_t                          size,
+                               unsigned long long * __restrict nsecs,
+                               strollpt_sort_array_fn *        sort)
+{
+	struct timespec              start, elapse;
+	struct strollpt_array_elem * tmp;
+
+	tmp = strollpt_array_create(elements, nr, size);
+	if (!tmp)
+		return EXIT_FAILURE;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	sort(tmp, nr, size, strollpt_array_compare_min);
+	clock_gettime(CLOCK_MONOTONIC, &elapse);
+
+	elapse = strollpt_tspec_sub(&elapse, &start);
+	*nsecs = strollpt_tspec2ns(&elapse);
+
+	free(tmp);
+
+	return EXIT_SUCCESS;
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_MT_UTILS) */
+
 /* Glibc's quick sorting */
 static inline void
 strollpt_sort_array_qsort(void * __restrict     array,
@@ -366,6 +405,86 @@ strollpt_sort_measure_array_3wquick(const unsigned int * __restrict elements,
 
 #endif /* defined(CONFIG_STROLL_ARRAY_3WQUICK_SORT) */
 
+#if defined(CONFIG_STROLL_ARRAY_SAMPLE_SORT_MT)
+
+static inline void
+strollpt_sort_array_sample_mt(void * __restrict     array,
+                              unsigned int          nr,
+                              size_t                size,
+                              stroll_array_cmp_fn * compare)
+{
+	if (stroll_array_sample_sort_mt(array,
+	                                nr,
+	                                size,
+	                                compare,
+	                                NULL,
+	                                strollpt_sort_threads))
+		exit(1);
+}
+
+static int
+strollpt_sort_validate_array_sample_mt(const unsigned int * __restrict elements,
+                                       unsigned int                    nr,
+                                       size_t                          size)
+{
+	return strollpt_sort_validate_array(elements,
+	                                    nr,
+	                                    size,
+	                                    strollpt_sort_array_sample_mt);
+}
+
+static int
+strollpt_sort_measure_array_sample_mt(const unsigned int * __restrict elements,
+                                      unsigned int                    nr,
+                                      size_t                          size,
+                                      unsigned long long * __restrict nsecs)
+{
+	return strollpt_sort_measure_array_mt(elements,
+	                                      nr,
+	                                      size,
+	                                      nsecs,
+	                                      strollpt_sort_array_sample_mt);
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_SAMPLE_SORT_MT) */
+
+#if defined(CONFIG_STROLL_ARRAY_PDQUICK_SORT)
+
+static inline void
+strollpt_sort_array_pdquick(void * __restrict     array,
+                            unsigned int          nr,
+                            size_t                size,
+                            stroll_array_cmp_fn * compare)
+{
+	stroll_array_pdquick_sort(array, nr, size, compare, NULL);
+}
+
+static int
+strollpt_sort_validate_array_pdquick(const unsigned int * __restrict elements,
+                                     unsigned int                    nr,
+                                     size_t                          size)
+{
+	return strollpt_sort_validate_array(elements,
+	                                    nr,
+	                                    size,
+	                                    strollpt_sort_array_pdquick);
+}
+
+static int
+strollpt_sort_measure_array_pdquick(const unsigned int * __restrict elements,
+                                    unsigned int                    nr,
+                                    size_t                          size,
+                                    unsigned long long * __restrict nsecs)
+{
+	return strollpt_sort_measure_array(elements,
+	                                   nr,
+	                                   size,
+	                                   nsecs,
+	                                   strollpt_sort_array_pdquick);
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_PDQUICK_SORT) */
+
 #if defined(CONFIG_STROLL_ARRAY_MERGE_SORT)
 
 static inline void
@@ -404,6 +523,300 @@ strollpt_sort_measure_array_merge(const unsigned int * __restrict elements,
 
 #endif /* defined(CONFIG_STROLL_ARRAY_MERGE_SORT) */
 
+#if defined(CONFIG_STROLL_ARRAY_MERGE_SORT_MT)
+
+static inline void
+strollpt_sort_array_merge_mt(void * __restrict     array,
+                             unsigned int          nr,
+                             size_t                size,
+                             stroll_array_cmp_fn * compare)
+{
+	if (stroll_array_merge_sort_mt(array,
+	                               nr,
+	                               size,
+	                               compare,
+	                               NULL,
+	                               strollpt_sort_threads))
+		exit(1);
+}
+
+static int
+strollpt_sort_validate_array_merge_mt(const unsigned int * __restrict elements,
+                                      unsigned int                    nr,
+                                      size_t                          size)
+{
+	return strollpt_sort_validate_array(elements,
+	                                    nr,
+	                                    size,
+	                                    strollpt_sort_array_merge_mt);
+}
+
+static int
+strollpt_sort_measure_array_merge_mt(const unsigned int * __restrict elements,
+                                     unsigned int                    nr,
+                                     size_t                          size,
+                                     unsigned long long * __restrict nsecs)
+{
+	return strollpt_sort_measure_array_mt(elements,
+	                                      nr,
+	                                      size,
+	                                      nsecs,
+	                                      strollpt_sort_array_merge_mt);
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_MERGE_SORT_MT) */
+
+#if defined(CONFIG_STROLL_ARRAY_INPLACE_MERGE_SORT)
+
+static inline void
+strollpt_sort_array_inpmerge(void * __restrict     array,
+                             unsigned int          nr,
+                             size_t                size,
+                             stroll_array_cmp_fn * compare)
+{
+	stroll_array_inplace_merge_sort(array, nr, size, compare, NULL);
+}
+
+static int
+strollpt_sort_validate_array_inpmerge(const unsigned int * __restrict elements,
+                                      unsigned int                    nr,
+                                      size_t                          size)
+{
+	return strollpt_sort_validate_array(elements,
+	                                    nr,
+	                                    size,
+	                                    strollpt_sort_array_inpmerge);
+}
+
+static int
+strollpt_sort_measure_array_inpmerge(const unsigned int * __restrict elements,
+                                     unsigned int                    nr,
+                                     size_t                          size,
+                                     unsigned long long * __restrict nsecs)
+{
+	return strollpt_sort_measure_array(elements,
+	                                   nr,
+	                                   size,
+	                                   nsecs,
+	                                   strollpt_sort_array_inpmerge);
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_INPLACE_MERGE_SORT) */
+
+#if defined(CONFIG_STROLL_ARRAY_INDIRECT_SORT)
+
+static inline void
+strollpt_sort_array_indirect(void * __restrict     array,
+                             unsigned int          nr,
+                             size_t                size,
+                             stroll_array_cmp_fn * compare)
+{
+	if (stroll_array_indirect_sort(array, nr, size, compare, NULL))
+		exit(1);
+}
+
+static int
+strollpt_sort_validate_array_indirect(const unsigned int * __restrict elements,
+                                      unsigned int                    nr,
+                                      size_t                          size)
+{
+	return strollpt_sort_validate_array(elements,
+	                                    nr,
+	                                    size,
+	                                    strollpt_sort_array_indirect);
+}
+
+static int
+strollpt_sort_measure_array_indirect(const unsigned int * __restrict elements,
+                                     unsigned int                    nr,
+                                     size_t                          size,
+                                     unsigned long long * __restrict nsecs)
+{
+	return strollpt_sort_measure_array(elements,
+	                                   nr,
+	                                   size,
+	                                   nsecs,
+	                                   strollpt_sort_array_indirect);
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_INDIRECT_SORT) */
+
+#if defined(CONFIG_STROLL_ARRAY_POWER_SORT)
+
+static inline void
+strollpt_sort_array_power(void * __restrict     array,
+                          unsigned int          nr,
+                          size_t                size,
+                          stroll_array_cmp_fn * compare)
+{
+	if (stroll_array_power_sort(array, nr, size, compare, NULL))
+		exit(1);
+}
+
+static int
+strollpt_sort_validate_array_power(const unsigned int * __restrict elements,
+                                   unsigned int                    nr,
+                                   size_t                          size)
+{
+	return strollpt_sort_validate_array(elements,
+	                                    nr,
+	                                    size,
+	                                    strollpt_sort_array_power);
+}
+
+static int
+strollpt_sort_measure_array_power(const unsigned int * __restrict elements,
+                                  unsigned int                    nr,
+                                  size_t                          size,
+                                  unsigned long long * __restrict nsecs)
+{
+	return strollpt_sort_measure_array(elements,
+	                                   nr,
+	                                   size,
+	                                   nsecs,
+	                                   strollpt_sort_array_power);
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_POWER_SORT) */
+
+#if defined(CONFIG_STROLL_ARRAY_RADIX_SORT)
+
+static inline void
+strollpt_sort_array_radix(void * __restrict     array,
+                          unsigned int          nr,
+                          size_t                size,
+                          stroll_array_cmp_fn * compare __unused)
+{
+	if (stroll_array_radix_sort(array,
+	                            nr,
+	                            size,
+	                            offsetof(struct strollpt_array_elem, id),
+	                            sizeof_member(struct strollpt_array_elem,
+	                                          id)))
+		exit(1);
+}
+
+static int
+strollpt_sort_validate_array_radix(const unsigned int * __restrict elements,
+                                   unsigned int                    nr,
+                                   size_t                          size)
+{
+	return strollpt_sort_validate_array(elements,
+	                                    nr,
+	                                    size,
+	                                    strollpt_sort_array_radix);
+}
+
+static int
+strollpt_sort_measure_array_radix(const unsigned int * __restrict elements,
+                                  unsigned int                    nr,
+                                  size_t                          size,
+                                  unsigned long long * __restrict nsecs)
+{
+	return strollpt_sort_measure_array(elements,
+	                                   nr,
+	                                   size,
+	                                   nsecs,
+	                                   strollpt_sort_array_radix);
+}
+
+static inline void
+strollpt_sort_array_msdradix(void * __restrict     array,
+                             unsigned int          nr,
+                             size_t                size,
+                             stroll_array_cmp_fn * compare __unused)
+{
+	stroll_array_msd_radix_sort(array,
+	                            nr,
+	                            size,
+	                            offsetof(struct strollpt_array_elem, id),
+	                            sizeof_member(struct strollpt_array_elem,
+	                                          id));
+}
+
+static int
+strollpt_sort_validate_array_msdradix(const unsigned int * __restrict elements,
+                                      unsigned int                    nr,
+                                      size_t                          size)
+{
+	return strollpt_sort_validate_array(elements,
+	                                    nr,
+	                                    size,
+	                                    strollpt_sort_array_msdradix);
+}
+
+static int
+strollpt_sort_measure_array_msdradix(const unsigned int * __restrict elements,
+                                     unsigned int                    nr,
+                                     size_t                          size,
+                                     unsigned long long * __restrict nsecs)
+{
+	return strollpt_sort_measure_array(elements,
+	                                   nr,
+	                                   size,
+	                                   nsecs,
+	                                   strollpt_sort_array_msdradix);
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_RADIX_SORT) */
+
+#if defined(CONFIG_STROLL_ARRAY_VQUICK_SORT)
+
+static inline void
+strollpt_sort_array_vquick(void * __restrict     array,
+                           unsigned int          nr,
+                           size_t                size __unused,
+                           stroll_array_cmp_fn * compare __unused)
+{
+	stroll_array_sort_u32(array, nr);
+}
+
+static int
+strollpt_sort_check_array_vquick(size_t size)
+{
+	if (size != sizeof_member(struct strollpt_array_elem, id)) {
+		strollpt_err("invalid data element size %zu specified: "
+		             "%zu expected.\n",
+		             size,
+		             sizeof_member(struct strollpt_array_elem, id));
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static int
+strollpt_sort_validate_array_vquick(const unsigned int * __restrict elements,
+                                    unsigned int                    nr,
+                                    size_t                          size)
+{
+	if (strollpt_sort_check_array_vquick(size))
+		return EXIT_FAILURE;
+
+	return strollpt_sort_validate_array(elements,
+	                                    nr,
+	                                    size,
+	                                    strollpt_sort_array_vquick);
+}
+
+static int
+strollpt_sort_measure_array_vquick(const unsigned int * __restrict elements,
+                                   unsigned int                    nr,
+                                   size_t                          size,
+                                   unsigned long long * __restrict nsecs)
+{
+	if (strollpt_sort_check_array_vquick(size))
+		return EXIT_FAILURE;
+
+	return strollpt_sort_measure_array(elements,
+	                                   nr,
+	                                   size,
+	                                   nsecs,
+	                                   strollpt_sort_array_vquick);
+}
+
+#endif /* defined(CONFIG_STROLL_ARRAY_VQUICK_SORT) */
+
 #if defined(CONFIG_STROLL_ARRAY_FBHEAP_SORT)
 
 static inline void
@@ -1136,6 +1549,21 @@ static const struct strollpt_sort_algo strollpt_sort_algos[] = {
 		.measure  = strollpt_sort_measure_array_3wquick
 	},
 #endif /* defined(CONFIG_STROLL_ARRAY_3WQUICK_SORT) */
+#if defined(CONFIG_STROLL_ARRAY_SAMPLE_SORT_MT)
+	{
+		.name     = "array_sample_mt",
+		.validate = strollpt_sort_validate_array_sample_mt,
+		.measure  = strollpt_sort_measure_array_sample_mt,
+		.threaded = true
+	},
+#endif /* defined(CONFIG_STROLL_ARRAY_SAMPLE_SORT_MT) */
+#if defined(CONFIG_STROLL_ARRAY_PDQUICK_SORT)
+	{
+		.name     = "array_pdquick",
+		.validate = strollpt_sort_validate_array_pdquick,
+		.measure  = strollpt_sort_measure_array_pdquick
+	},
+#endif /* defined(CONFIG_STROLL_ARRAY_PDQUICK_SORT) */
 #if defined(CONFIG_STROLL_ARRAY_MERGE_SORT)
 	{
 		.name     = "array_merge",
@@ -1143,6 +1571,54 @@ static const struct strollpt_sort_algo strollpt_sort_algos[] = {
 		.measure  = strollpt_sort_measure_array_merge
 	},
 #endif /* defined(CONFIG_STROLL_ARRAY_MERGE_SORT) */
+#if defined(CONFIG_STROLL_ARRAY_MERGE_SORT_MT)
+	{
+		.name     = "array_merge_mt",
+		.validate = strollpt_sort_validate_array_merge_mt,
+		.measure  = strollpt_sort_measure_array_merge_mt,
+		.threaded = true
+	},
+#endif /* defined(CONFIG_STROLL_ARRAY_MERGE_SORT_MT) */
+#if defined(CONFIG_STROLL_ARRAY_INPLACE_MERGE_SORT)
+	{
+		.name     = "array_inpmerge",
+		.validate = strollpt_sort_validate_array_inpmerge,
+		.measure  = strollpt_sort_measure_array_inpmerge
+	},
+#endif /* defined(CONFIG_STROLL_ARRAY_INPLACE_MERGE_SORT) */
+#if defined(CONFIG_STROLL_ARRAY_INDIRECT_SORT)
+	{
+		.name     = "array_indirect",
+		.validate = strollpt_sort_validate_array_indirect,
+		.measure  = strollpt_sort_measure_array_indirect
+	},
+#endif /* defined(CONFIG_STROLL_ARRAY_INDIRECT_SORT) */
+#if defined(CONFIG_STROLL_ARRAY_POWER_SORT)
+	{
+		.name     = "array_power",
+		.validate = strollpt_sort_validate_array_power,
+		.measure  = strollpt_sort_measure_array_power
+	},
+#endif /* defined(CONFIG_STROLL_ARRAY_POWER_SORT) */
+#if defined(CONFIG_STROLL_ARRAY_RADIX_SORT)
+	{
+		.name     = "array_radix",
+		.validate = strollpt_sort_validate_array_radix,
+		.measure  = strollpt_sort_measure_array_radix
+	},
+	{
+		.name     = "array_msdradix",
+		.validate = strollpt_sort_validate_array_msdradix,
+		.measure  = strollpt_sort_measure_array_msdradix
+	},
+#endif /* defined(CONFIG_STROLL_ARRAY_RADIX_SORT) */
+#if defined(CONFIG_STROLL_ARRAY_VQUICK_SORT)
+	{
+		.name     = "array_vquick",
+		.validate = strollpt_sort_validate_array_vquick,
+		.measure  = strollpt_sort_measure_array_vquick
+	},
+#endif /* defined(CONFIG_STROLL_ARRAY_VQUICK_SORT) */
 #if defined(CONFIG_STROLL_ARRAY_FBHEAP_SORT)
 	{
 		.name     = "array_fbheap",
@@ -1233,13 +1709,33 @@ strollpt_sort_parse_algo(const char * __restrict                       name,
 	return EXIT_FAILURE;
 }
 
+static int
+strollpt_sort_parse_thread_nr(const char * __restrict   arg,
+                              unsigned int * __restrict thread_nr)
+{
+	char *        str;
+	unsigned long nr;
+
+	nr = strtoul(arg, &str, 0);
+	if (*str || (nr > UINT_MAX)) {
+		strollpt_err("invalid number of threads '%s' specified.\n",
+		             arg);
+		return EXIT_FAILURE;
+	}
+
+	*thread_nr = (unsigned int)nr;
+
+	return EXIT_SUCCESS;
+}
+
 static void
 strollpt_sort_usage(FILE * __restrict stdio)
 {
 	fprintf(stdio,
 	        "Usage: %s [OPTIONS] FILE ALGORITHM SIZE LOOPS\n"
 	        "where OPTIONS:\n"
-	        "    -p|--prio  PRIORITY\n"
+	        "    -p|--prio    PRIORITY\n"
+	        "    -t|--threads NR\n"
 	        "    -h|--help\n",
 	        program_invocation_short_name);
 }
@@ -1262,10 +1758,11 @@ int main(int argc, char *argv[])
 		static const struct option lopts[] = {
 			{"help",    0, NULL, 'h'},
 			{"prio",    1, NULL, 'p'},
+			{"threads", 1, NULL, 't'},
 			{0,         0, 0,    0}
 		};
 
-		opt = getopt_long(argc, argv, "hp:", lopts, NULL);
+		opt = getopt_long(argc, argv, "hp:t:", lopts, NULL);
 		if (opt < 0)
 			/* No more options: go parsing positional arguments. */
 			break;
@@ -1279,6 +1776,16 @@ int main(int argc, char *argv[])
 
 			break;
 
+		case 't': /* number of threads */
+			if (strollpt_sort_parse_thread_nr(
+				optarg,
+				&strollpt_sort_threads)) {
+				strollpt_sort_usage(stderr);
+				return EXIT_FAILURE;
+			}
+
+			break;
+
 		case 'h': /* Help message. */
 			strollpt_sort_usage(stdout);
 			exit(EXIT_SUCCESS);
@@ -1332,6 +1839,8 @@ int main(int argc, char *argv[])
 	if (strollpt_calc_stats(&stats, nsecs, 1, loops))
 		goto free_nsecs;
 
+	if (algo->threaded)
+		printf("#Threads:       %u\n", strollpt_sort_threads);
 	printf("#Samples:       %u\n"
 	       "Order ratio:    %hu\n"
 	       "Distinct ratio: %hu\n"
@@ -146,6 +146,15 @@ extern CUTE_SUITE_DECL(strollut_bmap_suite);
 #if defined(CONFIG_STROLL_FBMAP)
 extern CUTE_SUITE_DECL(strollut_fbmap_suite);
 #endif
+#if defined(CONFIG_STROLL_HBMAP)
+extern CUTE_SUITE_DECL(strollut_hbmap_suite);
+#endif
+#if defined(CONFIG_STROLL_IDALLOC)
+extern CUTE_SUITE_DECL(strollut_idalloc_suite);
+#endif
+#if defined(CONFIG_STROLL_RBMAP)
+extern CUTE_SUITE_DECL(strollut_rbmap_suite);
+#endif
 #if defined(CONFIG_STROLL_LVSTR)
 extern CUTE_SUITE_DECL(strollut_lvstr_suite);
 #endif
@@ -172,6 +181,18 @@ extern CUTE_SUITE_DECL(strollut_theap_suite);
 #if defined(CONFIG_STROLL_MSG)
 extern CUTE_SUITE_DECL(strollut_message_suite);
 #endif
+#if defined(CONFIG_STROLL_BLOOM)
+extern CUTE_SUITE_DECL(strollut_bloom_suite);
+#endif
+#if defined(CONFIG_STROLL_CUCKOO)
+extern CUTE_SUITE_DECL(strollut_cuckoo_suite);
+#endif
+#if defined(CONFIG_STROLL_HLL)
+extern CUTE_SUITE_DECL(strollut_hll_suite);
+#endif
+#if defined(CONFIG_STROLL_CMSKETCH)
+extern CUTE_SUITE_DECL(strollut_cmsketch_suite);
+#endif
 
 CUTE_GROUP(strollut_group) = {
 	CUTE_REF(strollut_cdefs_suite),
@@ -184,6 +205,15 @@ CUTE_GROUP(strollut_group) = {
 #if defined(CONFIG_STROLL_FBMAP)
 	CUTE_REF(strollut_fbmap_suite),
 #endif
+#if defined(CONFIG_STROLL_HBMAP)
+	CUTE_REF(strollut_hbmap_suite),
+#endif
+#if defined(CONFIG_STROLL_IDALLOC)
+	CUTE_REF(strollut_idalloc_suite),
+#endif
+#if defined(CONFIG_STROLL_RBMAP)
+	CUTE_REF(strollut_rbmap_suite),
+#endif
 #if defined(CONFIG_STROLL_LVSTR)
 	CUTE_REF(strollut_lvstr_suite),
 #endif
@@ -210,6 +240,18 @@ CUTE_GROUP(strollut_group) = {
 #if defined(CONFIG_STROLL_MSG)
 	CUTE_REF(strollut_message_suite),
 #endif
+#if defined(CONFIG_STROLL_BLOOM)
+	CUTE_REF(strollut_bloom_suite),
+#endif
+#if defined(CONFIG_STROLL_CUCKOO)
+	CUTE_REF(strollut_cuckoo_suite),
+#endif
+#if defined(CONFIG_STROLL_HLL)
+	CUTE_REF(strollut_hll_suite),
+#endif
+#if defined(CONFIG_STROLL_CMSKETCH)
+	CUTE_REF(strollut_cmsketch_suite),
+#endif
 };
 
 CUTE_SUITE(strollut_suite, strollut_group);